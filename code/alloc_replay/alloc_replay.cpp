@@ -0,0 +1,133 @@
+/* ========================================================================
+   $File: alloc_replay.cpp $
+   $Date: October 19 2026 10:30 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_log.h>
+#include <c_string.h>
+#include <c_file_api.h>
+#include <c_memory_arena.h>
+#include <p_platform_data.h>
+
+#define PROGRAM_FLAG_HANDLER_IMPLEMENTATION
+#include <c_program_flag_handler.h>
+#include <c_alloc_trace.h>
+
+#include <p_platform_data.cpp>
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_alloc_trace.cpp>
+
+/* NOTE(Sleepster): Plays a capture from '-alloc_trace' back against the allocators and compares them.
+ *
+ *     alloc_replay allocs.atrc [-backend=all] [-kinds=zone,dynarray] [-sample_events=65536] [-csv=alloc_replay.csv]
+ *
+ * '-backend' is 'zone', 'malloc' or 'all'. '-kinds' picks which of the trace's allocations get played, out of
+ * 'arena', 'zone' and 'dynarray', empty is all of them. Arena pushes get played as allocations of their own like
+ * everything else. '-csv' writes every sample of every backend, the fragmentation over time is a line per backend in
+ * a spreadsheet.
+ */
+
+global_variable const char *alloc_replay_kind_names[ASK_Count] = {
+    "arena",
+    "zone",
+    "dynarray",
+};
+
+internal_api u32
+alloc_replay_parse_kinds(const char *kinds)
+{
+    u32 result = 0;
+    for(u32 kind = 0; kind < ASK_Count; ++kind)
+    {
+        if(strstr(kinds, alloc_replay_kind_names[kind])) result |= 1u << kind;
+    }
+
+    return(result);
+}
+
+int
+main(int argc, char **argv)
+{
+    char **backend_name  = c_program_flag_add_string("backend", (char*)"all", "'zone', 'malloc' or 'all'\n");
+    char **kinds         = c_program_flag_add_string("kinds", (char*)"", "Which allocations to play, out of 'arena', 'zone' and 'dynarray', empty is all of them\n");
+    u64   *sample_events = c_program_flag_add_size("sample_events", ALLOC_REPLAY_DEFAULT_SAMPLE_EVENTS, "Samples the fragmentation every this many records, on top of every frame\n");
+    u64   *capacity_mb   = c_program_flag_add_size("capacity_mb", 0, "What the zone backend reserves, 0 is four times the trace's peak live bytes\n");
+    char **csv_path      = c_program_flag_add_string("csv", (char*)"", "Writes every sample of every backend here\n");
+
+    char *trace_path    = null;
+    char *flag_args[64] = {argv[0]};
+    s32   flag_count    = 1;
+    for(s32 arg_index = 1; arg_index < argc && flag_count < (s32)ArrayCount(flag_args); ++arg_index)
+    {
+        if(argv[arg_index][0] == '-') flag_args[flag_count++] = argv[arg_index];
+        else                          trace_path               = argv[arg_index];
+    }
+    if(flag_count > 1) c_program_flag_parse_args(flag_count, flag_args);
+
+    if(!trace_path)
+    {
+        log_error("Usage: alloc_replay <trace> [-backend=all] [-kinds=] [-sample_events=65536] [-capacity_mb=0] [-csv=]...\n");
+        return(1);
+    }
+
+    alloc_trace_t trace = {};
+    if(!c_alloc_trace_load(c_string_create(trace_path), &trace)) return(1);
+    log_info("'%s': '%llu' records, '%llu' allocs, '%llu' frees over '%llu' frames, peak live %.2f MB...\n", trace_path,
+             (unsigned long long)trace.record_count, (unsigned long long)trace.alloc_count, (unsigned long long)trace.free_count,
+             (unsigned long long)trace.frame_count, (float64)trace.peak_live_bytes / (float64)MB(1));
+
+    alloc_replay_backend_t *backends[2];
+    u32                     backend_count = 0;
+    bool8                   all_backends  = strcmp(*backend_name, "all") == 0;
+    if(all_backends || strcmp(*backend_name, "zone")   == 0) backends[backend_count++] = c_alloc_replay_get_zone_backend();
+    if(all_backends || strcmp(*backend_name, "malloc") == 0) backends[backend_count++] = c_alloc_replay_get_malloc_backend();
+    if(!backend_count)
+    {
+        log_error("Unknown backend '%s', it's 'zone', 'malloc' or 'all'...\n", *backend_name);
+        c_alloc_trace_free(&trace);
+        return(1);
+    }
+
+    alloc_replay_config_t config = {};
+    config.kind_mask     = alloc_replay_parse_kinds(*kinds);
+    config.sample_events = *sample_events;
+    config.capacity      = *capacity_mb * MB(1);
+
+    s32                   result = 0;
+    alloc_replay_result_t results[ArrayCount(backends)] = {};
+    for(u32 backend_index = 0; backend_index < backend_count; ++backend_index)
+    {
+        if(c_alloc_replay_run(&trace, backends[backend_index], &config, results + backend_index))
+        {
+            c_alloc_replay_log(results + backend_index);
+        }
+        else
+        {
+            result = 1;
+        }
+    }
+
+    if(**csv_path && !c_alloc_replay_dump_csv(results, backend_count, c_string_create(*csv_path))) result = 1;
+
+    for(u32 backend_index = 0; backend_index < backend_count; ++backend_index)
+    {
+        c_alloc_replay_free_result(results + backend_index);
+    }
+    c_alloc_trace_free(&trace);
+    return(result);
+}
@@ -0,0 +1,411 @@
+/* ========================================================================
+   $File: jfd_synthetic_packer.cpp $
+   $Date: October 19 2026 09:10 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+#include <stdlib.h>
+
+#define HASH_TABLE_IMPLEMENTATION
+#define MATH_IMPLEMENTATION
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_globals.h>
+#include <c_log.h>
+#include <c_string.h>
+#include <c_file_api.h>
+#include <c_file_watcher.h>
+#include <c_dynarray.h>
+#include <c_zone_allocator.h>
+#include <c_threadpool.h>
+#include <c_memory_arena.h>
+#include <c_hash_table.h>
+#include <p_platform_data.h>
+
+#define PROGRAM_FLAG_HANDLER_IMPLEMENTATION
+#include <c_program_flag_handler.h>
+
+#include <s_asset_manager.h>
+
+#include <c_globals.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_memory_arena.cpp>
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_threadpool.cpp>
+#include <c_profiler.cpp>
+#include <c_sampler.cpp>
+#include <p_platform_data.cpp>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb/stb_image_write.h>
+
+#include "jfd_asset_file.h"
+
+/* NOTE(Sleepster): Writes a .jfd package of made up assets, for benchmarking the asset manager on more than the
+ * handful of real ones ('-asset_load', 'make asset_bench').
+ *
+ *     jfd_synthetic_packer [-output=synthetic_assets.jfd] [-textures=3072] [-distribution=mixed]
+ *                          [-shaders=32] [-sounds=64] [-seed=1] [-shader_source=<path to a .spv>]
+ *
+ * Textures are RGBA PNGs of a gradient with a little noise in it, so they don't compress down to nothing.
+ * Their sizes come out of '-distribution':
+ *
+ *     icons   16   - 64
+ *     sprites 32   - 256
+ *     mixed   85% 16 - 128, 13% 128 - 512, 2% 512 - 2048
+ *     large   512  - 2048
+ *
+ * log-uniform inside each range, each side on its own. Sounds are 16 bit mono sine waves, a quarter second to three
+ * seconds long, and shaders are copies of '-shader_source' (or a stub if it can't be read, a headless load never
+ * makes one). The same seed makes the same package.
+ *
+ * The catalogs' hash tables don't resolve collisions, two names in the same bucket are the same asset to them. So
+ * every name here is picked to land in a bucket nothing else has, and there can't be more entries than buckets.
+ */
+
+#define SYNTHETIC_MAX_ENTRIES     (4000)
+#define SYNTHETIC_SOUND_HZ        (44100)
+
+StaticAssert(SYNTHETIC_MAX_ENTRIES < ASSET_CATALOG_MAX_LOOKUPS, "Every synthetic entry needs its own catalog bucket...\n");
+
+typedef struct synthetic_size_range
+{
+    float32 weight;
+    u32     min_size;
+    u32     max_size;
+}synthetic_size_range_t;
+
+typedef struct synthetic_distribution
+{
+    const char             *name;
+    u32                     range_count;
+    synthetic_size_range_t  ranges[3];
+}synthetic_distribution_t;
+
+global_variable synthetic_distribution_t synthetic_distributions[] =
+{
+    {"icons",   1, {{1.00f, 16,  64}}},
+    {"sprites", 1, {{1.00f, 32,  256}}},
+    {"mixed",   3, {{0.85f, 16,  128}, {0.13f, 128, 512}, {0.02f, 512, 2048}}},
+    {"large",   1, {{1.00f, 512, 2048}}},
+};
+
+typedef struct synthetic_buffer
+{
+    byte *data;
+    u64   count;
+    u64   capacity;
+}synthetic_buffer_t;
+
+typedef struct synthetic_packer_state
+{
+    file_t             output_file;
+    u64                random_state;
+    bool8              used_buckets[ASSET_CATALOG_MAX_LOOKUPS];
+    synthetic_buffer_t entry_data;
+    u64                bytes_written[AT_Count];
+}synthetic_packer_state_t;
+
+global_variable synthetic_packer_state_t packer_state;
+
+// NOTE(Sleepster): xorshift64*, the same one the synthetic replays use.
+internal_api u64
+synthetic_random_next()
+{
+    u64 x = packer_state.random_state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    packer_state.random_state = x;
+
+    return(x * 0x2545F4914F6CDD1DULL);
+}
+
+internal_api float32
+synthetic_random_unit()
+{
+    return((float32)(synthetic_random_next() >> 40) / (float32)(1 << 24));
+}
+
+internal_api u32
+synthetic_random_log_uniform(u32 min_value, u32 max_value)
+{
+    float32 log_min = logf((float32)min_value);
+    float32 log_max = logf((float32)max_value);
+    u32     result  = (u32)expf(log_min + ((log_max - log_min) * synthetic_random_unit()));
+
+    return(Clamp(result, min_value, max_value));
+}
+
+internal_api void
+synthetic_buffer_append(synthetic_buffer_t *buffer, void *data, u64 size)
+{
+    if(buffer->count + size > buffer->capacity)
+    {
+        u64 new_capacity = Max(buffer->capacity * 2, buffer->count + size);
+        buffer->data     = (byte*)realloc(buffer->data, new_capacity);
+        buffer->capacity = new_capacity;
+        Assert(buffer->data);
+    }
+    memcpy(buffer->data + buffer->count, data, size);
+    buffer->count += size;
+}
+
+internal_api void
+synthetic_png_write_proc(void *context, void *data, int size)
+{
+    synthetic_buffer_append((synthetic_buffer_t*)context, data, (u64)size);
+}
+
+// NOTE(Sleepster): A name in its own bucket, 'base_00017' if that's free and 'base_00017_1', '_2'... if it isn't.
+internal_api u32
+synthetic_make_unique_name(char *name_buffer, u32 buffer_size, const char *base_name, u32 index)
+{
+    u32 name_length = 0;
+    for(u32 attempt = 0;; ++attempt)
+    {
+        if(attempt == 0) name_length = snprintf(name_buffer, buffer_size, "%s_%05u", base_name, index);
+        else             name_length = snprintf(name_buffer, buffer_size, "%s_%05u_%u", base_name, index, attempt);
+
+        u64 bucket = c_hash_table_value_from_key((byte*)name_buffer, name_length, ASSET_CATALOG_MAX_LOOKUPS);
+        if(bucket != 0 && !packer_state.used_buckets[bucket])
+        {
+            packer_state.used_buckets[bucket] = true;
+            break;
+        }
+    }
+
+    return(name_length);
+}
+
+internal_api bool8
+synthetic_write_entry(asset_type_t type, const char *base_name, u32 index, string_t asset_data)
+{
+    char name_buffer[64];
+    u32  name_length = synthetic_make_unique_name(name_buffer, sizeof(name_buffer), base_name, index);
+
+    jfd_package_chunk_header_t chunk_header = {};
+    chunk_header.magic_value      = ASSET_FILE_CHUNK_MAGIC;
+    chunk_header.total_entry_size = sizeof(jfd_package_chunk_header_t) + (asset_data.count + name_length);
+    chunk_header.asset_type       = type;
+    chunk_header.filename_size    = name_length;
+    chunk_header.entry_data_size  = asset_data.count;
+
+    bool8 result = c_file_write(&packer_state.output_file, &chunk_header, sizeof(chunk_header));
+    result      &= c_file_write(&packer_state.output_file, name_buffer, name_length);
+    result      &= c_file_write(&packer_state.output_file, asset_data.data, asset_data.count);
+    packer_state.bytes_written[type] += chunk_header.total_entry_size;
+
+    return(result);
+}
+
+internal_api string_t
+synthetic_make_texture(synthetic_distribution_t *distribution, u32 *width_out, u32 *height_out)
+{
+    float32 range_roll = synthetic_random_unit();
+    synthetic_size_range_t *range = distribution->ranges + (distribution->range_count - 1);
+    for(u32 range_index = 0; range_index < distribution->range_count; ++range_index)
+    {
+        if(range_roll < distribution->ranges[range_index].weight)
+        {
+            range = distribution->ranges + range_index;
+            break;
+        }
+        range_roll -= distribution->ranges[range_index].weight;
+    }
+
+    u32 width  = synthetic_random_log_uniform(range->min_size, range->max_size);
+    u32 height = synthetic_random_log_uniform(range->min_size, range->max_size);
+    u32 pixel_stride = width * 4;
+    byte *pixels = (byte*)malloc((u64)pixel_stride * height);
+    Assert(pixels);
+
+    // NOTE(Sleepster): A colour per texture, a gradient across it, a couple bits of noise on top and a transparent
+    //                  border, about what a sprite sheet's worth of art compresses to.
+    u32 base_color = (u32)synthetic_random_next();
+    u32 border     = Min(width, height) / 8;
+    for(u32 y = 0; y < height; ++y)
+    {
+        byte *row = pixels + ((u64)y * pixel_stride);
+        for(u32 x = 0; x < width; ++x)
+        {
+            u32   noise     = (u32)synthetic_random_next();
+            bool8 is_border = x < border || y < border || x >= width - border || y >= height - border;
+            row[(x * 4) + 0] = (byte)(((base_color >> 0)  & 0xFF) + ((x * 255) / width)  + (noise & 0x03));
+            row[(x * 4) + 1] = (byte)(((base_color >> 8)  & 0xFF) + ((y * 255) / height) + ((noise >> 8) & 0x03));
+            row[(x * 4) + 2] = (byte)(((base_color >> 16) & 0xFF));
+            row[(x * 4) + 3] = is_border ? 0 : 255;
+        }
+    }
+
+    packer_state.entry_data.count = 0;
+    stbi_write_png_to_func(synthetic_png_write_proc, &packer_state.entry_data, width, height, 4, pixels, pixel_stride);
+    free(pixels);
+
+    *width_out  = width;
+    *height_out = height;
+    string_t result = {.data = packer_state.entry_data.data, .count = (u32)packer_state.entry_data.count};
+    return(result);
+}
+
+#pragma pack(push, 1)
+typedef struct synthetic_wav_header
+{
+    u32 riff_id;
+    u32 riff_size;
+    u32 wave_id;
+    u32 fmt_id;
+    u32 fmt_size;
+    u16 format;
+    u16 channels;
+    u32 sample_rate;
+    u32 byte_rate;
+    u16 block_align;
+    u16 bits_per_sample;
+    u32 data_id;
+    u32 data_size;
+}synthetic_wav_header_t;
+#pragma pack(pop)
+
+internal_api string_t
+synthetic_make_sound()
+{
+    u32 sample_count = (u32)((0.25f + (2.75f * synthetic_random_unit())) * SYNTHETIC_SOUND_HZ);
+    float32 pitch_hz = 110.0f + (770.0f * synthetic_random_unit());
+
+    synthetic_wav_header_t header = {};
+    header.riff_id         = FOURCC("RIFF");
+    header.riff_size       = (sizeof(header) - 8) + (sample_count * sizeof(s16));
+    header.wave_id         = FOURCC("WAVE");
+    header.fmt_id          = FOURCC("fmt ");
+    header.fmt_size        = 16;
+    header.format          = 1;
+    header.channels        = 1;
+    header.sample_rate     = SYNTHETIC_SOUND_HZ;
+    header.byte_rate       = SYNTHETIC_SOUND_HZ * sizeof(s16);
+    header.block_align     = sizeof(s16);
+    header.bits_per_sample = 16;
+    header.data_id         = FOURCC("data");
+    header.data_size       = sample_count * sizeof(s16);
+
+    packer_state.entry_data.count = 0;
+    synthetic_buffer_append(&packer_state.entry_data, &header, sizeof(header));
+    for(u32 sample_index = 0; sample_index < sample_count; ++sample_index)
+    {
+        s16 sample = (s16)(sinf((TAU32 * pitch_hz * sample_index) / SYNTHETIC_SOUND_HZ) * 8000.0f);
+        synthetic_buffer_append(&packer_state.entry_data, &sample, sizeof(sample));
+    }
+
+    string_t result = {.data = packer_state.entry_data.data, .count = (u32)packer_state.entry_data.count};
+    return(result);
+}
+
+int
+main(int argc, char **argv)
+{
+    char  **output_path   = c_program_flag_add_string("output", (char*)"synthetic_assets.jfd", "Where the package is written\n");
+    u64    *texture_count = c_program_flag_add_size("textures", 3072, "How many PNG textures the package gets\n");
+    char  **distribution  = c_program_flag_add_string("distribution", (char*)"mixed", "Texture sizes: 'icons', 'sprites', 'mixed' or 'large'\n");
+    u64    *shader_count  = c_program_flag_add_size("shaders", 32, "How many shaders the package gets\n");
+    u64    *sound_count   = c_program_flag_add_size("sounds", 64, "How many WAV sounds the package gets\n");
+    u64    *random_seed   = c_program_flag_add_size("seed", 1, "Same seed, same package\n");
+    char  **shader_source = c_program_flag_add_string("shader_source", (char*)"../run_tree/res/shader_binaries/test.spv", "The SPIR-V every synthetic shader is a copy of\n");
+    if(argc > 1) c_program_flag_parse_args(argc, argv);
+
+    ZeroStruct(packer_state);
+    c_global_context_init();
+    packer_state.random_state = *random_seed ? *random_seed : 1;
+
+    synthetic_distribution_t *size_distribution = null;
+    for(u32 distribution_index = 0; distribution_index < ArrayCount(synthetic_distributions); ++distribution_index)
+    {
+        if(strcmp(synthetic_distributions[distribution_index].name, *distribution) == 0)
+        {
+            size_distribution = synthetic_distributions + distribution_index;
+        }
+    }
+    if(!size_distribution)
+    {
+        log_error("Unknown texture size distribution: '%s'...\n", *distribution);
+        return(1);
+    }
+
+    u64 entry_count = *texture_count + *shader_count + *sound_count;
+    if(entry_count > SYNTHETIC_MAX_ENTRIES)
+    {
+        log_error("'%llu' entries is more than the '%u' the asset catalogs can tell apart...\n", entry_count, SYNTHETIC_MAX_ENTRIES);
+        return(1);
+    }
+
+    packer_state.output_file = sys_file_open(STR(*output_path), true, false, false);
+    if(packer_state.output_file.handle == INVALID_FILE_HANDLE)
+    {
+        log_error("Could not create file: '%s'...\n", *output_path);
+        return(1);
+    }
+    log_info("Packing '%llu' '%s' textures, '%llu' shaders and '%llu' sounds into '%s' with seed '%llu'...\n",
+             *texture_count, size_distribution->name, *shader_count, *sound_count, *output_path, *random_seed);
+
+    jfd_file_header_t header = {};
+    header.magic_value = ASSET_FILE_HEADER_MAGIC;
+    header.version     = ASSET_FILE_VERSION;
+    header.flags       = 0;
+    header.entry_count = (u32)entry_count;
+
+    bool8 success = c_file_write(&packer_state.output_file, &header, sizeof(header));
+    u64   texture_pixels = 0;
+    for(u32 texture_index = 0; success && texture_index < *texture_count; ++texture_index)
+    {
+        u32 width  = 0;
+        u32 height = 0;
+        string_t texture_data = synthetic_make_texture(size_distribution, &width, &height);
+        success        &= synthetic_write_entry(AT_Bitmap, "synthetic_texture", texture_index, texture_data);
+        texture_pixels += (u64)width * height;
+
+        if(((texture_index + 1) % 256) == 0)
+        {
+            log_info("'%u' of '%llu' textures written...\n", texture_index + 1, *texture_count);
+        }
+    }
+
+    string_t shader_data = c_file_read_entirety(STR(*shader_source));
+    if(shader_data.data == null)
+    {
+        log_warning("Could not read '%s', the synthetic shaders are stubs...\n", *shader_source);
+
+        local_persist u32 stub_shader[] = {0x07230203, 0x00010000, 0, 1, 0};
+        shader_data.data  = (byte*)stub_shader;
+        shader_data.count = sizeof(stub_shader);
+    }
+    for(u32 shader_index = 0; success && shader_index < *shader_count; ++shader_index)
+    {
+        success &= synthetic_write_entry(AT_Shader, "synthetic_shader", shader_index, shader_data);
+    }
+
+    for(u32 sound_index = 0; success && sound_index < *sound_count; ++sound_index)
+    {
+        success &= synthetic_write_entry(AT_Sound, "synthetic_sound", sound_index, synthetic_make_sound());
+    }
+    c_file_close(&packer_state.output_file);
+    free(packer_state.entry_data.data);
+
+    if(!success)
+    {
+        log_error("Failed writing '%s'...\n", *output_path);
+        return(1);
+    }
+
+    log_info("Wrote '%s': textures '%.1f' MB ('%.1f' MB decoded), shaders '%.1f' MB, sounds '%.1f' MB...\n",
+             *output_path,
+             (float64)packer_state.bytes_written[AT_Bitmap] / (float64)MB(1),
+             (float64)(texture_pixels * 4) / (float64)MB(1),
+             (float64)packer_state.bytes_written[AT_Shader] / (float64)MB(1),
+             (float64)packer_state.bytes_written[AT_Sound]  / (float64)MB(1));
+    return(0);
+}
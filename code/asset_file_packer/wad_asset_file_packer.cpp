@@ -30,12 +30,15 @@
 
 #include <c_globals.cpp>
 #include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
 #include <c_memory_arena.cpp>
 #include <c_string.cpp>
 #include <c_dynarray_impl.cpp>
 #include <c_file_api.cpp>
 #include <c_file_watcher.cpp>
 #include <c_threadpool.cpp>
+#include <c_profiler.cpp>
+#include <c_sampler.cpp>
 #include <p_platform_data.cpp>
 
 global_variable packer_state_t packer_state;
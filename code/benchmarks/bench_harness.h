@@ -0,0 +1,490 @@
+#if !defined(BENCH_HARNESS_H)
+/* ========================================================================
+   $File: bench_harness.h $
+   $Date: October 19 2026 04:20 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define BENCH_HARNESS_H
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <c_intrinsics.h>
+#include <c_types.h>
+#include <c_base.h>
+
+#define PROGRAM_FLAG_HANDLER_IMPLEMENTATION
+#include <c_program_flag_handler.h>
+
+#include <c_perf_counters.h>
+
+#include <SDL3/SDL.h>
+
+/* NOTE(Sleepster): The harness behind the bench_suite_* executables ('make bench' builds them at -O2 and runs every one).
+ *
+ * A suite is a list of bench_case_t's. Every case gets 'warmup' untimed runs, then 'repetitions' timed ones. setup() and
+ * teardown() run around every run and are never timed, run() is the only thing on the clock. From the sorted samples
+ * we report min/median/p90/p99/max, and from the median (never the mean, one preempted run drags the mean around):
+ *   ns per item, cycles per item (rdtsc, so these are reference cycles, not core cycles), items per second and bytes
+ *   per second when the case says how many bytes a run touches.
+ *
+ * Where the machine has hardware counters (c_perf_counters.h) every timed run also reads them, and the medians per item
+ * of cycles, instructions, cache, branch and TLB misses are printed under the case and go into the JSON. They only
+ * count the benchmark's own thread, the work a case hands to the threadpool isn't in them. No counters, no line.
+ *
+ * So that the numbers are comparable across commits, every case runs a fixed amount of work from a fixed seed, and
+ * the JSON carries the commit, compiler, cpu and build settings next to the results. '-compare=<old json>' prints the
+ * median of every case against the same case in an older run.
+ *
+ * flags: -warmup=<n> -repetitions=<n> -filter=<substring> -json=<path> -compare=<path> -commit=<label>
+ */
+
+#define BENCH_MAX_CASES           (64)
+#define BENCH_MAX_REPETITIONS     (1024)
+#define BENCH_DEFAULT_WARMUP      (5)
+#define BENCH_DEFAULT_REPETITIONS (51)
+#define BENCH_NAME_LENGTH         (64)
+
+typedef void bench_proc_t(void *user_data);
+
+struct bench_case_t
+{
+    const char   *name;
+    bench_proc_t *setup;
+    bench_proc_t *run;
+    bench_proc_t *teardown;
+    void         *user_data;
+
+    u64           items_per_run;
+    u64           bytes_per_run;
+};
+
+struct bench_result_t
+{
+    char    name[BENCH_NAME_LENGTH];
+    u32     repetition_count;
+    u64     items_per_run;
+    u64     bytes_per_run;
+
+    float64 min_ns;
+    float64 median_ns;
+    float64 p90_ns;
+    float64 p99_ns;
+    float64 max_ns;
+    float64 median_cycles;
+
+    float64 ns_per_item;
+    float64 cycles_per_item;
+    float64 items_per_second;
+    float64 bytes_per_second;
+
+    // NOTE(Sleepster): Medians over the runs that had them, per run, not per item.
+    u32     counter_mask;
+    float64 median_counters[PERF_COUNTER_COUNT];
+};
+
+struct bench_suite_t
+{
+    const char     *name;
+    u32             warmup_count;
+    u32             repetition_count;
+    char           *filter;
+    char           *json_path;
+    char           *compare_path;
+    char           *commit;
+
+    bench_result_t  results[BENCH_MAX_CASES];
+    u32             result_count;
+
+    float64         ns_samples[BENCH_MAX_REPETITIONS];
+    float64         cycle_samples[BENCH_MAX_REPETITIONS];
+    float64         counter_samples[PERF_COUNTER_COUNT][BENCH_MAX_REPETITIONS];
+    u32             counter_sample_counts[PERF_COUNTER_COUNT];
+};
+
+internal_api inline u64
+bench_now()
+{
+    return(SDL_GetPerformanceCounter());
+}
+
+// NOTE(Sleepster): Fake work for the scheduler benchmarks, the result needs to be kept somewhere or it gets optimized out.
+internal_api inline u32
+bench_spin_work(u32 seed, u32 iterations)
+{
+    u32 value = seed | 1;
+    for(u32 iteration = 0;
+        iteration < iterations;
+        ++iteration)
+    {
+        value ^= value << 13;
+        value ^= value >> 17;
+        value ^= value << 5;
+    }
+
+    return(value);
+}
+
+// NOTE(Sleepster): Keeps a value alive without the compiler being able to see that nothing reads it.
+global_variable volatile u64 bench_sink_value;
+
+internal_api inline void
+bench_consume(u64 value)
+{
+    bench_sink_value += value;
+}
+
+// NOTE(Sleepster): xorshift64*, every case seeds its own so the inputs are the same on every commit.
+internal_api inline u64
+bench_random_next(u64 *state)
+{
+    u64 value = *state;
+    value ^= value >> 12;
+    value ^= value << 25;
+    value ^= value >> 27;
+    *state = value;
+
+    return(value * 0x2545F4914F6CDD1DULL);
+}
+
+internal_api int
+bench_compare_float64(const void *a, const void *b)
+{
+    float64 left  = *(const float64*)a;
+    float64 right = *(const float64*)b;
+    return((left > right) - (left < right));
+}
+
+// NOTE(Sleepster): Nearest rank, the samples are sorted.
+internal_api float64
+bench_percentile(float64 *samples, u32 sample_count, float64 percentile)
+{
+    u32 rank = (u32)((percentile / 100.0) * (float64)sample_count + 0.999999);
+    if(rank < 1)            rank = 1;
+    if(rank > sample_count) rank = sample_count;
+
+    return(samples[rank - 1]);
+}
+
+internal_api void
+bench_get_cpu_name(char *name_out, u32 name_size)
+{
+    snprintf(name_out, name_size, "unknown");
+#if OS_LINUX
+    FILE *cpuinfo = fopen("/proc/cpuinfo", "rb");
+    if(cpuinfo)
+    {
+        char line[256];
+        while(fgets(line, sizeof(line), cpuinfo))
+        {
+            if(strncmp(line, "model name", 10) == 0)
+            {
+                char *value = strchr(line, ':');
+                if(value)
+                {
+                    value += 1;
+                    while(*value == ' ') ++value;
+                    value[strcspn(value, "\r\n")] = 0;
+                    snprintf(name_out, name_size, "%s", value);
+                }
+                break;
+            }
+        }
+        fclose(cpuinfo);
+    }
+#endif
+}
+
+internal_api void
+bench_suite_init(bench_suite_t *suite, const char *name, s32 argc, char **argv)
+{
+    ZeroStruct(*suite);
+    u64   *warmup       = c_program_flag_add_size("warmup", BENCH_DEFAULT_WARMUP, "Untimed runs of every case before the timed ones\n");
+    u64   *repetitions  = c_program_flag_add_size("repetitions", BENCH_DEFAULT_REPETITIONS, "Timed runs of every case\n");
+    char **filter       = c_program_flag_add_string("filter", null, "Only runs the cases with this in their name\n");
+    char **json_path    = c_program_flag_add_string("json", null, "Writes the results here\n");
+    char **compare_path = c_program_flag_add_string("compare", null, "JSON from an older run to compare the medians against\n");
+    char **commit       = c_program_flag_add_string("commit", (char*)"unknown", "What gets recorded as the commit in the JSON\n");
+    if(argc > 1) c_program_flag_parse_args(argc, argv);
+
+    suite->name             = name;
+    suite->warmup_count     = (u32)*warmup;
+    suite->repetition_count = (u32)Max(1, Min(*repetitions, BENCH_MAX_REPETITIONS));
+    suite->filter           = *filter;
+    suite->json_path        = *json_path;
+    suite->compare_path     = *compare_path;
+    suite->commit           = *commit;
+
+    printf("[%s] %u warmup, %u repetitions\n", suite->name, suite->warmup_count, suite->repetition_count);
+    printf("%-32s %12s %12s %12s %12s %10s %12s %12s\n",
+           "case", "median", "p90", "p99", "ns/item", "cyc/item", "items/s", "MB/s");
+}
+
+internal_api void
+bench_suite_run(bench_suite_t *suite, bench_case_t *bench_case)
+{
+    if(suite->filter && !strstr(bench_case->name, suite->filter)) return;
+    if(suite->result_count >= BENCH_MAX_CASES)
+    {
+        log_warning("Benchmark suite '%s' is full, '%s' is skipped...\n", suite->name, bench_case->name);
+        return;
+    }
+
+    for(u32 warmup_index = 0; warmup_index < suite->warmup_count; ++warmup_index)
+    {
+        if(bench_case->setup) bench_case->setup(bench_case->user_data);
+        bench_case->run(bench_case->user_data);
+        if(bench_case->teardown) bench_case->teardown(bench_case->user_data);
+    }
+
+    ZeroStruct(suite->counter_sample_counts);
+
+    float64 counter_to_ns = 1000000000.0 / (float64)SDL_GetPerformanceFrequency();
+    for(u32 repetition_index = 0; repetition_index < suite->repetition_count; ++repetition_index)
+    {
+        if(bench_case->setup) bench_case->setup(bench_case->user_data);
+
+        // NOTE(Sleepster): The counter reads are syscalls, they stay outside of the timed part.
+        perf_counter_values_t start_values;
+        perf_counter_values_t end_values;
+        c_perf_counters_read(&start_values);
+
+        u64 start_counter = bench_now();
+        u64 start_cycles  = rdtsc();
+        bench_case->run(bench_case->user_data);
+        u64 end_cycles    = rdtsc();
+        u64 end_counter   = bench_now();
+
+        c_perf_counters_read(&end_values);
+
+        if(bench_case->teardown) bench_case->teardown(bench_case->user_data);
+
+        suite->ns_samples[repetition_index]    = (float64)(end_counter - start_counter) * counter_to_ns;
+        suite->cycle_samples[repetition_index] = (float64)(end_cycles - start_cycles);
+
+        u64 deltas[PERF_COUNTER_COUNT];
+        u32 counter_mask = c_perf_counters_delta(&start_values, &end_values, deltas);
+        for(u32 counter_index = 0; counter_index < PERF_COUNTER_COUNT; ++counter_index)
+        {
+            if(counter_mask & (1 << counter_index))
+            {
+                suite->counter_samples[counter_index][suite->counter_sample_counts[counter_index]++] = (float64)deltas[counter_index];
+            }
+        }
+    }
+
+    u32 sample_count = suite->repetition_count;
+    qsort(suite->ns_samples,    sample_count, sizeof(float64), bench_compare_float64);
+    qsort(suite->cycle_samples, sample_count, sizeof(float64), bench_compare_float64);
+
+    bench_result_t *result = suite->results + suite->result_count++;
+    snprintf(result->name, sizeof(result->name), "%s", bench_case->name);
+    result->repetition_count = sample_count;
+    result->items_per_run    = Max(bench_case->items_per_run, 1);
+    result->bytes_per_run    = bench_case->bytes_per_run;
+    result->min_ns           = suite->ns_samples[0];
+    result->median_ns        = bench_percentile(suite->ns_samples, sample_count, 50.0);
+    result->p90_ns           = bench_percentile(suite->ns_samples, sample_count, 90.0);
+    result->p99_ns           = bench_percentile(suite->ns_samples, sample_count, 99.0);
+    result->max_ns           = suite->ns_samples[sample_count - 1];
+    result->median_cycles    = bench_percentile(suite->cycle_samples, sample_count, 50.0);
+
+    float64 median_seconds   = Max(result->median_ns, 1.0) / 1000000000.0;
+    result->ns_per_item      = result->median_ns     / (float64)result->items_per_run;
+    result->cycles_per_item  = result->median_cycles / (float64)result->items_per_run;
+    result->items_per_second = (float64)result->items_per_run / median_seconds;
+    result->bytes_per_second = (float64)result->bytes_per_run / median_seconds;
+
+    result->counter_mask = 0;
+    for(u32 counter_index = 0; counter_index < PERF_COUNTER_COUNT; ++counter_index)
+    {
+        u32 counter_sample_count = suite->counter_sample_counts[counter_index];
+        result->median_counters[counter_index] = 0.0;
+        if(counter_sample_count)
+        {
+            qsort(suite->counter_samples[counter_index], counter_sample_count, sizeof(float64), bench_compare_float64);
+            result->median_counters[counter_index] = bench_percentile(suite->counter_samples[counter_index], counter_sample_count, 50.0);
+            result->counter_mask |= 1 << counter_index;
+        }
+    }
+
+    printf("%-32s %9.3f us %9.3f us %9.3f us %12.2f %10.2f %12.0f %12.1f\n",
+           result->name,
+           result->median_ns / 1000.0,
+           result->p90_ns    / 1000.0,
+           result->p99_ns    / 1000.0,
+           result->ns_per_item,
+           result->cycles_per_item,
+           result->items_per_second,
+           result->bytes_per_second / (1024.0 * 1024.0));
+
+    if(result->counter_mask)
+    {
+        u64 median_counters[PERF_COUNTER_COUNT];
+        for(u32 counter_index = 0; counter_index < PERF_COUNTER_COUNT; ++counter_index)
+        {
+            median_counters[counter_index] = (u64)result->median_counters[counter_index];
+        }
+
+        char counters[256];
+        c_perf_counters_format(counters, sizeof(counters), median_counters, result->counter_mask, (float64)result->items_per_run);
+        printf("%-32s per item: %s\n", "", counters);
+    }
+}
+
+/* NOTE(Sleepster): Only reads what bench_suite_write_json() writes, one result per line with the name and median in
+ * it. Cases that aren't in the old file are just printed as new.
+ */
+internal_api void
+bench_suite_compare(bench_suite_t *suite)
+{
+    FILE *baseline = fopen(suite->compare_path, "rb");
+    if(!baseline)
+    {
+        log_warning("Couldn't open '%s' to compare against...\n", suite->compare_path);
+        return;
+    }
+
+    char baseline_names[BENCH_MAX_CASES][BENCH_NAME_LENGTH];
+    float64 baseline_medians[BENCH_MAX_CASES];
+    char baseline_commit[BENCH_NAME_LENGTH] = "unknown";
+    u32  baseline_count = 0;
+
+    char line[1024];
+    while(fgets(line, sizeof(line), baseline))
+    {
+        char *commit = strstr(line, "\"commit\":\"");
+        if(commit)
+        {
+            commit += 10;
+            u32 length = (u32)strcspn(commit, "\"");
+            snprintf(baseline_commit, sizeof(baseline_commit), "%.*s", (s32)length, commit);
+        }
+
+        char *name   = strstr(line, "{\"name\":\"");
+        char *median = strstr(line, "\"median_ns\":");
+        if(name && median && baseline_count < BENCH_MAX_CASES)
+        {
+            name += 9;
+            u32 length = (u32)strcspn(name, "\"");
+            snprintf(baseline_names[baseline_count], BENCH_NAME_LENGTH, "%.*s", (s32)length, name);
+            baseline_medians[baseline_count] = strtod(median + 12, null);
+            ++baseline_count;
+        }
+    }
+    fclose(baseline);
+
+    printf("\n[%s] '%s' against '%s'\n", suite->name, suite->commit, baseline_commit);
+    for(u32 result_index = 0; result_index < suite->result_count; ++result_index)
+    {
+        bench_result_t *result = suite->results + result_index;
+
+        s32 found_index = -1;
+        for(u32 baseline_index = 0; baseline_index < baseline_count; ++baseline_index)
+        {
+            if(strcmp(baseline_names[baseline_index], result->name) == 0)
+            {
+                found_index = (s32)baseline_index;
+                break;
+            }
+        }
+
+        if(found_index >= 0 && baseline_medians[found_index] > 0.0)
+        {
+            float64 old_median = baseline_medians[found_index];
+            float64 change     = ((result->median_ns - old_median) / old_median) * 100.0;
+            printf("%-32s %9.3f us -> %9.3f us %+7.1f%%\n", result->name, old_median / 1000.0, result->median_ns / 1000.0, change);
+        }
+        else
+        {
+            printf("%-32s %9s    -> %9.3f us     new\n", result->name, "", result->median_ns / 1000.0);
+        }
+    }
+}
+
+internal_api bool8
+bench_suite_write_json(bench_suite_t *suite)
+{
+    FILE *file = fopen(suite->json_path, "wb");
+    if(!file)
+    {
+        log_error("Couldn't open '%s' for the benchmark results...\n", suite->json_path);
+        return(false);
+    }
+
+    char cpu_name[128];
+    bench_get_cpu_name(cpu_name, sizeof(cpu_name));
+#if defined(__VERSION__)
+    const char *compiler = __VERSION__;
+#else
+    const char *compiler = "unknown";
+#endif
+#if defined(__OPTIMIZE__)
+    bool8 is_optimized = true;
+#else
+    bool8 is_optimized = false;
+#endif
+#if defined(ASSERT_ENABLED)
+    bool8 asserts_enabled = true;
+#else
+    bool8 asserts_enabled = false;
+#endif
+
+    fprintf(file, "{\"suite\":\"%s\",\"commit\":\"%s\",\"compiler\":\"%s\",\"cpu\":\"%s\",\"logical_cores\":%d,\n",
+            suite->name, suite->commit, compiler, cpu_name, SDL_GetNumLogicalCPUCores());
+    fprintf(file, " \"optimized\":%s,\"asserts_enabled\":%s,\"profiler_enabled\":%d,\"warmup\":%u,\"repetitions\":%u,\n",
+            is_optimized ? "true" : "false", asserts_enabled ? "true" : "false", PROFILER_ENABLED, suite->warmup_count, suite->repetition_count);
+    fprintf(file, " \"results\":[");
+    for(u32 result_index = 0; result_index < suite->result_count; ++result_index)
+    {
+        bench_result_t *result = suite->results + result_index;
+        fprintf(file, "%s\n  {\"name\":\"%s\",\"repetitions\":%u,\"items\":%llu,\"bytes\":%llu,"
+                      "\"min_ns\":%.1f,\"median_ns\":%.1f,\"p90_ns\":%.1f,\"p99_ns\":%.1f,\"max_ns\":%.1f,\"median_cycles\":%.0f,"
+                      "\"ns_per_item\":%.4f,\"cycles_per_item\":%.4f,\"items_per_second\":%.1f,\"bytes_per_second\":%.1f",
+                result_index ? "," : "",
+                result->name, result->repetition_count, (unsigned long long)result->items_per_run, (unsigned long long)result->bytes_per_run,
+                result->min_ns, result->median_ns, result->p90_ns, result->p99_ns, result->max_ns, result->median_cycles,
+                result->ns_per_item, result->cycles_per_item, result->items_per_second, result->bytes_per_second);
+
+        // NOTE(Sleepster): Same line as the rest, -compare reads this file a line at a time.
+        if(result->counter_mask)
+        {
+            fprintf(file, ",\"counters\":{");
+            bool8 is_first = true;
+            for(u32 counter_index = 0; counter_index < PERF_COUNTER_COUNT; ++counter_index)
+            {
+                if(!(result->counter_mask & (1 << counter_index))) continue;
+
+                fprintf(file, "%s\"%s\":%.0f", is_first ? "" : ",", perf_counter_names[counter_index], result->median_counters[counter_index]);
+                is_first = false;
+            }
+            fprintf(file, "}");
+        }
+        fprintf(file, "}");
+    }
+    fprintf(file, "\n]}\n");
+
+    bool8 result = ferror(file) == 0;
+    fclose(file);
+
+    return(result);
+}
+
+// NOTE(Sleepster): Returns what main() should.
+internal_api s32
+bench_suite_finish(bench_suite_t *suite)
+{
+    s32 result = 0;
+    if(suite->json_path)
+    {
+        if(bench_suite_write_json(suite)) printf("\n[%s] results written to '%s'\n", suite->name, suite->json_path);
+        else                              result = 1;
+    }
+    if(suite->compare_path) bench_suite_compare(suite);
+
+    return(result);
+}
+
+#endif // BENCH_HARNESS_H
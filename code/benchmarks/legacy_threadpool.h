@@ -0,0 +1,212 @@
+#if !defined(LEGACY_THREADPOOL_H)
+/* ========================================================================
+   $File: legacy_threadpool.h $
+   $Date: October 18 2026 02:20 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define LEGACY_THREADPOOL_H
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+
+#include <p_platform_data.h>
+
+/* NOTE(Sleepster): Frozen copy of the old two global queue threadpool so the scheduler benchmarks have something
+ * to compare against. Don't use this anywhere else.
+ *
+ * Differences from the original:
+ * - thread count is a parameter and the pool can be shut down so we can build one per thread count.
+ * - the entry is written BEFORE the write index is published. The original published first, so a worker could
+ *   claim an entry that wasn't valid yet and the task would just get dropped. That means it's only safe with a
+ *   single producer, which is how the benchmark uses it.
+ */
+
+#define LEGACY_MAX_QUEUE_ENTRIES            (10000)
+#define LEGACY_THREADPOOL_ENTRY_BUFFER_SIZE (256)
+
+struct legacy_threadpool_queue_entry_t
+{
+    bool8                  is_valid;
+    byte                   entry_buffer[LEGACY_THREADPOOL_ENTRY_BUFFER_SIZE];
+
+    void                  *user_data;
+    threadpool_callback_t *callback;
+};
+
+struct legacy_threadpool_queue_t
+{
+    volatile u32 completion_goal;
+    volatile u32 entries_completed;
+
+    volatile u32 next_entry_to_write;
+    volatile u32 next_entry_to_read;
+
+    legacy_threadpool_queue_entry_t entries[LEGACY_MAX_QUEUE_ENTRIES];
+};
+
+struct legacy_threadpool_t
+{
+    sys_semaphore_t           semaphore;
+    u32                       max_threads;
+    volatile u32              is_running;
+    sys_thread_t              threads[THREADPOOL_MAX_WORKERS];
+
+    legacy_threadpool_queue_t high_priority_queue;
+    legacy_threadpool_queue_t low_priority_queue;
+};
+
+internal_api bool8
+legacy_threadpool_perform_next_task(legacy_threadpool_queue_t *queue)
+{
+    bool8 result = true;
+
+    u32 this_entry_to_read = queue->next_entry_to_read;
+    u32 next_entry_to_read = (this_entry_to_read + 1) % LEGACY_MAX_QUEUE_ENTRIES;
+    if(this_entry_to_read != queue->next_entry_to_write)
+    {
+        ReadWriteBarrier;
+        u32 task = AtomicCompareExchange((volatile s32*)&queue->next_entry_to_read,
+                                         next_entry_to_read,
+                                         this_entry_to_read);
+        if(task == this_entry_to_read)
+        {
+            legacy_threadpool_queue_entry_t *entry = queue->entries + task;
+            if(entry->is_valid)
+            {
+                ReadWriteBarrier;
+
+                entry->is_valid = false;
+                entry->callback(entry->user_data);
+                AtomicIncrement32(&queue->entries_completed);
+            }
+        }
+    }
+    else
+    {
+        result = false;
+    }
+
+    return(result);
+}
+
+PLATFORM_THREAD_PROC(LegacyThreadProc)
+{
+    legacy_threadpool_t *pool = (legacy_threadpool_t*)user_data;
+    while(AtomicLoad32(&pool->is_running))
+    {
+        if(!legacy_threadpool_perform_next_task(&pool->high_priority_queue))
+        {
+            if(!legacy_threadpool_perform_next_task(&pool->low_priority_queue))
+            {
+                sys_semaphore_wait(&pool->semaphore, 0);
+            }
+        }
+    }
+    return(0);
+}
+
+internal_api legacy_threadpool_t*
+legacy_threadpool_create(u32 thread_count)
+{
+    Assert(thread_count <= THREADPOOL_MAX_WORKERS);
+
+    legacy_threadpool_t *pool = (legacy_threadpool_t*)sys_allocate_memory(sizeof(legacy_threadpool_t));
+    pool->semaphore   = sys_semaphore_create(0, LEGACY_MAX_QUEUE_ENTRIES);
+    pool->max_threads = thread_count;
+    pool->is_running  = true;
+
+    for(u32 thread_index = 0;
+        thread_index < thread_count;
+        ++thread_index)
+    {
+        pool->threads[thread_index] = sys_thread_create(LegacyThreadProc, pool, false);
+    }
+
+    return(pool);
+}
+
+internal_api void
+legacy_threadpool_destroy(legacy_threadpool_t *pool)
+{
+    AtomicStore32(&pool->is_running, false);
+    sys_semaphore_release(&pool->semaphore, pool->max_threads);
+    for(u32 thread_index = 0;
+        thread_index < pool->max_threads;
+        ++thread_index)
+    {
+        sys_thread_join(&pool->threads[thread_index]);
+    }
+
+    sys_semaphore_destroy(&pool->semaphore);
+    sys_free_memory(pool, sizeof(legacy_threadpool_t));
+}
+
+internal_api bool8
+legacy_threadpool_add_task(legacy_threadpool_t *threadpool, void *user_data, threadpool_callback_t *callback, u32 priority)
+{
+    bool8 result = true;
+
+    legacy_threadpool_queue_t *queue = null;
+    Assert(priority != TPTP_Invalid);
+    switch(priority)
+    {
+        case TPTP_Low:
+        {
+            queue = &threadpool->low_priority_queue;
+        }break;
+        case TPTP_High:
+        {
+            queue = &threadpool->high_priority_queue;
+        }break;
+    }
+
+    ReadWriteBarrier;
+    u32 entry_to_write      = queue->next_entry_to_write;
+    u32 next_entry_to_write = (entry_to_write + 1) % LEGACY_MAX_QUEUE_ENTRIES;
+    Assert(next_entry_to_write != queue->next_entry_to_read);
+
+    legacy_threadpool_queue_entry_t *entry = queue->entries + entry_to_write;
+    entry->user_data = user_data;
+    entry->callback  = callback;
+    entry->is_valid  = true;
+
+    sfence();
+    u32 queue_entry_to_write = AtomicCompareExchange32((volatile s32*)&queue->next_entry_to_write,
+                                                       next_entry_to_write,
+                                                       entry_to_write);
+    if(queue_entry_to_write == entry_to_write)
+    {
+        AtomicIncrement32(&queue->completion_goal);
+        sys_semaphore_release(&threadpool->semaphore, 1);
+    }
+    else
+    {
+        result = false;
+    }
+
+    return(result);
+}
+
+internal_api void
+legacy_threadpool_flush_queue(legacy_threadpool_queue_t *queue)
+{
+    while(queue->completion_goal != queue->entries_completed)
+    {
+        if(!legacy_threadpool_perform_next_task(queue)) break;
+    }
+
+    ReadWriteBarrier;
+    AtomicExchange(&queue->completion_goal,   0);
+    AtomicExchange(&queue->entries_completed, 0);
+}
+
+internal_api void
+legacy_threadpool_flush_task_queues(legacy_threadpool_t *threadpool)
+{
+    legacy_threadpool_flush_queue(&threadpool->high_priority_queue);
+    legacy_threadpool_flush_queue(&threadpool->low_priority_queue);
+}
+
+#endif // LEGACY_THREADPOOL_H
@@ -0,0 +1,173 @@
+/* ========================================================================
+   $File: suite_arena.cpp $
+   $Date: October 19 2026 04:45 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_perf_counters.cpp>
+
+#include <benchmarks/bench_harness.h>
+
+/* NOTE(Sleepster): memory_arena_t pushes. The reset between runs (which memsets what was used) is in setup, so only
+ * the pushes are timed.
+ *
+ * push_16b        - one small struct at a time, the common case.
+ * push_mixed      - 8 to 1024 bytes, the same sizes every run.
+ * push_new_blocks - 4KB pushes into 64KB blocks, every 16th push maps a new block.
+ * temporary       - begin, a few pushes, end, the scratch pattern.
+ */
+
+#define BENCH_SMALL_PUSH_COUNT  (65536)
+#define BENCH_MIXED_PUSH_COUNT  (16384)
+#define BENCH_BLOCK_PUSH_COUNT  (1024)
+#define BENCH_BLOCK_PUSH_SIZE   (KB(4))
+#define BENCH_SCRATCH_COUNT     (16384)
+
+struct bench_arena_t
+{
+    memory_arena_t arena;
+    u32           *push_sizes;
+    u32            push_count;
+    u32            push_size;
+};
+
+struct bench_small_t
+{
+    u64 a;
+    u64 b;
+};
+
+void
+bench_arena_reset(void *user_data)
+{
+    bench_arena_t *bench = (bench_arena_t*)user_data;
+    c_arena_reset(&bench->arena);
+}
+
+void
+bench_arena_push_small(void *user_data)
+{
+    bench_arena_t *bench = (bench_arena_t*)user_data;
+    for(u32 push_index = 0; push_index < bench->push_count; ++push_index)
+    {
+        bench_small_t *value = c_arena_push_struct(&bench->arena, bench_small_t);
+        value->a = push_index;
+    }
+    bench_consume(bench->arena.used);
+}
+
+void
+bench_arena_push_mixed(void *user_data)
+{
+    bench_arena_t *bench = (bench_arena_t*)user_data;
+    for(u32 push_index = 0; push_index < bench->push_count; ++push_index)
+    {
+        byte *value = c_arena_push_size(&bench->arena, bench->push_sizes[push_index]);
+        value[0] = (byte)push_index;
+    }
+    bench_consume(bench->arena.used);
+}
+
+void
+bench_arena_push_fixed(void *user_data)
+{
+    bench_arena_t *bench = (bench_arena_t*)user_data;
+    for(u32 push_index = 0; push_index < bench->push_count; ++push_index)
+    {
+        byte *value = c_arena_push_size(&bench->arena, bench->push_size);
+        value[0] = (byte)push_index;
+    }
+    bench_consume(bench->arena.block_counter);
+}
+
+void
+bench_arena_temporary(void *user_data)
+{
+    bench_arena_t *bench = (bench_arena_t*)user_data;
+    for(u32 scratch_index = 0; scratch_index < bench->push_count; ++scratch_index)
+    {
+        scratch_arena_t scratch = c_arena_begin_temporary_memory(&bench->arena);
+        for(u32 push_index = 0; push_index < 4; ++push_index)
+        {
+            byte *value = c_arena_push_size(&bench->arena, 64);
+            value[0] = (byte)push_index;
+        }
+        c_arena_end_temporary_memory(&scratch);
+    }
+    bench_consume(bench->arena.used);
+}
+
+int
+main(int argc, char **argv)
+{
+    bench_suite_t *suite = (bench_suite_t*)calloc(1, sizeof(bench_suite_t));
+    bench_suite_init(suite, "arena", argc, argv);
+
+    u32 mixed_sizes[BENCH_MIXED_PUSH_COUNT];
+    u64 mixed_bytes  = 0;
+    u64 random_state = 0x9E3779B97F4A7C15ULL;
+    for(u32 push_index = 0; push_index < BENCH_MIXED_PUSH_COUNT; ++push_index)
+    {
+        mixed_sizes[push_index] = 8 + (u32)(bench_random_next(&random_state) % 1017);
+        mixed_bytes += mixed_sizes[push_index];
+    }
+
+    bench_arena_t small = {};
+    small.arena      = c_arena_create(MB(4));
+    small.push_count = BENCH_SMALL_PUSH_COUNT;
+    bench_case_t small_case = {"push_16b", bench_arena_reset, bench_arena_push_small, null, &small,
+                               BENCH_SMALL_PUSH_COUNT, BENCH_SMALL_PUSH_COUNT * sizeof(bench_small_t)};
+    bench_suite_run(suite, &small_case);
+
+    bench_arena_t mixed = {};
+    mixed.arena      = c_arena_create(MB(32));
+    mixed.push_sizes = mixed_sizes;
+    mixed.push_count = BENCH_MIXED_PUSH_COUNT;
+    bench_case_t mixed_case = {"push_mixed", bench_arena_reset, bench_arena_push_mixed, null, &mixed,
+                               BENCH_MIXED_PUSH_COUNT, mixed_bytes};
+    bench_suite_run(suite, &mixed_case);
+
+    bench_arena_t blocks = {};
+    blocks.arena      = c_arena_create(KB(64));
+    blocks.push_size  = BENCH_BLOCK_PUSH_SIZE;
+    blocks.push_count = BENCH_BLOCK_PUSH_COUNT;
+    bench_case_t blocks_case = {"push_new_blocks", bench_arena_reset, bench_arena_push_fixed, null, &blocks,
+                                BENCH_BLOCK_PUSH_COUNT, BENCH_BLOCK_PUSH_COUNT * BENCH_BLOCK_PUSH_SIZE};
+    bench_suite_run(suite, &blocks_case);
+
+    bench_arena_t scratch = {};
+    scratch.arena      = c_arena_create(MB(1));
+    scratch.push_count = BENCH_SCRATCH_COUNT;
+    bench_case_t scratch_case = {"temporary", null, bench_arena_temporary, null, &scratch,
+                                 BENCH_SCRATCH_COUNT, BENCH_SCRATCH_COUNT * 4 * 64};
+    bench_suite_run(suite, &scratch_case);
+
+    c_arena_destroy(&small.arena);
+    c_arena_destroy(&mixed.arena);
+    c_arena_destroy(&blocks.arena);
+    c_arena_destroy(&scratch.arena);
+
+    s32 result = bench_suite_finish(suite);
+    free(suite);
+
+    return(result);
+}
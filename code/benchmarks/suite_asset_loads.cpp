@@ -0,0 +1,200 @@
+/* ========================================================================
+   $File: suite_asset_loads.cpp $
+   $Date: October 19 2026 05:10 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_threadpool.h>
+#include <c_threadpool.cpp>
+#include <c_parallel.h>
+#include <c_parallel.cpp>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_sampler.cpp>
+#include <c_perf_counters.cpp>
+
+#include <benchmarks/bench_harness.h>
+
+/* NOTE(Sleepster): Asset loads on every core at once, the way s_asset_manager_load_asset_data() does one. An item
+ * is one asset: read its bytes out of the package into a zone, "decode" them into a block twice the size (the
+ * texture expanding out of its compressed form), then free both. The package is a file of random blobs written
+ * here, the loads are split into slices over the threadpool and each slice has its own file handle.
+ *
+ * shared_zone - every slice allocates out of one zone, what the asset manager does today.
+ * slice_zones - every slice has a zone of its own, a per-thread cache. Same work, no shared lock.
+ *
+ * The lock profiler's report for both zones is printed at the end, that's the number this is here for.
+ */
+
+#define BENCH_ASSET_COUNT       (512)
+#define BENCH_ASSET_MIN_SIZE    (KB(4))
+#define BENCH_ASSET_MAX_SIZE    (KB(64))
+#define BENCH_ASSET_SLICE_COUNT (32)
+#define BENCH_ASSET_ZONE_SIZE   (MB(256))
+#define BENCH_ASSET_PATH        "bench_asset_loads.pak"
+
+// NOTE(Sleepster): sys_file_read() only seeks for a non-zero offset, the first asset starts past a header.
+#define BENCH_ASSET_HEADER_SIZE (64)
+
+struct bench_asset_t
+{
+    u32 offset;
+    u32 size;
+};
+
+struct bench_asset_loads_t
+{
+    threadpool_t      pool;
+    bench_asset_t     assets[BENCH_ASSET_COUNT];
+    u64               total_bytes;
+
+    file_t            files[BENCH_ASSET_SLICE_COUNT];
+    zone_allocator_t *shared_zone;
+    zone_allocator_t *slice_zones[BENCH_ASSET_SLICE_COUNT];
+    bool8             use_slice_zones;
+
+    volatile u64      checksum;
+};
+
+internal_api void
+bench_asset_load_slice(void *user_data, u64 begin, u64 end)
+{
+    bench_asset_loads_t *bench = (bench_asset_loads_t*)user_data;
+    u32 slice_index            = (u32)(begin / (BENCH_ASSET_COUNT / BENCH_ASSET_SLICE_COUNT));
+    file_t           *file     = bench->files + slice_index;
+    zone_allocator_t *zone     = bench->use_slice_zones ? bench->slice_zones[slice_index] : bench->shared_zone;
+
+    u64 checksum = 0;
+    for(u64 asset_index = begin; asset_index < end; ++asset_index)
+    {
+        bench_asset_t *asset = bench->assets + asset_index;
+        string_t data = c_file_read_from_offset(file, asset->size, asset->offset, null, zone, ZA_TAG_STATIC);
+        byte *decoded = c_za_alloc(zone, asset->size * 2, ZA_TAG_TEXTURE);
+        for(u32 byte_index = 0; byte_index < data.count; ++byte_index)
+        {
+            decoded[byte_index * 2]     = data.data[byte_index];
+            decoded[byte_index * 2 + 1] = data.data[byte_index] ^ 0xFF;
+        }
+        checksum += decoded[asset->size];
+
+        c_za_free(zone, data.data);
+        c_za_free(zone, decoded);
+    }
+    AtomicExchangeAdd64(&bench->checksum, checksum);
+}
+
+void
+bench_asset_loads_shared_zone(void *user_data)
+{
+    bench_asset_loads_t *bench = (bench_asset_loads_t*)user_data;
+    bench->use_slice_zones = false;
+    c_parallel_for(&bench->pool, 0, BENCH_ASSET_COUNT, BENCH_ASSET_COUNT / BENCH_ASSET_SLICE_COUNT, bench_asset_load_slice, bench);
+    bench_consume(bench->checksum);
+}
+
+void
+bench_asset_loads_slice_zones(void *user_data)
+{
+    bench_asset_loads_t *bench = (bench_asset_loads_t*)user_data;
+    bench->use_slice_zones = true;
+    c_parallel_for(&bench->pool, 0, BENCH_ASSET_COUNT, BENCH_ASSET_COUNT / BENCH_ASSET_SLICE_COUNT, bench_asset_load_slice, bench);
+    bench_consume(bench->checksum);
+}
+
+internal_api bool8
+bench_asset_loads_write_package(bench_asset_loads_t *bench)
+{
+    bool8 result = false;
+
+    u64 random_state = 0x2545F4914F6CDD1DULL;
+    u32 offset       = BENCH_ASSET_HEADER_SIZE;
+    for(u32 asset_index = 0; asset_index < BENCH_ASSET_COUNT; ++asset_index)
+    {
+        bench_asset_t *asset = bench->assets + asset_index;
+        asset->offset        = offset;
+        asset->size          = BENCH_ASSET_MIN_SIZE + (u32)(bench_random_next(&random_state) % (BENCH_ASSET_MAX_SIZE - BENCH_ASSET_MIN_SIZE));
+        offset              += asset->size;
+    }
+    bench->total_bytes = offset - BENCH_ASSET_HEADER_SIZE;
+
+    byte *package = (byte*)malloc(offset);
+    FILE *file    = fopen(BENCH_ASSET_PATH, "wb");
+    if(package && file)
+    {
+        for(u32 byte_index = 0; byte_index < offset; ++byte_index)
+        {
+            package[byte_index] = (byte)bench_random_next(&random_state);
+        }
+        result = fwrite(package, 1, offset, file) == offset;
+    }
+    if(file) fclose(file);
+    free(package);
+
+    return(result);
+}
+
+int
+main(int argc, char **argv)
+{
+    bench_suite_t *suite = (bench_suite_t*)calloc(1, sizeof(bench_suite_t));
+    bench_suite_init(suite, "asset_loads", argc, argv);
+
+    bench_asset_loads_t *bench = (bench_asset_loads_t*)calloc(1, sizeof(bench_asset_loads_t));
+    if(!bench_asset_loads_write_package(bench))
+    {
+        log_error("Failed to write '%s' for the asset load benchmark...\n", BENCH_ASSET_PATH);
+        return(1);
+    }
+
+    threadpool_config_t config = {};
+    c_threadpool_init_with_config(&bench->pool, &config);
+
+    bench->shared_zone = c_za_create(BENCH_ASSET_ZONE_SIZE);
+    c_lock_profiler_register_mutex("shared_zone", &bench->shared_zone->mutex);
+    for(u32 slice_index = 0; slice_index < BENCH_ASSET_SLICE_COUNT; ++slice_index)
+    {
+        bench->files[slice_index]       = sys_file_open(STR(BENCH_ASSET_PATH), false, false, false);
+        bench->slice_zones[slice_index] = c_za_create(BENCH_ASSET_ZONE_SIZE / BENCH_ASSET_SLICE_COUNT);
+        Assert(bench->files[slice_index].handle != INVALID_FILE_HANDLE);
+        c_lock_profiler_register_mutex("slice_zones", &bench->slice_zones[slice_index]->mutex);
+    }
+
+    bench_case_t shared_case = {"shared_zone", null, bench_asset_loads_shared_zone, null, bench, BENCH_ASSET_COUNT, bench->total_bytes};
+    bench_case_t slice_case  = {"slice_zones", null, bench_asset_loads_slice_zones, null, bench, BENCH_ASSET_COUNT, bench->total_bytes};
+    bench_suite_run(suite, &shared_case);
+    bench_suite_run(suite, &slice_case);
+
+    c_lock_profiler_log();
+
+    for(u32 slice_index = 0; slice_index < BENCH_ASSET_SLICE_COUNT; ++slice_index)
+    {
+        c_file_close(bench->files + slice_index);
+        c_za_destroy(bench->slice_zones[slice_index]);
+    }
+    c_za_destroy(bench->shared_zone);
+    c_threadpool_destroy(&bench->pool);
+    remove(BENCH_ASSET_PATH);
+    free(bench);
+
+    s32 result = bench_suite_finish(suite);
+    free(suite);
+
+    return(result);
+}
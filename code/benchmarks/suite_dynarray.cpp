@@ -0,0 +1,154 @@
+/* ========================================================================
+   $File: suite_dynarray.cpp $
+   $Date: October 19 2026 05:35 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_dynarray.h>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_perf_counters.cpp>
+
+#include <benchmarks/bench_harness.h>
+
+/* NOTE(Sleepster): The c_dynarray_* macros on u32's. Creating and destroying the arrays is in setup and teardown.
+ *
+ * push_grow     - push into an empty array, every growth is a realloc.
+ * push_reserved - the same after c_dynarray_reserve(), just the push path.
+ * iterate       - c_dynarray_for over a full array.
+ * remove_front  - c_dynarray_remove_element() at 0, every remove moves the rest of the array down.
+ * pop           - c_dynarray_pop() until it's empty.
+ */
+
+#define BENCH_DYNARRAY_COUNT        (65536)
+#define BENCH_DYNARRAY_REMOVE_COUNT (2048)
+
+struct bench_dynarray_t
+{
+    u32   *array;
+    u32    count;
+    bool8  reserve;
+    bool8  fill;
+};
+
+void
+bench_dynarray_setup(void *user_data)
+{
+    bench_dynarray_t *bench = (bench_dynarray_t*)user_data;
+    bench->array = c_dynarray_create(u32);
+    if(bench->reserve) c_dynarray_reserve(bench->array, bench->count + 1);
+    if(bench->fill)
+    {
+        for(u32 index = 0; index < bench->count; ++index)
+        {
+            c_dynarray_push(bench->array, index);
+        }
+    }
+}
+
+void
+bench_dynarray_teardown(void *user_data)
+{
+    bench_dynarray_t *bench = (bench_dynarray_t*)user_data;
+    c_dynarray_destroy(bench->array);
+}
+
+void
+bench_dynarray_push(void *user_data)
+{
+    bench_dynarray_t *bench = (bench_dynarray_t*)user_data;
+    for(u32 index = 0; index < bench->count; ++index)
+    {
+        c_dynarray_push(bench->array, index);
+    }
+    bench_consume(bench->array[bench->count - 1]);
+}
+
+void
+bench_dynarray_iterate(void *user_data)
+{
+    bench_dynarray_t *bench = (bench_dynarray_t*)user_data;
+    u32 *array = bench->array;
+
+    u64 sum = 0;
+    c_dynarray_for(array, index)
+    {
+        sum += array[index];
+    }
+    bench_consume(sum);
+}
+
+void
+bench_dynarray_remove_front(void *user_data)
+{
+    bench_dynarray_t *bench = (bench_dynarray_t*)user_data;
+    u64 sum = 0;
+    for(u32 index = 0; index < bench->count; ++index)
+    {
+        sum += c_dynarray_remove_element(bench->array, 0);
+    }
+    bench_consume(sum);
+}
+
+void
+bench_dynarray_pop(void *user_data)
+{
+    bench_dynarray_t *bench = (bench_dynarray_t*)user_data;
+    u64 sum = 0;
+    for(u32 index = 0; index < bench->count; ++index)
+    {
+        sum += c_dynarray_pop(bench->array);
+    }
+    bench_consume(sum);
+}
+
+int
+main(int argc, char **argv)
+{
+    bench_suite_t *suite = (bench_suite_t*)calloc(1, sizeof(bench_suite_t));
+    bench_suite_init(suite, "dynarray", argc, argv);
+
+    u64 array_bytes  = BENCH_DYNARRAY_COUNT * sizeof(u32);
+    u64 remove_bytes = BENCH_DYNARRAY_REMOVE_COUNT * sizeof(u32);
+
+    bench_dynarray_t grow     = {null, BENCH_DYNARRAY_COUNT,        false, false};
+    bench_dynarray_t reserved = {null, BENCH_DYNARRAY_COUNT,        true,  false};
+    bench_dynarray_t full     = {null, BENCH_DYNARRAY_COUNT,        true,  true};
+    bench_dynarray_t front    = {null, BENCH_DYNARRAY_REMOVE_COUNT, true,  true};
+
+    bench_case_t cases[] =
+    {
+        {"push_grow",     bench_dynarray_setup, bench_dynarray_push,         bench_dynarray_teardown, &grow,     BENCH_DYNARRAY_COUNT,        array_bytes},
+        {"push_reserved", bench_dynarray_setup, bench_dynarray_push,         bench_dynarray_teardown, &reserved, BENCH_DYNARRAY_COUNT,        array_bytes},
+        {"iterate",       bench_dynarray_setup, bench_dynarray_iterate,      bench_dynarray_teardown, &full,     BENCH_DYNARRAY_COUNT,        array_bytes},
+        {"remove_front",  bench_dynarray_setup, bench_dynarray_remove_front, bench_dynarray_teardown, &front,    BENCH_DYNARRAY_REMOVE_COUNT, remove_bytes},
+        {"pop",           bench_dynarray_setup, bench_dynarray_pop,          bench_dynarray_teardown, &full,     BENCH_DYNARRAY_COUNT,        array_bytes},
+    };
+    for(u32 case_index = 0; case_index < ArrayCount(cases); ++case_index)
+    {
+        bench_suite_run(suite, cases + case_index);
+    }
+
+    s32 result = bench_suite_finish(suite);
+    free(suite);
+
+    return(result);
+}
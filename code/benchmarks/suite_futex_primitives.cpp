@@ -0,0 +1,351 @@
+/* ========================================================================
+   $File: suite_futex_primitives.cpp $
+   $Date: October 18 2026 08:55 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_futex.h>
+#include <c_lock_profiler.h>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_perf_counters.cpp>
+
+#include <benchmarks/bench_harness.h>
+
+/* NOTE(Sleepster): c_futex.h primitives against the SDL backed sys_mutex_t/sys_semaphore_t. profiled_mutex is the
+ * futex mutex with the lock profiler's stats (c_lock_profiler.h), the difference is what the stats cost.
+ *
+ * uncontended_<kind>    - lock + unlock (or release + wait) on a single thread, an item is a pair.
+ * contended_<kind>_t<n> - n threads hammering one lock around a tiny critical section, an item is an acquisition.
+ *                         The threads are started and joined inside the run.
+ * ping_pong_<kind>      - two threads handing a token back and forth, an item is a round trip. This is the sleep/wake
+ *                         path.
+ *
+ * flags: -max_threads=<n>, the contended cases double the thread count up to this.
+ */
+
+#define BENCH_UNCONTENDED_ITERATIONS (1000000)
+#define BENCH_CONTENDED_ITERATIONS   (200000)
+#define BENCH_PING_PONG_ROUNDS       (20000)
+#define BENCH_MAX_THREADS            (16)
+
+enum bench_lock_kind_t
+{
+    BLK_FutexMutex,
+    BLK_FutexReadLock,
+    BLK_FutexWriteLock,
+    BLK_SysMutex,
+    BLK_ProfiledMutex,
+    BLK_Count
+};
+
+global_variable const char *bench_lock_kind_names[BLK_Count] = {"futex_mutex", "futex_rw_read", "futex_rw_write", "sys_mutex", "profiled_mutex"};
+
+struct bench_locks_t
+{
+    futex_mutex_t      futex_mutex;
+    byte               _padding0[CACHE_LINE_SIZE];
+    futex_rwlock_t     rwlock;
+    byte               _padding1[CACHE_LINE_SIZE];
+    sys_mutex_t        sys_mutex;
+    byte               _padding2[CACHE_LINE_SIZE];
+    profiled_mutex_t   profiled_mutex;
+    byte               _padding3[CACHE_LINE_SIZE];
+
+    volatile u64       counter;
+    u32                lock_kind;
+    u32                iterations;
+
+    futex_auto_event_t ping;
+    futex_auto_event_t pong;
+    sys_semaphore_t    sys_ping;
+    sys_semaphore_t    sys_pong;
+};
+
+global_variable bench_locks_t bench_locks;
+
+internal_api inline void
+bench_lock(u32 lock_kind)
+{
+    switch(lock_kind)
+    {
+        case BLK_FutexMutex:     c_futex_mutex_lock(&bench_locks.futex_mutex);      break;
+        case BLK_FutexReadLock:  c_futex_rwlock_read_lock(&bench_locks.rwlock);     break;
+        case BLK_FutexWriteLock: c_futex_rwlock_write_lock(&bench_locks.rwlock);    break;
+        case BLK_SysMutex:       sys_mutex_lock(&bench_locks.sys_mutex, true);      break;
+        case BLK_ProfiledMutex:  c_profiled_mutex_lock(&bench_locks.profiled_mutex);  break;
+    }
+}
+
+internal_api inline void
+bench_unlock(u32 lock_kind)
+{
+    switch(lock_kind)
+    {
+        case BLK_FutexMutex:     c_futex_mutex_unlock(&bench_locks.futex_mutex);    break;
+        case BLK_FutexReadLock:  c_futex_rwlock_read_unlock(&bench_locks.rwlock);   break;
+        case BLK_FutexWriteLock: c_futex_rwlock_write_unlock(&bench_locks.rwlock);  break;
+        case BLK_SysMutex:       sys_mutex_unlock(&bench_locks.sys_mutex);          break;
+        case BLK_ProfiledMutex:  c_profiled_mutex_unlock(&bench_locks.profiled_mutex); break;
+    }
+}
+
+PLATFORM_THREAD_PROC(bench_contended_proc)
+{
+    u32 lock_kind = bench_locks.lock_kind;
+    for(u32 iteration = 0;
+        iteration < bench_locks.iterations;
+        ++iteration)
+    {
+        bench_lock(lock_kind);
+        bench_locks.counter += 1;
+        bench_unlock(lock_kind);
+    }
+
+    return(0);
+}
+
+PLATFORM_THREAD_PROC(bench_futex_pong_proc)
+{
+    for(u32 round = 0;
+        round < BENCH_PING_PONG_ROUNDS;
+        ++round)
+    {
+        c_futex_auto_event_wait(&bench_locks.ping);
+        c_futex_auto_event_signal(&bench_locks.pong);
+    }
+
+    return(0);
+}
+
+PLATFORM_THREAD_PROC(bench_sys_pong_proc)
+{
+    for(u32 round = 0;
+        round < BENCH_PING_PONG_ROUNDS;
+        ++round)
+    {
+        sys_semaphore_wait(&bench_locks.sys_ping, 0);
+        sys_semaphore_release(&bench_locks.sys_pong, 1);
+    }
+
+    return(0);
+}
+
+struct bench_contended_t
+{
+    u32 lock_kind;
+    u32 thread_count;
+};
+
+void
+bench_uncontended(void *user_data)
+{
+    u32 lock_kind = (u32)(usize)user_data;
+    for(u32 iteration = 0;
+        iteration < BENCH_UNCONTENDED_ITERATIONS;
+        ++iteration)
+    {
+        bench_lock(lock_kind);
+        bench_locks.counter += 1;
+        bench_unlock(lock_kind);
+    }
+}
+
+void
+bench_uncontended_futex_semaphore(void *user_data)
+{
+    futex_semaphore_t semaphore = {};
+    for(u32 iteration = 0;
+        iteration < BENCH_UNCONTENDED_ITERATIONS;
+        ++iteration)
+    {
+        c_futex_semaphore_release(&semaphore);
+        c_futex_semaphore_wait(&semaphore);
+    }
+}
+
+void
+bench_uncontended_sys_semaphore(void *user_data)
+{
+    for(u32 iteration = 0;
+        iteration < BENCH_UNCONTENDED_ITERATIONS;
+        ++iteration)
+    {
+        sys_semaphore_release(&bench_locks.sys_ping, 1);
+        sys_semaphore_wait(&bench_locks.sys_ping, 0);
+    }
+}
+
+void
+bench_contended_setup(void *user_data)
+{
+    bench_contended_t *contended = (bench_contended_t*)user_data;
+    bench_locks.counter    = 0;
+    bench_locks.lock_kind  = contended->lock_kind;
+    bench_locks.iterations = BENCH_CONTENDED_ITERATIONS / contended->thread_count;
+}
+
+void
+bench_contended(void *user_data)
+{
+    bench_contended_t *contended = (bench_contended_t*)user_data;
+
+    sys_thread_t threads[BENCH_MAX_THREADS];
+    for(u32 thread_index = 0;
+        thread_index < contended->thread_count;
+        ++thread_index)
+    {
+        threads[thread_index] = sys_thread_create(bench_contended_proc, null, false);
+    }
+    for(u32 thread_index = 0;
+        thread_index < contended->thread_count;
+        ++thread_index)
+    {
+        sys_thread_join(&threads[thread_index]);
+    }
+}
+
+void
+bench_contended_teardown(void *user_data)
+{
+    bench_contended_t *contended = (bench_contended_t*)user_data;
+    if(contended->lock_kind != BLK_FutexReadLock)
+    {
+        Assert(bench_locks.counter == (u64)bench_locks.iterations * contended->thread_count);
+    }
+}
+
+// NOTE(Sleepster): The pong thread is started before the clock and joined after it, only the round trips are timed.
+global_variable sys_thread_t bench_pong_thread;
+
+void
+bench_ping_pong_futex_setup(void *user_data)
+{
+    bench_pong_thread = sys_thread_create(bench_futex_pong_proc, null, false);
+}
+
+void
+bench_ping_pong_futex(void *user_data)
+{
+    for(u32 round = 0;
+        round < BENCH_PING_PONG_ROUNDS;
+        ++round)
+    {
+        c_futex_auto_event_signal(&bench_locks.ping);
+        c_futex_auto_event_wait(&bench_locks.pong);
+    }
+}
+
+void
+bench_ping_pong_sys_setup(void *user_data)
+{
+    bench_pong_thread = sys_thread_create(bench_sys_pong_proc, null, false);
+}
+
+void
+bench_ping_pong_sys(void *user_data)
+{
+    for(u32 round = 0;
+        round < BENCH_PING_PONG_ROUNDS;
+        ++round)
+    {
+        sys_semaphore_release(&bench_locks.sys_ping, 1);
+        sys_semaphore_wait(&bench_locks.sys_pong, 0);
+    }
+}
+
+void
+bench_ping_pong_teardown(void *user_data)
+{
+    sys_thread_join(&bench_pong_thread);
+}
+
+int
+main(int argc, char **argv)
+{
+    u64 *max_threads = c_program_flag_add_size("max_threads", 8, "The contended cases double the thread count up to this\n");
+
+    bench_suite_t *suite = (bench_suite_t*)calloc(1, sizeof(bench_suite_t));
+    bench_suite_init(suite, "futex_primitives", argc, argv);
+
+    u32 max_thread_count = (u32)*max_threads;
+    if(max_thread_count > BENCH_MAX_THREADS) max_thread_count = BENCH_MAX_THREADS;
+    if(max_thread_count < 1)                 max_thread_count = 1;
+
+    bench_locks.sys_mutex = sys_mutex_create();
+    bench_locks.sys_ping  = sys_semaphore_create(0, 2);
+    bench_locks.sys_pong  = sys_semaphore_create(0, 2);
+
+    char case_name[BENCH_NAME_LENGTH];
+    for(u32 lock_kind = 0;
+        lock_kind < BLK_Count;
+        ++lock_kind)
+    {
+        snprintf(case_name, sizeof(case_name), "uncontended_%s", bench_lock_kind_names[lock_kind]);
+        bench_case_t bench_case = {case_name, null, bench_uncontended, null, (void*)(usize)lock_kind, BENCH_UNCONTENDED_ITERATIONS, 0};
+        bench_suite_run(suite, &bench_case);
+    }
+
+    bench_case_t semaphore_cases[] =
+    {
+        {"uncontended_futex_semaphore", null, bench_uncontended_futex_semaphore, null, null, BENCH_UNCONTENDED_ITERATIONS, 0},
+        {"uncontended_sys_semaphore",   null, bench_uncontended_sys_semaphore,   null, null, BENCH_UNCONTENDED_ITERATIONS, 0},
+    };
+    for(u32 case_index = 0; case_index < ArrayCount(semaphore_cases); ++case_index)
+    {
+        bench_suite_run(suite, semaphore_cases + case_index);
+    }
+
+    for(u32 lock_kind = 0;
+        lock_kind < BLK_Count;
+        ++lock_kind)
+    {
+        for(u32 thread_count = 1; thread_count <= max_thread_count; thread_count *= 2)
+        {
+            bench_contended_t contended = {lock_kind, thread_count};
+            u64 acquisition_count = (u64)(BENCH_CONTENDED_ITERATIONS / thread_count) * thread_count;
+
+            snprintf(case_name, sizeof(case_name), "contended_%s_t%u", bench_lock_kind_names[lock_kind], thread_count);
+            bench_case_t bench_case = {case_name, bench_contended_setup, bench_contended, bench_contended_teardown, &contended,
+                                       acquisition_count, 0};
+            bench_suite_run(suite, &bench_case);
+        }
+    }
+
+    bench_case_t ping_pong_cases[] =
+    {
+        {"ping_pong_futex_event",   bench_ping_pong_futex_setup, bench_ping_pong_futex, bench_ping_pong_teardown, null, BENCH_PING_PONG_ROUNDS, 0},
+        {"ping_pong_sys_semaphore", bench_ping_pong_sys_setup,   bench_ping_pong_sys,   bench_ping_pong_teardown, null, BENCH_PING_PONG_ROUNDS, 0},
+    };
+    for(u32 case_index = 0; case_index < ArrayCount(ping_pong_cases); ++case_index)
+    {
+        bench_suite_run(suite, ping_pong_cases + case_index);
+    }
+
+    sys_semaphore_destroy(&bench_locks.sys_ping);
+    sys_semaphore_destroy(&bench_locks.sys_pong);
+    sys_mutex_free(&bench_locks.sys_mutex);
+
+    s32 result = bench_suite_finish(suite);
+    free(suite);
+
+    return(result);
+}
@@ -0,0 +1,159 @@
+/* ========================================================================
+   $File: suite_hash_table.cpp $
+   $Date: October 19 2026 05:20 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_string.h>
+
+#define HASH_TABLE_IMPLEMENTATION
+#include <c_hash_table.h>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_perf_counters.cpp>
+
+#include <benchmarks/bench_harness.h>
+
+/* NOTE(Sleepster): HashTable_t with string keys, the way the asset manager keys things by name.
+ *
+ * insert   - every key into an empty table.
+ * lookup   - every key out of a full table.
+ * fnv_64b  - just c_fnv_hash_value() over 64 byte keys, bytes per second is the hash's throughput.
+ *
+ * The keys look like asset paths, 'res/textures/asset_<n>.png', and are built once up front.
+ */
+
+#define BENCH_HASH_KEY_COUNT   (8192)
+#define BENCH_HASH_TABLE_SIZE  (16384)
+#define BENCH_HASH_LONG_KEY    (64)
+
+struct bench_hash_value_t
+{
+    u32 asset_id;
+    u32 generation;
+    u64 offset;
+};
+
+struct bench_hash_table_t
+{
+    HashTable_t(bench_hash_value_t) table;
+    memory_arena_t                  key_arena;
+    string_t                        keys[BENCH_HASH_KEY_COUNT];
+    string_t                        long_keys[BENCH_HASH_KEY_COUNT];
+    u64                             key_bytes;
+};
+
+void
+bench_hash_clear(void *user_data)
+{
+    bench_hash_table_t *bench = (bench_hash_table_t*)user_data;
+    memset(bench->table.data, 0, sizeof(bench_hash_value_t) * bench->table.header.max_entries);
+    memset(bench->table.keys, 0, sizeof(string_t) * bench->table.header.max_entries);
+    bench->table.header.current_entry_count = 0;
+}
+
+void
+bench_hash_insert(void *user_data)
+{
+    bench_hash_table_t *bench = (bench_hash_table_t*)user_data;
+    for(u32 key_index = 0; key_index < BENCH_HASH_KEY_COUNT; ++key_index)
+    {
+        bench_hash_value_t value = {key_index, 1, (u64)key_index * 64};
+        c_hash_table_insert_pair(&bench->table, bench->keys[key_index], value);
+    }
+    bench_consume(bench->table.header.current_entry_count);
+}
+
+void
+bench_hash_lookup(void *user_data)
+{
+    bench_hash_table_t *bench = (bench_hash_table_t*)user_data;
+    u64 checksum = 0;
+    for(u32 key_index = 0; key_index < BENCH_HASH_KEY_COUNT; ++key_index)
+    {
+        bench_hash_value_t *value = c_hash_table_get_value_ptr(&bench->table, bench->keys[key_index]);
+        checksum += value->offset;
+    }
+    bench_consume(checksum);
+}
+
+void
+bench_hash_fnv(void *user_data)
+{
+    bench_hash_table_t *bench = (bench_hash_table_t*)user_data;
+    u64 checksum = 0;
+    for(u32 key_index = 0; key_index < BENCH_HASH_KEY_COUNT; ++key_index)
+    {
+        string_t key = bench->long_keys[key_index];
+        checksum ^= c_fnv_hash_value(key.data, (u32)key.count);
+    }
+    bench_consume(checksum);
+}
+
+int
+main(int argc, char **argv)
+{
+    bench_suite_t *suite = (bench_suite_t*)calloc(1, sizeof(bench_suite_t));
+    bench_suite_init(suite, "hash_table", argc, argv);
+
+    bench_hash_table_t *bench = (bench_hash_table_t*)calloc(1, sizeof(bench_hash_table_t));
+    c_hash_table_init(&bench->table, BENCH_HASH_TABLE_SIZE);
+    bench->key_arena = c_arena_create(MB(2));
+
+    // NOTE(Sleepster): The table asserts on slot 0, names that hash there are skipped.
+    u32 name_index = 0;
+    for(u32 key_index = 0; key_index < BENCH_HASH_KEY_COUNT; ++key_index)
+    {
+        char *key = (char*)c_arena_push_size(&bench->key_arena, 48);
+        u32 key_length = 0;
+        do
+        {
+            key_length = (u32)snprintf(key, 48, "res/textures/asset_%u.png", name_index++);
+        }while(c_hash_table_value_from_key((byte*)key, key_length, BENCH_HASH_TABLE_SIZE) == 0);
+
+        bench->keys[key_index] = c_string_create_with_length((byte*)key, key_length);
+        bench->key_bytes      += key_length;
+
+        byte *long_key = c_arena_push_size(&bench->key_arena, BENCH_HASH_LONG_KEY);
+        memset(long_key, 'a' + (key_index % 26), BENCH_HASH_LONG_KEY);
+        memcpy(long_key, key, key_length);
+        bench->long_keys[key_index] = c_string_create_with_length(long_key, BENCH_HASH_LONG_KEY);
+    }
+
+    bench_case_t insert_case = {"insert", bench_hash_clear, bench_hash_insert, null, bench, BENCH_HASH_KEY_COUNT, bench->key_bytes};
+    bench_case_t lookup_case = {"lookup", null, bench_hash_lookup, null, bench, BENCH_HASH_KEY_COUNT, bench->key_bytes};
+    bench_case_t fnv_case    = {"fnv_64b", null, bench_hash_fnv, null, bench, BENCH_HASH_KEY_COUNT, BENCH_HASH_KEY_COUNT * BENCH_HASH_LONG_KEY};
+    bench_suite_run(suite, &insert_case);
+
+    // NOTE(Sleepster): Filled here too so '-filter=lookup' works on its own.
+    bench_hash_insert(bench);
+    bench_suite_run(suite, &lookup_case);
+    bench_suite_run(suite, &fnv_case);
+
+    c_arena_destroy(&bench->key_arena);
+    free(bench->table.data);
+    free(bench->table.keys);
+    free(bench);
+
+    s32 result = bench_suite_finish(suite);
+    free(suite);
+
+    return(result);
+}
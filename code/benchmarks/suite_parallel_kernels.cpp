@@ -0,0 +1,366 @@
+/* ========================================================================
+   $File: suite_parallel_kernels.cpp $
+   $Date: October 18 2026 06:15 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_threadpool.h>
+#include <c_threadpool.cpp>
+#include <c_parallel.h>
+#include <c_parallel.cpp>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_sampler.cpp>
+#include <c_perf_counters.cpp>
+
+#include <benchmarks/bench_harness.h>
+
+/* NOTE(Sleepster): c_parallel_for/c_parallel_reduce on the kinds of loops the engine actually has.
+ *
+ * atlas_blit - row memcpys, same shape as s_texture_atlas_pack_added_textures(). Bandwidth bound.
+ * transform  - SSE mat4 * vec4 per instance, like filling the instance buffers. Compute bound.
+ * entities   - data dependent switch/branches per entity, like the entity update. Branch bound.
+ * reduce     - sum + max over the entity health with c_parallel_reduce().
+ *
+ * Every kernel runs once serially ('_serial'), then at each grain size ('_g<grain>') with the caller taking part in
+ * the loop ('_participating') and with the caller only waiting ('_waiting'). The speedup is the serial median over
+ * the parallel one.
+ *
+ * flags: -threads=<n>, 0 is the threadpool's default.
+ */
+
+#define BENCH_ATLAS_SIZE     (2048)
+#define BENCH_ATLAS_CHANNEL  (4)
+#define BENCH_INSTANCES      (1 << 20)
+#define BENCH_ENTITIES       (1 << 20)
+#define BENCH_REDUCE_GRAIN   (16384)
+#define BENCH_MAX_KERNELS    (32)
+
+struct bench_blit_t
+{
+    byte *destination;
+    byte *source;
+    u32   stride;
+};
+
+struct bench_transform_t
+{
+    float32 *matrix;
+    float32 *positions;
+    float32 *results;
+};
+
+struct bench_entity_t
+{
+    u32     type;
+    u32     flags;
+    float32 position[2];
+    float32 velocity[2];
+    float32 health;
+    float32 timer;
+};
+
+struct bench_health_t
+{
+    float64 total;
+    float32 highest;
+};
+
+void
+bench_blit_rows(void *user_data, u64 begin, u64 end)
+{
+    bench_blit_t *blit = (bench_blit_t*)user_data;
+    for(u64 row_index = begin;
+        row_index < end;
+        ++row_index)
+    {
+        memcpy(blit->destination + (row_index * blit->stride), blit->source + (row_index * blit->stride), blit->stride);
+    }
+}
+
+void
+bench_transform_instances(void *user_data, u64 begin, u64 end)
+{
+    bench_transform_t *transform = (bench_transform_t*)user_data;
+    __m128 column0 = _mm_loadu_ps(transform->matrix + 0);
+    __m128 column1 = _mm_loadu_ps(transform->matrix + 4);
+    __m128 column2 = _mm_loadu_ps(transform->matrix + 8);
+    __m128 column3 = _mm_loadu_ps(transform->matrix + 12);
+    for(u64 instance_index = begin;
+        instance_index < end;
+        ++instance_index)
+    {
+        float32 *position = transform->positions + (instance_index * 4);
+        __m128 result = _mm_mul_ps(column0, _mm_set1_ps(position[0]));
+        result = _mm_add_ps(result, _mm_mul_ps(column1, _mm_set1_ps(position[1])));
+        result = _mm_add_ps(result, _mm_mul_ps(column2, _mm_set1_ps(position[2])));
+        result = _mm_add_ps(result, _mm_mul_ps(column3, _mm_set1_ps(position[3])));
+        _mm_storeu_ps(transform->results + (instance_index * 4), result);
+    }
+}
+
+void
+bench_update_entities(void *user_data, u64 begin, u64 end)
+{
+    bench_entity_t *entities = (bench_entity_t*)user_data;
+    for(u64 entity_index = begin;
+        entity_index < end;
+        ++entity_index)
+    {
+        bench_entity_t *entity = entities + entity_index;
+        switch(entity->type)
+        {
+            case 0:
+            {
+                entity->position[0] += entity->velocity[0];
+                entity->position[1] += entity->velocity[1];
+            }break;
+            case 1:
+            {
+                if(entity->flags & 1) entity->health -= 1.0f;
+                else                  entity->health += 0.5f;
+            }break;
+            case 2:
+            {
+                entity->timer -= 1.0f / 60.0f;
+                if(entity->timer < 0.0f)
+                {
+                    entity->timer  = 1.0f;
+                    entity->flags ^= 2;
+                }
+            }break;
+            default:
+            {
+                if(entity->position[0] > 100.0f && (entity->flags & 4))
+                {
+                    entity->velocity[0] = -entity->velocity[0];
+                }
+            }break;
+        }
+    }
+}
+
+void
+bench_sum_health(void *user_data, u64 begin, u64 end, void *partial_result)
+{
+    bench_entity_t *entities = (bench_entity_t*)user_data;
+    bench_health_t *health   = (bench_health_t*)partial_result;
+    for(u64 entity_index = begin;
+        entity_index < end;
+        ++entity_index)
+    {
+        float32 value = entities[entity_index].health;
+        health->total += value;
+        if(value > health->highest) health->highest = value;
+    }
+}
+
+void
+bench_combine_health(void *user_data, void *result, void *partial_result)
+{
+    bench_health_t *health  = (bench_health_t*)result;
+    bench_health_t *partial = (bench_health_t*)partial_result;
+    health->total += partial->total;
+    if(partial->highest > health->highest) health->highest = partial->highest;
+}
+
+enum bench_run_mode_t
+{
+    BRM_Serial,
+    BRM_Participating,
+    BRM_Waiting,
+    BRM_Count
+};
+
+global_variable const char *bench_run_mode_names[BRM_Count] = {"serial", "participating", "waiting"};
+
+struct bench_kernel_t
+{
+    threadpool_t            *pool;
+    u32                      mode;
+    u64                      count;
+    u64                      grain_size;
+    parallel_for_callback_t *callback;
+    void                    *user_data;
+};
+
+struct bench_kernels_t
+{
+    threadpool_t    pool;
+    bench_kernel_t  kernels[BENCH_MAX_KERNELS];
+    u32             kernel_count;
+    char            case_name[BENCH_NAME_LENGTH];
+
+    bench_entity_t *entities;
+    bench_health_t  health;
+};
+
+void
+bench_kernel_run(void *user_data)
+{
+    bench_kernel_t *kernel = (bench_kernel_t*)user_data;
+    switch(kernel->mode)
+    {
+        case BRM_Serial:        kernel->callback(kernel->user_data, 0, kernel->count);                                                                  break;
+        case BRM_Participating: c_parallel_for(kernel->pool, 0, kernel->count, kernel->grain_size, kernel->callback, kernel->user_data, PF_CallerParticipates); break;
+        case BRM_Waiting:       c_parallel_for(kernel->pool, 0, kernel->count, kernel->grain_size, kernel->callback, kernel->user_data, PF_None);               break;
+    }
+}
+
+void
+bench_reduce_serial(void *user_data)
+{
+    bench_kernels_t *bench = (bench_kernels_t*)user_data;
+    ZeroStruct(bench->health);
+    bench_sum_health(bench->entities, 0, BENCH_ENTITIES, &bench->health);
+}
+
+void
+bench_reduce_parallel(void *user_data)
+{
+    bench_kernels_t *bench = (bench_kernels_t*)user_data;
+    ZeroStruct(bench->health);
+    c_parallel_reduce(&bench->pool, 0, BENCH_ENTITIES, BENCH_REDUCE_GRAIN, &bench_sum_health, &bench_combine_health,
+                      bench->entities, &bench->health, sizeof(bench->health));
+}
+
+internal_api void
+bench_run_kernel(bench_suite_t *suite, bench_kernels_t *bench, const char *name, u32 mode, u64 count, u64 grain_size,
+                 parallel_for_callback_t *callback, void *user_data, u64 bytes_per_run)
+{
+    Assert(bench->kernel_count < BENCH_MAX_KERNELS);
+    bench_kernel_t *kernel = bench->kernels + bench->kernel_count++;
+    kernel->pool       = &bench->pool;
+    kernel->mode       = mode;
+    kernel->count      = count;
+    kernel->grain_size = grain_size;
+    kernel->callback   = callback;
+    kernel->user_data  = user_data;
+
+    if(mode == BRM_Serial) snprintf(bench->case_name, BENCH_NAME_LENGTH, "%s_serial", name);
+    else                   snprintf(bench->case_name, BENCH_NAME_LENGTH, "%s_g%llu_%s", name, (unsigned long long)grain_size, bench_run_mode_names[mode]);
+
+    bench_case_t bench_case = {bench->case_name, null, bench_kernel_run, null, kernel, count, bytes_per_run};
+    bench_suite_run(suite, &bench_case);
+}
+
+internal_api void
+bench_run_kernel_grains(bench_suite_t *suite, bench_kernels_t *bench, const char *name, u64 count, u64 *grains, u32 grain_count,
+                        parallel_for_callback_t *callback, void *user_data, u64 bytes_per_run)
+{
+    bench_run_kernel(suite, bench, name, BRM_Serial, count, count, callback, user_data, bytes_per_run);
+    for(u32 grain_index = 0; grain_index < grain_count; ++grain_index)
+    {
+        bench_run_kernel(suite, bench, name, BRM_Participating, count, grains[grain_index], callback, user_data, bytes_per_run);
+        bench_run_kernel(suite, bench, name, BRM_Waiting,       count, grains[grain_index], callback, user_data, bytes_per_run);
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+    u64 *thread_count = c_program_flag_add_size("threads", 0, "Worker threads, 0 is the threadpool's default\n");
+
+    bench_suite_t *suite = (bench_suite_t*)calloc(1, sizeof(bench_suite_t));
+    bench_suite_init(suite, "parallel_kernels", argc, argv);
+
+    bench_kernels_t *bench = (bench_kernels_t*)calloc(1, sizeof(bench_kernels_t));
+    c_threadpool_init(&bench->pool, (u32)*thread_count);
+
+    usize atlas_bytes = BENCH_ATLAS_SIZE * BENCH_ATLAS_SIZE * BENCH_ATLAS_CHANNEL;
+    bench_blit_t blit;
+    blit.destination = (byte*)sys_allocate_memory(atlas_bytes);
+    blit.source      = (byte*)sys_allocate_memory(atlas_bytes);
+    blit.stride      = BENCH_ATLAS_SIZE * BENCH_ATLAS_CHANNEL;
+    memset(blit.source, 0x7F, atlas_bytes);
+    memset(blit.destination, 0, atlas_bytes);
+
+    float32 matrix[16] = {1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  4, 5, 6, 1};
+    bench_transform_t transform;
+    transform.matrix    = matrix;
+    transform.positions = (float32*)sys_allocate_memory(sizeof(float32) * 4 * BENCH_INSTANCES);
+    transform.results   = (float32*)sys_allocate_memory(sizeof(float32) * 4 * BENCH_INSTANCES);
+    for(u32 instance_index = 0;
+        instance_index < BENCH_INSTANCES * 4;
+        ++instance_index)
+    {
+        transform.positions[instance_index] = (float32)(instance_index & 255);
+    }
+
+    bench_entity_t *entities = (bench_entity_t*)sys_allocate_memory(sizeof(bench_entity_t) * BENCH_ENTITIES);
+    u32 random_state = 0x1234567;
+    for(u32 entity_index = 0;
+        entity_index < BENCH_ENTITIES;
+        ++entity_index)
+    {
+        random_state = bench_spin_work(random_state, 1);
+
+        bench_entity_t *entity = entities + entity_index;
+        entity->type        = random_state & 3;
+        entity->flags       = (random_state >> 2) & 7;
+        entity->position[0] = (float32)((random_state >> 8) & 255);
+        entity->velocity[0] = 1.0f;
+        entity->health      = (float32)((random_state >> 16) & 127);
+        entity->timer       = 1.0f;
+    }
+    bench->entities = entities;
+
+    u64 blit_grains[]      = {8, 64, 256};
+    u64 transform_grains[] = {1024, 16384, 65536};
+    u64 entity_grains[]    = {1024, 16384, 65536};
+    bench_run_kernel_grains(suite, bench, "atlas_blit", BENCH_ATLAS_SIZE, blit_grains, ArrayCount(blit_grains),
+                            &bench_blit_rows, &blit, atlas_bytes);
+    bench_run_kernel_grains(suite, bench, "transform", BENCH_INSTANCES, transform_grains, ArrayCount(transform_grains),
+                            &bench_transform_instances, &transform, sizeof(float32) * 8 * BENCH_INSTANCES);
+    bench_run_kernel_grains(suite, bench, "entities", BENCH_ENTITIES, entity_grains, ArrayCount(entity_grains),
+                            &bench_update_entities, entities, sizeof(bench_entity_t) * BENCH_ENTITIES);
+
+    bench_case_t reduce_cases[] =
+    {
+        {"reduce_serial", null, bench_reduce_serial,   null, bench, BENCH_ENTITIES, sizeof(bench_entity_t) * BENCH_ENTITIES},
+        {"reduce_g16384", null, bench_reduce_parallel, null, bench, BENCH_ENTITIES, sizeof(bench_entity_t) * BENCH_ENTITIES},
+    };
+    for(u32 case_index = 0; case_index < ArrayCount(reduce_cases); ++case_index)
+    {
+        bench_suite_run(suite, reduce_cases + case_index);
+    }
+
+    // NOTE(Sleepster): Outside of the clock, the parallel reduce has to agree with the serial one.
+    bench_health_t serial_health = {};
+    bench_sum_health(entities, 0, BENCH_ENTITIES, &serial_health);
+    bench_reduce_parallel(bench);
+    Assert(serial_health.total   == bench->health.total);
+    Assert(serial_health.highest == bench->health.highest);
+
+    sys_free_memory(entities, sizeof(bench_entity_t) * BENCH_ENTITIES);
+    sys_free_memory(transform.results, sizeof(float32) * 4 * BENCH_INSTANCES);
+    sys_free_memory(transform.positions, sizeof(float32) * 4 * BENCH_INSTANCES);
+    sys_free_memory(blit.source, atlas_bytes);
+    sys_free_memory(blit.destination, atlas_bytes);
+
+    c_threadpool_destroy(&bench->pool);
+    free(bench);
+
+    s32 result = bench_suite_finish(suite);
+    free(suite);
+
+    return(result);
+}
@@ -0,0 +1,149 @@
+/* ========================================================================
+   $File: suite_profiler_overhead.cpp $
+   $Date: October 19 2026 12:50 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_profiler.h>
+#include <c_profiler.cpp>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_perf_counters.cpp>
+
+#include <benchmarks/bench_harness.h>
+
+/* NOTE(Sleepster): What a PROFILE_SCOPE costs, the budget is 20 ns per zone. An item is one zone.
+ *
+ * empty  - the same loop without the zone, subtract its ns/item from the others.
+ * rdtsc  - one rdtsc per iteration. Every zone reads it twice, under a hypervisor that can be most of the cost.
+ * flat   - one zone per iteration.
+ * nested - four zones deep per iteration.
+ *
+ * A run is a frame of BENCH_ZONES_PER_FRAME zones, the frame is ended in the teardown so the ring never fills and the
+ * collapse isn't timed. Build with PROFILER_ENABLED=0 to check that the zones really compile down to the empty loop.
+ */
+
+#define BENCH_ZONES_PER_FRAME (4096)
+
+global_variable volatile u32 bench_sink;
+
+internal_api NO_INLINE void
+bench_loop_empty(u32 iteration_count)
+{
+    for(u32 iteration = 0; iteration < iteration_count; ++iteration)
+    {
+        bench_sink = iteration;
+    }
+}
+
+internal_api NO_INLINE void
+bench_loop_rdtsc(u32 iteration_count)
+{
+    for(u32 iteration = 0; iteration < iteration_count; ++iteration)
+    {
+        bench_sink = (u32)rdtsc();
+    }
+}
+
+internal_api NO_INLINE void
+bench_loop_flat(u32 iteration_count)
+{
+    for(u32 iteration = 0; iteration < iteration_count; ++iteration)
+    {
+        PROFILE_SCOPE("flat");
+        bench_sink = iteration;
+    }
+}
+
+internal_api NO_INLINE void
+bench_loop_nested(u32 iteration_count)
+{
+    for(u32 iteration = 0; iteration < iteration_count; ++iteration)
+    {
+        PROFILE_SCOPE("nested_0");
+        {
+            PROFILE_SCOPE("nested_1");
+            {
+                PROFILE_SCOPE("nested_2");
+                {
+                    PROFILE_SCOPE("nested_3");
+                    bench_sink = iteration;
+                }
+            }
+        }
+    }
+}
+
+void
+bench_profiler_empty(void *user_data)
+{
+    bench_loop_empty(BENCH_ZONES_PER_FRAME);
+}
+
+void
+bench_profiler_rdtsc(void *user_data)
+{
+    bench_loop_rdtsc(BENCH_ZONES_PER_FRAME);
+}
+
+void
+bench_profiler_flat(void *user_data)
+{
+    bench_loop_flat(BENCH_ZONES_PER_FRAME);
+}
+
+void
+bench_profiler_nested(void *user_data)
+{
+    bench_loop_nested(BENCH_ZONES_PER_FRAME / 4);
+}
+
+void
+bench_profiler_frame_end(void *user_data)
+{
+    PROFILE_FRAME_END();
+}
+
+int
+main(int argc, char **argv)
+{
+    bench_suite_t *suite = (bench_suite_t*)calloc(1, sizeof(bench_suite_t));
+    bench_suite_init(suite, "profiler_overhead", argc, argv);
+
+    PROFILE_SET_THREAD_NAME("main");
+    PROFILE_FRAME_END();
+
+    bench_case_t cases[] =
+    {
+        {"empty",  null, bench_profiler_empty,  bench_profiler_frame_end, null, BENCH_ZONES_PER_FRAME, 0},
+        {"rdtsc",  null, bench_profiler_rdtsc,  bench_profiler_frame_end, null, BENCH_ZONES_PER_FRAME, 0},
+        {"flat",   null, bench_profiler_flat,   bench_profiler_frame_end, null, BENCH_ZONES_PER_FRAME, 0},
+        {"nested", null, bench_profiler_nested, bench_profiler_frame_end, null, BENCH_ZONES_PER_FRAME, 0},
+    };
+    for(u32 case_index = 0; case_index < ArrayCount(cases); ++case_index)
+    {
+        bench_suite_run(suite, cases + case_index);
+    }
+
+    s32 result = bench_suite_finish(suite);
+    free(suite);
+
+    return(result);
+}
@@ -0,0 +1,269 @@
+/* ========================================================================
+   $File: suite_queue_throughput.cpp $
+   $Date: October 18 2026 10:05 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_futex.h>
+#include <c_queue.h>
+#include <c_queue.cpp>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_perf_counters.cpp>
+
+#include <benchmarks/bench_harness.h>
+
+/* NOTE(Sleepster): Items per second through c_queue.h for every kind, one at a time ('_x1') and in batches ('_x32'),
+ * against a plain ring buffer behind a futex_mutex_t ('locked'). Items are 16 bytes, about the size of a file watcher
+ * event or a log record handle. A run starts the producers and consumers, and ends when they've all been joined.
+ *
+ * flags: -items_per_producer=<n>
+ */
+
+#define BENCH_QUEUE_CAPACITY              (1024)
+#define BENCH_MAX_THREADS                 (8)
+#define BENCH_BATCH_SIZE                  (32)
+#define BENCH_DEFAULT_ITEMS_PER_PRODUCER  (100000)
+
+struct bench_item_t
+{
+    u64 value;
+    u64 payload;
+};
+
+// NOTE(Sleepster): The baseline, what you'd write without the queue.
+struct bench_locked_ring_t
+{
+    futex_mutex_t mutex;
+    u32           read_index;
+    u32           write_index;
+    bench_item_t  items[BENCH_QUEUE_CAPACITY];
+};
+
+struct bench_run_t
+{
+    queue_t             queue;
+    bench_locked_ring_t ring;
+
+    bool8               use_ring;
+    u32                 batch_size;
+    u32                 items_per_producer;
+    u32                 producer_count;
+    volatile u32        items_consumed;
+    byte                _padding[CACHE_LINE_SIZE];
+    volatile u64        checksum;
+};
+
+global_variable bench_run_t bench_run;
+
+internal_api inline void
+bench_backoff(u32 *failed_attempts)
+{
+    if(++(*failed_attempts) < 64) _mm_pause();
+    else                          sys_thread_yield();
+}
+
+internal_api u32
+bench_ring_push(bench_locked_ring_t *ring, bench_item_t *items, u32 item_count)
+{
+    c_futex_mutex_lock(&ring->mutex);
+    u32 free_slots = BENCH_QUEUE_CAPACITY - (ring->write_index - ring->read_index);
+    u32 result     = item_count < free_slots ? item_count : free_slots;
+    for(u32 item_index = 0; item_index < result; ++item_index)
+    {
+        ring->items[(ring->write_index++) & (BENCH_QUEUE_CAPACITY - 1)] = items[item_index];
+    }
+    c_futex_mutex_unlock(&ring->mutex);
+
+    return(result);
+}
+
+internal_api u32
+bench_ring_pop(bench_locked_ring_t *ring, bench_item_t *items, u32 max_item_count)
+{
+    c_futex_mutex_lock(&ring->mutex);
+    u32 used_slots = ring->write_index - ring->read_index;
+    u32 result     = max_item_count < used_slots ? max_item_count : used_slots;
+    for(u32 item_index = 0; item_index < result; ++item_index)
+    {
+        items[item_index] = ring->items[(ring->read_index++) & (BENCH_QUEUE_CAPACITY - 1)];
+    }
+    c_futex_mutex_unlock(&ring->mutex);
+
+    return(result);
+}
+
+PLATFORM_THREAD_PROC(bench_producer_proc)
+{
+    bench_item_t batch[BENCH_BATCH_SIZE];
+    u32 produced = 0;
+    while(produced < bench_run.items_per_producer)
+    {
+        u32 batch_size = bench_run.batch_size;
+        if(batch_size > bench_run.items_per_producer - produced) batch_size = bench_run.items_per_producer - produced;
+        for(u32 item_index = 0; item_index < batch_size; ++item_index)
+        {
+            batch[item_index].value   = produced + item_index;
+            batch[item_index].payload = 0;
+        }
+
+        u32 pushed          = 0;
+        u32 failed_attempts = 0;
+        while(pushed < batch_size)
+        {
+            u32 pushed_now = bench_run.use_ring ? bench_ring_push(&bench_run.ring, batch + pushed, batch_size - pushed) :
+                                                  c_queue_push_batch(&bench_run.queue, batch + pushed, batch_size - pushed);
+            if(pushed_now == 0) bench_backoff(&failed_attempts);
+            pushed += pushed_now;
+        }
+        produced += batch_size;
+    }
+
+    return(0);
+}
+
+PLATFORM_THREAD_PROC(bench_consumer_proc)
+{
+    bench_item_t batch[BENCH_BATCH_SIZE];
+    u64 checksum    = 0;
+    u32 total_items     = bench_run.items_per_producer * bench_run.producer_count;
+    u32 failed_attempts = 0;
+    while(AtomicLoad32(&bench_run.items_consumed) < total_items)
+    {
+        u32 popped = bench_run.use_ring ? bench_ring_pop(&bench_run.ring, batch, bench_run.batch_size) :
+                                          c_queue_pop_batch(&bench_run.queue, batch, bench_run.batch_size);
+        if(popped == 0)
+        {
+            bench_backoff(&failed_attempts);
+            continue;
+        }
+        failed_attempts = 0;
+
+        for(u32 item_index = 0; item_index < popped; ++item_index)
+        {
+            checksum += batch[item_index].value;
+        }
+        AtomicExchangeAdd32(&bench_run.items_consumed, popped);
+    }
+    AtomicExchangeAdd64(&bench_run.checksum, checksum);
+
+    return(0);
+}
+
+struct bench_queue_config_t
+{
+    u32   kind;
+    bool8 use_ring;
+    u32   producer_count;
+    u32   consumer_count;
+    u32   batch_size;
+    u32   items_per_producer;
+};
+
+void
+bench_queue_setup(void *user_data)
+{
+    bench_queue_config_t *config = (bench_queue_config_t*)user_data;
+    bench_run.use_ring           = config->use_ring;
+    bench_run.batch_size         = config->batch_size;
+    bench_run.items_per_producer = config->items_per_producer;
+    bench_run.producer_count     = config->producer_count;
+    bench_run.items_consumed     = 0;
+    bench_run.checksum           = 0;
+    ZeroStruct(bench_run.ring);
+    c_queue_create_typed(&bench_run.queue, config->kind, bench_item_t, BENCH_QUEUE_CAPACITY);
+}
+
+void
+bench_queue_throughput(void *user_data)
+{
+    bench_queue_config_t *config = (bench_queue_config_t*)user_data;
+
+    sys_thread_t threads[BENCH_MAX_THREADS * 2];
+    u32 thread_count = 0;
+    for(u32 index = 0; index < config->consumer_count; ++index) threads[thread_count++] = sys_thread_create(bench_consumer_proc, null, false);
+    for(u32 index = 0; index < config->producer_count; ++index) threads[thread_count++] = sys_thread_create(bench_producer_proc, null, false);
+    for(u32 index = 0; index < thread_count;           ++index) sys_thread_join(&threads[index]);
+}
+
+void
+bench_queue_teardown(void *user_data)
+{
+    bench_queue_config_t *config = (bench_queue_config_t*)user_data;
+
+    u64 expected_checksum = (((u64)config->items_per_producer * (config->items_per_producer - 1)) / 2) * config->producer_count;
+    Assert(bench_run.checksum == expected_checksum);
+    c_queue_destroy(&bench_run.queue);
+}
+
+int
+main(int argc, char **argv)
+{
+    u64 *items_per_producer = c_program_flag_add_size("items_per_producer", BENCH_DEFAULT_ITEMS_PER_PRODUCER, "Items every producer pushes in a run\n");
+
+    bench_suite_t *suite = (bench_suite_t*)calloc(1, sizeof(bench_suite_t));
+    bench_suite_init(suite, "queue_throughput", argc, argv);
+
+    struct bench_queue_shape_t
+    {
+        const char *name;
+        u32         kind;
+        u32         producer_count;
+        u32         consumer_count;
+    };
+    bench_queue_shape_t shapes[] =
+    {
+        {"spsc_1_1", QK_SPSC, 1, 1},
+        {"mpsc_4_1", QK_MPSC, 4, 1},
+        {"mpmc_4_4", QK_MPMC, 4, 4},
+        {"mpmc_8_8", QK_MPMC, 8, 8},
+    };
+
+    for(u32 shape_index = 0;
+        shape_index < ArrayCount(shapes);
+        ++shape_index)
+    {
+        bench_queue_shape_t *shape = shapes + shape_index;
+        for(u32 variant = 0; variant < 4; ++variant)
+        {
+            bench_queue_config_t config = {};
+            config.kind               = shape->kind;
+            config.use_ring           = variant >= 2;
+            config.producer_count     = shape->producer_count;
+            config.consumer_count     = shape->consumer_count;
+            config.batch_size         = (variant & 1) ? BENCH_BATCH_SIZE : 1;
+            config.items_per_producer = (u32)*items_per_producer;
+
+            char case_name[BENCH_NAME_LENGTH];
+            snprintf(case_name, sizeof(case_name), "%s_%s_x%u", shape->name, config.use_ring ? "locked" : "queue", config.batch_size);
+
+            u64 item_count = (u64)config.items_per_producer * config.producer_count;
+            bench_case_t bench_case = {case_name, bench_queue_setup, bench_queue_throughput, bench_queue_teardown, &config,
+                                       item_count, item_count * sizeof(bench_item_t)};
+            bench_suite_run(suite, &bench_case);
+        }
+    }
+
+    s32 result = bench_suite_finish(suite);
+    free(suite);
+
+    return(result);
+}
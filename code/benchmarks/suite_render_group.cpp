@@ -0,0 +1,305 @@
+/* ========================================================================
+   $File: suite_render_group.cpp $
+   $Date: October 19 2026 09:40 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+
+#define MATH_IMPLEMENTATION
+#define HASH_TABLE_IMPLEMENTATION
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_hash_table.h>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_memory_telemetry.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_perf_counters.cpp>
+
+#include <r_vulkan_types.h>
+#include <r_render_group.h>
+#include <r_render_group.cpp>
+
+#include <benchmarks/bench_harness.h>
+
+/* NOTE(Sleepster): The CPU half of drawing, everything before Vulkan. The render state runs off a zeroed render
+ * context, no device is made and nothing is submitted. A run is one frame of a synthetic scene, an item is one
+ * sprite pushed, and the bytes are the instances written that frame (the push, and the fill's copy in fill_100k).
+ * Every scene is 100k sprites over 4 render layers, a group can only take 100k instances.
+ *
+ * push_100k       - one texture, one camera, one shader. The floor: a transform and an instance per sprite.
+ * push_15_atlases - every sprite from a different atlas than the last, a group's texture scan at its longest.
+ * push_16_cameras - the camera changes every 64 sprites. Every push hashes the active camera, and every change is
+ *                   a new draw state, so a new group.
+ * push_16_shaders - the shader changes every 256 sprites, r_render_group_begin() hashing the draw state and looking
+ *                   for the group in the used list.
+ * fill_100k       - r_render_group_update_used_groups() over push_100k's frame, the copy into the master arrays.
+ *
+ * The frame reset r_frame_packet_capture() does runs untimed between frames.
+ */
+
+#define BENCH_RENDER_SPRITES        (100000)
+#define BENCH_RENDER_LAYERS         (4)
+#define BENCH_RENDER_ATLASES        (MAX_RENDER_GROUP_BOUND_TEXTURES - 1)
+#define BENCH_RENDER_SUBTEXTURES    (1024)
+#define BENCH_RENDER_CAMERAS        (16)
+#define BENCH_RENDER_CAMERA_RUN     (64)
+#define BENCH_RENDER_SHADERS        (16)
+#define BENCH_RENDER_SHADER_RUN     (256)
+#define BENCH_RENDER_ATLAS_SIZE     (2048)
+
+typedef enum bench_render_scene
+{
+    BRS_Sprites,
+    BRS_Atlases,
+    BRS_Cameras,
+    BRS_Shaders,
+}bench_render_scene_t;
+
+struct bench_render_sprite_t
+{
+    vec2_t position;
+    vec2_t size;
+    vec4_t color;
+};
+
+struct bench_render_t
+{
+    vulkan_render_context_t *render_context;
+    render_state_t          *render_state;
+
+    bench_render_sprite_t   *sprites;
+    texture_atlas_t         *atlases;
+    subtexture_data_t       *subtextures;
+    render_camera_t          cameras[BENCH_RENDER_CAMERAS];
+    asset_handle_t           shaders[BENCH_RENDER_SHADERS];
+
+    bench_render_scene_t     scene;
+    u64                      pushed_count;
+};
+
+internal_api void
+bench_render_init(bench_render_t *bench)
+{
+    u64 random_state = 0xA0761D6478BD642FULL;
+
+    bench->render_context = (vulkan_render_context_t*)calloc(1, sizeof(vulkan_render_context_t));
+    bench->render_state   = (render_state_t*)calloc(1, sizeof(render_state_t));
+    bench->sprites        = (bench_render_sprite_t*)calloc(BENCH_RENDER_SPRITES, sizeof(bench_render_sprite_t));
+    bench->atlases        = (texture_atlas_t*)calloc(BENCH_RENDER_ATLASES, sizeof(texture_atlas_t));
+    bench->subtextures    = (subtexture_data_t*)calloc(BENCH_RENDER_SUBTEXTURES, sizeof(subtexture_data_t));
+
+    for(u32 camera_index = 0; camera_index < BENCH_RENDER_CAMERAS; ++camera_index)
+    {
+        mat4_t view       = mat4_make_translation(vec3((float32)camera_index * 64.0f, 0.0f, 0.0f));
+        mat4_t projection = mat4_make_scale(vec3(2.0f / 1920.0f, 2.0f / 1080.0f, 1.0f));
+        bench->cameras[camera_index] = r_render_camera_create(view, projection);
+    }
+    bench->render_context->test_camera     = bench->cameras[0];
+    bench->render_context->default_shader  = bench->shaders;
+    r_render_state_init(bench->render_state, bench->render_context);
+
+    for(u32 atlas_index = 0; atlas_index < BENCH_RENDER_ATLASES; ++atlas_index)
+    {
+        bench->atlases[atlas_index].atlas_size = BENCH_RENDER_ATLAS_SIZE;
+    }
+
+    // NOTE(Sleepster): Subtexture 'n' is in atlas 'n % atlases', so walking them in order changes atlas every sprite.
+    for(u32 subtexture_index = 0; subtexture_index < BENCH_RENDER_SUBTEXTURES; ++subtexture_index)
+    {
+        subtexture_data_t *subtexture = bench->subtextures + subtexture_index;
+        float32 x    = (float32)(bench_random_next(&random_state) % (BENCH_RENDER_ATLAS_SIZE - 128));
+        float32 y    = (float32)(bench_random_next(&random_state) % (BENCH_RENDER_ATLAS_SIZE - 128));
+        float32 size = (float32)(16 + (bench_random_next(&random_state) % 112));
+
+        subtexture->atlas                  = bench->atlases + (subtexture_index % BENCH_RENDER_ATLASES);
+        subtexture->uv_min                 = vec2(x, y);
+        subtexture->uv_max                 = vec2(x + size, y + size);
+        subtexture->offset                 = subtexture->uv_min;
+        subtexture->size                   = vec2(size, size);
+        subtexture->atlas_subtexture_index = subtexture_index;
+    }
+
+    for(u32 sprite_index = 0; sprite_index < BENCH_RENDER_SPRITES; ++sprite_index)
+    {
+        bench_render_sprite_t *sprite = bench->sprites + sprite_index;
+        sprite->position = vec2((float32)(bench_random_next(&random_state) % 1920), (float32)(bench_random_next(&random_state) % 1080));
+        sprite->size     = vec2((float32)(8 + (bench_random_next(&random_state) % 56)), (float32)(8 + (bench_random_next(&random_state) % 56)));
+        sprite->color    = vec4(1.0f, 1.0f, 1.0f, 1.0f);
+    }
+}
+
+// NOTE(Sleepster): What r_frame_packet_capture() leaves behind once it has taken a frame.
+void
+bench_render_reset(void *user_data)
+{
+    bench_render_t *bench      = (bench_render_t*)user_data;
+    draw_frame_t   *draw_frame = &bench->render_state->draw_frame;
+    for(u32 group_index = 0; group_index < draw_frame->used_render_group_count; ++group_index)
+    {
+        render_group_t *render_group = draw_frame->used_render_groups[group_index];
+        for(render_geometry_batch_t *current_buffer = &render_group->first_buffer;
+            current_buffer;
+            current_buffer = current_buffer->next_buffer)
+        {
+            current_buffer->master_array_start_offset = 0;
+            current_buffer->primitive_count           = 0;
+        }
+        render_group->total_primitive_count = 0;
+    }
+    draw_frame->used_render_group_count = 0;
+
+    draw_frame->state.active_camera = bench->cameras;
+    draw_frame->state.active_shader = bench->shaders;
+}
+
+void
+bench_render_push_scene(void *user_data)
+{
+    bench_render_t *bench        = (bench_render_t*)user_data;
+    render_state_t *render_state = bench->render_state;
+    draw_frame_t   *draw_frame   = &render_state->draw_frame;
+
+    u32 sprites_per_layer = BENCH_RENDER_SPRITES / BENCH_RENDER_LAYERS;
+    u32 sprite_index      = 0;
+    for(u32 layer_index = 1; layer_index <= BENCH_RENDER_LAYERS; ++layer_index)
+    {
+        r_set_active_render_layer(render_state, layer_index);
+        r_render_group_begin(render_state);
+        for(u32 layer_sprite = 0; layer_sprite < sprites_per_layer; ++layer_sprite, ++sprite_index)
+        {
+            bench_render_sprite_t *sprite     = bench->sprites + sprite_index;
+            subtexture_data_t     *subtexture = bench->subtextures;
+            switch(bench->scene)
+            {
+                case BRS_Sprites: break;
+                case BRS_Atlases:
+                {
+                    subtexture = bench->subtextures + (sprite_index % BENCH_RENDER_SUBTEXTURES);
+                }break;
+                case BRS_Cameras:
+                {
+                    if((layer_sprite % BENCH_RENDER_CAMERA_RUN) == 0)
+                    {
+                        r_render_group_end(render_state);
+                        draw_frame->state.active_camera = bench->cameras + ((sprite_index / BENCH_RENDER_CAMERA_RUN) % BENCH_RENDER_CAMERAS);
+                        r_render_group_begin(render_state);
+                    }
+                }break;
+                case BRS_Shaders:
+                {
+                    if((layer_sprite % BENCH_RENDER_SHADER_RUN) == 0)
+                    {
+                        r_render_group_end(render_state);
+                        draw_frame->state.active_shader = bench->shaders + ((sprite_index / BENCH_RENDER_SHADER_RUN) % BENCH_RENDER_SHADERS);
+                        r_render_group_begin(render_state);
+                    }
+                }break;
+            }
+            r_push_texture_ex(render_state, sprite->position, sprite->size, sprite->color, 0.0f, subtexture);
+        }
+        r_render_group_end(render_state);
+    }
+    bench->pushed_count += sprite_index;
+}
+
+void
+bench_render_push_and_reset(void *user_data)
+{
+    bench_render_t *bench = (bench_render_t*)user_data;
+    bench_render_reset(bench);
+    bench->scene = BRS_Sprites;
+    bench_render_push_scene(bench);
+}
+
+void
+bench_render_fill(void *user_data)
+{
+    bench_render_t *bench = (bench_render_t*)user_data;
+    r_render_group_update_used_groups(bench->render_state);
+
+    draw_frame_t *draw_frame = &bench->render_state->draw_frame;
+    bench_consume(draw_frame->used_render_groups[0]->total_primitive_count);
+}
+
+void
+bench_render_setup_sprites(void *user_data)
+{
+    bench_render_reset(user_data);
+    ((bench_render_t*)user_data)->scene = BRS_Sprites;
+}
+
+void
+bench_render_setup_atlases(void *user_data)
+{
+    bench_render_reset(user_data);
+    ((bench_render_t*)user_data)->scene = BRS_Atlases;
+}
+
+void
+bench_render_setup_cameras(void *user_data)
+{
+    bench_render_reset(user_data);
+    ((bench_render_t*)user_data)->scene = BRS_Cameras;
+}
+
+void
+bench_render_setup_shaders(void *user_data)
+{
+    bench_render_reset(user_data);
+    ((bench_render_t*)user_data)->scene = BRS_Shaders;
+}
+
+int
+main(int argc, char **argv)
+{
+    bench_suite_t *suite = (bench_suite_t*)calloc(1, sizeof(bench_suite_t));
+    bench_suite_init(suite, "render_group", argc, argv);
+
+    bench_render_t *bench = (bench_render_t*)calloc(1, sizeof(bench_render_t));
+    bench_render_init(bench);
+
+    u64 frame_bytes = (u64)BENCH_RENDER_SPRITES * sizeof(render_geometry_instance_t);
+    bench_case_t cases[] =
+    {
+        {"push_100k",       bench_render_setup_sprites,  bench_render_push_scene, null, bench, BENCH_RENDER_SPRITES, frame_bytes},
+        {"push_15_atlases", bench_render_setup_atlases,  bench_render_push_scene, null, bench, BENCH_RENDER_SPRITES, frame_bytes},
+        {"push_16_cameras", bench_render_setup_cameras,  bench_render_push_scene, null, bench, BENCH_RENDER_SPRITES, frame_bytes},
+        {"push_16_shaders", bench_render_setup_shaders,  bench_render_push_scene, null, bench, BENCH_RENDER_SPRITES, frame_bytes},
+        {"fill_100k",       bench_render_push_and_reset, bench_render_fill,       null, bench, BENCH_RENDER_SPRITES, frame_bytes},
+    };
+    for(u32 case_index = 0; case_index < ArrayCount(cases); ++case_index)
+    {
+        bench_suite_run(suite, cases + case_index);
+        printf("    '%u' groups, '%.2f' MB of instances written per frame...\n",
+               bench->render_state->draw_frame.used_render_group_count, (float64)frame_bytes / (float64)MB(1));
+    }
+    bench_render_reset(bench);
+
+    s32 result = bench_suite_finish(suite);
+    printf("render_group: '%llu' sprites pushed, renderer arena reserved '%.1f' MB...\n",
+           bench->pushed_count, (float64)bench->render_state->renderer_arena.reserved / (float64)MB(1));
+
+    free(bench->subtextures);
+    free(bench->atlases);
+    free(bench->sprites);
+    free(bench->render_state);
+    free(bench->render_context);
+    free(bench);
+    free(suite);
+
+    return(result);
+}
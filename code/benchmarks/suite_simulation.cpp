@@ -0,0 +1,110 @@
+/* ========================================================================
+   $File: suite_simulation.cpp $
+   $Date: October 19 2026 07:45 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+
+#define MATH_IMPLEMENTATION
+#define HASH_TABLE_IMPLEMENTATION
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_hash_table.h>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_perf_counters.cpp>
+
+#include <g_entity.cpp>
+#include <g_game_state.cpp>
+#include <g_replay.cpp>
+
+#include <benchmarks/bench_harness.h>
+
+/* NOTE(Sleepster): The fixed step through g_replay_run(), an item is one tick. The replay is g_replay_record_synthetic()'s
+ * instead of one read off disk so every machine runs the same one: 4 players, a minute of game time, every player
+ * changes direction every quarter second or so. '-replay=<path> -replay_repeat=<n>' on the game is the same thing with a real recording.
+ *
+ * replay_1m - reset and replay the whole minute, the checksum has to come out the same every run.
+ */
+
+#define BENCH_SIMULATION_PLAYERS (4)
+#define BENCH_SIMULATION_TICKS   (3600)
+
+struct bench_simulation_t
+{
+    memory_arena_t arena;
+    game_state_t  *state;
+    replay_data_t  replay;
+    u64            mismatches;
+};
+
+internal_api void
+bench_simulation_record(bench_simulation_t *bench)
+{
+    game_state_t      *state    = bench->state;
+    replay_recorder_t *recorder = (replay_recorder_t*)calloc(1, sizeof(replay_recorder_t));
+    g_replay_record_synthetic(recorder, state, STR("suite_simulation.replay"), BENCH_SIMULATION_PLAYERS, BENCH_SIMULATION_TICKS, 0xD1B54A32D192ED03ULL);
+
+    string_t file_data = g_replay_recorder_serialize(recorder, state, &bench->arena);
+    bench->replay      = g_replay_load_from_memory(file_data);
+    free(recorder);
+}
+
+void
+bench_simulation_reset(void *user_data)
+{
+    bench_simulation_t *bench = (bench_simulation_t*)user_data;
+    g_replay_reset_state(&bench->replay, bench->state);
+}
+
+void
+bench_simulation_replay(void *user_data)
+{
+    bench_simulation_t *bench = (bench_simulation_t*)user_data;
+    replay_stats_t stats = g_replay_run(&bench->replay, bench->state);
+    if(!stats.checksum_matches) ++bench->mismatches;
+    bench_consume(stats.checksum);
+}
+
+int
+main(int argc, char **argv)
+{
+    bench_suite_t *suite = (bench_suite_t*)calloc(1, sizeof(bench_suite_t));
+    bench_suite_init(suite, "simulation", argc, argv);
+
+    bench_simulation_t *bench = (bench_simulation_t*)calloc(1, sizeof(bench_simulation_t));
+    bench->arena = c_arena_create(MB(1));
+    bench->state = (game_state_t*)calloc(1, sizeof(game_state_t));
+    bench_simulation_record(bench);
+
+    bench_case_t replay_case = {"replay_1m", bench_simulation_reset, bench_simulation_replay, null, bench, BENCH_SIMULATION_TICKS, 0};
+    bench_suite_run(suite, &replay_case);
+
+    s32 result = bench_suite_finish(suite);
+    if(bench->mismatches)
+    {
+        fprintf(stderr, "simulation: '%llu' replays didn't match the recorded checksum...\n", bench->mismatches);
+        result = 1;
+    }
+
+    free(bench->state);
+    c_arena_destroy(&bench->arena);
+    free(bench);
+    free(suite);
+
+    return(result);
+}
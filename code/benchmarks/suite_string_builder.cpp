@@ -0,0 +1,141 @@
+/* ========================================================================
+   $File: suite_string_builder.cpp $
+   $Date: October 19 2026 06:05 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_string.h>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_perf_counters.cpp>
+
+#include <benchmarks/bench_harness.h>
+
+/* NOTE(Sleepster): string_builder_t, the reset between runs is in setup.
+ *
+ * append_16b   - short strings into 64KB buffers, about 4000 of them per buffer.
+ * append_value - 4 byte values, what the packers write their headers with.
+ * append_1k    - 1KB strings, so advancing to the next buffer shows up.
+ * get_string   - c_string_builder_get_current_string() over 1MB spread across 16 buffers.
+ */
+
+#define BENCH_BUILDER_BLOCK_SIZE  (KB(64))
+#define BENCH_BUILDER_SMALL_COUNT (65536)
+#define BENCH_BUILDER_LARGE_COUNT (1024)
+
+struct bench_builder_t
+{
+    string_builder_t builder;
+    byte             small_string[16];
+    byte             large_string[KB(1)];
+};
+
+void
+bench_builder_reset(void *user_data)
+{
+    bench_builder_t *bench = (bench_builder_t*)user_data;
+    c_string_builder_reset(&bench->builder);
+}
+
+void
+bench_builder_append_small(void *user_data)
+{
+    bench_builder_t *bench = (bench_builder_t*)user_data;
+    string_t small = c_string_create_with_length(bench->small_string, sizeof(bench->small_string));
+    for(u32 append_index = 0; append_index < BENCH_BUILDER_SMALL_COUNT; ++append_index)
+    {
+        c_string_builder_append_data(&bench->builder, small);
+    }
+    bench_consume(bench->builder.bytes_used);
+}
+
+void
+bench_builder_append_value(void *user_data)
+{
+    bench_builder_t *bench = (bench_builder_t*)user_data;
+    for(u32 append_index = 0; append_index < BENCH_BUILDER_SMALL_COUNT; ++append_index)
+    {
+        c_string_builder_append_value(&bench->builder, &append_index, sizeof(append_index));
+    }
+    bench_consume(bench->builder.bytes_used);
+}
+
+void
+bench_builder_append_large(void *user_data)
+{
+    bench_builder_t *bench = (bench_builder_t*)user_data;
+    string_t large = c_string_create_with_length(bench->large_string, sizeof(bench->large_string));
+    for(u32 append_index = 0; append_index < BENCH_BUILDER_LARGE_COUNT; ++append_index)
+    {
+        c_string_builder_append_data(&bench->builder, large);
+    }
+    bench_consume(bench->builder.bytes_used);
+}
+
+void
+bench_builder_fill(void *user_data)
+{
+    bench_builder_reset(user_data);
+    bench_builder_append_large(user_data);
+}
+
+void
+bench_builder_get_string(void *user_data)
+{
+    bench_builder_t *bench = (bench_builder_t*)user_data;
+    string_t result = c_string_builder_get_current_string(&bench->builder);
+    bench_consume(result.count);
+}
+
+int
+main(int argc, char **argv)
+{
+    bench_suite_t *suite = (bench_suite_t*)calloc(1, sizeof(bench_suite_t));
+    bench_suite_init(suite, "string_builder", argc, argv);
+
+    bench_builder_t *bench = (bench_builder_t*)calloc(1, sizeof(bench_builder_t));
+    c_string_builder_init(&bench->builder, BENCH_BUILDER_BLOCK_SIZE);
+    memset(bench->small_string, 's', sizeof(bench->small_string));
+    memset(bench->large_string, 'l', sizeof(bench->large_string));
+
+    u64 small_bytes = BENCH_BUILDER_SMALL_COUNT * sizeof(bench->small_string);
+    u64 value_bytes = BENCH_BUILDER_SMALL_COUNT * sizeof(u32);
+    u64 large_bytes = BENCH_BUILDER_LARGE_COUNT * sizeof(bench->large_string);
+
+    bench_case_t cases[] =
+    {
+        {"append_16b",   bench_builder_reset, bench_builder_append_small, null, bench, BENCH_BUILDER_SMALL_COUNT, small_bytes},
+        {"append_value", bench_builder_reset, bench_builder_append_value, null, bench, BENCH_BUILDER_SMALL_COUNT, value_bytes},
+        {"append_1k",    bench_builder_reset, bench_builder_append_large, null, bench, BENCH_BUILDER_LARGE_COUNT, large_bytes},
+        {"get_string",   bench_builder_fill,  bench_builder_get_string,   null, bench, 1,                         large_bytes},
+    };
+    for(u32 case_index = 0; case_index < ArrayCount(cases); ++case_index)
+    {
+        bench_suite_run(suite, cases + case_index);
+    }
+
+    c_string_builder_deinit(&bench->builder);
+    free(bench);
+
+    s32 result = bench_suite_finish(suite);
+    free(suite);
+
+    return(result);
+}
@@ -0,0 +1,171 @@
+/* ========================================================================
+   $File: suite_threadpool.cpp $
+   $Date: October 19 2026 05:50 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_threadpool.h>
+#include <c_threadpool.cpp>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_sampler.cpp>
+#include <c_perf_counters.cpp>
+
+#include <benchmarks/bench_harness.h>
+
+/* NOTE(Sleepster): threadpool_t with the default worker count, a run is submitting a frame's worth of jobs and waiting
+ * for all of them, so this is submit, steal, execute and wake-up together. suite_threadpool_submit.cpp splits the
+ * submit side out, suite_threadpool_scaling.cpp goes over the worker counts and suite_threadpool_stress.cpp has the
+ * latencies and the corner cases, this is the number to watch between commits.
+ *
+ * empty_single - 4096 empty jobs, one c_threadpool_add_task() each.
+ * empty_inline - the same with the payload copied into the task.
+ * empty_batch  - the same made up front and handed over in one c_threadpool_add_tasks().
+ * work_2k      - 1024 jobs of about 2000 xorshift steps, what a real frame of small jobs looks like.
+ * round_trip   - one job, then wait for it, 256 times. The latency of a single wake-up.
+ */
+
+#define BENCH_POOL_JOB_COUNT        (4096)
+#define BENCH_POOL_WORK_JOB_COUNT   (1024)
+#define BENCH_POOL_WORK_ITERATIONS  (2000)
+#define BENCH_POOL_ROUND_TRIP_COUNT (256)
+
+struct bench_pool_job_t
+{
+    u32  index;
+    u32  iterations;
+    u32 *results;
+};
+
+struct bench_pool_t
+{
+    threadpool_t      pool;
+    bench_pool_job_t  jobs[BENCH_POOL_JOB_COUNT];
+    threadpool_task_t batch[BENCH_POOL_JOB_COUNT];
+    u32               results[BENCH_POOL_JOB_COUNT];
+};
+
+void
+bench_pool_job(void *user_data)
+{
+    bench_pool_job_t *job = (bench_pool_job_t*)user_data;
+    job->results[job->index] = job->iterations ? bench_spin_work(job->index, job->iterations) : job->index;
+}
+
+void
+bench_pool_empty_single(void *user_data)
+{
+    bench_pool_t *bench = (bench_pool_t*)user_data;
+    threadpool_counter_t counter = {};
+    for(u32 job_index = 0; job_index < BENCH_POOL_JOB_COUNT; ++job_index)
+    {
+        c_threadpool_add_task(&bench->pool, bench->jobs + job_index, bench_pool_job, TPTP_High, &counter);
+    }
+    c_threadpool_wait_for_counter(&bench->pool, &counter);
+}
+
+void
+bench_pool_empty_inline(void *user_data)
+{
+    bench_pool_t *bench = (bench_pool_t*)user_data;
+    threadpool_counter_t counter = {};
+    for(u32 job_index = 0; job_index < BENCH_POOL_JOB_COUNT; ++job_index)
+    {
+        bench_pool_job_t job = {job_index, 0, bench->results};
+        c_threadpool_add_inline_task(&bench->pool, &job, sizeof(job), bench_pool_job, TPTP_High, &counter);
+    }
+    c_threadpool_wait_for_counter(&bench->pool, &counter);
+}
+
+void
+bench_pool_empty_batch(void *user_data)
+{
+    bench_pool_t *bench = (bench_pool_t*)user_data;
+    threadpool_counter_t counter = {};
+    for(u32 job_index = 0; job_index < BENCH_POOL_JOB_COUNT; ++job_index)
+    {
+        bench_pool_job_t job = {job_index, 0, bench->results};
+        bench->batch[job_index] = c_threadpool_make_inline_task(bench_pool_job, &job, sizeof(job));
+    }
+    c_threadpool_add_tasks(&bench->pool, bench->batch, BENCH_POOL_JOB_COUNT, TPTP_High, &counter);
+    c_threadpool_wait_for_counter(&bench->pool, &counter);
+}
+
+void
+bench_pool_work(void *user_data)
+{
+    bench_pool_t *bench = (bench_pool_t*)user_data;
+    threadpool_counter_t counter = {};
+    for(u32 job_index = 0; job_index < BENCH_POOL_WORK_JOB_COUNT; ++job_index)
+    {
+        bench_pool_job_t job = {job_index, BENCH_POOL_WORK_ITERATIONS, bench->results};
+        c_threadpool_add_inline_task(&bench->pool, &job, sizeof(job), bench_pool_job, TPTP_High, &counter);
+    }
+    c_threadpool_wait_for_counter(&bench->pool, &counter);
+    bench_consume(bench->results[BENCH_POOL_WORK_JOB_COUNT - 1]);
+}
+
+void
+bench_pool_round_trip(void *user_data)
+{
+    bench_pool_t *bench = (bench_pool_t*)user_data;
+    for(u32 trip_index = 0; trip_index < BENCH_POOL_ROUND_TRIP_COUNT; ++trip_index)
+    {
+        threadpool_counter_t counter = {};
+        c_threadpool_add_task(&bench->pool, bench->jobs + trip_index, bench_pool_job, TPTP_High, &counter);
+        c_threadpool_wait_for_counter(&bench->pool, &counter);
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+    bench_suite_t *suite = (bench_suite_t*)calloc(1, sizeof(bench_suite_t));
+    bench_suite_init(suite, "threadpool", argc, argv);
+
+    bench_pool_t *bench = (bench_pool_t*)calloc(1, sizeof(bench_pool_t));
+    c_threadpool_init(&bench->pool);
+    for(u32 job_index = 0; job_index < BENCH_POOL_JOB_COUNT; ++job_index)
+    {
+        bench->jobs[job_index] = {job_index, 0, bench->results};
+    }
+
+    bench_case_t cases[] =
+    {
+        {"empty_single", null, bench_pool_empty_single, null, bench, BENCH_POOL_JOB_COUNT,        0},
+        {"empty_inline", null, bench_pool_empty_inline, null, bench, BENCH_POOL_JOB_COUNT,        0},
+        {"empty_batch",  null, bench_pool_empty_batch,  null, bench, BENCH_POOL_JOB_COUNT,        0},
+        {"work_2k",      null, bench_pool_work,         null, bench, BENCH_POOL_WORK_JOB_COUNT,   0},
+        {"round_trip",   null, bench_pool_round_trip,   null, bench, BENCH_POOL_ROUND_TRIP_COUNT, 0},
+    };
+    for(u32 case_index = 0; case_index < ArrayCount(cases); ++case_index)
+    {
+        bench_suite_run(suite, cases + case_index);
+    }
+
+    c_threadpool_destroy(&bench->pool);
+    free(bench);
+
+    s32 result = bench_suite_finish(suite);
+    free(suite);
+
+    return(result);
+}
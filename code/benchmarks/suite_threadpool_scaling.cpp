@@ -0,0 +1,220 @@
+/* ========================================================================
+   $File: suite_threadpool_scaling.cpp $
+   $Date: October 18 2026 02:41 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_threadpool.h>
+#include <c_threadpool.cpp>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_sampler.cpp>
+#include <c_perf_counters.cpp>
+
+#include <benchmarks/bench_harness.h>
+#include <benchmarks/legacy_threadpool.h>
+
+/* NOTE(Sleepster): Scheduler scaling, old global queues vs. the work stealing pool, at 1, 2, 4... threads up to
+ * '-max_threads' ('_t<n>' on the case name).
+ *
+ * legacy_empty/stealing_empty - the main thread pushes BENCH_SCALING_TASK_COUNT empty tasks and waits, pure
+ *                               scheduling overhead.
+ * legacy_4k/stealing_4k       - the same with ~4k iterations of fake work per task.
+ * recursive                   - every task spawns BENCH_SCALING_RECURSIVE_FANOUT children until
+ *                               BENCH_SCALING_RECURSIVE_DEPTH. This is the case the old pool can't do at all past
+ *                               10000 queued entries, so it only runs on the new pool.
+ *
+ * flags: -max_threads=<n>
+ */
+
+#define BENCH_SCALING_TASK_COUNT       (8192)
+#define BENCH_SCALING_WORK_ITERATIONS  (4096)
+#define BENCH_SCALING_RECURSIVE_DEPTH  (7)
+#define BENCH_SCALING_RECURSIVE_FANOUT (4)
+#define BENCH_SCALING_RECURSIVE_COUNT  (21845) // NOTE(Sleepster): 4^0 + 4^1 + ... + 4^7
+#define BENCH_SCALING_CASES_PER_TIER   (5)
+
+StaticAssert(BENCH_SCALING_TASK_COUNT < LEGACY_MAX_QUEUE_ENTRIES, "The legacy pool can't hold a full fan out batch...\n");
+
+struct bench_scaling_task_t
+{
+    u32  iterations;
+    u32  result;
+    byte _padding[CACHE_LINE_SIZE - (sizeof(u32) * 2)];
+};
+
+struct bench_scaling_t
+{
+    legacy_threadpool_t *legacy_pool;
+    threadpool_t         pool;
+    char                 case_names[BENCH_SCALING_CASES_PER_TIER][BENCH_NAME_LENGTH];
+};
+
+global_variable bench_scaling_task_t  bench_scaling_tasks[BENCH_SCALING_TASK_COUNT];
+global_variable volatile u32          bench_scaling_tasks_done;
+global_variable threadpool_t         *bench_scaling_pool;
+
+// NOTE(Sleepster): Both pools pay for the same done counter, the old pool's flush can return before its tasks finish.
+void
+bench_scaling_leaf_task(void *user_data)
+{
+    bench_scaling_task_t *task = (bench_scaling_task_t*)user_data;
+    task->result = bench_spin_work((u32)(task - bench_scaling_tasks), task->iterations);
+
+    AtomicIncrement32(&bench_scaling_tasks_done);
+}
+
+void
+bench_scaling_recursive_task(void *user_data)
+{
+    u32 depth = (u32)(usize)user_data;
+    bench_scaling_tasks[depth].result = bench_spin_work(depth, 256);
+
+    if(depth < BENCH_SCALING_RECURSIVE_DEPTH)
+    {
+        for(u32 child_index = 0;
+            child_index < BENCH_SCALING_RECURSIVE_FANOUT;
+            ++child_index)
+        {
+            c_threadpool_add_task(bench_scaling_pool, (void*)(usize)(depth + 1), &bench_scaling_recursive_task, TPTP_High);
+        }
+    }
+    AtomicIncrement32(&bench_scaling_tasks_done);
+}
+
+internal_api void
+bench_scaling_reset_tasks(u32 iterations)
+{
+    for(u32 task_index = 0;
+        task_index < BENCH_SCALING_TASK_COUNT;
+        ++task_index)
+    {
+        bench_scaling_tasks[task_index].iterations = iterations;
+        bench_scaling_tasks[task_index].result     = 0;
+    }
+    AtomicStore32(&bench_scaling_tasks_done, 0);
+}
+
+void
+bench_scaling_reset_empty(void *user_data)
+{
+    bench_scaling_reset_tasks(0);
+}
+
+void
+bench_scaling_reset_work(void *user_data)
+{
+    bench_scaling_reset_tasks(BENCH_SCALING_WORK_ITERATIONS);
+}
+
+void
+bench_scaling_legacy_fan_out(void *user_data)
+{
+    bench_scaling_t *bench = (bench_scaling_t*)user_data;
+    for(u32 task_index = 0;
+        task_index < BENCH_SCALING_TASK_COUNT;
+        ++task_index)
+    {
+        legacy_threadpool_add_task(bench->legacy_pool, bench_scaling_tasks + task_index, &bench_scaling_leaf_task, TPTP_High);
+    }
+    legacy_threadpool_flush_task_queues(bench->legacy_pool);
+    while(AtomicLoad32(&bench_scaling_tasks_done) != BENCH_SCALING_TASK_COUNT)
+    {
+        _mm_pause();
+    }
+}
+
+void
+bench_scaling_stealing_fan_out(void *user_data)
+{
+    bench_scaling_t *bench = (bench_scaling_t*)user_data;
+    for(u32 task_index = 0;
+        task_index < BENCH_SCALING_TASK_COUNT;
+        ++task_index)
+    {
+        c_threadpool_add_task(&bench->pool, bench_scaling_tasks + task_index, &bench_scaling_leaf_task, TPTP_High);
+    }
+    c_threadpool_flush_task_queues(&bench->pool);
+}
+
+void
+bench_scaling_recursive(void *user_data)
+{
+    bench_scaling_t *bench = (bench_scaling_t*)user_data;
+    c_threadpool_add_task(&bench->pool, (void*)(usize)0, &bench_scaling_recursive_task, TPTP_High);
+    c_threadpool_flush_task_queues(&bench->pool);
+}
+
+void
+bench_scaling_check_done(void *user_data)
+{
+    u32 tasks_done = AtomicLoad32(&bench_scaling_tasks_done);
+    Assert(tasks_done == BENCH_SCALING_TASK_COUNT || tasks_done == BENCH_SCALING_RECURSIVE_COUNT);
+}
+
+int
+main(int argc, char **argv)
+{
+    u64 *max_threads = c_program_flag_add_size("max_threads", THREADPOOL_MAX_WORKERS, "Doubles the thread count up to this\n");
+
+    bench_suite_t *suite = (bench_suite_t*)calloc(1, sizeof(bench_suite_t));
+    bench_suite_init(suite, "threadpool_scaling", argc, argv);
+
+    u32 max_thread_count = (u32)*max_threads;
+    if(max_thread_count == 0 || max_thread_count > THREADPOOL_MAX_WORKERS) max_thread_count = THREADPOOL_MAX_WORKERS;
+
+    bench_scaling_t *bench = (bench_scaling_t*)calloc(1, sizeof(bench_scaling_t));
+    bench_scaling_pool = &bench->pool;
+    for(u32 thread_count = 1;
+        thread_count <= max_thread_count;
+        thread_count *= 2)
+    {
+        bench->legacy_pool = legacy_threadpool_create(thread_count);
+        c_threadpool_init(&bench->pool, thread_count);
+
+        bench_case_t cases[] =
+        {
+            {"legacy_empty",   bench_scaling_reset_empty, bench_scaling_legacy_fan_out,   bench_scaling_check_done, bench, BENCH_SCALING_TASK_COUNT,      0},
+            {"legacy_4k",      bench_scaling_reset_work,  bench_scaling_legacy_fan_out,   bench_scaling_check_done, bench, BENCH_SCALING_TASK_COUNT,      0},
+            {"stealing_empty", bench_scaling_reset_empty, bench_scaling_stealing_fan_out, bench_scaling_check_done, bench, BENCH_SCALING_TASK_COUNT,      0},
+            {"stealing_4k",    bench_scaling_reset_work,  bench_scaling_stealing_fan_out, bench_scaling_check_done, bench, BENCH_SCALING_TASK_COUNT,      0},
+            {"recursive",      bench_scaling_reset_empty, bench_scaling_recursive,        bench_scaling_check_done, bench, BENCH_SCALING_RECURSIVE_COUNT, 0},
+        };
+        StaticAssert(ArrayCount(cases) == BENCH_SCALING_CASES_PER_TIER, "BENCH_SCALING_CASES_PER_TIER is out of date...\n");
+
+        for(u32 case_index = 0; case_index < ArrayCount(cases); ++case_index)
+        {
+            char *case_name = bench->case_names[case_index];
+            snprintf(case_name, BENCH_NAME_LENGTH, "%s_t%u", cases[case_index].name, thread_count);
+            cases[case_index].name = case_name;
+            bench_suite_run(suite, cases + case_index);
+        }
+
+        c_threadpool_destroy(&bench->pool);
+        legacy_threadpool_destroy(bench->legacy_pool);
+    }
+    free(bench);
+
+    s32 result = bench_suite_finish(suite);
+    free(suite);
+
+    return(result);
+}
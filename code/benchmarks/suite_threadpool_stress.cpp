@@ -0,0 +1,297 @@
+/* ========================================================================
+   $File: suite_threadpool_stress.cpp $
+   $Date: October 19 2026 09:10 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_threadpool.h>
+#include <c_threadpool.cpp>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_sampler.cpp>
+#include <c_perf_counters.cpp>
+
+#include <benchmarks/bench_harness.h>
+
+/* NOTE(Sleepster): The threadpool pushed on, at every worker count from one up to a worker per cpu (doubling, '_w<n>'
+ * on the case name). suite_threadpool.cpp is the everyday number, this is the one a new scheduler has to beat before
+ * it goes in. The latency cases are one event per run, so the harness' median/p90/p99 are that event's percentiles.
+ *
+ * empty           - 4096 empty tasks one c_threadpool_add_task() at a time, then wait. Tasks per second.
+ * fan_out_in      - a task on a worker fans 64 small jobs out, waits for them on its fiber and signals main. Submit to
+ *                   done, a frame's job graph in miniature.
+ * high_under_low  - every worker is busy with a flood of low priority work, then one high priority task. How long it
+ *                   takes to start.
+ * low_under_high  - the other way around: one low priority task behind 1024 high priority ones. Priorities are strict,
+ *                   so this is the starvation, it can't start until the high queue has drained.
+ * flush           - 1024 small jobs as one batch, then c_threadpool_flush_task_queues() with main helping out.
+ * wakeup_idle     - workers left alone long enough to go to sleep on the semaphore, then one task. The wakeup.
+ * deque_full      - THREADPOOL_DEQUE_CAPACITY empty tasks from main, its deque fills up exactly.
+ * deque_overflow  - four times that, everything past the first deque's worth spills into the overflow queue.
+ *
+ * The latency cases spin main on a flag instead of waiting on a counter, a wait on main helps run tasks and would
+ * happily run the task it's timing itself.
+ */
+
+#define BENCH_STRESS_EMPTY_COUNT      (4096)
+#define BENCH_STRESS_FAN_OUT_COUNT    (64)
+#define BENCH_STRESS_FAN_OUT_WORK     (1000)
+#define BENCH_STRESS_FLOOD_COUNT      (1024)
+#define BENCH_STRESS_FLOOD_WORK       (500)
+#define BENCH_STRESS_FLUSH_COUNT      (1024)
+#define BENCH_STRESS_FLUSH_WORK       (200)
+#define BENCH_STRESS_IDLE_MS          (5)
+#define BENCH_STRESS_OVERFLOW_COUNT   (THREADPOOL_DEQUE_CAPACITY * 4)
+#define BENCH_STRESS_MAX_TIERS        (7)
+#define BENCH_STRESS_CASES_PER_TIER   (8)
+#define BENCH_STRESS_YIELD_SPINS      (1024)
+
+StaticAssert(BENCH_STRESS_MAX_TIERS * BENCH_STRESS_CASES_PER_TIER <= BENCH_MAX_CASES, "The stress tiers don't fit in one suite...\n");
+
+struct bench_stress_job_t
+{
+    u32  index;
+    u32  iterations;
+    u32 *results;
+};
+
+struct bench_stress_t
+{
+    threadpool_t         pool;
+    threadpool_counter_t flood_counter;
+    volatile u32         is_done;
+
+    bench_stress_job_t   jobs[BENCH_STRESS_OVERFLOW_COUNT];
+    threadpool_task_t    batch[BENCH_STRESS_FLUSH_COUNT];
+    u32                  results[BENCH_STRESS_OVERFLOW_COUNT];
+
+    char                 case_names[BENCH_STRESS_CASES_PER_TIER][BENCH_NAME_LENGTH];
+};
+
+void
+bench_stress_job(void *user_data)
+{
+    bench_stress_job_t *job = (bench_stress_job_t*)user_data;
+    job->results[job->index] = job->iterations ? bench_spin_work(job->index, job->iterations) : job->index;
+}
+
+void
+bench_stress_signal(void *user_data)
+{
+    bench_stress_t *bench = (bench_stress_t*)user_data;
+    AtomicExchange32(&bench->is_done, 1);
+}
+
+// NOTE(Sleepster): Doesn't help run anything. The yield is for machines with fewer cpus than threads, where spinning
+//                  would sit on the cpu the worker needs.
+internal_api void
+bench_stress_wait_for_signal(bench_stress_t *bench)
+{
+    for(u32 spin_count = 1; !AtomicLoad32(&bench->is_done); ++spin_count)
+    {
+        _mm_pause();
+        if((spin_count % BENCH_STRESS_YIELD_SPINS) == 0) sys_thread_yield();
+    }
+}
+
+internal_api void
+bench_stress_signal_after(bench_stress_t *bench, u32 priority)
+{
+    AtomicExchange32(&bench->is_done, 0);
+    c_threadpool_add_task(&bench->pool, bench, bench_stress_signal, priority);
+    bench_stress_wait_for_signal(bench);
+}
+
+internal_api void
+bench_stress_add_jobs(bench_stress_t *bench, u32 job_count, u32 iterations, u32 priority, threadpool_counter_t *counter)
+{
+    for(u32 job_index = 0; job_index < job_count; ++job_index)
+    {
+        bench_stress_job_t *job = bench->jobs + job_index;
+        job->iterations = iterations;
+        c_threadpool_add_task(&bench->pool, job, bench_stress_job, priority, counter);
+    }
+}
+
+void
+bench_stress_empty(void *user_data)
+{
+    bench_stress_t *bench = (bench_stress_t*)user_data;
+    threadpool_counter_t counter = {};
+    bench_stress_add_jobs(bench, BENCH_STRESS_EMPTY_COUNT, 0, TPTP_High, &counter);
+    c_threadpool_wait_for_counter(&bench->pool, &counter);
+}
+
+// NOTE(Sleepster): Runs on a worker, so the wait parks this fiber instead of helping.
+void
+bench_stress_fan_out_root(void *user_data)
+{
+    bench_stress_t *bench = (bench_stress_t*)user_data;
+    threadpool_counter_t counter = {};
+    bench_stress_add_jobs(bench, BENCH_STRESS_FAN_OUT_COUNT, BENCH_STRESS_FAN_OUT_WORK, TPTP_High, &counter);
+    c_threadpool_wait_for_counter(&bench->pool, &counter);
+    bench_stress_signal(bench);
+}
+
+void
+bench_stress_fan_out_in(void *user_data)
+{
+    bench_stress_t *bench = (bench_stress_t*)user_data;
+    AtomicExchange32(&bench->is_done, 0);
+    c_threadpool_add_task(&bench->pool, bench, bench_stress_fan_out_root, TPTP_High);
+    bench_stress_wait_for_signal(bench);
+    bench_consume(bench->results[BENCH_STRESS_FAN_OUT_COUNT - 1]);
+}
+
+void
+bench_stress_flood_low(void *user_data)
+{
+    bench_stress_t *bench = (bench_stress_t*)user_data;
+    bench_stress_add_jobs(bench, BENCH_STRESS_FLOOD_COUNT, BENCH_STRESS_FLOOD_WORK, TPTP_Low, &bench->flood_counter);
+}
+
+void
+bench_stress_flood_high(void *user_data)
+{
+    bench_stress_t *bench = (bench_stress_t*)user_data;
+    bench_stress_add_jobs(bench, BENCH_STRESS_FLOOD_COUNT, BENCH_STRESS_FLOOD_WORK, TPTP_High, &bench->flood_counter);
+}
+
+void
+bench_stress_drain_flood(void *user_data)
+{
+    bench_stress_t *bench = (bench_stress_t*)user_data;
+    c_threadpool_wait_for_counter(&bench->pool, &bench->flood_counter);
+}
+
+void
+bench_stress_high_under_low(void *user_data)
+{
+    bench_stress_signal_after((bench_stress_t*)user_data, TPTP_High);
+}
+
+void
+bench_stress_low_under_high(void *user_data)
+{
+    bench_stress_signal_after((bench_stress_t*)user_data, TPTP_Low);
+}
+
+void
+bench_stress_flush(void *user_data)
+{
+    bench_stress_t *bench = (bench_stress_t*)user_data;
+    for(u32 job_index = 0; job_index < BENCH_STRESS_FLUSH_COUNT; ++job_index)
+    {
+        bench_stress_job_t *job = bench->jobs + job_index;
+        job->iterations = BENCH_STRESS_FLUSH_WORK;
+        bench->batch[job_index] = c_threadpool_make_task(bench_stress_job, job);
+    }
+    c_threadpool_add_tasks(&bench->pool, bench->batch, BENCH_STRESS_FLUSH_COUNT, TPTP_High);
+    c_threadpool_flush_task_queues(&bench->pool);
+}
+
+void
+bench_stress_go_idle(void *user_data)
+{
+    sys_sleep_ms(BENCH_STRESS_IDLE_MS);
+}
+
+void
+bench_stress_wakeup_idle(void *user_data)
+{
+    bench_stress_signal_after((bench_stress_t*)user_data, TPTP_High);
+}
+
+void
+bench_stress_deque_full(void *user_data)
+{
+    bench_stress_t *bench = (bench_stress_t*)user_data;
+    threadpool_counter_t counter = {};
+    bench_stress_add_jobs(bench, THREADPOOL_DEQUE_CAPACITY, 0, TPTP_High, &counter);
+    c_threadpool_wait_for_counter(&bench->pool, &counter);
+}
+
+void
+bench_stress_deque_overflow(void *user_data)
+{
+    bench_stress_t *bench = (bench_stress_t*)user_data;
+    threadpool_counter_t counter = {};
+    bench_stress_add_jobs(bench, BENCH_STRESS_OVERFLOW_COUNT, 0, TPTP_High, &counter);
+    c_threadpool_wait_for_counter(&bench->pool, &counter);
+}
+
+int
+main(int argc, char **argv)
+{
+    bench_suite_t *suite = (bench_suite_t*)calloc(1, sizeof(bench_suite_t));
+    bench_suite_init(suite, "threadpool_stress", argc, argv);
+
+    bench_stress_t *bench = (bench_stress_t*)calloc(1, sizeof(bench_stress_t));
+    for(u32 job_index = 0; job_index < ArrayCount(bench->jobs); ++job_index)
+    {
+        bench->jobs[job_index] = {job_index, 0, bench->results};
+    }
+
+    // NOTE(Sleepster): 1, 2, 4... then one per cpu, main's cpu is shared with a worker at the top tier.
+    u32 cpu_count = (u32)Min(Max(sys_get_cpu_count(), 1), THREADPOOL_MAX_WORKERS);
+    u32 worker_counts[BENCH_STRESS_MAX_TIERS];
+    u32 tier_count = 0;
+    for(u32 worker_count = 1; worker_count < cpu_count && tier_count < BENCH_STRESS_MAX_TIERS - 1; worker_count *= 2)
+    {
+        worker_counts[tier_count++] = worker_count;
+    }
+    worker_counts[tier_count++] = cpu_count;
+
+    for(u32 tier_index = 0; tier_index < tier_count; ++tier_index)
+    {
+        u32 worker_count = worker_counts[tier_index];
+        c_threadpool_init(&bench->pool, worker_count);
+
+        bench_case_t cases[] =
+        {
+            {"empty",          null,                    bench_stress_empty,          null,                     bench, BENCH_STRESS_EMPTY_COUNT,    0},
+            {"fan_out_in",     null,                    bench_stress_fan_out_in,     null,                     bench, BENCH_STRESS_FAN_OUT_COUNT,  0},
+            {"high_under_low", bench_stress_flood_low,  bench_stress_high_under_low, bench_stress_drain_flood, bench, 1,                           0},
+            {"low_under_high", bench_stress_flood_high, bench_stress_low_under_high, bench_stress_drain_flood, bench, 1,                           0},
+            {"flush",          null,                    bench_stress_flush,          null,                     bench, BENCH_STRESS_FLUSH_COUNT,    0},
+            {"wakeup_idle",    bench_stress_go_idle,    bench_stress_wakeup_idle,    null,                     bench, 1,                           0},
+            {"deque_full",     null,                    bench_stress_deque_full,     null,                     bench, THREADPOOL_DEQUE_CAPACITY,   0},
+            {"deque_overflow", null,                    bench_stress_deque_overflow, null,                     bench, BENCH_STRESS_OVERFLOW_COUNT, 0},
+        };
+        StaticAssert(ArrayCount(cases) == BENCH_STRESS_CASES_PER_TIER, "BENCH_STRESS_CASES_PER_TIER is out of date...\n");
+
+        for(u32 case_index = 0; case_index < ArrayCount(cases); ++case_index)
+        {
+            char *case_name = bench->case_names[case_index];
+            snprintf(case_name, BENCH_NAME_LENGTH, "%s_w%u", cases[case_index].name, worker_count);
+            cases[case_index].name = case_name;
+            bench_suite_run(suite, cases + case_index);
+        }
+
+        c_threadpool_destroy(&bench->pool);
+    }
+    free(bench);
+
+    s32 result = bench_suite_finish(suite);
+    free(suite);
+
+    return(result);
+}
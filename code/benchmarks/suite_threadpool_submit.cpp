@@ -0,0 +1,169 @@
+/* ========================================================================
+   $File: suite_threadpool_submit.cpp $
+   $Date: October 18 2026 05:02 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_threadpool.h>
+#include <c_threadpool.cpp>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_sampler.cpp>
+#include <c_perf_counters.cpp>
+
+#include <benchmarks/bench_harness.h>
+
+/* NOTE(Sleepster): What it costs the submitting thread to hand off a frame's worth of tiny jobs.
+ *
+ * single - one c_threadpool_add_task() per job, user_data pointing into an array.
+ * inline - one c_threadpool_add_inline_task() per job, payload copied into the task.
+ * batch  - c_threadpool_make_inline_task() for every job, then one c_threadpool_add_tasks().
+ *
+ * "submit_" cases are just the time spent submitting, the wait for the jobs is in the teardown. "total_" cases include
+ * waiting for the jobs to finish.
+ *
+ * flags: -threads=<n>, 0 is the threadpool's default.
+ */
+
+#define BENCH_SUBMIT_JOB_COUNT (4096)
+
+struct bench_submit_job_t
+{
+    u32  index;
+    u32 *results;
+};
+
+struct bench_submit_t
+{
+    threadpool_t         pool;
+    threadpool_counter_t counter;
+
+    bench_submit_job_t   jobs[BENCH_SUBMIT_JOB_COUNT];
+    threadpool_task_t    batch[BENCH_SUBMIT_JOB_COUNT];
+    u32                  results[BENCH_SUBMIT_JOB_COUNT];
+};
+
+void
+bench_submit_job(void *user_data)
+{
+    bench_submit_job_t *job = (bench_submit_job_t*)user_data;
+    job->results[job->index] = job->index;
+}
+
+void
+bench_submit_single(void *user_data)
+{
+    bench_submit_t *bench = (bench_submit_t*)user_data;
+    for(u32 job_index = 0; job_index < BENCH_SUBMIT_JOB_COUNT; ++job_index)
+    {
+        c_threadpool_add_task(&bench->pool, bench->jobs + job_index, bench_submit_job, TPTP_High, &bench->counter);
+    }
+}
+
+void
+bench_submit_inline(void *user_data)
+{
+    bench_submit_t *bench = (bench_submit_t*)user_data;
+    for(u32 job_index = 0; job_index < BENCH_SUBMIT_JOB_COUNT; ++job_index)
+    {
+        bench_submit_job_t job = {job_index, bench->results};
+        c_threadpool_add_inline_task(&bench->pool, &job, sizeof(job), bench_submit_job, TPTP_High, &bench->counter);
+    }
+}
+
+void
+bench_submit_batch(void *user_data)
+{
+    bench_submit_t *bench = (bench_submit_t*)user_data;
+    for(u32 job_index = 0; job_index < BENCH_SUBMIT_JOB_COUNT; ++job_index)
+    {
+        bench_submit_job_t job = {job_index, bench->results};
+        bench->batch[job_index] = c_threadpool_make_inline_task(bench_submit_job, &job, sizeof(job));
+    }
+    c_threadpool_add_tasks(&bench->pool, bench->batch, BENCH_SUBMIT_JOB_COUNT, TPTP_High, &bench->counter);
+}
+
+void
+bench_submit_wait(void *user_data)
+{
+    bench_submit_t *bench = (bench_submit_t*)user_data;
+    c_threadpool_wait_for_counter(&bench->pool, &bench->counter);
+    ZeroStruct(bench->counter);
+}
+
+void
+bench_submit_single_total(void *user_data)
+{
+    bench_submit_single(user_data);
+    bench_submit_wait(user_data);
+}
+
+void
+bench_submit_inline_total(void *user_data)
+{
+    bench_submit_inline(user_data);
+    bench_submit_wait(user_data);
+}
+
+void
+bench_submit_batch_total(void *user_data)
+{
+    bench_submit_batch(user_data);
+    bench_submit_wait(user_data);
+}
+
+int
+main(int argc, char **argv)
+{
+    u64 *thread_count = c_program_flag_add_size("threads", 0, "Worker threads, 0 is the threadpool's default\n");
+
+    bench_suite_t *suite = (bench_suite_t*)calloc(1, sizeof(bench_suite_t));
+    bench_suite_init(suite, "threadpool_submit", argc, argv);
+
+    bench_submit_t *bench = (bench_submit_t*)calloc(1, sizeof(bench_submit_t));
+    c_threadpool_init(&bench->pool, (u32)*thread_count);
+    for(u32 job_index = 0; job_index < BENCH_SUBMIT_JOB_COUNT; ++job_index)
+    {
+        bench->jobs[job_index] = {job_index, bench->results};
+    }
+
+    bench_case_t cases[] =
+    {
+        {"submit_single", null, bench_submit_single,       bench_submit_wait, bench, BENCH_SUBMIT_JOB_COUNT, 0},
+        {"submit_inline", null, bench_submit_inline,       bench_submit_wait, bench, BENCH_SUBMIT_JOB_COUNT, 0},
+        {"submit_batch",  null, bench_submit_batch,        bench_submit_wait, bench, BENCH_SUBMIT_JOB_COUNT, 0},
+        {"total_single",  null, bench_submit_single_total, null,              bench, BENCH_SUBMIT_JOB_COUNT, 0},
+        {"total_inline",  null, bench_submit_inline_total, null,              bench, BENCH_SUBMIT_JOB_COUNT, 0},
+        {"total_batch",   null, bench_submit_batch_total,  null,              bench, BENCH_SUBMIT_JOB_COUNT, 0},
+    };
+    for(u32 case_index = 0; case_index < ArrayCount(cases); ++case_index)
+    {
+        bench_suite_run(suite, cases + case_index);
+    }
+
+    c_threadpool_destroy(&bench->pool);
+    free(bench);
+
+    s32 result = bench_suite_finish(suite);
+    free(suite);
+
+    return(result);
+}
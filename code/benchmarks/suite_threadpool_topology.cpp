@@ -0,0 +1,268 @@
+/* ========================================================================
+   $File: suite_threadpool_topology.cpp $
+   $Date: October 18 2026 07:30 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_threadpool.h>
+#include <c_threadpool.cpp>
+#include <c_parallel.h>
+#include <c_parallel.cpp>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_sampler.cpp>
+#include <c_perf_counters.cpp>
+
+#include <benchmarks/bench_harness.h>
+
+/* NOTE(Sleepster): Cache sensitive workloads under every threadpool pin policy ('_<policy>' on the case name).
+ *
+ * private_l2 - every task sweeps its own L2 sized buffer over and over. Suffers when two workers share a core's
+ *              L2 (SMT siblings) or get migrated away from their warm cache.
+ * shared_llc - c_parallel_reduce() passes over one LLC sized array. Likes the workers packed into one LLC group.
+ * fan_out    - lots of tiny tasks on a counter, mostly measures how far the cache lines have to travel
+ *              between the submitter and whoever steals.
+ *
+ * flags: -reserved_cores=<n> -threads=<n>, 0 threads is the threadpool's default.
+ */
+
+#define BENCH_TOPOLOGY_PRIVATE_BYTES     (KB(256))
+#define BENCH_TOPOLOGY_PRIVATE_SWEEPS    (32)
+#define BENCH_TOPOLOGY_SHARED_BYTES      (MB(4))
+#define BENCH_TOPOLOGY_SHARED_PASSES     (16)
+#define BENCH_TOPOLOGY_FAN_OUT_TASKS     (8192)
+#define BENCH_TOPOLOGY_MAX_TASKS         (THREADPOOL_MAX_WORKERS * 4)
+#define BENCH_TOPOLOGY_CASES_PER_POLICY  (3)
+
+struct bench_private_task_t
+{
+    u32          *buffer;
+    volatile u32 *result;
+};
+
+struct bench_topology_t
+{
+    threadpool_t          pool;
+    u32                   private_task_count;
+    bench_private_task_t  private_tasks[BENCH_TOPOLOGY_MAX_TASKS];
+    u32                  *buffers[BENCH_TOPOLOGY_MAX_TASKS];
+    u32                  *shared_values;
+    threadpool_task_t    *batch;
+    char                  case_names[BENCH_TOPOLOGY_CASES_PER_POLICY][BENCH_NAME_LENGTH];
+};
+
+global_variable volatile u32 bench_topology_sink;
+
+void
+bench_private_sweep(void *user_data)
+{
+    bench_private_task_t *task = (bench_private_task_t*)user_data;
+
+    u32 sum = 0;
+    u32 element_count = BENCH_TOPOLOGY_PRIVATE_BYTES / sizeof(u32);
+    for(u32 sweep = 0;
+        sweep < BENCH_TOPOLOGY_PRIVATE_SWEEPS;
+        ++sweep)
+    {
+        for(u32 element_index = 0;
+            element_index < element_count;
+            element_index += 4)
+        {
+            sum += task->buffer[element_index];
+            task->buffer[element_index] = sum;
+        }
+    }
+    *task->result = sum;
+}
+
+void
+bench_shared_sum(void *user_data, u64 begin, u64 end, void *partial_result)
+{
+    u32 *values = (u32*)user_data;
+    u64 *sum    = (u64*)partial_result;
+    for(u64 index = begin;
+        index < end;
+        ++index)
+    {
+        *sum += values[index];
+    }
+}
+
+void
+bench_shared_combine(void *user_data, void *result, void *partial_result)
+{
+    *(u64*)result += *(u64*)partial_result;
+}
+
+void
+bench_tiny_task(void *user_data)
+{
+    AtomicIncrement32(&bench_topology_sink);
+}
+
+void
+bench_topology_private_l2(void *user_data)
+{
+    bench_topology_t *bench = (bench_topology_t*)user_data;
+    threadpool_counter_t counter = {};
+    for(u32 task_index = 0;
+        task_index < bench->private_task_count;
+        ++task_index)
+    {
+        c_threadpool_add_task(&bench->pool, bench->private_tasks + task_index, &bench_private_sweep, TPTP_High, &counter);
+    }
+    c_threadpool_wait_for_counter(&bench->pool, &counter);
+}
+
+void
+bench_topology_shared_llc(void *user_data)
+{
+    bench_topology_t *bench = (bench_topology_t*)user_data;
+    u64 element_count = BENCH_TOPOLOGY_SHARED_BYTES / sizeof(u32);
+    for(u32 pass = 0;
+        pass < BENCH_TOPOLOGY_SHARED_PASSES;
+        ++pass)
+    {
+        u64 sum = 0;
+        c_parallel_reduce(&bench->pool, 0, element_count, 8192, &bench_shared_sum, &bench_shared_combine, bench->shared_values, &sum, sizeof(sum));
+        bench_topology_sink = (u32)sum;
+    }
+}
+
+void
+bench_topology_fan_out(void *user_data)
+{
+    bench_topology_t *bench = (bench_topology_t*)user_data;
+    threadpool_counter_t counter = {};
+    c_threadpool_add_tasks(&bench->pool, bench->batch, BENCH_TOPOLOGY_FAN_OUT_TASKS, TPTP_High, &counter);
+    c_threadpool_wait_for_counter(&bench->pool, &counter);
+}
+
+internal_api void
+bench_topology_print(void)
+{
+    sys_cpu_topology_t *topology = (sys_cpu_topology_t*)sys_allocate_memory(sizeof(sys_cpu_topology_t));
+    bool8 from_os = sys_get_cpu_topology(topology);
+    printf("topology%s: %u cpus, %u cores, %u packages, %u LLC groups, %u NUMA nodes\n",
+           from_os ? "" : " (fallback)",
+           topology->logical_cpu_count, topology->physical_core_count, topology->package_count,
+           topology->llc_count, topology->numa_node_count);
+    printf("%-6s | %-6s | %-6s | %-6s | %-6s | %-6s\n", "cpu", "core", "smt", "pkg", "llc", "node");
+    for(u32 cpu_index = 0;
+        cpu_index < topology->logical_cpu_count;
+        ++cpu_index)
+    {
+        sys_logical_cpu_t *cpu = topology->cpus + cpu_index;
+        printf("%-6u | %-6u | %-6u | %-6u | %-6u | %-6u\n",
+               cpu->cpu_index, cpu->core_index, cpu->smt_index, cpu->package_index, cpu->llc_index, cpu->numa_node);
+    }
+    printf("\n");
+    sys_free_memory(topology, sizeof(sys_cpu_topology_t));
+}
+
+int
+main(int argc, char **argv)
+{
+    u64 *reserved_core_count = c_program_flag_add_size("reserved_cores", 1, "Cores the threadpool leaves alone\n");
+    u64 *thread_count        = c_program_flag_add_size("threads", 0, "Worker threads, 0 is the threadpool's default\n");
+
+    bench_topology_print();
+
+    bench_suite_t *suite = (bench_suite_t*)calloc(1, sizeof(bench_suite_t));
+    bench_suite_init(suite, "threadpool_topology", argc, argv);
+
+    bench_topology_t *bench = (bench_topology_t*)calloc(1, sizeof(bench_topology_t));
+    for(u32 buffer_index = 0;
+        buffer_index < BENCH_TOPOLOGY_MAX_TASKS;
+        ++buffer_index)
+    {
+        bench->buffers[buffer_index] = (u32*)sys_allocate_memory(BENCH_TOPOLOGY_PRIVATE_BYTES);
+        memset(bench->buffers[buffer_index], (s32)buffer_index, BENCH_TOPOLOGY_PRIVATE_BYTES);
+
+        bench->private_tasks[buffer_index].buffer = bench->buffers[buffer_index];
+        bench->private_tasks[buffer_index].result = &bench_topology_sink;
+    }
+
+    bench->shared_values = (u32*)sys_allocate_memory(BENCH_TOPOLOGY_SHARED_BYTES);
+    for(u32 value_index = 0;
+        value_index < BENCH_TOPOLOGY_SHARED_BYTES / sizeof(u32);
+        ++value_index)
+    {
+        bench->shared_values[value_index] = value_index;
+    }
+
+    bench->batch = (threadpool_task_t*)sys_allocate_memory(sizeof(threadpool_task_t) * BENCH_TOPOLOGY_FAN_OUT_TASKS);
+    for(u32 task_index = 0;
+        task_index < BENCH_TOPOLOGY_FAN_OUT_TASKS;
+        ++task_index)
+    {
+        bench->batch[task_index] = c_threadpool_make_task(&bench_tiny_task, null);
+    }
+
+    u64 shared_items = (BENCH_TOPOLOGY_SHARED_BYTES / sizeof(u32)) * BENCH_TOPOLOGY_SHARED_PASSES;
+    for(u32 policy = TPPP_None;
+        policy < TPPP_Count;
+        ++policy)
+    {
+        threadpool_config_t config = {};
+        config.thread_count        = (u32)*thread_count;
+        config.pin_policy          = policy;
+        config.reserved_core_count = (u32)*reserved_core_count;
+        c_threadpool_init_with_config(&bench->pool, &config);
+
+        // NOTE(Sleepster): Four tasks per worker so the steals and the cache reuse actually matter.
+        bench->private_task_count = Min(bench->pool.max_threads * 4, BENCH_TOPOLOGY_MAX_TASKS);
+        u64 private_bytes = (u64)bench->private_task_count * BENCH_TOPOLOGY_PRIVATE_BYTES * BENCH_TOPOLOGY_PRIVATE_SWEEPS;
+
+        bench_case_t cases[] =
+        {
+            {"private_l2", null, bench_topology_private_l2, null, bench, bench->private_task_count,    private_bytes},
+            {"shared_llc", null, bench_topology_shared_llc, null, bench, shared_items,                 BENCH_TOPOLOGY_SHARED_BYTES * BENCH_TOPOLOGY_SHARED_PASSES},
+            {"fan_out",    null, bench_topology_fan_out,    null, bench, BENCH_TOPOLOGY_FAN_OUT_TASKS, 0},
+        };
+        StaticAssert(ArrayCount(cases) == BENCH_TOPOLOGY_CASES_PER_POLICY, "BENCH_TOPOLOGY_CASES_PER_POLICY is out of date...\n");
+
+        for(u32 case_index = 0; case_index < ArrayCount(cases); ++case_index)
+        {
+            char *case_name = bench->case_names[case_index];
+            snprintf(case_name, BENCH_NAME_LENGTH, "%s_%s", cases[case_index].name, threadpool_pin_policy_names[policy]);
+            cases[case_index].name = case_name;
+            bench_suite_run(suite, cases + case_index);
+        }
+
+        c_threadpool_destroy(&bench->pool);
+    }
+
+    sys_free_memory(bench->batch, sizeof(threadpool_task_t) * BENCH_TOPOLOGY_FAN_OUT_TASKS);
+    sys_free_memory(bench->shared_values, BENCH_TOPOLOGY_SHARED_BYTES);
+    for(u32 buffer_index = 0;
+        buffer_index < BENCH_TOPOLOGY_MAX_TASKS;
+        ++buffer_index)
+    {
+        sys_free_memory(bench->buffers[buffer_index], BENCH_TOPOLOGY_PRIVATE_BYTES);
+    }
+    free(bench);
+
+    s32 result = bench_suite_finish(suite);
+    free(suite);
+
+    return(result);
+}
@@ -0,0 +1,135 @@
+/* ========================================================================
+   $File: suite_zone.cpp $
+   $Date: October 19 2026 05:05 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_perf_counters.cpp>
+
+#include <benchmarks/bench_harness.h>
+
+/* NOTE(Sleepster): zone_allocator_t, an item is one alloc plus its free. Every run starts from an empty zone.
+ *
+ * lifo         - 256 byte blocks freed newest first, the cursor never has to walk.
+ * fifo         - 256 byte blocks freed oldest first.
+ * mixed_random - 16 bytes to 16KB, freed in a shuffled order, so the free list fragments and merges like the asset
+ *                zone does.
+ */
+
+#define BENCH_ZONE_SIZE        (MB(64))
+#define BENCH_ZONE_BLOCK_COUNT (2048)
+#define BENCH_ZONE_FIXED_SIZE  (256)
+
+struct bench_zone_t
+{
+    zone_allocator_t *zone;
+    byte             *blocks[BENCH_ZONE_BLOCK_COUNT];
+    u32               sizes[BENCH_ZONE_BLOCK_COUNT];
+    u32               free_order[BENCH_ZONE_BLOCK_COUNT];
+    u64               total_bytes;
+};
+
+void
+bench_zone_lifo(void *user_data)
+{
+    bench_zone_t *bench = (bench_zone_t*)user_data;
+    for(u32 block_index = 0; block_index < BENCH_ZONE_BLOCK_COUNT; ++block_index)
+    {
+        bench->blocks[block_index] = c_za_alloc(bench->zone, BENCH_ZONE_FIXED_SIZE, ZA_TAG_STATIC);
+    }
+    for(u32 block_index = BENCH_ZONE_BLOCK_COUNT; block_index > 0; --block_index)
+    {
+        c_za_free(bench->zone, bench->blocks[block_index - 1]);
+    }
+    bench_consume(bench->zone->allocation_count);
+}
+
+void
+bench_zone_fifo(void *user_data)
+{
+    bench_zone_t *bench = (bench_zone_t*)user_data;
+    for(u32 block_index = 0; block_index < BENCH_ZONE_BLOCK_COUNT; ++block_index)
+    {
+        bench->blocks[block_index] = c_za_alloc(bench->zone, BENCH_ZONE_FIXED_SIZE, ZA_TAG_STATIC);
+    }
+    for(u32 block_index = 0; block_index < BENCH_ZONE_BLOCK_COUNT; ++block_index)
+    {
+        c_za_free(bench->zone, bench->blocks[block_index]);
+    }
+    bench_consume(bench->zone->allocation_count);
+}
+
+void
+bench_zone_mixed_random(void *user_data)
+{
+    bench_zone_t *bench = (bench_zone_t*)user_data;
+    for(u32 block_index = 0; block_index < BENCH_ZONE_BLOCK_COUNT; ++block_index)
+    {
+        bench->blocks[block_index] = c_za_alloc(bench->zone, bench->sizes[block_index], ZA_TAG_TEXTURE);
+    }
+    for(u32 block_index = 0; block_index < BENCH_ZONE_BLOCK_COUNT; ++block_index)
+    {
+        c_za_free(bench->zone, bench->blocks[bench->free_order[block_index]]);
+    }
+    bench_consume(bench->zone->allocation_count);
+}
+
+int
+main(int argc, char **argv)
+{
+    bench_suite_t *suite = (bench_suite_t*)calloc(1, sizeof(bench_suite_t));
+    bench_suite_init(suite, "zone", argc, argv);
+
+    bench_zone_t *bench = (bench_zone_t*)calloc(1, sizeof(bench_zone_t));
+    bench->zone = c_za_create(BENCH_ZONE_SIZE);
+
+    u64 random_state = 0xD1B54A32D192ED03ULL;
+    for(u32 block_index = 0; block_index < BENCH_ZONE_BLOCK_COUNT; ++block_index)
+    {
+        bench->sizes[block_index]      = 16 + (u32)(bench_random_next(&random_state) % KB(16));
+        bench->free_order[block_index] = block_index;
+        bench->total_bytes            += bench->sizes[block_index];
+    }
+    for(u32 block_index = BENCH_ZONE_BLOCK_COUNT - 1; block_index > 0; --block_index)
+    {
+        u32 swap_index = (u32)(bench_random_next(&random_state) % (block_index + 1));
+        u32 temp                       = bench->free_order[block_index];
+        bench->free_order[block_index] = bench->free_order[swap_index];
+        bench->free_order[swap_index]  = temp;
+    }
+
+    u64 fixed_bytes = BENCH_ZONE_BLOCK_COUNT * BENCH_ZONE_FIXED_SIZE;
+    bench_case_t lifo_case   = {"lifo", null, bench_zone_lifo, null, bench, BENCH_ZONE_BLOCK_COUNT, fixed_bytes};
+    bench_case_t fifo_case   = {"fifo", null, bench_zone_fifo, null, bench, BENCH_ZONE_BLOCK_COUNT, fixed_bytes};
+    bench_case_t random_case = {"mixed_random", null, bench_zone_mixed_random, null, bench, BENCH_ZONE_BLOCK_COUNT, bench->total_bytes};
+    bench_suite_run(suite, &lifo_case);
+    bench_suite_run(suite, &fifo_case);
+    bench_suite_run(suite, &random_case);
+
+    c_za_destroy(bench->zone);
+    free(bench);
+
+    s32 result = bench_suite_finish(suite);
+    free(suite);
+
+    return(result);
+}
@@ -0,0 +1,914 @@
+/* ========================================================================
+   $File: c_alloc_trace.cpp $
+   $Date: October 19 2026 10:30 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <SDL3/SDL.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_log.h>
+#include <c_futex.h>
+#include <c_string.h>
+#include <c_file_api.h>
+#include <c_zone_allocator.h>
+
+#include <c_alloc_trace.h>
+#include <p_platform_data.h>
+
+#define ALLOC_TRACE_MAX_PATH_LENGTH   (512)
+#define ALLOC_TRACE_MIN_LIVE_CAPACITY (4096)
+#define ALLOC_TRACE_TOMBSTONE         (~0ULL)
+#define ALLOC_TRACE_READ_CHUNK        (MB(256))
+
+// NOTE(Sleepster): Zone and dynarray allocations that are still out there, by address. 'owner' is the record's.
+struct alloc_trace_live_t
+{
+    u64 address;
+    u64 id;
+    u32 owner;
+};
+
+struct alloc_trace_arena_push_t
+{
+    u64 position;
+    u64 id;
+};
+
+// NOTE(Sleepster): A zone or an arena, its index + 1 is the owner id in the records. A destroyed zone lets go of its
+//                  pointer, the next zone at that address is a new owner.
+struct alloc_trace_owner_t
+{
+    void                     *owner;
+    alloc_trace_arena_push_t *pushes;
+    u64                       push_count;
+    u64                       push_capacity;
+};
+
+struct alloc_trace_capture_t
+{
+    futex_mutex_t          lock;
+    volatile u32           is_running;
+    alloc_tracker_hook_t  *next_hook;
+    bool8                  is_hooked;
+
+    char                   filepath[ALLOC_TRACE_MAX_PATH_LENGTH];
+    file_t                 file;
+    alloc_trace_record_t  *buffer;
+    u32                    buffer_count;
+    bool8                  write_failed;
+    bool8                  reported_failure;
+
+    u64                    next_id;
+    u64                    frame_count;
+    u64                    record_count;
+    u64                    dropped_events;
+    bool8                  reported_full;
+
+    alloc_trace_live_t    *live;
+    u64                    live_capacity;
+    u64                    live_used;
+    u64                    live_count;
+
+    alloc_trace_owner_t    owners[ALLOC_TRACE_MAX_OWNERS];
+    u32                    owner_count;
+    u32                    last_owner_index;
+};
+
+global_variable alloc_trace_capture_t alloc_trace;
+
+/*===========================================
+  ================ RECORDS ==================
+  ===========================================*/
+
+internal_api void
+c_alloc_trace_flush(void)
+{
+    if(alloc_trace.buffer_count && !alloc_trace.write_failed)
+    {
+        alloc_trace.write_failed = !c_file_write(&alloc_trace.file, alloc_trace.buffer, sizeof(alloc_trace_record_t) * alloc_trace.buffer_count);
+    }
+    alloc_trace.buffer_count = 0;
+}
+
+internal_api void
+c_alloc_trace_emit(u32 op, u32 kind, u32 tag, u32 alignment_shift, u32 owner, u64 id, u64 size)
+{
+    alloc_trace_record_t *record = alloc_trace.buffer + alloc_trace.buffer_count++;
+    record->op              = (u8)op;
+    record->kind            = (u8)kind;
+    record->tag             = (u8)tag;
+    record->alignment_shift = (u8)alignment_shift;
+    record->owner           = owner;
+    record->id              = id;
+    record->size            = size;
+    record->ticks           = SDL_GetPerformanceCounter();
+    ++alloc_trace.record_count;
+
+    if(alloc_trace.buffer_count == ALLOC_TRACE_BUFFER_RECORDS) c_alloc_trace_flush();
+}
+
+internal_api u32
+c_alloc_trace_get_alignment_shift(u64 address)
+{
+    u32 result = ALLOC_TRACE_MAX_ALIGNMENT_SHIFT;
+    for(u32 shift = 0; shift < ALLOC_TRACE_MAX_ALIGNMENT_SHIFT; ++shift)
+    {
+        if(address & (1ULL << shift))
+        {
+            result = shift;
+            break;
+        }
+    }
+
+    return(result);
+}
+
+/*===========================================
+  ============= LIVE ALLOCATIONS ============
+  ===========================================*/
+
+internal_api u64
+c_alloc_trace_hash_address(u64 address)
+{
+    u64 result = (address >> 4) * 0x9E3779B97F4A7C15ULL;
+    return(result ^ (result >> 29));
+}
+
+internal_api void
+c_alloc_trace_live_grow(void)
+{
+    u64 new_capacity = ALLOC_TRACE_MIN_LIVE_CAPACITY;
+    while(new_capacity < alloc_trace.live_count * 4) new_capacity *= 2;
+
+    alloc_trace_live_t *new_live = (alloc_trace_live_t*)sys_allocate_memory(sizeof(alloc_trace_live_t) * new_capacity);
+    Assert(new_live);
+
+    for(u64 entry_index = 0; entry_index < alloc_trace.live_capacity; ++entry_index)
+    {
+        alloc_trace_live_t *entry = alloc_trace.live + entry_index;
+        if(entry->address == 0 || entry->address == ALLOC_TRACE_TOMBSTONE) continue;
+
+        u64 slot = c_alloc_trace_hash_address(entry->address) & (new_capacity - 1);
+        while(new_live[slot].address) slot = (slot + 1) & (new_capacity - 1);
+        new_live[slot] = *entry;
+    }
+
+    if(alloc_trace.live) sys_free_memory(alloc_trace.live, sizeof(alloc_trace_live_t) * alloc_trace.live_capacity);
+    alloc_trace.live          = new_live;
+    alloc_trace.live_capacity = new_capacity;
+    alloc_trace.live_used     = alloc_trace.live_count;
+}
+
+internal_api void
+c_alloc_trace_live_add(u64 address, u64 id, u32 owner)
+{
+    if((alloc_trace.live_used + 1) * 4 > alloc_trace.live_capacity * 3) c_alloc_trace_live_grow();
+
+    u64 mask = alloc_trace.live_capacity - 1;
+    u64 slot = c_alloc_trace_hash_address(address) & mask;
+    while(alloc_trace.live[slot].address && alloc_trace.live[slot].address != ALLOC_TRACE_TOMBSTONE)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    alloc_trace_live_t *entry = alloc_trace.live + slot;
+    if(entry->address == 0) ++alloc_trace.live_used;
+    entry->address = address;
+    entry->id      = id;
+    entry->owner   = owner;
+    ++alloc_trace.live_count;
+}
+
+// NOTE(Sleepster): Anything allocated before the capture started isn't in here, its free isn't recorded.
+internal_api alloc_trace_live_t*
+c_alloc_trace_live_find(u64 address)
+{
+    alloc_trace_live_t *result = null;
+
+    u64 mask = alloc_trace.live_capacity - 1;
+    u64 slot = c_alloc_trace_hash_address(address) & mask;
+    while(alloc_trace.live[slot].address)
+    {
+        if(alloc_trace.live[slot].address == address)
+        {
+            result = alloc_trace.live + slot;
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return(result);
+}
+
+internal_api void
+c_alloc_trace_live_remove(alloc_trace_live_t *entry)
+{
+    entry->address = ALLOC_TRACE_TOMBSTONE;
+    --alloc_trace.live_count;
+}
+
+/*===========================================
+  ================ OWNERS ===================
+  ===========================================*/
+
+// NOTE(Sleepster): Returns the owner id, 0 when it isn't known (or there's no room left for it).
+internal_api u32
+c_alloc_trace_find_owner(void *owner, bool8 should_add)
+{
+    u32 result = 0;
+    if(alloc_trace.last_owner_index < alloc_trace.owner_count && alloc_trace.owners[alloc_trace.last_owner_index].owner == owner)
+    {
+        result = alloc_trace.last_owner_index + 1;
+    }
+    else
+    {
+        for(u32 owner_index = 0; owner_index < alloc_trace.owner_count; ++owner_index)
+        {
+            if(alloc_trace.owners[owner_index].owner == owner)
+            {
+                alloc_trace.last_owner_index = owner_index;
+                result = owner_index + 1;
+                break;
+            }
+        }
+
+        if(!result && should_add)
+        {
+            if(alloc_trace.owner_count < ALLOC_TRACE_MAX_OWNERS)
+            {
+                alloc_trace.last_owner_index = alloc_trace.owner_count;
+                alloc_trace_owner_t *added = alloc_trace.owners + alloc_trace.owner_count++;
+                ZeroStruct(*added);
+                added->owner = owner;
+                result       = alloc_trace.owner_count;
+            }
+            else
+            {
+                ++alloc_trace.dropped_events;
+            }
+        }
+    }
+
+    return(result);
+}
+
+internal_api void
+c_alloc_trace_arena_push(u32 owner, u64 position, u64 id)
+{
+    alloc_trace_owner_t *arena = alloc_trace.owners + (owner - 1);
+    if(arena->push_count == arena->push_capacity)
+    {
+        arena->push_capacity = Max(arena->push_capacity * 2, (u64)256);
+        arena->pushes        = (alloc_trace_arena_push_t*)realloc(arena->pushes, sizeof(alloc_trace_arena_push_t) * arena->push_capacity);
+        Assert(arena->pushes);
+    }
+
+    alloc_trace_arena_push_t *push = arena->pushes + arena->push_count++;
+    push->position = position;
+    push->id       = id;
+}
+
+/*===========================================
+  ================== HOOK ===================
+  ===========================================*/
+
+internal_api void
+c_alloc_trace_hook(u32 event, void *owner, u64 address, u64 size, const char *file, u32 line)
+{
+    alloc_tracker_hook_t *next_hook = alloc_trace.next_hook;
+    if(next_hook) next_hook(event, owner, address, size, file, line);
+
+    c_futex_mutex_lock(&alloc_trace.lock);
+    if(!alloc_trace.is_running)
+    {
+        c_futex_mutex_unlock(&alloc_trace.lock);
+        return;
+    }
+
+    switch(event)
+    {
+        case AE_ArenaPush:
+        {
+            // NOTE(Sleepster): 'address' is a position, not a pointer. Every push is rounded up to 16 bytes and every
+            //                  block starts on a page, so 16 is what a push gets.
+            u32 owner_id = c_alloc_trace_find_owner(owner, true);
+            if(!owner_id) break;
+
+            u64 id = ++alloc_trace.next_id;
+            c_alloc_trace_arena_push(owner_id, address, id);
+            c_alloc_trace_emit(ATO_Alloc, ASK_Arena, 0, 4, owner_id, id, size);
+        }break;
+        case AE_ArenaRewind:
+        {
+            u32 owner_id = c_alloc_trace_find_owner(owner, false);
+            if(!owner_id) break;
+
+            alloc_trace_owner_t *arena = alloc_trace.owners + (owner_id - 1);
+            while(arena->push_count && arena->pushes[arena->push_count - 1].position >= address)
+            {
+                alloc_trace_arena_push_t *push = arena->pushes + --arena->push_count;
+                c_alloc_trace_emit(ATO_Free, ASK_Arena, 0, 0, owner_id, push->id, 0);
+            }
+        }break;
+        case AE_ZoneAlloc:
+        {
+            u32 owner_id = c_alloc_trace_find_owner(owner, true);
+            if(!owner_id) break;
+
+            // NOTE(Sleepster): The tag isn't in the event, the block header right before the data has it.
+            zone_allocator_block_t *block = (zone_allocator_block_t*)(address - sizeof(zone_allocator_block_t));
+            u64 id = ++alloc_trace.next_id;
+            c_alloc_trace_live_add(address, id, owner_id);
+            c_alloc_trace_emit(ATO_Alloc, ASK_Zone, (u32)block->allocation_tag, c_alloc_trace_get_alignment_shift(address), owner_id, id, size);
+        }break;
+        case AE_DynarrayCreate:
+        {
+            u64 id = ++alloc_trace.next_id;
+            c_alloc_trace_live_add(address, id, 0);
+            c_alloc_trace_emit(ATO_Alloc, ASK_Dynarray, 0, c_alloc_trace_get_alignment_shift(address), 0, id, size);
+        }break;
+        case AE_ZoneFree:
+        case AE_DynarrayDestroy:
+        {
+            alloc_trace_live_t *entry = c_alloc_trace_live_find(address);
+            if(entry)
+            {
+                c_alloc_trace_emit(ATO_Free, event == AE_ZoneFree ? ASK_Zone : ASK_Dynarray, 0, 0, entry->owner, entry->id, 0);
+                c_alloc_trace_live_remove(entry);
+            }
+        }break;
+        case AE_ZoneDestroy:
+        {
+            u32 owner_id = c_alloc_trace_find_owner(owner, false);
+            if(!owner_id) break;
+
+            for(u64 entry_index = 0; entry_index < alloc_trace.live_capacity; ++entry_index)
+            {
+                alloc_trace_live_t *entry = alloc_trace.live + entry_index;
+                if(entry->address && entry->address != ALLOC_TRACE_TOMBSTONE && entry->owner == owner_id)
+                {
+                    c_alloc_trace_emit(ATO_Free, ASK_Zone, 0, 0, owner_id, entry->id, 0);
+                    c_alloc_trace_live_remove(entry);
+                }
+            }
+            alloc_trace.owners[owner_id - 1].owner = null;
+        }break;
+        case AE_DynarrayResize:
+        {
+            // NOTE(Sleepster): A realloc, the old array's free and the new one's alloc. One that was made before the
+            //                  capture started only gets the alloc.
+            alloc_trace_live_t *entry = c_alloc_trace_live_find((u64)(usize)owner);
+            if(entry)
+            {
+                c_alloc_trace_emit(ATO_Free, ASK_Dynarray, 0, 0, 0, entry->id, 0);
+                c_alloc_trace_live_remove(entry);
+            }
+
+            u64 id = ++alloc_trace.next_id;
+            c_alloc_trace_live_add(address, id, 0);
+            c_alloc_trace_emit(ATO_Alloc, ASK_Dynarray, 0, c_alloc_trace_get_alignment_shift(address), 0, id, size);
+        }break;
+    }
+
+    bool8 report_full = alloc_trace.dropped_events && !alloc_trace.reported_full;
+    bool8 report_fail = alloc_trace.write_failed   && !alloc_trace.reported_failure;
+    alloc_trace.reported_full    |= report_full;
+    alloc_trace.reported_failure |= report_fail;
+    c_futex_mutex_unlock(&alloc_trace.lock);
+
+    if(report_full)
+    {
+        log_warning("Allocation trace is out of owners ('%u'), some zones or arenas aren't recorded...\n", ALLOC_TRACE_MAX_OWNERS);
+    }
+    if(report_fail)
+    {
+        log_error("Failed to write to the allocation trace '%s', the rest of it is lost...\n", alloc_trace.filepath);
+    }
+}
+
+/*===========================================
+  ================ CAPTURE ==================
+  ===========================================*/
+
+bool8
+c_alloc_trace_start(string_t filepath)
+{
+    bool8 result = false;
+
+    c_futex_mutex_lock(&alloc_trace.lock);
+    if(alloc_trace.is_running)
+    {
+        c_futex_mutex_unlock(&alloc_trace.lock);
+        log_warning("An allocation trace is already being captured to '%s'...\n", alloc_trace.filepath);
+        return(result);
+    }
+
+    for(u32 owner_index = 0; owner_index < alloc_trace.owner_count; ++owner_index)
+    {
+        free(alloc_trace.owners[owner_index].pushes);
+    }
+    if(alloc_trace.live) sys_free_memory(alloc_trace.live, sizeof(alloc_trace_live_t) * alloc_trace.live_capacity);
+
+    futex_mutex_t         lock      = alloc_trace.lock;
+    alloc_tracker_hook_t *next_hook = alloc_trace.next_hook;
+    bool8                 is_hooked = alloc_trace.is_hooked;
+    alloc_trace_record_t *buffer    = alloc_trace.buffer;
+    ZeroStruct(alloc_trace);
+    alloc_trace.lock      = lock;
+    alloc_trace.next_hook = next_hook;
+    alloc_trace.is_hooked = is_hooked;
+    alloc_trace.buffer    = buffer;
+
+    snprintf(alloc_trace.filepath, ALLOC_TRACE_MAX_PATH_LENGTH, "%.*s", (s32)filepath.count, C_STR(filepath));
+    alloc_trace.file = sys_file_open(c_string_create(alloc_trace.filepath), true, false, false);
+    if(alloc_trace.file.handle != INVALID_FILE_HANDLE)
+    {
+        if(!alloc_trace.buffer) alloc_trace.buffer = (alloc_trace_record_t*)sys_allocate_memory(sizeof(alloc_trace_record_t) * ALLOC_TRACE_BUFFER_RECORDS);
+
+        alloc_trace_header_t header = {};
+        header.magic            = ALLOC_TRACE_MAGIC;
+        header.version          = ALLOC_TRACE_VERSION;
+        header.record_size      = sizeof(alloc_trace_record_t);
+        header.ticks_per_second = SDL_GetPerformanceFrequency();
+        result = c_file_write(&alloc_trace.file, &header, sizeof(header));
+        if(result)
+        {
+            c_alloc_trace_live_grow();
+            AtomicStore32(&alloc_trace.is_running, 1);
+            if(!alloc_trace.is_hooked)
+            {
+                alloc_trace.next_hook = alloc_tracker_hook;
+                alloc_trace.is_hooked = true;
+                alloc_tracker_hook    = c_alloc_trace_hook;
+            }
+        }
+        else
+        {
+            c_file_close(&alloc_trace.file);
+        }
+    }
+    c_futex_mutex_unlock(&alloc_trace.lock);
+
+    if(result) log_info("Capturing an allocation trace to '%s'...\n", alloc_trace.filepath);
+    else       log_error("Failed to open '%s' for the allocation trace...\n", alloc_trace.filepath);
+    return(result);
+}
+
+// NOTE(Sleepster): Whatever is still live stays unfreed in the trace, the replay counts it as live to the end.
+void
+c_alloc_trace_stop(void)
+{
+    c_futex_mutex_lock(&alloc_trace.lock);
+    if(alloc_tracker_hook == c_alloc_trace_hook)
+    {
+        alloc_tracker_hook    = alloc_trace.next_hook;
+        alloc_trace.is_hooked = false;
+    }
+
+    bool8 was_running = alloc_trace.is_running != 0;
+    if(was_running)
+    {
+        AtomicStore32(&alloc_trace.is_running, 0);
+        c_alloc_trace_flush();
+        c_file_close(&alloc_trace.file);
+    }
+    c_futex_mutex_unlock(&alloc_trace.lock);
+
+    if(was_running)
+    {
+        log_info("Allocation trace '%s' has '%llu' records over '%llu' frames, '%llu' allocations, '%llu' events dropped...\n",
+                 alloc_trace.filepath, (unsigned long long)alloc_trace.record_count, (unsigned long long)alloc_trace.frame_count,
+                 (unsigned long long)alloc_trace.next_id, (unsigned long long)alloc_trace.dropped_events);
+    }
+}
+
+bool8
+c_alloc_trace_is_running(void)
+{
+    bool8 result = AtomicLoad32(&alloc_trace.is_running) != 0;
+    return(result);
+}
+
+void
+c_alloc_trace_frame_end(void)
+{
+    if(!c_alloc_trace_is_running()) return;
+
+    c_futex_mutex_lock(&alloc_trace.lock);
+    if(alloc_trace.is_running) c_alloc_trace_emit(ATO_Frame, 0, 0, 0, 0, alloc_trace.frame_count++, 0);
+    c_futex_mutex_unlock(&alloc_trace.lock);
+}
+
+/*===========================================
+  ================ LOADING ==================
+  ===========================================*/
+
+bool8
+c_alloc_trace_load(string_t filepath, alloc_trace_t *trace)
+{
+    bool8 result = false;
+    ZeroStruct(*trace);
+
+    file_t file = sys_file_open(filepath, false, false, false);
+    if(file.handle == INVALID_FILE_HANDLE)
+    {
+        log_error("Failed to open the allocation trace '%.*s'...\n", (s32)filepath.count, C_STR(filepath));
+        return(result);
+    }
+
+    // NOTE(Sleepster): sys_file_read() takes 32 bit offsets, a trace can't be past 4GB (134 million records).
+    s64 file_size = sys_file_get_size(&file);
+    bool8 header_read = file_size >= (s64)sizeof(alloc_trace_header_t) && file_size <= (s64)0xFFFFFFFF &&
+                        sys_file_read(&file, &trace->header, sizeof(alloc_trace_header_t), 0);
+    if(!header_read || trace->header.magic != ALLOC_TRACE_MAGIC || trace->header.version != ALLOC_TRACE_VERSION ||
+       trace->header.record_size != sizeof(alloc_trace_record_t))
+    {
+        log_error("'%.*s' isn't a version '%u' allocation trace...\n", (s32)filepath.count, C_STR(filepath), ALLOC_TRACE_VERSION);
+        c_file_close(&file);
+        return(result);
+    }
+
+    u64 record_bytes   = (u64)file_size - sizeof(alloc_trace_header_t);
+    trace->record_count = record_bytes / sizeof(alloc_trace_record_t);
+    record_bytes        = trace->record_count * sizeof(alloc_trace_record_t);
+    if(trace->record_count)
+    {
+        trace->records = (alloc_trace_record_t*)sys_allocate_memory(record_bytes);
+        result         = trace->records != null;
+        for(u64 offset = 0; result && offset < record_bytes; offset += ALLOC_TRACE_READ_CHUNK)
+        {
+            u32 chunk_size = (u32)Min(record_bytes - offset, (u64)ALLOC_TRACE_READ_CHUNK);
+            result = sys_file_read(&file, (byte*)trace->records + offset, chunk_size, (u32)(sizeof(alloc_trace_header_t) + offset));
+        }
+    }
+    else
+    {
+        result = true;
+    }
+    c_file_close(&file);
+
+    if(!result)
+    {
+        log_error("Failed to read the allocation trace '%.*s'...\n", (s32)filepath.count, C_STR(filepath));
+        c_alloc_trace_free(trace);
+        return(result);
+    }
+
+    // NOTE(Sleepster): The peak of what was live, for sizing a backend. The sizes are only on the allocs.
+    u64  size_capacity = 0;
+    u64 *sizes         = null;
+    u64  live_bytes    = 0;
+    for(u64 record_index = 0; record_index < trace->record_count; ++record_index)
+    {
+        alloc_trace_record_t *record = trace->records + record_index;
+        if(record->op == ATO_Frame)
+        {
+            ++trace->frame_count;
+            continue;
+        }
+
+        if(record->id >= size_capacity)
+        {
+            u64 new_capacity = Max(size_capacity * 2, (u64)65536);
+            while(new_capacity <= record->id) new_capacity *= 2;
+            sizes = (u64*)realloc(sizes, sizeof(u64) * new_capacity);
+            Assert(sizes);
+            memset(sizes + size_capacity, 0, sizeof(u64) * (new_capacity - size_capacity));
+            size_capacity = new_capacity;
+        }
+
+        if(record->op == ATO_Alloc)
+        {
+            ++trace->alloc_count;
+            sizes[record->id] = record->size;
+            live_bytes       += record->size;
+            if(live_bytes > trace->peak_live_bytes) trace->peak_live_bytes = live_bytes;
+        }
+        else
+        {
+            ++trace->free_count;
+            live_bytes       -= Min(sizes[record->id], live_bytes);
+            sizes[record->id] = 0;
+        }
+        if(record->id > trace->max_id) trace->max_id = record->id;
+    }
+    free(sizes);
+
+    return(result);
+}
+
+void
+c_alloc_trace_free(alloc_trace_t *trace)
+{
+    if(trace->records) sys_free_memory(trace->records, sizeof(alloc_trace_record_t) * trace->record_count);
+    ZeroStruct(*trace);
+}
+
+/*===========================================
+  ================ BACKENDS =================
+  ===========================================*/
+
+internal_api void*
+c_alloc_replay_zone_create(u64 capacity)
+{
+    void *result = c_za_create(capacity);
+    return(result);
+}
+
+// NOTE(Sleepster): The zone only ever tags, the alignment is whatever its block headers leave it at. Purgeable tags
+//                  come in as static, a zone under pressure purging them would free ids the replay still has.
+internal_api void*
+c_alloc_replay_zone_alloc(void *backend, u64 size, u32 alignment, u32 tag)
+{
+    za_allocation_tag_t zone_tag = (tag && tag < ZA_TAG_PURGELEVEL) ? (za_allocation_tag_t)tag : ZA_TAG_STATIC;
+    void *result = c_za_alloc((zone_allocator_t*)backend, size, zone_tag);
+    return(result);
+}
+
+internal_api void
+c_alloc_replay_zone_free(void *backend, void *data, u64 size)
+{
+    c_za_free((zone_allocator_t*)backend, data);
+}
+
+// NOTE(Sleepster): Up to the end of the furthest block still allocated, the free blocks under it are the fragmentation.
+internal_api u64
+c_alloc_replay_zone_footprint(void *backend)
+{
+    zone_allocator_t *zone   = (zone_allocator_t*)backend;
+    u64               result = 0;
+    for(zone_allocator_block_t *block = zone->first_block.next_block; block != &zone->first_block; block = block->next_block)
+    {
+        if(block->is_allocated)
+        {
+            u64 block_end = (u64)(((byte*)block + block->block_size) - zone->base);
+            if(block_end > result) result = block_end;
+        }
+    }
+
+    return(result);
+}
+
+internal_api void
+c_alloc_replay_zone_destroy(void *backend)
+{
+    c_za_destroy((zone_allocator_t*)backend);
+}
+
+// NOTE(Sleepster): The heap isn't ours alone, the footprint is relative to what it had when the replay started.
+struct alloc_replay_malloc_t
+{
+    u64 base_heap_bytes;
+};
+
+internal_api void*
+c_alloc_replay_malloc_create(u64 capacity)
+{
+    alloc_replay_malloc_t *result = (alloc_replay_malloc_t*)sys_allocate_memory(sizeof(alloc_replay_malloc_t));
+    result->base_heap_bytes = sys_get_heap_bytes();
+    return(result);
+}
+
+internal_api void*
+c_alloc_replay_malloc_alloc(void *backend, u64 size, u32 alignment, u32 tag)
+{
+    void *result = malloc(size);
+    return(result);
+}
+
+internal_api void
+c_alloc_replay_malloc_free(void *backend, void *data, u64 size)
+{
+    free(data);
+}
+
+internal_api u64
+c_alloc_replay_malloc_footprint(void *backend)
+{
+    alloc_replay_malloc_t *state      = (alloc_replay_malloc_t*)backend;
+    u64                    heap_bytes = sys_get_heap_bytes();
+    u64                    result     = heap_bytes > state->base_heap_bytes ? heap_bytes - state->base_heap_bytes : 0;
+    return(result);
+}
+
+internal_api void
+c_alloc_replay_malloc_destroy(void *backend)
+{
+    sys_free_memory(backend, sizeof(alloc_replay_malloc_t));
+}
+
+global_variable alloc_replay_backend_t alloc_replay_zone_backend = {
+    "zone",
+    c_alloc_replay_zone_create,
+    c_alloc_replay_zone_alloc,
+    c_alloc_replay_zone_free,
+    c_alloc_replay_zone_footprint,
+    c_alloc_replay_zone_destroy,
+};
+
+global_variable alloc_replay_backend_t alloc_replay_malloc_backend = {
+    "malloc",
+    c_alloc_replay_malloc_create,
+    c_alloc_replay_malloc_alloc,
+    c_alloc_replay_malloc_free,
+    c_alloc_replay_malloc_footprint,
+    c_alloc_replay_malloc_destroy,
+};
+
+alloc_replay_backend_t*
+c_alloc_replay_get_zone_backend(void)
+{
+    return(&alloc_replay_zone_backend);
+}
+
+alloc_replay_backend_t*
+c_alloc_replay_get_malloc_backend(void)
+{
+    return(&alloc_replay_malloc_backend);
+}
+
+/*===========================================
+  ================= REPLAY ==================
+  ===========================================*/
+
+internal_api void
+c_alloc_replay_sample(alloc_replay_result_t *result, u64 *sample_capacity, u64 record_index, u64 frame_index,
+                      u64 live_bytes, u64 footprint_bytes)
+{
+    if(result->sample_count == *sample_capacity)
+    {
+        *sample_capacity = Max(*sample_capacity * 2, (u64)1024);
+        result->samples  = (alloc_replay_sample_t*)realloc(result->samples, sizeof(alloc_replay_sample_t) * *sample_capacity);
+        Assert(result->samples);
+    }
+
+    // NOTE(Sleepster): A backend can be holding less than what's live (malloc handing a free chunk back out of memory
+    //                  it already had before we started), that's no fragmentation rather than a negative one.
+    alloc_replay_sample_t *sample = result->samples + result->sample_count++;
+    sample->record_index    = record_index;
+    sample->frame_index     = frame_index;
+    sample->live_bytes      = live_bytes;
+    sample->footprint_bytes = footprint_bytes;
+    sample->fragmentation   = footprint_bytes > live_bytes ? 1.0f - (float32)((float64)live_bytes / (float64)footprint_bytes) : 0.0f;
+
+    if(footprint_bytes > result->peak_footprint_bytes)       result->peak_footprint_bytes = footprint_bytes;
+    if(sample->fragmentation > result->peak_fragmentation)   result->peak_fragmentation   = sample->fragmentation;
+    result->final_fragmentation = sample->fragmentation;
+}
+
+bool8
+c_alloc_replay_run(alloc_trace_t *trace, alloc_replay_backend_t *backend, alloc_replay_config_t *config, alloc_replay_result_t *result)
+{
+    ZeroStruct(*result);
+    result->backend_name = backend->name;
+
+    alloc_replay_config_t defaults = {};
+    if(!config) config = &defaults;
+    u32 kind_mask     = config->kind_mask     ? config->kind_mask     : ((1u << ASK_Count) - 1);
+    u64 sample_events = config->sample_events ? config->sample_events : ALLOC_REPLAY_DEFAULT_SAMPLE_EVENTS;
+    u64 capacity      = config->capacity      ? config->capacity      : Max(trace->peak_live_bytes * 4, (u64)MB(16));
+
+    // NOTE(Sleepster): By id, what the backend handed out and what was asked for.
+    u64    id_count = trace->max_id + 1;
+    void **pointers = (void**)sys_allocate_memory(sizeof(void*) * id_count);
+    u64   *sizes    = (u64*)sys_allocate_memory(sizeof(u64) * id_count);
+    void  *state    = pointers && sizes ? backend->create(capacity) : null;
+    if(!state)
+    {
+        log_error("Failed to set up the '%s' backend for the allocation replay...\n", backend->name);
+        if(pointers) sys_free_memory(pointers, sizeof(void*) * id_count);
+        if(sizes)    sys_free_memory(sizes, sizeof(u64) * id_count);
+        return(false);
+    }
+
+    u64 sample_capacity     = 0;
+    u64 live_bytes          = 0;
+    u64 frame_index         = 0;
+    u64 events_since_sample = 0;
+    u64 elapsed_counts      = 0;
+    u64 segment_start       = SDL_GetPerformanceCounter();
+    for(u64 record_index = 0; record_index < trace->record_count; ++record_index)
+    {
+        alloc_trace_record_t *record = trace->records + record_index;
+        if(record->op == ATO_Frame || events_since_sample == sample_events)
+        {
+            elapsed_counts += SDL_GetPerformanceCounter() - segment_start;
+            c_alloc_replay_sample(result, &sample_capacity, record_index, frame_index, live_bytes, backend->get_footprint(state));
+            events_since_sample = 0;
+            segment_start       = SDL_GetPerformanceCounter();
+            if(record->op == ATO_Frame)
+            {
+                ++frame_index;
+                continue;
+            }
+        }
+        ++events_since_sample;
+        if(!(kind_mask & (1u << record->kind))) continue;
+
+        if(record->op == ATO_Alloc)
+        {
+            void *data = backend->alloc(state, record->size, 1u << record->alignment_shift, record->tag);
+            if(data)
+            {
+                pointers[record->id] = data;
+                sizes[record->id]    = record->size;
+                live_bytes          += record->size;
+                if(live_bytes > result->peak_live_bytes) result->peak_live_bytes = live_bytes;
+                ++result->alloc_count;
+            }
+            else
+            {
+                ++result->failed_count;
+            }
+        }
+        else if(pointers[record->id])
+        {
+            backend->free(state, pointers[record->id], sizes[record->id]);
+            live_bytes          -= sizes[record->id];
+            pointers[record->id] = null;
+            ++result->free_count;
+        }
+    }
+    elapsed_counts += SDL_GetPerformanceCounter() - segment_start;
+    c_alloc_replay_sample(result, &sample_capacity, trace->record_count, frame_index, live_bytes, backend->get_footprint(state));
+
+    float64 fragmentation_sum = 0.0;
+    for(u64 sample_index = 0; sample_index < result->sample_count; ++sample_index)
+    {
+        fragmentation_sum += result->samples[sample_index].fragmentation;
+    }
+    result->average_fragmentation = (float32)(fragmentation_sum / (float64)result->sample_count);
+    result->seconds               = (float64)elapsed_counts / (float64)SDL_GetPerformanceFrequency();
+    result->ops_per_second        = result->seconds > 0.0 ? (float64)(result->alloc_count + result->free_count) / result->seconds : 0.0;
+
+    // NOTE(Sleepster): Whatever the trace never freed goes back before the backend does, malloc has no destroy of its own.
+    for(u64 id = 0; id < id_count; ++id)
+    {
+        if(pointers[id]) backend->free(state, pointers[id], sizes[id]);
+    }
+    backend->destroy(state);
+    sys_free_memory(pointers, sizeof(void*) * id_count);
+    sys_free_memory(sizes, sizeof(u64) * id_count);
+
+    return(true);
+}
+
+void
+c_alloc_replay_free_result(alloc_replay_result_t *result)
+{
+    free(result->samples);
+    ZeroStruct(*result);
+}
+
+void
+c_alloc_replay_log(alloc_replay_result_t *result)
+{
+    log_info("Allocation replay on '%s': '%llu' allocs, '%llu' frees, '%llu' failed in %.3f ms, %.2f M ops/s...\n",
+             result->backend_name, (unsigned long long)result->alloc_count, (unsigned long long)result->free_count,
+             (unsigned long long)result->failed_count, result->seconds * 1000.0, result->ops_per_second / 1000000.0);
+    log_info("    peak live %.2f MB, peak footprint %.2f MB, fragmentation peak %.1f%%, average %.1f%%, final %.1f%% over '%llu' samples...\n",
+             (float64)result->peak_live_bytes / (float64)MB(1), (float64)result->peak_footprint_bytes / (float64)MB(1),
+             result->peak_fragmentation * 100.0f, result->average_fragmentation * 100.0f, result->final_fragmentation * 100.0f,
+             (unsigned long long)result->sample_count);
+}
+
+bool8
+c_alloc_replay_dump_csv(alloc_replay_result_t *results, u32 result_count, string_t filepath)
+{
+    bool8 result = false;
+
+    file_t file = sys_file_open(filepath, true, false, false);
+    if(file.handle == INVALID_FILE_HANDLE)
+    {
+        log_error("Failed to open '%.*s' for the allocation replay samples...\n", (s32)filepath.count, C_STR(filepath));
+        return(result);
+    }
+
+    char  line[256];
+    u32   line_length = snprintf(line, sizeof(line), "backend,record,frame,live_bytes,footprint_bytes,fragmentation\n");
+    result = c_file_write(&file, line, line_length);
+    for(u32 result_index = 0; result && result_index < result_count; ++result_index)
+    {
+        alloc_replay_result_t *replay = results + result_index;
+        for(u64 sample_index = 0; result && sample_index < replay->sample_count; ++sample_index)
+        {
+            alloc_replay_sample_t *sample = replay->samples + sample_index;
+            line_length = snprintf(line, sizeof(line), "%s,%llu,%llu,%llu,%llu,%.4f\n", replay->backend_name,
+                                   (unsigned long long)sample->record_index, (unsigned long long)sample->frame_index,
+                                   (unsigned long long)sample->live_bytes, (unsigned long long)sample->footprint_bytes,
+                                   sample->fragmentation);
+            result = c_file_write(&file, line, line_length);
+        }
+    }
+    c_file_close(&file);
+
+    return(result);
+}
@@ -0,0 +1,176 @@
+#if !defined(C_ALLOC_TRACE_H)
+/* ========================================================================
+   $File: c_alloc_trace.h $
+   $Date: October 19 2026 10:30 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define C_ALLOC_TRACE_H
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_alloc_tracker.h>
+
+/* NOTE(Sleepster): Records every allocation and free the game makes to a file, and plays those files back against an
+ * allocator, for seeing how an allocator would have held up under a real session without running the session again.
+ *
+ * Capturing hangs off the same hook as c_alloc_tracker.h, c_alloc_trace_start() puts itself in front of whatever hook
+ * was there and passes every event along, so the tracker and a capture can run at once. Stop them in the reverse of
+ * the order they were started.
+ *
+ * Each allocation gets an id, its free names that id instead of an address, so a replay doesn't care where the
+ * allocator put anything. A record has the size that was asked for, the kind of allocator, the zone tag, the
+ * alignment the allocation actually got (log2, capped at ALLOC_TRACE_MAX_ALIGNMENT_SHIFT), which zone or arena it came
+ * from, and an rdtsc timestamp. Lifetimes are the ticks between an id's alloc and its free. The same rules as the
+ * tracker for what a free is:
+ *   zones     - c_za_free(), or a free for everything the zone still had when it's destroyed.
+ *   dynarrays - c_dynarray_destroy(). A grow is a free of the old array and an alloc of the new one, it's a realloc.
+ *   arenas    - a rewind frees every push past the point the arena went back to, newest first.
+ * c_alloc_trace_frame_end() writes a frame marker, the replay samples the fragmentation at each one.
+ *
+ * The file is an alloc_trace_header_t and then records to the end. Records are buffered and written out
+ * ALLOC_TRACE_BUFFER_RECORDS at a time under the capture's lock, that write is a hitch in whichever thread filled
+ * the buffer.
+ *
+ * c_alloc_replay_run() plays a loaded trace against an alloc_replay_backend_t, every allocator kind in the trace into
+ * the one backend unless the config masks some out. The ops are timed, the sampling isn't. A sample is the bytes the
+ * trace has live, the backend's footprint (what it has taken from the OS, or the span of its memory it's using) and
+ * the fragmentation, 1 - live / footprint.
+ */
+
+#define ALLOC_TRACE_MAGIC                 (0x43525441) // NOTE(Sleepster): 'ATRC'
+#define ALLOC_TRACE_VERSION               (1)
+#define ALLOC_TRACE_BUFFER_RECORDS        (65536)
+#define ALLOC_TRACE_MAX_OWNERS            (256)
+#define ALLOC_TRACE_MAX_ALIGNMENT_SHIFT   (12)
+#define ALLOC_REPLAY_DEFAULT_SAMPLE_EVENTS (65536)
+
+enum alloc_trace_op_t
+{
+    ATO_Alloc,
+    ATO_Free,
+    ATO_Frame,
+};
+
+#pragma pack(push, 1)
+struct alloc_trace_header_t
+{
+    u32 magic;
+    u32 version;
+    u32 record_size;
+    u32 reserved;
+    u64 ticks_per_second;
+};
+
+// NOTE(Sleepster): 'kind' is an alloc_site_kind_t. 'owner' is 0 for dynarrays, otherwise a small id per zone or
+//                  arena, handed out as they show up. A free only has its op, id and ticks filled in, the rest is in
+//                  the alloc with the same id.
+struct alloc_trace_record_t
+{
+    u8  op;
+    u8  kind;
+    u8  tag;
+    u8  alignment_shift;
+    u32 owner;
+    u64 id;
+    u64 size;
+    u64 ticks;
+};
+#pragma pack(pop)
+
+StaticAssert(sizeof(alloc_trace_record_t) == 32, "Allocation trace records must stay 32 bytes, the file format depends on it...\n");
+
+struct alloc_trace_t
+{
+    alloc_trace_header_t  header;
+    alloc_trace_record_t *records;
+    u64                   record_count;
+
+    u64                   alloc_count;
+    u64                   free_count;
+    u64                   frame_count;
+    u64                   max_id;
+    u64                   peak_live_bytes;
+};
+
+bool8       c_alloc_trace_start(string_t filepath);
+void        c_alloc_trace_stop(void);
+bool8       c_alloc_trace_is_running(void);
+void        c_alloc_trace_frame_end(void);
+
+// NOTE(Sleepster): Reads the whole file, the counts are worked out on the way in.
+bool8       c_alloc_trace_load(string_t filepath, alloc_trace_t *trace);
+void        c_alloc_trace_free(alloc_trace_t *trace);
+
+/*===========================================
+  ================= REPLAY ==================
+  ===========================================*/
+
+typedef void* alloc_replay_create_t(u64 capacity);
+typedef void* alloc_replay_alloc_t(void *backend, u64 size, u32 alignment, u32 tag);
+typedef void  alloc_replay_free_t(void *backend, void *data, u64 size);
+typedef u64   alloc_replay_footprint_t(void *backend);
+typedef void  alloc_replay_destroy_t(void *backend);
+
+// NOTE(Sleepster): 'capacity' is a hint for backends that reserve up front, at least the trace's peak live bytes.
+//                  The alloc hands back null when it's out of room, the replay counts those and carries on.
+struct alloc_replay_backend_t
+{
+    const char               *name;
+    alloc_replay_create_t    *create;
+    alloc_replay_alloc_t     *alloc;
+    alloc_replay_free_t      *free;
+    alloc_replay_footprint_t *get_footprint;
+    alloc_replay_destroy_t   *destroy;
+};
+
+struct alloc_replay_config_t
+{
+    u32 kind_mask;        // NOTE(Sleepster): Bits of alloc_site_kind_t, 0 is every kind.
+    u64 sample_events;    // NOTE(Sleepster): Also samples every this many records, for traces without frames. 0 is the default.
+    u64 capacity;         // NOTE(Sleepster): 0 is four times the trace's peak live bytes.
+};
+
+struct alloc_replay_sample_t
+{
+    u64     record_index;
+    u64     frame_index;
+    u64     live_bytes;
+    u64     footprint_bytes;
+    float32 fragmentation;
+};
+
+struct alloc_replay_result_t
+{
+    const char            *backend_name;
+    u64                    alloc_count;
+    u64                    free_count;
+    u64                    failed_count;
+
+    float64                seconds;
+    float64                ops_per_second;
+
+    u64                    peak_live_bytes;
+    u64                    peak_footprint_bytes;
+    float32                peak_fragmentation;
+    float32                average_fragmentation;
+    float32                final_fragmentation;
+
+    alloc_replay_sample_t *samples;
+    u64                    sample_count;
+};
+
+// NOTE(Sleepster): The zone is c_za_create() with the config's capacity, its footprint is up to the end of the
+//                  furthest allocated block. malloc's is the heap the C runtime holds, sys_get_heap_bytes().
+alloc_replay_backend_t* c_alloc_replay_get_zone_backend(void);
+alloc_replay_backend_t* c_alloc_replay_get_malloc_backend(void);
+
+bool8       c_alloc_replay_run(alloc_trace_t *trace, alloc_replay_backend_t *backend, alloc_replay_config_t *config, alloc_replay_result_t *result);
+void        c_alloc_replay_free_result(alloc_replay_result_t *result);
+void        c_alloc_replay_log(alloc_replay_result_t *result);
+
+// NOTE(Sleepster): One row per sample per result, 'backend,record,frame,live_bytes,footprint_bytes,fragmentation'.
+bool8       c_alloc_replay_dump_csv(alloc_replay_result_t *results, u32 result_count, string_t filepath);
+
+#endif // C_ALLOC_TRACE_H
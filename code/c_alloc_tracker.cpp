@@ -0,0 +1,660 @@
+/* ========================================================================
+   $File: c_alloc_tracker.cpp $
+   $Date: October 19 2026 03:05 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_log.h>
+#include <c_futex.h>
+#include <c_string.h>
+#include <c_file_api.h>
+
+#include <c_alloc_tracker.h>
+#include <p_platform_data.h>
+
+#define ALLOC_TRACKER_SITE_TABLE_SIZE   (ALLOC_TRACKER_MAX_SITES * 2)
+#define ALLOC_TRACKER_MIN_LIVE_CAPACITY (4096)
+#define ALLOC_TRACKER_TOMBSTONE         (~0ULL)
+
+// NOTE(Sleepster): Zone and dynarray allocations that are still out there, by address.
+struct alloc_tracker_live_t
+{
+    u64   address;
+    u64   size;
+    void *owner;
+    u32   site_index;
+};
+
+// NOTE(Sleepster): An arena frees back to a position, so its pushes are a stack in the order they happened.
+struct alloc_tracker_arena_push_t
+{
+    u64 position;
+    u64 size;
+    u32 site_index;
+};
+
+struct alloc_tracker_arena_t
+{
+    void                       *arena;
+    alloc_tracker_arena_push_t *pushes;
+    u64                         push_count;
+    u64                         push_capacity;
+};
+
+struct alloc_tracker_t
+{
+    futex_mutex_t          lock;
+    volatile u32           is_running;
+    alloc_tracker_hook_t  *next_hook;
+    bool8                  is_hooked;
+    u64                    frame_count;
+    u64                    dropped_events;
+    bool8                  reported_full;
+
+    alloc_site_t           sites[ALLOC_TRACKER_MAX_SITES];
+    u32                    site_table[ALLOC_TRACKER_SITE_TABLE_SIZE];
+    u32                    site_count;
+
+    alloc_tracker_live_t  *live;
+    u64                    live_capacity;
+    u64                    live_used;
+    u64                    live_count;
+
+    alloc_tracker_arena_t  arenas[ALLOC_TRACKER_MAX_ARENAS];
+    u32                    arena_count;
+    u32                    last_arena_index;
+};
+
+global_variable alloc_tracker_t alloc_tracker;
+
+global_variable const char *alloc_tracker_kind_names[ASK_Count] = {
+    "arena",
+    "zone",
+    "dynarray",
+};
+
+/*===========================================
+  ================= SITES ===================
+  ===========================================*/
+
+internal_api u32
+c_alloc_tracker_hash_site(const char *file, u32 line)
+{
+    u32 result = 2166136261u;
+    for(const char *c = file; *c; ++c)
+    {
+        result = (result ^ (u8)*c) * 16777619u;
+    }
+    result = (result ^ line) * 16777619u;
+
+    return(result);
+}
+
+// NOTE(Sleepster): The same header in two translation units is two __FILE__ pointers, so the path is compared.
+internal_api alloc_site_t*
+c_alloc_tracker_get_or_add_site(const char *file, u32 line, u32 kind)
+{
+    alloc_site_t *result = null;
+
+    u32 slot = c_alloc_tracker_hash_site(file, line) & (ALLOC_TRACKER_SITE_TABLE_SIZE - 1);
+    for(;;)
+    {
+        u32 site_index = alloc_tracker.site_table[slot];
+        if(site_index == 0)
+        {
+            if(alloc_tracker.site_count < ALLOC_TRACKER_MAX_SITES)
+            {
+                result = alloc_tracker.sites + alloc_tracker.site_count++;
+                ZeroStruct(*result);
+                result->file        = file;
+                result->line        = line;
+                result->kind        = kind;
+                result->first_frame = alloc_tracker.frame_count;
+                alloc_tracker.site_table[slot] = alloc_tracker.site_count;
+            }
+            break;
+        }
+
+        alloc_site_t *site = alloc_tracker.sites + (site_index - 1);
+        if(site->line == line && site->kind == kind && (site->file == file || strcmp(site->file, file) == 0))
+        {
+            result = site;
+            break;
+        }
+        slot = (slot + 1) & (ALLOC_TRACKER_SITE_TABLE_SIZE - 1);
+    }
+
+    if(!result) ++alloc_tracker.dropped_events;
+    return(result);
+}
+
+internal_api void
+c_alloc_tracker_site_alloc(alloc_site_t *site, u64 size)
+{
+    site->live_bytes  += size;
+    site->live_count  += 1;
+    site->total_bytes += size;
+    site->total_count += 1;
+    site->frame_bytes += size;
+    if(site->live_bytes > site->peak_live_bytes) site->peak_live_bytes = site->live_bytes;
+}
+
+internal_api void
+c_alloc_tracker_site_free(u32 site_index, u64 size)
+{
+    alloc_site_t *site = alloc_tracker.sites + site_index;
+    site->live_bytes -= Min(size, site->live_bytes);
+    site->live_count -= site->live_count ? 1 : 0;
+    site->free_count += 1;
+}
+
+/*===========================================
+  ============= LIVE ALLOCATIONS ============
+  ===========================================*/
+
+internal_api u64
+c_alloc_tracker_hash_address(u64 address)
+{
+    u64 result = (address >> 4) * 0x9E3779B97F4A7C15ULL;
+    return(result ^ (result >> 29));
+}
+
+internal_api void
+c_alloc_tracker_live_grow(void)
+{
+    u64 new_capacity = ALLOC_TRACKER_MIN_LIVE_CAPACITY;
+    while(new_capacity < alloc_tracker.live_count * 4) new_capacity *= 2;
+
+    alloc_tracker_live_t *new_live = (alloc_tracker_live_t*)sys_allocate_memory(sizeof(alloc_tracker_live_t) * new_capacity);
+    Assert(new_live);
+
+    // NOTE(Sleepster): The tombstones stay behind.
+    for(u64 entry_index = 0; entry_index < alloc_tracker.live_capacity; ++entry_index)
+    {
+        alloc_tracker_live_t *entry = alloc_tracker.live + entry_index;
+        if(entry->address == 0 || entry->address == ALLOC_TRACKER_TOMBSTONE) continue;
+
+        u64 slot = c_alloc_tracker_hash_address(entry->address) & (new_capacity - 1);
+        while(new_live[slot].address) slot = (slot + 1) & (new_capacity - 1);
+        new_live[slot] = *entry;
+    }
+
+    if(alloc_tracker.live) sys_free_memory(alloc_tracker.live, sizeof(alloc_tracker_live_t) * alloc_tracker.live_capacity);
+    alloc_tracker.live          = new_live;
+    alloc_tracker.live_capacity = new_capacity;
+    alloc_tracker.live_used     = alloc_tracker.live_count;
+}
+
+internal_api void
+c_alloc_tracker_live_add(u64 address, u64 size, void *owner, u32 site_index)
+{
+    if((alloc_tracker.live_used + 1) * 4 > alloc_tracker.live_capacity * 3) c_alloc_tracker_live_grow();
+
+    u64 mask = alloc_tracker.live_capacity - 1;
+    u64 slot = c_alloc_tracker_hash_address(address) & mask;
+    while(alloc_tracker.live[slot].address && alloc_tracker.live[slot].address != ALLOC_TRACKER_TOMBSTONE)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    alloc_tracker_live_t *entry = alloc_tracker.live + slot;
+    if(entry->address == 0) ++alloc_tracker.live_used;
+    entry->address    = address;
+    entry->size       = size;
+    entry->owner      = owner;
+    entry->site_index = site_index;
+    ++alloc_tracker.live_count;
+}
+
+// NOTE(Sleepster): Anything allocated before tracking started isn't in here, those frees are just ignored.
+internal_api alloc_tracker_live_t*
+c_alloc_tracker_live_find(u64 address)
+{
+    alloc_tracker_live_t *result = null;
+    if(alloc_tracker.live_capacity)
+    {
+        u64 mask = alloc_tracker.live_capacity - 1;
+        u64 slot = c_alloc_tracker_hash_address(address) & mask;
+        while(alloc_tracker.live[slot].address)
+        {
+            if(alloc_tracker.live[slot].address == address)
+            {
+                result = alloc_tracker.live + slot;
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    return(result);
+}
+
+internal_api void
+c_alloc_tracker_live_remove(alloc_tracker_live_t *entry)
+{
+    entry->address = ALLOC_TRACKER_TOMBSTONE;
+    --alloc_tracker.live_count;
+}
+
+/*===========================================
+  ================= ARENAS ==================
+  ===========================================*/
+
+internal_api alloc_tracker_arena_t*
+c_alloc_tracker_find_arena(void *arena, bool8 should_add)
+{
+    alloc_tracker_arena_t *result = null;
+    if(alloc_tracker.last_arena_index < alloc_tracker.arena_count &&
+       alloc_tracker.arenas[alloc_tracker.last_arena_index].arena == arena)
+    {
+        result = alloc_tracker.arenas + alloc_tracker.last_arena_index;
+    }
+    else
+    {
+        for(u32 arena_index = 0; arena_index < alloc_tracker.arena_count; ++arena_index)
+        {
+            if(alloc_tracker.arenas[arena_index].arena == arena)
+            {
+                result = alloc_tracker.arenas + arena_index;
+                alloc_tracker.last_arena_index = arena_index;
+                break;
+            }
+        }
+
+        if(!result && should_add && alloc_tracker.arena_count < ALLOC_TRACKER_MAX_ARENAS)
+        {
+            alloc_tracker.last_arena_index = alloc_tracker.arena_count;
+            result = alloc_tracker.arenas + alloc_tracker.arena_count++;
+            ZeroStruct(*result);
+            result->arena = arena;
+        }
+    }
+
+    return(result);
+}
+
+internal_api void
+c_alloc_tracker_arena_push(void *arena, u64 position, u64 size, u32 site_index)
+{
+    alloc_tracker_arena_t *tracked = c_alloc_tracker_find_arena(arena, true);
+    if(!tracked)
+    {
+        ++alloc_tracker.dropped_events;
+        return;
+    }
+
+    if(tracked->push_count == tracked->push_capacity)
+    {
+        tracked->push_capacity = Max(tracked->push_capacity * 2, (u64)256);
+        tracked->pushes        = (alloc_tracker_arena_push_t*)realloc(tracked->pushes, sizeof(alloc_tracker_arena_push_t) * tracked->push_capacity);
+        Assert(tracked->pushes);
+    }
+
+    alloc_tracker_arena_push_t *push = tracked->pushes + tracked->push_count++;
+    push->position   = position;
+    push->size       = size;
+    push->site_index = site_index;
+}
+
+internal_api void
+c_alloc_tracker_arena_rewind(void *arena, u64 position)
+{
+    alloc_tracker_arena_t *tracked = c_alloc_tracker_find_arena(arena, false);
+    if(!tracked) return;
+
+    while(tracked->push_count && tracked->pushes[tracked->push_count - 1].position >= position)
+    {
+        alloc_tracker_arena_push_t *push = tracked->pushes + --tracked->push_count;
+        c_alloc_tracker_site_free(push->site_index, push->size);
+    }
+}
+
+/*===========================================
+  ================== HOOK ===================
+  ===========================================*/
+
+internal_api void
+c_alloc_tracker_hook(u32 event, void *owner, u64 address, u64 size, const char *file, u32 line)
+{
+    alloc_tracker_hook_t *next_hook = alloc_tracker.next_hook;
+    if(next_hook) next_hook(event, owner, address, size, file, line);
+
+    c_futex_mutex_lock(&alloc_tracker.lock);
+    if(!alloc_tracker.is_running)
+    {
+        c_futex_mutex_unlock(&alloc_tracker.lock);
+        return;
+    }
+
+    switch(event)
+    {
+        case AE_ArenaPush:
+        case AE_ZoneAlloc:
+        case AE_DynarrayCreate:
+        {
+            u32 kind = event == AE_ArenaPush ? ASK_Arena : event == AE_ZoneAlloc ? ASK_Zone : ASK_Dynarray;
+            alloc_site_t *site = c_alloc_tracker_get_or_add_site(file, line, kind);
+            if(!site) break;
+
+            u32 site_index = (u32)(site - alloc_tracker.sites);
+            c_alloc_tracker_site_alloc(site, size);
+            if(event == AE_ArenaPush) c_alloc_tracker_arena_push(owner, address, size, site_index);
+            else                      c_alloc_tracker_live_add(address, size, event == AE_ZoneAlloc ? owner : null, site_index);
+        }break;
+        case AE_ArenaRewind:
+        {
+            c_alloc_tracker_arena_rewind(owner, address);
+        }break;
+        case AE_ZoneFree:
+        case AE_DynarrayDestroy:
+        {
+            alloc_tracker_live_t *entry = c_alloc_tracker_live_find(address);
+            if(entry)
+            {
+                c_alloc_tracker_site_free(entry->site_index, entry->size);
+                c_alloc_tracker_live_remove(entry);
+            }
+        }break;
+        case AE_ZoneDestroy:
+        {
+            for(u64 entry_index = 0; entry_index < alloc_tracker.live_capacity; ++entry_index)
+            {
+                alloc_tracker_live_t *entry = alloc_tracker.live + entry_index;
+                if(entry->address && entry->address != ALLOC_TRACKER_TOMBSTONE && entry->owner == owner)
+                {
+                    c_alloc_tracker_site_free(entry->site_index, entry->size);
+                    c_alloc_tracker_live_remove(entry);
+                }
+            }
+        }break;
+        case AE_DynarrayResize:
+        {
+            // NOTE(Sleepster): Still the same array, it stays with the site that made it and isn't a free.
+            alloc_tracker_live_t *entry = c_alloc_tracker_live_find((u64)(usize)owner);
+            if(entry)
+            {
+                u32           site_index = entry->site_index;
+                alloc_site_t *site       = alloc_tracker.sites + site_index;
+                u64           old_size   = entry->size;
+                c_alloc_tracker_live_remove(entry);
+                c_alloc_tracker_live_add(address, size, null, site_index);
+
+                site->live_bytes = site->live_bytes - Min(old_size, site->live_bytes) + size;
+                if(size > old_size)
+                {
+                    site->total_bytes += size - old_size;
+                    site->frame_bytes += size - old_size;
+                }
+                if(site->live_bytes > site->peak_live_bytes) site->peak_live_bytes = site->live_bytes;
+            }
+        }break;
+    }
+
+    bool8 report_full = alloc_tracker.dropped_events && !alloc_tracker.reported_full;
+    alloc_tracker.reported_full |= report_full;
+    c_futex_mutex_unlock(&alloc_tracker.lock);
+
+    if(report_full)
+    {
+        log_warning("Allocation tracker is out of sites ('%u') or arenas ('%u'), some allocations aren't tracked...\n",
+                    ALLOC_TRACKER_MAX_SITES, ALLOC_TRACKER_MAX_ARENAS);
+    }
+}
+
+/*===========================================
+  ================== API ====================
+  ===========================================*/
+
+// NOTE(Sleepster): Starts over every time, whatever was tracked before is thrown away.
+bool8
+c_alloc_tracker_start(void)
+{
+    c_futex_mutex_lock(&alloc_tracker.lock);
+    if(!alloc_tracker.is_running)
+    {
+        for(u32 arena_index = 0; arena_index < alloc_tracker.arena_count; ++arena_index)
+        {
+            free(alloc_tracker.arenas[arena_index].pushes);
+        }
+        if(alloc_tracker.live) sys_free_memory(alloc_tracker.live, sizeof(alloc_tracker_live_t) * alloc_tracker.live_capacity);
+
+        futex_mutex_t         lock      = alloc_tracker.lock;
+        alloc_tracker_hook_t *next_hook = alloc_tracker.next_hook;
+        bool8                 is_hooked = alloc_tracker.is_hooked;
+        ZeroStruct(alloc_tracker);
+        alloc_tracker.lock      = lock;
+        alloc_tracker.next_hook = next_hook;
+        alloc_tracker.is_hooked = is_hooked;
+        c_alloc_tracker_live_grow();
+
+        // NOTE(Sleepster): Whoever had the hook (an allocation trace) still gets every event. Stopped out of order
+        //                  we never left the chain, so there's nothing to put back in.
+        AtomicStore32(&alloc_tracker.is_running, 1);
+        if(!alloc_tracker.is_hooked)
+        {
+            alloc_tracker.next_hook = alloc_tracker_hook;
+            alloc_tracker.is_hooked = true;
+            alloc_tracker_hook      = c_alloc_tracker_hook;
+        }
+    }
+    c_futex_mutex_unlock(&alloc_tracker.lock);
+
+    log_info("Allocation tracking is on...\n");
+    return(true);
+}
+
+// NOTE(Sleepster): Keeps the numbers, only stops collecting new ones. If something hooked in after us we stay in the
+//                  chain and just pass the events along.
+void
+c_alloc_tracker_stop(void)
+{
+    c_futex_mutex_lock(&alloc_tracker.lock);
+    if(alloc_tracker_hook == c_alloc_tracker_hook)
+    {
+        alloc_tracker_hook      = alloc_tracker.next_hook;
+        alloc_tracker.is_hooked = false;
+    }
+    AtomicStore32(&alloc_tracker.is_running, 0);
+    c_futex_mutex_unlock(&alloc_tracker.lock);
+}
+
+bool8
+c_alloc_tracker_is_running(void)
+{
+    bool8 result = AtomicLoad32(&alloc_tracker.is_running) != 0;
+    return(result);
+}
+
+void
+c_alloc_tracker_frame_end(void)
+{
+    if(!c_alloc_tracker_is_running()) return;
+
+    c_futex_mutex_lock(&alloc_tracker.lock);
+    for(u32 site_index = 0; site_index < alloc_tracker.site_count; ++site_index)
+    {
+        alloc_site_t *site = alloc_tracker.sites + site_index;
+        site->last_frame_bytes = site->frame_bytes;
+        site->frame_bytes      = 0;
+        if(site->last_frame_bytes > site->peak_frame_bytes) site->peak_frame_bytes = site->last_frame_bytes;
+    }
+    ++alloc_tracker.frame_count;
+    c_futex_mutex_unlock(&alloc_tracker.lock);
+}
+
+bool8
+c_alloc_tracker_get_site(const char *file, u32 line, alloc_site_t *site_out)
+{
+    bool8 result = false;
+
+    c_futex_mutex_lock(&alloc_tracker.lock);
+    for(u32 site_index = 0; site_index < alloc_tracker.site_count; ++site_index)
+    {
+        alloc_site_t *site = alloc_tracker.sites + site_index;
+        if(site->line == line && strcmp(site->file, file) == 0)
+        {
+            *site_out = *site;
+            result    = true;
+            break;
+        }
+    }
+    c_futex_mutex_unlock(&alloc_tracker.lock);
+
+    return(result);
+}
+
+u32
+c_alloc_tracker_get_sites(alloc_site_t *sites_out, u32 max_site_count)
+{
+    c_futex_mutex_lock(&alloc_tracker.lock);
+    u32 result = Min(alloc_tracker.site_count, max_site_count);
+    memcpy(sites_out, alloc_tracker.sites, sizeof(alloc_site_t) * result);
+    c_futex_mutex_unlock(&alloc_tracker.lock);
+
+    return(result);
+}
+
+// NOTE(Sleepster): Over the frames since the site first showed up, a site that only ran at startup fades out.
+float64
+c_alloc_tracker_get_bytes_per_frame(alloc_site_t *site)
+{
+    u64     frame_count = alloc_tracker.frame_count > site->first_frame ? alloc_tracker.frame_count - site->first_frame : 1;
+    float64 result      = (float64)site->total_bytes / (float64)frame_count;
+    return(result);
+}
+
+const char*
+c_alloc_tracker_get_kind_name(u32 kind)
+{
+    const char *result = kind < ASK_Count ? alloc_tracker_kind_names[kind] : "unknown";
+    return(result);
+}
+
+/*===========================================
+  ================ REPORTS ==================
+  ===========================================*/
+
+internal_api int
+c_alloc_tracker_compare_rate(const void *a, const void *b)
+{
+    float64 left  = c_alloc_tracker_get_bytes_per_frame((alloc_site_t*)a);
+    float64 right = c_alloc_tracker_get_bytes_per_frame((alloc_site_t*)b);
+    return((left < right) - (left > right));
+}
+
+internal_api int
+c_alloc_tracker_compare_live(const void *a, const void *b)
+{
+    u64 left  = ((alloc_site_t*)a)->live_bytes;
+    u64 right = ((alloc_site_t*)b)->live_bytes;
+    return((left < right) - (left > right));
+}
+
+internal_api const char*
+c_alloc_tracker_short_path(const char *file)
+{
+    const char *result = file;
+    while(result[0] == '.' && result[1] == '/') result += 2;
+    return(result);
+}
+
+internal_api inline float64
+c_alloc_tracker_kb(u64 bytes)
+{
+    float64 result = (float64)bytes / 1024.0;
+    return(result);
+}
+
+void
+c_alloc_tracker_log(u32 max_site_count)
+{
+    alloc_site_t *sites = (alloc_site_t*)malloc(sizeof(alloc_site_t) * ALLOC_TRACKER_MAX_SITES);
+    if(!sites) return;
+
+    u32 site_count = c_alloc_tracker_get_sites(sites, ALLOC_TRACKER_MAX_SITES);
+    log_info("Allocation tracker, '%u' sites after '%llu' frames, '%llu' events dropped...\n",
+             site_count, (unsigned long long)alloc_tracker.frame_count, (unsigned long long)alloc_tracker.dropped_events);
+
+    qsort(sites, site_count, sizeof(alloc_site_t), c_alloc_tracker_compare_rate);
+    log_info("    Most allocated per frame:\n");
+    for(u32 site_index = 0; site_index < Min(site_count, max_site_count); ++site_index)
+    {
+        alloc_site_t *site = sites + site_index;
+        log_info("        %s:%u (%s): %.2f KB/frame, last frame %.2f KB, peak frame %.2f KB, live %.2f KB in '%llu', peak live %.2f KB, '%llu' allocs, '%llu' frees\n",
+                 c_alloc_tracker_short_path(site->file), site->line, c_alloc_tracker_get_kind_name(site->kind),
+                 c_alloc_tracker_get_bytes_per_frame(site) / 1024.0, c_alloc_tracker_kb(site->last_frame_bytes),
+                 c_alloc_tracker_kb(site->peak_frame_bytes), c_alloc_tracker_kb(site->live_bytes),
+                 (unsigned long long)site->live_count, c_alloc_tracker_kb(site->peak_live_bytes),
+                 (unsigned long long)site->total_count, (unsigned long long)site->free_count);
+    }
+
+    qsort(sites, site_count, sizeof(alloc_site_t), c_alloc_tracker_compare_live);
+    log_info("    Holding memory and never freed any of it:\n");
+    u32 logged_count = 0;
+    for(u32 site_index = 0; site_index < site_count && logged_count < max_site_count; ++site_index)
+    {
+        alloc_site_t *site = sites + site_index;
+        if(site->free_count || !site->live_count) continue;
+
+        log_info("        %s:%u (%s): live %.2f KB in '%llu' allocations, growing %.2f KB/frame since frame '%llu'\n",
+                 c_alloc_tracker_short_path(site->file), site->line, c_alloc_tracker_get_kind_name(site->kind),
+                 c_alloc_tracker_kb(site->live_bytes), (unsigned long long)site->live_count,
+                 c_alloc_tracker_get_bytes_per_frame(site) / 1024.0, (unsigned long long)site->first_frame);
+        ++logged_count;
+    }
+
+    free(sites);
+}
+
+bool8
+c_alloc_tracker_dump_csv(string_t filepath)
+{
+    bool8 result = false;
+
+    alloc_site_t *sites = (alloc_site_t*)malloc(sizeof(alloc_site_t) * ALLOC_TRACKER_MAX_SITES);
+    u32 site_count      = sites ? c_alloc_tracker_get_sites(sites, ALLOC_TRACKER_MAX_SITES) : 0;
+    u64 buffer_size     = KB(1) * ((u64)site_count + 1);
+    char *buffer        = sites ? (char*)malloc(buffer_size) : null;
+    if(!buffer)
+    {
+        free(sites);
+        return(result);
+    }
+
+    u64 used = snprintf(buffer, buffer_size, "file,line,kind,live_bytes,live_count,peak_live_bytes,total_bytes,total_count,free_count,"
+                                             "bytes_per_frame,last_frame_bytes,peak_frame_bytes,first_frame\n");
+    for(u32 site_index = 0; site_index < site_count; ++site_index)
+    {
+        alloc_site_t *site = sites + site_index;
+        used += snprintf(buffer + used, buffer_size - used, "%s,%u,%s,%llu,%llu,%llu,%llu,%llu,%llu,%.1f,%llu,%llu,%llu\n",
+                         c_alloc_tracker_short_path(site->file), site->line, c_alloc_tracker_get_kind_name(site->kind),
+                         (unsigned long long)site->live_bytes, (unsigned long long)site->live_count,
+                         (unsigned long long)site->peak_live_bytes, (unsigned long long)site->total_bytes,
+                         (unsigned long long)site->total_count, (unsigned long long)site->free_count,
+                         c_alloc_tracker_get_bytes_per_frame(site), (unsigned long long)site->last_frame_bytes,
+                         (unsigned long long)site->peak_frame_bytes, (unsigned long long)site->first_frame);
+    }
+
+    file_t file = sys_file_open(filepath, true, false, false);
+    if(file.handle != INVALID_FILE_HANDLE)
+    {
+        result = c_file_write(&file, buffer, used);
+        c_file_close(&file);
+    }
+    else
+    {
+        log_error("Failed to open '%s' for the allocation sites...\n", C_STR(filepath));
+    }
+
+    free(buffer);
+    free(sites);
+    return(result);
+}
@@ -0,0 +1,111 @@
+#if !defined(C_ALLOC_TRACKER_H)
+/* ========================================================================
+   $File: c_alloc_tracker.h $
+   $Date: October 19 2026 03:05 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define C_ALLOC_TRACKER_H
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+
+// NOTE(Sleepster): The allocators include this, c_string.h includes the allocators.
+typedef struct string string_t;
+
+/* NOTE(Sleepster): Opt-in allocation tracking by call site, for finding whatever keeps growing.
+ *
+ * c_arena_push_size(), c_za_alloc() and the dynarray create are macros that pass __FILE__ and __LINE__ along, the
+ * allocators hand those to alloc_tracker_hook. The hook is null until c_alloc_tracker_start(), so while nobody is
+ * tracking an allocation pays for a load and a branch.
+ *
+ * A site is a file and a line. For each one we keep the live bytes and count, the peak of the live bytes, everything
+ * it ever allocated and how many of those got freed, and the bytes it allocated in each frame
+ * (c_alloc_tracker_frame_end()). What counts as freed:
+ *   zones     - c_za_free(), or the zone getting destroyed.
+ *   dynarrays - c_dynarray_destroy(). A grow stays with the site that created the array, only its size changes.
+ *   arenas    - never one allocation at a time, the arena rewinds. A reset, the end of a temporary memory block or
+ *               freeing the last block frees everything pushed past the point the arena went back to.
+ *
+ * c_alloc_tracker_log() prints the sites that allocate the most per frame, then the sites that still hold memory and
+ * have never freed any of it. The second list is where the leaks and the unbounded growth are.
+ *
+ * Every event takes the tracker's lock. It's for finding problems, don't ship with it on.
+ *
+ * The hook is a chain, starting the tracker keeps whatever was hooked before it (c_alloc_trace.h) and calls it first.
+ */
+
+#define ALLOC_TRACKER_MAX_SITES     (4096)
+#define ALLOC_TRACKER_MAX_ARENAS    (256)
+
+StaticAssert((ALLOC_TRACKER_MAX_SITES & (ALLOC_TRACKER_MAX_SITES - 1)) == 0, "Allocation tracker site count must be a power of two...\n");
+
+enum alloc_event_t
+{
+    AE_ArenaPush,          // NOTE(Sleepster): 'address' is the arena's position (every block counted) before the push
+    AE_ArenaRewind,        // NOTE(Sleepster): 'address' is the position the arena went back to
+    AE_ZoneAlloc,
+    AE_ZoneFree,
+    AE_ZoneDestroy,
+    AE_DynarrayCreate,     // NOTE(Sleepster): 'address' is the header
+    AE_DynarrayResize,     // NOTE(Sleepster): 'owner' is the old header, 'address' the new one
+    AE_DynarrayDestroy,
+};
+
+typedef void alloc_tracker_hook_t(u32 event, void *owner, u64 address, u64 size, const char *file, u32 line);
+
+// NOTE(Sleepster): Defined in c_dynarray_impl.cpp, every build that has one of the allocators has that one too.
+extern alloc_tracker_hook_t *volatile alloc_tracker_hook;
+
+#define ALLOC_TRACK(event, owner, address, size, file, line)                                                  \
+    do {                                                                                                     \
+        alloc_tracker_hook_t *tracker_hook = alloc_tracker_hook;                                             \
+        if(tracker_hook) tracker_hook(event, (void*)(owner), (u64)(address), (u64)(size), file, line);      \
+    } while(0)
+
+enum alloc_site_kind_t
+{
+    ASK_Arena,
+    ASK_Zone,
+    ASK_Dynarray,
+    ASK_Count,
+};
+
+struct alloc_site_t
+{
+    const char *file;
+    u32         line;
+    u32         kind;
+
+    u64         live_bytes;
+    u64         live_count;
+    u64         peak_live_bytes;
+
+    u64         total_bytes;
+    u64         total_count;
+    u64         free_count;
+
+    u64         frame_bytes;        // NOTE(Sleepster): This frame so far.
+    u64         last_frame_bytes;
+    u64         peak_frame_bytes;
+    u64         first_frame;
+};
+
+bool8       c_alloc_tracker_start(void);
+void        c_alloc_tracker_stop(void);
+bool8       c_alloc_tracker_is_running(void);
+
+// NOTE(Sleepster): Once a frame, from one thread.
+void        c_alloc_tracker_frame_end(void);
+
+// NOTE(Sleepster): Copies, the sites keep changing under the lock.
+bool8       c_alloc_tracker_get_site(const char *file, u32 line, alloc_site_t *site_out);
+u32         c_alloc_tracker_get_sites(alloc_site_t *sites_out, u32 max_site_count);
+float64     c_alloc_tracker_get_bytes_per_frame(alloc_site_t *site);
+const char* c_alloc_tracker_get_kind_name(u32 kind);
+
+void        c_alloc_tracker_log(u32 max_site_count);
+bool8       c_alloc_tracker_dump_csv(string_t filepath);
+
+#endif // C_ALLOC_TRACKER_H
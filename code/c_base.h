@@ -226,6 +226,15 @@ typedef void void_func(void);
 
 #define INVALID_ID ((u32)-1)
 
+// NOTE(Sleepster): Used to pad structures that are hammered by multiple threads so they don't false share.
+#define CACHE_LINE_SIZE (64)
+
+#if COMPILER_CL
+# define NO_INLINE __declspec(noinline)
+#else
+# define NO_INLINE __attribute__((noinline))
+#endif
+
 // NOTE(Sleepster): C++
 #define TypesSame(A, B) (true) 
 
@@ -12,12 +12,13 @@
 
 #include <c_base.h>
 #include <c_types.h>
+#include <c_alloc_tracker.h>
 
 #define DYNARRAY_HEADER_DEBUG_ID (0xC0FFEE)
 
 typedef struct dynarray_header 
 {
-    u32   flags;
+    u32   element_size;
     u32   size;
     u32   capacity;
     u32   header_id;
@@ -31,12 +32,23 @@ StaticAssert(sizeof(dynarray_header_t) % 16 == 0, "Dynamic Array header must be
 
 #define DynArray_t(type) TypeOf((type*)null)
 
-void* _dynarray_create_impl(u32 element_size);
+// NOTE(Sleepster): Every dynarray combined, for the memory telemetry. Header included.
+struct dynarray_memory_stats_t
+{
+    volatile s64 live_count;
+    volatile s64 live_bytes;
+    volatile s64 peak_bytes;
+};
+extern dynarray_memory_stats_t dynarray_memory_stats;
+
+void* _dynarray_create_impl_(u32 element_size, const char *file, u32 line);
 void  _dynarray_destroy_impl(void **array);
 void* _dynarray_grow_impl(void **array, u32 element_size, u32 new_capacity);
 void  _dynarray_insert_impl(void **array, void *element, u32 element_size, u32 index);
 void  _dynarray_remove_impl(void **array, u32 element_size, u32 index);
 
+#define _dynarray_create_impl(element_size) _dynarray_create_impl_(element_size, __FILE__, __LINE__)
+
 #define _dynarray_header(d_array_ptr) \
     ((dynarray_header_t*)(d_array_ptr ? ((byte*)(d_array_ptr) - sizeof(dynarray_header_t)) : null))
 
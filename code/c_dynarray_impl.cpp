@@ -4,14 +4,31 @@
    $Revision: $
    $Creator: Justin Lewis $
    ======================================================================== */
+#include <c_intrinsics.h>
 #include <c_base.h>
 #include <c_types.h>
 #include <c_dynarray.h>
 
 #include <stdlib.h>
 
+dynarray_memory_stats_t dynarray_memory_stats;
+alloc_tracker_hook_t *volatile alloc_tracker_hook = null;
+
+internal_api inline void
+_dynarray_track_bytes(s64 byte_delta)
+{
+    s64 live_bytes = AtomicExchangeAdd64(&dynarray_memory_stats.live_bytes, byte_delta) + byte_delta;
+    s64 peak_bytes = AtomicLoad64(&dynarray_memory_stats.peak_bytes);
+    while(live_bytes > peak_bytes)
+    {
+        s64 previous = AtomicCompareExchange64(&dynarray_memory_stats.peak_bytes, live_bytes, peak_bytes);
+        if(previous == peak_bytes) break;
+        peak_bytes = previous;
+    }
+}
+
 void*
-_dynarray_create_impl(u32 element_size)
+_dynarray_create_impl_(u32 element_size, const char *file, u32 line)
 {
     void *result = null;
 
@@ -22,8 +39,13 @@ _dynarray_create_impl(u32 element_size)
     dynarray_header_t *header = (dynarray_header_t*)result;
     result = (byte*)result + sizeof(dynarray_header_t);
 
-    header->header_id = DYNARRAY_HEADER_DEBUG_ID;
-    header->capacity  = DYNARRAY_INITIAL_SIZE;
+    header->header_id    = DYNARRAY_HEADER_DEBUG_ID;
+    header->capacity     = DYNARRAY_INITIAL_SIZE;
+    header->element_size = element_size;
+
+    AtomicIncrement64(&dynarray_memory_stats.live_count);
+    _dynarray_track_bytes((s64)(element_size * DYNARRAY_INITIAL_SIZE) + (s64)sizeof(dynarray_header_t));
+    ALLOC_TRACK(AE_DynarrayCreate, null, header, (element_size * DYNARRAY_INITIAL_SIZE) + sizeof(dynarray_header_t), file, line);
 
     return(result);
 }
@@ -39,6 +61,7 @@ _dynarray_grow_impl(void **array, u32 element_size, u32 new_capacity)
     Expect(new_capacity > DYNARRAY_INITIAL_SIZE, "new capacity is <= Initial\n");
     void *result = null;
     result = (byte*)*array - sizeof(dynarray_header_t);
+    void *old_header = result;
     
     u64 old_size = header->capacity * element_size;
     u64 new_size = new_capacity     * element_size;
@@ -49,7 +72,10 @@ _dynarray_grow_impl(void **array, u32 element_size, u32 new_capacity)
     result = (byte*)result + sizeof(dynarray_header_t);
 
     header = _dynarray_header(result); 
-    header->capacity = new_capacity;
+    header->capacity     = new_capacity;
+    header->element_size = element_size;
+    _dynarray_track_bytes((s64)new_size - (s64)old_size);
+    ALLOC_TRACK(AE_DynarrayResize, old_header, header, new_size + sizeof(dynarray_header_t), null, 0);
 
     return(result);
 }
@@ -62,7 +88,11 @@ _dynarray_destroy_impl(void **array)
     dynarray_header_t *header = _dynarray_header(*array); 
     Expect(header->header_id == DYNARRAY_HEADER_DEBUG_ID, "Header ID is invalid...\n");
 
+    AtomicDecrement64(&dynarray_memory_stats.live_count);
+    _dynarray_track_bytes(-((s64)(header->element_size * header->capacity) + (s64)sizeof(dynarray_header_t)));
+
     void *array_data = (byte *)*array - sizeof(dynarray_header_t);
+    ALLOC_TRACK(AE_DynarrayDestroy, null, array_data, 0, null, 0);
     free(array_data);
 
     *array = null;
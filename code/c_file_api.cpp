@@ -8,6 +8,7 @@
 #include <c_string.h>
 
 #include <c_globals.h>
+#include <c_profiler.h>
 #include <p_platform_data.h>
 
 // NOTE(Sleepster): Errors from these calls are handled internally 
@@ -62,6 +63,7 @@ c_file_read(file_t             *file_data,
             za_allocation_tag_t tag,
             bool8               create)
 {
+    PROFILE_FUNCTION();
     Assert(file_data->handle != INVALID_FILE_HANDLE);
 
     string_t result;
@@ -84,6 +86,7 @@ c_file_read_from_offset(file_t             *file_data,
                         zone_allocator_t   *zone, 
                         za_allocation_tag_t tag)
 {
+    PROFILE_FUNCTION();
     Assert(file_data->handle != INVALID_FILE_HANDLE);
 
     string_t result;
@@ -0,0 +1,336 @@
+/* ========================================================================
+   $File: c_flight_recorder.cpp $
+   $Date: October 19 2026 08:30 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+#include <SDL3/SDL.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_log.h>
+
+#include <c_flight_recorder.h>
+#include <c_memory_telemetry.h>
+#include <p_platform_data.h>
+
+#define FLIGHT_RECORDER_MAX_RECORD_SIZE  (512)
+#define FLIGHT_RECORDER_DEFAULT_SECONDS  (10.0f)
+#define FLIGHT_RECORDER_DEFAULT_COOLDOWN (5.0f)
+
+/*===========================================
+  =============== WRITER ====================
+  ===========================================*/
+
+internal_api void
+c_flight_recorder_output_flush(flight_recorder_t *recorder)
+{
+    if(recorder->output_used && !recorder->output_failed)
+    {
+        recorder->output_failed = !c_file_write(&recorder->output_file, recorder->output_buffer, recorder->output_used);
+    }
+    recorder->output_used = 0;
+}
+
+internal_api void
+c_flight_recorder_append(flight_recorder_t *recorder, const char *format, ...)
+{
+    if(recorder->output_used + FLIGHT_RECORDER_MAX_RECORD_SIZE > FLIGHT_RECORDER_OUTPUT_SIZE) c_flight_recorder_output_flush(recorder);
+    char *buffer = (char*)recorder->output_buffer + recorder->output_used;
+
+    va_list args;
+    va_start(args, format);
+    s32 written = vsnprintf(buffer, FLIGHT_RECORDER_MAX_RECORD_SIZE, format, args);
+    va_end(args);
+
+    if(written > 0) recorder->output_used += Min((u32)written, (u32)FLIGHT_RECORDER_MAX_RECORD_SIZE - 1);
+}
+
+// NOTE(Sleepster): Zone names are code literals, quotes and backslashes are all we expect.
+internal_api void
+c_flight_recorder_append_name(flight_recorder_t *recorder, const char *name)
+{
+    char escaped[FLIGHT_RECORDER_MAX_RECORD_SIZE / 2];
+    u32  used = 0;
+    for(u32 char_index = 0;
+        name && name[char_index] && used < sizeof(escaped) - 2;
+        ++char_index)
+    {
+        char c = name[char_index];
+        if(c == '"' || c == '\\') escaped[used++] = '\\';
+        escaped[used++] = ((u8)c < 0x20) ? ' ' : c;
+    }
+    escaped[used] = 0;
+
+    c_flight_recorder_append(recorder, "\"%s\"", escaped);
+}
+
+internal_api void
+c_flight_recorder_write_dump(flight_recorder_t *recorder)
+{
+    flight_recorder_frame_t *trigger   = recorder->dump_frames + recorder->dump_trigger_index;
+    float64                  ms_per_count = 1000.0 / (float64)recorder->counter_frequency;
+
+    c_flight_recorder_append(recorder, "{\"reason\":\"%s\",\"trigger_frame\":%llu,\"trigger_frame_ms\":%.3f,\"hitch_ms\":%.3f,\"frame_count\":%u,\"skipped_dumps\":%llu,\"frames\":[\n",
+                             recorder->dump_reason, trigger->frame_index, trigger->frame_ms, recorder->config.hitch_ms,
+                             recorder->dump_frame_count, recorder->skipped_dumps);
+    for(u32 frame_index = 0; frame_index < recorder->dump_frame_count; ++frame_index)
+    {
+        flight_recorder_frame_t *frame = recorder->dump_frames + frame_index;
+        float64 t_ms = ((float64)frame->counter - (float64)trigger->counter) * ms_per_count;
+
+        c_flight_recorder_append(recorder, "%s{\"frame\":%llu,\"t_ms\":%.3f,\"frame_ms\":%.3f,\"render_wait_ms\":%.3f,\"threadpool_queued\":%u,\"asset_loads\":%u,",
+                                 frame_index ? ",\n" : "", frame->frame_index, t_ms, frame->frame_ms, frame->render_wait_ms,
+                                 frame->threadpool_queued, frame->asset_loads_in_flight);
+        c_flight_recorder_append(recorder, "\"memory_bytes\":%llu,\"memory_delta\":%lld,\"allocations\":%llu,\"allocation_delta\":%lld,\"dropped_zones\":%llu,\"zones\":[",
+                                 frame->memory_bytes, frame->memory_delta_bytes, frame->allocation_count, frame->allocation_delta,
+                                 frame->dropped_zones);
+        for(u32 zone_index = 0; zone_index < frame->zone_count; ++zone_index)
+        {
+            flight_recorder_zone_t *zone = frame->zones + zone_index;
+            c_flight_recorder_append(recorder, "%s{\"name\":", zone_index ? "," : "");
+            c_flight_recorder_append_name(recorder, zone->name);
+            c_flight_recorder_append(recorder, ",\"thread\":%u,\"depth\":%u,\"calls\":%u,\"total_ms\":%.3f,\"self_ms\":%.3f}",
+                                     zone->thread_index, zone->depth, zone->call_count, zone->total_ms, zone->self_ms);
+        }
+        c_flight_recorder_append(recorder, "]}");
+    }
+    c_flight_recorder_append(recorder, "\n]}\n");
+}
+
+PLATFORM_THREAD_PROC(c_flight_recorder_writer_proc)
+{
+    flight_recorder_t *recorder = (flight_recorder_t*)user_data;
+    PROFILE_SET_THREAD_NAME("flight_writer");
+
+    recorder->output_used   = 0;
+    recorder->output_failed = false;
+    recorder->output_file   = sys_file_open(c_string_create(recorder->dump_path), true, false, false);
+    if(recorder->output_file.handle != INVALID_FILE_HANDLE)
+    {
+        c_flight_recorder_write_dump(recorder);
+        c_flight_recorder_output_flush(recorder);
+        c_file_close(&recorder->output_file);
+        if(recorder->output_failed) log_error("Failed writing the flight recorder dump '%s'...\n", recorder->dump_path);
+    }
+    else
+    {
+        log_error("Failed to open '%s' for the flight recorder dump...\n", recorder->dump_path);
+    }
+
+    AtomicStore32(&recorder->writer_busy, 0);
+    return(0);
+}
+
+/*===========================================
+  =============== RECORDING =================
+  ===========================================*/
+
+void
+c_flight_recorder_init(flight_recorder_t *recorder, flight_recorder_config_t *config)
+{
+    Assert(!recorder->is_initialized);
+
+    recorder->config = *config;
+    if(recorder->config.seconds <= 0.0f)          recorder->config.seconds          = FLIGHT_RECORDER_DEFAULT_SECONDS;
+    if(recorder->config.cooldown_seconds <= 0.0f) recorder->config.cooldown_seconds = FLIGHT_RECORDER_DEFAULT_COOLDOWN;
+    snprintf(recorder->base_path, sizeof(recorder->base_path), "%s", config->base_path ? config->base_path : "flight");
+
+    // NOTE(Sleepster): Enough for 'seconds' at FLIGHT_RECORDER_MAX_FPS, a faster frame rate just covers less time.
+    u32 wanted_frames = (u32)(recorder->config.seconds * (float32)FLIGHT_RECORDER_MAX_FPS);
+    recorder->frame_capacity = 64;
+    while(recorder->frame_capacity < wanted_frames) recorder->frame_capacity <<= 1;
+
+    u64 frames_size = recorder->frame_capacity * sizeof(flight_recorder_frame_t);
+    recorder->frames            = (flight_recorder_frame_t*)sys_allocate_memory(frames_size);
+    recorder->dump_frames       = (flight_recorder_frame_t*)sys_allocate_memory(frames_size);
+    recorder->output_buffer     = (byte*)sys_allocate_memory(FLIGHT_RECORDER_OUTPUT_SIZE);
+    recorder->counter_frequency = SDL_GetPerformanceFrequency();
+    recorder->frame_count       = 0;
+    recorder->dump_requested    = 0;
+    recorder->writer_busy       = 0;
+    recorder->is_initialized    = recorder->frames && recorder->dump_frames && recorder->output_buffer;
+    Assert(recorder->is_initialized);
+
+    sys_register_dump_request_flag(&recorder->dump_requested);
+    if(recorder->config.hitch_ms > 0.0f)
+    {
+        log_info("Flight recorder: '%u' frames ('%.1f' MB), dumping to '%s_<n>.json' on frames over '%.1f' ms or a dump request...\n",
+                 recorder->frame_capacity, (float64)(frames_size * 2) / (float64)MB(1), recorder->base_path, recorder->config.hitch_ms);
+    }
+    else
+    {
+        log_info("Flight recorder: '%u' frames ('%.1f' MB), dumping to '%s_<n>.json' on a dump request...\n",
+                 recorder->frame_capacity, (float64)(frames_size * 2) / (float64)MB(1), recorder->base_path);
+    }
+}
+
+void
+c_flight_recorder_destroy(flight_recorder_t *recorder)
+{
+    if(!recorder->is_initialized) return;
+
+    sys_register_dump_request_flag(null);
+    sys_thread_join(&recorder->writer_thread);
+
+    u64 frames_size = recorder->frame_capacity * sizeof(flight_recorder_frame_t);
+    sys_free_memory(recorder->frames,        frames_size);
+    sys_free_memory(recorder->dump_frames,   frames_size);
+    sys_free_memory(recorder->output_buffer, FLIGHT_RECORDER_OUTPUT_SIZE);
+    recorder->is_initialized = false;
+}
+
+#if PROFILER_ENABLED
+// NOTE(Sleepster): The top FLIGHT_RECORDER_MAX_ZONE_DEPTH levels of every thread's tree, same walk as the profiler's log.
+internal_api void
+c_flight_recorder_copy_zones(flight_recorder_frame_t *frame, profiler_frame_t *profiler_frame)
+{
+    frame->dropped_zones = profiler_frame->dropped_zones;
+    for(u32 thread_index = 0;
+        thread_index < profiler_frame->thread_count && frame->zone_count < FLIGHT_RECORDER_MAX_ZONES;
+        ++thread_index)
+    {
+        u32 root       = profiler_frame->thread_roots[thread_index];
+        u32 node_index = root;
+        while(node_index != PROFILER_INVALID_NODE && frame->zone_count < FLIGHT_RECORDER_MAX_ZONES)
+        {
+            profiler_node_t *node = profiler_frame->nodes + node_index;
+            if(node->call_count || node_index == root)
+            {
+                flight_recorder_zone_t *zone = frame->zones + frame->zone_count++;
+                zone->name         = node->name;
+                zone->depth        = (u16)node->depth;
+                zone->thread_index = (u16)thread_index;
+                zone->call_count   = node->call_count;
+                zone->total_ms     = (float32)c_profiler_node_total_ms(profiler_frame, node_index);
+                zone->self_ms      = (float32)c_profiler_node_self_ms(profiler_frame, node_index);
+            }
+
+            if(node->first_child != PROFILER_INVALID_NODE && node->depth < FLIGHT_RECORDER_MAX_ZONE_DEPTH)
+            {
+                node_index = node->first_child;
+            }
+            else
+            {
+                while(node_index != root && profiler_frame->nodes[node_index].next_sibling == PROFILER_INVALID_NODE)
+                {
+                    node_index = profiler_frame->nodes[node_index].parent;
+                }
+                node_index = node_index == root ? PROFILER_INVALID_NODE : profiler_frame->nodes[node_index].next_sibling;
+            }
+        }
+    }
+}
+#endif
+
+void
+c_flight_recorder_frame_end(flight_recorder_t *recorder, flight_recorder_frame_stats_t *stats)
+{
+    if(!recorder->is_initialized) return;
+
+    flight_recorder_frame_t *frame = recorder->frames + (recorder->frame_count & (recorder->frame_capacity - 1));
+    frame->frame_index           = recorder->frame_count;
+    frame->counter               = SDL_GetPerformanceCounter();
+    frame->frame_ms              = stats->frame_ms;
+    frame->render_wait_ms        = stats->render_wait_ms;
+    frame->threadpool_queued     = stats->threadpool_queued;
+    frame->asset_loads_in_flight = stats->asset_loads_in_flight;
+    frame->dropped_zones         = 0;
+    frame->zone_count            = 0;
+
+    memory_telemetry_sample_t memory = {};
+    c_memory_telemetry_get_total(0, &memory);
+    frame->memory_bytes           = memory.current_bytes;
+    frame->memory_delta_bytes     = (s64)memory.current_bytes    - (s64)recorder->last_memory_bytes;
+    frame->allocation_count       = memory.allocation_count;
+    frame->allocation_delta       = (s64)memory.allocation_count - (s64)recorder->last_allocation_count;
+    recorder->last_memory_bytes     = memory.current_bytes;
+    recorder->last_allocation_count = memory.allocation_count;
+
+#if PROFILER_ENABLED
+    profiler_frame_t *profiler_frame = c_profiler_get_last_frame();
+    if(profiler_frame) c_flight_recorder_copy_zones(frame, profiler_frame);
+#endif
+
+    ++recorder->frame_count;
+
+    const char *reason = null;
+    if(AtomicExchange32(&recorder->dump_requested, 0))
+    {
+        reason = "request";
+    }
+    else if(recorder->config.hitch_ms > 0.0f                   &&
+            recorder->frame_count > FLIGHT_RECORDER_WARMUP_FRAMES &&
+            stats->frame_ms > recorder->config.hitch_ms)
+    {
+        u64 cooldown_counts = (u64)(recorder->config.cooldown_seconds * (float32)recorder->counter_frequency);
+        if(recorder->last_dump_counter == 0 || frame->counter - recorder->last_dump_counter >= cooldown_counts)
+        {
+            reason = "hitch";
+        }
+    }
+
+    if(reason) c_flight_recorder_dump(recorder, reason);
+}
+
+// NOTE(Sleepster): The last 'seconds' of frames, the newest one is the one the dump is about.
+bool8
+c_flight_recorder_dump(flight_recorder_t *recorder, const char *reason)
+{
+    bool8 result = false;
+    if(!recorder->is_initialized || recorder->frame_count == 0) return(result);
+
+    if(AtomicLoad32(&recorder->writer_busy))
+    {
+        ++recorder->skipped_dumps;
+        log_warning("Flight recorder is still writing '%s', skipping the '%s' dump...\n", recorder->dump_path, reason);
+        return(result);
+    }
+    sys_thread_join(&recorder->writer_thread);
+
+    u64 newest_index   = recorder->frame_count - 1;
+    u64 newest_counter = recorder->frames[newest_index & (recorder->frame_capacity - 1)].counter;
+    u64 window_counts  = (u64)(recorder->config.seconds * (float32)recorder->counter_frequency);
+
+    u32 frame_count = 0;
+    while(frame_count < recorder->frame_count && frame_count < recorder->frame_capacity)
+    {
+        flight_recorder_frame_t *frame = recorder->frames + ((newest_index - frame_count) & (recorder->frame_capacity - 1));
+        if(newest_counter - frame->counter > window_counts) break;
+        ++frame_count;
+    }
+
+    u64 first_index = recorder->frame_count - frame_count;
+    for(u32 frame_index = 0; frame_index < frame_count; ++frame_index)
+    {
+        recorder->dump_frames[frame_index] = recorder->frames[(first_index + frame_index) & (recorder->frame_capacity - 1)];
+    }
+    recorder->dump_frame_count   = frame_count;
+    recorder->dump_trigger_index = frame_count - 1;
+    recorder->dump_reason        = reason;
+    snprintf(recorder->dump_path, sizeof(recorder->dump_path), "%s_%u.json", recorder->base_path, recorder->dump_index++);
+
+    recorder->last_dump_counter = newest_counter;
+    log_warning("Flight recorder '%s' on frame '%llu' ('%.2f' ms), writing the last '%u' frames to '%s'...\n",
+                reason, recorder->dump_frames[recorder->dump_trigger_index].frame_index,
+                recorder->dump_frames[recorder->dump_trigger_index].frame_ms, frame_count, recorder->dump_path);
+
+    AtomicStore32(&recorder->writer_busy, 1);
+    recorder->writer_thread = sys_thread_create(c_flight_recorder_writer_proc, recorder, false);
+    if(recorder->writer_thread.handle)
+    {
+        result = true;
+    }
+    else
+    {
+        AtomicStore32(&recorder->writer_busy, 0);
+    }
+
+    return(result);
+}
@@ -0,0 +1,129 @@
+#if !defined(C_FLIGHT_RECORDER_H)
+/* ========================================================================
+   $File: c_flight_recorder.h $
+   $Date: October 19 2026 08:30 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define C_FLIGHT_RECORDER_H
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_profiler.h>
+#include <c_file_api.h>
+#include <p_platform_data.h>
+
+/* NOTE(Sleepster): Always on, keeps the last few seconds of frames around so a hitch can be looked at after it
+ * happened instead of hoping it happens again with a trace running.
+ *
+ * Every frame c_flight_recorder_frame_end() writes one flight_recorder_frame_t into a ring that's allocated once at
+ * init: the frame time, the render thread's wait, how many tasks are still queued on the threadpool, how many asset
+ * loads are in flight, the combined memory telemetry numbers (and how much they moved since last frame), and the top
+ * of the profiler's call tree for the frame. That's a copy of a few hundred bytes, the profiler and the telemetry
+ * already did the work.
+ *
+ * The ring gets dumped to '<base>_<n>.json' when:
+ *   - a frame takes longer than hitch_ms (0 turns this off), at most once every cooldown_seconds
+ *   - the process gets SIGUSR1 (Ctrl+Break on Windows)
+ *   - somebody calls c_flight_recorder_dump()
+ * The dump copies the last 'seconds' worth of frames into a second buffer and a writer thread formats them, so the
+ * frame that triggered it doesn't also pay for the disk. A dump that comes in while the last one is still being
+ * written is skipped and counted.
+ *
+ * Main thread only, after PROFILE_FRAME_END() and c_memory_telemetry_frame_end().
+ */
+
+#define FLIGHT_RECORDER_MAX_ZONES        (32)
+#define FLIGHT_RECORDER_MAX_ZONE_DEPTH   (3)
+#define FLIGHT_RECORDER_MAX_FPS          (144)
+#define FLIGHT_RECORDER_WARMUP_FRAMES    (120)
+#define FLIGHT_RECORDER_MAX_PATH_LENGTH  (256)
+#define FLIGHT_RECORDER_OUTPUT_SIZE      (KB(256))
+
+struct flight_recorder_zone_t
+{
+    const char *name;
+    u16         depth;
+    u16         thread_index;
+    u32         call_count;
+    float32     total_ms;
+    float32     self_ms;
+};
+
+struct flight_recorder_frame_t
+{
+    u64                    frame_index;
+    u64                    counter;
+    float32                frame_ms;
+    float32                render_wait_ms;
+    u32                    threadpool_queued;
+    u32                    asset_loads_in_flight;
+
+    u64                    memory_bytes;
+    s64                    memory_delta_bytes;
+    u64                    allocation_count;
+    s64                    allocation_delta;
+
+    u64                    dropped_zones;
+    u32                    zone_count;
+    flight_recorder_zone_t zones[FLIGHT_RECORDER_MAX_ZONES];
+};
+
+// NOTE(Sleepster): What the caller knows about the frame, the rest the recorder fills in itself.
+struct flight_recorder_frame_stats_t
+{
+    float32 frame_ms;
+    float32 render_wait_ms;
+    u32     threadpool_queued;
+    u32     asset_loads_in_flight;
+};
+
+struct flight_recorder_config_t
+{
+    float32     seconds;
+    float32     hitch_ms;
+    float32     cooldown_seconds;
+    const char *base_path;
+};
+
+struct flight_recorder_t
+{
+    bool8                    is_initialized;
+    flight_recorder_config_t config;
+    char                     base_path[FLIGHT_RECORDER_MAX_PATH_LENGTH];
+    u64                      counter_frequency;
+
+    flight_recorder_frame_t *frames;
+    u32                      frame_capacity;
+    u64                      frame_count;
+    u64                      last_memory_bytes;
+    u64                      last_allocation_count;
+    u64                      last_dump_counter;
+
+    // NOTE(Sleepster): Set from the signal handler.
+    volatile u32             dump_requested;
+
+    // NOTE(Sleepster): Owned by the writer while writer_busy is set.
+    sys_thread_t             writer_thread;
+    volatile u32             writer_busy;
+    flight_recorder_frame_t *dump_frames;
+    u32                      dump_frame_count;
+    u32                      dump_trigger_index;
+    const char              *dump_reason;
+    char                     dump_path[FLIGHT_RECORDER_MAX_PATH_LENGTH];
+    byte                    *output_buffer;
+    u32                      output_used;
+    file_t                   output_file;
+    bool8                    output_failed;
+
+    u32                      dump_index;
+    u64                      skipped_dumps;
+};
+
+void  c_flight_recorder_init(flight_recorder_t *recorder, flight_recorder_config_t *config);
+void  c_flight_recorder_destroy(flight_recorder_t *recorder);
+void  c_flight_recorder_frame_end(flight_recorder_t *recorder, flight_recorder_frame_stats_t *stats);
+bool8 c_flight_recorder_dump(flight_recorder_t *recorder, const char *reason);
+
+#endif // C_FLIGHT_RECORDER_H
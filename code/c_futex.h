@@ -0,0 +1,333 @@
+#if !defined(C_FUTEX_H)
+/* ========================================================================
+   $File: c_futex.h $
+   $Date: October 18 2026 08:05 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define C_FUTEX_H
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+
+#include <c_synchronization.h>
+
+/* NOTE(Sleepster): Sync primitives on top of sys_futex_wait()/sys_futex_wake().
+ *
+ * Every one of these is a couple of u32s, zero initialized is ready to use, and nothing allocates or needs to be
+ * freed. Embed them right in whatever they protect. The uncontended paths are a single atomic and never make a
+ * syscall, the kernel only gets involved once somebody actually has to sleep. Header only so those fast paths inline.
+ *
+ * None of these are fiber aware. Don't hold one across c_threadpool_wait_for_counter(), the task can come back on
+ * a different thread.
+ */
+
+#define FUTEX_MUTEX_SPIN_COUNT     (100)
+#define FUTEX_SEMAPHORE_SPIN_COUNT (100)
+
+// NOTE(Sleepster): state is 0 unlocked, 1 locked, 2 locked and somebody might be sleeping on it.
+struct futex_mutex_t
+{
+    volatile u32 state;
+};
+
+struct futex_semaphore_t
+{
+    volatile u32 count;
+    volatile u32 waiter_count;
+};
+
+// NOTE(Sleepster): One-shot, once it's signaled it stays signaled. Every waiter, past and future, gets through.
+struct futex_event_t
+{
+    volatile u32 is_signaled;
+};
+
+// NOTE(Sleepster): Auto-reset, every signal lets exactly one waiter through. Signals don't stack.
+struct futex_auto_event_t
+{
+    volatile u32 is_signaled;
+    volatile u32 waiter_count;
+};
+
+/* NOTE(Sleepster): Reader/writer lock. Writers are preferred, once a writer is waiting no new readers get in, so a
+ * steady stream of readers can't starve it out. Not recursive, and a reader can't upgrade to a writer.
+ */
+#define FUTEX_RWLOCK_WRITER         (0x80000000)
+#define FUTEX_RWLOCK_WRITER_WAITING (0x40000000)
+#define FUTEX_RWLOCK_READER_MASK    (0x3FFFFFFF)
+
+struct futex_rwlock_t
+{
+    volatile u32 state;
+    volatile u32 waiter_count;
+};
+
+/*===========================================
+  ================= MUTEX ===================
+  ===========================================*/
+
+internal_api inline bool8
+c_futex_mutex_try_lock(futex_mutex_t *mutex)
+{
+    bool8 result = AtomicCompareExchange32(&mutex->state, 1, 0) == 0;
+    return(result);
+}
+
+// NOTE(Sleepster): Drepper's "Futexes Are Tricky" mutex with a short spin in front of it. Critical sections in
+//                  here are usually a handful of instructions, so spinning a bit beats a trip into the kernel.
+internal_api inline void
+c_futex_mutex_lock(futex_mutex_t *mutex)
+{
+    if(AtomicCompareExchange32(&mutex->state, 1, 0) != 0)
+    {
+        bool8 acquired = false;
+        for(u32 spin_index = 0;
+            spin_index < FUTEX_MUTEX_SPIN_COUNT && !acquired;
+            ++spin_index)
+        {
+            _mm_pause();
+            if(AtomicLoad32(&mutex->state) == 0)
+            {
+                acquired = AtomicCompareExchange32(&mutex->state, 1, 0) == 0;
+            }
+        }
+
+        if(!acquired)
+        {
+            // NOTE(Sleepster): Once we've gone to sleep we can't know if anyone else is, so we always take it as 2
+            //                  and the unlock always does a wake. Costs at most one extra syscall.
+            while(AtomicExchange32(&mutex->state, 2) != 0)
+            {
+                sys_futex_wait(&mutex->state, 2, 0);
+            }
+        }
+    }
+}
+
+internal_api inline void
+c_futex_mutex_unlock(futex_mutex_t *mutex)
+{
+    Assert(mutex->state != 0);
+    if(AtomicExchange32(&mutex->state, 0) == 2)
+    {
+        sys_futex_wake(&mutex->state, 1);
+    }
+}
+
+/*===========================================
+  =============== SEMAPHORE =================
+  ===========================================*/
+
+internal_api inline bool8
+c_futex_semaphore_try_wait(futex_semaphore_t *semaphore)
+{
+    bool8 result = false;
+    for(;;)
+    {
+        u32 count = AtomicLoad32(&semaphore->count);
+        if(count == 0) break;
+
+        if((u32)AtomicCompareExchange32(&semaphore->count, count - 1, count) == count)
+        {
+            result = true;
+            break;
+        }
+    }
+
+    return(result);
+}
+
+// NOTE(Sleepster): timeout_ms of 0 means forever, returns false if it timed out.
+internal_api inline bool8
+c_futex_semaphore_wait(futex_semaphore_t *semaphore, u32 timeout_ms = 0)
+{
+    bool8 result = false;
+    for(u32 spin_index = 0;
+        spin_index < FUTEX_SEMAPHORE_SPIN_COUNT && !result;
+        ++spin_index)
+    {
+        result = c_futex_semaphore_try_wait(semaphore);
+        if(!result) _mm_pause();
+    }
+
+    // NOTE(Sleepster): waiter_count goes up before we look at count, and the release bumps count before it looks at
+    //                  waiter_count. Both are full barriers, so either we see the count or it sees us.
+    bool8 timed_out = false;
+    while(!result && !timed_out)
+    {
+        AtomicIncrement32(&semaphore->waiter_count);
+        if(AtomicLoad32(&semaphore->count) == 0)
+        {
+            timed_out = !sys_futex_wait(&semaphore->count, 0, timeout_ms);
+        }
+        AtomicDecrement32(&semaphore->waiter_count);
+
+        result = c_futex_semaphore_try_wait(semaphore);
+    }
+
+    return(result);
+}
+
+internal_api inline void
+c_futex_semaphore_release(futex_semaphore_t *semaphore, u32 release_count = 1)
+{
+    AtomicExchangeAdd32(&semaphore->count, release_count);
+    if(AtomicLoad32(&semaphore->waiter_count) > 0)
+    {
+        sys_futex_wake(&semaphore->count, release_count);
+    }
+}
+
+/*===========================================
+  ================= EVENTS ==================
+  ===========================================*/
+
+internal_api inline void
+c_futex_event_signal(futex_event_t *event)
+{
+    if(AtomicExchange32(&event->is_signaled, 1) == 0)
+    {
+        sys_futex_wake(&event->is_signaled, SYS_FUTEX_WAKE_ALL);
+    }
+}
+
+internal_api inline void
+c_futex_event_wait(futex_event_t *event)
+{
+    while(AtomicLoad32(&event->is_signaled) == 0)
+    {
+        sys_futex_wait(&event->is_signaled, 0, 0);
+    }
+}
+
+internal_api inline bool8
+c_futex_event_is_signaled(futex_event_t *event)
+{
+    bool8 result = AtomicLoad32(&event->is_signaled) != 0;
+    return(result);
+}
+
+internal_api inline void
+c_futex_auto_event_signal(futex_auto_event_t *event)
+{
+    AtomicExchange32(&event->is_signaled, 1);
+    if(AtomicLoad32(&event->waiter_count) > 0)
+    {
+        sys_futex_wake(&event->is_signaled, 1);
+    }
+}
+
+internal_api inline void
+c_futex_auto_event_wait(futex_auto_event_t *event)
+{
+    while(AtomicCompareExchange32(&event->is_signaled, 0, 1) != 1)
+    {
+        AtomicIncrement32(&event->waiter_count);
+        if(AtomicLoad32(&event->is_signaled) == 0)
+        {
+            sys_futex_wait(&event->is_signaled, 0, 0);
+        }
+        AtomicDecrement32(&event->waiter_count);
+    }
+}
+
+/*===========================================
+  ================ RW LOCK ==================
+  ===========================================*/
+
+// NOTE(Sleepster): Everybody sleeps on state and every unlock that might let somebody in wakes all of them. The
+//                  losers go right back to sleep. Fine for the read mostly cases this is meant for.
+internal_api inline void
+c_futex_rwlock_sleep(futex_rwlock_t *lock, u32 observed_state)
+{
+    AtomicIncrement32(&lock->waiter_count);
+    if((u32)AtomicLoad32(&lock->state) == observed_state)
+    {
+        sys_futex_wait(&lock->state, observed_state, 0);
+    }
+    AtomicDecrement32(&lock->waiter_count);
+}
+
+internal_api inline void
+c_futex_rwlock_wake(futex_rwlock_t *lock)
+{
+    if(AtomicLoad32(&lock->waiter_count) > 0)
+    {
+        sys_futex_wake(&lock->state, SYS_FUTEX_WAKE_ALL);
+    }
+}
+
+internal_api inline void
+c_futex_rwlock_read_lock(futex_rwlock_t *lock)
+{
+    u32 spin_count = 0;
+    for(;;)
+    {
+        u32 state = AtomicLoad32(&lock->state);
+        if((state & (FUTEX_RWLOCK_WRITER|FUTEX_RWLOCK_WRITER_WAITING)) == 0)
+        {
+            Assert((state & FUTEX_RWLOCK_READER_MASK) != FUTEX_RWLOCK_READER_MASK);
+            if((u32)AtomicCompareExchange32(&lock->state, state + 1, state) == state) break;
+        }
+        else if(spin_count < FUTEX_MUTEX_SPIN_COUNT)
+        {
+            ++spin_count;
+            _mm_pause();
+        }
+        else
+        {
+            c_futex_rwlock_sleep(lock, state);
+        }
+    }
+}
+
+internal_api inline void
+c_futex_rwlock_read_unlock(futex_rwlock_t *lock)
+{
+    u32 state = (u32)AtomicAdd32(&lock->state, -1);
+    if((state & FUTEX_RWLOCK_READER_MASK) == 0)
+    {
+        c_futex_rwlock_wake(lock);
+    }
+}
+
+internal_api inline void
+c_futex_rwlock_write_lock(futex_rwlock_t *lock)
+{
+    u32 spin_count = 0;
+    for(;;)
+    {
+        u32 state = AtomicLoad32(&lock->state);
+        if((state & ~FUTEX_RWLOCK_WRITER_WAITING) == 0)
+        {
+            // NOTE(Sleepster): Taking it clears the waiting bit. Any other writers that are still waiting set it
+            //                  again the next time they look.
+            if((u32)AtomicCompareExchange32(&lock->state, FUTEX_RWLOCK_WRITER, state) == state) break;
+        }
+        else if((state & FUTEX_RWLOCK_WRITER_WAITING) == 0)
+        {
+            AtomicCompareExchange32(&lock->state, state | FUTEX_RWLOCK_WRITER_WAITING, state);
+        }
+        else if(spin_count < FUTEX_MUTEX_SPIN_COUNT)
+        {
+            ++spin_count;
+            _mm_pause();
+        }
+        else
+        {
+            c_futex_rwlock_sleep(lock, state);
+        }
+    }
+}
+
+internal_api inline void
+c_futex_rwlock_write_unlock(futex_rwlock_t *lock)
+{
+    Assert(lock->state & FUTEX_RWLOCK_WRITER);
+    AtomicExchange32(&lock->state, 0);
+    c_futex_rwlock_wake(lock);
+}
+
+#endif // C_FUTEX_H
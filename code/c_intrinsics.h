@@ -47,9 +47,11 @@
             #error "LMAO what hte fuck are you doing here???"
         #endif
 
-        #define PopCount16(value) __builtin_popcount((s16)value)
-        #define PopCount32(value) __builtin_popcount((s32)value)
-        #define PopCount64(value) __builtin_popcount((s64)value)
+        // NOTE(Sleepster): Unsigned, a signed 16 bit value sign extends into the int. 64 bits needs the ll version,
+        //                  the plain one truncates to 32.
+        #define PopCount16(value) __builtin_popcount((u16)(value))
+        #define PopCount32(value) __builtin_popcount((u32)(value))
+        #define PopCount64(value) __builtin_popcountll((u64)(value))
 
     /* ===========================================
        ================== FENCES =================
@@ -0,0 +1,260 @@
+/* ========================================================================
+   $File: c_lock_profiler.cpp $
+   $Date: October 19 2026 04:20 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <string.h>
+#include <stdlib.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_log.h>
+
+#include <c_lock_profiler.h>
+#include <c_profiler.h>
+
+#if PROFILER_ENABLED
+
+struct lock_profiler_entry_t
+{
+    const char   *name;
+    void         *lock;
+    lock_stats_t *stats;
+    bool8         is_semaphore;
+
+    // NOTE(Sleepster): What the last c_lock_profiler_log() saw.
+    u64           reported_acquire_count;
+    u64           reported_contended_count;
+    u64           reported_wait_ticks;
+};
+
+struct lock_profiler_t
+{
+    futex_mutex_t         mutex;
+    lock_profiler_entry_t entries[LOCK_PROFILER_MAX_LOCKS];
+    u32                   entry_count;
+};
+
+global_variable lock_profiler_t lock_profiler;
+
+internal_api void
+c_lock_profiler_add_entry(const char *name, void *lock, lock_stats_t *stats, bool8 is_semaphore)
+{
+    c_futex_mutex_lock(&lock_profiler.mutex);
+    if(lock_profiler.entry_count < LOCK_PROFILER_MAX_LOCKS)
+    {
+        lock_profiler_entry_t *entry = lock_profiler.entries + lock_profiler.entry_count++;
+        ZeroStruct(*entry);
+        entry->name         = name;
+        entry->lock         = lock;
+        entry->stats        = stats;
+        entry->is_semaphore = is_semaphore;
+        entry->reported_acquire_count   = stats->acquire_count;
+        entry->reported_contended_count = stats->contended_count;
+        entry->reported_wait_ticks      = stats->wait_ticks;
+    }
+    else
+    {
+        log_warning("Lock profiler is full ('%u' locks), '%s' won't be reported...\n", LOCK_PROFILER_MAX_LOCKS, name);
+    }
+    c_futex_mutex_unlock(&lock_profiler.mutex);
+}
+
+void
+c_lock_profiler_register_mutex(const char *name, profiled_mutex_t *mutex)
+{
+    c_lock_profiler_add_entry(name, mutex, &mutex->stats, false);
+}
+
+void
+c_lock_profiler_register_semaphore(const char *name, profiled_semaphore_t *semaphore)
+{
+    c_lock_profiler_add_entry(name, semaphore, &semaphore->stats, true);
+}
+
+void
+c_lock_profiler_unregister(void *lock)
+{
+    c_futex_mutex_lock(&lock_profiler.mutex);
+    for(u32 entry_index = 0;
+        entry_index < lock_profiler.entry_count;
+        ++entry_index)
+    {
+        if(lock_profiler.entries[entry_index].lock == lock)
+        {
+            lock_profiler.entries[entry_index] = lock_profiler.entries[--lock_profiler.entry_count];
+            break;
+        }
+    }
+    c_futex_mutex_unlock(&lock_profiler.mutex);
+}
+
+// NOTE(Sleepster): Read while the locks are in use, every number is a u64 on its own so nothing tears, they just
+//                  might not agree with each other by a few acquires.
+internal_api void
+c_lock_profiler_add_stats(lock_stats_t *total, lock_stats_t *stats)
+{
+    total->acquire_count      += stats->acquire_count;
+    total->contended_count    += stats->contended_count;
+    total->wait_ticks         += stats->wait_ticks;
+    total->hold_ticks         += stats->hold_ticks;
+    total->hold_samples       += stats->hold_samples;
+    total->dropped_site_waits += stats->dropped_site_waits;
+    total->max_wait_ticks      = Max(total->max_wait_ticks, stats->max_wait_ticks);
+    total->max_hold_ticks      = Max(total->max_hold_ticks, stats->max_hold_ticks);
+
+    // NOTE(Sleepster): Same header, different translation unit, different __FILE__ pointer.
+    for(u32 site_index = 0; site_index < LOCK_PROFILER_MAX_WAIT_SITES; ++site_index)
+    {
+        lock_wait_site_t site = stats->wait_sites[site_index];
+        if(site.file == null) break;
+
+        bool8 was_added = false;
+        for(u32 total_index = 0; total_index < LOCK_PROFILER_MAX_WAIT_SITES && !was_added; ++total_index)
+        {
+            lock_wait_site_t *total_site = total->wait_sites + total_index;
+            if(total_site->file == null)
+            {
+                *total_site = site;
+                was_added   = true;
+            }
+            else if(total_site->line == site.line && strcmp(total_site->file, site.file) == 0)
+            {
+                total_site->wait_count += site.wait_count;
+                total_site->wait_ticks += site.wait_ticks;
+                was_added = true;
+            }
+        }
+        if(!was_added) total->dropped_site_waits += site.wait_count;
+    }
+}
+
+u32
+c_lock_profiler_get_stats(const char *name, lock_stats_t *stats_out)
+{
+    u32 result = 0;
+    ZeroStruct(*stats_out);
+
+    c_futex_mutex_lock(&lock_profiler.mutex);
+    for(u32 entry_index = 0;
+        entry_index < lock_profiler.entry_count;
+        ++entry_index)
+    {
+        lock_profiler_entry_t *entry = lock_profiler.entries + entry_index;
+        if(strcmp(entry->name, name) == 0)
+        {
+            c_lock_profiler_add_stats(stats_out, entry->stats);
+            ++result;
+        }
+    }
+    c_futex_mutex_unlock(&lock_profiler.mutex);
+
+    return(result);
+}
+
+internal_api int
+c_lock_profiler_compare_sites(const void *a, const void *b)
+{
+    u64 left  = ((lock_wait_site_t*)a)->wait_ticks;
+    u64 right = ((lock_wait_site_t*)b)->wait_ticks;
+    return((left < right) - (left > right));
+}
+
+void
+c_lock_profiler_log(void)
+{
+    float64 ticks_per_ms = c_profiler_get_ticks_per_ms();
+    float64 ticks_per_us = ticks_per_ms / 1000.0;
+
+    c_futex_mutex_lock(&lock_profiler.mutex);
+    log_info("Lock contention, '%u' locks...\n", lock_profiler.entry_count);
+
+    bool8 was_logged[LOCK_PROFILER_MAX_LOCKS] = {};
+    for(u32 entry_index = 0;
+        entry_index < lock_profiler.entry_count;
+        ++entry_index)
+    {
+        if(was_logged[entry_index]) continue;
+
+        // NOTE(Sleepster): Every lock with this name, and what each of them did since the last report.
+        lock_profiler_entry_t *first_entry = lock_profiler.entries + entry_index;
+        lock_stats_t total     = {};
+        u32 lock_count         = 0;
+        u64 new_acquire_count  = 0;
+        u64 new_contended      = 0;
+        u64 new_wait_ticks     = 0;
+        for(u32 other_index = entry_index;
+            other_index < lock_profiler.entry_count;
+            ++other_index)
+        {
+            lock_profiler_entry_t *entry = lock_profiler.entries + other_index;
+            if(strcmp(entry->name, first_entry->name) != 0) continue;
+
+            lock_stats_t stats = *entry->stats;
+            c_lock_profiler_add_stats(&total, &stats);
+            new_acquire_count += stats.acquire_count   - entry->reported_acquire_count;
+            new_contended     += stats.contended_count - entry->reported_contended_count;
+            new_wait_ticks    += stats.wait_ticks      - entry->reported_wait_ticks;
+            entry->reported_acquire_count   = stats.acquire_count;
+            entry->reported_contended_count = stats.contended_count;
+            entry->reported_wait_ticks      = stats.wait_ticks;
+
+            was_logged[other_index] = true;
+            ++lock_count;
+        }
+
+        float64 contended_percent = total.acquire_count ? (100.0 * (float64)total.contended_count) / (float64)total.acquire_count : 0.0;
+        log_info("    %s (x%u): '%llu' acquires, '%llu' contended (%.2f%%), waited %.3f ms (max %.1f us)\n",
+                 first_entry->name, lock_count, (unsigned long long)total.acquire_count, (unsigned long long)total.contended_count,
+                 contended_percent, (float64)total.wait_ticks / ticks_per_ms, (float64)total.max_wait_ticks / ticks_per_us);
+        if(!first_entry->is_semaphore && total.hold_samples)
+        {
+            // NOTE(Sleepster): Only some acquires were timed, the total is their average times all of them.
+            float64 average_hold_ticks = (float64)total.hold_ticks / (float64)total.hold_samples;
+            log_info("        held ~%.3f ms (avg %.2f us, max %.1f us, '%llu' timed)\n",
+                     average_hold_ticks * (float64)total.acquire_count / ticks_per_ms, average_hold_ticks / ticks_per_us,
+                     (float64)total.max_hold_ticks / ticks_per_us, (unsigned long long)total.hold_samples);
+        }
+        log_info("        since the last report: '%llu' acquires, '%llu' contended, waited %.3f ms\n",
+                 (unsigned long long)new_acquire_count, (unsigned long long)new_contended, (float64)new_wait_ticks / ticks_per_ms);
+
+        qsort(total.wait_sites, LOCK_PROFILER_MAX_WAIT_SITES, sizeof(lock_wait_site_t), c_lock_profiler_compare_sites);
+        for(u32 site_index = 0; site_index < LOCK_PROFILER_MAX_WAIT_SITES; ++site_index)
+        {
+            lock_wait_site_t *site = total.wait_sites + site_index;
+            if(site->wait_count == 0) break;
+
+            log_info("        waited at %s:%u '%llu' times, %.3f ms\n",
+                     site->file, site->line, (unsigned long long)site->wait_count, (float64)site->wait_ticks / ticks_per_ms);
+        }
+        if(total.dropped_site_waits)
+        {
+            log_info("        '%llu' waits from sites that didn't fit...\n", (unsigned long long)total.dropped_site_waits);
+        }
+    }
+    c_futex_mutex_unlock(&lock_profiler.mutex);
+}
+
+#else
+
+void c_lock_profiler_register_mutex(const char *name, profiled_mutex_t *mutex) {}
+void c_lock_profiler_register_semaphore(const char *name, profiled_semaphore_t *semaphore) {}
+void c_lock_profiler_unregister(void *lock) {}
+
+u32
+c_lock_profiler_get_stats(const char *name, lock_stats_t *stats_out)
+{
+    ZeroStruct(*stats_out);
+    return(0);
+}
+
+void
+c_lock_profiler_log(void)
+{
+    log_info("Lock profiling is compiled out (PROFILER_ENABLED=0)...\n");
+}
+
+#endif // PROFILER_ENABLED
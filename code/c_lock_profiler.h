@@ -0,0 +1,214 @@
+#if !defined(C_LOCK_PROFILER_H)
+/* ========================================================================
+   $File: c_lock_profiler.h $
+   $Date: October 19 2026 04:20 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define C_LOCK_PROFILER_H
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_futex.h>
+
+/* NOTE(Sleepster): Contention numbers for the locks we think are hot, so it's a measurement instead of a hunch.
+ *
+ * profiled_mutex_t and profiled_semaphore_t are the futex ones with stats hung off of them. Use them the same way,
+ * through the c_profiled_* calls, zero initialized is still ready to go. Every lock keeps:
+ *   acquires  - every time it was taken
+ *   contended - the ones that didn't get it on the first try, the wait time is how long those took
+ *   hold      - mutexes only, lock to unlock. Timed on one acquire in LOCK_PROFILER_HOLD_SAMPLE_RATE, the max is
+ *               the longest of those
+ *   sites     - the file:line of the contended acquires, with how often and how long each one waited
+ * An acquire that gets the lock on the first try is a plain add and a branch, plus the rdtscs on the sampled ones.
+ * A mutex's stats only ever change while it's held. Semaphores have no owner, theirs are atomics and the wait sites
+ * take a lock of their own, only on the contended path.
+ *
+ * A semaphore's "contended" waits are the ones where it had nothing to hand out. For the threadpool that's a worker
+ * going idle, the wait time is how long the workers slept and not a cost.
+ *
+ * Register a lock with a name for it to be in c_lock_profiler_log(), and unregister it before it's freed. Locks with
+ * the same name get added together (every zone, say). Compiled out with the profiler, the wrappers are then just
+ * the futex calls.
+ */
+
+// NOTE(Sleepster): Not c_profiler.h, the zone allocator includes this and the profiler includes the platform layer.
+#if !defined(PROFILER_ENABLED)
+    #define PROFILER_ENABLED 0
+#endif
+
+#define LOCK_PROFILER_MAX_LOCKS      (64)
+#define LOCK_PROFILER_MAX_WAIT_SITES (8)
+#define LOCK_PROFILER_HOLD_SAMPLE_RATE (16)
+
+StaticAssert((LOCK_PROFILER_HOLD_SAMPLE_RATE & (LOCK_PROFILER_HOLD_SAMPLE_RATE - 1)) == 0, "Lock profiler hold sample rate must be a power of two...\n");
+
+struct lock_wait_site_t
+{
+    const char  *file;
+    u32          line;
+    u64          wait_count;
+    u64          wait_ticks;
+};
+
+struct lock_stats_t
+{
+    volatile u64     acquire_count;
+    u64              contended_count;
+    u64              wait_ticks;
+    u64              max_wait_ticks;
+    u64              hold_ticks;
+    u64              hold_samples;
+    u64              max_hold_ticks;
+
+    // NOTE(Sleepster): Contended waits from a site that didn't fit in the table, still in the totals above.
+    u64              dropped_site_waits;
+    lock_wait_site_t wait_sites[LOCK_PROFILER_MAX_WAIT_SITES];
+};
+
+struct profiled_mutex_t
+{
+    futex_mutex_t    mutex;
+#if PROFILER_ENABLED
+    u64              acquired_at;      // NOTE(Sleepster): 0 when this acquire isn't the one being timed.
+    lock_stats_t     stats;
+#endif
+};
+
+struct profiled_semaphore_t
+{
+    futex_semaphore_t semaphore;
+#if PROFILER_ENABLED
+    futex_mutex_t     site_lock;
+    lock_stats_t      stats;
+#endif
+};
+
+void  c_lock_profiler_register_mutex(const char *name, profiled_mutex_t *mutex);
+void  c_lock_profiler_register_semaphore(const char *name, profiled_semaphore_t *semaphore);
+void  c_lock_profiler_unregister(void *lock);
+
+// NOTE(Sleepster): Every registered lock with this name added together, returns how many there were.
+u32   c_lock_profiler_get_stats(const char *name, lock_stats_t *stats_out);
+
+// NOTE(Sleepster): Everything since the start, and what changed since the last call.
+void  c_lock_profiler_log(void);
+
+#define c_profiled_mutex_lock(mutex)         c_profiled_mutex_lock_(mutex, __FILE__, __LINE__)
+#define c_profiled_semaphore_wait(semaphore) c_profiled_semaphore_wait_(semaphore, __FILE__, __LINE__)
+
+#if PROFILER_ENABLED
+
+internal_api inline void
+c_lock_stats_record_wait(lock_stats_t *stats, const char *file, u32 line, u64 wait_ticks)
+{
+    stats->contended_count += 1;
+    stats->wait_ticks      += wait_ticks;
+    if(wait_ticks > stats->max_wait_ticks) stats->max_wait_ticks = wait_ticks;
+
+    for(u32 site_index = 0; site_index < LOCK_PROFILER_MAX_WAIT_SITES; ++site_index)
+    {
+        lock_wait_site_t *site = stats->wait_sites + site_index;
+        if(site->file == null)
+        {
+            site->file = file;
+            site->line = line;
+        }
+
+        if(site->file == file && site->line == line)
+        {
+            site->wait_count += 1;
+            site->wait_ticks += wait_ticks;
+            return;
+        }
+    }
+    stats->dropped_site_waits += 1;
+}
+
+internal_api inline void
+c_profiled_mutex_acquired(profiled_mutex_t *mutex)
+{
+    mutex->stats.acquire_count += 1;
+    mutex->acquired_at          = (mutex->stats.acquire_count & (LOCK_PROFILER_HOLD_SAMPLE_RATE - 1)) ? 0 : rdtsc();
+}
+
+#endif // PROFILER_ENABLED
+
+/*===========================================
+  ================= MUTEX ===================
+  ===========================================*/
+
+internal_api inline bool8
+c_profiled_mutex_try_lock(profiled_mutex_t *mutex)
+{
+    bool8 result = c_futex_mutex_try_lock(&mutex->mutex);
+#if PROFILER_ENABLED
+    if(result) c_profiled_mutex_acquired(mutex);
+#endif
+
+    return(result);
+}
+
+internal_api inline void
+c_profiled_mutex_lock_(profiled_mutex_t *mutex, const char *file, u32 line)
+{
+#if PROFILER_ENABLED
+    if(!c_futex_mutex_try_lock(&mutex->mutex))
+    {
+        u64 wait_start = rdtsc();
+        c_futex_mutex_lock(&mutex->mutex);
+        c_lock_stats_record_wait(&mutex->stats, file, line, rdtsc() - wait_start);
+    }
+    c_profiled_mutex_acquired(mutex);
+#else
+    c_futex_mutex_lock(&mutex->mutex);
+#endif
+}
+
+internal_api inline void
+c_profiled_mutex_unlock(profiled_mutex_t *mutex)
+{
+#if PROFILER_ENABLED
+    if(mutex->acquired_at)
+    {
+        u64 hold_ticks = rdtsc() - mutex->acquired_at;
+        mutex->stats.hold_ticks   += hold_ticks;
+        mutex->stats.hold_samples += 1;
+        if(hold_ticks > mutex->stats.max_hold_ticks) mutex->stats.max_hold_ticks = hold_ticks;
+    }
+#endif
+    c_futex_mutex_unlock(&mutex->mutex);
+}
+
+/*===========================================
+  =============== SEMAPHORE =================
+  ===========================================*/
+
+internal_api inline void
+c_profiled_semaphore_wait_(profiled_semaphore_t *semaphore, const char *file, u32 line)
+{
+#if PROFILER_ENABLED
+    if(!c_futex_semaphore_try_wait(&semaphore->semaphore))
+    {
+        u64 wait_start = rdtsc();
+        c_futex_semaphore_wait(&semaphore->semaphore);
+        u64 wait_ticks = rdtsc() - wait_start;
+
+        c_futex_mutex_lock(&semaphore->site_lock);
+        c_lock_stats_record_wait(&semaphore->stats, file, line, wait_ticks);
+        c_futex_mutex_unlock(&semaphore->site_lock);
+    }
+    AtomicIncrement64(&semaphore->stats.acquire_count);
+#else
+    c_futex_semaphore_wait(&semaphore->semaphore);
+#endif
+}
+
+internal_api inline void
+c_profiled_semaphore_release(profiled_semaphore_t *semaphore, u32 release_count = 1)
+{
+    c_futex_semaphore_release(&semaphore->semaphore, release_count);
+}
+
+#endif // C_LOCK_PROFILER_H
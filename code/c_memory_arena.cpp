@@ -19,6 +19,7 @@ c_arena_create(u64 block_size)
     result.base           = (byte*)sys_allocate_memory(block_size);
     result.used           = 0;
     result.block_size     = block_size;
+    result.reserved       = block_size;
     result.block_counter += 1;
     result.is_initialized = true;
 
@@ -43,8 +44,9 @@ c_arena_get_footer(memory_arena_t *arena)
     return(result);
 }
 
+// NOTE(Sleepster): No file means don't track it, for pushes that aren't where the memory ends up (bootstrapping).
 byte*
-c_arena_push_size(memory_arena_t *arena, u64 size_init)
+c_arena_push_size_(memory_arena_t *arena, u64 size_init, const char *file, u32 line)
 {
     Assert(arena->is_initialized == true);
     Assert(size_init > 0);
@@ -63,6 +65,7 @@ c_arena_push_size(memory_arena_t *arena, u64 size_init)
         footer.last_base       = (u8 *)arena->base;
         footer.last_used       = arena->used;
         footer.last_block_size = arena->block_size;
+        footer.last_touched    = arena->touched;
 
         size += sizeof(memory_arena_footer_t);
         u64 new_block_size = size > (arena->block_size + sizeof(memory_arena_footer_t)) ? size : arena->block_size;
@@ -73,6 +76,11 @@ c_arena_push_size(memory_arena_t *arena, u64 size_init)
         arena->used       = 0;
         arena->block_counter += 1;
 
+        arena->used_below    += footer.last_used;
+        arena->touched_below += footer.last_touched;
+        arena->touched        = 0;
+        arena->reserved      += new_block_size;
+
         memory_arena_footer_t *arena_footer = c_arena_get_footer(arena);
         *arena_footer = footer;
     }
@@ -83,6 +91,10 @@ c_arena_push_size(memory_arena_t *arena, u64 size_init)
     result = offset_ptr;
     arena->used += size;
 
+    if(arena->used > arena->touched)                       arena->touched   = arena->used;
+    if(arena->used_below + arena->used > arena->peak_used) arena->peak_used = arena->used_below + arena->used;
+    if(file) ALLOC_TRACK(AE_ArenaPush, arena, arena->used_below + arena->used - size, size_init, file, line);
+
     return(result);
 }
 
@@ -94,7 +106,7 @@ c_arena_bootstrap_allocate_struct_(u32 structure_size, u32 offset_to_arena, u64
 
     structure_size = Align16(structure_size);
     memory_arena_t bootstrap = c_arena_create(block_size);
-    result                   = (byte*)c_arena_push_size(&bootstrap, structure_size);
+    result                   = (byte*)c_arena_push_size_(&bootstrap, structure_size, null, 0);
     Assert(result);
 
     *(memory_arena_t*)(result + offset_to_arena) = bootstrap;
@@ -106,6 +118,7 @@ c_arena_clear_block(memory_arena_t *arena)
 {
     memset(arena->base, 0, arena->used);    
     arena->used = 0;
+    ALLOC_TRACK(AE_ArenaRewind, arena, arena->used_below, 0, null, 0);
 }
 
 void
@@ -122,8 +135,14 @@ c_arena_free_last_block(memory_arena_t *arena)
     arena->block_size = footer->last_block_size;
     arena->block_size = footer->last_block_size;
 
+    arena->used_below    -= footer->last_used;
+    arena->touched_below -= footer->last_touched;
+    arena->touched        = footer->last_touched;
+    arena->reserved      -= free_size + sizeof(memory_arena_footer_t);
+
     sys_free_memory(block_to_free, free_size);
     arena->block_counter -= 1;
+    ALLOC_TRACK(AE_ArenaRewind, arena, arena->used_below + arena->used, 0, null, 0);
 }
 
 void
@@ -137,6 +156,7 @@ c_arena_reset(memory_arena_t *arena)
     memset(arena->base, 0, arena->used);
 
     arena->used = 0;
+    ALLOC_TRACK(AE_ArenaRewind, arena, arena->used_below, 0, null, 0);
 }
 
 scratch_arena_t
@@ -145,7 +165,7 @@ c_arena_begin_temporary_memory(memory_arena_t *arena)
     scratch_arena_t result;
     result.parent = arena;
     result.used   = arena->used;
-    result.base   = (u8*)arena->base + arena->used;
+    result.base   = (u8*)arena->base;
 
     arena->scratch_arena_count += 1;
 
@@ -167,4 +187,5 @@ c_arena_end_temporary_memory(scratch_arena_t *scratch_arena)
     parent->base = scratch_arena->base;
 
     parent->scratch_arena_count -= 1;
+    ALLOC_TRACK(AE_ArenaRewind, parent, parent->used_below + parent->used, 0, null, 0);
 }
@@ -9,12 +9,14 @@
 #define C_MEMORY_ARENA_H
 #include <c_base.h>
 #include <c_types.h>
+#include <c_alloc_tracker.h>
 
 struct memory_arena_footer_t
 {
     byte *last_base;
     u64   last_used;
     u64   last_block_size;
+    u64   last_touched;
 };
 
 struct memory_arena_t
@@ -26,6 +28,16 @@ struct memory_arena_t
 
     u32    block_counter;
     u32    scratch_arena_count;
+
+    /* NOTE(Sleepster): Telemetry (see c_memory_telemetry.h). 'touched' is how far into the current block we've
+     * ever pushed, the OS only commits a page the first time it's written so that's what the arena actually costs.
+     * The blocks under the current one are folded into the *_below counts.
+     */
+    u64    touched;
+    u64    used_below;
+    u64    touched_below;
+    u64    reserved;
+    u64    peak_used;
 };
 
 struct scratch_arena_t
@@ -38,13 +50,14 @@ struct scratch_arena_t
 /*===========================================
   ============ STANDARD ARENAS  =============
   ===========================================*/
+#define c_arena_push_size(arena, size)                                   c_arena_push_size_(arena, size, __FILE__, __LINE__)
 #define c_arena_push_struct(arena, type)                                 (type*)(c_arena_push_size(arena, sizeof(type)))
 #define c_arena_push_array(arena, type, count)                           (type*)(c_arena_push_size(arena, sizeof(type) * count))
 #define c_arena_bootstrap_allocate_struct(type, member, allocation_size) (type*)(c_arena_bootstrap_allocate_struct_(sizeof(type), IntFromPtr(OffsetOf(type, member)), allocation_size))
 
 memory_arena_t c_arena_create(u64 block_size);
 void           c_arena_destroy(memory_arena_t *arena);
-byte*          c_arena_push_size(memory_arena_t *arena, u64 push_size);
+byte*          c_arena_push_size_(memory_arena_t *arena, u64 push_size, const char *file, u32 line);
 byte*          c_arena_bootstrap_allocate_struct_(u32 structure_size, u32 offset_to_arena, u64 block_size);
 void           c_arena_clear_block(memory_arena_t *arena);
 void           c_arena_free_last_block(memory_arena_t *arena);
@@ -53,7 +66,7 @@ void           c_arena_reset(memory_arena_t *arena);
 /*===========================================
   ============= SCRATCH ARENAS  =============
   ===========================================*/
-inline scratch_arena_t c_arena_begin_temporary_memeory(memory_arena_t *arena);
+inline scratch_arena_t c_arena_begin_temporary_memory(memory_arena_t *arena);
 inline void            c_arena_end_temporary_memory(scratch_arena_t *scratch_arena);
 
 #endif // C_MEMORY_ARENA_H
@@ -0,0 +1,527 @@
+/* ========================================================================
+   $File: c_memory_telemetry.cpp $
+   $Date: October 19 2026 03:10 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_log.h>
+#include <c_file_api.h>
+
+#include <c_memory_telemetry.h>
+#include <p_platform_data.h>
+
+#define MEMORY_TELEMETRY_WRITE_BUFFER_SIZE (KB(64))
+#define MEMORY_TELEMETRY_MAX_LINE_SIZE     (KB(1))
+
+global_variable memory_telemetry_t memory_telemetry;
+
+global_variable const char *memory_telemetry_kind_names[MTK_Count] = {
+    "arena",
+    "zone",
+    "dynarrays",
+};
+
+global_variable const char *memory_telemetry_tag_names[MTT_Count] = {
+    "none",
+    "static",
+    "texture",
+    "sound",
+    "font",
+    "cache",
+    "other",
+};
+
+internal_api inline float64
+c_memory_telemetry_mb(u64 bytes)
+{
+    float64 result = (float64)bytes / (float64)MB(1);
+    return(result);
+}
+
+internal_api u32
+c_memory_telemetry_get_tag_index(u64 tag)
+{
+    u32 result = MTT_Other;
+    switch(tag)
+    {
+        case ZA_TAG_NONE:    result = MTT_None;    break;
+        case ZA_TAG_STATIC:  result = MTT_Static;  break;
+        case ZA_TAG_TEXTURE: result = MTT_Texture; break;
+        case ZA_TAG_SOUND:   result = MTT_Sound;   break;
+        case ZA_TAG_FONT:    result = MTT_Font;    break;
+        case ZA_TAG_CACHE:   result = MTT_Cache;   break;
+    }
+
+    return(result);
+}
+
+/*===========================================
+  ============== REGISTRATION ===============
+  ===========================================*/
+
+internal_api void
+c_memory_telemetry_add_entry(const char *name, u32 kind, void *source)
+{
+    if(memory_telemetry.entry_count < MEMORY_TELEMETRY_MAX_ENTRIES)
+    {
+        memory_telemetry_entry_t *entry = memory_telemetry.entries + memory_telemetry.entry_count++;
+        ZeroStruct(*entry);
+        snprintf(entry->name, MEMORY_TELEMETRY_NAME_LENGTH, "%s", name);
+        for(char *c = entry->name; *c; ++c)
+        {
+            // NOTE(Sleepster): Names go into the CSV and JSON as they are.
+            if(*c == '"' || *c == '\\' || *c == ',') *c = '/';
+        }
+        entry->kind    = kind;
+        entry->source  = source;
+        entry->history = (memory_telemetry_sample_t*)sys_allocate_memory(sizeof(memory_telemetry_sample_t) * MEMORY_TELEMETRY_HISTORY_COUNT);
+        Assert(entry->history);
+    }
+    else
+    {
+        log_warning("Memory telemetry is full ('%u' entries), '%s' is not tracked...\n", MEMORY_TELEMETRY_MAX_ENTRIES, name);
+    }
+}
+
+// NOTE(Sleepster): Lock held. The dynarrays are always there, they don't have anything to register.
+internal_api void
+c_memory_telemetry_ensure_initialized(void)
+{
+    if(!memory_telemetry.is_initialized)
+    {
+        memory_telemetry.is_initialized = true;
+        c_memory_telemetry_add_entry("dynarrays", MTK_Dynarrays, &dynarray_memory_stats);
+    }
+}
+
+void
+c_memory_telemetry_register_arena(const char *name, memory_arena_t *arena)
+{
+    c_futex_mutex_lock(&memory_telemetry.mutex);
+    c_memory_telemetry_ensure_initialized();
+    c_memory_telemetry_add_entry(name, MTK_Arena, arena);
+    c_futex_mutex_unlock(&memory_telemetry.mutex);
+}
+
+void
+c_memory_telemetry_register_zone(const char *name, zone_allocator_t *zone)
+{
+    c_futex_mutex_lock(&memory_telemetry.mutex);
+    c_memory_telemetry_ensure_initialized();
+    c_memory_telemetry_add_entry(name, MTK_Zone, zone);
+    c_futex_mutex_unlock(&memory_telemetry.mutex);
+}
+
+void
+c_memory_telemetry_unregister(void *source)
+{
+    c_futex_mutex_lock(&memory_telemetry.mutex);
+    for(u32 entry_index = 0;
+        entry_index < memory_telemetry.entry_count;
+        ++entry_index)
+    {
+        memory_telemetry_entry_t *entry = memory_telemetry.entries + entry_index;
+        if(entry->source == source)
+        {
+            sys_free_memory(entry->history, sizeof(memory_telemetry_sample_t) * MEMORY_TELEMETRY_HISTORY_COUNT);
+            *entry = memory_telemetry.entries[--memory_telemetry.entry_count];
+            break;
+        }
+    }
+    c_futex_mutex_unlock(&memory_telemetry.mutex);
+}
+
+/*===========================================
+  ================ SAMPLING =================
+  ===========================================*/
+
+internal_api void
+c_memory_telemetry_sample_arena(memory_arena_t *arena, memory_telemetry_sample_t *sample)
+{
+    sample->current_bytes    = arena->used_below + arena->used;
+    sample->peak_bytes       = arena->peak_used;
+    sample->committed_bytes  = arena->touched_below + arena->touched;
+    sample->reserved_bytes   = arena->reserved;
+    sample->allocation_count = arena->block_counter;
+}
+
+internal_api void
+c_memory_telemetry_sample_zone(zone_allocator_t *zone, memory_telemetry_sample_t *sample)
+{
+    c_profiled_mutex_lock(&zone->mutex);
+    for(zone_allocator_block_t *block = zone->first_block.next_block;
+        block != &zone->first_block;
+        block = block->next_block)
+    {
+        if(block->is_allocated)
+        {
+            sample->tag_bytes[c_memory_telemetry_get_tag_index(block->allocation_tag)] += block->block_size;
+        }
+        else
+        {
+            sample->free_bytes       += block->block_size;
+            sample->free_block_count += 1;
+            if(block->block_size > sample->largest_free_block) sample->largest_free_block = block->block_size;
+        }
+    }
+
+    sample->current_bytes    = zone->used_bytes;
+    sample->peak_bytes       = zone->peak_used_bytes;
+    sample->committed_bytes  = zone->touched_bytes;
+    sample->reserved_bytes   = zone->capacity;
+    sample->allocation_count = zone->allocation_count;
+    c_profiled_mutex_unlock(&zone->mutex);
+}
+
+// NOTE(Sleepster): malloc'd and zeroed on creation, everything they have is committed.
+internal_api void
+c_memory_telemetry_sample_dynarrays(dynarray_memory_stats_t *stats, memory_telemetry_sample_t *sample)
+{
+    sample->current_bytes    = (u64)AtomicLoad64(&stats->live_bytes);
+    sample->peak_bytes       = (u64)AtomicLoad64(&stats->peak_bytes);
+    sample->committed_bytes  = sample->current_bytes;
+    sample->reserved_bytes   = sample->current_bytes;
+    sample->allocation_count = (u64)AtomicLoad64(&stats->live_count);
+}
+
+void
+c_memory_telemetry_frame_end(void)
+{
+    c_futex_mutex_lock(&memory_telemetry.mutex);
+    c_memory_telemetry_ensure_initialized();
+    for(u32 entry_index = 0;
+        entry_index < memory_telemetry.entry_count;
+        ++entry_index)
+    {
+        memory_telemetry_entry_t  *entry  = memory_telemetry.entries + entry_index;
+        memory_telemetry_sample_t *sample = entry->history + (entry->sample_count & (MEMORY_TELEMETRY_HISTORY_COUNT - 1));
+        ZeroStruct(*sample);
+        sample->frame_index = memory_telemetry.frame_index;
+
+        switch(entry->kind)
+        {
+            case MTK_Arena:     c_memory_telemetry_sample_arena((memory_arena_t*)entry->source, sample);              break;
+            case MTK_Zone:      c_memory_telemetry_sample_zone((zone_allocator_t*)entry->source, sample);             break;
+            case MTK_Dynarrays: c_memory_telemetry_sample_dynarrays((dynarray_memory_stats_t*)entry->source, sample); break;
+            default:            InvalidCodePath;                                                                        break;
+        }
+        ++entry->sample_count;
+    }
+    ++memory_telemetry.frame_index;
+    c_futex_mutex_unlock(&memory_telemetry.mutex);
+}
+
+bool8
+c_memory_telemetry_get_sample(void *source, u32 frames_ago, memory_telemetry_sample_t *sample_out)
+{
+    bool8 result = false;
+
+    c_futex_mutex_lock(&memory_telemetry.mutex);
+    for(u32 entry_index = 0;
+        entry_index < memory_telemetry.entry_count;
+        ++entry_index)
+    {
+        memory_telemetry_entry_t *entry = memory_telemetry.entries + entry_index;
+        if(entry->source == source)
+        {
+            if(frames_ago < entry->sample_count && frames_ago < MEMORY_TELEMETRY_HISTORY_COUNT)
+            {
+                *sample_out = entry->history[(entry->sample_count - 1 - frames_ago) & (MEMORY_TELEMETRY_HISTORY_COUNT - 1)];
+                result      = true;
+            }
+            break;
+        }
+    }
+    c_futex_mutex_unlock(&memory_telemetry.mutex);
+
+    return(result);
+}
+
+// NOTE(Sleepster): Every entry's sample added together, the sizes and the allocation count only.
+bool8
+c_memory_telemetry_get_total(u32 frames_ago, memory_telemetry_sample_t *total_out)
+{
+    bool8 result = false;
+    ZeroStruct(*total_out);
+
+    c_futex_mutex_lock(&memory_telemetry.mutex);
+    for(u32 entry_index = 0;
+        entry_index < memory_telemetry.entry_count;
+        ++entry_index)
+    {
+        memory_telemetry_entry_t *entry = memory_telemetry.entries + entry_index;
+        if(frames_ago < entry->sample_count && frames_ago < MEMORY_TELEMETRY_HISTORY_COUNT)
+        {
+            memory_telemetry_sample_t *sample = entry->history + ((entry->sample_count - 1 - frames_ago) & (MEMORY_TELEMETRY_HISTORY_COUNT - 1));
+            total_out->frame_index       = sample->frame_index;
+            total_out->current_bytes    += sample->current_bytes;
+            total_out->peak_bytes       += sample->peak_bytes;
+            total_out->committed_bytes  += sample->committed_bytes;
+            total_out->reserved_bytes   += sample->reserved_bytes;
+            total_out->allocation_count += sample->allocation_count;
+            result = true;
+        }
+    }
+    c_futex_mutex_unlock(&memory_telemetry.mutex);
+
+    return(result);
+}
+
+u32
+c_memory_telemetry_get_latest(memory_telemetry_latest_t *latest_out, u32 max_count)
+{
+    u32 result = 0;
+
+    c_futex_mutex_lock(&memory_telemetry.mutex);
+    for(u32 entry_index = 0;
+        entry_index < memory_telemetry.entry_count && result < max_count;
+        ++entry_index)
+    {
+        memory_telemetry_entry_t *entry = memory_telemetry.entries + entry_index;
+        if(entry->sample_count)
+        {
+            memory_telemetry_latest_t *latest = latest_out + result++;
+            memcpy(latest->name, entry->name, sizeof(latest->name));
+            latest->kind   = entry->kind;
+            latest->sample = entry->history[(entry->sample_count - 1) & (MEMORY_TELEMETRY_HISTORY_COUNT - 1)];
+        }
+    }
+    c_futex_mutex_unlock(&memory_telemetry.mutex);
+
+    return(result);
+}
+
+// NOTE(Sleepster): How much of the free space can't be handed out in one piece, 0 when it's all one block.
+float64
+c_memory_telemetry_get_fragmentation(memory_telemetry_sample_t *sample)
+{
+    float64 result = 0.0;
+    if(sample->free_bytes)
+    {
+        result = 1.0 - ((float64)sample->largest_free_block / (float64)sample->free_bytes);
+    }
+
+    return(result);
+}
+
+const char*
+c_memory_telemetry_get_tag_name(u32 tag_index)
+{
+    const char *result = tag_index < MTT_Count ? memory_telemetry_tag_names[tag_index] : "invalid";
+    return(result);
+}
+
+const char*
+c_memory_telemetry_get_kind_name(u32 kind)
+{
+    const char *result = kind < MTK_Count ? memory_telemetry_kind_names[kind] : "invalid";
+    return(result);
+}
+
+/*===========================================
+  ================ OUTPUT ===================
+  ===========================================*/
+
+void
+c_memory_telemetry_log(void)
+{
+    c_futex_mutex_lock(&memory_telemetry.mutex);
+    log_info("Memory telemetry, '%u' entries after '%llu' frames...\n", memory_telemetry.entry_count, (unsigned long long)memory_telemetry.frame_index);
+    for(u32 entry_index = 0;
+        entry_index < memory_telemetry.entry_count;
+        ++entry_index)
+    {
+        memory_telemetry_entry_t *entry = memory_telemetry.entries + entry_index;
+        if(entry->sample_count == 0) continue;
+
+        memory_telemetry_sample_t *sample = entry->history + ((entry->sample_count - 1) & (MEMORY_TELEMETRY_HISTORY_COUNT - 1));
+        float64 peak_percent = sample->reserved_bytes ? ((float64)sample->peak_bytes * 100.0) / (float64)sample->reserved_bytes : 0.0;
+        log_info("    %-24s %-9s current %9.2f MB, peak %9.2f MB, committed %9.2f MB, reserved %9.2f MB (peak is %.1f%%)\n",
+                 entry->name, memory_telemetry_kind_names[entry->kind],
+                 c_memory_telemetry_mb(sample->current_bytes), c_memory_telemetry_mb(sample->peak_bytes),
+                 c_memory_telemetry_mb(sample->committed_bytes), c_memory_telemetry_mb(sample->reserved_bytes), peak_percent);
+
+        if(entry->kind == MTK_Zone)
+        {
+            log_info("        '%llu' allocations, free %.2f MB in '%llu' blocks, largest %.2f MB, fragmentation %.1f%%\n",
+                     (unsigned long long)sample->allocation_count, c_memory_telemetry_mb(sample->free_bytes),
+                     (unsigned long long)sample->free_block_count, c_memory_telemetry_mb(sample->largest_free_block),
+                     c_memory_telemetry_get_fragmentation(sample) * 100.0);
+            for(u32 tag_index = 0; tag_index < MTT_Count; ++tag_index)
+            {
+                if(sample->tag_bytes[tag_index] == 0) continue;
+                log_info("        tag '%s': %.2f MB\n", memory_telemetry_tag_names[tag_index], c_memory_telemetry_mb(sample->tag_bytes[tag_index]));
+            }
+        }
+    }
+    c_futex_mutex_unlock(&memory_telemetry.mutex);
+}
+
+struct memory_telemetry_writer_t
+{
+    file_t file;
+    char  *buffer;
+    u32    used;
+    bool8  failed;
+};
+
+internal_api void
+c_memory_telemetry_writer_flush(memory_telemetry_writer_t *writer)
+{
+    if(writer->used && !writer->failed)
+    {
+        writer->failed = !c_file_write(&writer->file, writer->buffer, writer->used);
+    }
+    writer->used = 0;
+}
+
+internal_api void
+c_memory_telemetry_append(memory_telemetry_writer_t *writer, const char *format, ...)
+{
+    if(writer->used + MEMORY_TELEMETRY_MAX_LINE_SIZE > MEMORY_TELEMETRY_WRITE_BUFFER_SIZE) c_memory_telemetry_writer_flush(writer);
+
+    va_list args;
+    va_start(args, format);
+    s32 written = vsnprintf(writer->buffer + writer->used, MEMORY_TELEMETRY_MAX_LINE_SIZE, format, args);
+    va_end(args);
+
+    if(written > 0) writer->used += Min((u32)written, (u32)MEMORY_TELEMETRY_MAX_LINE_SIZE - 1);
+}
+
+internal_api bool8
+c_memory_telemetry_writer_open(memory_telemetry_writer_t *writer, string_t filepath)
+{
+    bool8 result = false;
+
+    writer->file = sys_file_open(filepath, true, false, false);
+    if(writer->file.handle != INVALID_FILE_HANDLE)
+    {
+        writer->buffer = (char*)sys_allocate_memory(MEMORY_TELEMETRY_WRITE_BUFFER_SIZE);
+        result         = writer->buffer != null;
+    }
+    else
+    {
+        log_error("Failed to open '%s' for the memory telemetry dump...\n", C_STR(filepath));
+    }
+
+    return(result);
+}
+
+internal_api bool8
+c_memory_telemetry_writer_close(memory_telemetry_writer_t *writer)
+{
+    c_memory_telemetry_writer_flush(writer);
+    sys_free_memory(writer->buffer, MEMORY_TELEMETRY_WRITE_BUFFER_SIZE);
+    c_file_close(&writer->file);
+
+    bool8 result = !writer->failed;
+    return(result);
+}
+
+// NOTE(Sleepster): Oldest sample that's still in the ring.
+internal_api inline u64
+c_memory_telemetry_first_sample(memory_telemetry_entry_t *entry)
+{
+    u64 result = entry->sample_count > MEMORY_TELEMETRY_HISTORY_COUNT ? entry->sample_count - MEMORY_TELEMETRY_HISTORY_COUNT : 0;
+    return(result);
+}
+
+bool8
+c_memory_telemetry_dump_csv(string_t filepath)
+{
+    memory_telemetry_writer_t writer = {};
+    if(!c_memory_telemetry_writer_open(&writer, filepath)) return(false);
+
+    c_memory_telemetry_append(&writer, "frame,name,kind,current_bytes,peak_bytes,committed_bytes,reserved_bytes,allocation_count,free_bytes,free_block_count,largest_free_block,fragmentation");
+    for(u32 tag_index = 0; tag_index < MTT_Count; ++tag_index)
+    {
+        c_memory_telemetry_append(&writer, ",tag_%s_bytes", memory_telemetry_tag_names[tag_index]);
+    }
+    c_memory_telemetry_append(&writer, "\n");
+
+    c_futex_mutex_lock(&memory_telemetry.mutex);
+    for(u32 entry_index = 0;
+        entry_index < memory_telemetry.entry_count;
+        ++entry_index)
+    {
+        memory_telemetry_entry_t *entry = memory_telemetry.entries + entry_index;
+        for(u64 sample_index = c_memory_telemetry_first_sample(entry);
+            sample_index < entry->sample_count;
+            ++sample_index)
+        {
+            memory_telemetry_sample_t *sample = entry->history + (sample_index & (MEMORY_TELEMETRY_HISTORY_COUNT - 1));
+            c_memory_telemetry_append(&writer, "%llu,%s,%s,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%.4f",
+                                      (unsigned long long)sample->frame_index, entry->name, memory_telemetry_kind_names[entry->kind],
+                                      (unsigned long long)sample->current_bytes, (unsigned long long)sample->peak_bytes,
+                                      (unsigned long long)sample->committed_bytes, (unsigned long long)sample->reserved_bytes,
+                                      (unsigned long long)sample->allocation_count, (unsigned long long)sample->free_bytes,
+                                      (unsigned long long)sample->free_block_count, (unsigned long long)sample->largest_free_block,
+                                      c_memory_telemetry_get_fragmentation(sample));
+            for(u32 tag_index = 0; tag_index < MTT_Count; ++tag_index)
+            {
+                c_memory_telemetry_append(&writer, ",%llu", (unsigned long long)sample->tag_bytes[tag_index]);
+            }
+            c_memory_telemetry_append(&writer, "\n");
+        }
+    }
+    c_futex_mutex_unlock(&memory_telemetry.mutex);
+
+    bool8 result = c_memory_telemetry_writer_close(&writer);
+    return(result);
+}
+
+bool8
+c_memory_telemetry_dump_json(string_t filepath)
+{
+    memory_telemetry_writer_t writer = {};
+    if(!c_memory_telemetry_writer_open(&writer, filepath)) return(false);
+
+    c_futex_mutex_lock(&memory_telemetry.mutex);
+    c_memory_telemetry_append(&writer, "{\"frame_count\":%llu,\"entries\":[", (unsigned long long)memory_telemetry.frame_index);
+    for(u32 entry_index = 0;
+        entry_index < memory_telemetry.entry_count;
+        ++entry_index)
+    {
+        memory_telemetry_entry_t *entry = memory_telemetry.entries + entry_index;
+        c_memory_telemetry_append(&writer, "%s\n{\"name\":\"%s\",\"kind\":\"%s\",\"samples\":[", entry_index ? "," : "", entry->name, memory_telemetry_kind_names[entry->kind]);
+
+        u64 first_sample = c_memory_telemetry_first_sample(entry);
+        for(u64 sample_index = first_sample;
+            sample_index < entry->sample_count;
+            ++sample_index)
+        {
+            memory_telemetry_sample_t *sample = entry->history + (sample_index & (MEMORY_TELEMETRY_HISTORY_COUNT - 1));
+            c_memory_telemetry_append(&writer, "%s\n  {\"frame\":%llu,\"current\":%llu,\"peak\":%llu,\"committed\":%llu,\"reserved\":%llu,\"allocations\":%llu",
+                                      sample_index != first_sample ? "," : "", (unsigned long long)sample->frame_index,
+                                      (unsigned long long)sample->current_bytes, (unsigned long long)sample->peak_bytes,
+                                      (unsigned long long)sample->committed_bytes, (unsigned long long)sample->reserved_bytes,
+                                      (unsigned long long)sample->allocation_count);
+            if(entry->kind == MTK_Zone)
+            {
+                c_memory_telemetry_append(&writer, ",\"free\":%llu,\"free_blocks\":%llu,\"largest_free\":%llu,\"fragmentation\":%.4f,\"tags\":{",
+                                          (unsigned long long)sample->free_bytes, (unsigned long long)sample->free_block_count,
+                                          (unsigned long long)sample->largest_free_block, c_memory_telemetry_get_fragmentation(sample));
+                for(u32 tag_index = 0; tag_index < MTT_Count; ++tag_index)
+                {
+                    c_memory_telemetry_append(&writer, "%s\"%s\":%llu", tag_index ? "," : "", memory_telemetry_tag_names[tag_index], (unsigned long long)sample->tag_bytes[tag_index]);
+                }
+                c_memory_telemetry_append(&writer, "}");
+            }
+            c_memory_telemetry_append(&writer, "}");
+        }
+        c_memory_telemetry_append(&writer, "]}");
+    }
+    c_memory_telemetry_append(&writer, "\n]}\n");
+    c_futex_mutex_unlock(&memory_telemetry.mutex);
+
+    bool8 result = c_memory_telemetry_writer_close(&writer);
+    return(result);
+}
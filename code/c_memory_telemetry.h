@@ -0,0 +1,130 @@
+#if !defined(C_MEMORY_TELEMETRY_H)
+/* ========================================================================
+   $File: c_memory_telemetry.h $
+   $Date: October 19 2026 03:10 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define C_MEMORY_TELEMETRY_H
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_string.h>
+#include <c_futex.h>
+#include <c_memory_arena.h>
+#include <c_zone_allocator.h>
+#include <c_dynarray.h>
+
+/* NOTE(Sleepster): How much of each arena and zone we're actually using, so the reservations can be sized off of
+ * real numbers instead of guesses.
+ *
+ * Arenas and zones are registered by pointer with a name, the registry never owns them. Once a frame
+ * c_memory_telemetry_frame_end() takes a sample of every one of them into its history ring:
+ *   current   - bytes handed out right now (zones count their block headers)
+ *   peak      - the most that was ever handed out at once, exact, the allocators keep it themselves
+ *   committed - bytes ever touched. mmap only commits a page the first time it's written, so this is what the
+ *               reservation really costs in RAM, and the number to size the reservation off of
+ *   reserved  - the address space we asked for
+ * Zones also get walked for fragmentation (free bytes, free block count, largest free block) and the allocated
+ * bytes of every za_allocation_tag_t. Every dynarray is malloc'd, they're one combined 'dynarrays' entry.
+ *
+ * The samples are read without stopping the owner (except a zone's walk, which takes its lock), an arena that
+ * belongs to another thread can be a push or two behind.
+ *
+ * c_memory_telemetry_log() prints the latest sample, the dumps write the whole history (CSV, one row per entry per
+ * frame, or JSON).
+ */
+
+#define MEMORY_TELEMETRY_MAX_ENTRIES    (64)
+#define MEMORY_TELEMETRY_HISTORY_COUNT  (256)
+#define MEMORY_TELEMETRY_NAME_LENGTH    (64)
+
+StaticAssert((MEMORY_TELEMETRY_HISTORY_COUNT & (MEMORY_TELEMETRY_HISTORY_COUNT - 1)) == 0, "Memory telemetry history must be a power of two...\n");
+
+enum memory_telemetry_kind_t
+{
+    MTK_Arena,
+    MTK_Zone,
+    MTK_Dynarrays,
+    MTK_Count
+};
+
+// NOTE(Sleepster): za_allocation_tag_t isn't contiguous, this is where each one lands in the sample.
+enum memory_telemetry_tag_t
+{
+    MTT_None,
+    MTT_Static,
+    MTT_Texture,
+    MTT_Sound,
+    MTT_Font,
+    MTT_Cache,
+    MTT_Other,
+    MTT_Count
+};
+
+struct memory_telemetry_sample_t
+{
+    u64 frame_index;
+    u64 current_bytes;
+    u64 peak_bytes;
+    u64 committed_bytes;
+    u64 reserved_bytes;
+    u64 allocation_count;
+
+    // NOTE(Sleepster): Zones only.
+    u64 free_bytes;
+    u64 free_block_count;
+    u64 largest_free_block;
+    u64 tag_bytes[MTT_Count];
+};
+
+struct memory_telemetry_entry_t
+{
+    char                       name[MEMORY_TELEMETRY_NAME_LENGTH];
+    u32                        kind;
+    void                      *source;
+    memory_telemetry_sample_t *history;
+    u64                        sample_count;
+};
+
+struct memory_telemetry_t
+{
+    futex_mutex_t              mutex;
+    bool8                      is_initialized;
+    u64                        frame_index;
+
+    memory_telemetry_entry_t   entries[MEMORY_TELEMETRY_MAX_ENTRIES];
+    u32                        entry_count;
+};
+
+// NOTE(Sleepster): One entry's latest sample, with what it's called.
+struct memory_telemetry_latest_t
+{
+    char                      name[MEMORY_TELEMETRY_NAME_LENGTH];
+    u32                       kind;
+    memory_telemetry_sample_t sample;
+};
+
+void        c_memory_telemetry_register_arena(const char *name, memory_arena_t *arena);
+void        c_memory_telemetry_register_zone(const char *name, zone_allocator_t *zone);
+void        c_memory_telemetry_unregister(void *source);
+
+// NOTE(Sleepster): Once a frame, from one thread.
+void        c_memory_telemetry_frame_end(void);
+
+// NOTE(Sleepster): 0 is the latest sample. The dynarrays entry's source is &dynarray_memory_stats.
+bool8       c_memory_telemetry_get_sample(void *source, u32 frames_ago, memory_telemetry_sample_t *sample_out);
+bool8       c_memory_telemetry_get_total(u32 frames_ago, memory_telemetry_sample_t *total_out);
+
+// NOTE(Sleepster): Every entry that has a sample, in registration order. Returns how many were written.
+u32         c_memory_telemetry_get_latest(memory_telemetry_latest_t *latest_out, u32 max_count);
+float64     c_memory_telemetry_get_fragmentation(memory_telemetry_sample_t *sample);
+const char* c_memory_telemetry_get_tag_name(u32 tag_index);
+const char* c_memory_telemetry_get_kind_name(u32 kind);
+
+void        c_memory_telemetry_log(void);
+bool8       c_memory_telemetry_dump_csv(string_t filepath);
+bool8       c_memory_telemetry_dump_json(string_t filepath);
+
+#endif // C_MEMORY_TELEMETRY_H
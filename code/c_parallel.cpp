@@ -0,0 +1,224 @@
+/* ========================================================================
+   $File: c_parallel.cpp $
+   $Date: October 18 2026 05:40 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+
+#include <c_threadpool.h>
+#include <c_parallel.h>
+
+struct parallel_job_t
+{
+    volatile u64                next_index;
+    byte                        _padding[CACHE_LINE_SIZE - sizeof(u64)];
+
+    u64                         end;
+    u64                         grain_size;
+    u32                         participant_count;
+
+    parallel_for_callback_t    *for_callback;
+    parallel_reduce_callback_t *reduce_callback;
+    void                       *user_data;
+
+    byte                       *partial_results;
+};
+
+struct parallel_task_payload_t
+{
+    parallel_job_t *job;
+    u32             participant_index;
+};
+
+internal_api bool8
+c_parallel_claim_chunk(parallel_job_t *job, u64 *begin_out, u64 *end_out)
+{
+    bool8 result = false;
+    for(;;)
+    {
+        u64 begin = AtomicLoad64(&job->next_index);
+        if(begin >= job->end) break;
+
+        u64 remaining  = job->end - begin;
+        u64 chunk_size = remaining / ((u64)job->participant_count * 2);
+        if(chunk_size < job->grain_size) chunk_size = job->grain_size;
+        if(chunk_size > remaining)       chunk_size = remaining;
+
+        if((u64)AtomicCompareExchange64(&job->next_index, begin + chunk_size, begin) == begin)
+        {
+            *begin_out = begin;
+            *end_out   = begin + chunk_size;
+            result     = true;
+            break;
+        }
+    }
+
+    return(result);
+}
+
+internal_api void
+c_parallel_run_participant(parallel_job_t *job, u32 participant_index)
+{
+    void *partial_result = null;
+    if(job->partial_results)
+    {
+        partial_result = job->partial_results + (participant_index * PARALLEL_REDUCE_MAX_RESULT_SIZE);
+    }
+
+    u64 chunk_begin;
+    u64 chunk_end;
+    while(c_parallel_claim_chunk(job, &chunk_begin, &chunk_end))
+    {
+        if(job->for_callback) job->for_callback(job->user_data, chunk_begin, chunk_end);
+        else                  job->reduce_callback(job->user_data, chunk_begin, chunk_end, partial_result);
+    }
+}
+
+internal_api void
+c_parallel_task(void *user_data)
+{
+    parallel_task_payload_t *payload = (parallel_task_payload_t*)user_data;
+    c_parallel_run_participant(payload->job, payload->participant_index);
+}
+
+// NOTE(Sleepster): Returns how many participants were used. Participant 0 is always the caller's slot, even when
+//                  it doesn't participate it just never claims anything.
+internal_api u32
+c_parallel_run(threadpool_t *pool, parallel_job_t *job, u64 begin, u32 flags)
+{
+    Assert(job->grain_size > 0);
+
+    u64 range_size  = job->end - begin;
+    u64 chunk_count = (range_size + job->grain_size - 1) / job->grain_size;
+
+    bool8 caller_participates = (flags & PF_CallerParticipates) != 0;
+    u32   helper_limit        = (pool && pool->is_initialized) ? pool->max_threads : 0;
+    if(!caller_participates && helper_limit == 0)
+    {
+        // NOTE(Sleepster): Nobody to hand this to.
+        caller_participates = true;
+    }
+
+    u64 max_participants = helper_limit + (caller_participates ? 1 : 0);
+    if(max_participants > chunk_count)           max_participants = chunk_count;
+    if(max_participants > PARALLEL_MAX_PARTICIPANTS) max_participants = PARALLEL_MAX_PARTICIPANTS;
+
+    job->next_index        = begin;
+    job->participant_count = (u32)max_participants;
+
+    u32 first_helper = caller_participates ? 1 : 0;
+    u32 helper_count = job->participant_count - first_helper;
+    if(helper_count == 0)
+    {
+        c_parallel_run_participant(job, 0);
+    }
+    else
+    {
+        threadpool_task_t tasks[PARALLEL_MAX_PARTICIPANTS];
+        for(u32 helper_index = 0;
+            helper_index < helper_count;
+            ++helper_index)
+        {
+            parallel_task_payload_t payload = {job, first_helper + helper_index};
+            tasks[helper_index] = c_threadpool_make_inline_task(&c_parallel_task, &payload, sizeof(payload));
+        }
+
+        threadpool_counter_t counter = {};
+        c_threadpool_add_tasks(pool, tasks, helper_count, TPTP_High, &counter);
+        if(caller_participates)
+        {
+            c_parallel_run_participant(job, 0);
+        }
+        c_threadpool_wait_for_counter(pool, &counter);
+    }
+
+    return(job->participant_count);
+}
+
+void
+c_parallel_for(threadpool_t            *pool,
+               u64                      begin,
+               u64                      end,
+               u64                      grain_size,
+               parallel_for_callback_t *callback,
+               void                    *user_data,
+               u32                      flags)
+{
+    Assert(callback);
+    if(grain_size == 0) grain_size = 1;
+
+    if(begin < end)
+    {
+        if((end - begin) <= grain_size)
+        {
+            callback(user_data, begin, end);
+        }
+        else
+        {
+            parallel_job_t job = {};
+            job.end          = end;
+            job.grain_size   = grain_size;
+            job.for_callback = callback;
+            job.user_data    = user_data;
+
+            c_parallel_run(pool, &job, begin, flags);
+        }
+    }
+}
+
+void
+c_parallel_reduce(threadpool_t               *pool,
+                  u64                         begin,
+                  u64                         end,
+                  u64                         grain_size,
+                  parallel_reduce_callback_t *callback,
+                  parallel_reduce_combine_t  *combine,
+                  void                       *user_data,
+                  void                       *result,
+                  u32                         result_size,
+                  u32                         flags)
+{
+    Assert(callback);
+    Assert(combine);
+    Assert(result);
+    Assert(result_size <= PARALLEL_REDUCE_MAX_RESULT_SIZE);
+    if(grain_size == 0) grain_size = 1;
+
+    if(begin < end)
+    {
+        if((end - begin) <= grain_size)
+        {
+            callback(user_data, begin, end, result);
+        }
+        else
+        {
+            // NOTE(Sleepster): One cache line per participant so they don't false share while accumulating.
+            alignas(CACHE_LINE_SIZE) byte partial_results[PARALLEL_MAX_PARTICIPANTS * PARALLEL_REDUCE_MAX_RESULT_SIZE];
+            for(u32 participant_index = 0;
+                participant_index < PARALLEL_MAX_PARTICIPANTS;
+                ++participant_index)
+            {
+                MemoryCopy(partial_results + (participant_index * PARALLEL_REDUCE_MAX_RESULT_SIZE), result, result_size);
+            }
+
+            parallel_job_t job = {};
+            job.end             = end;
+            job.grain_size      = grain_size;
+            job.reduce_callback = callback;
+            job.user_data       = user_data;
+            job.partial_results = partial_results;
+
+            // NOTE(Sleepster): Combined in participant order on the caller, the combine doesn't need to be thread safe.
+            u32 participant_count = c_parallel_run(pool, &job, begin, flags);
+            for(u32 participant_index = 0;
+                participant_index < participant_count;
+                ++participant_index)
+            {
+                combine(user_data, result, partial_results + (participant_index * PARALLEL_REDUCE_MAX_RESULT_SIZE));
+            }
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#if !defined(C_PARALLEL_H)
+/* ========================================================================
+   $File: c_parallel.h $
+   $Date: October 18 2026 05:40 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define C_PARALLEL_H
+#include <c_base.h>
+#include <c_types.h>
+
+#include <c_threadpool.h>
+
+/* NOTE(Sleepster): Data parallel helpers on top of the threadpool.
+ *
+ * The range [begin, end) gets handed out in chunks of at least grain_size. Chunks start big and shrink toward the
+ * grain as the range runs out (guided scheduling), so there's very little contention on the shared cursor early on
+ * and everyone still finishes at about the same time.
+ *
+ * With PF_CallerParticipates the calling thread grabs chunks too. Without it the caller just waits on the helpers,
+ * which on a worker means its fiber gets parked and the worker can go run something else.
+ *
+ * Anything that fits in a single grain, or a null/uninitialized pool, just runs inline on the caller.
+ * It's fine to call these from inside of a task.
+ */
+
+#define PARALLEL_MAX_PARTICIPANTS       (THREADPOOL_MAX_WORKERS + 1)
+#define PARALLEL_REDUCE_MAX_RESULT_SIZE (CACHE_LINE_SIZE)
+
+typedef void parallel_for_callback_t(void *user_data, u64 begin, u64 end);
+
+// NOTE(Sleepster): Fold [begin, end) into partial_result. Every participant's partial_result starts as a copy of the
+//                  caller's result, so whatever is in there when you call c_parallel_reduce() has to be the identity.
+typedef void parallel_reduce_callback_t(void *user_data, u64 begin, u64 end, void *partial_result);
+typedef void parallel_reduce_combine_t(void *user_data, void *result, void *partial_result);
+
+enum parallel_flags_t
+{
+    PF_None               = 0,
+    PF_CallerParticipates = 1 << 0,
+};
+
+void c_parallel_for(threadpool_t            *pool,
+                    u64                      begin,
+                    u64                      end,
+                    u64                      grain_size,
+                    parallel_for_callback_t *callback,
+                    void                    *user_data,
+                    u32                      flags = PF_CallerParticipates);
+
+void c_parallel_reduce(threadpool_t               *pool,
+                       u64                         begin,
+                       u64                         end,
+                       u64                         grain_size,
+                       parallel_reduce_callback_t *callback,
+                       parallel_reduce_combine_t  *combine,
+                       void                       *user_data,
+                       void                       *result,
+                       u32                         result_size,
+                       u32                         flags = PF_CallerParticipates);
+
+#endif // C_PARALLEL_H
@@ -0,0 +1,83 @@
+/* ========================================================================
+   $File: c_perf_counters.cpp $
+   $Date: October 19 2026 01:15 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <string.h>
+#include <errno.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_log.h>
+
+#include <c_perf_counters.h>
+#include <p_platform_data.h>
+
+struct perf_counters_thread_t
+{
+    sys_perf_counters_t counters;
+    bool8               is_open;
+    bool8               tried_open;
+
+    // NOTE(Sleepster): Only exists so the counters get closed with the thread.
+    ~perf_counters_thread_t()
+    {
+        if(is_open) sys_perf_counters_close(&counters);
+    }
+};
+
+global_variable thread_local perf_counters_thread_t tl_perf_counters;
+global_variable volatile u32                        perf_counters_reported;
+
+internal_api perf_counters_thread_t*
+c_perf_counters_get_thread(void)
+{
+    perf_counters_thread_t *result = &tl_perf_counters;
+    if(!result->tried_open)
+    {
+        result->tried_open = true;
+        result->is_open    = sys_perf_counters_open(&result->counters);
+
+        // NOTE(Sleepster): Every thread will have the same luck as the first one, no need to hear about it again.
+        s32 open_error = errno;
+        if(AtomicExchange32(&perf_counters_reported, 1) == 0)
+        {
+            if(!result->is_open)
+            {
+                log_info("No hardware perf counters on this machine ('%s'), zones and benchmarks only get timings...\n", strerror(open_error));
+            }
+            else if(result->counters.open_mask != (1 << PERF_COUNTER_COUNT) - 1)
+            {
+                log_info("Only some of the hardware perf counters are available (mask '0x%x')...\n", result->counters.open_mask);
+            }
+        }
+    }
+
+    return(result);
+}
+
+bool8
+c_perf_counters_read(perf_counter_values_t *values)
+{
+    bool8 result = false;
+    ZeroStruct(*values);
+
+    perf_counters_thread_t *thread = c_perf_counters_get_thread();
+    if(thread->is_open && sys_perf_counters_read(&thread->counters, values->values))
+    {
+        values->valid_mask = thread->counters.open_mask;
+        values->owner      = thread;
+        result = true;
+    }
+
+    return(result);
+}
+
+bool8
+c_perf_counters_available(void)
+{
+    bool8 result = c_perf_counters_get_thread()->is_open;
+    return(result);
+}
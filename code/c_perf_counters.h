@@ -0,0 +1,94 @@
+#if !defined(C_PERF_COUNTERS_H)
+/* ========================================================================
+   $File: c_perf_counters.h $
+   $Date: October 19 2026 01:15 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define C_PERF_COUNTERS_H
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <p_platform_data.h>
+
+/* NOTE(Sleepster): Hardware counters per thread, for when the time alone doesn't say whether something is waiting on
+ * memory or actually computing.
+ *
+ * A thread opens its counters the first time it calls c_perf_counters_read() and keeps them until it exits. Reads
+ * are a syscall (~1us), take two around the code you care about and subtract them with c_perf_counters_delta(). For
+ * profiler zones there's PROFILE_SCOPE_COUNTERS("name") which does that and hangs the deltas off the zone's node.
+ *
+ * Nothing here fails loudly. No counters (containers, VMs, perf_event_paranoid, Windows) logs once, then every read
+ * comes back with a valid_mask of 0 and the deltas are empty. A machine that only has some of them gets those.
+ */
+
+#define PERF_COUNTER_COUNT (SPCK_Count)
+
+global_variable const char *perf_counter_names[PERF_COUNTER_COUNT] =
+{
+    "cycles",
+    "instructions",
+    "cache_misses",
+    "branch_misses",
+    "tlb_misses",
+};
+
+struct perf_counter_values_t
+{
+    u64   values[PERF_COUNTER_COUNT];
+    u32   valid_mask;
+
+    // NOTE(Sleepster): The thread the values came from, a fiber can wake up somewhere else between two reads.
+    void *owner;
+};
+
+bool8 c_perf_counters_read(perf_counter_values_t *values);
+bool8 c_perf_counters_available(void);
+
+// NOTE(Sleepster): Returns the mask of the counters that are in both and went forwards, 0 if the two reads came from
+//                  different threads.
+internal_api inline u32
+c_perf_counters_delta(perf_counter_values_t *start, perf_counter_values_t *end, u64 *deltas_out)
+{
+    u32 result = 0;
+    if(start->owner && start->owner == end->owner)
+    {
+        u32 valid_mask = start->valid_mask & end->valid_mask;
+        for(u32 counter_index = 0; counter_index < PERF_COUNTER_COUNT; ++counter_index)
+        {
+            deltas_out[counter_index] = 0;
+            if((valid_mask & (1 << counter_index)) && end->values[counter_index] >= start->values[counter_index])
+            {
+                deltas_out[counter_index] = end->values[counter_index] - start->values[counter_index];
+                result |= 1 << counter_index;
+            }
+        }
+    }
+
+    return(result);
+}
+
+// NOTE(Sleepster): "ipc 1.92, cache_misses 12.5, ..." with everything but ipc divided by 'per', empty for a mask of 0.
+internal_api inline void
+c_perf_counters_format(char *buffer, u32 buffer_size, u64 *counters, u32 counter_mask, float64 per)
+{
+    u32 used = 0;
+    buffer[0] = 0;
+    if((counter_mask & (1 << SPCK_Cycles)) && (counter_mask & (1 << SPCK_Instructions)) && counters[SPCK_Cycles])
+    {
+        used += snprintf(buffer + used, buffer_size - used, "ipc %.2f", (float64)counters[SPCK_Instructions] / (float64)counters[SPCK_Cycles]);
+    }
+
+    for(u32 counter_index = 0; counter_index < PERF_COUNTER_COUNT && used < buffer_size; ++counter_index)
+    {
+        if(counter_mask & (1 << counter_index))
+        {
+            used += snprintf(buffer + used, buffer_size - used, "%s%s %.1f", used ? ", " : "", perf_counter_names[counter_index], (float64)counters[counter_index] / per);
+        }
+    }
+}
+
+#endif // C_PERF_COUNTERS_H
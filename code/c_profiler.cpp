@@ -0,0 +1,605 @@
+/* ========================================================================
+   $File: c_profiler.cpp $
+   $Date: October 18 2026 11:50 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <string.h>
+#include <SDL3/SDL.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_log.h>
+
+#include <c_profiler.h>
+#include <p_platform_data.h>
+
+#if PROFILER_ENABLED
+
+enum profiler_slot_state_t
+{
+    PSS_Free,
+    PSS_Claimed,
+    PSS_Active,
+    PSS_Exited,
+};
+
+// NOTE(Sleepster): The collapse's view of a thread, the zones it has seen begin but not end yet.
+struct profiler_thread_slot_t
+{
+    volatile u32              state;
+    profiler_thread_buffer_t *buffer;
+
+    const char               *open_names[PROFILER_MAX_DEPTH];
+    u64                       open_timestamps[PROFILER_MAX_DEPTH];
+    u32                       open_nodes[PROFILER_MAX_DEPTH];
+    bool8                     open_has_counters[PROFILER_MAX_DEPTH];
+    u32                       open_depth;
+    u32                       overflow_depth;
+    u64                       reported_dropped_zones;
+};
+
+struct profiler_t
+{
+    profiler_thread_slot_t slots[PROFILER_MAX_THREADS];
+    volatile u32           slot_count;
+    volatile u32           registration_failed;
+
+    profiler_frame_t       frames[2];
+    u32                    frame_write_index;
+    profiler_frame_t      *last_frame;
+    u64                    frame_index;
+
+    u64                    last_frame_timestamp;
+    u64                    last_frame_counter;
+    float64                ticks_per_ms;
+
+    profiler_event_sink_t *event_sink;
+    void                  *event_sink_user_data;
+    volatile u32           next_flow_id;
+};
+
+global_variable profiler_t profiler;
+thread_local profiler_thread_buffer_t *tl_profiler_buffer    = null;
+volatile u32                           profiler_trace_active = 0;
+
+/* NOTE(Sleepster): thread_local destructors run when the thread exits, that's the only reason this is an object.
+ * The ring isn't freed here, the collapse might still have events to read out of it. It's marked as exited and the
+ * collapse frees the slot after it drains it.
+ */
+struct profiler_thread_exit_t
+{
+    profiler_thread_slot_t *slot;
+
+    ~profiler_thread_exit_t()
+    {
+        if(slot)
+        {
+            tl_profiler_buffer = null;
+            AtomicStore32(&slot->state, PSS_Exited);
+        }
+    }
+};
+global_variable thread_local profiler_thread_exit_t tl_profiler_thread_exit;
+
+profiler_thread_buffer_t*
+c_profiler_register_thread(void)
+{
+    profiler_thread_buffer_t *result = null;
+    for(u32 slot_index = 0;
+        slot_index < PROFILER_MAX_THREADS;
+        ++slot_index)
+    {
+        profiler_thread_slot_t *slot = profiler.slots + slot_index;
+        if(AtomicLoad32(&slot->state) == PSS_Free &&
+           AtomicCompareExchange32(&slot->state, PSS_Claimed, PSS_Free) == PSS_Free)
+        {
+            if(!slot->buffer)
+            {
+                slot->buffer = (profiler_thread_buffer_t*)sys_allocate_memory(sizeof(profiler_thread_buffer_t));
+                Assert(slot->buffer);
+            }
+
+            result = slot->buffer;
+            ZeroStruct(result->zones);
+            result->write_index       = 0;
+            result->cached_read_index = 0;
+            result->read_index        = 0;
+            result->dropped_zones     = 0;
+            result->dropped_events    = 0;
+            result->thread_id         = (u32)GetThreadID();
+            result->thread_name       = null;
+
+            for(;;)
+            {
+                u32 slot_count = AtomicLoad32(&profiler.slot_count);
+                if(slot_count > slot_index) break;
+                if((u32)AtomicCompareExchange32(&profiler.slot_count, slot_index + 1, slot_count) == slot_count) break;
+            }
+
+            tl_profiler_buffer           = result;
+            tl_profiler_thread_exit.slot = slot;
+            AtomicStore32(&slot->state, PSS_Active);
+            break;
+        }
+    }
+
+    if(!result && AtomicExchange32(&profiler.registration_failed, 1) == 0)
+    {
+        log_warning("Profiler is out of thread rings ('%u'), threads past this point are not profiled...\n", PROFILER_MAX_THREADS);
+    }
+
+    return(result);
+}
+
+void
+c_profiler_set_thread_name(const char *name)
+{
+    profiler_thread_buffer_t *buffer = tl_profiler_buffer;
+    if(!buffer) buffer = c_profiler_register_thread();
+    if(buffer)
+    {
+        AtomicStore64(&buffer->thread_name, (s64)(usize)name);
+    }
+}
+
+/*===========================================
+  ================ FIBERS ===================
+  ===========================================*/
+
+// NOTE(Sleepster): NO_INLINE for the same reason as c_threadpool_get_current_worker(), these run on both sides of a
+//                  fiber switch and the thread_local has to be looked up again on the other side.
+NO_INLINE void
+c_profiler_fiber_leave(profiler_zone_stack_t *saved_zones)
+{
+    saved_zones->depth          = 0;
+    saved_zones->overflow_depth = 0;
+
+    profiler_thread_buffer_t *buffer = tl_profiler_buffer;
+    if(buffer)
+    {
+        profiler_zone_stack_t *zones = &buffer->zones;
+        saved_zones->depth          = zones->depth;
+        saved_zones->overflow_depth = zones->overflow_depth;
+        memcpy(saved_zones->names, zones->names, sizeof(const char*) * zones->depth);
+
+        zones->overflow_depth = 0;
+        while(zones->depth)
+        {
+            c_profiler_end();
+        }
+    }
+}
+
+NO_INLINE void
+c_profiler_fiber_enter(profiler_zone_stack_t *saved_zones)
+{
+    for(u32 zone_index = 0;
+        zone_index < saved_zones->depth;
+        ++zone_index)
+    {
+        c_profiler_begin(saved_zones->names[zone_index]);
+    }
+
+    profiler_thread_buffer_t *buffer = tl_profiler_buffer;
+    if(buffer)
+    {
+        buffer->zones.overflow_depth += saved_zones->overflow_depth;
+    }
+
+    saved_zones->depth          = 0;
+    saved_zones->overflow_depth = 0;
+}
+
+/*===========================================
+  ================ COLLAPSE =================
+  ===========================================*/
+
+internal_api u32
+c_profiler_add_node(profiler_frame_t *frame, u32 parent, const char *name)
+{
+    u32 result = PROFILER_INVALID_NODE;
+    if(frame->node_count < PROFILER_MAX_FRAME_NODES)
+    {
+        result = frame->node_count++;
+
+        profiler_node_t *node = frame->nodes + result;
+        ZeroStruct(*node);
+        node->name         = name;
+        node->parent       = parent;
+        node->first_child  = PROFILER_INVALID_NODE;
+        node->last_child   = PROFILER_INVALID_NODE;
+        node->next_sibling = PROFILER_INVALID_NODE;
+
+        if(parent != PROFILER_INVALID_NODE)
+        {
+            profiler_node_t *parent_node = frame->nodes + parent;
+            node->depth = parent_node->depth + 1;
+            if(parent_node->last_child == PROFILER_INVALID_NODE) parent_node->first_child = result;
+            else                                                 frame->nodes[parent_node->last_child].next_sibling = result;
+            parent_node->last_child = result;
+        }
+    }
+    else
+    {
+        ++frame->dropped_nodes;
+    }
+
+    return(result);
+}
+
+u32
+c_profiler_find_child(profiler_frame_t *frame, u32 parent, const char *name)
+{
+    u32 result = PROFILER_INVALID_NODE;
+    if(parent != PROFILER_INVALID_NODE)
+    {
+        for(u32 child = frame->nodes[parent].first_child;
+            child != PROFILER_INVALID_NODE;
+            child = frame->nodes[child].next_sibling)
+        {
+            // NOTE(Sleepster): The same literal in two translation units isn't always the same pointer.
+            const char *child_name = frame->nodes[child].name;
+            if(child_name == name || strcmp(child_name, name) == 0)
+            {
+                result = child;
+                break;
+            }
+        }
+    }
+
+    return(result);
+}
+
+internal_api u32
+c_profiler_get_child(profiler_frame_t *frame, u32 parent, const char *name)
+{
+    u32 result = c_profiler_find_child(frame, parent, name);
+    if(result == PROFILER_INVALID_NODE && parent != PROFILER_INVALID_NODE)
+    {
+        result = c_profiler_add_node(frame, parent, name);
+    }
+
+    return(result);
+}
+
+internal_api void
+c_profiler_collapse_thread(profiler_frame_t *frame, profiler_thread_slot_t *slot)
+{
+    profiler_thread_buffer_t *buffer = slot->buffer;
+
+    const char *thread_name = (const char*)(usize)AtomicLoad64(&buffer->thread_name);
+    u32 root = c_profiler_add_node(frame, PROFILER_INVALID_NODE, thread_name ? thread_name : "thread");
+    if(root == PROFILER_INVALID_NODE) return;
+
+    frame->thread_roots[frame->thread_count] = root;
+    frame->thread_ids[frame->thread_count]   = buffer->thread_id;
+    ++frame->thread_count;
+
+    // NOTE(Sleepster): Zones that were still open at the end of last frame get their nodes back in this one.
+    for(u32 depth = 0;
+        depth < slot->open_depth;
+        ++depth)
+    {
+        u32 parent = depth ? slot->open_nodes[depth - 1] : root;
+        slot->open_nodes[depth] = c_profiler_get_child(frame, parent, slot->open_names[depth]);
+    }
+
+    u64 write_index = AtomicLoad64(&buffer->write_index);
+    for(u64 event_index = buffer->read_index;
+        event_index < write_index;
+        ++event_index)
+    {
+        profiler_event_t *event     = buffer->events + (event_index & (PROFILER_RING_EVENT_COUNT - 1));
+        u32               kind      = (u32)(event->timestamp >> PROFILER_EVENT_KIND_SHIFT);
+        u64               timestamp = event->timestamp & PROFILER_EVENT_TIMESTAMP_MASK;
+        if(kind == PEK_Begin)
+        {
+            if(slot->open_depth == PROFILER_MAX_DEPTH)
+            {
+                ++slot->overflow_depth;
+                continue;
+            }
+
+            // NOTE(Sleepster): Once a zone runs out of nodes everything under it is only counted as dropped.
+            u32 depth  = slot->open_depth++;
+            u32 parent = depth ? slot->open_nodes[depth - 1] : root;
+            slot->open_names[depth]        = event->name;
+            slot->open_timestamps[depth]   = timestamp;
+            slot->open_nodes[depth]        = c_profiler_get_child(frame, parent, event->name);
+            slot->open_has_counters[depth] = false;
+        }
+        else if(kind == PEK_End)
+        {
+            if(slot->overflow_depth)
+            {
+                --slot->overflow_depth;
+                continue;
+            }
+            if(slot->open_depth == 0) continue;
+
+            u32 depth = --slot->open_depth;
+            u64 ticks = timestamp - slot->open_timestamps[depth];
+            u32 node  = slot->open_nodes[depth];
+            if(node != PROFILER_INVALID_NODE)
+            {
+                frame->nodes[node].total_ticks   += ticks;
+                frame->nodes[node].call_count    += 1;
+                frame->nodes[node].counter_calls += slot->open_has_counters[depth];
+
+                u32 parent = depth ? slot->open_nodes[depth - 1] : root;
+                frame->nodes[parent].child_ticks += ticks;
+                if(parent == root) frame->nodes[root].total_ticks += ticks;
+            }
+        }
+        else if(kind == PEK_ZoneCounter)
+        {
+            u64 delta = buffer->events[(event_index + 1) & (PROFILER_RING_EVENT_COUNT - 1)].timestamp;
+            ++event_index;
+            if(slot->overflow_depth || slot->open_depth == 0) continue;
+
+            u32 depth = slot->open_depth - 1;
+            u32 node  = slot->open_nodes[depth];
+            if(node == PROFILER_INVALID_NODE) continue;
+
+            // NOTE(Sleepster): Same as the zone names, the table in another translation unit is another pointer.
+            for(u32 counter_index = 0; counter_index < PERF_COUNTER_COUNT; ++counter_index)
+            {
+                if(event->name == perf_counter_names[counter_index] || strcmp(event->name, perf_counter_names[counter_index]) == 0)
+                {
+                    frame->nodes[node].counters[counter_index] += delta;
+                    frame->nodes[node].counter_mask            |= 1 << counter_index;
+                    slot->open_has_counters[depth]              = true;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            // NOTE(Sleepster): Trace only, skip the value too.
+            ++event_index;
+        }
+    }
+
+    if(profiler.event_sink)
+    {
+        profiler.event_sink(profiler.event_sink_user_data, buffer, buffer->read_index, write_index);
+    }
+    AtomicStore64(&buffer->read_index, write_index);
+
+    u64 dropped_zones = AtomicLoad64(&buffer->dropped_zones);
+    frame->nodes[root].call_count = 1;
+    frame->dropped_zones         += dropped_zones - slot->reported_dropped_zones;
+    slot->reported_dropped_zones  = dropped_zones;
+}
+
+// NOTE(Sleepster): rdtsc doesn't tell us its frequency, measure it against the performance counter. Only the first
+//                  time, after that every frame end measures it again over the whole frame.
+internal_api void
+c_profiler_calibrate(void)
+{
+    u64 frequency         = SDL_GetPerformanceFrequency();
+    u64 start_timestamp   = rdtsc();
+    u64 start_counter     = SDL_GetPerformanceCounter();
+    u64 current_counter   = start_counter;
+    while(current_counter - start_counter < frequency / 1000)
+    {
+        _mm_pause();
+        current_counter = SDL_GetPerformanceCounter();
+    }
+    u64 current_timestamp = rdtsc();
+
+    profiler.last_frame_timestamp = current_timestamp;
+    profiler.last_frame_counter   = current_counter;
+    profiler.ticks_per_ms         = (float64)(current_timestamp - start_timestamp) / (((float64)(current_counter - start_counter) * 1000.0) / (float64)frequency);
+}
+
+float64
+c_profiler_get_ticks_per_ms(void)
+{
+    if(profiler.last_frame_counter == 0) c_profiler_calibrate();
+
+    float64 result = profiler.ticks_per_ms;
+    return(result);
+}
+
+void
+c_profiler_set_event_sink(profiler_event_sink_t *sink, void *user_data)
+{
+    profiler.event_sink           = sink;
+    profiler.event_sink_user_data = user_data;
+    AtomicStore32(&profiler_trace_active, sink != null);
+}
+
+u32
+c_profiler_trace_flow_begin_new(const char *name)
+{
+    u32 result = 0;
+    if(profiler_trace_active)
+    {
+        do
+        {
+            result = (u32)AtomicIncrement32(&profiler.next_flow_id) + 1;
+        } while(result == 0);
+
+        c_profiler_trace_event(PEK_FlowBegin, name, result);
+    }
+
+    return(result);
+}
+
+void
+c_profiler_zone_counters(perf_counter_values_t *start_values, perf_counter_values_t *end_values)
+{
+    profiler_thread_buffer_t *buffer = tl_profiler_buffer;
+    if(!buffer) return;
+
+    u64 deltas[PERF_COUNTER_COUNT];
+    u32 counter_mask = c_perf_counters_delta(start_values, end_values, deltas);
+
+    profiler_zone_stack_t *zones = &buffer->zones;
+    if(!counter_mask || zones->overflow_depth || zones->depth == 0 || !zones->is_recorded[zones->depth - 1]) return;
+
+    u32 counter_count = 0;
+    for(u32 counter_index = 0; counter_index < PERF_COUNTER_COUNT; ++counter_index)
+    {
+        counter_count += (counter_mask >> counter_index) & 1;
+    }
+
+    // NOTE(Sleepster): The zone's own end is already in recorded_count, same rule as the trace events.
+    if(!c_profiler_ring_has_room(buffer, zones->recorded_count + (2 * counter_count)))
+    {
+        AtomicStore64(&buffer->dropped_events, buffer->dropped_events + 1);
+        return;
+    }
+
+    u64 timestamp   = rdtsc() | ((u64)PEK_ZoneCounter << PROFILER_EVENT_KIND_SHIFT);
+    u64 write_index = buffer->write_index;
+    for(u32 counter_index = 0; counter_index < PERF_COUNTER_COUNT; ++counter_index)
+    {
+        if(!(counter_mask & (1 << counter_index))) continue;
+
+        profiler_event_t *event   = buffer->events + (write_index++ & (PROFILER_RING_EVENT_COUNT - 1));
+        profiler_event_t *payload = buffer->events + (write_index++ & (PROFILER_RING_EVENT_COUNT - 1));
+        event->timestamp   = timestamp;
+        event->name        = perf_counter_names[counter_index];
+        payload->timestamp = deltas[counter_index];
+        payload->name      = null;
+    }
+
+    AtomicStore64(&buffer->write_index, write_index);
+}
+
+profiler_frame_t*
+c_profiler_frame_end(void)
+{
+    if(profiler.last_frame_counter == 0) c_profiler_calibrate();
+
+    u64 frame_timestamp = rdtsc();
+    u64 frame_counter   = SDL_GetPerformanceCounter();
+    u64 frequency       = SDL_GetPerformanceFrequency();
+
+    profiler_frame_t *frame = profiler.frames + profiler.frame_write_index;
+    profiler.frame_write_index ^= 1;
+
+    float64 elapsed_ms  = ((float64)(frame_counter - profiler.last_frame_counter) * 1000.0) / (float64)frequency;
+    u64     elapsed_tsc = frame_timestamp - profiler.last_frame_timestamp;
+    frame->frame_index   = profiler.frame_index++;
+    frame->ticks_per_ms  = elapsed_ms > 0.0 ? (float64)elapsed_tsc / elapsed_ms : profiler.ticks_per_ms;
+    frame->frame_ms      = elapsed_ms;
+    frame->node_count    = 0;
+    frame->thread_count  = 0;
+    frame->dropped_zones = 0;
+    frame->dropped_nodes = 0;
+
+    profiler.last_frame_timestamp = frame_timestamp;
+    profiler.last_frame_counter   = frame_counter;
+    profiler.ticks_per_ms         = frame->ticks_per_ms;
+
+    u32 slot_count = AtomicLoad32(&profiler.slot_count);
+    for(u32 slot_index = 0;
+        slot_index < slot_count;
+        ++slot_index)
+    {
+        profiler_thread_slot_t *slot = profiler.slots + slot_index;
+
+        u32 state = AtomicLoad32(&slot->state);
+        if(state == PSS_Active || state == PSS_Exited)
+        {
+            c_profiler_collapse_thread(frame, slot);
+
+            // NOTE(Sleepster): The thread is gone and its ring is empty now, somebody else can have it.
+            if(state == PSS_Exited)
+            {
+                slot->open_depth             = 0;
+                slot->overflow_depth         = 0;
+                slot->reported_dropped_zones = 0;
+                AtomicStore32(&slot->state, PSS_Free);
+            }
+        }
+    }
+
+    profiler.last_frame = frame;
+    return(frame);
+}
+
+profiler_frame_t*
+c_profiler_get_last_frame(void)
+{
+    profiler_frame_t *result = profiler.last_frame;
+    return(result);
+}
+
+float64
+c_profiler_node_total_ms(profiler_frame_t *frame, u32 node_index)
+{
+    float64 result = (float64)frame->nodes[node_index].total_ticks / frame->ticks_per_ms;
+    return(result);
+}
+
+float64
+c_profiler_node_self_ms(profiler_frame_t *frame, u32 node_index)
+{
+    profiler_node_t *node = frame->nodes + node_index;
+
+    // NOTE(Sleepster): Children that started last frame can add up to more than the node did this frame.
+    u64 self_ticks = node->total_ticks > node->child_ticks ? node->total_ticks - node->child_ticks : 0;
+    float64 result = (float64)self_ticks / frame->ticks_per_ms;
+    return(result);
+}
+
+void
+c_profiler_log_frame(profiler_frame_t *frame)
+{
+    if(!frame) return;
+
+    log_info("Profiler frame '%llu': '%.3f' ms, '%u' threads, '%llu' zones dropped, '%llu' nodes dropped...\n",
+             (unsigned long long)frame->frame_index, frame->frame_ms, frame->thread_count,
+             (unsigned long long)frame->dropped_zones, (unsigned long long)frame->dropped_nodes);
+
+    // NOTE(Sleepster): Nodes are added parents first and children in order, so walking the array is a pre-order walk
+    //                  of each thread's tree, only the threads come out interleaved. Walk it per root instead.
+    for(u32 thread_index = 0;
+        thread_index < frame->thread_count;
+        ++thread_index)
+    {
+        u32 root = frame->thread_roots[thread_index];
+        log_info("    %s (%u): total %8.3f ms\n", frame->nodes[root].name, frame->thread_ids[thread_index], c_profiler_node_total_ms(frame, root));
+
+        u32 node_index = frame->nodes[root].first_child;
+        while(node_index != PROFILER_INVALID_NODE)
+        {
+            profiler_node_t *node = frame->nodes + node_index;
+            if(node->call_count)
+            {
+                log_info("    %*s%-*s total %8.3f, self %8.3f ms, calls %u\n",
+                         (int)node->depth * 2, "", Max(40 - (int)node->depth * 2, 1), node->name,
+                         c_profiler_node_total_ms(frame, node_index), c_profiler_node_self_ms(frame, node_index), node->call_count);
+                if(node->counter_calls)
+                {
+                    char counters[256];
+                    c_perf_counters_format(counters, sizeof(counters), node->counters, node->counter_mask, (float64)node->counter_calls);
+                    log_info("    %*s  per call: %s\n", (int)node->depth * 2, "", counters);
+                }
+            }
+
+            // NOTE(Sleepster): Depth first, children, then siblings, then back up to the parent's sibling.
+            if(node->first_child != PROFILER_INVALID_NODE)
+            {
+                node_index = node->first_child;
+            }
+            else
+            {
+                while(node_index != root && frame->nodes[node_index].next_sibling == PROFILER_INVALID_NODE)
+                {
+                    node_index = frame->nodes[node_index].parent;
+                }
+                node_index = node_index == root ? PROFILER_INVALID_NODE : frame->nodes[node_index].next_sibling;
+            }
+        }
+    }
+}
+
+#endif // PROFILER_ENABLED
@@ -0,0 +1,370 @@
+#if !defined(C_PROFILER_H)
+/* ========================================================================
+   $File: c_profiler.h $
+   $Date: October 18 2026 11:50 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define C_PROFILER_H
+#include <string.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_perf_counters.h>
+
+/* NOTE(Sleepster): Hierarchical frame profiler.
+ *
+ * PROFILE_SCOPE("name") records an rdtsc timestamp when it's opened and another when it goes out of scope. Every
+ * thread writes into its own ring of events, nothing is shared with the other threads so there are no locks and no
+ * atomics on the hot path, the only store anybody else looks at is the ring's write index. The ring is registered
+ * the first time a thread opens a zone and handed back when the thread exits.
+ *
+ * Once a frame c_profiler_frame_end() (main thread) drains every ring and collapses the events into a call tree, one
+ * root per thread. Zones with the same name under the same parent are merged, each node has a call count, a total
+ * time and a self time (total minus the children). A zone counts towards the frame it ENDS in, so anything left open
+ * at the frame boundary is carried over to the next one.
+ *
+ * Names are never copied, use string literals or something else that lives forever.
+ *
+ * A full ring drops whole zones, a begin is only written if there's room left for its end and the end of every
+ * zone that's still open, so the tree never has half a zone in it. Dropped zones are counted in the frame.
+ *
+ * Fibers: a threadpool task can wait on a counter and come back on another thread. The pool calls
+ * PROFILE_FIBER_LEAVE/ENTER around the switch, that closes the fiber's open zones on the old thread and opens them
+ * again on the new one. A zone that waited shows up as two calls.
+ *
+ * Traces: the rings are also where c_trace gets its timeline from. While a sink is attached (only during a capture)
+ * TRACE_COUNTER and the TRACE_FLOW_* macros write counter and flow events into the same ring, they take two slots,
+ * the event and its value. With no sink attached they cost one load and a branch. The collapse skips them.
+ *
+ * Hardware counters: PROFILE_SCOPE_COUNTERS("name") is a PROFILE_SCOPE that also reads the thread's perf counters
+ * (c_perf_counters.h) on the way in and out. The deltas go into the ring right before the zone's end, one two slot
+ * PEK_ZoneCounter per counter, and the collapse adds them to the zone's node. Two syscalls a zone, so keep it to the
+ * zones that are worth it. Without counters it's a PROFILE_SCOPE and a failed read.
+ *
+ * Compiled out completely unless PROFILER_ENABLED is 1 (the makefile turns it on, PROFILER_ENABLED=0 to turn it off).
+ * Only ever use the macros outside of this file.
+ */
+
+#if !defined(PROFILER_ENABLED)
+    #define PROFILER_ENABLED 0
+#endif
+
+#if PROFILER_ENABLED
+
+// NOTE(Sleepster): The ring capacity MUST be a power of two, we mask instead of mod.
+#define PROFILER_RING_EVENT_COUNT  (16384)
+#define PROFILER_MAX_THREADS       (64)
+#define PROFILER_MAX_DEPTH         (64)
+#define PROFILER_MAX_FRAME_NODES   (1024)
+#define PROFILER_INVALID_NODE      (0xFFFFFFFF)
+
+StaticAssert((PROFILER_RING_EVENT_COUNT & (PROFILER_RING_EVENT_COUNT - 1)) == 0, "Profiler ring size must be a power of two...\n");
+
+// NOTE(Sleepster): The kind lives in the top bits of the timestamp, rdtsc won't get there for a few decades.
+#define PROFILER_EVENT_KIND_SHIFT       (60)
+#define PROFILER_EVENT_TIMESTAMP_MASK   ((1ULL << PROFILER_EVENT_KIND_SHIFT) - 1)
+
+enum profiler_event_kind_t
+{
+    PEK_Begin,
+    PEK_End,        // NOTE(Sleepster): Ends the last zone opened on the thread, no name.
+
+    // NOTE(Sleepster): These are followed by a second event that only holds the value in its timestamp.
+    PEK_Counter,    // NOTE(Sleepster): float64 bits
+    PEK_FlowBegin,  // NOTE(Sleepster): flow id
+    PEK_FlowStep,
+    PEK_FlowEnd,
+    PEK_ZoneCounter,  // NOTE(Sleepster): The delta, the name is the counter's. Goes to the innermost open zone.
+};
+
+struct profiler_event_t
+{
+    u64         timestamp;
+    const char *name;
+};
+
+struct profiler_zone_stack_t
+{
+    const char *names[PROFILER_MAX_DEPTH];
+    bool8       is_recorded[PROFILER_MAX_DEPTH];
+    u32         depth;
+    u32         recorded_count;
+    u32         overflow_depth;
+};
+
+struct profiler_thread_buffer_t
+{
+    // NOTE(Sleepster): Owner thread only, except for the write index and the stats which the collapse reads.
+    profiler_zone_stack_t zones;
+    volatile u64          write_index;
+    u64                   cached_read_index;
+    volatile u64          dropped_zones;
+    volatile u64          dropped_events;
+    u32                   thread_id;
+    const char           *thread_name;
+    byte                  _padding0[CACHE_LINE_SIZE];
+
+    // NOTE(Sleepster): Collapse only.
+    volatile u64          read_index;
+    byte                  _padding1[CACHE_LINE_SIZE];
+
+    profiler_event_t      events[PROFILER_RING_EVENT_COUNT];
+};
+
+struct profiler_node_t
+{
+    const char *name;
+    u32         parent;
+    u32         first_child;
+    u32         last_child;
+    u32         next_sibling;
+    u32         depth;
+
+    u32         call_count;
+    u64         total_ticks;
+    u64         child_ticks;
+
+    // NOTE(Sleepster): Only PROFILE_SCOPE_COUNTERS zones, summed over every call that had counters.
+    u32         counter_mask;
+    u32         counter_calls;
+    u64         counters[PERF_COUNTER_COUNT];
+};
+
+struct profiler_frame_t
+{
+    u64             frame_index;
+    float64         ticks_per_ms;
+    float64         frame_ms;
+
+    profiler_node_t nodes[PROFILER_MAX_FRAME_NODES];
+    u32             node_count;
+
+    // NOTE(Sleepster): Root node of every thread that had a ring this frame, the root's total is its zones combined.
+    u32             thread_roots[PROFILER_MAX_THREADS];
+    u32             thread_ids[PROFILER_MAX_THREADS];
+    u32             thread_count;
+
+    u64             dropped_zones;
+    u64             dropped_nodes;
+};
+
+// NOTE(Sleepster): Called from the collapse with each thread's new events, [first_event, last_event) in the ring.
+typedef void profiler_event_sink_t(void *user_data, profiler_thread_buffer_t *buffer, u64 first_event, u64 last_event);
+
+extern thread_local profiler_thread_buffer_t *tl_profiler_buffer;
+extern volatile u32                           profiler_trace_active;
+
+profiler_thread_buffer_t* c_profiler_register_thread(void);
+void                      c_profiler_set_thread_name(const char *name);
+void                      c_profiler_fiber_leave(profiler_zone_stack_t *saved_zones);
+void                      c_profiler_fiber_enter(profiler_zone_stack_t *saved_zones);
+
+// NOTE(Sleepster): Main thread, once a frame. The returned frame stays valid until the next call.
+profiler_frame_t*         c_profiler_frame_end(void);
+void                      c_profiler_set_event_sink(profiler_event_sink_t *sink, void *user_data);
+float64                   c_profiler_get_ticks_per_ms(void);
+profiler_frame_t*         c_profiler_get_last_frame(void);
+void                      c_profiler_log_frame(profiler_frame_t *frame);
+
+u32                       c_profiler_find_child(profiler_frame_t *frame, u32 parent, const char *name);
+float64                   c_profiler_node_total_ms(profiler_frame_t *frame, u32 node_index);
+float64                   c_profiler_node_self_ms(profiler_frame_t *frame, u32 node_index);
+
+/*===========================================
+  ================ HOT PATH =================
+  ===========================================*/
+
+// NOTE(Sleepster): OWNER ONLY. True if the ring has room for 'event_count' more events.
+internal_api true_inline inline bool8
+c_profiler_ring_has_room(profiler_thread_buffer_t *buffer, u64 event_count)
+{
+    bool8 result = (buffer->write_index + event_count - buffer->cached_read_index) <= PROFILER_RING_EVENT_COUNT;
+    if(!result)
+    {
+        buffer->cached_read_index = AtomicLoad64(&buffer->read_index);
+        result = (buffer->write_index + event_count - buffer->cached_read_index) <= PROFILER_RING_EVENT_COUNT;
+    }
+
+    return(result);
+}
+
+internal_api true_inline inline void
+c_profiler_ring_push(profiler_thread_buffer_t *buffer, u32 kind, const char *name, u64 timestamp)
+{
+    u64               write_index = buffer->write_index;
+    profiler_event_t *event       = buffer->events + (write_index & (PROFILER_RING_EVENT_COUNT - 1));
+    event->timestamp = timestamp | ((u64)kind << PROFILER_EVENT_KIND_SHIFT);
+    event->name      = name;
+
+    AtomicStore64(&buffer->write_index, write_index + 1);
+}
+
+internal_api true_inline inline void
+c_profiler_begin(const char *name)
+{
+    profiler_thread_buffer_t *buffer = tl_profiler_buffer;
+    if(!buffer)
+    {
+        buffer = c_profiler_register_thread();
+        if(!buffer) return;
+    }
+
+    profiler_zone_stack_t *zones = &buffer->zones;
+    if(zones->depth == PROFILER_MAX_DEPTH)
+    {
+        ++zones->overflow_depth;
+        return;
+    }
+
+    // NOTE(Sleepster): Room for this begin, its end, and the end of everything already open.
+    bool8 is_recorded = c_profiler_ring_has_room(buffer, zones->recorded_count + 2);
+    zones->names[zones->depth]       = name;
+    zones->is_recorded[zones->depth] = is_recorded;
+    ++zones->depth;
+
+    if(is_recorded)
+    {
+        ++zones->recorded_count;
+        c_profiler_ring_push(buffer, PEK_Begin, name, rdtsc());
+    }
+    else
+    {
+        AtomicStore64(&buffer->dropped_zones, buffer->dropped_zones + 1);
+    }
+}
+
+internal_api true_inline inline void
+c_profiler_end(void)
+{
+    u64 timestamp = rdtsc();
+
+    profiler_thread_buffer_t *buffer = tl_profiler_buffer;
+    if(!buffer) return;
+
+    profiler_zone_stack_t *zones = &buffer->zones;
+    if(zones->overflow_depth)
+    {
+        --zones->overflow_depth;
+        return;
+    }
+
+    Assert(zones->depth > 0);
+    --zones->depth;
+    if(zones->is_recorded[zones->depth])
+    {
+        --zones->recorded_count;
+        c_profiler_ring_push(buffer, PEK_End, null, timestamp);
+    }
+}
+
+// NOTE(Sleepster): Counters and flows, both halves are published with one store so the collapse never sees just one.
+internal_api inline void
+c_profiler_trace_event(u32 kind, const char *name, u64 value)
+{
+    if(!profiler_trace_active) return;
+
+    profiler_thread_buffer_t *buffer = tl_profiler_buffer;
+    if(!buffer)
+    {
+        buffer = c_profiler_register_thread();
+        if(!buffer) return;
+    }
+
+    if(!c_profiler_ring_has_room(buffer, buffer->zones.recorded_count + 2))
+    {
+        AtomicStore64(&buffer->dropped_events, buffer->dropped_events + 1);
+        return;
+    }
+
+    u64               write_index = buffer->write_index;
+    profiler_event_t *event       = buffer->events + (write_index       & (PROFILER_RING_EVENT_COUNT - 1));
+    profiler_event_t *payload     = buffer->events + ((write_index + 1) & (PROFILER_RING_EVENT_COUNT - 1));
+    event->timestamp   = rdtsc() | ((u64)kind << PROFILER_EVENT_KIND_SHIFT);
+    event->name        = name;
+    payload->timestamp = value;
+    payload->name      = null;
+
+    AtomicStore64(&buffer->write_index, write_index + 2);
+}
+
+internal_api inline void
+c_profiler_trace_counter(const char *name, float64 value)
+{
+    u64 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    c_profiler_trace_event(PEK_Counter, name, bits);
+}
+
+// NOTE(Sleepster): 0 when nobody is tracing, so the other end knows not to bother.
+u32 c_profiler_trace_flow_begin_new(const char *name);
+
+// NOTE(Sleepster): Has to come right before the zone's c_profiler_end(), the deltas belong to the innermost zone.
+void c_profiler_zone_counters(perf_counter_values_t *start_values, perf_counter_values_t *end_values);
+
+struct profiler_scope_t
+{
+    true_inline profiler_scope_t(const char *name) { c_profiler_begin(name); }
+    true_inline ~profiler_scope_t()                { c_profiler_end();       }
+};
+
+struct profiler_counter_scope_t
+{
+    perf_counter_values_t start_values;
+
+    profiler_counter_scope_t(const char *name)
+    {
+        c_profiler_begin(name);
+        c_perf_counters_read(&start_values);
+    }
+
+    ~profiler_counter_scope_t()
+    {
+        perf_counter_values_t end_values;
+        c_perf_counters_read(&end_values);
+        c_profiler_zone_counters(&start_values, &end_values);
+        c_profiler_end();
+    }
+};
+
+#define PROFILE_SCOPE(name)               profiler_scope_t Glue(profiler_scope_, __LINE__)(name)
+#define PROFILE_FUNCTION()                PROFILE_SCOPE(__FUNCTION__)
+#define PROFILE_SCOPE_COUNTERS(name)      profiler_counter_scope_t Glue(profiler_counter_scope_, __LINE__)(name)
+#define PROFILE_BEGIN(name)               c_profiler_begin(name)
+#define PROFILE_END()                     c_profiler_end()
+#define PROFILE_SET_THREAD_NAME(name)     c_profiler_set_thread_name(name)
+#define PROFILE_FIBER_LEAVE(saved_zones)  c_profiler_fiber_leave(saved_zones)
+#define PROFILE_FIBER_ENTER(saved_zones)  c_profiler_fiber_enter(saved_zones)
+#define PROFILE_FRAME_END()               c_profiler_frame_end()
+#define PROFILE_LOG_FRAME()               c_profiler_log_frame(c_profiler_get_last_frame())
+
+#define TRACE_COUNTER(name, value)        c_profiler_trace_counter(name, (float64)(value))
+#define TRACE_FLOW_BEGIN(name, id)        c_profiler_trace_event(PEK_FlowBegin, name, (u64)(id))
+#define TRACE_FLOW_STEP(name, id)         c_profiler_trace_event(PEK_FlowStep,  name, (u64)(id))
+#define TRACE_FLOW_END(name, id)          c_profiler_trace_event(PEK_FlowEnd,   name, (u64)(id))
+#define TRACE_FLOW_BEGIN_NEW(name)        c_profiler_trace_flow_begin_new(name)
+
+#else
+
+#define PROFILE_SCOPE(name)
+#define PROFILE_FUNCTION()
+#define PROFILE_SCOPE_COUNTERS(name)
+#define PROFILE_BEGIN(name)
+#define PROFILE_END()
+#define PROFILE_SET_THREAD_NAME(name)
+#define PROFILE_FIBER_LEAVE(saved_zones)
+#define PROFILE_FIBER_ENTER(saved_zones)
+#define PROFILE_FRAME_END()
+#define PROFILE_LOG_FRAME()
+
+#define TRACE_COUNTER(name, value)
+#define TRACE_FLOW_BEGIN(name, id)
+#define TRACE_FLOW_STEP(name, id)
+#define TRACE_FLOW_END(name, id)
+#define TRACE_FLOW_BEGIN_NEW(name)        (0)
+
+#endif // PROFILER_ENABLED
+
+#endif // C_PROFILER_H
@@ -0,0 +1,218 @@
+/* ========================================================================
+   $File: c_queue.cpp $
+   $Date: October 18 2026 09:20 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <string.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_log.h>
+
+#include <c_queue.h>
+#include <p_platform_data.h>
+
+#define QUEUE_CELL_HEADER_SIZE (sizeof(u64))
+
+internal_api inline byte*
+c_queue_get_cell(queue_t *queue, u64 position)
+{
+    byte *result = queue->cells + ((position & queue->mask) * queue->cell_size);
+    return(result);
+}
+
+internal_api inline u64
+c_queue_get_sequence(byte *cell)
+{
+    u64 result = (u64)AtomicLoad64((volatile u64*)cell);
+    return(result);
+}
+
+/* NOTE(Sleepster): Claims up to max_count consecutive cells starting at *position. A cell is ready for us when its
+ * sequence is position + ready_offset (0 for producers, 1 for consumers). Shared sides race for the claim with a
+ * CAS, the single side is the only one that ever writes its position so it just stores it.
+ */
+internal_api u32
+c_queue_claim(queue_t      *queue,
+              volatile u64 *position,
+              bool8         is_shared,
+              u64           ready_offset,
+              u32           max_count,
+              u64          *first_position_out)
+{
+    u32 result = 0;
+    for(;;)
+    {
+        u64 first_position = (u64)AtomicLoad64(position);
+        s64 difference     = (s64)(c_queue_get_sequence(c_queue_get_cell(queue, first_position)) - (first_position + ready_offset));
+        if(difference < 0)
+        {
+            // NOTE(Sleepster): Full (producer) or empty (consumer).
+            break;
+        }
+        else if(difference > 0)
+        {
+            // NOTE(Sleepster): Somebody claimed this one after we read the position, go again.
+            Assert(is_shared);
+            _mm_pause();
+            continue;
+        }
+
+        u32 available = 1;
+        while(available < max_count)
+        {
+            u64 cell_position = first_position + available;
+            if(c_queue_get_sequence(c_queue_get_cell(queue, cell_position)) != cell_position + ready_offset) break;
+            ++available;
+        }
+
+        if(!is_shared)
+        {
+            AtomicStore64(position, first_position + available);
+        }
+        else if((u64)AtomicCompareExchange64(position, first_position + available, first_position) != first_position)
+        {
+            continue;
+        }
+
+        *first_position_out = first_position;
+        result = available;
+        break;
+    }
+
+    return(result);
+}
+
+bool8
+c_queue_create(queue_t *queue, u32 kind, u32 element_size, u32 capacity)
+{
+    Assert(kind < QK_Count);
+    Assert(element_size > 0);
+
+    bool8 result = false;
+    ZeroStruct(*queue);
+
+    u32 rounded_capacity = 2;
+    while(rounded_capacity < capacity)
+    {
+        rounded_capacity <<= 1;
+    }
+
+    queue->kind         = kind;
+    queue->element_size = element_size;
+    queue->cell_size    = Align8(QUEUE_CELL_HEADER_SIZE + element_size);
+    queue->capacity     = rounded_capacity;
+    queue->mask         = rounded_capacity - 1;
+    queue->cells_size   = (usize)queue->cell_size * rounded_capacity;
+    queue->cells        = (byte*)sys_allocate_memory(queue->cells_size);
+    if(queue->cells)
+    {
+        for(u32 cell_index = 0;
+            cell_index < rounded_capacity;
+            ++cell_index)
+        {
+            *(u64*)c_queue_get_cell(queue, cell_index) = cell_index;
+        }
+        result = true;
+    }
+    else
+    {
+        log_error("Failed to allocate '%llu' bytes for a queue...\n", (unsigned long long)queue->cells_size);
+    }
+
+    return(result);
+}
+
+void
+c_queue_destroy(queue_t *queue)
+{
+    if(queue->cells)
+    {
+        sys_free_memory(queue->cells, queue->cells_size);
+    }
+    ZeroStruct(*queue);
+}
+
+u32
+c_queue_push_batch(queue_t *queue, void *elements, u32 element_count)
+{
+    u32 result = 0;
+    u64 first_position;
+    if(element_count > 0)
+    {
+        result = c_queue_claim(queue, &queue->enqueue_position, queue->kind != QK_SPSC, 0, element_count, &first_position);
+    }
+
+    byte *element = (byte*)elements;
+    for(u32 element_index = 0;
+        element_index < result;
+        ++element_index)
+    {
+        u64   position = first_position + element_index;
+        byte *cell     = c_queue_get_cell(queue, position);
+        memcpy(cell + QUEUE_CELL_HEADER_SIZE, element, queue->element_size);
+        AtomicStore64((volatile u64*)cell, position + 1);
+
+        element += queue->element_size;
+    }
+
+    return(result);
+}
+
+u32
+c_queue_pop_batch(queue_t *queue, void *elements_out, u32 max_element_count)
+{
+    u32 result = 0;
+    u64 first_position;
+    if(max_element_count > 0)
+    {
+        result = c_queue_claim(queue, &queue->dequeue_position, queue->kind == QK_MPMC, 1, max_element_count, &first_position);
+    }
+
+    byte *element = (byte*)elements_out;
+    for(u32 element_index = 0;
+        element_index < result;
+        ++element_index)
+    {
+        u64   position = first_position + element_index;
+        byte *cell     = c_queue_get_cell(queue, position);
+        memcpy(element, cell + QUEUE_CELL_HEADER_SIZE, queue->element_size);
+        AtomicStore64((volatile u64*)cell, position + queue->capacity);
+
+        element += queue->element_size;
+    }
+
+    return(result);
+}
+
+bool8
+c_queue_push(queue_t *queue, void *element)
+{
+    bool8 result = c_queue_push_batch(queue, element, 1) == 1;
+    return(result);
+}
+
+bool8
+c_queue_pop(queue_t *queue, void *element_out)
+{
+    bool8 result = c_queue_pop_batch(queue, element_out, 1) == 1;
+    return(result);
+}
+
+u32
+c_queue_get_count(queue_t *queue)
+{
+    u64 dequeue_position = (u64)AtomicLoad64(&queue->dequeue_position);
+    u64 enqueue_position = (u64)AtomicLoad64(&queue->enqueue_position);
+
+    u32 result = 0;
+    if(enqueue_position > dequeue_position)
+    {
+        u64 count = enqueue_position - dequeue_position;
+        result = (u32)(count > queue->capacity ? queue->capacity : count);
+    }
+
+    return(result);
+}
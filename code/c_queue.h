@@ -0,0 +1,69 @@
+#if !defined(C_QUEUE_H)
+/* ========================================================================
+   $File: c_queue.h $
+   $Date: October 18 2026 09:20 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define C_QUEUE_H
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+
+/* NOTE(Sleepster): Bounded lock free FIFO for handing fixed size elements between threads.
+ *
+ * This is Dmitry Vyukov's bounded MPMC queue. Every cell has a sequence number next to the element:
+ *   sequence == position                 -> the cell is free for the producer that claims 'position'
+ *   sequence == position + 1             -> the cell is full, ready for the consumer that claims 'position'
+ *   sequence == position + capacity      -> consumed, free again for the next lap
+ * Producers and consumers only ever touch their own position counter and the cells, so the two sides never fight
+ * over a cache line unless the queue is nearly empty or nearly full.
+ *
+ * The kind picks which side(s) need a CAS to claim a position. A single producer or consumer just stores it, which
+ * is the whole difference between SPSC, MPSC and MPMC. Using a SPSC queue from two producers will corrupt it.
+ *
+ * The batch calls claim a run of cells with one CAS and return how many they actually got, which can be less than
+ * asked for (and 0) when the queue is nearly full/empty. Elements are copied in and out, capacity is rounded up to
+ * a power of two.
+ */
+
+enum queue_kind_t
+{
+    QK_SPSC,
+    QK_MPSC,
+    QK_MPMC,
+    QK_Count
+};
+
+struct queue_t
+{
+    volatile u64  enqueue_position;
+    byte          _enqueue_padding[CACHE_LINE_SIZE - sizeof(u64)];
+
+    volatile u64  dequeue_position;
+    byte          _dequeue_padding[CACHE_LINE_SIZE - sizeof(u64)];
+
+    u32           kind;
+    u32           element_size;
+    u32           cell_size;
+    u32           capacity;
+    u64           mask;
+    byte         *cells;
+    usize         cells_size;
+};
+
+#define c_queue_create_typed(queue, kind, type, capacity) c_queue_create(queue, kind, sizeof(type), capacity)
+
+bool8 c_queue_create(queue_t *queue, u32 kind, u32 element_size, u32 capacity);
+void  c_queue_destroy(queue_t *queue);
+
+bool8 c_queue_push(queue_t *queue, void *element);
+bool8 c_queue_pop(queue_t *queue, void *element_out);
+u32   c_queue_push_batch(queue_t *queue, void *elements, u32 element_count);
+u32   c_queue_pop_batch(queue_t *queue, void *elements_out, u32 max_element_count);
+
+// NOTE(Sleepster): Only a snapshot, it can be stale by the time you look at it.
+u32   c_queue_get_count(queue_t *queue);
+
+#endif // C_QUEUE_H
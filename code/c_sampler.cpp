@@ -0,0 +1,1019 @@
+/* ========================================================================
+   $File: c_sampler.cpp $
+   $Date: October 19 2026 10:05 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if OS_LINUX
+    #include <cxxabi.h>
+#endif
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_log.h>
+#include <c_profiler.h>
+
+#include <c_sampler.h>
+#include <p_platform_data.h>
+
+#define SAMPLER_REPORT_OUTPUT_SIZE  (KB(64))
+#define SAMPLER_MAX_FUNCTION_NAME   (1024)
+
+global_variable sampler_t sampler;
+global_variable thread_local sampler_thread_ring_t *tl_sampler_ring = null;
+
+internal_api void c_sampler_thread_exited(sampler_thread_slot_t *slot);
+
+// NOTE(Sleepster): Same as the profiler, thread_local destructors run when the thread exits.
+struct sampler_thread_exit_t
+{
+    sampler_thread_slot_t *slot;
+
+    ~sampler_thread_exit_t()
+    {
+        if(slot) c_sampler_thread_exited(slot);
+    }
+};
+global_variable thread_local sampler_thread_exit_t tl_sampler_thread_exit;
+
+/*===========================================
+  ================ CAPTURE ==================
+  ===========================================*/
+
+// NOTE(Sleepster): The signal handler. No locks, no allocations, nothing but this thread's ring.
+internal_api void
+c_sampler_record_sample(u64 *frames, u32 frame_count)
+{
+    sampler_thread_ring_t *ring = tl_sampler_ring;
+    if(!ring) return;
+
+    u32 write_index = ring->write_index;
+    if(write_index - AtomicLoad32(&ring->read_index) >= SAMPLER_RING_SAMPLE_COUNT)
+    {
+        ring->dropped_samples = ring->dropped_samples + 1;
+        return;
+    }
+
+    sampler_sample_t *sample = ring->samples + (write_index & (SAMPLER_RING_SAMPLE_COUNT - 1));
+    sample->frame_count = frame_count;
+    for(u32 frame_index = 0; frame_index < frame_count; ++frame_index)
+    {
+        sample->frames[frame_index] = frames[frame_index];
+    }
+    AtomicStore32(&ring->write_index, write_index + 1);
+}
+
+internal_api void
+c_sampler_output_flush(void)
+{
+    if(sampler.output_used && !sampler.output_failed)
+    {
+        if(!c_file_write(&sampler.output_file, sampler.output_buffer, sampler.output_used))
+        {
+            log_error("Failed to write to the sampler capture '%s'...\n", sampler.output_path);
+            sampler.output_failed = true;
+        }
+    }
+    sampler.output_used = 0;
+}
+
+internal_api void
+c_sampler_output_append(void *data, u32 size)
+{
+    Assert(size <= SAMPLER_OUTPUT_SIZE);
+    if(sampler.output_used + size > SAMPLER_OUTPUT_SIZE) c_sampler_output_flush();
+
+    memcpy(sampler.output_buffer + sampler.output_used, data, size);
+    sampler.output_used += size;
+}
+
+internal_api void
+c_sampler_write_record(u32 type, void *body, u32 body_size, void *tail, u32 tail_size)
+{
+    sampler_record_header_t header = {};
+    header.type = (u16)type;
+    header.size = body_size + tail_size;
+
+    c_sampler_output_append(&header, sizeof(header));
+    c_sampler_output_append(body, body_size);
+    if(tail_size) c_sampler_output_append(tail, tail_size);
+}
+
+internal_api void
+c_sampler_write_modules(void)
+{
+    u32 module_count = sys_get_loaded_modules(sampler.modules, SAMPLER_MAX_MODULES);
+    for(u32 module_index = 0; module_index < module_count; ++module_index)
+    {
+        sys_module_t *module = sampler.modules + module_index;
+
+        sampler_module_record_t record = {};
+        record.load_bias = module->load_bias;
+        record.start     = module->start;
+        record.end       = module->end;
+        c_sampler_write_record(SRT_Module, &record, sizeof(record), module->path, (u32)strlen(module->path) + 1);
+    }
+}
+
+// NOTE(Sleepster): Under the lock. Frees the slots of threads that exited once their rings are empty.
+internal_api void
+c_sampler_drain_rings(void)
+{
+    for(u32 slot_index = 0;
+        slot_index < sampler.slot_count;
+        ++slot_index)
+    {
+        sampler_thread_slot_t *slot  = sampler.slots + slot_index;
+        u32                    state = AtomicLoad32(&slot->state);
+        if(state == SSS_Free) continue;
+
+        if(!slot->name_written)
+        {
+            sampler_thread_record_t record = {};
+            record.slot_index = slot_index;
+            record.thread_id  = (u32)slot->sys_thread.thread_id;
+            c_sampler_write_record(SRT_Thread, &record, sizeof(record), slot->name, (u32)strlen(slot->name) + 1);
+            slot->name_written = true;
+        }
+
+        sampler_thread_ring_t *ring        = slot->ring;
+        u32                    write_index = AtomicLoad32(&ring->write_index);
+        for(u32 read_index = ring->read_index;
+            read_index != write_index;
+            ++read_index)
+        {
+            sampler_sample_t *sample = ring->samples + (read_index & (SAMPLER_RING_SAMPLE_COUNT - 1));
+
+            sampler_sample_record_t record = {};
+            record.slot_index  = slot_index;
+            record.frame_count = sample->frame_count;
+            c_sampler_write_record(SRT_Sample, &record, sizeof(record), sample->frames, sample->frame_count * sizeof(u64));
+            ++sampler.samples_written;
+        }
+        AtomicStore32(&ring->read_index, write_index);
+
+        u32 dropped_samples = AtomicLoad32(&ring->dropped_samples);
+        if(dropped_samples != slot->dropped_written)
+        {
+            sampler_dropped_record_t record = {};
+            record.slot_index    = slot_index;
+            record.dropped_count = dropped_samples - slot->dropped_written;
+            c_sampler_write_record(SRT_Dropped, &record, sizeof(record), null, 0);
+
+            sampler.samples_dropped += record.dropped_count;
+            slot->dropped_written    = dropped_samples;
+        }
+
+        if(state == SSS_Exited) AtomicStore32(&slot->state, SSS_Free);
+    }
+}
+
+PLATFORM_THREAD_PROC(c_sampler_drain_proc)
+{
+    PROFILE_SET_THREAD_NAME("sampler_drain");
+
+    for(;;)
+    {
+        // NOTE(Sleepster): Read before draining, whatever was sampled before the stop is still written.
+        bool8 is_running = AtomicLoad32(&sampler.is_running);
+
+        c_futex_mutex_lock(&sampler.lock);
+        c_sampler_drain_rings();
+        c_futex_mutex_unlock(&sampler.lock);
+
+        if(!is_running) break;
+        c_futex_semaphore_wait(&sampler.drain_wake, SAMPLER_DRAIN_INTERVAL_MS);
+    }
+
+    return(0);
+}
+
+internal_api void
+c_sampler_thread_exited(sampler_thread_slot_t *slot)
+{
+    c_futex_mutex_lock(&sampler.lock);
+    tl_sampler_ring = null;
+    sys_sampler_thread_stop(&slot->sys_thread);
+    slot->timer_running = false;
+    AtomicStore32(&slot->state, AtomicLoad32(&sampler.is_running) ? SSS_Exited : SSS_Free);
+    c_futex_mutex_unlock(&sampler.lock);
+}
+
+// NOTE(Sleepster): Call it again to rename the thread.
+void
+c_sampler_register_thread(const char *name)
+{
+    c_futex_mutex_lock(&sampler.lock);
+
+    sampler_thread_slot_t *slot = tl_sampler_thread_exit.slot;
+    if(!slot)
+    {
+        for(u32 slot_index = 0;
+            slot_index < SAMPLER_MAX_THREADS;
+            ++slot_index)
+        {
+            sampler_thread_slot_t *candidate = sampler.slots + slot_index;
+            if(AtomicLoad32(&candidate->state) != SSS_Free) continue;
+
+            if(!candidate->ring)
+            {
+                candidate->ring = (sampler_thread_ring_t*)sys_allocate_memory(sizeof(sampler_thread_ring_t));
+                Assert(candidate->ring);
+            }
+            candidate->ring->write_index     = 0;
+            candidate->ring->read_index      = 0;
+            candidate->ring->dropped_samples = 0;
+            candidate->dropped_written       = 0;
+            candidate->timer_running         = false;
+            sys_sampler_register_thread(&candidate->sys_thread);
+
+            sampler.slot_count           = Max(sampler.slot_count, slot_index + 1);
+            tl_sampler_ring              = candidate->ring;
+            tl_sampler_thread_exit.slot  = candidate;
+            AtomicStore32(&candidate->state, SSS_Active);
+
+            slot = candidate;
+            break;
+        }
+    }
+
+    if(slot)
+    {
+        snprintf(slot->name, SAMPLER_MAX_NAME_LENGTH, "%s", name ? name : "unnamed");
+        slot->name_written = false;
+        if(AtomicLoad32(&sampler.is_running) && !slot->timer_running)
+        {
+            slot->timer_running = sys_sampler_thread_start(&slot->sys_thread, sampler.frequency_hz);
+        }
+    }
+    else if(!sampler.registration_failed)
+    {
+        sampler.registration_failed = true;
+        log_warning("Sampler is out of thread slots ('%u'), threads past this point are not sampled...\n", SAMPLER_MAX_THREADS);
+    }
+
+    c_futex_mutex_unlock(&sampler.lock);
+}
+
+bool8
+c_sampler_start(const char *path, u32 frequency_hz)
+{
+    bool8 result = false;
+    if(frequency_hz == 0) frequency_hz = SAMPLER_DEFAULT_FREQUENCY;
+
+    c_futex_mutex_lock(&sampler.lock);
+    if(AtomicLoad32(&sampler.is_running))
+    {
+        log_warning("The sampler is already running...\n");
+        c_futex_mutex_unlock(&sampler.lock);
+        return(result);
+    }
+
+    if(!sampler.handler_installed) sampler.handler_installed = sys_sampler_install(c_sampler_record_sample);
+    if(sampler.handler_installed)
+    {
+        snprintf(sampler.output_path, SAMPLER_MAX_PATH_LENGTH, "%s", path);
+        sampler.output_file = sys_file_open(c_string_create(sampler.output_path), true, false, false);
+        if(sampler.output_file.handle != INVALID_FILE_HANDLE)
+        {
+            sampler.output_buffer   = (byte*)sys_allocate_memory(SAMPLER_OUTPUT_SIZE);
+            sampler.output_used     = 0;
+            sampler.output_failed   = false;
+            sampler.samples_written = 0;
+            sampler.samples_dropped = 0;
+            sampler.frequency_hz    = frequency_hz;
+            Assert(sampler.output_buffer);
+
+            sampler_file_header_t header = {};
+            header.magic        = SAMPLER_FILE_MAGIC;
+            header.version      = SAMPLER_FILE_VERSION;
+            header.frequency_hz = frequency_hz;
+            c_sampler_output_append(&header, sizeof(header));
+            c_sampler_write_modules();
+
+            // NOTE(Sleepster): The timers aren't armed yet, nothing's writing to the rings.
+            u32 thread_count = 0;
+            for(u32 slot_index = 0; slot_index < sampler.slot_count; ++slot_index)
+            {
+                sampler_thread_slot_t *slot = sampler.slots + slot_index;
+                if(AtomicLoad32(&slot->state) != SSS_Active) continue;
+
+                slot->ring->read_index = slot->ring->write_index;
+                slot->dropped_written  = slot->ring->dropped_samples;
+                slot->name_written     = false;
+                slot->timer_running    = sys_sampler_thread_start(&slot->sys_thread, frequency_hz);
+                thread_count          += slot->timer_running;
+            }
+
+            AtomicStore32(&sampler.is_running, 1);
+            sampler.drain_thread = sys_thread_create(c_sampler_drain_proc, null, false);
+
+            result = true;
+            log_info("Sampling '%u' threads at '%u' Hz into '%s'...\n", thread_count, frequency_hz, sampler.output_path);
+        }
+        else
+        {
+            log_error("Failed to open the sampler capture '%s'...\n", sampler.output_path);
+        }
+    }
+
+    c_futex_mutex_unlock(&sampler.lock);
+    return(result);
+}
+
+void
+c_sampler_stop(void)
+{
+    c_futex_mutex_lock(&sampler.lock);
+    bool8 was_running = AtomicLoad32(&sampler.is_running);
+    if(was_running)
+    {
+        AtomicStore32(&sampler.is_running, 0);
+        for(u32 slot_index = 0; slot_index < sampler.slot_count; ++slot_index)
+        {
+            sampler_thread_slot_t *slot = sampler.slots + slot_index;
+            if(slot->timer_running)
+            {
+                sys_sampler_thread_stop(&slot->sys_thread);
+                slot->timer_running = false;
+            }
+        }
+    }
+    c_futex_mutex_unlock(&sampler.lock);
+    if(!was_running) return;
+
+    c_futex_semaphore_release(&sampler.drain_wake);
+    sys_thread_join(&sampler.drain_thread);
+
+    // NOTE(Sleepster): Again, for whatever got loaded during the capture.
+    c_futex_mutex_lock(&sampler.lock);
+    c_sampler_write_modules();
+    c_sampler_output_flush();
+    c_file_close(&sampler.output_file);
+    sys_free_memory(sampler.output_buffer, SAMPLER_OUTPUT_SIZE);
+    sampler.output_buffer = null;
+    c_futex_mutex_unlock(&sampler.lock);
+
+    log_info("Sampler wrote '%llu' samples to '%s', '%llu' dropped...\n",
+             (unsigned long long)sampler.samples_written, sampler.output_path, (unsigned long long)sampler.samples_dropped);
+}
+
+bool8
+c_sampler_is_running(void)
+{
+    bool8 result = AtomicLoad32(&sampler.is_running) != 0;
+    return(result);
+}
+
+/*===========================================
+  ================ REPORT ===================
+  ===========================================*/
+
+// NOTE(Sleepster): Just enough of the ELF64 format to find the function symbols, from elf(5).
+#define SAMPLER_ELF_CLASS_64        (2)
+#define SAMPLER_ELF_SECTION_SYMTAB  (2)
+#define SAMPLER_ELF_SECTION_DYNSYM  (11)
+#define SAMPLER_ELF_SYMBOL_FUNC     (2)
+
+#pragma pack(push, 1)
+struct sampler_elf_header_t
+{
+    u8  ident[16];
+    u16 type;
+    u16 machine;
+    u32 version;
+    u64 entry;
+    u64 program_header_offset;
+    u64 section_header_offset;
+    u32 flags;
+    u16 header_size;
+    u16 program_header_size;
+    u16 program_header_count;
+    u16 section_header_size;
+    u16 section_header_count;
+    u16 section_name_index;
+};
+
+struct sampler_elf_section_t
+{
+    u32 name;
+    u32 type;
+    u64 flags;
+    u64 address;
+    u64 offset;
+    u64 size;
+    u32 link;
+    u32 info;
+    u64 alignment;
+    u64 entry_size;
+};
+
+struct sampler_elf_symbol_t
+{
+    u32 name;
+    u8  info;
+    u8  other;
+    u16 section_index;
+    u64 value;
+    u64 size;
+};
+#pragma pack(pop)
+
+// NOTE(Sleepster): qsort doesn't take a user pointer.
+global_variable sampler_report_t *sampler_sort_report;
+
+internal_api int
+c_sampler_compare_symbols(const void *a, const void *b)
+{
+    u64 address_a = ((sampler_symbol_t*)a)->address;
+    u64 address_b = ((sampler_symbol_t*)b)->address;
+
+    int result = (address_a > address_b) - (address_a < address_b);
+    return(result);
+}
+
+internal_api int
+c_sampler_compare_addresses(const void *a, const void *b)
+{
+    u64 address_a = *(u64*)a;
+    u64 address_b = *(u64*)b;
+
+    int result = (address_a > address_b) - (address_a < address_b);
+    return(result);
+}
+
+internal_api int
+c_sampler_compare_stacks(const void *a, const void *b)
+{
+    sampler_report_sample_t *sample_a = sampler_sort_report->samples + *(u32*)a;
+    sampler_report_sample_t *sample_b = sampler_sort_report->samples + *(u32*)b;
+    u32 *stack_a = sampler_sort_report->stack_functions + sample_a->first_frame;
+    u32 *stack_b = sampler_sort_report->stack_functions + sample_b->first_frame;
+
+    int result      = 0;
+    u32 frame_count = Min(sample_a->frame_count, sample_b->frame_count);
+    for(u32 frame_index = 0; frame_index < frame_count && !result; ++frame_index)
+    {
+        result = (stack_a[frame_index] > stack_b[frame_index]) - (stack_a[frame_index] < stack_b[frame_index]);
+    }
+    if(!result) result = (sample_a->frame_count > sample_b->frame_count) - (sample_a->frame_count < sample_b->frame_count);
+
+    return(result);
+}
+
+internal_api int
+c_sampler_compare_functions(const void *a, const void *b)
+{
+    sampler_function_t *function_a = *(sampler_function_t**)a;
+    sampler_function_t *function_b = *(sampler_function_t**)b;
+
+    int result = (function_a->self_samples < function_b->self_samples) - (function_a->self_samples > function_b->self_samples);
+    if(!result) result = (function_a->total_samples < function_b->total_samples) - (function_a->total_samples > function_b->total_samples);
+
+    return(result);
+}
+
+// NOTE(Sleepster): Not c_file_open(), that asserts on a missing file.
+internal_api string_t
+c_sampler_read_file(string_t filepath, memory_arena_t *arena)
+{
+    string_t result = {};
+
+    file_t file = sys_file_open(filepath, false, false, false);
+    if(file.handle != INVALID_FILE_HANDLE)
+    {
+        s64 file_size = c_file_get_size(&file);
+        if(file_size > 0) result = c_file_read(&file, (u32)file_size, arena);
+        c_file_close(&file);
+    }
+
+    return(result);
+}
+
+internal_api const char*
+c_sampler_report_copy_name(sampler_report_t *report, const char *name)
+{
+    const char *source    = name;
+    char       *demangled = null;
+#if OS_LINUX
+    s32 status = 0;
+    demangled  = abi::__cxa_demangle(name, null, null, &status);
+    if(demangled && status == 0) source = demangled;
+#endif
+
+    // NOTE(Sleepster): Drop the parameter list, 'c_fnv_hash_value' reads better than the whole signature.
+    usize length = strlen(source);
+    if(source != name && length && source[length - 1] == ')')
+    {
+        s32 depth = 0;
+        for(usize index = length; index > 0; --index)
+        {
+            char c = source[index - 1];
+            if(c == ')') ++depth;
+            if(c == '(' && --depth == 0)
+            {
+                length = index - 1;
+                break;
+            }
+        }
+    }
+
+    char *result = (char*)c_arena_push_size(&report->arena, length + 1);
+    memcpy(result, source, length);
+    result[length] = 0;
+
+    if(demangled) free(demangled);
+    return(result);
+}
+
+internal_api u32
+c_sampler_report_add_function(sampler_report_t *report, const char *name, bool8 is_thread)
+{
+    if(report->function_count == report->function_capacity)
+    {
+        u32                 new_capacity  = report->function_capacity ? report->function_capacity * 2 : 256;
+        sampler_function_t *new_functions = c_arena_push_array(&report->arena, sampler_function_t, new_capacity);
+        if(report->function_count) memcpy(new_functions, report->functions, sizeof(sampler_function_t) * report->function_count);
+
+        report->functions         = new_functions;
+        report->function_capacity = new_capacity;
+    }
+
+    u32 result = report->function_count++;
+    sampler_function_t *function = report->functions + result;
+    ZeroStruct(*function);
+    function->name      = name;
+    function->is_thread = is_thread;
+
+    return(result);
+}
+
+// NOTE(Sleepster): Threads with the same name share a root, every threadpool worker ends up under one.
+internal_api u32
+c_sampler_report_add_thread(sampler_report_t *report, const char *name)
+{
+    u32 result = SAMPLER_INVALID_FUNCTION;
+    for(u32 function_index = 0; function_index < report->function_count; ++function_index)
+    {
+        sampler_function_t *function = report->functions + function_index;
+        if(function->is_thread && strcmp(function->name, name) == 0)
+        {
+            result = function_index;
+            break;
+        }
+    }
+
+    if(result == SAMPLER_INVALID_FUNCTION)
+    {
+        result = c_sampler_report_add_function(report, c_sampler_report_copy_name(report, name), true);
+    }
+
+    return(result);
+}
+
+internal_api void
+c_sampler_report_load_symbols(sampler_report_t *report, sampler_module_t *module)
+{
+    module->symbols_loaded = true;
+
+    memory_arena_t file_arena = c_arena_create(MB(1));
+    string_t       file_data  = c_sampler_read_file(c_string_create(module->path), &file_arena);
+
+    sampler_elf_header_t *header = (sampler_elf_header_t*)file_data.data;
+    if(file_data.count >= sizeof(sampler_elf_header_t) &&
+       memcmp(header->ident, "\x7F" "ELF", 4) == 0    &&
+       header->ident[4] == SAMPLER_ELF_CLASS_64       &&
+       header->section_header_size == sizeof(sampler_elf_section_t) &&
+       header->section_header_offset + (u64)header->section_header_count * sizeof(sampler_elf_section_t) <= file_data.count)
+    {
+        // NOTE(Sleepster): .symtab has everything, a stripped module only has .dynsym left.
+        sampler_elf_section_t *sections     = (sampler_elf_section_t*)(file_data.data + header->section_header_offset);
+        sampler_elf_section_t *symbol_table = null;
+        for(u32 section_index = 0; section_index < header->section_header_count; ++section_index)
+        {
+            sampler_elf_section_t *section = sections + section_index;
+            if(section->type == SAMPLER_ELF_SECTION_SYMTAB) symbol_table = section;
+            if(section->type == SAMPLER_ELF_SECTION_DYNSYM && !symbol_table) symbol_table = section;
+        }
+
+        if(symbol_table && symbol_table->link < header->section_header_count &&
+           symbol_table->offset + symbol_table->size <= file_data.count)
+        {
+            sampler_elf_section_t *string_table = sections + symbol_table->link;
+            sampler_elf_symbol_t  *symbols      = (sampler_elf_symbol_t*)(file_data.data + symbol_table->offset);
+            u32                    symbol_count = (u32)(symbol_table->size / sizeof(sampler_elf_symbol_t));
+            const char            *strings      = (const char*)(file_data.data + string_table->offset);
+
+            if(string_table->offset + string_table->size <= file_data.count)
+            {
+                module->symbols = c_arena_push_array(&report->arena, sampler_symbol_t, symbol_count);
+                for(u32 symbol_index = 0; symbol_index < symbol_count; ++symbol_index)
+                {
+                    sampler_elf_symbol_t *symbol = symbols + symbol_index;
+                    if((symbol->info & 0xF) != SAMPLER_ELF_SYMBOL_FUNC) continue;
+                    if(!symbol->value || !symbol->section_index)        continue;
+                    if(symbol->name >= string_table->size)              continue;
+
+                    sampler_symbol_t *entry = module->symbols + module->symbol_count++;
+                    entry->address        = symbol->value;
+                    entry->size           = symbol->size;
+                    entry->name           = c_sampler_report_copy_name(report, strings + symbol->name);
+                    entry->function_index = SAMPLER_INVALID_FUNCTION;
+                }
+                qsort(module->symbols, module->symbol_count, sizeof(sampler_symbol_t), c_sampler_compare_symbols);
+            }
+        }
+
+        if(!module->symbol_count) log_warning("No function symbols in '%s', its samples only get the module name...\n", module->path);
+    }
+    else
+    {
+        log_warning("Couldn't read '%s' as a 64 bit ELF file, its samples only get the module name...\n", module->path);
+    }
+
+    c_arena_destroy(&file_arena);
+}
+
+internal_api sampler_symbol_t*
+c_sampler_report_find_symbol(sampler_module_t *module, u64 address)
+{
+    sampler_symbol_t *result = null;
+
+    // NOTE(Sleepster): The last symbol that starts at or before the address.
+    u32 low  = 0;
+    u32 high = module->symbol_count;
+    while(low < high)
+    {
+        u32 middle = low + ((high - low) / 2);
+        if(module->symbols[middle].address <= address) low  = middle + 1;
+        else                                           high = middle;
+    }
+
+    if(low > 0)
+    {
+        sampler_symbol_t *symbol = module->symbols + (low - 1);
+        if(!symbol->size || address < symbol->address + symbol->size) result = symbol;
+    }
+
+    return(result);
+}
+
+internal_api u32
+c_sampler_report_resolve(sampler_report_t *report, u64 address)
+{
+    u32 result = report->unknown_function_index;
+    for(u32 module_index = 0; module_index < report->module_count; ++module_index)
+    {
+        sampler_module_t *module = report->modules + module_index;
+        if(address < module->start || address >= module->end) continue;
+
+        if(!module->symbols_loaded) c_sampler_report_load_symbols(report, module);
+
+        sampler_symbol_t *symbol = c_sampler_report_find_symbol(module, address - module->load_bias);
+        if(symbol)
+        {
+            if(symbol->function_index == SAMPLER_INVALID_FUNCTION)
+            {
+                symbol->function_index = c_sampler_report_add_function(report, symbol->name, false);
+            }
+            result = symbol->function_index;
+        }
+        else
+        {
+            if(module->function_index == SAMPLER_INVALID_FUNCTION)
+            {
+                const char *module_name = strrchr(module->path, '/');
+                module_name = module_name ? module_name + 1 : module->path;
+
+                char name[SAMPLER_MAX_FUNCTION_NAME];
+                snprintf(name, sizeof(name), "[%s]", module_name);
+                module->function_index = c_sampler_report_add_function(report, c_sampler_report_copy_name(report, name), false);
+            }
+            result = module->function_index;
+        }
+        break;
+    }
+
+    return(result);
+}
+
+internal_api void
+c_sampler_report_add_module(sampler_report_t *report, sampler_module_record_t *record, const char *path)
+{
+    for(u32 module_index = 0; module_index < report->module_count; ++module_index)
+    {
+        sampler_module_t *module = report->modules + module_index;
+        if(module->start == record->start && module->end == record->end && module->load_bias == record->load_bias) return;
+    }
+
+    if(report->module_count < SAMPLER_MAX_MODULES)
+    {
+        sampler_module_t *module = report->modules + report->module_count++;
+        ZeroStruct(*module);
+        module->load_bias      = record->load_bias;
+        module->start          = record->start;
+        module->end            = record->end;
+        module->path           = c_sampler_report_copy_name(report, path);
+        module->function_index = SAMPLER_INVALID_FUNCTION;
+    }
+}
+
+/* NOTE(Sleepster): Two passes over the records, the first one counts and collects the modules, the second one
+ * copies the stacks out root first with the thread's name at the root. Return addresses get one taken off so they
+ * land in the call instead of whatever comes after it. Every distinct address is only symbolized once.
+ */
+bool8
+c_sampler_report_load(sampler_report_t *report, string_t filepath)
+{
+    ZeroStruct(*report);
+    report->arena = c_arena_create(MB(4));
+
+    memory_arena_t         load_arena = c_arena_create(MB(4));
+    string_t               file_data  = c_sampler_read_file(filepath, &load_arena);
+    sampler_file_header_t *header     = (sampler_file_header_t*)file_data.data;
+    if(!file_data.data || file_data.count < sizeof(sampler_file_header_t))
+    {
+        log_error("Failed to read sampler capture '%s'...\n", C_STR(filepath));
+        c_arena_destroy(&load_arena);
+        return(false);
+    }
+    if(header->magic != SAMPLER_FILE_MAGIC || header->version != SAMPLER_FILE_VERSION)
+    {
+        log_error("'%s' isn't a sampler capture, or it's from another version ('%u', this is '%u')...\n",
+                  C_STR(filepath), header->version, SAMPLER_FILE_VERSION);
+        c_arena_destroy(&load_arena);
+        return(false);
+    }
+    report->frequency_hz           = header->frequency_hz;
+    report->unknown_function_index = c_sampler_report_add_function(report, "[unknown]", false);
+
+    // NOTE(Sleepster): Parallel to stack_functions until everything's resolved, 0 at the thread roots.
+    u64 *addresses     = null;
+    u32  address_count = 0;
+    for(u32 pass = 0; pass < 2; ++pass)
+    {
+        u32 thread_functions[SAMPLER_MAX_THREADS];
+        for(u32 slot_index = 0; slot_index < SAMPLER_MAX_THREADS; ++slot_index) thread_functions[slot_index] = SAMPLER_INVALID_FUNCTION;
+
+        u32 sample_index = 0;
+        u32 frame_index  = 0;
+        u64 offset       = sizeof(sampler_file_header_t);
+        while(offset + sizeof(sampler_record_header_t) <= file_data.count)
+        {
+            sampler_record_header_t *record_header = (sampler_record_header_t*)(file_data.data + offset);
+            byte                    *body          = file_data.data + offset + sizeof(sampler_record_header_t);
+            offset += sizeof(sampler_record_header_t) + record_header->size;
+            if(offset > file_data.count)
+            {
+                if(pass == 0) log_warning("Sampler capture '%s' is cut short, using what's there...\n", C_STR(filepath));
+                break;
+            }
+
+            switch(record_header->type)
+            {
+                case SRT_Module:
+                {
+                    if(pass == 0 && record_header->size > sizeof(sampler_module_record_t))
+                    {
+                        body[record_header->size - 1] = 0;
+                        c_sampler_report_add_module(report, (sampler_module_record_t*)body, (const char*)(body + sizeof(sampler_module_record_t)));
+                    }
+                }break;
+                case SRT_Thread:
+                {
+                    sampler_thread_record_t *record = (sampler_thread_record_t*)body;
+                    if(pass == 1 && record_header->size > sizeof(sampler_thread_record_t) && record->slot_index < SAMPLER_MAX_THREADS)
+                    {
+                        body[record_header->size - 1] = 0;
+                        thread_functions[record->slot_index] = c_sampler_report_add_thread(report, (const char*)(body + sizeof(sampler_thread_record_t)));
+                    }
+                }break;
+                case SRT_Sample:
+                {
+                    sampler_sample_record_t *record = (sampler_sample_record_t*)body;
+                    if(record->frame_count == 0 || record->frame_count > SAMPLER_MAX_DEPTH ||
+                       record_header->size != sizeof(sampler_sample_record_t) + record->frame_count * sizeof(u64))
+                    {
+                        break;
+                    }
+
+                    if(pass == 1)
+                    {
+                        u32 thread_function = record->slot_index < SAMPLER_MAX_THREADS ? thread_functions[record->slot_index] : SAMPLER_INVALID_FUNCTION;
+                        if(thread_function == SAMPLER_INVALID_FUNCTION) thread_function = c_sampler_report_add_thread(report, "unknown_thread");
+
+                        sampler_report_sample_t *sample = report->samples + sample_index;
+                        sample->first_frame = frame_index;
+                        sample->frame_count = record->frame_count + 1;
+
+                        report->stack_functions[frame_index] = thread_function;
+                        addresses[frame_index++]             = 0;
+
+                        u64 *frames = (u64*)(body + sizeof(sampler_sample_record_t));
+                        for(u32 leaf_index = record->frame_count; leaf_index > 0; --leaf_index)
+                        {
+                            u64 address = frames[leaf_index - 1];
+                            if(leaf_index > 1) address -= 1;
+
+                            report->stack_functions[frame_index] = SAMPLER_INVALID_FUNCTION;
+                            addresses[frame_index++]             = address;
+                        }
+                    }
+                    else
+                    {
+                        address_count += record->frame_count + 1;
+                    }
+                    ++sample_index;
+                }break;
+                case SRT_Dropped:
+                {
+                    if(pass == 0) report->dropped_samples += ((sampler_dropped_record_t*)body)->dropped_count;
+                }break;
+            }
+        }
+
+        if(pass == 0)
+        {
+            report->sample_count         = sample_index;
+            report->stack_function_count = address_count;
+            report->samples              = c_arena_push_array(&report->arena, sampler_report_sample_t, Max(sample_index, 1u));
+            report->stack_functions      = c_arena_push_array(&report->arena, u32, Max(address_count, 1u));
+            addresses                    = c_arena_push_array(&load_arena, u64, Max(address_count, 1u));
+        }
+    }
+
+    // NOTE(Sleepster): Sort the addresses, symbolize each one once, then look every frame up in the sorted list.
+    u64 *unique_addresses = c_arena_push_array(&load_arena, u64, Max(address_count, 1u));
+    u32 *unique_functions = c_arena_push_array(&load_arena, u32, Max(address_count, 1u));
+    u32  unique_count     = 0;
+    for(u32 frame_index = 0; frame_index < address_count; ++frame_index)
+    {
+        if(report->stack_functions[frame_index] == SAMPLER_INVALID_FUNCTION) unique_addresses[unique_count++] = addresses[frame_index];
+    }
+    qsort(unique_addresses, unique_count, sizeof(u64), c_sampler_compare_addresses);
+
+    u32 write_index = 0;
+    for(u32 read_index = 0; read_index < unique_count; ++read_index)
+    {
+        if(write_index && unique_addresses[write_index - 1] == unique_addresses[read_index]) continue;
+        unique_addresses[write_index] = unique_addresses[read_index];
+        unique_functions[write_index] = c_sampler_report_resolve(report, unique_addresses[read_index]);
+        ++write_index;
+    }
+    unique_count = write_index;
+
+    for(u32 frame_index = 0; frame_index < address_count; ++frame_index)
+    {
+        if(report->stack_functions[frame_index] != SAMPLER_INVALID_FUNCTION) continue;
+
+        u64 *found = (u64*)bsearch(addresses + frame_index, unique_addresses, unique_count, sizeof(u64), c_sampler_compare_addresses);
+        Assert(found);
+        report->stack_functions[frame_index] = unique_functions[found - unique_addresses];
+    }
+
+    // NOTE(Sleepster): Self is the leaf, total counts a function once per sample even if it recursed.
+    for(u32 sample_index = 0; sample_index < report->sample_count; ++sample_index)
+    {
+        sampler_report_sample_t *sample = report->samples + sample_index;
+        u32                     *stack  = report->stack_functions + sample->first_frame;
+        report->functions[stack[sample->frame_count - 1]].self_samples += 1;
+        for(u32 frame_index = 0; frame_index < sample->frame_count; ++frame_index)
+        {
+            sampler_function_t *function = report->functions + stack[frame_index];
+            if(function->last_sample != sample_index + 1)
+            {
+                function->last_sample    = sample_index + 1;
+                function->total_samples += 1;
+            }
+        }
+    }
+
+    c_arena_destroy(&load_arena);
+    report->is_valid = true;
+
+    return(report->is_valid);
+}
+
+void
+c_sampler_report_destroy(sampler_report_t *report)
+{
+    c_arena_destroy(&report->arena);
+    ZeroStruct(*report);
+}
+
+u32
+c_sampler_report_get_top(sampler_report_t *report, sampler_function_t **functions_out, u32 max_count)
+{
+    u32 result = 0;
+
+    sampler_function_t **sorted = (sampler_function_t**)malloc(sizeof(sampler_function_t*) * Max(report->function_count, 1u));
+    u32 sorted_count = 0;
+    for(u32 function_index = 0; function_index < report->function_count; ++function_index)
+    {
+        sampler_function_t *function = report->functions + function_index;
+        if(!function->is_thread && function->total_samples) sorted[sorted_count++] = function;
+    }
+    qsort(sorted, sorted_count, sizeof(sampler_function_t*), c_sampler_compare_functions);
+
+    result = Min(sorted_count, max_count);
+    memcpy(functions_out, sorted, sizeof(sampler_function_t*) * result);
+    free(sorted);
+
+    return(result);
+}
+
+void
+c_sampler_report_log_top(sampler_report_t *report, u32 max_count)
+{
+    float64 seconds = report->frequency_hz ? (float64)report->sample_count / (float64)report->frequency_hz : 0.0;
+    log_info("Sampler capture, '%u' samples at '%u' Hz ('%.2f' seconds of CPU), '%llu' dropped...\n",
+             report->sample_count, report->frequency_hz, seconds, (unsigned long long)report->dropped_samples);
+    if(!report->sample_count) return;
+
+    sampler_function_t **top = (sampler_function_t**)malloc(sizeof(sampler_function_t*) * Max(max_count, 1u));
+    u32 top_count = c_sampler_report_get_top(report, top, max_count);
+
+    log_info("    %7s %7s %8s %8s  %s\n", "self", "total", "self #", "total #", "function");
+    for(u32 top_index = 0; top_index < top_count; ++top_index)
+    {
+        sampler_function_t *function = top[top_index];
+        log_info("    %6.2f%% %6.2f%% %8llu %8llu  %s\n",
+                 ((float64)function->self_samples  * 100.0) / (float64)report->sample_count,
+                 ((float64)function->total_samples * 100.0) / (float64)report->sample_count,
+                 (unsigned long long)function->self_samples, (unsigned long long)function->total_samples, function->name);
+    }
+    free(top);
+}
+
+/* NOTE(Sleepster): One line per distinct stack, 'root;...;leaf <count>', the samples are sorted so identical stacks
+ * sit next to each other.
+ */
+bool8
+c_sampler_report_write_folded(sampler_report_t *report, string_t filepath)
+{
+    bool8 result = false;
+
+    file_t file = sys_file_open(filepath, true, false, false);
+    if(file.handle == INVALID_FILE_HANDLE)
+    {
+        log_error("Failed to open '%s' for the folded stacks...\n", C_STR(filepath));
+        return(result);
+    }
+
+    u32 *order = (u32*)malloc(sizeof(u32) * Max(report->sample_count, 1u));
+    for(u32 sample_index = 0; sample_index < report->sample_count; ++sample_index) order[sample_index] = sample_index;
+    sampler_sort_report = report;
+    qsort(order, report->sample_count, sizeof(u32), c_sampler_compare_stacks);
+    sampler_sort_report = null;
+
+    char *buffer = (char*)malloc(SAMPLER_REPORT_OUTPUT_SIZE);
+    u32   used   = 0;
+    result       = true;
+    for(u32 run_start = 0; run_start < report->sample_count;)
+    {
+        u32 run_end = run_start + 1;
+        sampler_sort_report = report;
+        while(run_end < report->sample_count && c_sampler_compare_stacks(order + run_start, order + run_end) == 0) ++run_end;
+        sampler_sort_report = null;
+
+        sampler_report_sample_t *sample = report->samples + order[run_start];
+        u32                     *stack  = report->stack_functions + sample->first_frame;
+        for(u32 frame_index = 0; frame_index <= sample->frame_count; ++frame_index)
+        {
+            char line_part[SAMPLER_MAX_FUNCTION_NAME + 32];
+            s32  part_length = 0;
+            if(frame_index < sample->frame_count)
+            {
+                part_length = snprintf(line_part, sizeof(line_part), "%s%s", frame_index ? ";" : "", report->functions[stack[frame_index]].name);
+            }
+            else
+            {
+                part_length = snprintf(line_part, sizeof(line_part), " %u\n", run_end - run_start);
+            }
+            part_length = Min(part_length, (s32)sizeof(line_part) - 1);
+
+            if(used + part_length > SAMPLER_REPORT_OUTPUT_SIZE)
+            {
+                result &= c_file_write(&file, buffer, used);
+                used    = 0;
+            }
+            memcpy(buffer + used, line_part, part_length);
+            used += part_length;
+        }
+        run_start = run_end;
+    }
+    if(used) result &= c_file_write(&file, buffer, used);
+    c_file_close(&file);
+
+    if(!result) log_error("Failed to write the folded stacks to '%s'...\n", C_STR(filepath));
+    free(buffer);
+    free(order);
+
+    return(result);
+}
@@ -0,0 +1,248 @@
+#if !defined(C_SAMPLER_H)
+/* ========================================================================
+   $File: c_sampler.h $
+   $Date: October 19 2026 10:05 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define C_SAMPLER_H
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_futex.h>
+#include <c_file_api.h>
+#include <c_memory_arena.h>
+#include <p_platform_data.h>
+
+/* NOTE(Sleepster): Sampling profiler, for the hot spots nobody thought to put a PROFILE_SCOPE around.
+ *
+ * Every thread that called c_sampler_register_thread() gets a timer on its own CPU clock. While the sampler is
+ * running that timer sends the thread SIGPROF 'frequency_hz' times per second of CPU it burns, the handler walks the
+ * frame pointers from the interrupted instruction out and pushes the addresses into the thread's ring. One producer
+ * (the handler) and one consumer (the drain thread) per ring, so it's a write index and a read index, no locks. A
+ * full ring drops the sample and counts it.
+ *
+ * The drain thread empties the rings every SAMPLER_DRAIN_INTERVAL_MS and writes the raw addresses to the capture
+ * file along with the modules that were mapped at the start and the end of the capture. Nothing gets symbolized
+ * while the game runs. c_sampler_report_load() does that afterwards against the ELF symbols of each module, the
+ * report tool ('sampler_report <capture>') prints the top functions and writes folded stacks that flamegraph.pl or
+ * speedscope take as is.
+ *
+ * Stacks only walk through code built with frame pointers, the makefile builds everything that way. A sample taken
+ * in something that wasn't (libc, the driver) still has the function it was in, the walk just stops there.
+ *
+ * Linux only for now, c_sampler_start() fails everywhere else. c_sampler_register_thread() is safe to call anywhere.
+ */
+
+#define SAMPLER_MAX_THREADS         (64)
+#define SAMPLER_MAX_DEPTH           (SYS_SAMPLER_MAX_FRAMES)
+#define SAMPLER_MAX_MODULES         (256)
+#define SAMPLER_RING_SAMPLE_COUNT   (512)
+#define SAMPLER_DEFAULT_FREQUENCY   (997)
+#define SAMPLER_DRAIN_INTERVAL_MS   (10)
+#define SAMPLER_OUTPUT_SIZE         (KB(256))
+#define SAMPLER_MAX_PATH_LENGTH     (256)
+#define SAMPLER_MAX_NAME_LENGTH     (64)
+
+StaticAssert((SAMPLER_RING_SAMPLE_COUNT & (SAMPLER_RING_SAMPLE_COUNT - 1)) == 0, "Sampler ring size must be a power of two...\n");
+
+#if !defined(FOURCC)
+    #define FOURCC(string) (((u32)(string[0]) << 0) | ((u32)(string[1]) << 8) | ((u32)(string[2]) << 16) | ((u32)(string[3]) << 24))
+#endif
+
+#define SAMPLER_FILE_MAGIC          (FOURCC("smpl"))
+#define SAMPLER_FILE_VERSION        (1)
+
+/* NOTE(Sleepster): The capture file is the header and then records, each one a sampler_record_header_t and 'size'
+ * bytes of body. A thread record always comes before the first sample of its slot, a slot that gets reused by
+ * another thread gets a new thread record. Module records can repeat, the reader keeps the first of each.
+ */
+enum sampler_record_type_t
+{
+    SRT_Module,    // NOTE(Sleepster): sampler_module_record_t, then the path, null terminated
+    SRT_Thread,    // NOTE(Sleepster): sampler_thread_record_t, then the name, null terminated
+    SRT_Sample,    // NOTE(Sleepster): sampler_sample_record_t, then frame_count u64 addresses, leaf first
+    SRT_Dropped,   // NOTE(Sleepster): sampler_dropped_record_t
+};
+
+#pragma pack(push, 1)
+struct sampler_file_header_t
+{
+    u32 magic;
+    u32 version;
+    u32 frequency_hz;
+    u32 reserved;
+};
+
+struct sampler_record_header_t
+{
+    u16 type;
+    u16 reserved;
+    u32 size;
+};
+
+struct sampler_module_record_t
+{
+    u64 load_bias;
+    u64 start;
+    u64 end;
+};
+
+struct sampler_thread_record_t
+{
+    u32 slot_index;
+    u32 thread_id;
+};
+
+struct sampler_sample_record_t
+{
+    u32 slot_index;
+    u32 frame_count;
+};
+
+struct sampler_dropped_record_t
+{
+    u32 slot_index;
+    u32 dropped_count;
+};
+#pragma pack(pop)
+
+/*===========================================
+  ================ CAPTURE ==================
+  ===========================================*/
+
+struct sampler_sample_t
+{
+    u32 frame_count;
+    u32 reserved;
+    u64 frames[SAMPLER_MAX_DEPTH];
+};
+
+struct sampler_thread_ring_t
+{
+    // NOTE(Sleepster): write_index and dropped_samples belong to the signal handler, read_index to the drain.
+    volatile u32     write_index;
+    volatile u32     read_index;
+    volatile u32     dropped_samples;
+    sampler_sample_t samples[SAMPLER_RING_SAMPLE_COUNT];
+};
+
+enum sampler_slot_state_t
+{
+    SSS_Free,
+    SSS_Active,
+    SSS_Exited,    // NOTE(Sleepster): The thread is gone, the drain frees the slot once it's emptied the ring.
+};
+
+struct sampler_thread_slot_t
+{
+    volatile u32           state;
+    sys_sampler_thread_t   sys_thread;
+    sampler_thread_ring_t *ring;
+    char                   name[SAMPLER_MAX_NAME_LENGTH];
+    bool8                  name_written;
+    bool8                  timer_running;
+    u32                    dropped_written;
+};
+
+struct sampler_t
+{
+    // NOTE(Sleepster): Guards the slots, start and stop. Never taken in the signal handler.
+    futex_mutex_t          lock;
+    sampler_thread_slot_t  slots[SAMPLER_MAX_THREADS];
+    u32                    slot_count;
+    bool8                  handler_installed;
+    bool8                  registration_failed;
+
+    volatile u32           is_running;
+    u32                    frequency_hz;
+    sys_thread_t           drain_thread;
+    futex_semaphore_t      drain_wake;
+
+    char                   output_path[SAMPLER_MAX_PATH_LENGTH];
+    file_t                 output_file;
+    byte                  *output_buffer;
+    u32                    output_used;
+    bool8                  output_failed;
+    u64                    samples_written;
+    u64                    samples_dropped;
+
+    sys_module_t           modules[SAMPLER_MAX_MODULES];
+};
+
+void  c_sampler_register_thread(const char *name);
+bool8 c_sampler_start(const char *path, u32 frequency_hz);
+void  c_sampler_stop(void);
+bool8 c_sampler_is_running(void);
+
+/*===========================================
+  ================ REPORT ===================
+  ===========================================*/
+
+#define SAMPLER_INVALID_FUNCTION    (0xFFFFFFFF)
+
+struct sampler_symbol_t
+{
+    u64         address;
+    u64         size;
+    const char *name;
+    u32         function_index;
+};
+
+struct sampler_module_t
+{
+    u64               load_bias;
+    u64               start;
+    u64               end;
+    const char       *path;
+
+    bool8             symbols_loaded;
+    sampler_symbol_t *symbols;
+    u32               symbol_count;
+    u32               function_index;    // NOTE(Sleepster): '[module]', for addresses that aren't in any symbol.
+};
+
+struct sampler_function_t
+{
+    const char *name;
+    bool8       is_thread;
+    u64         self_samples;
+    u64         total_samples;
+    u64         last_sample;
+};
+
+struct sampler_report_sample_t
+{
+    u32 first_frame;     // NOTE(Sleepster): Into stack_functions, root (the thread) first.
+    u32 frame_count;
+};
+
+struct sampler_report_t
+{
+    memory_arena_t           arena;
+    bool8                    is_valid;
+    u32                      frequency_hz;
+    u64                      dropped_samples;
+
+    sampler_module_t         modules[SAMPLER_MAX_MODULES];
+    u32                      module_count;
+
+    sampler_function_t      *functions;
+    u32                      function_count;
+    u32                      function_capacity;
+    u32                      unknown_function_index;
+
+    sampler_report_sample_t *samples;
+    u32                      sample_count;
+    u32                     *stack_functions;
+    u32                      stack_function_count;
+};
+
+bool8 c_sampler_report_load(sampler_report_t *report, string_t filepath);
+void  c_sampler_report_destroy(sampler_report_t *report);
+bool8 c_sampler_report_write_folded(sampler_report_t *report, string_t filepath);
+u32   c_sampler_report_get_top(sampler_report_t *report, sampler_function_t **functions_out, u32 max_count);
+void  c_sampler_report_log_top(sampler_report_t *report, u32 max_count);
+
+#endif // C_SAMPLER_H
@@ -0,0 +1,267 @@
+/* ========================================================================
+   $File: c_stats_export.cpp $
+   $Date: October 19 2026 07:10 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_log.h>
+
+#include <c_stats_export.h>
+#include <c_memory_telemetry.h>
+
+StaticAssert((sizeof(stats_export_header_t) % 8) == 0, "The stats export snapshot has to start 8 byte aligned...\n");
+
+/*===========================================
+  ================= WRITER ==================
+  ===========================================*/
+
+bool8
+c_stats_export_open(stats_exporter_t *exporter, const char *name)
+{
+    ZeroStruct(*exporter);
+    if(!sys_shared_memory_create(&exporter->shared, name, sizeof(stats_export_region_t))) return(false);
+
+    // NOTE(Sleepster): Zeroed, so a reader that maps it now sees sequence 0, "nothing yet".
+    exporter->region = (stats_export_region_t*)exporter->shared.data;
+    exporter->region->header.version       = STATS_EXPORT_VERSION;
+    exporter->region->header.snapshot_size = sizeof(stats_export_snapshot_t);
+    AtomicStore32(&exporter->region->header.magic, STATS_EXPORT_MAGIC);
+    exporter->is_open = true;
+
+    log_info("Stats export: publishing '%u' bytes a frame to shared memory '%s'...\n",
+             (u32)sizeof(stats_export_region_t), exporter->shared.name);
+    return(true);
+}
+
+void
+c_stats_export_close(stats_exporter_t *exporter)
+{
+    if(!exporter->is_open) return;
+
+    sys_shared_memory_close(&exporter->shared);
+    ZeroStruct(*exporter);
+}
+
+internal_api void
+c_stats_export_copy_memory(stats_export_memory_t *memory, memory_telemetry_latest_t *latest)
+{
+    snprintf(memory->name, sizeof(memory->name), "%s", latest->name);
+    memory->kind             = latest->kind;
+    memory->current_bytes    = latest->sample.current_bytes;
+    memory->peak_bytes       = latest->sample.peak_bytes;
+    memory->committed_bytes  = latest->sample.committed_bytes;
+    memory->reserved_bytes   = latest->sample.reserved_bytes;
+    memory->allocation_count = latest->sample.allocation_count;
+}
+
+void
+c_stats_export_frame_end(stats_exporter_t *exporter, stats_export_frame_t *frame)
+{
+    if(!exporter->is_open) return;
+
+    stats_export_snapshot_t *snapshot = &exporter->snapshot;
+    snapshot->frame_index          += 1;
+    snapshot->uptime_seconds       += frame->frame_ms / 1000.0f;
+    snapshot->frame_ms              = frame->frame_ms;
+    snapshot->render_wait_ms        = frame->render_wait_ms;
+    snapshot->tick_index            = frame->tick_index;
+    snapshot->threadpool_queued     = frame->threadpool_queued;
+    snapshot->asset_loads_in_flight = frame->asset_loads_in_flight;
+    snapshot->network               = frame->network;
+
+    // NOTE(Sleepster): The rates only move once a second, a single frame's worth of ticks is either 0, 1 or 2.
+    exporter->window_seconds += frame->frame_ms / 1000.0f;
+    exporter->window_frames  += 1;
+    exporter->window_max_ms   = Max(exporter->window_max_ms, frame->frame_ms);
+    if(exporter->window_seconds >= 1.0f)
+    {
+        snapshot->frames_per_second = (float32)exporter->window_frames / exporter->window_seconds;
+        snapshot->ticks_per_second  = (float32)(frame->tick_index - exporter->window_start_tick) / exporter->window_seconds;
+        snapshot->frame_ms_average  = (exporter->window_seconds * 1000.0f) / (float32)exporter->window_frames;
+        snapshot->frame_ms_max      = exporter->window_max_ms;
+
+        exporter->window_seconds    = 0.0f;
+        exporter->window_frames     = 0;
+        exporter->window_max_ms     = 0.0f;
+        exporter->window_start_tick = frame->tick_index;
+    }
+
+    memory_telemetry_latest_t latest[STATS_EXPORT_MAX_MEMORY_ENTRIES];
+    u32 latest_count = c_memory_telemetry_get_latest(latest, STATS_EXPORT_MAX_MEMORY_ENTRIES);
+    ZeroStruct(snapshot->memory_total);
+    snprintf(snapshot->memory_total.name, sizeof(snapshot->memory_total.name), "total");
+    for(u32 entry_index = 0; entry_index < latest_count; ++entry_index)
+    {
+        stats_export_memory_t *memory = snapshot->memory + entry_index;
+        c_stats_export_copy_memory(memory, latest + entry_index);
+
+        snapshot->memory_total.current_bytes    += memory->current_bytes;
+        snapshot->memory_total.peak_bytes       += memory->peak_bytes;
+        snapshot->memory_total.committed_bytes  += memory->committed_bytes;
+        snapshot->memory_total.reserved_bytes   += memory->reserved_bytes;
+        snapshot->memory_total.allocation_count += memory->allocation_count;
+    }
+    snapshot->memory_entry_count = latest_count;
+
+    // NOTE(Sleepster): Odd, then the snapshot, then even. Only the entries in use get copied.
+    usize publish_size = OffsetOfInt(stats_export_snapshot_t, memory) + (latest_count * sizeof(stats_export_memory_t));
+    AtomicStore64(&exporter->region->header.sequence, exporter->sequence + 1);
+    sfence();
+    memcpy(&exporter->region->snapshot, snapshot, publish_size);
+    AtomicStore64(&exporter->region->header.sequence, exporter->sequence + 2);
+    exporter->sequence += 2;
+}
+
+/*===========================================
+  ================= READER ==================
+  ===========================================*/
+
+bool8
+c_stats_export_attach(sys_shared_memory_t *shared, const char *name)
+{
+    bool8 result = false;
+    if(!sys_shared_memory_open(shared, name)) return(result);
+
+    stats_export_header_t *header = (stats_export_header_t*)shared->data;
+    if(shared->size < sizeof(stats_export_region_t))
+    {
+        log_error("Shared memory '%s' is '%llu' bytes, too small for a stats export...\n", shared->name, (unsigned long long)shared->size);
+    }
+    else if((u32)AtomicLoad32(&header->magic) != STATS_EXPORT_MAGIC)
+    {
+        log_error("Shared memory '%s' isn't a stats export...\n", shared->name);
+    }
+    else if(header->version != STATS_EXPORT_VERSION || header->snapshot_size != sizeof(stats_export_snapshot_t))
+    {
+        log_error("Stats export '%s' is version '%u' ('%u' bytes), this reader knows version '%u' ('%u' bytes)...\n",
+                  shared->name, header->version, header->snapshot_size, STATS_EXPORT_VERSION, (u32)sizeof(stats_export_snapshot_t));
+    }
+    else
+    {
+        result = true;
+    }
+
+    if(!result) sys_shared_memory_close(shared);
+    return(result);
+}
+
+bool8
+c_stats_export_read(stats_export_region_t *region, stats_export_snapshot_t *snapshot_out, u64 *sequence_out, u32 max_attempts)
+{
+    bool8 result = false;
+    for(u32 attempt_index = 0; attempt_index < max_attempts && !result; ++attempt_index)
+    {
+        u64 before = (u64)AtomicLoad64(&region->header.sequence);
+        if(before == 0) break;
+        if(before & 1)
+        {
+            sys_thread_yield();
+            continue;
+        }
+
+        memcpy(snapshot_out, &region->snapshot, sizeof(stats_export_snapshot_t));
+        lfence();
+        u64 after = (u64)AtomicLoad64(&region->header.sequence);
+        if(before == after)
+        {
+            // NOTE(Sleepster): Entries past the count are whatever an older frame left there.
+            snapshot_out->memory_entry_count = Min(snapshot_out->memory_entry_count, (u32)STATS_EXPORT_MAX_MEMORY_ENTRIES);
+            if(sequence_out) *sequence_out = after;
+            result = true;
+        }
+    }
+
+    return(result);
+}
+
+/*===========================================
+  =============== PROMETHEUS ================
+  ===========================================*/
+
+struct stats_export_text_t
+{
+    char *buffer;
+    u32   size;
+    u32   used;
+    bool8 overflowed;
+};
+
+internal_api void
+c_stats_export_append(stats_export_text_t *text, const char *format, ...)
+{
+    if(text->overflowed) return;
+
+    va_list args;
+    va_start(args, format);
+    s32 written = vsnprintf(text->buffer + text->used, text->size - text->used, format, args);
+    va_end(args);
+
+    if(written < 0 || (u32)written >= text->size - text->used) text->overflowed = true;
+    else                                                       text->used      += (u32)written;
+}
+
+internal_api void
+c_stats_export_append_metric(stats_export_text_t *text, const char *name, const char *type, const char *help, float64 value)
+{
+    c_stats_export_append(text, "# HELP engine_%s %s\n# TYPE engine_%s %s\nengine_%s %.17g\n", name, help, name, type, name, value);
+}
+
+// NOTE(Sleepster): One family, a sample for the total and one for every entry.
+internal_api void
+c_stats_export_append_memory(stats_export_text_t *text, stats_export_snapshot_t *snapshot, const char *name,
+                             const char *help, u32 value_offset)
+{
+    c_stats_export_append(text, "# HELP engine_memory_%s %s\n# TYPE engine_memory_%s gauge\n", name, help, name);
+    for(s32 entry_index = -1; entry_index < (s32)snapshot->memory_entry_count; ++entry_index)
+    {
+        stats_export_memory_t *memory = entry_index < 0 ? &snapshot->memory_total : snapshot->memory + entry_index;
+        const char *kind = entry_index < 0 ? "total" : c_memory_telemetry_get_kind_name(memory->kind);
+        u64 value        = *(u64*)((u8*)memory + value_offset);
+        c_stats_export_append(text, "engine_memory_%s{name=\"%.*s\",kind=\"%s\"} %llu\n",
+                              name, STATS_EXPORT_NAME_LENGTH, memory->name, kind, (unsigned long long)value);
+    }
+}
+
+u32
+c_stats_export_format_prometheus(stats_export_snapshot_t *snapshot, char *buffer, u32 buffer_size)
+{
+    stats_export_text_t text = {buffer, buffer_size, 0, false};
+    stats_export_network_t *network = &snapshot->network;
+
+    c_stats_export_append_metric(&text, "frames_total",                   "counter", "Frames since startup.",                        (float64)snapshot->frame_index);
+    c_stats_export_append_metric(&text, "uptime_seconds",                 "gauge",   "Seconds of frames since startup.",             snapshot->uptime_seconds);
+    c_stats_export_append_metric(&text, "frame_ms",                       "gauge",   "The last frame's time.",                       snapshot->frame_ms);
+    c_stats_export_append_metric(&text, "frame_ms_average",               "gauge",   "Average frame time over the last second.",     snapshot->frame_ms_average);
+    c_stats_export_append_metric(&text, "frame_ms_max",                   "gauge",   "Longest frame over the last second.",          snapshot->frame_ms_max);
+    c_stats_export_append_metric(&text, "frames_per_second",              "gauge",   "Frames over the last second.",                 snapshot->frames_per_second);
+    c_stats_export_append_metric(&text, "ticks_total",                    "counter", "Simulation ticks since startup.",              (float64)snapshot->tick_index);
+    c_stats_export_append_metric(&text, "ticks_per_second",               "gauge",   "Simulation ticks over the last second.",       snapshot->ticks_per_second);
+    c_stats_export_append_metric(&text, "render_wait_ms",                 "gauge",   "How long the last frame waited on rendering.", snapshot->render_wait_ms);
+    c_stats_export_append_metric(&text, "threadpool_queued_tasks",        "gauge",   "Tasks still queued at the end of the frame.",  (float64)snapshot->threadpool_queued);
+    c_stats_export_append_metric(&text, "asset_loads_in_flight",          "gauge",   "Asset loads that haven't finished.",           (float64)snapshot->asset_loads_in_flight);
+    c_stats_export_append_metric(&text, "network_packets_sent_total",     "counter", "Packets sent.",                                (float64)network->packets_sent);
+    c_stats_export_append_metric(&text, "network_bytes_sent_total",       "counter", "Bytes sent.",                                  (float64)network->bytes_sent);
+    c_stats_export_append_metric(&text, "network_packets_received_total", "counter", "Packets received.",                            (float64)network->packets_received);
+    c_stats_export_append_metric(&text, "network_bytes_received_total",   "counter", "Bytes received.",                              (float64)network->bytes_received);
+    c_stats_export_append_metric(&text, "network_send_errors_total",      "counter", "sendto() calls that failed.",                  (float64)network->send_errors);
+    c_stats_export_append_metric(&text, "network_invalid_packets_total",  "counter", "Received packets without our magic.",          (float64)network->invalid_packets);
+    c_stats_export_append_metric(&text, "network_connected_clients",      "gauge",   "Connected clients, this one included.",        (float64)network->connected_clients);
+    c_stats_export_append_metric(&text, "network_is_host",                "gauge",   "1 when this instance is the host.",            (float64)network->is_host);
+
+    c_stats_export_append_memory(&text, snapshot, "current_bytes",   "Bytes handed out right now.",         OffsetOfInt(stats_export_memory_t, current_bytes));
+    c_stats_export_append_memory(&text, snapshot, "peak_bytes",      "Most bytes ever handed out at once.", OffsetOfInt(stats_export_memory_t, peak_bytes));
+    c_stats_export_append_memory(&text, snapshot, "committed_bytes", "Bytes ever touched.",                 OffsetOfInt(stats_export_memory_t, committed_bytes));
+    c_stats_export_append_memory(&text, snapshot, "reserved_bytes",  "Address space reserved.",             OffsetOfInt(stats_export_memory_t, reserved_bytes));
+    c_stats_export_append_memory(&text, snapshot, "allocations",     "Live allocations.",                   OffsetOfInt(stats_export_memory_t, allocation_count));
+
+    u32 result = text.overflowed ? 0 : text.used;
+    return(result);
+}
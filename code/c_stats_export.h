@@ -0,0 +1,151 @@
+#if !defined(C_STATS_EXPORT_H)
+/* ========================================================================
+   $File: c_stats_export.h $
+   $Date: October 19 2026 07:10 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define C_STATS_EXPORT_H
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <p_platform_data.h>
+
+/* NOTE(Sleepster): Live numbers for something outside the process to watch, a headless server has no overlay to
+ * look at.
+ *
+ * c_stats_export_open() creates a named shared memory region and once a frame c_stats_export_frame_end() publishes
+ * a stats_export_snapshot_t into it: frame times, tick rate, the threadpool's queue, asset loads in flight, the
+ * memory telemetry and the network counters. Publishing is a copy into memory that's already mapped, there are no
+ * syscalls on the frame.
+ *
+ * The region is a stats_export_header_t with the snapshot right after it. Readers never take a lock, the header's
+ * sequence is a seqlock: odd while the engine is writing the snapshot, the next even number once it's done. Copy
+ * the snapshot out between two reads of the sequence and keep it when both were the same even number,
+ * c_stats_export_read() does that. A reader can't slow the engine down, the worst it gets is a retry.
+ *
+ * The layout is versioned: bump STATS_EXPORT_VERSION whenever the snapshot changes, c_stats_export_attach() won't
+ * take a version or a size it doesn't know. Everything in it is fixed size so the other end doesn't have to be built
+ * with the same compiler.
+ *
+ * 'stats_monitor' (code/stats_monitor/) tails it or prints it in Prometheus' text format.
+ *
+ * Main thread only, after c_memory_telemetry_frame_end().
+ */
+
+#define STATS_EXPORT_MAGIC              (0x54415453) // NOTE(Sleepster): 'STAT'
+#define STATS_EXPORT_VERSION            (1)
+#define STATS_EXPORT_MAX_MEMORY_ENTRIES (32)
+#define STATS_EXPORT_NAME_LENGTH        (32)
+#define STATS_EXPORT_DEFAULT_NAME       "newsdl_stats"
+#define STATS_EXPORT_PROMETHEUS_SIZE    (KB(16))
+
+struct stats_export_memory_t
+{
+    char    name[STATS_EXPORT_NAME_LENGTH];
+    u32     kind;                  // NOTE(Sleepster): memory_telemetry_kind_t
+    u32     padding;
+    u64     current_bytes;
+    u64     peak_bytes;
+    u64     committed_bytes;
+    u64     reserved_bytes;
+    u64     allocation_count;
+};
+
+// NOTE(Sleepster): Since startup.
+struct stats_export_network_t
+{
+    u64     packets_sent;
+    u64     bytes_sent;
+    u64     packets_received;
+    u64     bytes_received;
+    u64     send_errors;
+    u64     invalid_packets;
+    u32     connected_clients;
+    u32     is_host;
+};
+
+struct stats_export_snapshot_t
+{
+    u64                    frame_index;
+    float64                uptime_seconds;
+
+    // NOTE(Sleepster): frame_ms is the last frame, the rest are over the last full second.
+    float32                frame_ms;
+    float32                frame_ms_average;
+    float32                frame_ms_max;
+    float32                frames_per_second;
+    float32                ticks_per_second;
+    float32                render_wait_ms;
+    u64                    tick_index;
+
+    u32                    threadpool_queued;
+    u32                    asset_loads_in_flight;
+
+    stats_export_network_t network;
+
+    stats_export_memory_t  memory_total;
+    u32                    memory_entry_count;
+    u32                    padding;
+    stats_export_memory_t  memory[STATS_EXPORT_MAX_MEMORY_ENTRIES];
+};
+
+struct stats_export_header_t
+{
+    u32                    magic;
+    u32                    version;
+    u32                    snapshot_size;
+    u32                    padding;
+    volatile u64           sequence;
+};
+
+struct stats_export_region_t
+{
+    stats_export_header_t   header;
+    stats_export_snapshot_t snapshot;
+};
+
+// NOTE(Sleepster): What the caller knows about the frame, the memory telemetry the exporter reads itself.
+struct stats_export_frame_t
+{
+    float32                frame_ms;
+    float32                render_wait_ms;
+    u64                    tick_index;
+    u32                    threadpool_queued;
+    u32                    asset_loads_in_flight;
+    stats_export_network_t network;
+};
+
+struct stats_exporter_t
+{
+    bool8                   is_open;
+    sys_shared_memory_t     shared;
+    stats_export_region_t  *region;
+    u64                     sequence;
+
+    // NOTE(Sleepster): Built here, then copied into the region under the seqlock.
+    stats_export_snapshot_t snapshot;
+
+    // NOTE(Sleepster): The second that's being measured right now.
+    float32                 window_seconds;
+    u32                     window_frames;
+    float32                 window_max_ms;
+    u64                     window_start_tick;
+};
+
+bool8 c_stats_export_open(stats_exporter_t *exporter, const char *name);
+void  c_stats_export_close(stats_exporter_t *exporter);
+void  c_stats_export_frame_end(stats_exporter_t *exporter, stats_export_frame_t *frame);
+
+// NOTE(Sleepster): Reader side. Maps somebody's region read only, false if it isn't there or isn't a layout we know.
+bool8 c_stats_export_attach(sys_shared_memory_t *shared, const char *name);
+
+// NOTE(Sleepster): A copy of the snapshot that isn't torn, false when nothing's been published yet or the writer was
+//                  in the middle of every one of 'max_attempts'.
+bool8 c_stats_export_read(stats_export_region_t *region, stats_export_snapshot_t *snapshot_out, u64 *sequence_out, u32 max_attempts);
+
+// NOTE(Sleepster): Prometheus' text exposition format, returns the length, 0 if it didn't fit.
+u32   c_stats_export_format_prometheus(stats_export_snapshot_t *snapshot, char *buffer, u32 buffer_size);
+
+#endif // C_STATS_EXPORT_H
@@ -472,7 +472,7 @@ c_string_builder_create_and_attach_buffer(string_builder_t *builder, u64 block_s
 
     result->buffer_size = block_size;
     result->next_buffer = null;
-    result->buffer_data = c_arena_push_size(&builder->arena, u64(block_size * 0.25f));
+    result->buffer_data = c_arena_push_size(&builder->arena, block_size);
     if(builder->current_buffer)
     {
         builder->current_buffer->next_buffer = result;
@@ -529,6 +529,8 @@ c_string_builder_append_data(string_builder_t *builder, string_t data)
     {
         c_string_builder_advance_buffer(builder);
         Assert(current_buffer->next_buffer);
+
+        current_buffer = builder->current_buffer;
         Assert(current_buffer->buffer_data);
     }
 
@@ -585,6 +587,7 @@ c_string_builder_reset(string_builder_t *builder)
     builder->total_allocated = 0;
     builder->current_buffer  = null;
     builder->current_buffer  = c_string_builder_create_and_attach_buffer(builder, builder->default_buffer_block_size);
+    builder->first_buffer    = builder->current_buffer;
 }
 
 bool8 
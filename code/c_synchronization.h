@@ -12,12 +12,16 @@
     typedef void* sys_semaphore_handle_t;
     typedef void* sys_mutex_handle_t;
     typedef void* sys_thread_handle_t;
+    typedef void* sys_fiber_handle_t;
 #elif OS_LINUX
 #include <SDL3/SDL.h>
 
 typedef SDL_Semaphore* sys_semaphore_handle_t;
 typedef SDL_Mutex*     sys_mutex_handle_t;
 typedef SDL_Thread*    sys_thread_handle_t;
+
+// NOTE(Sleepster): Saved stack pointer, the rest of the context lives on the fiber's stack.
+typedef void*          sys_fiber_handle_t;
 #elif OS_MAC
 #error "not implemented...\n"
 #endif
@@ -42,5 +46,30 @@ typedef struct sys_semaphore
     sys_semaphore_handle_t handle;
 }sys_semaphore_t;
 
+// NOTE(Sleepster): Fiber procs must NEVER return, switch to another fiber instead.
+typedef void sys_fiber_proc_t(void *user_data);
+
+typedef struct sys_fiber
+{
+    sys_fiber_handle_t  handle;
+    void               *stack;
+    usize               stack_size;
+
+    sys_fiber_proc_t   *proc;
+    void               *user_data;
+}sys_fiber_t;
+
+/* NOTE(Sleepster): Futex, sleep while *address == expected_value. The compare and the sleep are atomic with respect
+ * to sys_futex_wake(), so a wake that comes in between can't get lost. Wakeups can be spurious, always recheck.
+ * timeout_ms of 0 means forever, returns false if it timed out. SYS_FUTEX_WAKE_ALL wakes every waiter.
+ *
+ * These are declared here instead of p_platform_data.h so c_futex.h works in the headers p_platform_data.h pulls
+ * in itself (the zone allocator).
+ */
+#define SYS_FUTEX_WAKE_ALL (0xFFFFFFFF)
+
+bool8 sys_futex_wait(volatile u32 *address, u32 expected_value, u32 timeout_ms);
+void  sys_futex_wake(volatile u32 *address, u32 wake_count);
+
 #endif // C_SYNCHRONIZATION_H
 
@@ -0,0 +1,554 @@
+/* ========================================================================
+   $File: c_task_graph.cpp $
+   $Date: October 18 2026 10:40 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdarg.h>
+#include <stdio.h>
+#include <SDL3/SDL.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_log.h>
+
+#include <c_task_graph.h>
+#include <c_profiler.h>
+#include <c_file_api.h>
+#include <p_platform_data.h>
+
+#define TASK_GRAPH_COST_SMOOTHING     (0.1)
+#define TASK_GRAPH_DEFAULT_COST_MS    (1.0)
+#define TASK_GRAPH_CRITICAL_TOLERANCE (0.01)
+#define TASK_GRAPH_DOT_BUFFER_SIZE    (KB(64))
+
+struct task_graph_task_payload_t
+{
+    task_graph_t *graph;
+    u32           node_id;
+};
+
+internal_api void c_task_graph_submit_ready(task_graph_t *graph, u64 ready_mask);
+
+internal_api inline u64
+c_task_graph_node_bit(u32 node_id)
+{
+    u64 result = 1ull << node_id;
+    return(result);
+}
+
+internal_api inline float64
+c_task_graph_counter_to_ms(task_graph_t *graph, u64 counter_delta)
+{
+    float64 result = ((float64)counter_delta * 1000.0) / (float64)graph->counter_frequency;
+    return(result);
+}
+
+internal_api void
+c_task_graph_run_node(task_graph_t *graph, u32 node_id, bool8 on_caller)
+{
+    task_graph_node_t *node = graph->nodes + node_id;
+
+    u64 start_counter = SDL_GetPerformanceCounter();
+    {
+        PROFILE_SCOPE(node->name);
+        node->callback(node->user_data);
+    }
+    u64 end_counter   = SDL_GetPerformanceCounter();
+
+    // NOTE(Sleepster): Only the thread that ran the node writes these, the caller reads them after the frame.
+    node->start_ms      = c_task_graph_counter_to_ms(graph, start_counter - graph->frame_start_counter);
+    node->end_ms        = c_task_graph_counter_to_ms(graph, end_counter   - graph->frame_start_counter);
+    node->duration_ms   = node->end_ms - node->start_ms;
+    node->ran_on_caller = on_caller;
+    if(node->duration_ms > node->max_duration_ms)
+    {
+        node->max_duration_ms = node->duration_ms;
+    }
+
+    u64 ready_mask = 0;
+    for(u32 successor_id = node_id + 1;
+        successor_id < graph->node_count;
+        ++successor_id)
+    {
+        if((node->successor_mask & c_task_graph_node_bit(successor_id)) == 0) continue;
+
+        task_graph_node_t *successor = graph->nodes + successor_id;
+        if(AtomicDecrement32(&successor->pending_predecessors) == 1)
+        {
+            ready_mask |= c_task_graph_node_bit(successor_id);
+        }
+    }
+    c_task_graph_submit_ready(graph, ready_mask);
+
+    // NOTE(Sleepster): Last thing we touch, execute() can return as soon as this hits node_count.
+    AtomicIncrement32(&graph->nodes_completed);
+}
+
+internal_api void
+c_task_graph_node_task(void *user_data)
+{
+    task_graph_task_payload_t *payload = (task_graph_task_payload_t*)user_data;
+    c_task_graph_run_node(payload->graph, payload->node_id, false);
+}
+
+/* NOTE(Sleepster): Pool nodes are sorted by bottom level, shortest first. The owner pops its deque LIFO so the
+ * longest chain, pushed last, is the first one to run here and the shorter ones are what gets stolen.
+ */
+internal_api void
+c_task_graph_submit_ready(task_graph_t *graph, u64 ready_mask)
+{
+    u32 pool_nodes[TASK_GRAPH_MAX_NODES];
+    u32 pool_node_count = 0;
+    for(u32 node_id = 0;
+        ready_mask != 0 && node_id < graph->node_count;
+        ++node_id)
+    {
+        if((ready_mask & c_task_graph_node_bit(node_id)) == 0) continue;
+        ready_mask &= ~c_task_graph_node_bit(node_id);
+
+        task_graph_node_t *node = graph->nodes + node_id;
+        if(node->flags & TGNF_MainThread)
+        {
+            bool8 pushed = c_queue_push(&graph->main_thread_queue, &node_id);
+            Assert(pushed);
+        }
+        else
+        {
+            u32 insert_index = pool_node_count++;
+            while(insert_index > 0 &&
+                  graph->nodes[pool_nodes[insert_index - 1]].bottom_level_ms > node->bottom_level_ms)
+            {
+                pool_nodes[insert_index] = pool_nodes[insert_index - 1];
+                --insert_index;
+            }
+            pool_nodes[insert_index] = node_id;
+        }
+    }
+
+    if(pool_node_count > 0)
+    {
+        threadpool_task_t critical_tasks[TASK_GRAPH_MAX_NODES];
+        threadpool_task_t slack_tasks[TASK_GRAPH_MAX_NODES];
+        u32 critical_task_count = 0;
+        u32 slack_task_count    = 0;
+        for(u32 pool_node_index = 0;
+            pool_node_index < pool_node_count;
+            ++pool_node_index)
+        {
+            task_graph_task_payload_t payload = {graph, pool_nodes[pool_node_index]};
+            threadpool_task_t task = c_threadpool_make_inline_task(c_task_graph_node_task, &payload, sizeof(payload));
+            if(graph->nodes[payload.node_id].is_critical) critical_tasks[critical_task_count++] = task;
+            else                                          slack_tasks[slack_task_count++]       = task;
+        }
+
+        if(slack_task_count > 0)
+        {
+            c_threadpool_add_tasks(graph->pool, slack_tasks, slack_task_count, TPTP_Low);
+        }
+        if(critical_task_count > 0)
+        {
+            c_threadpool_add_tasks(graph->pool, critical_tasks, critical_task_count, TPTP_High);
+        }
+    }
+}
+
+/* NOTE(Sleepster): Nodes are in topological order already (edges only point forward) so both levels are one pass.
+ *   bottom level - the node's cost plus the longest chain after it
+ *   top level    - the longest chain before it, so the earliest it could possibly start
+ * A node is on the critical path when top + bottom is the length of the whole graph.
+ */
+internal_api void
+c_task_graph_update_schedule(task_graph_t *graph)
+{
+    graph->critical_path_ms = 0;
+    for(s32 node_id = (s32)graph->node_count - 1;
+        node_id >= 0;
+        --node_id)
+    {
+        task_graph_node_t *node = graph->nodes + node_id;
+
+        float64 longest_successor = 0;
+        for(u32 successor_id = node_id + 1;
+            successor_id < graph->node_count;
+            ++successor_id)
+        {
+            if((node->successor_mask & c_task_graph_node_bit(successor_id)) == 0) continue;
+            longest_successor = Max(longest_successor, graph->nodes[successor_id].bottom_level_ms);
+        }
+
+        node->bottom_level_ms   = node->cost_ms + longest_successor;
+        graph->critical_path_ms = Max(graph->critical_path_ms, node->bottom_level_ms);
+    }
+
+    float64 tolerance = graph->critical_path_ms * TASK_GRAPH_CRITICAL_TOLERANCE;
+    for(u32 node_id = 0;
+        node_id < graph->node_count;
+        ++node_id)
+    {
+        task_graph_node_t *node = graph->nodes + node_id;
+
+        node->top_level_ms = 0;
+        for(u32 predecessor_id = 0;
+            predecessor_id < node_id;
+            ++predecessor_id)
+        {
+            if((node->predecessor_mask & c_task_graph_node_bit(predecessor_id)) == 0) continue;
+
+            task_graph_node_t *predecessor = graph->nodes + predecessor_id;
+            node->top_level_ms = Max(node->top_level_ms, predecessor->top_level_ms + predecessor->cost_ms);
+        }
+        node->is_critical = (node->top_level_ms + node->bottom_level_ms) >= (graph->critical_path_ms - tolerance);
+    }
+}
+
+void
+c_task_graph_init(task_graph_t *graph, threadpool_t *pool)
+{
+    Assert(pool->is_initialized);
+
+    ZeroStruct(*graph);
+    graph->pool              = pool;
+    graph->counter_frequency = SDL_GetPerformanceFrequency();
+    c_queue_create_typed(&graph->main_thread_queue, QK_MPSC, u32, TASK_GRAPH_MAX_NODES);
+}
+
+void
+c_task_graph_destroy(task_graph_t *graph)
+{
+    c_queue_destroy(&graph->main_thread_queue);
+    ZeroStruct(*graph);
+}
+
+u32
+c_task_graph_add_resource(task_graph_t *graph, const char *name)
+{
+    u32 result = TASK_GRAPH_INVALID_ID;
+    if(graph->resource_count < TASK_GRAPH_MAX_RESOURCES)
+    {
+        result = graph->resource_count++;
+        graph->resource_names[result] = name;
+    }
+    else
+    {
+        log_error("Task graph is out of resources, '%s' was not added...\n", name);
+    }
+
+    return(result);
+}
+
+u32
+c_task_graph_add_node(task_graph_t *graph, const char *name, threadpool_callback_t *callback, void *user_data, u32 flags)
+{
+    Assert(callback);
+
+    u32 result = TASK_GRAPH_INVALID_ID;
+    if(graph->node_count < TASK_GRAPH_MAX_NODES)
+    {
+        result = graph->node_count++;
+
+        task_graph_node_t *node = graph->nodes + result;
+        ZeroStruct(*node);
+        node->name      = name;
+        node->callback  = callback;
+        node->user_data = user_data;
+        node->flags     = flags;
+        node->cost_ms   = TASK_GRAPH_DEFAULT_COST_MS;
+
+        graph->is_built = false;
+    }
+    else
+    {
+        log_error("Task graph is out of nodes, '%s' was not added...\n", name);
+    }
+
+    return(result);
+}
+
+internal_api void
+c_task_graph_node_add_access(task_graph_t *graph, u32 node_id, u32 resource_id, u32 access_type)
+{
+    Assert(node_id < graph->node_count);
+    Assert(resource_id < graph->resource_count);
+
+    task_graph_node_t *node = graph->nodes + node_id;
+    if(node->access_count < TASK_GRAPH_MAX_NODE_ACCESSES)
+    {
+        node->resources[node->access_count]    = resource_id;
+        node->access_types[node->access_count] = access_type;
+        ++node->access_count;
+
+        graph->is_built = false;
+    }
+    else
+    {
+        log_error("Task graph node '%s' has too many accesses, '%s' was dropped...\n", node->name, graph->resource_names[resource_id]);
+    }
+}
+
+void
+c_task_graph_node_reads(task_graph_t *graph, u32 node_id, u32 resource_id)
+{
+    c_task_graph_node_add_access(graph, node_id, resource_id, TGA_Read);
+}
+
+void
+c_task_graph_node_writes(task_graph_t *graph, u32 node_id, u32 resource_id)
+{
+    c_task_graph_node_add_access(graph, node_id, resource_id, TGA_Write);
+}
+
+bool8
+c_task_graph_build(task_graph_t *graph)
+{
+    bool8 result = false;
+    if(graph->node_count > 0)
+    {
+        u32 last_writers[TASK_GRAPH_MAX_RESOURCES];
+        u64 readers_since_write[TASK_GRAPH_MAX_RESOURCES];
+        u64 ancestor_masks[TASK_GRAPH_MAX_NODES];
+        for(u32 resource_id = 0;
+            resource_id < graph->resource_count;
+            ++resource_id)
+        {
+            last_writers[resource_id]        = TASK_GRAPH_INVALID_ID;
+            readers_since_write[resource_id] = 0;
+        }
+
+        graph->edge_count = 0;
+        graph->root_mask  = 0;
+        for(u32 node_id = 0;
+            node_id < graph->node_count;
+            ++node_id)
+        {
+            task_graph_node_t *node = graph->nodes + node_id;
+            node->successor_mask = 0;
+
+            u64 dependency_mask = 0;
+            for(u32 access_index = 0;
+                access_index < node->access_count;
+                ++access_index)
+            {
+                u32 resource_id = node->resources[access_index];
+                if(last_writers[resource_id] != TASK_GRAPH_INVALID_ID)
+                {
+                    dependency_mask |= c_task_graph_node_bit(last_writers[resource_id]);
+                }
+                if(node->access_types[access_index] == TGA_Write)
+                {
+                    dependency_mask |= readers_since_write[resource_id];
+                }
+            }
+            dependency_mask &= ~c_task_graph_node_bit(node_id);
+
+            // NOTE(Sleepster): Reads first so a node that reads and writes the same resource ends up as just the writer.
+            for(u32 access_index = 0;
+                access_index < node->access_count;
+                ++access_index)
+            {
+                if(node->access_types[access_index] == TGA_Read)
+                {
+                    readers_since_write[node->resources[access_index]] |= c_task_graph_node_bit(node_id);
+                }
+            }
+            for(u32 access_index = 0;
+                access_index < node->access_count;
+                ++access_index)
+            {
+                if(node->access_types[access_index] == TGA_Write)
+                {
+                    last_writers[node->resources[access_index]]        = node_id;
+                    readers_since_write[node->resources[access_index]] = 0;
+                }
+            }
+
+            // NOTE(Sleepster): Drop the edges that are already implied through another predecessor, every edge is an
+            //                  atomic decrement at runtime and a line in the dump.
+            u64 implied_mask = 0;
+            ancestor_masks[node_id] = dependency_mask;
+            for(u32 predecessor_id = 0;
+                predecessor_id < node_id;
+                ++predecessor_id)
+            {
+                if((dependency_mask & c_task_graph_node_bit(predecessor_id)) == 0) continue;
+
+                implied_mask            |= ancestor_masks[predecessor_id];
+                ancestor_masks[node_id] |= ancestor_masks[predecessor_id];
+            }
+
+            node->predecessor_mask  = dependency_mask & ~implied_mask;
+            node->predecessor_count = PopCount64(node->predecessor_mask);
+            for(u32 predecessor_id = 0;
+                predecessor_id < node_id;
+                ++predecessor_id)
+            {
+                if(node->predecessor_mask & c_task_graph_node_bit(predecessor_id))
+                {
+                    graph->nodes[predecessor_id].successor_mask |= c_task_graph_node_bit(node_id);
+                }
+            }
+
+            graph->edge_count += node->predecessor_count;
+            if(node->predecessor_count == 0)
+            {
+                graph->root_mask |= c_task_graph_node_bit(node_id);
+            }
+        }
+
+        c_task_graph_update_schedule(graph);
+        graph->is_built = true;
+        result          = true;
+
+        log_info("Task graph: '%u' nodes, '%u' resources, '%u' edges, '%u' roots...\n",
+                 graph->node_count, graph->resource_count, graph->edge_count, (u32)PopCount64(graph->root_mask));
+    }
+    else
+    {
+        log_error("Task graph has no nodes to build...\n");
+    }
+
+    return(result);
+}
+
+// NOTE(Sleepster): Call this from the thread that owns the graph (worker 0 of the pool), not from inside a task.
+void
+c_task_graph_execute(task_graph_t *graph)
+{
+    Assert(graph->is_built);
+
+    for(u32 node_id = 0;
+        node_id < graph->node_count;
+        ++node_id)
+    {
+        task_graph_node_t *node = graph->nodes + node_id;
+        AtomicStore32(&node->pending_predecessors, node->predecessor_count);
+    }
+    AtomicStore32(&graph->nodes_completed, 0);
+
+    graph->frame_start_counter = SDL_GetPerformanceCounter();
+    c_task_graph_submit_ready(graph, graph->root_mask);
+
+    while((u32)AtomicLoad32(&graph->nodes_completed) < graph->node_count)
+    {
+        u32 node_id;
+        if(c_queue_pop(&graph->main_thread_queue, &node_id))
+        {
+            c_task_graph_run_node(graph, node_id, true);
+        }
+        else if(!c_threadpool_perform_next_task(graph->pool))
+        {
+            _mm_pause();
+        }
+    }
+    graph->frame_ms = c_task_graph_counter_to_ms(graph, SDL_GetPerformanceCounter() - graph->frame_start_counter);
+
+    for(u32 node_id = 0;
+        node_id < graph->node_count;
+        ++node_id)
+    {
+        task_graph_node_t *node = graph->nodes + node_id;
+        if(graph->frame_index == 0) node->cost_ms  = node->duration_ms;
+        else                        node->cost_ms += (node->duration_ms - node->cost_ms) * TASK_GRAPH_COST_SMOOTHING;
+    }
+    c_task_graph_update_schedule(graph);
+    ++graph->frame_index;
+}
+
+internal_api void
+c_task_graph_append(char *buffer, u32 *used, const char *format, ...)
+{
+    if(*used < TASK_GRAPH_DOT_BUFFER_SIZE)
+    {
+        va_list args;
+        va_start(args, format);
+        s32 written = vsnprintf(buffer + *used, TASK_GRAPH_DOT_BUFFER_SIZE - *used, format, args);
+        va_end(args);
+
+        if(written > 0) *used = Min(*used + (u32)written, (u32)TASK_GRAPH_DOT_BUFFER_SIZE);
+    }
+}
+
+bool8
+c_task_graph_dump_dot(task_graph_t *graph, string_t filepath)
+{
+    bool8 result = false;
+
+    char *buffer = (char*)sys_allocate_memory(TASK_GRAPH_DOT_BUFFER_SIZE);
+    u32   used   = 0;
+    c_task_graph_append(buffer, &used, "digraph task_graph\n{\n");
+    c_task_graph_append(buffer, &used, "    label=\"frame %llu: %.3f ms, critical path %.3f ms\";\n",
+                        (unsigned long long)graph->frame_index, graph->frame_ms, graph->critical_path_ms);
+    c_task_graph_append(buffer, &used, "    rankdir=LR;\n    node [shape=box, fontname=\"monospace\"];\n");
+
+    for(u32 node_id = 0;
+        node_id < graph->node_count;
+        ++node_id)
+    {
+        task_graph_node_t *node = graph->nodes + node_id;
+        c_task_graph_append(buffer, &used, "    n%u [label=\"%s%s\\nlast %.3f ms @ %.3f, avg %.3f, max %.3f\\n",
+                            node_id, node->name, (node->flags & TGNF_MainThread) ? " (main)" : "",
+                            node->duration_ms, node->start_ms, node->cost_ms, node->max_duration_ms);
+
+        for(u32 access_type = TGA_Read; access_type <= TGA_Write; ++access_type)
+        {
+            c_task_graph_append(buffer, &used, access_type == TGA_Read ? "reads:" : "\\nwrites:");
+            for(u32 access_index = 0;
+                access_index < node->access_count;
+                ++access_index)
+            {
+                if(node->access_types[access_index] != access_type) continue;
+                c_task_graph_append(buffer, &used, " %s", graph->resource_names[node->resources[access_index]]);
+            }
+        }
+        c_task_graph_append(buffer, &used, "\"%s];\n", node->is_critical ? ", color=red, penwidth=2" : "");
+    }
+
+    for(u32 node_id = 0;
+        node_id < graph->node_count;
+        ++node_id)
+    {
+        task_graph_node_t *node = graph->nodes + node_id;
+        for(u32 successor_id = node_id + 1;
+            successor_id < graph->node_count;
+            ++successor_id)
+        {
+            if((node->successor_mask & c_task_graph_node_bit(successor_id)) == 0) continue;
+
+            bool8 is_critical_edge = node->is_critical && graph->nodes[successor_id].is_critical;
+            c_task_graph_append(buffer, &used, "    n%u -> n%u%s;\n", node_id, successor_id, is_critical_edge ? " [color=red, penwidth=2]" : "");
+        }
+    }
+    c_task_graph_append(buffer, &used, "}\n");
+
+    file_t file = sys_file_open(filepath, true, true, false);
+    if(file.handle != INVALID_FILE_HANDLE)
+    {
+        result = c_file_write(&file, buffer, used);
+        c_file_close(&file);
+    }
+    else
+    {
+        log_error("Failed to open '%s' for the task graph dump...\n", C_STR(filepath));
+    }
+    sys_free_memory(buffer, TASK_GRAPH_DOT_BUFFER_SIZE);
+
+    return(result);
+}
+
+void
+c_task_graph_log_timings(task_graph_t *graph)
+{
+    log_info("Task graph frame '%llu': '%.3f' ms, critical path '%.3f' ms...\n",
+             (unsigned long long)graph->frame_index, graph->frame_ms, graph->critical_path_ms);
+    for(u32 node_id = 0;
+        node_id < graph->node_count;
+        ++node_id)
+    {
+        task_graph_node_t *node = graph->nodes + node_id;
+        log_info("    %-24s start %8.3f, last %8.3f, avg %8.3f, max %8.3f ms %s%s\n",
+                 node->name, node->start_ms, node->duration_ms, node->cost_ms, node->max_duration_ms,
+                 node->ran_on_caller ? "[caller]" : "[pool]  ", node->is_critical ? " critical" : "");
+    }
+}
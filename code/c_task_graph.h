@@ -0,0 +1,136 @@
+#if !defined(C_TASK_GRAPH_H)
+/* ========================================================================
+   $File: c_task_graph.h $
+   $Date: October 18 2026 10:40 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define C_TASK_GRAPH_H
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_string.h>
+
+#include <c_threadpool.h>
+#include <c_queue.h>
+
+/* NOTE(Sleepster): Per-frame task graph.
+ *
+ * Systems are added as nodes, then each node says which resources it reads and which it writes. Resources are just
+ * ids with a name, the graph never touches them. c_task_graph_build() turns the accesses into edges using the order
+ * the nodes were added in, same rules as a CPU pipeline:
+ *   read after write  -> the reader waits on the last writer
+ *   write after read  -> the writer waits on every reader since the last write
+ *   write after write -> the writer waits on the last writer
+ * So the graph always does what running the nodes one after the other in that order would do, it just overlaps the
+ * ones that don't touch the same things. Since an edge always points at a later node there can't be any cycles.
+ *
+ * c_task_graph_execute() runs every node once. Nodes with no pending predecessors are submitted to the threadpool
+ * and each finishing node releases its successors. Nodes flagged TGNF_MainThread never go to the pool, they're handed
+ * to the thread that called execute (SDL events, the Vulkan submit) which helps the pool in between.
+ *
+ * Scheduling follows the critical path. Every node keeps a moving average of how long it takes, and after each frame
+ * the graph works out the longest chain of work hanging off of every node (its bottom level). Nodes on the critical
+ * path go in at TPTP_High, everything with slack goes in at TPTP_Low, and when several nodes become ready at once
+ * the longest chain is pushed last so the worker's LIFO pop picks it up first.
+ *
+ * Build once, execute every frame. Adding nodes or accesses after the build means building again.
+ */
+
+#define TASK_GRAPH_MAX_NODES          (64)
+#define TASK_GRAPH_MAX_RESOURCES      (64)
+#define TASK_GRAPH_MAX_NODE_ACCESSES  (16)
+#define TASK_GRAPH_INVALID_ID         (0xFFFFFFFF)
+
+// NOTE(Sleepster): Node masks are a u64, one bit per node.
+StaticAssert(TASK_GRAPH_MAX_NODES <= 64, "The task graph stores edges as u64 masks...\n");
+
+enum task_graph_node_flags_t
+{
+    TGNF_None       = 0,
+    TGNF_MainThread = 1 << 0,
+};
+
+enum task_graph_access_t
+{
+    TGA_Read,
+    TGA_Write,
+};
+
+struct task_graph_node_t
+{
+    const char            *name;
+    threadpool_callback_t *callback;
+    void                  *user_data;
+    u32                    flags;
+
+    u32                    resources[TASK_GRAPH_MAX_NODE_ACCESSES];
+    u32                    access_types[TASK_GRAPH_MAX_NODE_ACCESSES];
+    u32                    access_count;
+
+    u64                    predecessor_mask;
+    u64                    successor_mask;
+    u32                    predecessor_count;
+
+    // NOTE(Sleepster): Scheduling, in milliseconds. cost is the moving average of duration.
+    float64                cost_ms;
+    float64                top_level_ms;
+    float64                bottom_level_ms;
+    bool8                  is_critical;
+
+    volatile u32           pending_predecessors;
+
+    // NOTE(Sleepster): Timings for the last frame, start and end are relative to the start of the frame.
+    float64                start_ms;
+    float64                end_ms;
+    float64                duration_ms;
+    float64                max_duration_ms;
+    bool8                  ran_on_caller;
+    byte                   _padding[CACHE_LINE_SIZE];
+};
+
+struct task_graph_t
+{
+    threadpool_t      *pool;
+    bool8              is_built;
+
+    task_graph_node_t  nodes[TASK_GRAPH_MAX_NODES];
+    u32                node_count;
+    u32                edge_count;
+    u64                root_mask;
+
+    const char        *resource_names[TASK_GRAPH_MAX_RESOURCES];
+    u32                resource_count;
+
+    // NOTE(Sleepster): Ready TGNF_MainThread nodes, pushed by whichever worker released them.
+    queue_t            main_thread_queue;
+
+    byte               _padding0[CACHE_LINE_SIZE];
+    volatile u32       nodes_completed;
+    byte               _padding1[CACHE_LINE_SIZE];
+
+    u64                counter_frequency;
+    u64                frame_start_counter;
+    u64                frame_index;
+    float64            frame_ms;
+    float64            critical_path_ms;
+};
+
+void  c_task_graph_init(task_graph_t *graph, threadpool_t *pool);
+void  c_task_graph_destroy(task_graph_t *graph);
+
+// NOTE(Sleepster): The names are not copied, use string literals.
+u32   c_task_graph_add_resource(task_graph_t *graph, const char *name);
+u32   c_task_graph_add_node(task_graph_t *graph, const char *name, threadpool_callback_t *callback, void *user_data, u32 flags = TGNF_None);
+void  c_task_graph_node_reads(task_graph_t *graph, u32 node_id, u32 resource_id);
+void  c_task_graph_node_writes(task_graph_t *graph, u32 node_id, u32 resource_id);
+
+bool8 c_task_graph_build(task_graph_t *graph);
+void  c_task_graph_execute(task_graph_t *graph);
+
+// NOTE(Sleepster): Graphviz, 'dot -Tsvg graph.dot -o graph.svg'. Critical path in red, last frame's timings on the nodes.
+bool8 c_task_graph_dump_dot(task_graph_t *graph, string_t filepath);
+void  c_task_graph_log_timings(task_graph_t *graph);
+
+#endif // C_TASK_GRAPH_H
@@ -7,147 +7,1150 @@
 #include <c_intrinsics.h>
 #include <c_base.h>
 #include <c_types.h>
+#include <c_log.h>
 
 #include <c_threadpool.h>
+#include <c_profiler.h>
+#include <c_sampler.h>
 #include <p_platform_data.h>
 
 PLATFORM_THREAD_PROC(ThreadProc);
+internal_api void c_threadpool_fiber_proc(void *user_data);
 
-bool8
-c_threadpool_perform_next_task(threadpool_queue_t *queue)
+// NOTE(Sleepster): Set for the pool's OS threads, and for the thread that called c_threadpool_init() (worker 0).
+//                  Anything else submitting to the pool is "external" and goes through the overflow queues.
+global_variable thread_local threadpool_worker_t *tl_current_worker = null;
+
+// NOTE(Sleepster): NO_INLINE on purpose. A task that waits on a counter can wake up on a different thread, and the
+//                  compiler is allowed to cache the address of a thread_local across the fiber switch if this inlines.
+internal_api NO_INLINE threadpool_worker_t*
+c_threadpool_get_current_worker(threadpool_t *pool)
 {
-    bool8 result = true;
+    threadpool_worker_t *result = null;
+    if(tl_current_worker && tl_current_worker->pool == pool)
+    {
+        result = tl_current_worker;
+    }
+
+    return(result);
+}
+
+internal_api inline u32
+c_threadpool_random_next(u32 *state)
+{
+    // NOTE(Sleepster): xorshift32, only used to pick steal victims so it doesn't need to be good.
+    u32 value = *state;
+    value ^= value << 13;
+    value ^= value >> 17;
+    value ^= value << 5;
+    *state = value;
+
+    return(value);
+}
+
+/*===========================================
+  ========= WORK STEALING DEQUE =============
+  ===========================================*/
+
+// NOTE(Sleepster): OWNER ONLY. Pushes as many of the tasks as will fit and publishes all of them with a single
+//                  store to bottom. Returns how many made it in.
+internal_api u32
+c_threadpool_deque_push(threadpool_deque_t *deque, threadpool_task_t *tasks, u32 task_count)
+{
+    u32 result = 0;
 
-    u32 this_entry_to_read = queue->next_entry_to_read;
-    u32 next_entry_to_read = (this_entry_to_read + 1) % MAX_QUEUE_ENTRIES;
-    if(this_entry_to_read != queue->next_entry_to_write)
+    s64 bottom     = deque->bottom;
+    s64 top        = AtomicLoad64(&deque->top);
+    s64 free_slots = THREADPOOL_DEQUE_CAPACITY - (bottom - top);
+    if(free_slots > 0)
     {
-        ReadWriteBarrier;
-        u32 task = AtomicCompareExchange((volatile s32*)&queue->next_entry_to_read,
-                                         next_entry_to_read,
-                                         this_entry_to_read);
-        if(task == this_entry_to_read)
+        result = (free_slots < (s64)task_count) ? (u32)free_slots : task_count;
+        for(u32 task_index = 0;
+            task_index < result;
+            ++task_index)
         {
-            threadpool_queue_entry_t *entry = queue->entries + task;
-            if(entry->is_valid)
-            {
-                ReadWriteBarrier;
+            deque->tasks[(bottom + task_index) & (THREADPOOL_DEQUE_CAPACITY - 1)] = tasks[task_index];
+        }
+
+        // NOTE(Sleepster): The tasks have to be visible before the new bottom is.
+        sfence();
+        AtomicStore64(&deque->bottom, bottom + result);
+    }
+
+    return(result);
+}
+
+// NOTE(Sleepster): OWNER ONLY
+internal_api bool8
+c_threadpool_deque_pop(threadpool_deque_t *deque, threadpool_task_t *task_out)
+{
+    bool8 result = false;
+
+    s64 bottom = deque->bottom - 1;
+    AtomicStore64(&deque->bottom, bottom);
 
-                entry->is_valid = false;
-                entry->callback(entry->user_data);
-                AtomicIncrement32(&queue->entries_completed);
+    // NOTE(Sleepster): Store -> Load ordering, the thieves need to see our new bottom before we look at top.
+    mfence();
+    s64 top = AtomicLoad64(&deque->top);
+    if(top <= bottom)
+    {
+        *task_out = deque->tasks[bottom & (THREADPOOL_DEQUE_CAPACITY - 1)];
+        result    = true;
+        if(top == bottom)
+        {
+            // NOTE(Sleepster): Last task in the deque, race the thieves for it.
+            if(AtomicCompareExchange64(&deque->top, top + 1, top) != top)
+            {
+                result = false;
             }
+            AtomicStore64(&deque->bottom, bottom + 1);
         }
     }
     else
     {
-        result = false;
+        AtomicStore64(&deque->bottom, bottom + 1);
     }
 
     return(result);
 }
 
+// NOTE(Sleepster): ANY THREAD
+internal_api bool8
+c_threadpool_deque_steal(threadpool_deque_t *deque, threadpool_task_t *task_out)
+{
+    bool8 result = false;
+
+    s64 top = AtomicLoad64(&deque->top);
+    mfence();
+    s64 bottom = AtomicLoad64(&deque->bottom);
+    if(top < bottom)
+    {
+        threadpool_task_t task = deque->tasks[top & (THREADPOOL_DEQUE_CAPACITY - 1)];
+        if(AtomicCompareExchange64(&deque->top, top + 1, top) == top)
+        {
+            *task_out = task;
+            result    = true;
+        }
+    }
+
+    return(result);
+}
+
+internal_api inline bool8
+c_threadpool_deque_is_empty(threadpool_deque_t *deque)
+{
+    s64 top    = AtomicLoad64(&deque->top);
+    s64 bottom = AtomicLoad64(&deque->bottom);
+
+    return((bottom - top) <= 0);
+}
+
+/*===========================================
+  ============= OVERFLOW QUEUE ==============
+  ===========================================*/
+
+internal_api void
+c_threadpool_overflow_push(threadpool_overflow_queue_t *queue, threadpool_task_t *tasks, u32 task_count)
+{
+    c_profiled_mutex_lock(&queue->mutex);
+
+    for(u32 task_index = 0;
+        task_index < task_count;
+        ++task_index)
+    {
+        threadpool_overflow_chunk_t *chunk = queue->last_chunk;
+        if(chunk == null || chunk->write_index == THREADPOOL_OVERFLOW_CHUNK_SIZE)
+        {
+            threadpool_overflow_chunk_t *new_chunk = queue->free_chunks;
+            if(new_chunk)
+            {
+                queue->free_chunks = new_chunk->next_chunk;
+            }
+            else
+            {
+                new_chunk = (threadpool_overflow_chunk_t*)sys_allocate_memory(sizeof(threadpool_overflow_chunk_t));
+                Assert(new_chunk);
+            }
+            new_chunk->read_index  = 0;
+            new_chunk->write_index = 0;
+            new_chunk->next_chunk  = null;
+
+            if(chunk) chunk->next_chunk = new_chunk;
+            else      queue->first_chunk = new_chunk;
+
+            queue->last_chunk = new_chunk;
+            chunk             = new_chunk;
+        }
+
+        chunk->tasks[chunk->write_index++] = tasks[task_index];
+    }
+    AtomicAdd32(&queue->task_count, task_count);
+
+    c_profiled_mutex_unlock(&queue->mutex);
+}
+
+internal_api bool8
+c_threadpool_overflow_pop(threadpool_overflow_queue_t *queue, threadpool_task_t *task_out)
+{
+    bool8 result = false;
+
+    // NOTE(Sleepster): Don't touch the lock if there's nothing in here, this is checked constantly by idle workers.
+    if(AtomicLoad32(&queue->task_count) > 0)
+    {
+        c_profiled_mutex_lock(&queue->mutex);
+
+        threadpool_overflow_chunk_t *chunk = queue->first_chunk;
+        if(chunk && chunk->read_index < chunk->write_index)
+        {
+            *task_out = chunk->tasks[chunk->read_index++];
+            AtomicDecrement32(&queue->task_count);
+            result = true;
+
+            if(chunk->read_index == THREADPOOL_OVERFLOW_CHUNK_SIZE)
+            {
+                queue->first_chunk = chunk->next_chunk;
+                if(queue->first_chunk == null)
+                {
+                    queue->last_chunk = null;
+                }
+
+                chunk->next_chunk  = queue->free_chunks;
+                queue->free_chunks = chunk;
+            }
+        }
+
+        c_profiled_mutex_unlock(&queue->mutex);
+    }
+
+    return(result);
+}
+
+internal_api void
+c_threadpool_overflow_free_chunks(threadpool_overflow_chunk_t *chunk)
+{
+    while(chunk)
+    {
+        threadpool_overflow_chunk_t *next_chunk = chunk->next_chunk;
+        sys_free_memory(chunk, sizeof(threadpool_overflow_chunk_t));
+
+        chunk = next_chunk;
+    }
+}
+
+/*===========================================
+  ============= FIBERS / COUNTERS ===========
+  ===========================================*/
+
+internal_api inline void
+c_threadpool_spin_lock(volatile u32 *lock)
+{
+    while(AtomicCompareExchange32(lock, 1, 0) != 0)
+    {
+        while(AtomicLoad32(lock))
+        {
+            _mm_pause();
+        }
+    }
+}
+
+internal_api inline void
+c_threadpool_spin_unlock(volatile u32 *lock)
+{
+    AtomicStore32(lock, 0);
+}
+
+internal_api threadpool_fiber_t*
+c_threadpool_acquire_free_fiber(threadpool_t *pool)
+{
+    c_threadpool_spin_lock(&pool->fiber_lock);
+    threadpool_fiber_t *result = pool->free_fibers;
+    if(result)
+    {
+        pool->free_fibers  = result->next_fiber;
+        result->next_fiber = null;
+    }
+    c_threadpool_spin_unlock(&pool->fiber_lock);
+
+    return(result);
+}
+
+internal_api void
+c_threadpool_release_fiber(threadpool_t *pool, threadpool_fiber_t *fiber)
+{
+    c_threadpool_spin_lock(&pool->fiber_lock);
+    fiber->next_fiber = pool->free_fibers;
+    pool->free_fibers = fiber;
+    c_threadpool_spin_unlock(&pool->fiber_lock);
+}
+
+internal_api threadpool_fiber_t*
+c_threadpool_pop_ready_fiber(threadpool_t *pool)
+{
+    threadpool_fiber_t *result = null;
+    if(AtomicLoad32(&pool->ready_fiber_count) > 0)
+    {
+        c_threadpool_spin_lock(&pool->fiber_lock);
+        result = pool->first_ready_fiber;
+        if(result)
+        {
+            pool->first_ready_fiber = result->next_fiber;
+            if(pool->first_ready_fiber == null)
+            {
+                pool->last_ready_fiber = null;
+            }
+            result->next_fiber = null;
+            AtomicDecrement32(&pool->ready_fiber_count);
+        }
+        c_threadpool_spin_unlock(&pool->fiber_lock);
+    }
+
+    return(result);
+}
+
+internal_api void c_threadpool_wake_workers(threadpool_t *pool, u32 wake_count);
+
+internal_api void
+c_threadpool_push_ready_fibers(threadpool_t *pool, threadpool_fiber_t *first_fiber)
+{
+    u32 fiber_count = 0;
+
+    c_threadpool_spin_lock(&pool->fiber_lock);
+    while(first_fiber)
+    {
+        threadpool_fiber_t *next_fiber = first_fiber->next_fiber;
+        first_fiber->next_fiber = null;
+
+        if(pool->last_ready_fiber) pool->last_ready_fiber->next_fiber = first_fiber;
+        else                       pool->first_ready_fiber            = first_fiber;
+        pool->last_ready_fiber = first_fiber;
+
+        AtomicIncrement32(&pool->ready_fiber_count);
+        ++fiber_count;
+
+        first_fiber = next_fiber;
+    }
+    c_threadpool_spin_unlock(&pool->fiber_lock);
+
+    if(fiber_count > 0)
+    {
+        c_threadpool_wake_workers(pool, fiber_count);
+    }
+}
+
+// NOTE(Sleepster): The 1 -> 0 transition only ever happens under the counter's lock, and the lock is the last
+//                  thing the decrementer touches. So anyone that sees zero and then sees the lock free knows
+//                  nobody is going to touch the counter again, and it's safe to let it go out of scope.
+internal_api void
+c_threadpool_counter_decrement(threadpool_t *pool, threadpool_counter_t *counter)
+{
+    threadpool_fiber_t *waiting_fibers = null;
+    for(;;)
+    {
+        s64 value = AtomicLoad64(&counter->value);
+        Assert(value > 0);
+
+        if(value == 1)
+        {
+            c_threadpool_spin_lock(&counter->lock);
+            bool8 reached_zero = AtomicCompareExchange64(&counter->value, 0, 1) == 1;
+            if(reached_zero)
+            {
+                waiting_fibers          = counter->waiting_fibers;
+                counter->waiting_fibers = null;
+            }
+            c_threadpool_spin_unlock(&counter->lock);
+
+            if(reached_zero) break;
+        }
+        else if(AtomicCompareExchange64(&counter->value, value - 1, value) == value)
+        {
+            break;
+        }
+    }
+
+    if(waiting_fibers)
+    {
+        c_threadpool_push_ready_fibers(pool, waiting_fibers);
+    }
+}
+
+internal_api inline void
+c_threadpool_counter_wait_for_unlock(threadpool_counter_t *counter)
+{
+    while(AtomicLoad32(&counter->lock))
+    {
+        _mm_pause();
+    }
+}
+
+// NOTE(Sleepster): Runs on the fiber we just switched TO. The fiber we came from has been fully saved by now, so
+//                  this is where it's safe to hand it off to somebody else.
+internal_api void
+c_threadpool_after_fiber_switch(threadpool_t *pool)
+{
+    threadpool_worker_t *worker = c_threadpool_get_current_worker(pool);
+    Assert(worker);
+
+    if(worker->fiber_to_recycle)
+    {
+        c_threadpool_release_fiber(pool, worker->fiber_to_recycle);
+        worker->fiber_to_recycle = null;
+    }
+
+    if(worker->fiber_to_park)
+    {
+        threadpool_fiber_t   *fiber   = worker->fiber_to_park;
+        threadpool_counter_t *counter = worker->park_counter;
+        worker->fiber_to_park = null;
+        worker->park_counter  = null;
+
+        c_threadpool_spin_lock(&counter->lock);
+        bool8 already_done = AtomicLoad64(&counter->value) == 0;
+        if(!already_done)
+        {
+            fiber->next_fiber       = counter->waiting_fibers;
+            counter->waiting_fibers = fiber;
+        }
+        c_threadpool_spin_unlock(&counter->lock);
+
+        if(already_done)
+        {
+            c_threadpool_push_ready_fibers(pool, fiber);
+        }
+    }
+}
+
+internal_api void
+c_threadpool_switch_to_fiber(threadpool_t *pool, threadpool_worker_t *worker, threadpool_fiber_t *target)
+{
+    threadpool_fiber_t *current = worker->current_fiber;
+    worker->current_fiber = target;
+    PROFILE_FIBER_LEAVE(&current->profiler_zones);
+    sys_fiber_switch(&current->fiber, &target->fiber);
+
+    // NOTE(Sleepster): We can come back on ANY worker, don't touch 'worker' after this.
+    c_threadpool_after_fiber_switch(pool);
+    PROFILE_FIBER_ENTER(&current->profiler_zones);
+}
+
+/*===========================================
+  ============== SCHEDULING =================
+  ===========================================*/
+
+// NOTE(Sleepster): Search order is: our own deque, the overflow queue, then a random victim and every worker after it.
+//                  All of that for high priority first, then all of it again for low priority. With more than one
+//                  NUMA node the steal goes around twice, workers on our own node first and everybody else after.
+internal_api bool8
+c_threadpool_find_task(threadpool_t        *pool,
+                       threadpool_worker_t *worker,
+                       u32                 *random_state,
+                       threadpool_task_t   *task_out)
+{
+    bool8 result = false;
+    for(u32 priority = TPTP_High;
+        priority > TPTP_Invalid && !result;
+        --priority)
+    {
+        if(worker && c_threadpool_deque_pop(&worker->deques[priority], task_out))
+        {
+            result = true;
+            break;
+        }
+
+        if(c_threadpool_overflow_pop(&pool->overflow_queues[priority], task_out))
+        {
+            result = true;
+            break;
+        }
+
+        u32 numa_node    = worker ? worker->numa_node : 0;
+        u32 steal_passes = pool->numa_node_count > 1 ? 2 : 1;
+        u32 first_victim = c_threadpool_random_next(random_state) % pool->worker_count;
+        for(u32 steal_pass = 0;
+            steal_pass < steal_passes && !result;
+            ++steal_pass)
+        {
+            for(u32 victim_offset = 0;
+                victim_offset < pool->worker_count;
+                ++victim_offset)
+            {
+                threadpool_worker_t *victim = pool->workers + ((first_victim + victim_offset) % pool->worker_count);
+                if(victim == worker) continue;
+                if(steal_passes > 1 && ((victim->numa_node == numa_node) != (steal_pass == 0))) continue;
+
+                if(c_threadpool_deque_steal(&victim->deques[priority], task_out))
+                {
+                    if(worker) ++worker->tasks_stolen;
+                    result = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    return(result);
+}
+
+internal_api bool8
+c_threadpool_has_pending_tasks(threadpool_t *pool)
+{
+    bool8 result = false;
+    for(u32 priority = TPTP_Low;
+        priority < TPTP_Count && !result;
+        ++priority)
+    {
+        if(AtomicLoad32(&pool->overflow_queues[priority].task_count) > 0 ||
+           AtomicLoad32(&pool->ready_fiber_count) > 0)
+        {
+            result = true;
+            break;
+        }
+
+        for(u32 worker_index = 0;
+            worker_index < pool->worker_count;
+            ++worker_index)
+        {
+            if(!c_threadpool_deque_is_empty(&pool->workers[worker_index].deques[priority]))
+            {
+                result = true;
+                break;
+            }
+        }
+    }
+
+    return(result);
+}
+
+// NOTE(Sleepster): Tasks waiting to run plus parked fibers that are ready to go again. Read without stopping anybody,
+//                  so it's a snapshot that can be a few tasks off, good enough for stats.
+u32
+c_threadpool_get_queued_task_count(threadpool_t *pool)
+{
+    s64 result = AtomicLoad32(&pool->ready_fiber_count);
+    for(u32 priority = TPTP_Low;
+        priority < TPTP_Count;
+        ++priority)
+    {
+        result += AtomicLoad32(&pool->overflow_queues[priority].task_count);
+        for(u32 worker_index = 0;
+            worker_index < pool->worker_count;
+            ++worker_index)
+        {
+            threadpool_deque_t *deque = &pool->workers[worker_index].deques[priority];
+            s64 queued = AtomicLoad64(&deque->bottom) - AtomicLoad64(&deque->top);
+            if(queued > 0) result += queued;
+        }
+    }
+
+    return((u32)result);
+}
+
+internal_api inline void
+c_threadpool_execute_task(threadpool_t *pool, threadpool_task_t *task)
+{
+    void *user_data = task->payload_size ? (void*)task->payload : task->user_data;
+    {
+        PROFILE_SCOPE("threadpool_task");
+        if(task->trace_flow_id)
+        {
+            TRACE_FLOW_END("threadpool_task", task->trace_flow_id);
+        }
+        task->callback(user_data);
+    }
+    if(task->counter)
+    {
+        c_threadpool_counter_decrement(pool, task->counter);
+    }
+
+    // NOTE(Sleepster): The task may have waited and come back on another worker.
+    threadpool_worker_t *worker = c_threadpool_get_current_worker(pool);
+    if(worker) ++worker->tasks_executed;
+
+    AtomicIncrement64(&pool->entries_completed);
+}
+
+internal_api void
+c_threadpool_wake_workers(threadpool_t *pool, u32 wake_count)
+{
+    // NOTE(Sleepster): Pairs with the sleeping worker's increment + recheck in ThreadProc. Either we see that it's
+    //                  sleeping, or it sees our task. Nobody sleeping, nobody to signal.
+    mfence();
+    u32 threads_sleeping = AtomicLoad32(&pool->threads_sleeping);
+    if(threads_sleeping > 0)
+    {
+        if(wake_count > threads_sleeping) wake_count = threads_sleeping;
+        c_profiled_semaphore_release(&pool->semaphore, wake_count);
+    }
+}
+
+/*===========================================
+  ============= WORKER PLACEMENT ============
+  ===========================================*/
+
+global_variable const char *threadpool_pin_policy_names[TPPP_Count] = {"none", "physical_cores", "compact", "scatter"};
+
+internal_api u32
+c_threadpool_count_lower_cores_in_llc(sys_cpu_topology_t *topology, sys_logical_cpu_t *cpu)
+{
+    u32 result = 0;
+    for(u32 cpu_index = 0;
+        cpu_index < topology->logical_cpu_count;
+        ++cpu_index)
+    {
+        sys_logical_cpu_t *other = topology->cpus + cpu_index;
+        if(other->smt_index == 0 && other->llc_index == cpu->llc_index && other->core_index < cpu->core_index)
+        {
+            ++result;
+        }
+    }
+
+    return(result);
+}
+
+internal_api u32
+c_threadpool_count_lower_llcs_in_node(sys_cpu_topology_t *topology, sys_logical_cpu_t *cpu)
+{
+    u32   result = 0;
+    bool8 counted[SYS_MAX_LOGICAL_CPUS] = {};
+    for(u32 cpu_index = 0;
+        cpu_index < topology->logical_cpu_count;
+        ++cpu_index)
+    {
+        sys_logical_cpu_t *other = topology->cpus + cpu_index;
+        if(other->numa_node == cpu->numa_node && other->llc_index < cpu->llc_index && !counted[other->llc_index])
+        {
+            counted[other->llc_index] = true;
+            ++result;
+        }
+    }
+
+    return(result);
+}
+
+/* NOTE(Sleepster): Takes the reserved cores off the top, then sorts every cpu the policy is allowed to use into the
+ * order workers should be handed out in. Returns how many went into cpu_order (indices into topology->cpus).
+ */
+internal_api u32
+c_threadpool_build_cpu_order(threadpool_t *pool, threadpool_config_t *config, sys_cpu_topology_t *topology, u32 *cpu_order)
+{
+    u32 result = 0;
+
+    u32 reserved_core_count = config->reserved_core_count;
+    if(reserved_core_count > THREADPOOL_MAX_RESERVED_CPUS)      reserved_core_count = THREADPOOL_MAX_RESERVED_CPUS;
+    if(reserved_core_count >= topology->physical_core_count)    reserved_core_count = topology->physical_core_count - 1;
+
+    bool8 reserved_cores[SYS_MAX_LOGICAL_CPUS] = {};
+    while(pool->reserved_cpu_count < reserved_core_count)
+    {
+        sys_logical_cpu_t *best = null;
+        for(u32 cpu_index = 0;
+            cpu_index < topology->logical_cpu_count;
+            ++cpu_index)
+        {
+            sys_logical_cpu_t *cpu = topology->cpus + cpu_index;
+            if(cpu->smt_index != 0 || reserved_cores[cpu->core_index]) continue;
+            if(best == null ||
+               cpu->numa_node < best->numa_node ||
+               (cpu->numa_node == best->numa_node && cpu->core_index < best->core_index))
+            {
+                best = cpu;
+            }
+        }
+        if(best == null) break;
+
+        reserved_cores[best->core_index] = true;
+        pool->reserved_cpus[pool->reserved_cpu_count++] = best->cpu_index;
+    }
+
+    u64 sort_keys[SYS_MAX_LOGICAL_CPUS];
+    for(u32 cpu_index = 0;
+        cpu_index < topology->logical_cpu_count;
+        ++cpu_index)
+    {
+        sys_logical_cpu_t *cpu = topology->cpus + cpu_index;
+        if(reserved_cores[cpu->core_index]) continue;
+        if(config->pin_policy == TPPP_PhysicalCores && cpu->smt_index != 0) continue;
+
+        u64 key = 0;
+        if(config->pin_policy == TPPP_Scatter)
+        {
+            u64 core_rank = c_threadpool_count_lower_cores_in_llc(topology, cpu);
+            u64 llc_rank  = c_threadpool_count_lower_llcs_in_node(topology, cpu);
+            key = ((u64)cpu->smt_index << 56) | (core_rank << 44) | (llc_rank << 32) | ((u64)cpu->numa_node << 16) | cpu->core_index;
+        }
+        else
+        {
+            key = ((u64)cpu->numa_node << 48) | ((u64)cpu->llc_index << 36) | ((u64)cpu->core_index << 12) | cpu->smt_index;
+        }
+
+        // NOTE(Sleepster): Insertion sort, there's never more than a couple hundred of these.
+        u32 insert_index = result++;
+        while(insert_index > 0 && sort_keys[insert_index - 1] > key)
+        {
+            sort_keys[insert_index] = sort_keys[insert_index - 1];
+            cpu_order[insert_index] = cpu_order[insert_index - 1];
+            --insert_index;
+        }
+        sort_keys[insert_index] = key;
+        cpu_order[insert_index] = cpu_index;
+    }
+
+    return(result);
+}
+
+/*===========================================
+  ============== THREADPOOL API =============
+  ===========================================*/
+
+void
+c_threadpool_init(threadpool_t *pool, u32 thread_count)
+{
+    threadpool_config_t config = {};
+    config.thread_count = thread_count;
+    config.pin_policy   = TPPP_None;
+
+    c_threadpool_init_with_config(pool, &config);
+}
+
 void
-c_threadpool_init(threadpool_t *pool) 
+c_threadpool_init_with_config(threadpool_t *pool, threadpool_config_t *config)
 {
 #if OS_WINDOWS
     SetProcessDPIAware();
     timeBeginPeriod(1);
 #endif
+    Assert(config->pin_policy < TPPP_Count);
+    ZeroStruct(*pool);
 
-    u32 num_processors = sys_get_cpu_count();
+    sys_cpu_topology_t *topology = (sys_cpu_topology_t*)sys_allocate_memory(sizeof(sys_cpu_topology_t));
+    Assert(topology);
+    sys_get_cpu_topology(topology);
 
-    ZeroStruct(*pool);
-    pool->semaphore   = sys_semaphore_create(0, num_processors);
-    pool->max_threads = num_processors;
+    u32 cpu_order[SYS_MAX_LOGICAL_CPUS];
+    u32 cpu_order_count = c_threadpool_build_cpu_order(pool, config, topology, cpu_order);
+    if(cpu_order_count == 0)
+    {
+        cpu_order[cpu_order_count++] = 0;
+    }
+
+    u32 thread_count = config->thread_count;
+    if(thread_count == 0)
+    {
+        thread_count = cpu_order_count;
+    }
+    if(thread_count > THREADPOOL_MAX_WORKERS)
+    {
+        log_warning("Requested '%u' threadpool workers, clamping to '%u'...\n", thread_count, THREADPOOL_MAX_WORKERS);
+        thread_count = THREADPOOL_MAX_WORKERS;
+    }
+    if(config->pin_policy != TPPP_None && thread_count > cpu_order_count)
+    {
+        log_warning("'%u' threadpool workers but only '%u' cpus for policy '%s', some cpus will get more than one...\n",
+                    thread_count, cpu_order_count, threadpool_pin_policy_names[config->pin_policy]);
+    }
+
+    pool->max_threads     = thread_count;
+    pool->worker_count    = thread_count + 1;
+    pool->pin_policy      = config->pin_policy;
+    pool->numa_node_count = config->pin_policy != TPPP_None ? topology->numa_node_count : 1;
+    pool->is_running      = true;
+    pool->workers         = (threadpool_worker_t*)sys_allocate_memory(sizeof(threadpool_worker_t) * pool->worker_count);
+    Assert(pool->workers);
+
+    for(u32 worker_index = 0;
+        worker_index < pool->worker_count;
+        ++worker_index)
+    {
+        threadpool_worker_t *worker = pool->workers + worker_index;
+        worker->pool         = pool;
+        worker->worker_index = worker_index;
+        worker->random_state = 0x9E3779B9u * (worker_index + 1);
+        worker->pinned_cpu   = -1;
+
+        if(worker_index > 0 && config->pin_policy != TPPP_None)
+        {
+            sys_logical_cpu_t *cpu = topology->cpus + cpu_order[(worker_index - 1) % cpu_order_count];
+            worker->pinned_cpu = cpu->cpu_index;
+            worker->numa_node  = cpu->numa_node;
+        }
+    }
+
+    threadpool_worker_t *calling_worker = pool->workers;
+    if(config->pin_calling_thread && pool->reserved_cpu_count > 0 && c_threadpool_pin_to_reserved_core(pool, 0))
+    {
+        calling_worker->pinned_cpu = pool->reserved_cpus[0];
+        for(u32 cpu_index = 0;
+            cpu_index < topology->logical_cpu_count;
+            ++cpu_index)
+        {
+            if(topology->cpus[cpu_index].cpu_index == pool->reserved_cpus[0])
+            {
+                calling_worker->numa_node = topology->cpus[cpu_index].numa_node;
+                break;
+            }
+        }
+    }
+
+    log_info("Threadpool: '%u' workers, pin policy '%s', '%u' reserved cores. '%u' cpus, '%u' cores, '%u' LLC groups, '%u' NUMA nodes...\n",
+             thread_count, threadpool_pin_policy_names[config->pin_policy], pool->reserved_cpu_count,
+             topology->logical_cpu_count, topology->physical_core_count, topology->llc_count, topology->numa_node_count);
+    sys_free_memory(topology, sizeof(sys_cpu_topology_t));
+
+    // NOTE(Sleepster): Every worker thread needs one fiber to run its loop on, the rest are for parked tasks.
+    pool->fiber_count = THREADPOOL_FIBER_COUNT + thread_count;
+    pool->fibers      = (threadpool_fiber_t*)sys_allocate_memory(sizeof(threadpool_fiber_t) * pool->fiber_count);
+    Assert(pool->fibers);
+    for(u32 fiber_index = 0;
+        fiber_index < pool->fiber_count;
+        ++fiber_index)
+    {
+        threadpool_fiber_t *fiber = pool->fibers + fiber_index;
+        if(sys_fiber_create(&fiber->fiber, THREADPOOL_FIBER_STACK_SIZE, c_threadpool_fiber_proc, pool))
+        {
+            fiber->next_fiber = pool->free_fibers;
+            pool->free_fibers = fiber;
+        }
+    }
+
+    tl_current_worker    = pool->workers;
+    pool->is_initialized = true;
+    c_lock_profiler_register_semaphore("threadpool_semaphore", &pool->semaphore);
+    c_lock_profiler_register_mutex("threadpool_overflow_low",  &pool->overflow_queues[TPTP_Low].mutex);
+    c_lock_profiler_register_mutex("threadpool_overflow_high", &pool->overflow_queues[TPTP_High].mutex);
 
-    for(u32 thread_index = 0;
-        thread_index < num_processors;
-        ++thread_index)
+    for(u32 worker_index = 1;
+        worker_index < pool->worker_count;
+        ++worker_index)
     {
-        sys_thread_create(ThreadProc, pool, true);
+        threadpool_worker_t *worker = pool->workers + worker_index;
+        worker->thread = sys_thread_create(ThreadProc, worker, false);
     }
 }
 
+void
+c_threadpool_destroy(threadpool_t *pool)
+{
+    Assert(pool->is_initialized);
+    c_threadpool_flush_task_queues(pool);
+    c_lock_profiler_unregister(&pool->semaphore);
+    c_lock_profiler_unregister(&pool->overflow_queues[TPTP_Low].mutex);
+    c_lock_profiler_unregister(&pool->overflow_queues[TPTP_High].mutex);
+
+    AtomicStore32(&pool->is_running, false);
+    c_profiled_semaphore_release(&pool->semaphore, pool->worker_count);
+    for(u32 worker_index = 1;
+        worker_index < pool->worker_count;
+        ++worker_index)
+    {
+        sys_thread_join(&pool->workers[worker_index].thread);
+    }
+
+    for(u32 priority = TPTP_Low;
+        priority < TPTP_Count;
+        ++priority)
+    {
+        threadpool_overflow_queue_t *queue = pool->overflow_queues + priority;
+        c_threadpool_overflow_free_chunks(queue->first_chunk);
+        c_threadpool_overflow_free_chunks(queue->free_chunks);
+    }
+
+    for(u32 fiber_index = 0;
+        fiber_index < pool->fiber_count;
+        ++fiber_index)
+    {
+        sys_fiber_destroy(&pool->fibers[fiber_index].fiber);
+    }
+    sys_free_memory(pool->fibers, sizeof(threadpool_fiber_t) * pool->fiber_count);
+
+    if(c_threadpool_get_current_worker(pool))
+    {
+        tl_current_worker = null;
+    }
+
+    sys_free_memory(pool->workers, sizeof(threadpool_worker_t) * pool->worker_count);
+    ZeroStruct(*pool);
+}
+
 bool8
-c_threadpool_add_task(threadpool_t *threadpool, void *user_data, threadpool_callback_t *callback, u32 priority)
+c_threadpool_pin_to_reserved_core(threadpool_t *pool, u32 reserved_index)
 {
-    bool8 result = true;
+    bool8 result = false;
+    if(reserved_index < pool->reserved_cpu_count)
+    {
+        result = sys_thread_pin_current(pool->reserved_cpus[reserved_index]);
+    }
 
-    threadpool_queue_t *queue = null;
+    return(result);
+}
+
+// NOTE(Sleepster): Everything goes through here. The goal and the counter have to go up before anyone can possibly
+//                  complete one of the tasks.
+internal_api void
+c_threadpool_submit(threadpool_t *pool, threadpool_task_t *tasks, u32 task_count, u32 priority, threadpool_counter_t *counter)
+{
+    Assert(pool->is_initialized);
     Assert(priority != TPTP_Invalid);
-    switch(priority) 
+    Assert(priority <  TPTP_Count);
+
+    for(u32 task_index = 0;
+        task_index < task_count;
+        ++task_index)
     {
-        case TPTP_Low:
-        {
-            queue = &threadpool->low_priority_queue;
-        }break;
-        case TPTP_High:
-        {
-            queue = &threadpool->high_priority_queue;
-        }break;
+        Assert(tasks[task_index].callback);
+        tasks[task_index].counter       = counter;
+        tasks[task_index].trace_flow_id = TRACE_FLOW_BEGIN_NEW("threadpool_task");
     }
-    
-    ReadWriteBarrier;
-    u32 entry_to_write      = queue->next_entry_to_write;
-    u32 next_entry_to_write = (entry_to_write + 1) % MAX_QUEUE_ENTRIES;
-    Assert(next_entry_to_write != queue->next_entry_to_read);
 
-    u32 queue_entry_to_write = AtomicCompareExchange32((volatile s32*)&queue->next_entry_to_write,
-                                                       next_entry_to_write,
-                                                       entry_to_write);
-    if(queue_entry_to_write == entry_to_write)
+    AtomicExchangeAdd64(&pool->completion_goal, task_count);
+    if(counter)
     {
-        threadpool_queue_entry_t *entry = queue->entries + entry_to_write;
-
-        ReadWriteBarrier;
-        entry->is_valid  = true;
-        entry->user_data = user_data;
-        entry->callback  = callback;
+        AtomicExchangeAdd64(&counter->value, task_count);
+    }
 
-        AtomicIncrement32(&queue->completion_goal);
-        sys_semaphore_release(&threadpool->semaphore, 1);
+    u32 tasks_pushed = 0;
+    threadpool_worker_t *worker = c_threadpool_get_current_worker(pool);
+    if(worker)
+    {
+        tasks_pushed = c_threadpool_deque_push(&worker->deques[priority], tasks, task_count);
     }
-    else
+    if(tasks_pushed < task_count)
+    {
+        c_threadpool_overflow_push(&pool->overflow_queues[priority], tasks + tasks_pushed, task_count - tasks_pushed);
+    }
+
+    c_threadpool_wake_workers(pool, task_count);
+}
+
+threadpool_task_t
+c_threadpool_make_task(threadpool_callback_t *callback, void *user_data)
+{
+    threadpool_task_t result;
+    result.callback     = callback;
+    result.user_data    = user_data;
+    result.counter      = null;
+    result.payload_size = 0;
+
+    return(result);
+}
+
+threadpool_task_t
+c_threadpool_make_inline_task(threadpool_callback_t *callback, void *payload, u32 payload_size)
+{
+    Assert(payload_size > 0);
+    Assert(payload_size <= THREADPOOL_TASK_PAYLOAD_SIZE);
+
+    threadpool_task_t result;
+    result.callback     = callback;
+    result.user_data    = null;
+    result.counter      = null;
+    result.payload_size = payload_size;
+    MemoryCopy(result.payload, payload, payload_size);
+
+    return(result);
+}
+
+bool8
+c_threadpool_add_task(threadpool_t *threadpool, void *user_data, threadpool_callback_t *callback, u32 priority, threadpool_counter_t *counter)
+{
+    bool8 result = true;
+
+    threadpool_task_t task = c_threadpool_make_task(callback, user_data);
+    c_threadpool_submit(threadpool, &task, 1, priority, counter);
+
+    return(result);
+}
+
+bool8
+c_threadpool_add_inline_task(threadpool_t *threadpool, void *payload, u32 payload_size, threadpool_callback_t *callback, u32 priority, threadpool_counter_t *counter)
+{
+    bool8 result = true;
+
+    threadpool_task_t task = c_threadpool_make_inline_task(callback, payload, payload_size);
+    c_threadpool_submit(threadpool, &task, 1, priority, counter);
+
+    return(result);
+}
+
+bool8
+c_threadpool_add_tasks(threadpool_t *threadpool, threadpool_task_t *tasks, u32 task_count, u32 priority, threadpool_counter_t *counter)
+{
+    bool8 result = true;
+    if(task_count > 0)
     {
-        result = false;
+        c_threadpool_submit(threadpool, tasks, task_count, priority, counter);
     }
 
     return(result);
 }
 
-void 
-c_threadpool_flush_queue(threadpool_queue_t *queue)
+bool8
+c_threadpool_perform_next_task(threadpool_t *threadpool)
 {
-    while(queue->completion_goal != queue->entries_completed)
+    threadpool_worker_t *worker = c_threadpool_get_current_worker(threadpool);
+
+    u32  external_random_state = (u32)rdtsc() | 1;
+    u32 *random_state          = worker ? &worker->random_state : &external_random_state;
+
+    threadpool_task_t task;
+    bool8 result = c_threadpool_find_task(threadpool, worker, random_state, &task);
+    if(result)
     {
-        if(!c_threadpool_perform_next_task(queue)) break;
+        c_threadpool_execute_task(threadpool, &task);
     }
 
-    ReadWriteBarrier;
-    AtomicExchange(&queue->completion_goal,   0);
-    AtomicExchange(&queue->entries_completed, 0);
+    return(result);
 }
 
+// NOTE(Sleepster): The calling thread helps out until every task submitted so far is complete.
+//                  Don't call this from inside of a task, that task is counted in the goal.
 void
 c_threadpool_flush_task_queues(threadpool_t *threadpool)
 {
-    c_threadpool_flush_queue(&threadpool->high_priority_queue);
-    c_threadpool_flush_queue(&threadpool->low_priority_queue);
+    for(;;)
+    {
+        u64 entries_completed = AtomicLoad64(&threadpool->entries_completed);
+        u64 completion_goal   = AtomicLoad64(&threadpool->completion_goal);
+        if(entries_completed == completion_goal) break;
+
+        if(!c_threadpool_perform_next_task(threadpool))
+        {
+            _mm_pause();
+        }
+    }
+}
+
+/* NOTE(Sleepster): Counter waits.
+ *
+ * On a worker thread: the current fiber is parked on the counter and the worker switches to a ready fiber, or
+ * a free one that picks the worker loop back up. When the counter hits zero the fiber is made ready again and the
+ * first worker that sees it resumes it, which isn't necessarily the one we started on.
+ *
+ * Everywhere else (worker 0, external threads, or we ran out of fibers): help run tasks until the counter is zero.
+ */
+void
+c_threadpool_wait_for_counter(threadpool_t *threadpool, threadpool_counter_t *counter)
+{
+    Assert(threadpool->is_initialized);
+    Assert(counter);
+
+    if(AtomicLoad64(&counter->value) != 0)
+    {
+        bool8 parked = false;
+
+        threadpool_worker_t *worker = c_threadpool_get_current_worker(threadpool);
+        if(worker && worker->current_fiber)
+        {
+            threadpool_fiber_t *next_fiber = c_threadpool_pop_ready_fiber(threadpool);
+            if(!next_fiber)
+            {
+                next_fiber = c_threadpool_acquire_free_fiber(threadpool);
+            }
+
+            if(next_fiber)
+            {
+                worker->fiber_to_park = worker->current_fiber;
+                worker->park_counter  = counter;
+                c_threadpool_switch_to_fiber(threadpool, worker, next_fiber);
+
+                parked = true;
+            }
+        }
+
+        if(!parked)
+        {
+            while(AtomicLoad64(&counter->value) != 0)
+            {
+                if(!c_threadpool_perform_next_task(threadpool))
+                {
+                    _mm_pause();
+                }
+            }
+        }
+    }
+
+    c_threadpool_counter_wait_for_unlock(counter);
 }
 
-PLATFORM_THREAD_PROC(ThreadProc)
+// NOTE(Sleepster): Every worker thread's loop runs on one of the pool's fibers. Fibers that get recycled are
+//                  suspended somewhere in here, so picking one back up just continues the loop.
+internal_api void
+c_threadpool_fiber_proc(void *user_data)
 {
     threadpool_t *pool = (threadpool_t*)user_data;
-    for(;;)
+    c_threadpool_after_fiber_switch(pool);
+
+    u32 idle_spins = 0;
+    while(AtomicLoad32(&pool->is_running))
     {
-        if(!c_threadpool_perform_next_task(&pool->high_priority_queue))
+        threadpool_worker_t *worker = c_threadpool_get_current_worker(pool);
+
+        threadpool_task_t task;
+        threadpool_fiber_t *ready_fiber = c_threadpool_pop_ready_fiber(pool);
+        if(ready_fiber)
+        {
+            worker->fiber_to_recycle = worker->current_fiber;
+            c_threadpool_switch_to_fiber(pool, worker, ready_fiber);
+
+            idle_spins = 0;
+        }
+        else if(c_threadpool_find_task(pool, worker, &worker->random_state, &task))
         {
-            if(!c_threadpool_perform_next_task(&pool->low_priority_queue))
+            c_threadpool_execute_task(pool, &task);
+            idle_spins = 0;
+        }
+        else if(idle_spins < THREADPOOL_IDLE_SPIN_COUNT)
+        {
+            ++idle_spins;
+            _mm_pause();
+        }
+        else
+        {
+            AtomicIncrement32(&pool->threads_sleeping);
+            if(!c_threadpool_has_pending_tasks(pool) && AtomicLoad32(&pool->is_running))
             {
-                sys_semaphore_wait(&pool->semaphore, 0);
+                c_profiled_semaphore_wait(&pool->semaphore);
             }
+            AtomicDecrement32(&pool->threads_sleeping);
+
+            idle_spins = 0;
         }
     }
+
+    // NOTE(Sleepster): Shutting down, hand the worker back to its thread's own stack.
+    threadpool_worker_t *worker = c_threadpool_get_current_worker(pool);
+    worker->fiber_to_recycle = worker->current_fiber;
+    sys_fiber_switch(&worker->current_fiber->fiber, &worker->thread_fiber);
+
+    InvalidCodePath;
+}
+
+PLATFORM_THREAD_PROC(ThreadProc)
+{
+    threadpool_worker_t *worker = (threadpool_worker_t*)user_data;
+    threadpool_t        *pool   = worker->pool;
+    tl_current_worker = worker;
+    PROFILE_SET_THREAD_NAME("threadpool_worker");
+    c_sampler_register_thread("threadpool_worker");
+
+    if(worker->pinned_cpu >= 0)
+    {
+        sys_thread_pin_current((u32)worker->pinned_cpu);
+    }
+
+    if(sys_fiber_convert_thread(&worker->thread_fiber))
+    {
+        threadpool_fiber_t *loop_fiber = c_threadpool_acquire_free_fiber(pool);
+        Assert(loop_fiber);
+
+        worker->current_fiber = loop_fiber;
+        sys_fiber_switch(&worker->thread_fiber, &loop_fiber->fiber);
+
+        // NOTE(Sleepster): Back on the thread's stack, the pool is shutting down.
+        c_threadpool_after_fiber_switch(pool);
+        worker->current_fiber = null;
+        sys_fiber_convert_to_thread(&worker->thread_fiber);
+    }
+
+    tl_current_worker = null;
     return(0);
 }
@@ -12,13 +12,25 @@
 #include <c_types.h>
 
 #include <p_platform_data.h>
+#include <c_futex.h>
+#include <c_lock_profiler.h>
+#include <c_profiler.h>
 
-#define MAX_QUEUE_ENTRIES            (10000)
-#define THREADPOOL_ENTRY_BUFFER_SIZE (256)
+// NOTE(Sleepster): The deque capacity MUST be a power of two, we mask instead of mod.
+#define THREADPOOL_MAX_WORKERS         (64)
+#define THREADPOOL_DEQUE_CAPACITY      (1024)
+#define THREADPOOL_TASK_SIZE           (128)
+#define THREADPOOL_OVERFLOW_CHUNK_SIZE (127)
+#define THREADPOOL_IDLE_SPIN_COUNT     (64)
+#define THREADPOOL_FIBER_COUNT         (128)
+#define THREADPOOL_FIBER_STACK_SIZE    (KB(256))
+#define THREADPOOL_MAX_RESERVED_CPUS   (8)
+
+StaticAssert((THREADPOOL_DEQUE_CAPACITY & (THREADPOOL_DEQUE_CAPACITY - 1)) == 0, "Threadpool deque capacity must be a power of two...\n");
 
 typedef void threadpool_callback_t(void *user_data);
 
-enum job_priority_t 
+enum job_priority_t
 {
     TPTP_Invalid,
     TPTP_Low,
@@ -26,44 +38,200 @@ enum job_priority_t
     TPTP_Count
 };
 
-// NOTE(Sleepster): This buffer is an extra 2MB per threadpool... It's fine.
-struct threadpool_queue_entry_t
+/* NOTE(Sleepster): Where the worker threads end up.
+ *
+ * None          - no affinity, the OS puts the workers wherever it wants. One worker per logical cpu by default.
+ * PhysicalCores - one worker per physical core, pinned to the core's first SMT thread. The siblings are left alone
+ *                 so every worker gets a whole L1/L2 to itself.
+ * Compact       - pinned and packed together, one LLC group at a time with SMT siblings next to each other. Good for
+ *                 workers that share a lot of data.
+ * Scatter       - pinned and spread out, a core from every LLC group/NUMA node before a second one from any of them,
+ *                 SMT siblings last. Good for workers that each stream through their own data.
+ *
+ * Reserved cores are taken off of NUMA node 0 before anything is placed and never get a worker, they're for the main
+ * and render threads. c_threadpool_pin_to_reserved_core() puts the calling thread on one of them.
+ */
+enum threadpool_pin_policy_t
 {
-    bool8                  is_valid;
-    byte                   entry_buffer[THREADPOOL_ENTRY_BUFFER_SIZE];
+    TPPP_None,
+    TPPP_PhysicalCores,
+    TPPP_Compact,
+    TPPP_Scatter,
+    TPPP_Count
+};
 
-    void                  *user_data;
+struct threadpool_config_t
+{
+    u32   thread_count;        // NOTE(Sleepster): 0 means one worker per cpu the policy hands out
+    u32   pin_policy;
+    u32   reserved_core_count;
+    bool8 pin_calling_thread;  // NOTE(Sleepster): pins the init thread (worker 0) to the first reserved core
+};
+
+struct threadpool_t;
+struct threadpool_fiber_t;
+
+/* NOTE(Sleepster): Tasks can be attached to a counter when they're submitted. The counter goes up on submit and
+ * down when the task finishes. A task that waits on a counter doesn't block its worker, the task's fiber gets parked
+ * and the worker goes off and runs something else until the counter hits zero.
+ *
+ * Zero initialize these. A counter has to outlive every task attached to it and every wait on it.
+ */
+struct threadpool_counter_t
+{
+    volatile s64        value;
+    volatile u32        lock;
+    threadpool_fiber_t *waiting_fibers;
+};
+
+struct threadpool_fiber_t
+{
+    sys_fiber_t            fiber;
+    threadpool_fiber_t    *next_fiber;
+#if PROFILER_ENABLED
+    // NOTE(Sleepster): Zones the fiber had open when it was switched out, they're opened again where it resumes.
+    profiler_zone_stack_t  profiler_zones;
+#endif
+};
+
+#define THREADPOOL_TASK_PAYLOAD_SIZE (THREADPOOL_TASK_SIZE - (sizeof(void*) * 3) - (sizeof(u32) * 2))
+
+/* NOTE(Sleepster): Small closures can be copied straight into the task with c_threadpool_add_inline_task(), then the
+ * callback gets a pointer to the copy instead of user_data. The copy lives on the stack of whoever runs the task, so
+ * it's only valid for the duration of the callback. Don't hold on to it.
+ */
+struct threadpool_task_t
+{
     threadpool_callback_t *callback;
+    void                  *user_data;
+    threadpool_counter_t  *counter;
+    u32                    payload_size;
+    u32                    trace_flow_id;
+    byte                   payload[THREADPOOL_TASK_PAYLOAD_SIZE];
+};
+StaticAssert(sizeof(threadpool_task_t) == THREADPOOL_TASK_SIZE, "threadpool_task_t is the wrong size...\n");
+
+/* NOTE(Sleepster): Chase-Lev work stealing deque.
+ *
+ * The owning worker pushes and pops at the bottom (LIFO, keeps the cache warm), every other thread steals
+ * from the top (FIFO) with a single CAS. top and bottom live on their own cache lines since thieves hammer
+ * top and the owner hammers bottom.
+ *
+ * This is bounded, when it's full the task goes to the pool's overflow queue instead.
+ */
+struct threadpool_deque_t
+{
+    volatile s64      top;
+    byte              _top_padding[CACHE_LINE_SIZE - sizeof(s64)];
+
+    volatile s64      bottom;
+    byte              _bottom_padding[CACHE_LINE_SIZE - sizeof(s64)];
+
+    threadpool_task_t tasks[THREADPOOL_DEQUE_CAPACITY];
+};
+
+// NOTE(Sleepster): Unbounded FIFO of chunks. This is where tasks go when they are submitted from threads that don't
+//                  own a deque in the pool, or when the submitting worker's deque is full.
+struct threadpool_overflow_chunk_t
+{
+    u32                          read_index;
+    u32                          write_index;
+    threadpool_overflow_chunk_t *next_chunk;
+
+    threadpool_task_t            tasks[THREADPOOL_OVERFLOW_CHUNK_SIZE];
 };
 
-struct threadpool_queue_t
+struct threadpool_overflow_queue_t
 {
-    volatile u32 completion_goal;
-    volatile u32 entries_completed;
+    profiled_mutex_t             mutex;
+    volatile u32                 task_count;
+
+    threadpool_overflow_chunk_t *first_chunk;
+    threadpool_overflow_chunk_t *last_chunk;
+    threadpool_overflow_chunk_t *free_chunks;
+    byte                         _padding[CACHE_LINE_SIZE];
+};
+
+// NOTE(Sleepster): Worker 0 is the thread that called c_threadpool_init(), it doesn't get an OS thread of it's own.
+//                  It only runs tasks when it flushes, but anything it pushes can still be stolen by the others.
+//                  It also never runs on a fiber, so waits on worker 0 just help out until the counter is done.
+struct threadpool_worker_t
+{
+    threadpool_deque_t    deques[TPTP_Count];
+
+    threadpool_t         *pool;
+    u32                   worker_index;
+    u32                   random_state;
+    sys_thread_t          thread;
+    s32                   pinned_cpu;
+    u32                   numa_node;
 
-    volatile u32 next_entry_to_write;
-    volatile u32 next_entry_to_read;
+    // NOTE(Sleepster): Fiber bookkeeping. The *_to_* fields are set right before switching fibers and
+    //                  handled by whatever fiber runs next, once the old fiber's context is safely saved.
+    sys_fiber_t           thread_fiber;
+    threadpool_fiber_t   *current_fiber;
+    threadpool_fiber_t   *fiber_to_recycle;
+    threadpool_fiber_t   *fiber_to_park;
+    threadpool_counter_t *park_counter;
 
-    threadpool_queue_entry_t entries[MAX_QUEUE_ENTRIES];
+    volatile u64        tasks_executed;
+    volatile u64        tasks_stolen;
+    byte                _padding[CACHE_LINE_SIZE];
 };
 
 struct threadpool_t
 {
-    bool8           is_initialized;
-
-    sys_semaphore_t semaphore;
-    u32             threads_awake;
-    u32             max_threads;
-    
-    threadpool_queue_t high_priority_queue;
-    threadpool_queue_t low_priority_queue;
+    bool8                        is_initialized;
+    volatile u32                 is_running;
+
+    profiled_semaphore_t         semaphore;
+    volatile u32                 threads_sleeping;
+    u32                          max_threads;
+
+    threadpool_worker_t         *workers;
+    u32                          worker_count;
+
+    u32                          pin_policy;
+    u32                          numa_node_count;
+    u32                          reserved_cpus[THREADPOOL_MAX_RESERVED_CPUS];
+    u32                          reserved_cpu_count;
+
+    threadpool_overflow_queue_t  overflow_queues[TPTP_Count];
+
+    threadpool_fiber_t          *fibers;
+    u32                          fiber_count;
+
+    byte                         _fiber_padding[CACHE_LINE_SIZE];
+    volatile u32                 fiber_lock;
+    volatile u32                 ready_fiber_count;
+    threadpool_fiber_t          *free_fibers;
+    threadpool_fiber_t          *first_ready_fiber;
+    threadpool_fiber_t          *last_ready_fiber;
+
+    byte                         _padding0[CACHE_LINE_SIZE];
+    volatile u64                 completion_goal;
+    byte                         _padding1[CACHE_LINE_SIZE];
+    volatile u64                 entries_completed;
+    byte                         _padding2[CACHE_LINE_SIZE];
 };
 
-void  c_threadpool_init(threadpool_t *pool);
-bool8 c_threadpool_add_task(threadpool_t *threadpool, void *user_data, threadpool_callback_t *callback, u32 priority);
-bool8 c_threadpool_perform_next_task(threadpool_queue_t *queue);
-void  c_threadpool_flush_queue(threadpool_queue_t *queue);
+// NOTE(Sleepster): thread_count of 0 means "one worker per logical core", no pinning and nothing reserved.
+void  c_threadpool_init(threadpool_t *pool, u32 thread_count = 0);
+void  c_threadpool_init_with_config(threadpool_t *pool, threadpool_config_t *config);
+void  c_threadpool_destroy(threadpool_t *pool);
+bool8 c_threadpool_pin_to_reserved_core(threadpool_t *pool, u32 reserved_index);
+bool8 c_threadpool_add_task(threadpool_t *threadpool, void *user_data, threadpool_callback_t *callback, u32 priority, threadpool_counter_t *counter = null);
+bool8 c_threadpool_add_inline_task(threadpool_t *threadpool, void *payload, u32 payload_size, threadpool_callback_t *callback, u32 priority, threadpool_counter_t *counter = null);
+
+// NOTE(Sleepster): One reservation for the whole batch and only as many wakeups as there are tasks. The counter
+//                  gets written into every task in the array.
+bool8 c_threadpool_add_tasks(threadpool_t *threadpool, threadpool_task_t *tasks, u32 task_count, u32 priority, threadpool_counter_t *counter = null);
+threadpool_task_t c_threadpool_make_task(threadpool_callback_t *callback, void *user_data);
+threadpool_task_t c_threadpool_make_inline_task(threadpool_callback_t *callback, void *payload, u32 payload_size);
+
+bool8 c_threadpool_perform_next_task(threadpool_t *threadpool);
+u32   c_threadpool_get_queued_task_count(threadpool_t *pool);
 void  c_threadpool_flush_task_queues(threadpool_t *threadpool);
+void  c_threadpool_wait_for_counter(threadpool_t *threadpool, threadpool_counter_t *counter);
 
 #endif // C_THREADPOOL_H
-
@@ -0,0 +1,714 @@
+/* ========================================================================
+   $File: c_trace.cpp $
+   $Date: October 19 2026 01:40 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_log.h>
+
+#include <c_trace.h>
+#include <p_platform_data.h>
+
+#if PROFILER_ENABLED
+
+#define TRACE_PROCESS_ID             (1)
+#define TRACE_PROCESS_UUID           (1ULL)
+#define TRACE_THREAD_UUID(thread_id) ((1ULL << 32) | (u64)(thread_id))
+#define TRACE_SEQUENCE_ID            (1)
+#define TRACE_MAX_NAME_LENGTH        (200)
+#define TRACE_MAX_RECORD_SIZE        (1024)
+
+/* NOTE(Sleepster): The handful of Perfetto protobuf fields we write, from perfetto/trace/trace_packet.proto and
+ * perfetto/trace/track_event/{track_event,track_descriptor}.proto. A trace is just a list of 'packet' fields.
+ */
+enum trace_perfetto_field_t
+{
+    TPF_Trace_Packet                       = 1,
+
+    TPF_Packet_Timestamp                   = 8,
+    TPF_Packet_TrustedPacketSequenceID     = 10,
+    TPF_Packet_TrackEvent                  = 11,
+    TPF_Packet_SequenceFlags               = 13,
+    TPF_Packet_TrackDescriptor             = 60,
+
+    TPF_TrackEvent_Type                    = 9,
+    TPF_TrackEvent_TrackUUID               = 11,
+    TPF_TrackEvent_Name                    = 23,
+    TPF_TrackEvent_DoubleCounterValue      = 44,
+    TPF_TrackEvent_FlowIDs                 = 47,
+    TPF_TrackEvent_TerminatingFlowIDs      = 48,
+
+    TPF_TrackDescriptor_UUID               = 1,
+    TPF_TrackDescriptor_Name               = 2,
+    TPF_TrackDescriptor_Process            = 3,
+    TPF_TrackDescriptor_Thread             = 4,
+    TPF_TrackDescriptor_ParentUUID         = 5,
+    TPF_TrackDescriptor_Counter            = 8,
+
+    TPF_ProcessDescriptor_PID              = 1,
+    TPF_ProcessDescriptor_ProcessName      = 6,
+
+    TPF_ThreadDescriptor_PID               = 1,
+    TPF_ThreadDescriptor_TID               = 2,
+    TPF_ThreadDescriptor_ThreadName        = 5,
+};
+
+enum trace_perfetto_event_type_t
+{
+    TPET_SliceBegin = 1,
+    TPET_SliceEnd   = 2,
+    TPET_Instant    = 3,
+    TPET_Counter    = 4,
+};
+
+enum trace_perfetto_wire_type_t
+{
+    TPWT_Varint     = 0,
+    TPWT_Fixed64    = 1,
+    TPWT_Bytes      = 2,
+};
+
+// NOTE(Sleepster): SEQ_INCREMENTAL_STATE_CLEARED, on the first packet only.
+#define TRACE_PERFETTO_SEQUENCE_CLEARED (1)
+
+/*===========================================
+  =============== OUTPUT ====================
+  ===========================================*/
+
+internal_api void
+c_trace_output_flush(trace_output_t *output)
+{
+    if(output->used && !output->failed)
+    {
+        if(c_file_write(&output->file, output->buffer, output->used))
+        {
+            output->bytes_written += output->used;
+        }
+        else
+        {
+            output->failed = true;
+        }
+    }
+    output->used = 0;
+}
+
+// NOTE(Sleepster): Nothing we write in one go is bigger than TRACE_MAX_RECORD_SIZE.
+internal_api byte*
+c_trace_output_reserve(trace_output_t *output, u64 size)
+{
+    Assert(size <= TRACE_OUTPUT_BUFFER_SIZE);
+    if(output->used + size > TRACE_OUTPUT_BUFFER_SIZE) c_trace_output_flush(output);
+
+    byte *result = output->buffer + output->used;
+    return(result);
+}
+
+internal_api bool8
+c_trace_output_open(trace_output_t *output)
+{
+    bool8 result = false;
+
+    output->file = sys_file_open(c_string_create(output->path), true, false, false);
+    if(output->file.handle != INVALID_FILE_HANDLE)
+    {
+        output->buffer = (byte*)sys_allocate_memory(TRACE_OUTPUT_BUFFER_SIZE);
+        result         = output->buffer != null;
+    }
+    else
+    {
+        log_error("Failed to open trace file '%s'...\n", output->path);
+    }
+
+    return(result);
+}
+
+internal_api void
+c_trace_output_close(trace_output_t *output)
+{
+    if(output->buffer)
+    {
+        c_trace_output_flush(output);
+        sys_free_memory(output->buffer, TRACE_OUTPUT_BUFFER_SIZE);
+        output->buffer = null;
+    }
+    if(output->file.handle != INVALID_FILE_HANDLE)
+    {
+        c_file_close(&output->file);
+        output->file.handle = INVALID_FILE_HANDLE;
+    }
+}
+
+/*===========================================
+  =============== CHROME JSON ===============
+  ===========================================*/
+
+internal_api void
+c_trace_json_append(trace_capture_t *trace, const char *format, ...)
+{
+    trace_output_t *output = &trace->json;
+    char           *buffer = (char*)c_trace_output_reserve(output, TRACE_MAX_RECORD_SIZE / 2);
+
+    va_list args;
+    va_start(args, format);
+    s32 written = vsnprintf(buffer, TRACE_MAX_RECORD_SIZE / 2, format, args);
+    va_end(args);
+
+    if(written > 0) output->used += Min((u32)written, (u32)(TRACE_MAX_RECORD_SIZE / 2) - 1);
+}
+
+// NOTE(Sleepster): Quoted and escaped, names are code literals so quotes and backslashes are all we expect.
+internal_api void
+c_trace_json_append_name(trace_capture_t *trace, const char *name)
+{
+    trace_output_t *output = &trace->json;
+    char           *buffer = (char*)c_trace_output_reserve(output, TRACE_MAX_RECORD_SIZE / 2);
+    u32             used   = 0;
+
+    buffer[used++] = '"';
+    for(u32 char_index = 0;
+        name[char_index] && char_index < TRACE_MAX_NAME_LENGTH;
+        ++char_index)
+    {
+        char c = name[char_index];
+        if(c == '"' || c == '\\')  buffer[used++] = '\\';
+        buffer[used++] = ((u8)c < 0x20) ? ' ' : c;
+    }
+    buffer[used++] = '"';
+
+    output->used += used;
+}
+
+internal_api void
+c_trace_json_event(trace_capture_t *trace, const char *name, const char *phase, u32 thread_id, u64 timestamp_ns)
+{
+    c_trace_json_append(trace, ",\n{\"name\":");
+    c_trace_json_append_name(trace, name ? name : "");
+    c_trace_json_append(trace, ",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":%u,\"tid\":%u", phase, (float64)timestamp_ns / 1000.0, TRACE_PROCESS_ID, thread_id);
+}
+
+/*===========================================
+  =============== PERFETTO ==================
+  ===========================================*/
+
+internal_api byte*
+c_trace_pb_varint(byte *at, u64 value)
+{
+    while(value >= 0x80)
+    {
+        *at++   = (byte)(value | 0x80);
+        value >>= 7;
+    }
+    *at++ = (byte)value;
+
+    return(at);
+}
+
+internal_api inline byte*
+c_trace_pb_uint(byte *at, u32 field, u64 value)
+{
+    at = c_trace_pb_varint(at, (field << 3) | TPWT_Varint);
+    at = c_trace_pb_varint(at, value);
+    return(at);
+}
+
+internal_api inline byte*
+c_trace_pb_fixed64(byte *at, u32 field, u64 value)
+{
+    at = c_trace_pb_varint(at, (field << 3) | TPWT_Fixed64);
+    for(u32 byte_index = 0; byte_index < 8; ++byte_index)
+    {
+        *at++ = (byte)(value >> (byte_index * 8));
+    }
+
+    return(at);
+}
+
+internal_api inline byte*
+c_trace_pb_bytes(byte *at, u32 field, const void *data, u64 size)
+{
+    at = c_trace_pb_varint(at, (field << 3) | TPWT_Bytes);
+    at = c_trace_pb_varint(at, size);
+    memcpy(at, data, size);
+
+    return(at + size);
+}
+
+internal_api inline byte*
+c_trace_pb_string(byte *at, u32 field, const char *string)
+{
+    u64 length = 0;
+    while(string[length] && length < TRACE_MAX_NAME_LENGTH) ++length;
+
+    at = c_trace_pb_bytes(at, field, string, length);
+    return(at);
+}
+
+// NOTE(Sleepster): Wraps a finished TracePacket in the Trace's 'packet' field.
+internal_api void
+c_trace_perfetto_packet(trace_capture_t *trace, byte *packet, byte *packet_end)
+{
+    trace_output_t *output = &trace->perfetto;
+    byte           *at     = c_trace_output_reserve(output, TRACE_MAX_RECORD_SIZE);
+    byte           *end    = c_trace_pb_bytes(at, TPF_Trace_Packet, packet, (u64)(packet_end - packet));
+
+    output->used += (u64)(end - at);
+}
+
+internal_api void
+c_trace_perfetto_descriptor(trace_capture_t *trace, byte *descriptor, byte *descriptor_end, bool8 clears_state)
+{
+    byte  packet[TRACE_MAX_RECORD_SIZE - 16];
+    byte *at = packet;
+    at = c_trace_pb_uint(at, TPF_Packet_TrustedPacketSequenceID, TRACE_SEQUENCE_ID);
+    if(clears_state) at = c_trace_pb_uint(at, TPF_Packet_SequenceFlags, TRACE_PERFETTO_SEQUENCE_CLEARED);
+    at = c_trace_pb_bytes(at, TPF_Packet_TrackDescriptor, descriptor, (u64)(descriptor_end - descriptor));
+
+    c_trace_perfetto_packet(trace, packet, at);
+}
+
+// NOTE(Sleepster): 'flow_field' is 0 for no flow, otherwise which of the two flow id fields 'flow_id' goes in.
+internal_api void
+c_trace_perfetto_event(trace_capture_t *trace, u64 timestamp_ns, u64 track_uuid, u32 type, const char *name,
+                       u32 flow_field, u64 flow_id, float64 counter_value)
+{
+    byte  event[TRACE_MAX_RECORD_SIZE / 2];
+    byte *at = event;
+    at = c_trace_pb_uint(at, TPF_TrackEvent_Type, type);
+    at = c_trace_pb_uint(at, TPF_TrackEvent_TrackUUID, track_uuid);
+    if(name)       at = c_trace_pb_string(at, TPF_TrackEvent_Name, name);
+    if(flow_field) at = c_trace_pb_fixed64(at, flow_field, flow_id);
+    if(type == TPET_Counter)
+    {
+        u64 value_bits;
+        memcpy(&value_bits, &counter_value, sizeof(value_bits));
+        at = c_trace_pb_fixed64(at, TPF_TrackEvent_DoubleCounterValue, value_bits);
+    }
+
+    byte  packet[TRACE_MAX_RECORD_SIZE - 16];
+    byte *packet_at = packet;
+    packet_at = c_trace_pb_uint(packet_at, TPF_Packet_Timestamp, timestamp_ns);
+    packet_at = c_trace_pb_uint(packet_at, TPF_Packet_TrustedPacketSequenceID, TRACE_SEQUENCE_ID);
+    packet_at = c_trace_pb_bytes(packet_at, TPF_Packet_TrackEvent, event, (u64)(at - event));
+
+    c_trace_perfetto_packet(trace, packet, packet_at);
+}
+
+/*===========================================
+  =============== TRACKS ====================
+  ===========================================*/
+
+internal_api trace_thread_state_t*
+c_trace_get_thread(trace_capture_t *trace, u32 thread_id, const char *thread_name)
+{
+    trace_thread_state_t *result = null;
+    for(u32 thread_index = 0; thread_index < trace->thread_count; ++thread_index)
+    {
+        if(trace->threads[thread_index].thread_id == thread_id)
+        {
+            result = trace->threads + thread_index;
+            break;
+        }
+    }
+
+    if(!result && trace->thread_count < TRACE_MAX_THREADS)
+    {
+        result = trace->threads + trace->thread_count++;
+        result->thread_id = thread_id;
+        if(!thread_name) thread_name = "thread";
+
+        c_trace_json_append(trace, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":", TRACE_PROCESS_ID, thread_id);
+        c_trace_json_append_name(trace, thread_name);
+        c_trace_json_append(trace, "}}");
+
+        byte  thread_descriptor[TRACE_MAX_RECORD_SIZE / 4];
+        byte *thread_at = thread_descriptor;
+        thread_at = c_trace_pb_uint(thread_at, TPF_ThreadDescriptor_PID, TRACE_PROCESS_ID);
+        thread_at = c_trace_pb_uint(thread_at, TPF_ThreadDescriptor_TID, thread_id);
+        thread_at = c_trace_pb_string(thread_at, TPF_ThreadDescriptor_ThreadName, thread_name);
+
+        byte  descriptor[TRACE_MAX_RECORD_SIZE / 2];
+        byte *at = descriptor;
+        at = c_trace_pb_uint(at, TPF_TrackDescriptor_UUID, TRACE_THREAD_UUID(thread_id));
+        at = c_trace_pb_bytes(at, TPF_TrackDescriptor_Thread, thread_descriptor, (u64)(thread_at - thread_descriptor));
+        c_trace_perfetto_descriptor(trace, descriptor, at, false);
+    }
+
+    return(result);
+}
+
+// NOTE(Sleepster): Counters are matched by name, the same name from two places is the same track.
+internal_api u64
+c_trace_get_counter_track(trace_capture_t *trace, const char *name)
+{
+    u64 result = 0;
+    for(u32 track_index = 0; track_index < trace->counter_track_count; ++track_index)
+    {
+        trace_counter_track_t *track = trace->counter_tracks + track_index;
+        if(track->name == name || strcmp(track->name, name) == 0)
+        {
+            result = track->uuid;
+            break;
+        }
+    }
+
+    if(!result && trace->counter_track_count < TRACE_MAX_COUNTER_TRACKS)
+    {
+        u64 hash = 14695981039346656037ULL;
+        for(const char *c = name; *c; ++c)
+        {
+            hash = (hash ^ (u8)*c) * 1099511628211ULL;
+        }
+
+        trace_counter_track_t *track = trace->counter_tracks + trace->counter_track_count++;
+        track->name = name;
+        track->uuid = hash | (1ULL << 63);
+        result      = track->uuid;
+
+        byte  descriptor[TRACE_MAX_RECORD_SIZE / 2];
+        byte *at = descriptor;
+        at = c_trace_pb_uint(at, TPF_TrackDescriptor_UUID, track->uuid);
+        at = c_trace_pb_string(at, TPF_TrackDescriptor_Name, name);
+        at = c_trace_pb_uint(at, TPF_TrackDescriptor_ParentUUID, TRACE_PROCESS_UUID);
+        at = c_trace_pb_bytes(at, TPF_TrackDescriptor_Counter, null, 0);
+        c_trace_perfetto_descriptor(trace, descriptor, at, false);
+    }
+
+    return(result);
+}
+
+/*===========================================
+  =============== WRITER ====================
+  ===========================================*/
+
+internal_api void
+c_trace_write_header(trace_capture_t *trace)
+{
+    c_trace_json_append(trace, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    c_trace_json_append(trace, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":0,\"args\":{\"name\":\"NewSDLEngine\"}}", TRACE_PROCESS_ID);
+
+    byte  process_descriptor[TRACE_MAX_RECORD_SIZE / 4];
+    byte *process_at = process_descriptor;
+    process_at = c_trace_pb_uint(process_at, TPF_ProcessDescriptor_PID, TRACE_PROCESS_ID);
+    process_at = c_trace_pb_string(process_at, TPF_ProcessDescriptor_ProcessName, "NewSDLEngine");
+
+    byte  descriptor[TRACE_MAX_RECORD_SIZE / 2];
+    byte *at = descriptor;
+    at = c_trace_pb_uint(at, TPF_TrackDescriptor_UUID, TRACE_PROCESS_UUID);
+    at = c_trace_pb_bytes(at, TPF_TrackDescriptor_Process, process_descriptor, (u64)(process_at - process_descriptor));
+    c_trace_perfetto_descriptor(trace, descriptor, at, true);
+}
+
+// NOTE(Sleepster): Slices still open when the capture stopped end where their thread's last event was.
+internal_api void
+c_trace_write_footer(trace_capture_t *trace)
+{
+    for(u32 thread_index = 0; thread_index < trace->thread_count; ++thread_index)
+    {
+        trace_thread_state_t *thread = trace->threads + thread_index;
+        for(; thread->open_depth; --thread->open_depth)
+        {
+            c_trace_json_event(trace, null, "E", thread->thread_id, thread->last_timestamp_ns);
+            c_trace_json_append(trace, "}");
+            c_trace_perfetto_event(trace, thread->last_timestamp_ns, TRACE_THREAD_UUID(thread->thread_id), TPET_SliceEnd, null, 0, 0, 0.0);
+        }
+    }
+    c_trace_json_append(trace, "\n]}\n");
+}
+
+internal_api void
+c_trace_write_chunk(trace_capture_t *trace, trace_chunk_t *chunk)
+{
+    trace_thread_state_t *thread = c_trace_get_thread(trace, chunk->thread_id, chunk->thread_name);
+    if(!thread) return;
+
+    u64 track_uuid = TRACE_THREAD_UUID(chunk->thread_id);
+    for(u32 event_index = 0;
+        event_index < chunk->event_count;
+        ++event_index)
+    {
+        profiler_event_t *event     = chunk->events + event_index;
+        u32               kind      = (u32)(event->timestamp >> PROFILER_EVENT_KIND_SHIFT);
+        u64               timestamp = event->timestamp & PROFILER_EVENT_TIMESTAMP_MASK;
+        u64               value     = 0;
+        if(kind >= PEK_Counter) value = chunk->events[++event_index].timestamp;
+
+        // NOTE(Sleepster): Perf counter deltas are for the profiler's tree, the timeline doesn't show them.
+        if(kind == PEK_ZoneCounter) continue;
+
+        // NOTE(Sleepster): Anything from before the start, and the ends of zones that began before it.
+        if(timestamp < trace->start_timestamp) continue;
+        if(kind == PEK_End && thread->open_depth == 0) continue;
+
+        u64 timestamp_ns = (u64)((float64)(timestamp - trace->start_timestamp) * trace->ns_per_tick);
+        timestamp_ns     = Max(timestamp_ns, thread->last_timestamp_ns);
+        thread->last_timestamp_ns = timestamp_ns;
+        ++trace->events_written;
+
+        switch(kind)
+        {
+            case PEK_Begin:
+            {
+                ++thread->open_depth;
+                c_trace_json_event(trace, event->name, "B", chunk->thread_id, timestamp_ns);
+                c_trace_json_append(trace, "}");
+                c_trace_perfetto_event(trace, timestamp_ns, track_uuid, TPET_SliceBegin, event->name, 0, 0, 0.0);
+            }break;
+            case PEK_End:
+            {
+                --thread->open_depth;
+                c_trace_json_event(trace, null, "E", chunk->thread_id, timestamp_ns);
+                c_trace_json_append(trace, "}");
+                c_trace_perfetto_event(trace, timestamp_ns, track_uuid, TPET_SliceEnd, null, 0, 0, 0.0);
+            }break;
+            case PEK_Counter:
+            {
+                float64 counter_value;
+                memcpy(&counter_value, &value, sizeof(counter_value));
+
+                u64 counter_uuid = c_trace_get_counter_track(trace, event->name);
+                if(!counter_uuid) break;
+
+                c_trace_json_event(trace, event->name, "C", chunk->thread_id, timestamp_ns);
+                c_trace_json_append(trace, ",\"args\":{\"value\":%.6f}}", counter_value);
+                c_trace_perfetto_event(trace, timestamp_ns, counter_uuid, TPET_Counter, null, 0, 0, counter_value);
+            }break;
+            case PEK_FlowBegin:
+            case PEK_FlowStep:
+            case PEK_FlowEnd:
+            {
+                // NOTE(Sleepster): Chrome binds a flow to the slice it lands in, Perfetto wants an event to carry
+                //                  the id so it gets an instant on the thread's track.
+                const char *phase      = kind == PEK_FlowBegin ? "s" : kind == PEK_FlowStep ? "t" : "f";
+                u32         flow_field = kind == PEK_FlowEnd ? TPF_TrackEvent_TerminatingFlowIDs : TPF_TrackEvent_FlowIDs;
+                c_trace_json_event(trace, event->name, phase, chunk->thread_id, timestamp_ns);
+                c_trace_json_append(trace, ",\"cat\":\"flow\",\"id\":%llu%s}", (unsigned long long)value, kind == PEK_FlowEnd ? ",\"bp\":\"e\"" : "");
+                c_trace_perfetto_event(trace, timestamp_ns, track_uuid, TPET_Instant, event->name, flow_field, value, 0.0);
+            }break;
+            default:
+            {
+                InvalidCodePath;
+            }break;
+        }
+    }
+}
+
+PLATFORM_THREAD_PROC(c_trace_writer_proc)
+{
+    trace_capture_t *trace = (trace_capture_t*)user_data;
+    PROFILE_SET_THREAD_NAME("trace_writer");
+
+    for(;;)
+    {
+        c_futex_semaphore_wait(&trace->chunks_ready);
+
+        // NOTE(Sleepster): Read before draining, whatever was pushed before the stop is still written.
+        bool8          is_running = AtomicLoad32(&trace->writer_running);
+        trace_chunk_t *chunk      = null;
+        while(c_queue_pop(&trace->full_chunks, &chunk))
+        {
+            c_trace_write_chunk(trace, chunk);
+            chunk->event_count = 0;
+            c_queue_push(&trace->free_chunks, &chunk);
+        }
+
+        if(!is_running) break;
+    }
+
+    return(0);
+}
+
+/*===========================================
+  =============== CAPTURE ===================
+  ===========================================*/
+
+internal_api void
+c_trace_submit_chunk(trace_capture_t *trace)
+{
+    trace_chunk_t *chunk = trace->current_chunk;
+    if(chunk && chunk->event_count)
+    {
+        c_queue_push(&trace->full_chunks, &chunk);
+        c_futex_semaphore_release(&trace->chunks_ready);
+        trace->current_chunk = null;
+    }
+}
+
+// NOTE(Sleepster): An empty current chunk is reused as is, only the writer ever hands chunks back.
+internal_api trace_chunk_t*
+c_trace_begin_chunk(trace_capture_t *trace, u32 thread_id, const char *thread_name)
+{
+    c_trace_submit_chunk(trace);
+
+    trace_chunk_t *result = trace->current_chunk;
+    if(!result && !c_queue_pop(&trace->free_chunks, &result)) result = null;
+    if(result)
+    {
+        result->thread_id   = thread_id;
+        result->thread_name = thread_name;
+        result->event_count = 0;
+    }
+    trace->current_chunk = result;
+
+    return(result);
+}
+
+internal_api void
+c_trace_sink(void *user_data, profiler_thread_buffer_t *buffer, u64 first_event, u64 last_event)
+{
+    trace_capture_t *trace       = (trace_capture_t*)user_data;
+    const char      *thread_name = (const char*)(usize)AtomicLoad64(&buffer->thread_name);
+    for(u64 event_index = first_event;
+        event_index < last_event;
+        ++event_index)
+    {
+        profiler_event_t *event      = buffer->events + (event_index & (PROFILER_RING_EVENT_COUNT - 1));
+        u32               slot_count = ((event->timestamp >> PROFILER_EVENT_KIND_SHIFT) >= PEK_Counter) ? 2 : 1;
+
+        // NOTE(Sleepster): One thread per chunk, and a two slot event never straddles two of them.
+        trace_chunk_t *chunk = trace->current_chunk;
+        if(!chunk || chunk->thread_id != buffer->thread_id || chunk->event_count + slot_count > TRACE_CHUNK_EVENT_COUNT)
+        {
+            chunk = c_trace_begin_chunk(trace, buffer->thread_id, thread_name);
+            if(!chunk)
+            {
+                trace->dropped_events += last_event - event_index;
+                break;
+            }
+        }
+
+        chunk->events[chunk->event_count++] = *event;
+        if(slot_count == 2)
+        {
+            ++event_index;
+            chunk->events[chunk->event_count++] = buffer->events[event_index & (PROFILER_RING_EVENT_COUNT - 1)];
+        }
+    }
+}
+
+bool8
+c_trace_start(trace_capture_t *trace, const char *base_path, u32 frame_count)
+{
+    bool8 result = false;
+    if(trace->is_capturing)
+    {
+        log_warning("A trace capture is already running...\n");
+        return(result);
+    }
+
+    u32 capture_index = trace->capture_index;
+    ZeroStruct(*trace);
+    trace->capture_index        = capture_index + 1;
+    trace->json.file.handle     = INVALID_FILE_HANDLE;
+    trace->perfetto.file.handle = INVALID_FILE_HANDLE;
+    snprintf(trace->json.path,     TRACE_MAX_PATH_LENGTH, "%s_%u.json",           base_path, capture_index);
+    snprintf(trace->perfetto.path, TRACE_MAX_PATH_LENGTH, "%s_%u.perfetto-trace", base_path, capture_index);
+
+    if(!c_trace_output_open(&trace->json) || !c_trace_output_open(&trace->perfetto))
+    {
+        c_trace_output_close(&trace->json);
+        c_trace_output_close(&trace->perfetto);
+        return(result);
+    }
+
+    trace->chunk_memory = (trace_chunk_t*)sys_allocate_memory(sizeof(trace_chunk_t) * TRACE_CHUNK_COUNT);
+    Assert(trace->chunk_memory);
+    c_queue_create_typed(&trace->free_chunks, QK_SPSC, trace_chunk_t*, TRACE_CHUNK_COUNT);
+    c_queue_create_typed(&trace->full_chunks, QK_SPSC, trace_chunk_t*, TRACE_CHUNK_COUNT);
+    for(u32 chunk_index = 0; chunk_index < TRACE_CHUNK_COUNT; ++chunk_index)
+    {
+        trace_chunk_t *chunk = trace->chunk_memory + chunk_index;
+        c_queue_push(&trace->free_chunks, &chunk);
+    }
+
+    trace->ns_per_tick     = 1000000.0 / c_profiler_get_ticks_per_ms();
+    trace->start_timestamp = rdtsc();
+    c_trace_write_header(trace);
+
+    trace->writer_running  = true;
+    trace->writer_thread   = sys_thread_create(c_trace_writer_proc, trace, false);
+    c_profiler_set_event_sink(c_trace_sink, trace);
+
+    trace->frames_left     = frame_count;
+    trace->is_capturing    = true;
+    result                 = true;
+    if(frame_count) log_info("Trace capture started for '%u' frames, writing '%s' and '%s'...\n", frame_count, trace->json.path, trace->perfetto.path);
+    else            log_info("Trace capture started, writing '%s' and '%s'...\n", trace->json.path, trace->perfetto.path);
+
+    return(result);
+}
+
+void
+c_trace_stop(trace_capture_t *trace)
+{
+    if(!trace->is_capturing) return;
+
+    // NOTE(Sleepster): Nothing new comes in once the sink is gone, the writer drains what's left and exits.
+    c_profiler_set_event_sink(null, null);
+    c_trace_submit_chunk(trace);
+    AtomicStore32(&trace->writer_running, false);
+    c_futex_semaphore_release(&trace->chunks_ready);
+    sys_thread_join(&trace->writer_thread);
+
+    c_trace_write_footer(trace);
+    c_trace_output_close(&trace->json);
+    c_trace_output_close(&trace->perfetto);
+
+    bool8 failed = trace->json.failed || trace->perfetto.failed;
+    c_queue_destroy(&trace->free_chunks);
+    c_queue_destroy(&trace->full_chunks);
+    sys_free_memory(trace->chunk_memory, sizeof(trace_chunk_t) * TRACE_CHUNK_COUNT);
+    trace->chunk_memory  = null;
+    trace->current_chunk = null;
+    trace->is_capturing  = false;
+
+    if(failed)
+    {
+        log_error("Trace capture '%s' failed to write...\n", trace->json.path);
+    }
+    else
+    {
+        log_info("Trace capture finished, '%llu' events ('%llu' dropped), '%.2f' MB to '%s', '%.2f' MB to '%s'...\n",
+                 (unsigned long long)trace->events_written, (unsigned long long)trace->dropped_events,
+                 (float64)trace->json.bytes_written / (float64)MB(1), trace->json.path,
+                 (float64)trace->perfetto.bytes_written / (float64)MB(1), trace->perfetto.path);
+    }
+}
+
+void
+c_trace_frame_end(trace_capture_t *trace)
+{
+    if(trace->is_capturing)
+    {
+        c_trace_submit_chunk(trace);
+        if(trace->frames_left && --trace->frames_left == 0) c_trace_stop(trace);
+    }
+}
+
+#else
+
+bool8
+c_trace_start(trace_capture_t *trace, const char *base_path, u32 frame_count)
+{
+    log_warning("Trace capture needs the profiler, build with PROFILER_ENABLED=1...\n");
+    return(false);
+}
+
+void
+c_trace_stop(trace_capture_t *trace)
+{
+}
+
+void
+c_trace_frame_end(trace_capture_t *trace)
+{
+}
+
+#endif // PROFILER_ENABLED
@@ -0,0 +1,113 @@
+#if !defined(C_TRACE_H)
+/* ========================================================================
+   $File: c_trace.h $
+   $Date: October 19 2026 01:40 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define C_TRACE_H
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_file_api.h>
+#include <c_futex.h>
+#include <c_queue.h>
+#include <c_profiler.h>
+#include <p_platform_data.h>
+
+/* NOTE(Sleepster): Timeline capture, every zone, counter and flow the profiler sees written out as a trace.
+ *
+ * Two files per capture, '<base>_<n>.json' (Chrome trace format, chrome://tracing or ui.perfetto.dev) and
+ * '<base>_<n>.perfetto-trace' (Perfetto's protobuf format, ui.perfetto.dev or trace_processor). Both have the same
+ * events, one track per thread plus one per counter, flows are drawn as arrows between the slices they land in.
+ *
+ * The capture hangs off of the profiler's collapse as its event sink. The collapse already walks every thread's new
+ * events once a frame, the sink just copies them into chunks (one thread per chunk) and a writer thread formats and
+ * writes them in the background, so the game never waits on the disk. The chunks are all allocated up front, if the
+ * writer can't keep up the events that don't fit are dropped and counted instead of growing the memory.
+ *
+ * c_trace_frame_end() goes right after PROFILE_FRAME_END(), it hands the frame's chunk to the writer and stops the
+ * capture once 'frame_count' frames are in it (0 runs until c_trace_stop()).
+ *
+ * Main thread only. Does nothing when the profiler is compiled out.
+ */
+
+#define TRACE_CHUNK_EVENT_COUNT   (8192)
+#define TRACE_CHUNK_COUNT         (64)
+#define TRACE_MAX_THREADS         (64)
+#define TRACE_MAX_COUNTER_TRACKS  (128)
+#define TRACE_OUTPUT_BUFFER_SIZE  (MB(1))
+#define TRACE_MAX_PATH_LENGTH     (256)
+
+#if PROFILER_ENABLED
+
+struct trace_chunk_t
+{
+    u32               thread_id;
+    const char       *thread_name;
+    u32               event_count;
+    profiler_event_t  events[TRACE_CHUNK_EVENT_COUNT];
+};
+
+struct trace_thread_state_t
+{
+    u32         thread_id;
+    u32         open_depth;
+    u64         last_timestamp_ns;
+};
+
+struct trace_counter_track_t
+{
+    const char *name;
+    u64         uuid;
+};
+
+struct trace_output_t
+{
+    file_t      file;
+    char        path[TRACE_MAX_PATH_LENGTH];
+    byte       *buffer;
+    u64         used;
+    u64         bytes_written;
+    bool8       failed;
+};
+
+#endif // PROFILER_ENABLED
+
+struct trace_capture_t
+{
+    bool8                  is_capturing;
+    u32                    capture_index;
+    u32                    frames_left;
+
+#if PROFILER_ENABLED
+    // NOTE(Sleepster): Main thread.
+    trace_chunk_t         *chunk_memory;
+    trace_chunk_t         *current_chunk;
+    queue_t                free_chunks;
+    queue_t                full_chunks;
+    futex_semaphore_t      chunks_ready;
+    u64                    dropped_events;
+
+    // NOTE(Sleepster): Writer thread, the main thread only touches these before it starts and after it's joined.
+    sys_thread_t           writer_thread;
+    volatile u32           writer_running;
+    u64                    start_timestamp;
+    float64                ns_per_tick;
+    u64                    events_written;
+    trace_output_t         json;
+    trace_output_t         perfetto;
+
+    trace_thread_state_t   threads[TRACE_MAX_THREADS];
+    u32                    thread_count;
+    trace_counter_track_t  counter_tracks[TRACE_MAX_COUNTER_TRACKS];
+    u32                    counter_track_count;
+#endif
+};
+
+bool8 c_trace_start(trace_capture_t *trace, const char *base_path, u32 frame_count);
+void  c_trace_stop(trace_capture_t *trace);
+void  c_trace_frame_end(trace_capture_t *trace);
+
+#endif // C_TRACE_H
@@ -5,6 +5,7 @@
    $Creator: Justin Lewis $
    ======================================================================== */
 #include <c_zone_allocator.h>
+#include <c_profiler.h>
 #include <p_platform_data.h>
 
 ///////////////////
@@ -20,7 +21,7 @@ c_za_create(u64 block_size)
     result              = (zone_allocator_t*)base;
     result->base        = (u8*)base + sizeof(zone_allocator_t);
     result->capacity    = block_size;
-    result->mutex       = sys_mutex_create();
+    result->mutex       = {};
 
 
     zone_allocator_block_t *block      = (zone_allocator_block_t *)(result->base);
@@ -45,18 +46,25 @@ c_za_create(u64 block_size)
 void
 c_za_destroy(zone_allocator_t *zone)
 {
+    ALLOC_TRACK(AE_ZoneDestroy, zone, 0, 0, null, 0);
+    c_lock_profiler_unregister(&zone->mutex);
     sys_free_memory(zone, zone->capacity + sizeof(zone_allocator_t));
     zone = null;
 }
 
 byte*
-c_za_alloc(zone_allocator_t *zone, u64 size_init, za_allocation_tag_t tag)
+c_za_alloc_(zone_allocator_t *zone, u64 size_init, za_allocation_tag_t tag, const char *file, u32 line)
 {
     Assert(zone);
 
     byte *result = null;
-    bool8 locked = sys_mutex_lock(&zone->mutex, true);
-    Assert(locked);
+    if(!c_profiled_mutex_try_lock(&zone->mutex))
+    {
+        // NOTE(Sleepster): Only the contended case gets a zone, so the trace shows who waited and for how long. The
+        //                  lock profiler gets whoever called us as the wait site.
+        PROFILE_SCOPE("za_lock_wait");
+        c_profiled_mutex_lock_(&zone->mutex, file, line);
+    }
 
     u64 size = (size_init + 15) & ~15;
     size     = size + sizeof(zone_allocator_block_t);
@@ -98,6 +106,7 @@ c_za_alloc(zone_allocator_t *zone, u64 size_init, za_allocation_tag_t tag)
         if(block_cursor == starting_block)
         {
             log_fatal("failed to allocate memory to the zone allocator... allocation size of: %d...\n", size);
+            c_profiled_mutex_unlock(&zone->mutex);
             return(result);
         }
     }
@@ -123,27 +132,36 @@ c_za_alloc(zone_allocator_t *zone, u64 size_init, za_allocation_tag_t tag)
     base_block->block_id       = DEBUG_ZONE_ID;
     zone->cursor               = base_block->next_block;
 
+    u64 block_end           = (u64)(((byte*)base_block + base_block->block_size) - zone->base);
+    zone->used_bytes       += base_block->block_size;
+    zone->allocation_count += 1;
+    if(zone->used_bytes > zone->peak_used_bytes) zone->peak_used_bytes = zone->used_bytes;
+    if(block_end        > zone->touched_bytes)   zone->touched_bytes   = block_end;
+
     result = (byte*)base_block + sizeof(zone_allocator_block_t);
     memset(result, 0, size - sizeof(zone_allocator_block_t));
 
-    log_info("Zone Allocated: %d bytes...\n", size);
-    sys_mutex_unlock(&zone->mutex);
+    c_profiled_mutex_unlock(&zone->mutex);
+    ALLOC_TRACK(AE_ZoneAlloc, zone, result, size_init, file, line);
 
     return(result);
 }
 
 void
-c_za_free(zone_allocator_t *zone, void *data)
+c_za_free_(zone_allocator_t *zone, void *data, const char *file, u32 line)
 {
     zone_allocator_block_t *block = null;
     zone_allocator_block_t *other = null;
 
     block = (zone_allocator_block_t *)((byte*)data - sizeof(zone_allocator_block_t));
     Assert(block->block_id == DEBUG_ZONE_ID);
-    u64 block_size                = block->block_size;
-    za_allocation_tag_t block_tag = (za_allocation_tag_t)block->allocation_tag;
+    c_profiled_mutex_lock_(&zone->mutex, file, line);
     if(block->is_allocated)
     {
+        ALLOC_TRACK(AE_ZoneFree, zone, data, 0, null, 0);
+        zone->used_bytes       -= block->block_size;
+        zone->allocation_count -= 1;
+
         block->is_allocated   = false;
         block->allocation_tag = ZA_TAG_NONE;
         block->block_id       = 0;
@@ -173,12 +191,12 @@ c_za_free(zone_allocator_t *zone, void *data)
             }
         }
         data = null;
-        log_info("Freed a zone block with a size of '%d'... had an allocation tag of '%d'...\n", block_size, block_tag);
     }
     else
     {
         log_error("Attempted to free a block in the zone allocator that has not been allocated...\n");
     }
+    c_profiled_mutex_unlock(&zone->mutex);
 }
 
 void
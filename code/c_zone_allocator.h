@@ -14,6 +14,9 @@
 #include <c_base.h>
 #include <c_types.h>
 #include <c_synchronization.h>
+#include <c_futex.h>
+#include <c_alloc_tracker.h>
+#include <c_lock_profiler.h>
 
 #include <stdlib.h>
 
@@ -49,22 +52,31 @@ typedef struct zone_allocator_block
 
 typedef struct zone_allocator
 {
-    sys_mutex_t            mutex;
+    profiled_mutex_t       mutex;
     u64                    capacity;
     u8                    *base;
 
     zone_allocator_block_t  first_block;
     zone_allocator_block_t *cursor;
+
+    // NOTE(Sleepster): Telemetry, block headers included. 'touched_bytes' is the furthest into the zone any block
+    //                  has ever reached, the OS only commits what's been written.
+    u64                     used_bytes;
+    u64                     peak_used_bytes;
+    u64                     touched_bytes;
+    u64                     allocation_count;
 }zone_allocator_t;
 
 //////////// ZONE ALLOCATOR API DEFINITIONS /////////////
+#define c_za_alloc(zone, size, tag)              c_za_alloc_(zone, size, tag, __FILE__, __LINE__)
+#define c_za_free(zone, data)                    c_za_free_(zone, data, __FILE__, __LINE__)
 #define c_za_push_struct(zone, type, tag)        (type*)c_za_alloc(zone, sizeof(type), tag);
 #define c_za_push_array(zone, type, count, tag)  (type*)c_za_alloc(zone, sizeof(type) * count, tag);
 
 zone_allocator_t* c_za_create(u64 block_size);
 void              c_za_destroy(zone_allocator_t *zone);
-byte*             c_za_alloc(zone_allocator_t *zone, u64 size_init, za_allocation_tag_t tag);
-void              c_za_free(zone_allocator_t  *zone, void *data);
+byte*             c_za_alloc_(zone_allocator_t *zone, u64 size_init, za_allocation_tag_t tag, const char *file, u32 line);
+void              c_za_free_(zone_allocator_t  *zone, void *data, const char *file, u32 line);
 void              c_za_free_zone_tag(zone_allocator_t *zone, za_allocation_tag_t tag);
 void              c_za_free_zone_tag_range(zone_allocator_t *zone, za_allocation_tag_t low_tag, za_allocation_tag_t high_tag);
 void              c_za_change_zone_tag(zone_allocator_t *zone, void *pointer, za_allocation_tag_t new_tag);
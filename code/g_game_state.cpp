@@ -0,0 +1,109 @@
+/* ========================================================================
+   $File: g_game_state.cpp $
+   $Date: October 19 2026 06:40 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <c_base.h>
+#include <c_types.h>
+#include <c_intrinsics.h>
+#include <c_hash_table.h>
+#include <c_profiler.h>
+#include <c_globals.h>
+
+#include <g_game_state.h>
+#include <g_entity.h>
+#include <g_replay.h>
+
+const char *simulation_system_names[GSS_Count] =
+{
+    "input",
+    "network",
+    "players",
+};
+
+void
+g_game_state_seed_random(game_state_t *state, u64 seed)
+{
+    state->random_seed  = seed;
+    state->random_state = seed ? seed : 0x9E3779B97F4A7C15ULL;
+}
+
+// NOTE(Sleepster): xorshift64*, anything in the simulation that wants a random number has to take it from here or a
+// replay won't come out the same.
+u32
+g_random_next(game_state_t *state)
+{
+    u64 x = state->random_state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    state->random_state = x;
+
+    u32 result = (u32)((x * 0x2545F4914F6CDD1DULL) >> 32);
+    return(result);
+}
+
+float32
+g_random_unilateral(game_state_t *state)
+{
+    float32 result = (float32)(g_random_next(state) >> 8) * (1.0f / 16777216.0f);
+    return(result);
+}
+
+void
+g_simulation_system_end(game_state_t *state, u32 system, u64 start_cycles)
+{
+    Assert(system < GSS_Count);
+    state->simulation_timings.cycles[system] += rdtsc() - start_cycles;
+    state->simulation_timings.calls[system]  += 1;
+}
+
+void
+g_simulate_tick(game_state_t *state)
+{
+    replay_recorder_t *recorder = state->replay_recorder;
+    if(recorder) g_replay_record_spawns(recorder, state);
+
+    {
+        PROFILE_SCOPE("simulate_players");
+        u64 start_cycles = rdtsc();
+        for(u32 entity_index = 0;
+            entity_index < state->entity_manager.active_entities;
+            ++entity_index)
+        {
+            entity_t *entity = state->entity_manager.entities + entity_index;
+            switch(entity->e_type)
+            {
+                case ET_Player:
+                {
+                    client_data_t *entity_client = state->clients + entity->owner_client_id;
+                    while(entity_client->input_data_tail != entity_client->input_data_head)
+                    {
+                        input_data_t *input_data = entity_client->input_data_buffer + entity_client->input_data_tail;
+                        entity_client->input_data_tail = (entity_client->input_data_tail + 1) % MAX_BUFFERED_INPUTS;
+                        if(recorder) g_replay_record_input(recorder, entity->owner_client_id, input_data);
+
+                        entity_simulate_player(entity, input_data, gcv_tick_rate);
+                    }
+                }break;
+            }
+        }
+        g_simulation_system_end(state, GSS_Players, start_cycles);
+    }
+
+    if(recorder) g_replay_end_tick(recorder);
+    ++state->tick_index;
+}
+
+// NOTE(Sleepster): What the replay compares against at the end, if this moves the simulation isn't deterministic anymore.
+u64
+g_game_state_checksum(game_state_t *state)
+{
+    u64 result = c_fnv_hash_value((byte*)state->entity_manager.entities,
+                                  state->entity_manager.active_entities * sizeof(entity_t));
+    result ^= c_fnv_hash_value((byte*)&state->tick_index,   sizeof(state->tick_index));
+    result ^= c_fnv_hash_value((byte*)&state->random_state, sizeof(state->random_state)) * 31;
+
+    return(result);
+}
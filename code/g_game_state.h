@@ -24,6 +24,34 @@ struct input_data_t
 
 #define MAX_BUFFERED_INPUTS (1024)
 
+// NOTE(Sleepster): The fixed step's systems, every tick keeps how long each one took so a replay can report them.
+enum simulation_system_t
+{
+    GSS_Input,
+    GSS_Network,
+    GSS_Players,
+    GSS_Count
+};
+
+struct simulation_timings_t
+{
+    u64 cycles[GSS_Count];
+    u64 calls[GSS_Count];
+};
+
+struct replay_recorder_t;
+
+// NOTE(Sleepster): Since startup, everything that went through sendto() and recvfrom().
+struct network_stats_t
+{
+    u64 packets_sent;
+    u64 bytes_sent;
+    u64 packets_received;
+    u64 bytes_received;
+    u64 send_errors;
+    u64 invalid_packets;
+};
+
 struct client_data_t 
 {
     u32                ID;
@@ -54,8 +82,28 @@ struct game_state_t
     u32                client_id;
     client_data_t      clients[4];
     u32                connected_client_count;
+    network_stats_t    network_stats;
+
+    // NOTE(Sleepster): Anything random in the simulation comes out of random_state, a replay starts from the same seed.
+    u64                  tick_index;
+    u64                  random_seed;
+    u64                  random_state;
+    simulation_timings_t simulation_timings;
+    replay_recorder_t   *replay_recorder;
 };
 
+extern const char *simulation_system_names[GSS_Count];
+
+void    g_game_state_seed_random(game_state_t *state, u64 seed);
+u32     g_random_next(game_state_t *state);
+float32 g_random_unilateral(game_state_t *state);
+
+// NOTE(Sleepster): One fixed step. The inputs have to be in the client rings already, live that's the local input plus
+// whatever came off the network, in a replay it's what was recorded.
+void    g_simulate_tick(game_state_t *state);
+void    g_simulation_system_end(game_state_t *state, u32 system, u64 start_cycles);
+u64     g_game_state_checksum(game_state_t *state);
+
 
 #endif // G_GAME_STATE_H
 
@@ -0,0 +1,508 @@
+/* ========================================================================
+   $File: g_replay.cpp $
+   $Date: October 19 2026 06:40 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <SDL3/SDL.h>
+
+#include <c_base.h>
+#include <c_types.h>
+#include <c_intrinsics.h>
+#include <c_log.h>
+#include <c_globals.h>
+#include <c_profiler.h>
+#include <c_file_api.h>
+#include <c_memory_arena.h>
+
+#include <g_game_state.h>
+#include <g_entity.h>
+#include <g_replay.h>
+
+#define REPLAY_BUILDER_BLOCK_SIZE (KB(64))
+#define REPLAY_SYNTHETIC_PLAYERS  (4)
+
+void
+g_replay_recorder_begin(replay_recorder_t *recorder, game_state_t *state, string_t filepath)
+{
+    recorder->filepath            = filepath;
+    recorder->header              = {};
+    recorder->header.magic_value  = REPLAY_FILE_MAGIC;
+    recorder->header.version      = REPLAY_FILE_VERSION;
+    recorder->header.tick_rate    = gcv_tick_rate;
+    recorder->header.client_id    = state->client_id;
+    recorder->header.random_seed  = state->random_state;
+    recorder->header.entity_count = state->entity_manager.active_entities;
+
+    c_string_builder_init(&recorder->snapshot_builder, REPLAY_BUILDER_BLOCK_SIZE);
+    c_string_builder_init(&recorder->run_builder,      REPLAY_BUILDER_BLOCK_SIZE);
+    if(state->entity_manager.active_entities)
+    {
+        c_string_builder_append_value(&recorder->snapshot_builder,
+                                      state->entity_manager.entities,
+                                      state->entity_manager.active_entities * sizeof(entity_t));
+    }
+
+    recorder->known_entity_count  = state->entity_manager.active_entities;
+    recorder->tick_event_count    = 0;
+    recorder->tick_spawn_count    = 0;
+    recorder->dropped_event_count = 0;
+    recorder->has_open_run        = false;
+
+    // NOTE(Sleepster): The replay starts from tick 0, the live tick_index only matters for the checksum at the end.
+    state->tick_index      = 0;
+    state->replay_recorder = recorder;
+    log_info("Recording inputs to '%s'...\n", C_STR(filepath));
+}
+
+// NOTE(Sleepster): entity_create() only ever appends, so anything past known_entity_count was made this tick.
+void
+g_replay_record_spawns(replay_recorder_t *recorder, game_state_t *state)
+{
+    while(recorder->known_entity_count < state->entity_manager.active_entities)
+    {
+        if(recorder->tick_spawn_count < REPLAY_MAX_SPAWNS_PER_TICK)
+        {
+            recorder->tick_spawns[recorder->tick_spawn_count++] = state->entity_manager.entities[recorder->known_entity_count];
+        }
+        else
+        {
+            log_warning("More than '%d' entities were made in one tick, the replay won't have them...\n", REPLAY_MAX_SPAWNS_PER_TICK);
+        }
+        ++recorder->known_entity_count;
+    }
+}
+
+void
+g_replay_record_input(replay_recorder_t *recorder, u32 client_id, input_data_t *input_data)
+{
+    if(recorder->tick_event_count < REPLAY_MAX_EVENTS_PER_TICK)
+    {
+        replay_event_t *event = recorder->tick_events + recorder->tick_event_count++;
+        event->client_id  = (u8)client_id;
+        event->input_axis = input_data->input_axis;
+    }
+    else
+    {
+        ++recorder->dropped_event_count;
+    }
+}
+
+internal_api void
+g_replay_write_run(replay_recorder_t *recorder, replay_run_t *run, entity_t *spawns, replay_event_t *events)
+{
+    c_string_builder_append_value(&recorder->run_builder, run, sizeof(replay_run_t));
+    if(run->spawn_count) c_string_builder_append_value(&recorder->run_builder, spawns, run->spawn_count * sizeof(entity_t));
+    if(run->event_count) c_string_builder_append_value(&recorder->run_builder, events, run->event_count * sizeof(replay_event_t));
+
+    ++recorder->header.run_count;
+}
+
+internal_api void
+g_replay_close_open_run(replay_recorder_t *recorder)
+{
+    if(recorder->has_open_run)
+    {
+        g_replay_write_run(recorder, &recorder->open_run, null, recorder->open_run_events);
+        recorder->has_open_run = false;
+    }
+}
+
+void
+g_replay_end_tick(replay_recorder_t *recorder)
+{
+    if(recorder->dropped_event_count)
+    {
+        log_warning("Dropped '%d' inputs from tick '%llu', more than '%d' in one tick...\n",
+                    recorder->dropped_event_count, recorder->header.tick_count, REPLAY_MAX_EVENTS_PER_TICK);
+        recorder->dropped_event_count = 0;
+    }
+
+    u32   event_bytes  = recorder->tick_event_count * sizeof(replay_event_t);
+    bool8 extends_open = recorder->has_open_run                                     &&
+                         recorder->tick_spawn_count      == 0                        &&
+                         recorder->open_run.event_count  == recorder->tick_event_count &&
+                         recorder->open_run.repeat_count <  0xFFFFFFFF              &&
+                         memcmp(recorder->open_run_events, recorder->tick_events, event_bytes) == 0;
+    if(extends_open)
+    {
+        ++recorder->open_run.repeat_count;
+    }
+    else
+    {
+        g_replay_close_open_run(recorder);
+
+        replay_run_t run = {};
+        run.repeat_count = 1;
+        run.event_count  = (u8)recorder->tick_event_count;
+        run.spawn_count  = (u8)recorder->tick_spawn_count;
+        if(run.spawn_count)
+        {
+            g_replay_write_run(recorder, &run, recorder->tick_spawns, recorder->tick_events);
+        }
+        else
+        {
+            recorder->open_run     = run;
+            recorder->has_open_run = true;
+            memcpy(recorder->open_run_events, recorder->tick_events, event_bytes);
+        }
+    }
+
+    recorder->tick_event_count = 0;
+    recorder->tick_spawn_count = 0;
+    ++recorder->header.tick_count;
+}
+
+// NOTE(Sleepster): Stops the recording, the file is the result pushed onto the arena.
+string_t
+g_replay_recorder_serialize(replay_recorder_t *recorder, game_state_t *state, memory_arena_t *arena)
+{
+    g_replay_close_open_run(recorder);
+    recorder->header.final_checksum = g_game_state_checksum(state);
+    state->replay_recorder          = null;
+
+    string_t snapshot = c_string_builder_get_current_string(&recorder->snapshot_builder);
+    string_t runs     = c_string_builder_get_current_string(&recorder->run_builder);
+
+    string_t result = {};
+    result.count = sizeof(replay_file_header_t) + snapshot.count + runs.count;
+    result.data  = c_arena_push_size(arena, result.count);
+    memcpy(result.data, &recorder->header, sizeof(replay_file_header_t));
+    if(snapshot.count) memcpy(result.data + sizeof(replay_file_header_t), snapshot.data, snapshot.count);
+    if(runs.count)     memcpy(result.data + sizeof(replay_file_header_t) + snapshot.count, runs.data, runs.count);
+
+    c_string_builder_deinit(&recorder->snapshot_builder);
+    c_string_builder_deinit(&recorder->run_builder);
+
+    return(result);
+}
+
+bool8
+g_replay_recorder_finish(replay_recorder_t *recorder, game_state_t *state)
+{
+    bool8 result = false;
+
+    memory_arena_t arena     = c_arena_create(MB(1));
+    string_t       file_data = g_replay_recorder_serialize(recorder, state, &arena);
+
+    file_t file = sys_file_open(recorder->filepath, true, false, false);
+    if(file.handle != INVALID_FILE_HANDLE)
+    {
+        result = c_file_write(&file, file_data.data, file_data.count);
+        c_file_close(&file);
+    }
+
+    if(result)
+    {
+        log_info("Recorded '%llu' ticks in '%d' runs to '%s' ('%llu' bytes)...\n",
+                 recorder->header.tick_count, recorder->header.run_count, C_STR(recorder->filepath), file_data.count);
+    }
+    else
+    {
+        log_error("Failed to write the replay to '%s'...\n", C_STR(recorder->filepath));
+    }
+    c_arena_destroy(&arena);
+
+    return(result);
+}
+
+// NOTE(Sleepster): xorshift64*, the inputs' own RNG. Drawing from the game's would change what the simulation draws.
+internal_api u64
+g_replay_synthetic_random_next(u64 *random_state)
+{
+    u64 value = *random_state;
+    value ^= value >> 12;
+    value ^= value << 25;
+    value ^= value >> 27;
+    *random_state = value;
+
+    return(value * 0x2545F4914F6CDD1DULL);
+}
+
+/* NOTE(Sleepster): A recording nobody had to play. 'player_count' players join on the first tick and each one picks a
+ * new direction (or stops) every quarter second or so, for 'tick_count' ticks. The same seed is the same recording on
+ * every machine, which is what the benchmarks and the PGO training run ('make pgo') want. 'state' has to be zeroed,
+ * the recorder is left open for g_replay_recorder_serialize() or g_replay_recorder_finish().
+ */
+void
+g_replay_record_synthetic(replay_recorder_t *recorder, game_state_t *state, string_t filepath, u32 player_count, u32 tick_count, u64 seed)
+{
+    Assert(player_count <= ArrayCount(state->clients));
+
+    g_game_state_seed_random(state, seed);
+    for(u32 client_index = 0; client_index < player_count; ++client_index)
+    {
+        state->client_id                = client_index;
+        state->clients[client_index].ID = client_index;
+        entity_t *player = entity_create(state);
+        player->e_type   = ET_Player;
+        state->clients[client_index].player = player;
+    }
+
+    u64    input_random_state = seed ^ 0x9E3779B97F4A7C15ULL;
+    vec2_t input_axes[ArrayCount(state->clients)] = {};
+    g_replay_recorder_begin(recorder, state, filepath);
+    for(u32 tick_index = 0; tick_index < tick_count; ++tick_index)
+    {
+        for(u32 client_index = 0; client_index < player_count; ++client_index)
+        {
+            if((g_replay_synthetic_random_next(&input_random_state) % 15) == 0)
+            {
+                u64 direction = g_replay_synthetic_random_next(&input_random_state);
+                input_axes[client_index] = vec2((float32)((s32)(direction % 3) - 1), (float32)((s32)((direction >> 8) % 3) - 1));
+            }
+
+            client_data_t *client = state->clients + client_index;
+            client->input_data_buffer[client->input_data_head].input_axis = input_axes[client_index];
+            client->input_data_head = (client->input_data_head + 1) % MAX_BUFFERED_INPUTS;
+        }
+        g_simulate_tick(state);
+    }
+}
+
+// NOTE(Sleepster): '-replay_generate', a synthetic recording of four players written to disk for '-replay' to read.
+s32
+g_replay_write_synthetic(string_t filepath, u32 tick_count, u64 seed)
+{
+    game_state_t      *state    = (game_state_t*)calloc(1, sizeof(game_state_t));
+    replay_recorder_t *recorder = (replay_recorder_t*)calloc(1, sizeof(replay_recorder_t));
+
+    g_replay_record_synthetic(recorder, state, filepath, REPLAY_SYNTHETIC_PLAYERS, tick_count, seed);
+    s32 result = g_replay_recorder_finish(recorder, state) ? 0 : 1;
+
+    free(recorder);
+    free(state);
+    return(result);
+}
+
+replay_data_t
+g_replay_load_from_memory(string_t file_data)
+{
+    replay_data_t result = {};
+    result.file_data = file_data;
+
+    if(file_data.count >= sizeof(replay_file_header_t))
+    {
+        replay_file_header_t *header = (replay_file_header_t*)file_data.data;
+        u64 snapshot_size = (u64)header->entity_count * sizeof(entity_t);
+        if(header->magic_value != REPLAY_FILE_MAGIC || header->version != REPLAY_FILE_VERSION)
+        {
+            log_error("Not a replay file, or a replay from an older version...\n");
+        }
+        else if(header->entity_count > ArrayCount(((entity_manager_t*)0)->entities) ||
+                sizeof(replay_file_header_t) + snapshot_size > file_data.count)
+        {
+            log_error("Replay file is truncated...\n");
+        }
+        else
+        {
+            if(header->tick_rate != gcv_tick_rate)
+            {
+                log_warning("Replay was recorded at a tick rate of '%f', we're running at '%f', it won't match...\n",
+                            header->tick_rate, gcv_tick_rate);
+            }
+
+            result.header    = header;
+            result.entities  = (entity_t*)(file_data.data + sizeof(replay_file_header_t));
+            result.runs      = file_data.data + sizeof(replay_file_header_t) + snapshot_size;
+            result.runs_size = file_data.count - (sizeof(replay_file_header_t) + snapshot_size);
+            result.is_valid  = true;
+        }
+    }
+    else
+    {
+        log_error("Replay file is too small to have a header...\n");
+    }
+
+    return(result);
+}
+
+replay_data_t
+g_replay_load(string_t filepath, memory_arena_t *arena)
+{
+    replay_data_t result = {};
+
+    // NOTE(Sleepster): Not c_file_open(), that asserts on a missing file and a bad '-replay' path shouldn't.
+    file_t file = sys_file_open(filepath, false, false, false);
+    if(file.handle != INVALID_FILE_HANDLE)
+    {
+        s64 file_size = c_file_get_size(&file);
+        if(file_size > 0)
+        {
+            string_t file_data = c_file_read(&file, (u32)file_size, arena);
+            result = g_replay_load_from_memory(file_data);
+        }
+        c_file_close(&file);
+    }
+    else
+    {
+        log_error("Failed to open replay file '%s'...\n", C_STR(filepath));
+    }
+
+    return(result);
+}
+
+void
+g_replay_reset_state(replay_data_t *replay, game_state_t *state)
+{
+    Assert(replay->is_valid);
+
+    ZeroStruct(state->entity_manager);
+    ZeroStruct(state->simulation_timings);
+    for(u32 client_index = 0; client_index < ArrayCount(state->clients); ++client_index)
+    {
+        client_data_t *client   = state->clients + client_index;
+        client->player          = null;
+        client->input_data_head = 0;
+        client->input_data_tail = 0;
+    }
+
+    memcpy(state->entity_manager.entities, replay->entities, replay->header->entity_count * sizeof(entity_t));
+    state->entity_manager.active_entities = replay->header->entity_count;
+    state->client_id       = replay->header->client_id;
+    state->tick_index      = 0;
+    state->replay_recorder = null;
+    state->random_seed     = replay->header->random_seed;
+    state->random_state    = replay->header->random_seed;
+}
+
+internal_api void
+g_replay_push_input(game_state_t *state, replay_event_t *event)
+{
+    if(event->client_id < ArrayCount(state->clients))
+    {
+        client_data_t *client = state->clients + event->client_id;
+        client->input_data_buffer[client->input_data_head].input_axis = event->input_axis;
+        client->input_data_head = (client->input_data_head + 1) % MAX_BUFFERED_INPUTS;
+    }
+}
+
+/* NOTE(Sleepster): Runs the whole replay as fast as it'll go. The state has to be g_replay_reset_state()'d first, it
+ * ends a profiler frame every second of game time so the profiler's rings don't fill up on long replays.
+ */
+replay_stats_t
+g_replay_run(replay_data_t *replay, game_state_t *state)
+{
+    replay_stats_t result = {};
+    Assert(replay->is_valid);
+
+    u64 start_counter = SDL_GetPerformanceCounter();
+
+    byte *cursor = replay->runs;
+    byte *end    = replay->runs + replay->runs_size;
+    for(u32 run_index = 0; run_index < replay->header->run_count; ++run_index)
+    {
+        if(cursor + sizeof(replay_run_t) > end)
+        {
+            log_error("Replay ends after '%d' of '%d' runs...\n", run_index, replay->header->run_count);
+            break;
+        }
+        replay_run_t   *run    = (replay_run_t*)cursor;
+        entity_t       *spawns = (entity_t*)(cursor + sizeof(replay_run_t));
+        replay_event_t *events = (replay_event_t*)(spawns + run->spawn_count);
+        cursor = (byte*)(events + run->event_count);
+        if(cursor > end)
+        {
+            log_error("Replay run '%d' is truncated...\n", run_index);
+            break;
+        }
+
+        for(u32 spawn_index = 0; spawn_index < run->spawn_count; ++spawn_index)
+        {
+            Assert(state->entity_manager.active_entities < ArrayCount(state->entity_manager.entities));
+            state->entity_manager.entities[state->entity_manager.active_entities++] = spawns[spawn_index];
+        }
+
+        for(u32 repeat_index = 0; repeat_index < run->repeat_count; ++repeat_index)
+        {
+            for(u32 event_index = 0; event_index < run->event_count; ++event_index)
+            {
+                g_replay_push_input(state, events + event_index);
+            }
+            g_simulate_tick(state);
+
+            if((state->tick_index % 60) == 0)
+            {
+                PROFILE_FRAME_END();
+            }
+        }
+    }
+
+    u64 end_counter = SDL_GetPerformanceCounter();
+
+    result.ticks            = state->tick_index;
+    result.seconds          = (float64)(end_counter - start_counter) / (float64)SDL_GetPerformanceFrequency();
+    result.ticks_per_second = result.seconds > 0.0 ? (float64)result.ticks / result.seconds : 0.0;
+    result.realtime_factor  = result.ticks_per_second * (float64)gcv_tick_rate;
+    result.checksum         = g_game_state_checksum(state);
+    result.checksum_matches = result.checksum == replay->header->final_checksum;
+
+    return(result);
+}
+
+/* NOTE(Sleepster): '-replay=<path>', no window, no renderer, no sockets. Every pass starts from the recorded state, the
+ * per-system timings are over all of them. Returns non-zero if any pass didn't come out with the recorded checksum.
+ */
+s32
+g_replay_run_headless(string_t filepath, u32 repeat_count)
+{
+    s32 result = 0;
+
+    memory_arena_t arena  = c_arena_create(MB(4));
+    replay_data_t  replay = g_replay_load(filepath, &arena);
+    if(replay.is_valid)
+    {
+        game_state_t *state = (game_state_t*)calloc(1, sizeof(game_state_t));
+        if(repeat_count == 0) repeat_count = 1;
+
+        log_info("Replaying '%s', '%llu' ticks in '%d' runs, '%d' entities, '%d' passes...\n",
+                 C_STR(filepath), replay.header->tick_count, replay.header->run_count, replay.header->entity_count, repeat_count);
+
+        simulation_timings_t timings = {};
+        float64 best_ticks_per_second = 0.0;
+        float64 total_seconds         = 0.0;
+        u64     total_ticks           = 0;
+        u64     start_cycles          = rdtsc();
+        for(u32 pass_index = 0; pass_index < repeat_count; ++pass_index)
+        {
+            g_replay_reset_state(&replay, state);
+            replay_stats_t stats = g_replay_run(&replay, state);
+            for(u32 system = 0; system < GSS_Count; ++system)
+            {
+                timings.cycles[system] += state->simulation_timings.cycles[system];
+                timings.calls[system]  += state->simulation_timings.calls[system];
+            }
+
+            total_seconds        += stats.seconds;
+            total_ticks          += stats.ticks;
+            best_ticks_per_second = Max(best_ticks_per_second, stats.ticks_per_second);
+            if(!stats.checksum_matches)
+            {
+                log_error("Pass '%d' checksum '%016llx' doesn't match the recorded '%016llx', the simulation isn't deterministic...\n",
+                          pass_index, stats.checksum, replay.header->final_checksum);
+                result = 1;
+            }
+        }
+        u64 total_cycles = rdtsc() - start_cycles;
+
+        float64 ticks_per_second = total_seconds > 0.0 ? (float64)total_ticks / total_seconds : 0.0;
+        float64 cycles_per_ns    = total_seconds > 0.0 ? (float64)total_cycles / (total_seconds * 1000000000.0) : 1.0;
+        log_info("Replay: '%llu' ticks in '%.3f' s, '%.0f' ticks/s (best pass '%.0f'), '%.1f'x realtime...\n",
+                 total_ticks, total_seconds, ticks_per_second, best_ticks_per_second, ticks_per_second * (float64)gcv_tick_rate);
+        for(u32 system = 0; system < GSS_Count; ++system)
+        {
+            if(timings.calls[system] == 0) continue;
+            float64 ns_per_tick = ((float64)timings.cycles[system] / cycles_per_ns) / (float64)timings.calls[system];
+            log_info("    %-10s '%10.1f' ns/tick over '%llu' ticks...\n", simulation_system_names[system], ns_per_tick, timings.calls[system]);
+        }
+
+        free(state);
+    }
+    else
+    {
+        result = 1;
+    }
+    c_arena_destroy(&arena);
+
+    return(result);
+}
@@ -0,0 +1,124 @@
+#if !defined(G_REPLAY_H)
+/* ========================================================================
+   $File: g_replay.h $
+   $Date: October 19 2026 06:40 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define G_REPLAY_H
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_string.h>
+
+#include <g_game_state.h>
+#include <g_entity.h>
+
+/* NOTE(Sleepster): A replay is everything the fixed step consumed, so running it again without a window lands on the
+ * exact same state. The file is:
+ *
+ * - replay_file_header_t
+ * - entity_count entity_t's, the world when the recording started
+ * - run_count runs, a replay_run_t followed by spawn_count entity_t's and event_count replay_event_t's
+ *
+ * A run is repeat_count ticks that all consumed the same inputs, so holding a key down (or not touching anything) for a
+ * minute is one run instead of 3600 ticks. Spawns are the entities that showed up during the tick (clients joining),
+ * a run with spawns is never repeated.
+ */
+
+#if !defined(FOURCC)
+    #define FOURCC(string) (((u32)(string[0]) << 0) | ((u32)(string[1]) << 8) | ((u32)(string[2]) << 16) | ((u32)(string[3]) << 24))
+#endif
+
+#define REPLAY_FILE_MAGIC          (FOURCC("rply"))
+#define REPLAY_FILE_VERSION        (1)
+#define REPLAY_MAX_EVENTS_PER_TICK (64)
+#define REPLAY_MAX_SPAWNS_PER_TICK (16)
+
+#pragma pack(push, 1)
+typedef struct replay_file_header
+{
+    u32     magic_value;
+    u32     version;
+    float32 tick_rate;
+    u32     client_id;
+    u64     random_seed;    // NOTE(Sleepster): random_state when the recording started, not the '-seed' it came from
+    u64     tick_count;
+    u64     final_checksum;
+    u32     entity_count;
+    u32     run_count;
+}replay_file_header_t;
+
+typedef struct replay_run
+{
+    u32 repeat_count;
+    u8  event_count;
+    u8  spawn_count;
+}replay_run_t;
+
+typedef struct replay_event
+{
+    u8     client_id;
+    vec2_t input_axis;
+}replay_event_t;
+#pragma pack(pop)
+
+StaticAssert(sizeof(replay_file_header_t) % 4 == 0, "replay file header is not 4 byte aligned...\n");
+
+struct replay_recorder_t
+{
+    string_t             filepath;
+    replay_file_header_t header;
+    string_builder_t     snapshot_builder;
+    string_builder_t     run_builder;
+    u32                  known_entity_count;
+
+    replay_event_t       tick_events[REPLAY_MAX_EVENTS_PER_TICK];
+    u32                  tick_event_count;
+    entity_t             tick_spawns[REPLAY_MAX_SPAWNS_PER_TICK];
+    u32                  tick_spawn_count;
+    u32                  dropped_event_count;
+
+    // NOTE(Sleepster): The run that's still open, it gets written once a tick comes along that doesn't match it.
+    replay_run_t         open_run;
+    replay_event_t       open_run_events[REPLAY_MAX_EVENTS_PER_TICK];
+    bool8                has_open_run;
+};
+
+typedef struct replay_data
+{
+    bool8                 is_valid;
+    replay_file_header_t *header;
+    entity_t             *entities;
+    byte                 *runs;
+    u64                   runs_size;
+    string_t              file_data;
+}replay_data_t;
+
+typedef struct replay_stats
+{
+    u64     ticks;
+    float64 seconds;
+    float64 ticks_per_second;
+    float64 realtime_factor;
+    u64     checksum;
+    bool8   checksum_matches;
+}replay_stats_t;
+
+void           g_replay_recorder_begin(replay_recorder_t *recorder, game_state_t *state, string_t filepath);
+void           g_replay_record_spawns(replay_recorder_t *recorder, game_state_t *state);
+void           g_replay_record_input(replay_recorder_t *recorder, u32 client_id, input_data_t *input_data);
+void           g_replay_end_tick(replay_recorder_t *recorder);
+string_t       g_replay_recorder_serialize(replay_recorder_t *recorder, game_state_t *state, memory_arena_t *arena);
+bool8          g_replay_recorder_finish(replay_recorder_t *recorder, game_state_t *state);
+void           g_replay_record_synthetic(replay_recorder_t *recorder, game_state_t *state, string_t filepath, u32 player_count, u32 tick_count, u64 seed);
+s32            g_replay_write_synthetic(string_t filepath, u32 tick_count, u64 seed);
+
+replay_data_t  g_replay_load_from_memory(string_t file_data);
+replay_data_t  g_replay_load(string_t filepath, memory_arena_t *arena);
+void           g_replay_reset_state(replay_data_t *replay, game_state_t *state);
+replay_stats_t g_replay_run(replay_data_t *replay, game_state_t *state);
+s32            g_replay_run_headless(string_t filepath, u32 repeat_count);
+
+#endif // G_REPLAY_H
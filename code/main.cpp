@@ -15,27 +15,42 @@
 #include <c_string.h>
 #include <c_dynarray.h>
 #include <c_threadpool.h>
+#include <c_task_graph.h>
+#include <c_profiler.h>
+#include <c_trace.h>
+#include <c_memory_telemetry.h>
+#include <c_alloc_tracker.h>
+#include <c_alloc_trace.h>
+#include <c_lock_profiler.h>
+#include <c_stats_export.h>
+#include <c_flight_recorder.h>
+#include <c_sampler.h>
 #include <c_log.h>
 #include <c_globals.h>
 #include <c_zone_allocator.h>
+
+#define PROGRAM_FLAG_HANDLER_IMPLEMENTATION
 #include <c_program_flag_handler.h>
 #include <p_platform_data.h>
 
 #include <r_vulkan_types.h>
 #include <r_vulkan_core.h>
 #include <r_render_group.h>
+#include <r_render_thread.h>
 
 #include <s_nt_networking.h>
 #include <s_input_manager.h>
 #include <s_asset_manager.h>
 #include <g_game_state.h>
 #include <g_entity.h>
+#include <g_replay.h>
 
 #include <asset_file_packer/jfd_asset_file.h>
 #include <meta/GENERATED_program_types.h>
 
+// NOTE(Sleepster): Resizes only get recorded here, the render thread picks them up from the next frame packet.
 internal_api void
-c_process_window_events(SDL_Window *window, vulkan_render_context_t *render_context, input_manager_t *input_manager)
+c_process_window_events(SDL_Window *window, input_manager_t *input_manager, vec2_t *framebuffer_size, u32 *framebuffer_size_generation)
 {
     SDL_Event event;
     while(SDL_PollEvent(&event))
@@ -56,15 +71,227 @@ c_process_window_events(SDL_Window *window, vulkan_render_context_t *render_cont
                 g_window_size.x = (float32)window_x;
                 g_window_size.y = (float32)window_y;
 
-                r_vulkan_on_resize(render_context, g_window_size);
+                *framebuffer_size = g_window_size;
+                *framebuffer_size_generation += 1;
             }break;
         }
     }
 }
 
+/*===========================================
+  ============== FRAME TASK GRAPH ===========
+  ===========================================*/
+
+/* NOTE(Sleepster): Everything a frame's graph nodes share. The graph only knows the resource ids below, what each
+ * node actually touches is whatever it reaches through here, so keep the reads/writes in main() honest when a node
+ * starts touching something new. The render group build doesn't read the game state yet (the pushes are hardcoded),
+ * that's the only reason it overlaps the simulation.
+ */
+struct frame_data_t
+{
+    game_state_t            *state;
+    vulkan_render_context_t *render_context;
+    render_state_t          *render_state;
+    input_manager_t         *input_manager;
+    input_controller_t      *game_controller;
+    render_thread_t         *render_thread;
+
+    float32                  delta_time;
+    float64                  dt_accumulator;
+    vec2_t                   framebuffer_size;
+    u32                      framebuffer_size_generation;
+    bool8                    dump_task_graph;
+    bool8                    toggle_trace;
+    bool8                    dump_memory_telemetry;
+};
+
+void
+frame_poll_input(void *user_data)
+{
+    frame_data_t *frame = (frame_data_t*)user_data;
+    game_state_t *state = frame->state;
+
+    s_im_reset_controller_states(frame->input_manager);
+    c_process_window_events(state->window, frame->input_manager, &frame->framebuffer_size, &frame->framebuffer_size_generation);
+
+    state->input_axis = {};
+    if(s_im_is_keyboard_key_down(frame->game_controller, SDL_SCANCODE_W))
+    {
+        state->input_axis.y = -1.0f;
+    }
+    if(s_im_is_keyboard_key_down(frame->game_controller, SDL_SCANCODE_A))
+    {
+        state->input_axis.x = -1.0f;
+    }
+    if(s_im_is_keyboard_key_down(frame->game_controller, SDL_SCANCODE_S))
+    {
+        state->input_axis.y =  1.0f;
+    }
+    if(s_im_is_keyboard_key_down(frame->game_controller, SDL_SCANCODE_D))
+    {
+        state->input_axis.x =  1.0f;
+    }
+
+    if(s_im_is_keyboard_key_pressed(frame->game_controller, SDL_SCANCODE_F3))
+    {
+        frame->dump_task_graph = true;
+    }
+    if(s_im_is_keyboard_key_pressed(frame->game_controller, SDL_SCANCODE_F4))
+    {
+        frame->toggle_trace = true;
+    }
+    if(s_im_is_keyboard_key_pressed(frame->game_controller, SDL_SCANCODE_F5))
+    {
+        frame->dump_memory_telemetry = true;
+    }
+}
+
+void
+frame_simulate(void *user_data)
+{
+    frame_data_t *frame = (frame_data_t*)user_data;
+    game_state_t *state = frame->state;
+
+    if(frame->delta_time >= (gcv_tick_rate * 2.0f))
+    {
+        frame->delta_time = gcv_tick_rate * 2.0f;
+    }
+
+    frame->dt_accumulator += frame->delta_time;
+    while(frame->dt_accumulator >= gcv_tick_rate)
+    {
+        u64 input_start_cycles  = rdtsc();
+        client_data_t *client   = state->clients + state->client_id;
+        input_data_t input_data = {.input_axis = state->input_axis};
+
+        client->input_data_buffer[client->input_data_head] = input_data;
+        client->input_data_head = (client->input_data_head + 1) % MAX_BUFFERED_INPUTS;
+        g_simulation_system_end(state, GSS_Input, input_start_cycles);
+
+        // TODO(Sleepster): If we have any input packets form the host, reconcile here... 
+        // If we are the host update the client's players...
+        u64 network_start_cycles = rdtsc();
+        s_nt_client_check_packets(state);
+        s_nt_client_send_packets(state);
+        g_simulation_system_end(state, GSS_Network, network_start_cycles);
+
+        g_simulate_tick(state);
+
+        frame->dt_accumulator -= gcv_tick_rate;
+    }
+}
+
+void
+frame_build_render_groups(void *user_data)
+{
+    frame_data_t   *frame        = (frame_data_t*)user_data;
+    render_state_t *render_state = frame->render_state;
+
+    r_render_group_begin(render_state);
+    r_push_texture(render_state, {0, 0}, {100, 100}, {0.0, 1.0, 0.0, 1.0}, 0, frame->render_context->default_texture);
+    r_push_rect(render_state, {0, 150}, {100, 100}, {1.0, 1.0, 1.0, 1.0}, 0);
+    r_push_texture(render_state, {-100, 100}, {100, 100}, {1.0, 1.0, 1.0, 1.0}, 0, frame->render_context->default_texture);
+    r_render_group_end(render_state);
+}
+
+// NOTE(Sleepster): Blocks here when the render thread falls too far behind, that's the back-pressure.
+void
+frame_submit_packet(void *user_data)
+{
+    frame_data_t          *frame  = (frame_data_t*)user_data;
+    render_frame_packet_t *packet = r_render_thread_acquire_packet(frame->render_thread);
+
+    r_frame_packet_capture(packet, frame->render_state);
+    packet->camera.view_matrix       = mat4_identity();
+    packet->camera.projection_matrix = mat4_RHGL_ortho(frame->framebuffer_size.x * -0.5,
+                                                       frame->framebuffer_size.x *  0.5,
+                                                       frame->framebuffer_size.y * -0.5,
+                                                       frame->framebuffer_size.y *  0.5,
+                                                       0.0,
+                                                       1.0);
+    packet->framebuffer_size            = frame->framebuffer_size;
+    packet->framebuffer_size_generation = frame->framebuffer_size_generation;
+
+    r_render_thread_submit_packet(frame->render_thread, packet);
+}
+
+/* NOTE(Sleepster): Only the single dash '-name=value' arguments are program flags, the networking arguments
+ * ('--host port', '--client ip port') are positional and read straight out of argv.
+ */
+internal_api void
+c_parse_program_flags(s32 argc, char **argv)
+{
+    char *flag_args[64] = {argv[0]};
+    s32   flag_count    = 1;
+    for(s32 arg_index = 1;
+        arg_index < argc && flag_count < (s32)ArrayCount(flag_args);
+        ++arg_index)
+    {
+        char *arg = argv[arg_index];
+        if(arg[0] == '-' && arg[1] != '-') flag_args[flag_count++] = arg;
+    }
+
+    if(flag_count > 1) c_program_flag_parse_args(flag_count, flag_args);
+}
+
 int
 main(int argc, char **argv)
 {
+    u64     *trace_frames   = c_program_flag_add_size("trace_frames", 0, "Captures a trace of the first 'n' frames (F4 starts and stops one by hand)\n");
+    char   **trace_path     = c_program_flag_add_string("trace_path", (char*)"trace", "Base path of the trace files, '<path>_<n>.json' and '<path>_<n>.perfetto-trace'\n");
+    char   **record_path    = c_program_flag_add_string("record", (char*)"", "Records every tick's inputs and the RNG seed to this file, written on exit\n");
+    char   **replay_path    = c_program_flag_add_string("replay", (char*)"", "Replays a '-record' file headless as fast as it'll go and reports the ticks per second, no window\n");
+    u64     *replay_count   = c_program_flag_add_size("replay_repeat", 1, "How many times '-replay' runs the file\n");
+    char   **generate_path  = c_program_flag_add_string("replay_generate", (char*)"", "Writes a synthetic recording of four players made from '-seed' to this file for '-replay' and exits\n");
+    u64     *generate_ticks = c_program_flag_add_size("replay_ticks", 3600, "How many ticks '-replay_generate' records\n");
+    char   **asset_path     = c_program_flag_add_string("asset_load", (char*)"", "Loads, decodes and atlas packs every asset in this package headless, no window, reports cold and warm load times and exits\n");
+    u64     *asset_count    = c_program_flag_add_size("asset_load_repeat", 1, "How many times '-asset_load' loads the package\n");
+    u64     *random_seed    = c_program_flag_add_size("seed", 0, "Seed of the simulation's RNG, 0 picks one from the clock\n");
+    float32 *hitch_ms       = c_program_flag_add_float32("hitch_ms", 50.0f, "Frames longer than this dump the flight recorder, 0 only dumps on SIGUSR1\n");
+    float32 *flight_seconds = c_program_flag_add_float32("flight_seconds", 10.0f, "Seconds of frames the flight recorder keeps\n");
+    char   **flight_path    = c_program_flag_add_string("flight_path", (char*)"flight", "Base path of the flight recorder dumps, '<path>_<n>.json'\n");
+    u64     *sample_hz      = c_program_flag_add_size("sample_hz", 0, "Runs the sampling profiler at this many samples per CPU second on every thread, 0 is off\n");
+    char   **sample_path    = c_program_flag_add_string("sample_path", (char*)"samples.smpl", "Where the sampling profiler writes its capture, 'sampler_report <path>' reads it\n");
+    bool32  *track_allocs   = c_program_flag_add_bool32("track_allocations", false, "Tracks every arena, zone and dynarray allocation by call site, F5 and exit report the top allocators and leaks\n");
+    char   **alloc_trace    = c_program_flag_add_string("alloc_trace", (char*)"", "Records every arena, zone and dynarray allocation and free to this file, 'alloc_replay <path>' plays it back against the allocators\n");
+    char   **stats_name     = c_program_flag_add_string("stats_export", (char*)"", "Publishes live frame, tick, queue, memory and network stats to this shared memory name every frame, 'stats_monitor' reads them\n");
+    float32 *lock_seconds   = c_program_flag_add_float32("lock_report_seconds", 0.0f, "Logs the lock profiler's contention report every this many seconds and on exit, 0 is off\n");
+    c_parse_program_flags(argc, argv);
+
+    // NOTE(Sleepster): Before anything else starts threads, the workers and the render thread register themselves.
+    c_sampler_register_thread("main");
+    if(*sample_hz) c_sampler_start(*sample_path, (u32)*sample_hz);
+
+    // NOTE(Sleepster): Before '-asset_load' too, a load's allocations are one of the things worth replaying.
+    if(**alloc_trace) c_alloc_trace_start(STR(*alloc_trace));
+
+    if(**generate_path)
+    {
+        s32 result = g_replay_write_synthetic(STR(*generate_path), (u32)*generate_ticks, *random_seed);
+        c_alloc_trace_stop();
+        c_sampler_stop();
+        return(result);
+    }
+
+    if(**replay_path)
+    {
+        s32 result = g_replay_run_headless(STR(*replay_path), (u32)*replay_count);
+        c_alloc_trace_stop();
+        c_sampler_stop();
+        return(result);
+    }
+
+    if(**asset_path)
+    {
+        // NOTE(Sleepster): The atlas pack splits its copies across the threadpool.
+        c_global_context_init();
+        c_threadpool_init(&global_context->main_threadpool, 0);
+        s32 result = s_asset_manager_load_package_headless(STR(*asset_path), (u32)*asset_count);
+        c_alloc_trace_stop();
+        c_sampler_stop();
+        return(result);
+    }
+
     game_state_t            *state          = Alloc(game_state_t);
     vulkan_render_context_t *render_context = Alloc(vulkan_render_context_t);
     asset_manager_t         *asset_manager  = Alloc(asset_manager_t);
@@ -81,8 +308,19 @@ main(int argc, char **argv)
         {
             log_fatal("Could not create SDL window... Error: '%s'...\n", SDL_GetError());
         }
+        // NOTE(Sleepster): Before the context, its arenas are some of the first sites we want.
+        if(*track_allocs) c_alloc_tracker_start();
         c_global_context_init();
-        c_threadpool_init(&global_context->main_threadpool);
+        PROFILE_SET_THREAD_NAME("main");
+        c_memory_telemetry_register_arena("context",   &global_context->context_arena);
+        c_memory_telemetry_register_arena("temporary", &global_context->temporary_arena);
+
+        // NOTE(Sleepster): One worker per physical core, minus a core each for the main loop and the render thread.
+        threadpool_config_t threadpool_config = {};
+        threadpool_config.pin_policy          = TPPP_PhysicalCores;
+        threadpool_config.reserved_core_count = 2;
+        threadpool_config.pin_calling_thread  = true;
+        c_threadpool_init_with_config(&global_context->main_threadpool, &threadpool_config);
 
         s_asset_manager_init(asset_manager);
         s_asset_manager_load_asset_file(asset_manager, STR("asset_data.jfd"));
@@ -101,119 +339,134 @@ main(int argc, char **argv)
         r_render_state_init(render_state, render_context);
 
         s_nt_socket_api_init(state, argc, argv);
+        g_game_state_seed_random(state, *random_seed ? *random_seed : SDL_GetPerformanceCounter());
+
+        replay_recorder_t *replay_recorder = null;
+        if(**record_path)
+        {
+            replay_recorder = Alloc(replay_recorder_t);
+            g_replay_recorder_begin(replay_recorder, state, STR(*record_path));
+        }
 
         texture_atlas_t *atlas = s_texture_atlas_create(asset_manager, 1024, 4, BMF_RGBA32, 32);
         s_texture_atlas_add_texture(atlas, render_context->default_texture);
         s_texture_atlas_pack_added_textures(render_context, atlas);
+        s_asset_load_timings_log(&asset_manager->load_timings, "startup", 1);
 
         input_manager_t input_manager = {};
         s_im_init_input_manager(&input_manager);
         input_controller_t *game_controller = s_im_get_primary_controller(&input_manager);
 
+        // NOTE(Sleepster): From here on the render context belongs to the render thread, don't touch it on this one.
+        render_thread_t render_thread = {};
+        render_thread_config_t render_thread_config = {};
+        render_thread_config.max_frames_ahead    = 1;
+        render_thread_config.pool                = &global_context->main_threadpool;
+        render_thread_config.reserved_core_index = 1;
+        r_render_thread_start(&render_thread, render_context, &render_thread_config);
+
+        frame_data_t frame    = {};
+        frame.state           = state;
+        frame.render_context  = render_context;
+        frame.render_state    = render_state;
+        frame.input_manager   = &input_manager;
+        frame.game_controller = game_controller;
+        frame.render_thread   = &render_thread;
+        frame.framebuffer_size.x = (float32)render_context->framebuffer_width;
+        frame.framebuffer_size.y = (float32)render_context->framebuffer_height;
+
+        // NOTE(Sleepster): SDL events and the packet hand off stay on this thread, the rest can go wherever.
+        task_graph_t frame_graph;
+        c_task_graph_init(&frame_graph, &global_context->main_threadpool);
+        u32 input_resource         = c_task_graph_add_resource(&frame_graph, "input");
+        u32 window_resource        = c_task_graph_add_resource(&frame_graph, "window");
+        u32 game_state_resource    = c_task_graph_add_resource(&frame_graph, "game_state");
+        u32 network_resource       = c_task_graph_add_resource(&frame_graph, "network");
+        u32 render_groups_resource = c_task_graph_add_resource(&frame_graph, "render_groups");
+
+        u32 poll_input_node = c_task_graph_add_node(&frame_graph, "poll_input", frame_poll_input, &frame, TGNF_MainThread);
+        c_task_graph_node_writes(&frame_graph, poll_input_node, input_resource);
+        c_task_graph_node_writes(&frame_graph, poll_input_node, window_resource);
+
+        u32 simulate_node = c_task_graph_add_node(&frame_graph, "simulate", frame_simulate, &frame);
+        c_task_graph_node_reads(&frame_graph,  simulate_node, input_resource);
+        c_task_graph_node_writes(&frame_graph, simulate_node, game_state_resource);
+        c_task_graph_node_writes(&frame_graph, simulate_node, network_resource);
+
+        u32 build_render_groups_node = c_task_graph_add_node(&frame_graph, "build_render_groups", frame_build_render_groups, &frame);
+        c_task_graph_node_writes(&frame_graph, build_render_groups_node, render_groups_resource);
+
+        u32 submit_packet_node = c_task_graph_add_node(&frame_graph, "submit_packet", frame_submit_packet, &frame, TGNF_MainThread);
+        c_task_graph_node_reads(&frame_graph,  submit_packet_node, window_resource);
+        c_task_graph_node_writes(&frame_graph, submit_packet_node, render_groups_resource);
+
+        c_task_graph_build(&frame_graph);
+
         u64 perf_count_freq = SDL_GetPerformanceFrequency();
         u64 last_tsc        = SDL_GetPerformanceCounter();
         u64 current_tsc     = 0;
         u64 delta_tsc       = 0;
 
-        float32 delta_time    = 0;
-        //float32 delta_time_ms = 0;
-        float64 dt_accumulator = 0.0f;
+        trace_capture_t trace = {};
+        if(*trace_frames)
+        {
+            c_trace_start(&trace, *trace_path, (u32)*trace_frames);
+        }
+
+        flight_recorder_t flight_recorder = {};
+        flight_recorder_config_t flight_config = {};
+        flight_config.seconds   = *flight_seconds;
+        flight_config.hitch_ms  = *hitch_ms;
+        flight_config.base_path = *flight_path;
+        c_flight_recorder_init(&flight_recorder, &flight_config);
+        float32 lock_report_elapsed = 0.0f;
+
+        stats_exporter_t stats_exporter = {};
+        if(**stats_name) c_stats_export_open(&stats_exporter, *stats_name);
 
         g_running = true;
         while(g_running)
         {
-            s_im_reset_controller_states(&input_manager);
-            c_process_window_events(state->window, render_context, &input_manager);
-
-            state->input_axis = {};
-            if(s_im_is_keyboard_key_down(game_controller, SDL_SCANCODE_W))
-            {
-                state->input_axis.y = -1.0f;
-            }
-            if(s_im_is_keyboard_key_down(game_controller, SDL_SCANCODE_A))
             {
-                state->input_axis.x = -1.0f;
+                PROFILE_SCOPE("frame");
+                c_task_graph_execute(&frame_graph);
             }
-            if(s_im_is_keyboard_key_down(game_controller, SDL_SCANCODE_S))
-            {
-                state->input_axis.y =  1.0f;
-            }
-            if(s_im_is_keyboard_key_down(game_controller, SDL_SCANCODE_D))
-            {
-                state->input_axis.x =  1.0f;
-            }
-
-            if(delta_time >= (gcv_tick_rate * 2.0f))
-            {
-                delta_time = gcv_tick_rate * 2.0f;
-            }
-
-            dt_accumulator += delta_time;
-            while(dt_accumulator >= gcv_tick_rate)
+            TRACE_COUNTER("frame_ms",       frame.delta_time * 1000.0f);
+            TRACE_COUNTER("render_wait_ms", render_thread.last_game_wait_ms);
+            PROFILE_FRAME_END();
+            c_trace_frame_end(&trace);
+            c_memory_telemetry_frame_end();
+            c_alloc_tracker_frame_end();
+            c_alloc_trace_frame_end();
+
+            if(frame.dump_memory_telemetry)
             {
-                client_data_t *client   = state->clients + state->client_id;
-                input_data_t input_data = {.input_axis = state->input_axis};
-
-                client->input_data_buffer[client->input_data_head] = input_data;
-                client->input_data_head = (client->input_data_head + 1) % MAX_BUFFERED_INPUTS;
-
-                // TODO(Sleepster): If we have any input packets form the host, reconcile here... 
-                // If we are the host update the client's players...
-                s_nt_client_check_packets(state);
-                s_nt_client_send_packets(state);
-
-                for(u32 entity_index = 0;
-                    entity_index < state->entity_manager.active_entities;
-                    ++entity_index)
+                frame.dump_memory_telemetry = false;
+                c_memory_telemetry_log();
+                c_memory_telemetry_dump_csv(STR("memory_telemetry.csv"));
+                c_memory_telemetry_dump_json(STR("memory_telemetry.json"));
+                if(c_alloc_tracker_is_running())
                 {
-                    entity_t *entity = state->entity_manager.entities + entity_index;
-                    switch(entity->e_type)
-                    {
-                        case ET_Player:
-                        {
-                            client_data_t *entity_client = state->clients + entity->owner_client_id;
-                            while(entity_client->input_data_tail != entity_client->input_data_head)
-                            {
-                                input_data_t *input_data = entity_client->input_data_buffer + entity_client->input_data_tail;
-                                entity_client->input_data_tail = (entity_client->input_data_tail + 1) % MAX_BUFFERED_INPUTS;
-                                entity_simulate_player(entity, input_data, gcv_tick_rate);
-                            }
-                        }break;
-                    }
+                    c_alloc_tracker_log(16);
+                    c_alloc_tracker_dump_csv(STR("alloc_sites.csv"));
                 }
-
-                dt_accumulator -= gcv_tick_rate;
             }
-
-            if(r_vulkan_begin_frame(render_context, render_state, gcv_tick_rate))
+            if(frame.toggle_trace)
             {
+                frame.toggle_trace = false;
+                if(trace.is_capturing) c_trace_stop(&trace);
+                else                   c_trace_start(&trace, *trace_path, 0);
+            }
 
-                vulkan_shader_data_t *shader = &render_context->default_shader->slot->shader.shader_data;
-                mat4_t view_matrix = mat4_identity();
-                mat4_t projection_matrix = mat4_RHGL_ortho(render_context->framebuffer_width  * -0.5,
-                                                           render_context->framebuffer_width  *  0.5,
-                                                           render_context->framebuffer_height * -0.5,
-                                                           render_context->framebuffer_height *  0.5,
-                                                           0.0,
-                                                           1.0);
-                shader->camera_matrices = {
-                    .view_matrix       = view_matrix,
-                    .projection_matrix = projection_matrix
-                };
-
-                r_vulkan_shader_set_uniform_data(render_context->default_shader, STR("Matrices"), &shader->camera_matrices, sizeof(shader->camera_matrices));
-
-                r_render_group_begin(render_state);
-                r_push_texture(render_state, {0, 0}, {100, 100}, {0.0, 1.0, 0.0, 1.0}, 0, render_context->default_texture);
-                r_push_rect(render_state, {0, 150}, {100, 100}, {1.0, 1.0, 1.0, 1.0}, 0);
-                r_push_texture(render_state, {-100, 100}, {100, 100}, {1.0, 1.0, 1.0, 1.0}, 0, render_context->default_texture);
-                r_render_group_end(render_state);
-                    
-                r_render_group_update_used_groups(render_state);
-                r_vulkan_end_frame(render_context, render_state, gcv_tick_rate);
+            if(frame.dump_task_graph)
+            {
+                frame.dump_task_graph = false;
+                c_task_graph_dump_dot(&frame_graph, STR("task_graph.dot"));
+                c_task_graph_log_timings(&frame_graph);
+                PROFILE_LOG_FRAME();
             }
 #if 0
-            float32 alpha = (dt_accumulator / gcv_tick_rate);
+            float32 alpha = (frame.dt_accumulator / gcv_tick_rate);
 #endif
             c_global_context_reset_temporary_data();
 
@@ -221,11 +474,56 @@ main(int argc, char **argv)
             delta_tsc   = current_tsc - last_tsc;
             last_tsc    = current_tsc;
 
-            delta_time    = (float32)(((float64)delta_tsc) / (float64)perf_count_freq);
+            frame.delta_time = (float32)(((float64)delta_tsc) / (float64)perf_count_freq);
+
+            // NOTE(Sleepster): The queue depth is what's still backed up once the frame's graph is done.
+            flight_recorder_frame_stats_t flight_stats = {};
+            flight_stats.frame_ms              = frame.delta_time * 1000.0f;
+            flight_stats.render_wait_ms        = (float32)render_thread.last_game_wait_ms;
+            flight_stats.threadpool_queued     = c_threadpool_get_queued_task_count(&global_context->main_threadpool);
+            flight_stats.asset_loads_in_flight = AtomicLoad32(&asset_manager->loads_in_flight);
+            c_flight_recorder_frame_end(&flight_recorder, &flight_stats);
+
+            stats_export_frame_t export_stats = {};
+            export_stats.frame_ms                  = flight_stats.frame_ms;
+            export_stats.render_wait_ms            = flight_stats.render_wait_ms;
+            export_stats.tick_index                = state->tick_index;
+            export_stats.threadpool_queued         = flight_stats.threadpool_queued;
+            export_stats.asset_loads_in_flight     = flight_stats.asset_loads_in_flight;
+            export_stats.network.packets_sent      = state->network_stats.packets_sent;
+            export_stats.network.bytes_sent        = state->network_stats.bytes_sent;
+            export_stats.network.packets_received  = state->network_stats.packets_received;
+            export_stats.network.bytes_received    = state->network_stats.bytes_received;
+            export_stats.network.send_errors       = state->network_stats.send_errors;
+            export_stats.network.invalid_packets   = state->network_stats.invalid_packets;
+            export_stats.network.connected_clients = state->connected_client_count;
+            export_stats.network.is_host           = state->is_host;
+            c_stats_export_frame_end(&stats_exporter, &export_stats);
+
+            if(*lock_seconds > 0.0f)
+            {
+                lock_report_elapsed += frame.delta_time;
+                if(lock_report_elapsed >= *lock_seconds)
+                {
+                    lock_report_elapsed = 0.0f;
+                    c_lock_profiler_log();
+                }
+            }
 
-            //float32 delta_time_ms = delta_time * 1000.0f;
+            //float32 delta_time_ms = frame.delta_time * 1000.0f;
             //printf("delta time: '%.02f'...\n", delta_time_ms);
         }
+        c_trace_stop(&trace);
+        c_sampler_stop();
+        c_alloc_trace_stop();
+        c_flight_recorder_destroy(&flight_recorder);
+        c_stats_export_close(&stats_exporter);
+        if(replay_recorder) g_replay_recorder_finish(replay_recorder, state);
+        c_memory_telemetry_log();
+        if(c_alloc_tracker_is_running()) c_alloc_tracker_log(16);
+        if(*lock_seconds > 0.0f)         c_lock_profiler_log();
+        c_task_graph_destroy(&frame_graph);
+        r_render_thread_stop(&render_thread);
     }
     else
     {
@@ -34,6 +34,12 @@ void* sys_allocate_memory(usize allocation_size);
 void  sys_free_memory(void *data, usize free_size);
 void* sys_reallocate_memory(void *offset, u64 allocation_size);
 
+// NOTE(Sleepster): The most the process has had resident at once since it started, everything malloc() has included.
+u64   sys_get_peak_resident_bytes(void);
+
+// NOTE(Sleepster): What the C runtime's heap is holding from the OS right now, free chunks it hasn't given back included.
+u64   sys_get_heap_bytes(void);
+
 /*===========================================
   ============== FILE IO STUFF ==============
   ===========================================*/
@@ -48,6 +54,10 @@ mapped_file_t sys_file_map(string_t filepath);
 bool8         sys_file_unmap(mapped_file_t *map_data);
 
 bool8         sys_file_exists(string_t filepath);
+
+// NOTE(Sleepster): Asks the OS to forget the file's cached pages so the next read comes off the disk, false where
+//                  there's no way to ask (Windows).
+bool8         sys_file_drop_from_cache(string_t filepath);
 file_data_t   sys_file_get_modtime_and_size(string_t filepath);
 bool8         sys_file_replace_or_rename(string_t old_file, string_t new_file);
 
@@ -70,7 +80,33 @@ void  sys_file_watcher_process_changes(file_watcher_t *watcher, bool8 *changed);
 /*===========================================
   ============== MULTITHREADING =============
   ===========================================*/
+#define SYS_MAX_LOGICAL_CPUS (256)
+
+// NOTE(Sleepster): All of the *_index fields are dense (0..count-1), cpu_index is the OS's id for the CPU.
+typedef struct sys_logical_cpu
+{
+    u32 cpu_index;
+    u32 core_index;
+    u32 smt_index;
+    u32 package_index;
+    u32 llc_index;
+    u32 numa_node;
+}sys_logical_cpu_t;
+
+typedef struct sys_cpu_topology
+{
+    u32               logical_cpu_count;
+    u32               physical_core_count;
+    u32               package_count;
+    u32               llc_count;
+    u32               numa_node_count;
+
+    sys_logical_cpu_t cpus[SYS_MAX_LOGICAL_CPUS];
+}sys_cpu_topology_t;
+
 s32             sys_get_cpu_count();
+bool8           sys_get_cpu_topology(sys_cpu_topology_t *topology);
+bool8           sys_thread_pin_current(u32 cpu_index);
 sys_semaphore_t sys_semaphore_create(s32 initial_thread_count, s32 max_thread_count);
 void            sys_semaphore_close(sys_semaphore_t *semaphore);
 void            sys_semaphore_wait(sys_semaphore_t *semaphore, u64 wait_duration_ms);
@@ -79,10 +115,92 @@ bool8           sys_semaphore_destroy(sys_semaphore_t *semaphore);
 sys_thread_t    sys_thread_create(thread_proc_t *proc, void *user_data, bool8 close_handle);
 void            sys_thread_wait(sys_semaphore_t *semaphore, u64 wait_duration_ms);
 bool8           sys_thread_close_handle(sys_thread_t *thread_data);
+bool8           sys_thread_join(sys_thread_t *thread_data);
+void            sys_thread_yield();
+void            sys_sleep_ms(u32 milliseconds);
 sys_mutex_t     sys_mutex_create();
 void            sys_mutex_free(sys_mutex_t *mutex);
 bool8           sys_mutex_lock(sys_mutex_t *mutex, bool8 should_block);
 bool8           sys_mutex_unlock(sys_mutex_t *mutex);
+bool8           sys_fiber_create(sys_fiber_t *fiber, usize stack_size, sys_fiber_proc_t *proc, void *user_data);
+void            sys_fiber_destroy(sys_fiber_t *fiber);
+bool8           sys_fiber_convert_thread(sys_fiber_t *fiber);
+void            sys_fiber_convert_to_thread(sys_fiber_t *fiber);
+void            sys_fiber_switch(sys_fiber_t *from, sys_fiber_t *to);
+bool8           sys_register_dump_request_flag(volatile u32 *flag);
+
+/*===========================================
+  ============== SHARED MEMORY ==============
+  ===========================================*/
+#define SYS_SHARED_MEMORY_NAME_LENGTH (64)
+
+// NOTE(Sleepster): A named region other processes can map, '/dev/shm/<name>' on Linux and 'Local\<name>' on Windows.
+typedef struct sys_shared_memory
+{
+    void        *data;
+    usize        size;
+    sys_handle_t handle;       // NOTE(Sleepster): Windows only, Linux closes the fd once it's mapped.
+    bool8        is_owner;
+    char         name[SYS_SHARED_MEMORY_NAME_LENGTH];
+}sys_shared_memory_t;
+
+// NOTE(Sleepster): Creates the region (or takes over a stale one) at 'size' bytes, zeroed and read/write. The owner
+//                  removes the name again on close.
+bool8           sys_shared_memory_create(sys_shared_memory_t *shared, const char *name, usize size);
+
+// NOTE(Sleepster): Maps one that somebody else created, read only, at whatever size they made it.
+bool8           sys_shared_memory_open(sys_shared_memory_t *shared, const char *name);
+void            sys_shared_memory_close(sys_shared_memory_t *shared);
+
+/*===========================================
+  ================ SAMPLING =================
+  ===========================================*/
+#define SYS_SAMPLER_MAX_FRAMES      (64)
+#define SYS_MODULE_MAX_PATH_LENGTH  (256)
+
+// NOTE(Sleepster): Runs in the signal handler of the thread that got sampled, frames[0] is the interrupted
+//                  instruction, the rest are return addresses walking out.
+typedef void sys_sample_proc_t(u64 *frames, u32 frame_count);
+
+// NOTE(Sleepster): Something mapped into the process, 'load_bias' is what gets added to the file's addresses.
+typedef struct sys_module
+{
+    u64  load_bias;
+    u64  start;
+    u64  end;
+    char path[SYS_MODULE_MAX_PATH_LENGTH];
+}sys_module_t;
+
+bool8           sys_sampler_install(sys_sample_proc_t *proc);
+bool8           sys_sampler_register_thread(sys_sampler_thread_t *thread);
+bool8           sys_sampler_thread_start(sys_sampler_thread_t *thread, u32 frequency_hz);
+void            sys_sampler_thread_stop(sys_sampler_thread_t *thread);
+u32             sys_get_loaded_modules(sys_module_t *modules, u32 max_module_count);
+
+/*===========================================
+  ============== PERF COUNTERS ==============
+  ===========================================*/
+enum sys_perf_counter_kind_t
+{
+    SPCK_Cycles,
+    SPCK_Instructions,
+    SPCK_CacheMisses,      // NOTE(Sleepster): Last level cache
+    SPCK_BranchMisses,
+    SPCK_TLBMisses,        // NOTE(Sleepster): Data TLB, loads
+    SPCK_Count,
+};
+
+StaticAssert(SPCK_Count <= SYS_PERF_MAX_COUNTERS, "More perf counter kinds than the platform has room for...\n");
+
+// NOTE(Sleepster): Hardware counters of the calling thread, user space only. 'open_mask' gets a bit for every
+//                  counter the machine gave us, false if it gave us none (containers and VMs usually don't). errno
+//                  has the reason for the first one that didn't open.
+bool8           sys_perf_counters_open(sys_perf_counters_t *counters);
+void            sys_perf_counters_close(sys_perf_counters_t *counters);
+
+// NOTE(Sleepster): values_out[SPCK_Count], only the counters in 'open_mask' are written. Scaled up when the kernel
+//                  had to multiplex them with somebody else's.
+bool8           sys_perf_counters_read(sys_perf_counters_t *counters, u64 *values_out);
 
 typedef struct sockaddr_in sockaddr_in_t;
 
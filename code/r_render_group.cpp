@@ -6,9 +6,11 @@
    ======================================================================== */
 #include <c_types.h>
 #include <c_memory_arena.h>
+#include <c_memory_telemetry.h>
 #include <c_hash_table.h>
 #include <c_string.h>
 #include <c_math.h>
+#include <c_profiler.h>
 #include <s_asset_manager.h>
 
 #include <r_vulkan_types.h>
@@ -105,6 +107,7 @@ r_render_state_init(render_state_t *render_state, vulkan_render_context_t *rende
     render_state->current_frame_data = render_context->current_frame;
 
     render_state->renderer_arena = c_arena_create(MB(200));
+    c_memory_telemetry_register_arena("renderer", &render_state->renderer_arena);
     c_hash_table_init(&render_state->render_group_hash, 
                        MAX_HASHED_RENDER_GROUPS,
                       &render_state->renderer_arena,
@@ -201,6 +204,7 @@ r_render_group_get_current_buffer(render_state_t *render_state)
 render_group_t*
 r_render_group_begin(render_state_t *render_state)
 {
+    PROFILE_FUNCTION();
     render_group_t *result = null;
 
     u64 render_group_ID = c_fnv_hash_value((byte*)&render_state->draw_frame.state, sizeof(render_state->draw_frame.state));
@@ -232,9 +236,13 @@ r_render_group_begin(render_state_t *render_state)
         u32 next_group_index = render_state->draw_frame.used_render_group_count++;
         render_state->draw_frame.used_render_groups[next_group_index] = result;
 
-        result->first_buffer       = *r_render_group_create_new_geoemetry_buffer(render_state);
-        result->master_batch_array =  c_arena_push_array(&render_state->renderer_arena, render_geometry_instance_t, MAX_VULKAN_INSTANCES);
-        result->cached_buffer      = &result->first_buffer;
+        // NOTE(Sleepster): A group keeps its arrays from the last frame it was used in, they were only ever emptied.
+        if(!result->master_batch_array)
+        {
+            result->first_buffer       = *r_render_group_create_new_geoemetry_buffer(render_state);
+            result->master_batch_array =  c_arena_push_array(&render_state->renderer_arena, render_geometry_instance_t, MAX_VULKAN_INSTANCES);
+        }
+        result->cached_buffer = &result->first_buffer;
     }
 
     draw_frame->state.active_render_group = result;
@@ -251,6 +259,8 @@ r_render_group_end(render_state_t *render_state)
 void
 r_render_group_fill_master_buffer(render_state_t *render_state, render_group_t *render_group)
 {
+    // NOTE(Sleepster): Nothing but memcpy, the counters say whether that's bandwidth or the batch list walk.
+    PROFILE_SCOPE_COUNTERS("r_render_group_fill_master_buffer");
     for(render_geometry_batch_t *current_buffer = &render_group->first_buffer;
         current_buffer;
         current_buffer = current_buffer->next_buffer)
@@ -265,6 +275,7 @@ r_render_group_fill_master_buffer(render_state_t *render_state, render_group_t *
 void
 r_render_group_update_used_groups(render_state_t *render_state)
 {
+    PROFILE_FUNCTION();
     draw_frame_t *draw_frame = &render_state->draw_frame;
 
     for(u32 group_index = 0;
@@ -328,6 +339,7 @@ r_push_texture_ex(render_state_t    *render_state,
                   float32            rotation, 
                   subtexture_data_t *subtexture_data)
 {
+    PROFILE_FUNCTION();
     render_geometry_batch_t *buffer = r_render_group_get_current_buffer(render_state);
     Assert(buffer->primitive_count + 1 < MAX_VULKAN_INSTANCES);
 
@@ -0,0 +1,245 @@
+/* ========================================================================
+   $File: r_render_thread.cpp $
+   $Date: October 18 2026 11:30 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <string.h>
+#include <SDL3/SDL.h>
+
+#include <c_types.h>
+#include <c_base.h>
+#include <c_math.h>
+#include <c_log.h>
+#include <c_futex.h>
+#include <c_profiler.h>
+#include <c_sampler.h>
+#include <c_threadpool.h>
+#include <p_platform_data.h>
+
+#include <r_vulkan_types.h>
+#include <r_render_group.h>
+#include <r_vulkan_core.h>
+#include <r_render_thread.h>
+
+internal_api inline float64
+r_render_thread_ms_since(render_thread_t *render_thread, u64 start_counter)
+{
+    float64 result = ((float64)(SDL_GetPerformanceCounter() - start_counter) * 1000.0) / (float64)render_thread->counter_frequency;
+    return(result);
+}
+
+PLATFORM_THREAD_PROC(r_render_thread_proc)
+{
+    render_thread_t         *render_thread  = (render_thread_t*)user_data;
+    vulkan_render_context_t *render_context = render_thread->render_context;
+    PROFILE_SET_THREAD_NAME("render");
+    c_sampler_register_thread("render");
+
+    if(render_thread->pool && !c_threadpool_pin_to_reserved_core(render_thread->pool, render_thread->reserved_core_index))
+    {
+        log_warning("Render thread could not be pinned to reserved core '%u', running unpinned...\n", render_thread->reserved_core_index);
+    }
+
+    u32 framebuffer_size_generation = 0;
+    u64 last_frame_counter          = SDL_GetPerformanceCounter();
+    for(;;)
+    {
+        c_futex_semaphore_wait(&render_thread->ready_packets);
+        if(!AtomicLoad32(&render_thread->is_running)) break;
+
+        PROFILE_SCOPE("render_frame");
+        render_frame_packet_t *packet = render_thread->packets + render_thread->read_index;
+        render_thread->read_index = (render_thread->read_index + 1) % render_thread->packet_count;
+        if(packet->trace_flow_id)
+        {
+            TRACE_FLOW_END("frame_packet", packet->trace_flow_id);
+        }
+
+        u64     start_counter = SDL_GetPerformanceCounter();
+        float32 delta_time    = (float32)((float64)(start_counter - last_frame_counter) / (float64)render_thread->counter_frequency);
+        last_frame_counter    = start_counter;
+
+        if(packet->framebuffer_size_generation != framebuffer_size_generation)
+        {
+            framebuffer_size_generation = packet->framebuffer_size_generation;
+            r_vulkan_on_resize(render_context, packet->framebuffer_size);
+        }
+
+        if(r_vulkan_begin_frame(render_context, delta_time))
+        {
+            vulkan_shader_data_t *shader = &render_context->default_shader->slot->shader.shader_data;
+            shader->camera_matrices = {
+                .view_matrix       = packet->camera.view_matrix,
+                .projection_matrix = packet->camera.projection_matrix
+            };
+            r_vulkan_shader_set_uniform_data(render_context->default_shader, STR("Matrices"), &shader->camera_matrices, sizeof(shader->camera_matrices));
+
+            r_vulkan_end_frame(render_context, packet, delta_time);
+            AtomicIncrement64(&render_thread->packets_rendered);
+        }
+        else
+        {
+            AtomicIncrement64(&render_thread->packets_dropped);
+        }
+        render_thread->last_render_ms = r_render_thread_ms_since(render_thread, start_counter);
+
+        c_futex_semaphore_release(&render_thread->free_packets);
+    }
+
+    return(0);
+}
+
+void
+r_render_thread_start(render_thread_t *render_thread, vulkan_render_context_t *render_context, render_thread_config_t *config)
+{
+    Assert(!render_thread->is_initialized);
+    ZeroStruct(*render_thread);
+
+    u32 max_frames_ahead = config->max_frames_ahead;
+    if(max_frames_ahead == 0)                             max_frames_ahead = 1;
+    if(max_frames_ahead > RENDER_THREAD_MAX_FRAMES_AHEAD) max_frames_ahead = RENDER_THREAD_MAX_FRAMES_AHEAD;
+
+    render_thread->render_context      = render_context;
+    render_thread->pool                = config->pool;
+    render_thread->reserved_core_index = config->reserved_core_index;
+    render_thread->counter_frequency   = SDL_GetPerformanceFrequency();
+    render_thread->packet_count        = max_frames_ahead + 1;
+    render_thread->packets             = (render_frame_packet_t*)sys_allocate_memory(sizeof(render_frame_packet_t) * render_thread->packet_count);
+    Assert(render_thread->packets);
+
+    for(u32 packet_index = 0;
+        packet_index < render_thread->packet_count;
+        ++packet_index)
+    {
+        render_frame_packet_t *packet = render_thread->packets + packet_index;
+        packet->instance_capacity = MAX_VULKAN_INSTANCES;
+        packet->instances         = (render_geometry_instance_t*)sys_allocate_memory(sizeof(render_geometry_instance_t) * packet->instance_capacity);
+        Assert(packet->instances);
+    }
+
+    render_thread->free_packets.count  = render_thread->packet_count;
+    render_thread->ready_packets.count = 0;
+    render_thread->is_running          = true;
+    render_thread->is_initialized      = true;
+    render_thread->thread              = sys_thread_create(r_render_thread_proc, render_thread, false);
+
+    log_info("Render thread started, '%u' frames ahead at most ('%u' packets)...\n", max_frames_ahead, render_thread->packet_count);
+}
+
+void
+r_render_thread_stop(render_thread_t *render_thread)
+{
+    if(render_thread->is_initialized)
+    {
+        // NOTE(Sleepster): Let it finish whatever was already submitted, every packet is free once this is done.
+        for(u32 packet_index = 0;
+            packet_index < render_thread->packet_count;
+            ++packet_index)
+        {
+            c_futex_semaphore_wait(&render_thread->free_packets);
+        }
+
+        AtomicStore32(&render_thread->is_running, false);
+        c_futex_semaphore_release(&render_thread->ready_packets);
+        sys_thread_join(&render_thread->thread);
+
+        for(u32 packet_index = 0;
+            packet_index < render_thread->packet_count;
+            ++packet_index)
+        {
+            render_frame_packet_t *packet = render_thread->packets + packet_index;
+            sys_free_memory(packet->instances, sizeof(render_geometry_instance_t) * packet->instance_capacity);
+        }
+        sys_free_memory(render_thread->packets, sizeof(render_frame_packet_t) * render_thread->packet_count);
+
+        log_info("Render thread stopped, '%llu' packets submitted, '%llu' rendered, '%llu' dropped, '%.2f' ms spent waiting on it...\n",
+                 (unsigned long long)render_thread->packets_submitted, (unsigned long long)render_thread->packets_rendered,
+                 (unsigned long long)render_thread->packets_dropped, render_thread->total_game_wait_ms);
+        ZeroStruct(*render_thread);
+    }
+}
+
+render_frame_packet_t*
+r_render_thread_acquire_packet(render_thread_t *render_thread)
+{
+    PROFILE_FUNCTION();
+    Assert(render_thread->is_initialized);
+
+    u64 start_counter = SDL_GetPerformanceCounter();
+    c_futex_semaphore_wait(&render_thread->free_packets);
+    render_thread->last_game_wait_ms   = r_render_thread_ms_since(render_thread, start_counter);
+    render_thread->total_game_wait_ms += render_thread->last_game_wait_ms;
+
+    render_frame_packet_t *result = render_thread->packets + render_thread->write_index;
+    render_thread->write_index = (render_thread->write_index + 1) % render_thread->packet_count;
+
+    result->frame_index    = render_thread->packets_submitted;
+    result->group_count    = 0;
+    result->batch_count    = 0;
+    result->instance_count = 0;
+
+    return(result);
+}
+
+void
+r_render_thread_submit_packet(render_thread_t *render_thread, render_frame_packet_t *packet)
+{
+    Assert(packet == render_thread->packets + ((render_thread->write_index + render_thread->packet_count - 1) % render_thread->packet_count));
+
+    ++render_thread->packets_submitted;
+    packet->trace_flow_id = TRACE_FLOW_BEGIN_NEW("frame_packet");
+    c_futex_semaphore_release(&render_thread->ready_packets);
+}
+
+/* NOTE(Sleepster): This replaces r_render_group_update_used_groups() for the threaded path, the instances go
+ * straight from the group's batches into the packet instead of through the master array. The reset at the end used
+ * to happen on the renderer side after recording.
+ */
+void
+r_frame_packet_capture(render_frame_packet_t *packet, render_state_t *render_state)
+{
+    PROFILE_FUNCTION();
+    draw_frame_t *draw_frame = &render_state->draw_frame;
+    for(u32 group_index = 0;
+        group_index < draw_frame->used_render_group_count;
+        ++group_index)
+    {
+        render_group_t *render_group = draw_frame->used_render_groups[group_index];
+        Assert(render_group);
+        Assert(packet->group_count < MAX_RENDER_GROUPS);
+
+        render_packet_group_t *packet_group = packet->groups + packet->group_count++;
+        packet_group->shader         = render_group->shader;
+        packet_group->pipeline_state = render_group->dynamic_pipeline_state;
+        packet_group->texture_count  = render_group->current_texture_count;
+        packet_group->first_instance = packet->instance_count;
+        packet_group->instance_count = 0;
+        packet_group->first_batch    = packet->batch_count;
+        packet_group->batch_count    = 0;
+        memcpy(packet_group->textures, render_group->textures, sizeof(texture2D_t*) * render_group->current_texture_count);
+
+        for(render_geometry_batch_t *current_buffer = &render_group->first_buffer;
+            current_buffer;
+            current_buffer = current_buffer->next_buffer)
+        {
+            Assert(packet->batch_count < ArrayCount(packet->batches));
+            Assert(packet->instance_count + current_buffer->primitive_count <= packet->instance_capacity);
+
+            render_packet_batch_t *batch = packet->batches + packet->batch_count++;
+            batch->first_instance = packet_group->instance_count;
+            batch->instance_count = current_buffer->primitive_count;
+            memcpy(packet->instances + packet->instance_count, current_buffer->instances, sizeof(render_geometry_instance_t) * current_buffer->primitive_count);
+
+            packet->instance_count       += current_buffer->primitive_count;
+            packet_group->instance_count += current_buffer->primitive_count;
+            packet_group->batch_count    += 1;
+
+            current_buffer->master_array_start_offset = 0;
+            current_buffer->primitive_count           = 0;
+        }
+
+        render_group->total_primitive_count = 0;
+    }
+    draw_frame->used_render_group_count = 0;
+}
@@ -0,0 +1,122 @@
+#if !defined(R_RENDER_THREAD_H)
+/* ========================================================================
+   $File: r_render_thread.h $
+   $Date: October 18 2026 11:30 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define R_RENDER_THREAD_H
+#include <c_types.h>
+#include <c_base.h>
+#include <c_math.h>
+#include <c_futex.h>
+#include <c_threadpool.h>
+#include <p_platform_data.h>
+
+#include <r_vulkan_types.h>
+#include <r_render_group.h>
+
+/* NOTE(Sleepster): The render thread owns every Vulkan call made after init: begin frame, recording the render
+ * groups, the submit and the fence waits. The game thread never touches the render context again, it builds its
+ * render groups like before and then copies them into a frame packet, which is the only thing the two threads share.
+ *
+ * A packet is immutable once it's submitted. The game thread fills packet N+1 while the render thread is still
+ * recording packet N, then the game's render_state is reset and can be reused right away.
+ *
+ * Back-pressure: there are max_frames_ahead + 1 packets. When the game thread gets max_frames_ahead packets ahead
+ * of the render thread r_render_thread_acquire_packet() blocks until one is free. 1 is plain double buffering,
+ * more hides longer hitches on the render thread at the cost of that many frames of latency.
+ */
+
+#define RENDER_THREAD_MAX_FRAMES_AHEAD (3)
+#define RENDER_THREAD_MAX_PACKETS      (RENDER_THREAD_MAX_FRAMES_AHEAD + 1)
+
+struct render_packet_batch_t
+{
+    u32 first_instance;
+    u32 instance_count;
+};
+
+struct render_packet_group_t
+{
+    asset_handle_t          *shader;
+    render_pipeline_state_t  pipeline_state;
+
+    texture2D_t             *textures[MAX_RENDER_GROUP_BOUND_TEXTURES];
+    u32                      texture_count;
+
+    // NOTE(Sleepster): Ranges into the packet's instances and batches.
+    u32                      first_instance;
+    u32                      instance_count;
+    u32                      first_batch;
+    u32                      batch_count;
+};
+
+struct render_frame_packet_t
+{
+    u64                         frame_index;
+    u32                         trace_flow_id;
+    render_camera_t             camera;
+
+    // NOTE(Sleepster): The render thread resizes the swapchain when this generation changes.
+    vec2_t                      framebuffer_size;
+    u32                         framebuffer_size_generation;
+
+    render_packet_group_t       groups[MAX_RENDER_GROUPS];
+    u32                         group_count;
+
+    render_packet_batch_t       batches[MAX_RENDER_GROUPS * MAX_RENDER_GROUP_CAMERA_COUNT];
+    u32                         batch_count;
+
+    render_geometry_instance_t *instances;
+    u32                         instance_count;
+    u32                         instance_capacity;
+};
+
+struct render_thread_config_t
+{
+    u32           max_frames_ahead;      // NOTE(Sleepster): 0 means 1, double buffered
+    threadpool_t *pool;                  // NOTE(Sleepster): Optional, pins the render thread to one of its reserved cores
+    u32           reserved_core_index;
+};
+
+struct render_thread_t
+{
+    bool8                    is_initialized;
+    volatile u32             is_running;
+
+    vulkan_render_context_t *render_context;
+    threadpool_t            *pool;
+    u32                      reserved_core_index;
+    sys_thread_t             thread;
+
+    render_frame_packet_t   *packets;
+    u32                      packet_count;
+    u32                      write_index;
+    u32                      read_index;
+
+    futex_semaphore_t        free_packets;
+    futex_semaphore_t        ready_packets;
+
+    // NOTE(Sleepster): Stats, in milliseconds. Written by the thread they're named after.
+    u64                      counter_frequency;
+    u64                      packets_submitted;
+    float64                  last_game_wait_ms;
+    float64                  total_game_wait_ms;
+    volatile u64             packets_rendered;
+    volatile u64             packets_dropped;
+    float64                  last_render_ms;
+};
+
+void                   r_render_thread_start(render_thread_t *render_thread, vulkan_render_context_t *render_context, render_thread_config_t *config);
+void                   r_render_thread_stop(render_thread_t *render_thread);
+
+// NOTE(Sleepster): Game thread only. Acquire blocks while the render thread is max_frames_ahead packets behind.
+render_frame_packet_t* r_render_thread_acquire_packet(render_thread_t *render_thread);
+void                   r_render_thread_submit_packet(render_thread_t *render_thread, render_frame_packet_t *packet);
+
+// NOTE(Sleepster): Copies the used render groups into the packet, then resets them for the next frame.
+void                   r_frame_packet_capture(render_frame_packet_t *packet, render_state_t *render_state);
+
+#endif // R_RENDER_THREAD_H
@@ -10,10 +10,12 @@
 #include <c_string.h>
 #include <c_dynarray.h>
 #include <c_threadpool.h>
+#include <c_profiler.h>
 #include <c_log.h>
 #include <c_globals.h>
 #include <c_file_api.h>
 #include <c_memory_arena.h>
+#include <c_memory_telemetry.h>
 
 #include <s_asset_manager.h>
 
@@ -24,6 +26,7 @@
 
 #include <r_vulkan_types.h>
 #include <r_render_group.h>
+#include <r_render_thread.h>
 #include <r_vulkan_core.h>
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -2757,7 +2760,11 @@ r_vulkan_swapchain_present(vulkan_render_context_t *render_context,
         .pImageIndices      = &image_index,
     };
     
-    VkResult result = vkQueuePresentKHR(present_queue, &present_info);
+    VkResult result;
+    {
+        PROFILE_SCOPE("vkQueuePresentKHR");
+        result = vkQueuePresentKHR(present_queue, &present_info);
+    }
     if(result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
     {
         render_context->swapchain = r_vulkan_swapchain_recreate(render_context, 
@@ -2970,11 +2977,10 @@ r_vulkan_physical_device_is_supported(vulkan_render_context_t
 // VULKAN RENDERER CORE 
 ////////////////////////////
 
+// NOTE(Sleepster): Render thread only. The packet is read only here, the game thread owns it again once it's released.
 void
-r_vulkan_render_groups_to_output(render_state_t *render_state)
+r_vulkan_render_packet_to_output(vulkan_render_context_t *render_context, render_frame_packet_t *packet)
 {
-    draw_frame_t *draw_frame                     = &render_state->draw_frame;
-    vulkan_render_context_t *render_context      =  render_state->render_context;
     vulkan_render_frame_state_t  *frame          =  render_context->current_frame;
     vulkan_command_buffer_data_t *command_buffer =  frame->render_command_buffer;
 
@@ -3014,22 +3020,21 @@ r_vulkan_render_groups_to_output(render_state_t *render_state)
                               frame->current_framebuffer->handle);
 
     for(u32 render_group_index = 0;
-        render_group_index < draw_frame->used_render_group_count;
+        render_group_index < packet->group_count;
         ++render_group_index)
     {
-        render_group_t *current_group = draw_frame->used_render_groups[render_group_index];
-        Assert(current_group);
+        render_packet_group_t *current_group = packet->groups + render_group_index;
 
         vulkan_shader_data_t *shader  = &current_group->shader->slot->shader.shader_data;
         r_vulkan_shader_bind(render_context, shader);
-        r_vulkan_shader_set_uniform_data(render_context->default_shader, STR("RenderInstances"), current_group->master_batch_array, sizeof(render_geometry_instance_t) * current_group->total_primitive_count);
+        r_vulkan_shader_set_uniform_data(render_context->default_shader, STR("RenderInstances"), packet->instances + current_group->first_instance, sizeof(render_geometry_instance_t) * current_group->instance_count);
         
         // TODO(Sleepster): Material system will make this unnecessary 
         vulkan_shader_uniform_data_t *uniform = r_vulkan_shader_get_uniform_from_shader(shader, STR("TextureSampler"));
         if(uniform)
         {
             for(u32 texture_index = 0; 
-                texture_index < current_group->current_texture_count; 
+                texture_index < current_group->texture_count; 
                 ++texture_index)
             {
                 texture2D_t *current_texture = current_group->textures[texture_index];
@@ -3046,10 +3051,11 @@ r_vulkan_render_groups_to_output(render_state_t *render_state)
         VkDeviceSize offsets[1] = {};
         vkCmdBindVertexBuffers(command_buffer->handle, 0, 1, &render_context->vertex_buffer.handle, (VkDeviceSize*)&offsets);
         vkCmdBindIndexBuffer(command_buffer->handle, render_context->index_buffer.handle, 0, VK_INDEX_TYPE_UINT32);
-        for(render_geometry_batch_t *current_buffer = &current_group->first_buffer;
-            current_buffer;
-            current_buffer = current_buffer->next_buffer)
+        for(u32 batch_index = 0;
+            batch_index < current_group->batch_count;
+            ++batch_index)
         {
+            render_packet_batch_t *current_batch = packet->batches + current_group->first_batch + batch_index;
             r_vulkan_shader_update_instance_set(render_context, shader);
 
             // TODO(Sleepster): rename this for r_vulkan_shader_update_push_constants;
@@ -3058,18 +3064,12 @@ r_vulkan_render_groups_to_output(render_state_t *render_state)
             // TODO(Sleepster): Multidraw indirect 
             vkCmdDrawIndexed(command_buffer->handle, 
                              6, 
-                             current_buffer->primitive_count, 
+                             current_batch->instance_count, 
                              0, 
                              0,
-                             0);
-            current_buffer->master_array_start_offset = 0;
-            current_buffer->primitive_count           = 0;
+                             current_batch->first_instance);
         }
-
-        current_group->total_primitive_count = 0;
     }
-    draw_frame->used_render_group_count = 0;
-    memset(draw_frame->used_render_groups, -1, draw_frame->used_render_group_count * sizeof(render_group_t**));
 }
 
 void
@@ -3082,7 +3082,7 @@ r_vulkan_on_resize(vulkan_render_context_t *render_context, vec2_t new_window_si
 }
 
 bool8
-r_vulkan_begin_frame(vulkan_render_context_t *render_context, render_state_t *render_state, float32 delta_time)
+r_vulkan_begin_frame(vulkan_render_context_t *render_context, float32 delta_time)
 {
     vulkan_render_frame_state_t *this_frame = render_context->frames + render_context->current_frame_index;
     render_context->current_frame = this_frame;
@@ -3168,11 +3168,11 @@ begin_frame_return:
 }
 
 bool8
-r_vulkan_end_frame(vulkan_render_context_t *render_context, render_state_t *render_state, float32 delta_time)
+r_vulkan_end_frame(vulkan_render_context_t *render_context, render_frame_packet_t *packet, float32 delta_time)
 {
     bool8 result = true;
 
-    r_vulkan_render_groups_to_output(render_state);
+    r_vulkan_render_packet_to_output(render_context, packet);
 
     vulkan_command_buffer_data_t *command_buffer = render_context->current_frame->render_command_buffer; 
     r_vulkan_renderpass_end(render_context, command_buffer, 
@@ -3212,10 +3212,14 @@ r_vulkan_end_frame(vulkan_render_context_t *render_context, render_state_t *rend
         .pWaitDstStageMask    = stage_flags
     };
 
-    VkResult submit_result = vkQueueSubmit(render_context->rendering_device.graphics_queue, 
-                                           1, 
-                                          &submit_info, 
-                                           render_context->current_frame->image_render_idle_fence->handle);
+    VkResult submit_result;
+    {
+        PROFILE_SCOPE("vkQueueSubmit");
+        submit_result = vkQueueSubmit(render_context->rendering_device.graphics_queue, 
+                                      1, 
+                                     &submit_info, 
+                                      render_context->current_frame->image_render_idle_fence->handle);
+    }
     if(submit_result != VK_SUCCESS)
     {
         log_error("vkQueueSubmit has failed with result: '%s'...\n", r_vulkan_result_string(submit_result, true));
@@ -3383,6 +3387,8 @@ r_renderer_init(vulkan_render_context_t *render_context, render_state_t *render_
     render_context->initialization_arena = c_arena_create(MB(10));
     render_context->frame_arena          = c_arena_create(MB(100));
     render_context->permanent_arena      = c_arena_create(MB(100));
+    c_memory_telemetry_register_arena("vulkan_frame",     &render_context->frame_arena);
+    c_memory_telemetry_register_arena("vulkan_permanent", &render_context->permanent_arena);
 
     // NOTE(Sleepster): Default to triple buffering 
     render_context->additional_buffer_count = VULKAN_MAX_FRAMES_IN_FLIGHT;
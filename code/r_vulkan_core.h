@@ -22,6 +22,7 @@
 
 typedef struct texture2D texture2D_t;
 struct render_state_t;
+struct render_frame_packet_t;
 
 //#define VkAssert(result) Statement(Assert(result == VK_SUCCESS))
 #define vkAssert(result) ({                                                \
@@ -57,8 +58,9 @@ void r_vulkan_shader_assign_vulkan_buffer(vulkan_shader_data_t *shader, string_t
 
 vulkan_shader_uniform_data_t *r_vulkan_shader_get_uniform(asset_handle_t *shader_handle, string_t uniform_name);
 
-bool8 r_vulkan_begin_frame(vulkan_render_context_t *render_context, render_state_t *render_state, float32 delta_time);
-bool8 r_vulkan_end_frame(vulkan_render_context_t *render_context, render_state_t *render_state, float32 delta_time);
+// NOTE(Sleepster): Render thread only once it's running, see r_render_thread.h.
+bool8 r_vulkan_begin_frame(vulkan_render_context_t *render_context, float32 delta_time);
+bool8 r_vulkan_end_frame(vulkan_render_context_t *render_context, render_frame_packet_t *packet, float32 delta_time);
 
 void r_vulkan_shader_update_static_set(vulkan_render_context_t *render_context, vulkan_shader_data_t *shader);
 
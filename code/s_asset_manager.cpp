@@ -11,15 +11,53 @@
 #include <c_log.h>
 #include <c_memory_arena.h>
 #include <c_zone_allocator.h>
+#include <c_memory_telemetry.h>
+#include <c_lock_profiler.h>
 #include <c_file_api.h>
 #include <c_file_watcher.h>
 #include <c_string.h>
 #include <c_hash_table.h>
 #include <c_dynarray.h>
+#include <c_globals.h>
+#include <c_parallel.h>
+#include <c_profiler.h>
 #include <asset_file_packer/jfd_asset_file.h>
 
 #include <r_vulkan_core.h>
 
+const char *asset_load_stage_names[ALS_Count] =
+{
+    "read",
+    "decode",
+    "atlas_pack",
+    "upload",
+};
+
+// NOTE(Sleepster): Loads can happen on more than one thread, so the adds are atomic.
+internal_api void
+s_asset_load_timings_add(asset_load_timings_t *timings, asset_load_stage_t stage, u64 start_counter, u64 bytes)
+{
+    AtomicExchangeAdd64(&timings->ticks[stage], SDL_GetPerformanceCounter() - start_counter);
+    AtomicExchangeAdd64(&timings->bytes[stage], bytes);
+    AtomicIncrement64(&timings->calls[stage]);
+}
+
+// NOTE(Sleepster): 'pass_count' divides everything, so a report over several loads reads as one average load.
+void
+s_asset_load_timings_log(asset_load_timings_t *timings, const char *label, u32 pass_count)
+{
+    float64 ticks_per_ms = (float64)SDL_GetPerformanceFrequency() / 1000.0;
+    float64 pass_scale   = 1.0 / (float64)(pass_count ? pass_count : 1);
+    for(u32 stage_index = 0; stage_index < ALS_Count; ++stage_index)
+    {
+        float64 stage_ms = ((float64)timings->ticks[stage_index] / ticks_per_ms) * pass_scale;
+        float64 stage_mb = ((float64)timings->bytes[stage_index] / (float64)MB(1)) * pass_scale;
+        log_info("[%s] %-10s '%9.3f' ms, '%6llu' calls, '%8.1f' MB...\n",
+                 label, asset_load_stage_names[stage_index], stage_ms,
+                 (unsigned long long)((float64)timings->calls[stage_index] * pass_scale), stage_mb);
+    }
+}
+
 // ===============================
 // ========== TEXTURES ===========
 // ===============================
@@ -112,8 +150,14 @@ s_asset_shader_create(asset_manager_t *asset_manager, asset_slot_t *slot, u64 na
 void
 s_asset_manager_load_asset_data(asset_manager_t *asset_manager, asset_handle_t *handle, u64 name_hash)
 {
+    PROFILE_FUNCTION();
+
     asset_slot_t *slot = handle->slot;
     Assert(slot->slot_state == ASLS_Unloaded || slot->slot_state == ASLS_ShouldReload);
+    AtomicIncrement32(&asset_manager->loads_in_flight);
+    asset_load_timings_t *timings = &asset_manager->load_timings;
+
+    u64 stage_start = SDL_GetPerformanceCounter();
     slot->package_entry->asset_data = c_file_read_from_offset(&slot->owner_asset_file, 
                                                               slot->package_entry->asset_data.count,
                                                               slot->package_entry->data_offset, 
@@ -121,16 +165,22 @@ s_asset_manager_load_asset_data(asset_manager_t *asset_manager, asset_handle_t *
                                                               asset_manager->asset_allocator, 
                                                               ZA_TAG_STATIC);
     Assert(slot->package_entry->asset_data.data != null);
+    s_asset_load_timings_add(timings, ALS_Read, stage_start, slot->package_entry->asset_data.count);
+
     switch(slot->type)
     {
         case AT_Bitmap:
         {
+            stage_start   = SDL_GetPerformanceCounter();
             slot->texture = s_asset_texture_create(asset_manager, slot);
+            s_asset_load_timings_add(timings, ALS_Decode, stage_start, slot->texture.bitmap.pixels.count);
             log_info("Loading texture data for bitmap: '%s'...\n", C_STR(handle->slot->name));
         }break;
         case AT_Shader:
         {
+            stage_start  = SDL_GetPerformanceCounter();
             slot->shader = s_asset_shader_create(asset_manager, slot, name_hash);
+            s_asset_load_timings_add(timings, ALS_Upload, stage_start, slot->package_entry->asset_data.count);
             log_info("Loading shader data for: '%s'...\n", C_STR(handle->slot->name));
         }break;
         case AT_Font:
@@ -144,6 +194,7 @@ s_asset_manager_load_asset_data(asset_manager_t *asset_manager, asset_handle_t *
     }
     slot->slot_state = ASLS_Loaded;
     AtomicIncrement32(&slot->package_generation);
+    AtomicDecrement32(&asset_manager->loads_in_flight);
 }
 
 internal_api
@@ -168,6 +219,9 @@ s_asset_manager_init(asset_manager_t *asset_manager)
 
     asset_manager->manager_arena   = c_arena_create(MB(100));
     asset_manager->asset_allocator = c_za_create(GB(1));
+    c_memory_telemetry_register_arena("asset_manager", &asset_manager->manager_arena);
+    c_memory_telemetry_register_zone("asset_zone",     asset_manager->asset_allocator);
+    c_lock_profiler_register_mutex("asset_zone", &asset_manager->asset_allocator->mutex);
     for(u32 catalog_index = 1;
         catalog_index < AT_Count;
         ++catalog_index)
@@ -197,6 +251,8 @@ s_asset_manager_init(asset_manager_t *asset_manager)
 bool8
 s_asset_manager_load_asset_file(asset_manager_t *asset_manager, string_t filepath)
 {
+    PROFILE_FUNCTION();
+
     Assert(asset_manager->is_initialized);
     Assert(asset_manager->loaded_file_count + 1 <= ASSET_MANAGER_MAX_ASSET_FILES);
     
@@ -225,10 +281,16 @@ s_asset_manager_load_asset_file(asset_manager_t *asset_manager, string_t filepat
         asset_file->is_initialized  = true;
         asset_file->ID              = asset_manager->loaded_file_count;
 
+        char arena_name[MEMORY_TELEMETRY_NAME_LENGTH];
+        snprintf(arena_name, sizeof(arena_name), "asset_file %.*s", (s32)asset_file->file_info.file_name.count, C_STR(asset_file->file_info.file_name));
+        c_memory_telemetry_register_arena(arena_name, &asset_file->init_arena);
+
         jfd_file_header_t *header = (jfd_file_header_t*)(c_file_read(file_handle, sizeof(jfd_file_header_t), &asset_file->init_arena).data);
         Assert(header->magic_value == ASSET_FILE_HEADER_MAGIC);
         
-        asset_file->package_entries = c_arena_push_array(&asset_file->init_arena, jfd_package_entry_t, header->entry_count);
+        asset_file->header_data         = header;
+        asset_file->package_entry_count = header->entry_count;
+        asset_file->package_entries     = c_arena_push_array(&asset_file->init_arena, jfd_package_entry_t, header->entry_count);
         c_hash_table_init(&asset_file->entry_hash, 
                            ASSET_CATALOG_MAX_LOOKUPS, 
                           &asset_file->init_arena, 
@@ -345,6 +407,146 @@ s_asset_manager_acquire_asset_handle(asset_manager_t *asset_manager, string_t na
     return(result);
 }
 
+#define ASSET_LOAD_HEADLESS_ATLAS_SIZE (2048)
+
+/* NOTE(Sleepster): '-asset_load', every asset in a package read into the zone, decoded and packed into atlases the
+ * way the game does it, 'repeat_count' times over. No window and no GPU: shaders are skipped since making one needs
+ * the renderer, and the atlases are packed with a null render context so the upload stage stays empty.
+ *
+ * The first pass is cold, the package is dropped from the OS' file cache before it (where the platform can), the
+ * rest are warm. Reports the cold pass, the median and fastest warm pass, each with its per stage times, and the
+ * peaks of the asset zone and the process. This is also the asset half of the PGO training run ('make pgo'), and
+ * 'make asset_bench' runs it over a pack from jfd_synthetic_packer.
+ */
+s32
+s_asset_manager_load_package_headless(string_t filepath, u32 repeat_count)
+{
+    s32 result = 1;
+    if(repeat_count == 0) repeat_count = 1;
+
+    bool8 is_cold = sys_file_drop_from_cache(filepath);
+    if(!is_cold)
+    {
+        log_warning("Could not drop '%s' from the file cache, the first pass won't be a cold one...\n", C_STR(filepath));
+    }
+
+    asset_manager_t *asset_manager = Alloc(asset_manager_t);
+    s_asset_manager_init(asset_manager);
+    if(s_asset_manager_load_asset_file(asset_manager, filepath))
+    {
+        asset_manager_asset_file_data_t *asset_file = asset_manager->asset_files + (asset_manager->loaded_file_count - 1);
+        asset_handle_t *handles     = c_arena_push_array(&asset_manager->manager_arena, asset_handle_t, asset_file->package_entry_count);
+        float64        *pass_ms     = c_arena_push_array(&asset_manager->manager_arena, float64, repeat_count);
+        float64         ticks_per_ms = (float64)SDL_GetPerformanceFrequency() / 1000.0;
+
+        asset_load_timings_t cold_timings = {};
+        asset_load_timings_t warm_timings = {};
+        u64 asset_count = 0;
+        u64 asset_bytes = 0;
+        u32 atlas_count = 0;
+        for(u32 pass_index = 0; pass_index < repeat_count; ++pass_index)
+        {
+            ZeroStruct(asset_manager->load_timings);
+            u64 pass_start  = SDL_GetPerformanceCounter();
+            u32 handle_count = 0;
+            asset_count = 0;
+            asset_bytes = 0;
+            for(u32 entry_index = 0; entry_index < asset_file->package_entry_count; ++entry_index)
+            {
+                jfd_package_entry_t *entry = asset_file->package_entries + entry_index;
+                if(entry->entry_header->asset_type == AT_Shader) continue;
+
+                asset_handle_t *handle = handles + handle_count++;
+                *handle = s_asset_manager_acquire_asset_handle(asset_manager, entry->filename);
+                Assert(handle->is_valid && handle->slot->slot_state == ASLS_Loaded);
+                asset_bytes += entry->asset_data.count;
+                ++asset_count;
+            }
+
+            // NOTE(Sleepster): A new atlas whenever the current one is full, anything bigger than a whole atlas is
+            //                  left out the same as it would be in the game.
+            texture_atlas_t *atlas = null;
+            atlas_count = 0;
+            for(u32 handle_index = 0; handle_index < handle_count; ++handle_index)
+            {
+                asset_handle_t *handle = handles + handle_index;
+                bitmap_t       *bitmap = &handle->slot->texture.bitmap;
+                if(handle->type != AT_Bitmap || bitmap->channels != 4) continue;
+                if(bitmap->width  >= ASSET_LOAD_HEADLESS_ATLAS_SIZE || 
+                   bitmap->height >= ASSET_LOAD_HEADLESS_ATLAS_SIZE) continue;
+
+                if(atlas && !s_texture_atlas_add_texture(atlas, handle))
+                {
+                    s_texture_atlas_pack_added_textures(null, atlas);
+                    s_texture_atlas_destroy(asset_manager, atlas);
+                    atlas = null;
+                }
+                if(!atlas)
+                {
+                    atlas = s_texture_atlas_create(asset_manager, ASSET_LOAD_HEADLESS_ATLAS_SIZE, 4, BMF_RGBA32, 256);
+                    s_texture_atlas_add_texture(atlas, handle);
+                    ++atlas_count;
+                }
+            }
+            if(atlas)
+            {
+                s_texture_atlas_pack_added_textures(null, atlas);
+                s_texture_atlas_destroy(asset_manager, atlas);
+            }
+            pass_ms[pass_index] = (float64)(SDL_GetPerformanceCounter() - pass_start) / ticks_per_ms;
+
+            // NOTE(Sleepster): Unloaded again so the next pass does the whole load over.
+            for(u32 handle_index = 0; handle_index < handle_count; ++handle_index)
+            {
+                asset_slot_t *slot = handles[handle_index].slot;
+                if(slot->type == AT_Bitmap) stbi_image_free(slot->texture.bitmap.pixels.data);
+                c_za_free(asset_manager->asset_allocator, slot->package_entry->asset_data.data);
+                slot->package_entry->asset_data.data = null;
+                slot->slot_state                     = ASLS_Unloaded;
+            }
+
+            asset_load_timings_t *pass_timings = pass_index == 0 ? &cold_timings : &warm_timings;
+            for(u32 stage_index = 0; stage_index < ALS_Count; ++stage_index)
+            {
+                pass_timings->ticks[stage_index] += asset_manager->load_timings.ticks[stage_index];
+                pass_timings->calls[stage_index] += asset_manager->load_timings.calls[stage_index];
+                pass_timings->bytes[stage_index] += asset_manager->load_timings.bytes[stage_index];
+            }
+        }
+
+        log_info("Loaded '%llu' assets ('%.1f' MB) into '%u' atlases out of '%s' over '%u' passes...\n",
+                 asset_count, (float64)asset_bytes / (float64)MB(1), atlas_count, C_STR(filepath), repeat_count);
+        log_info("%s pass: '%.3f' ms...\n", is_cold ? "Cold" : "First", pass_ms[0]);
+        s_asset_load_timings_log(&cold_timings, is_cold ? "cold" : "first", 1);
+
+        u32 warm_count = repeat_count - 1;
+        if(warm_count > 0)
+        {
+            float64 *warm_ms = pass_ms + 1;
+            for(u32 sort_index = 1; sort_index < warm_count; ++sort_index)
+            {
+                float64 value = warm_ms[sort_index];
+                u32 insert_index = sort_index;
+                for(; insert_index > 0 && warm_ms[insert_index - 1] > value; --insert_index)
+                {
+                    warm_ms[insert_index] = warm_ms[insert_index - 1];
+                }
+                warm_ms[insert_index] = value;
+            }
+            log_info("Warm passes: median '%.3f' ms, min '%.3f' ms, max '%.3f' ms over '%u' passes...\n",
+                     warm_ms[warm_count / 2], warm_ms[0], warm_ms[warm_count - 1], warm_count);
+            s_asset_load_timings_log(&warm_timings, "warm", warm_count);
+        }
+
+        log_info("Peak memory: asset zone '%.1f' MB, process resident '%.1f' MB...\n",
+                 (float64)asset_manager->asset_allocator->peak_used_bytes / (float64)MB(1),
+                 (float64)sys_get_peak_resident_bytes() / (float64)MB(1));
+        result = 0;
+    }
+
+    return(result);
+}
+
 // ===============================
 // ======= TEXTURE ATLASES =======
 // ===============================
@@ -382,33 +584,112 @@ s_texture_atlas_create(asset_manager_t *asset_manager,
     atlas->textures_to_merge = c_dynarray_create(asset_handle_t*);
     c_dynarray_reserve(atlas->textures_to_merge, initial_subtexture_count);
 
-    atlas->packed_subtextures = c_dynarray_create(subtexture_data_t);
-    atlas->packed_subtextures = c_dynarray_reserve(atlas->packed_subtextures, initial_subtexture_count);
+    // NOTE(Sleepster): Never grown, the assets point into it. add_texture() turns textures away once it's spoken for.
+    atlas->packed_subtextures  = c_dynarray_create(subtexture_data_t);
+    atlas->packed_subtextures  = c_dynarray_reserve(atlas->packed_subtextures, initial_subtexture_count);
+    atlas->subtexture_capacity = initial_subtexture_count;
 
-    atlas->ID       = registry->current_atlas_count - 1;
-    atlas->is_valid = true;
+    // NOTE(Sleepster): The slot, not the count, a destroyed atlas leaves a hole the next one fills.
+    atlas->ID            = (u32)(atlas - registry->atlases);
+    atlas->asset_manager = asset_manager;
+    atlas->is_valid      = true;
 
     return(atlas);
 }
 
+// NOTE(Sleepster): The CPU side only, an atlas that's been uploaded still has its GPU texture.
 void
+s_texture_atlas_destroy(asset_manager_t *asset_manager, texture_atlas_t *atlas)
+{
+    Assert(atlas->is_valid);
+
+    c_za_free(asset_manager->asset_allocator, atlas->texture.bitmap.pixels.data);
+    c_dynarray_destroy(atlas->textures_to_merge);
+    c_dynarray_destroy(atlas->packed_subtextures);
+    ZeroStruct(*atlas);
+
+    asset_manager->atlas_registry.current_atlas_count -= 1;
+}
+
+/* NOTE(Sleepster): Walks the same rows s_texture_atlas_pack_added_textures() will, one texture ahead of it, so a
+ * texture that would run off the bottom (or is wider than the atlas) is turned away here instead of being copied
+ * past the end of the atlas' pixels. So is one that would need a subtexture past the ones the atlas reserved.
+ */
+bool8
 s_texture_atlas_add_texture(texture_atlas_t *atlas, asset_handle_t *texture_handle)
 {
     Assert(texture_handle);
     Assert(texture_handle->is_valid);
     Assert(texture_handle->type == AT_Bitmap);
 
-    c_dynarray_push(atlas->textures_to_merge, texture_handle);
-    atlas->merge_counter += 1;
+    u32 padding        = 1;
+    u32 atlas_size     = atlas->bitmap_data->height;
+    u32 bitmap_width   = texture_handle->slot->texture.bitmap.width;
+    u32 bitmap_height  = texture_handle->slot->texture.bitmap.height;
+    u32 cursor_x       = atlas->reserve_cursor_x;
+    u32 cursor_y       = atlas->reserve_cursor_y;
+    u32 tallest_y      = atlas->reserve_tallest_y;
+    if((cursor_x + bitmap_width) >= atlas_size)
+    {
+        cursor_x  = 0;
+        cursor_y += tallest_y;
+    }
+    if(bitmap_height > tallest_y) tallest_y = bitmap_height;
+
+    bool8 result = (cursor_x + padding + bitmap_width)  <= atlas->bitmap_data->width &&
+                   (cursor_y + padding + bitmap_height) <= atlas_size &&
+                   (atlas->packed_subtexture_count + atlas->merge_counter) < atlas->subtexture_capacity;
+    if(result)
+    {
+        atlas->reserve_cursor_x  = cursor_x + padding + bitmap_width;
+        atlas->reserve_cursor_y  = cursor_y;
+        atlas->reserve_tallest_y = tallest_y;
+
+        c_dynarray_push(atlas->textures_to_merge, texture_handle);
+        atlas->merge_counter += 1;
+    }
+
+    return(result);
+}
+
+struct texture_atlas_blit_t
+{
+    byte *atlas_pixels;
+    u32   atlas_stride;
+
+    byte *bitmap_pixels;
+    u32   bitmap_stride;
+
+    u32   row_size;
+};
+
+internal_api void
+s_texture_atlas_blit_rows(void *user_data, u64 first_row, u64 last_row)
+{
+    PROFILE_SCOPE_COUNTERS("s_texture_atlas_blit_rows");
+    texture_atlas_blit_t *blit = (texture_atlas_blit_t*)user_data;
+    for(u64 row_index = first_row;
+        row_index < last_row;
+        ++row_index)
+    {
+        memcpy(blit->atlas_pixels  + (row_index * blit->atlas_stride),
+               blit->bitmap_pixels + (row_index * blit->bitmap_stride),
+               blit->row_size);
+    }
 }
 
 void
 s_texture_atlas_pack_added_textures(vulkan_render_context_t *render_context, texture_atlas_t *atlas)
 {
+    PROFILE_FUNCTION();
     Assert(atlas->is_valid);
 
     if(atlas->merge_counter > 0)
     {
+        asset_load_timings_t *timings = &atlas->asset_manager->load_timings;
+        u64 stage_start  = SDL_GetPerformanceCounter();
+        u64 packed_bytes = 0;
+
         u32 atlas_width       = atlas->bitmap_data->width;
         u32 atlas_height      = atlas->bitmap_data->height;
         u32 atlas_channels    = atlas->bitmap_data->channels;
@@ -438,24 +719,21 @@ s_texture_atlas_pack_added_textures(vulkan_render_context_t *render_context, tex
             u32 atlas_cursor_x = atlas->atlas_cursor_x + padding;
             u32 atlas_cursor_y = atlas->atlas_cursor_y + padding;
 
-            // NOTE(Sleepster): Copy by row. 
-            for(u32 row_index = 0;
-                row_index < bitmap_height;
-                ++row_index)
-            {
-                u32 atlas_bitmap_offset  = ((atlas_cursor_y + row_index) * atlas_width + atlas_cursor_x) * atlas_channels;
-                byte *atlas_pixel_offset = atlas_pixels.data + atlas_bitmap_offset;
-
-                u32 bitmap_offset = (row_index * bitmap_width) * bitmap_channels;
-                byte *bitmap_data_offset = bitmap_pixels.data + bitmap_offset;
-
-                memcpy(atlas_pixel_offset, bitmap_data_offset, bitmap_width * bitmap_channels);
-            }
+            // NOTE(Sleepster): Copy by row. Big textures get their rows split across the threadpool, anything
+            //                  under the grain just gets copied right here.
+            texture_atlas_blit_t blit;
+            blit.atlas_pixels  = atlas_pixels.data + (((atlas_cursor_y * atlas_width) + atlas_cursor_x) * atlas_channels);
+            blit.atlas_stride  = atlas_width * atlas_channels;
+            blit.bitmap_pixels = bitmap_pixels.data;
+            blit.bitmap_stride = bitmap_width * bitmap_channels;
+            blit.row_size      = bitmap_width * bitmap_channels;
+            c_parallel_for(&global_context->main_threadpool, 0, bitmap_height, 64, &s_texture_atlas_blit_rows, &blit);
 
             vec2_t uv_min = vec2(atlas_cursor_x, atlas_cursor_y);
             vec2_t uv_max = vec2(atlas_cursor_x + bitmap_width, atlas_cursor_y + bitmap_height);
 
             // NOTE(Sleepster): Create the subtexture, let the owner of the sprite know this is that subtexture. 
+            Assert(atlas->packed_subtexture_count < atlas->subtexture_capacity);
             subtexture_data_t *subtexture = atlas->packed_subtextures + atlas->packed_subtexture_count;
             asset->subtexture_data = subtexture;
 
@@ -467,9 +745,18 @@ s_texture_atlas_pack_added_textures(vulkan_render_context_t *render_context, tex
             subtexture->atlas                  = atlas;
 
             atlas->atlas_cursor_x = atlas_cursor_x + bitmap_width;
+            packed_bytes         += (u64)bitmap_width * bitmap_height * bitmap_channels;
         }
         c_dynarray_clear(atlas->textures_to_merge);
-        r_vulkan_make_gpu_texture(render_context, &atlas->texture);
+        atlas->merge_counter = 0;
+        s_asset_load_timings_add(timings, ALS_AtlasPack, stage_start, packed_bytes);
+
+        if(render_context)
+        {
+            stage_start = SDL_GetPerformanceCounter();
+            r_vulkan_make_gpu_texture(render_context, &atlas->texture);
+            s_asset_load_timings_add(timings, ALS_Upload, stage_start, atlas->bitmap_data->pixels.count);
+        }
     }
     else
     {
@@ -55,6 +55,24 @@ typedef enum asset_slot_state
     ASLS_Count
 }asset_slot_load_status_t;
 
+// NOTE(Sleepster): Where a load's time goes. Read is off the package into the zone, decode is the PNG to pixels,
+//                  atlas pack is the copy into an atlas and upload is anything that goes to the GPU (shaders, atlases).
+typedef enum asset_load_stage
+{
+    ALS_Read,
+    ALS_Decode,
+    ALS_AtlasPack,
+    ALS_Upload,
+    ALS_Count
+}asset_load_stage_t;
+
+typedef struct asset_load_timings
+{
+    volatile u64 ticks[ALS_Count];
+    volatile u64 calls[ALS_Count];
+    volatile u64 bytes[ALS_Count];
+}asset_load_timings_t;
+
 typedef enum bitmap_format
 {
     BMF_Invalid,
@@ -124,18 +142,25 @@ typedef struct texture_atlas
 
     u32                           ID;
     u32                           merge_counter;
+    asset_manager_t              *asset_manager;
     DynArray_t(asset_handle_t*)   textures_to_merge;
 
     // TODO(Sleepster): Technically we need "add" to this array, just pull from it. What do we do about this? 
     //                  Guess it's not a problem for now.
     DynArray_t(subtexture_data_t) packed_subtextures;
     u32                           packed_subtexture_count;
+    u32                           subtexture_capacity;
     bool32                        is_valid;
 
     u32                           atlas_cursor_x;
     u32                           atlas_cursor_y;
     u32                           tallest_y;
     u32                           atlas_size;
+
+    // NOTE(Sleepster): Where the textures that were added but not packed yet will end up, add_texture() checks these.
+    u32                           reserve_cursor_x;
+    u32                           reserve_cursor_y;
+    u32                           reserve_tallest_y;
 }texture_atlas_t;
 
 /*===========================================
@@ -251,6 +276,8 @@ typedef struct asset_manager
 
     asset_slot_t                   *asset_load_queue[256];
     asset_slot_t                   *asset_unload_queue[256];
+    volatile u32                    loads_in_flight;
+    asset_load_timings_t            load_timings;
 
     texture_atlas_registry_t        atlas_registry;
 
@@ -266,10 +293,19 @@ typedef struct asset_manager
 void  s_asset_manager_init(asset_manager_t *asset_manager);
 bool8 s_asset_manager_load_asset_file(asset_manager_t *asset_manager, string_t filepath);
 asset_handle_t s_asset_manager_acquire_asset_handle(asset_manager_t *asset_manager, string_t name);
+void  s_asset_load_timings_log(asset_load_timings_t *timings, const char *label, u32 pass_count);
+s32   s_asset_manager_load_package_headless(string_t filepath, u32 repeat_count);
+
+extern const char *asset_load_stage_names[ALS_Count];
 
 
 texture_atlas_t* s_texture_atlas_create(asset_manager_t *asset_manager, u32 size, u32 channel_count, u32 format, u32 initial_subtexture_count);
-void s_texture_atlas_add_texture(texture_atlas_t *atlas, asset_handle_t *texture_handle);
+void s_texture_atlas_destroy(asset_manager_t *asset_manager, texture_atlas_t *atlas);
+
+// NOTE(Sleepster): False when the texture won't fit in what's left of the atlas, it isn't added then.
+bool8 s_texture_atlas_add_texture(texture_atlas_t *atlas, asset_handle_t *texture_handle);
+
+// NOTE(Sleepster): A null render_context packs on the CPU and skips the upload, for headless loads.
 void s_texture_atlas_pack_added_textures(vulkan_render_context_t *render_context, texture_atlas_t *atlas);
 
 #endif // S_ASSET_MANAGER_H
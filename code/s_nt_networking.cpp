@@ -7,6 +7,21 @@
 #include <s_nt_networking.h>
 #include <stdio.h>
 
+internal_api void
+s_nt_send_packet(game_state_t *state, packet_t *packet, struct sockaddr *address, socklen_t address_length)
+{
+    s64 bytes = sendto(state->socket, (char*)packet, sizeof(packet_t), 0, address, address_length);
+    if(bytes > 0)
+    {
+        state->network_stats.packets_sent += 1;
+        state->network_stats.bytes_sent   += (u64)bytes;
+    }
+    else
+    {
+        state->network_stats.send_errors += 1;
+    }
+}
+
 bool8
 s_nt_socket_api_init(game_state_t *state, int argc, char **argv)
 {
@@ -106,12 +121,7 @@ s_nt_init_client_data(game_state_t *state, char *host_ip, u32 port)
 
         packet_t packet = {};
         packet.type     = PT_Connect;
-        sendto(state->socket, 
-               (char*)&packet, 
-               sizeof(packet_t), 
-               0,
-               (struct sockaddr*)&state->host_address_data, 
-               sizeof(state->host_address_data));
+        s_nt_send_packet(state, &packet, (struct sockaddr*)&state->host_address_data, sizeof(state->host_address_data));
 
         printf("[CLIENT]: Connecting to %s:%d\n", host_ip, htons(state->host_address_data.sin_port));
     }
@@ -133,7 +143,13 @@ s_nt_client_check_packets(game_state_t *state)
                              &sock_addr_size);
         if(bytes > 0) 
         {
-            if(packet.magic_value == htonl(cv_packet_magic_value))
+            state->network_stats.packets_received += 1;
+            state->network_stats.bytes_received   += (u64)bytes;
+            if(packet.magic_value != htonl(cv_packet_magic_value))
+            {
+                state->network_stats.invalid_packets += 1;
+            }
+            else
             {
                 Assert(packet.client_id <= 4);
                 switch(packet.type) 
@@ -158,12 +174,7 @@ s_nt_client_check_packets(game_state_t *state)
                         response.client_id = htonl(client->ID);
 
                         state->connected_client_count += 1;
-                        sendto(state->socket, 
-                               (char*)&response, 
-                               sizeof(packet_t), 
-                               0, 
-                               (struct sockaddr*)&from, 
-                               sock_addr_size);
+                        s_nt_send_packet(state, &response, (struct sockaddr*)&from, sock_addr_size);
 
                         printf("[HOST]: Client %d connected\n", client->ID);
 
@@ -234,12 +245,7 @@ s_nt_client_send_packets(game_state_t *state)
             input_data_t input_data   = our_client->input_data_buffer[our_client->input_data_tail];
             packet.payload.input_data = input_data;
 
-            sendto(state->socket,
-                   (char*)&packet,
-                   sizeof(packet_t),
-                   0,
-                   (struct sockaddr*)&host->address,
-                   host->addr_len);
+            s_nt_send_packet(state, &packet, (struct sockaddr*)&host->address, host->addr_len);
         }
     }
 
@@ -266,12 +272,7 @@ s_nt_client_send_packets(game_state_t *state)
                     if(other_client_index != connected_clients)
                     {
                         client_data_t *dest_client = state->clients + other_client_index;
-                        sendto(state->socket,
-                               (char*)&echo_packet,
-                               sizeof(packet_t),
-                               0,
-                               (struct sockaddr*)&dest_client->address,
-                               dest_client->addr_len);
+                        s_nt_send_packet(state, &echo_packet, (struct sockaddr*)&dest_client->address, dest_client->addr_len);
                     }
                 }
             }
@@ -0,0 +1,83 @@
+/* ========================================================================
+   $File: sampler_report.cpp $
+   $Date: October 19 2026 11:20 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_log.h>
+#include <c_string.h>
+#include <c_file_api.h>
+#include <c_memory_arena.h>
+#include <p_platform_data.h>
+
+#define PROGRAM_FLAG_HANDLER_IMPLEMENTATION
+#include <c_program_flag_handler.h>
+#include <c_sampler.h>
+
+#include <p_platform_data.cpp>
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_sampler.cpp>
+
+/* NOTE(Sleepster): Symbolizes a capture from '-sample_hz' offline, run it on the machine the capture came from so the
+ * module paths in it still point at the same binaries.
+ *
+ *     sampler_report samples.smpl [-top=25] [-folded=samples.folded]
+ *
+ * Prints the top functions by self time. '-folded' writes one 'thread;root;...;leaf count' line per distinct stack,
+ * 'flamegraph.pl samples.folded > samples.svg' or drop it on speedscope.app.
+ */
+
+int
+main(int argc, char **argv)
+{
+    u64   *top_count   = c_program_flag_add_size("top", 25, "How many functions the report lists\n");
+    char **folded_path = c_program_flag_add_string("folded", (char*)"", "Writes the folded stacks here\n");
+
+    char *capture_path = null;
+    char *flag_args[64] = {argv[0]};
+    s32   flag_count    = 1;
+    for(s32 arg_index = 1; arg_index < argc && flag_count < (s32)ArrayCount(flag_args); ++arg_index)
+    {
+        if(argv[arg_index][0] == '-') flag_args[flag_count++] = argv[arg_index];
+        else                          capture_path             = argv[arg_index];
+    }
+    if(flag_count > 1) c_program_flag_parse_args(flag_count, flag_args);
+
+    if(!capture_path)
+    {
+        log_error("Usage: sampler_report <capture> [-top=<n>] [-folded=<path>]...\n");
+        return(1);
+    }
+
+    s32 result = 1;
+    sampler_report_t *report = (sampler_report_t*)calloc(1, sizeof(sampler_report_t));
+    if(c_sampler_report_load(report, STR(capture_path)))
+    {
+        c_sampler_report_log_top(report, (u32)*top_count);
+
+        result = 0;
+        if(**folded_path)
+        {
+            if(c_sampler_report_write_folded(report, STR(*folded_path))) log_info("Wrote the folded stacks to '%s'...\n", *folded_path);
+            else                                                      result = 1;
+        }
+    }
+    c_sampler_report_destroy(report);
+    free(report);
+
+    return(result);
+}
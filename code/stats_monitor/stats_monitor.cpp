@@ -0,0 +1,173 @@
+/* ========================================================================
+   $File: stats_monitor.cpp $
+   $Date: October 19 2026 07:40 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_log.h>
+#include <c_string.h>
+#include <c_memory_arena.h>
+#include <p_platform_data.h>
+
+#define PROGRAM_FLAG_HANDLER_IMPLEMENTATION
+#include <c_program_flag_handler.h>
+#include <c_stats_export.h>
+
+#include <p_platform_data.cpp>
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_memory_telemetry.cpp>
+#include <c_stats_export.cpp>
+
+/* NOTE(Sleepster): Reads what an engine started with '-stats_export=<name>' publishes, from another process on the
+ * same machine.
+ *
+ *     stats_monitor [-name=newsdl_stats] [-interval_ms=1000] [-count=0]
+ *     stats_monitor [-name=newsdl_stats] -prometheus
+ *
+ * The first tails it, a line every interval that saw a new frame, until 'count' lines (0 is forever). The engine
+ * going away and coming back is fine, it waits for it. '-prometheus' prints the latest snapshot once in Prometheus'
+ * text format and exits, for node_exporter's textfile collector or a scrape script.
+ */
+
+#define STATS_MONITOR_READ_ATTEMPTS  (64)
+#define STATS_MONITOR_STALL_SECONDS  (3.0f)
+
+internal_api void
+stats_monitor_print_line(stats_export_snapshot_t *snapshot)
+{
+    stats_export_network_t *network = &snapshot->network;
+    printf("frame %llu | %6.2f ms (avg %6.2f, max %6.2f) | %6.1f fps | %5.1f ticks/s | queued %3u | loads %2u | "
+           "mem %8.1f MB (%llu allocs) | net tx %llu pkts %llu B, rx %llu pkts %llu B\n",
+           (unsigned long long)snapshot->frame_index, snapshot->frame_ms, snapshot->frame_ms_average, snapshot->frame_ms_max,
+           snapshot->frames_per_second, snapshot->ticks_per_second, snapshot->threadpool_queued, snapshot->asset_loads_in_flight,
+           (float64)snapshot->memory_total.current_bytes / (float64)MB(1), (unsigned long long)snapshot->memory_total.allocation_count,
+           (unsigned long long)network->packets_sent, (unsigned long long)network->bytes_sent,
+           (unsigned long long)network->packets_received, (unsigned long long)network->bytes_received);
+    fflush(stdout);
+}
+
+internal_api s32
+stats_monitor_prometheus(const char *name)
+{
+    s32 result = 1;
+
+    sys_shared_memory_t shared = {};
+    if(!c_stats_export_attach(&shared, name))
+    {
+        log_error("Nothing is exporting stats as '%s'...\n", name);
+        return(result);
+    }
+
+    stats_export_snapshot_t *snapshot = (stats_export_snapshot_t*)malloc(sizeof(stats_export_snapshot_t));
+    char                    *text     = (char*)malloc(STATS_EXPORT_PROMETHEUS_SIZE);
+    if(c_stats_export_read((stats_export_region_t*)shared.data, snapshot, null, STATS_MONITOR_READ_ATTEMPTS))
+    {
+        u32 text_length = c_stats_export_format_prometheus(snapshot, text, STATS_EXPORT_PROMETHEUS_SIZE);
+        if(text_length)
+        {
+            fwrite(text, 1, text_length, stdout);
+            result = 0;
+        }
+        else
+        {
+            log_error("The snapshot didn't fit in '%u' bytes of Prometheus text...\n", STATS_EXPORT_PROMETHEUS_SIZE);
+        }
+    }
+    else
+    {
+        log_error("'%s' hasn't published a frame yet...\n", name);
+    }
+
+    free(text);
+    free(snapshot);
+    sys_shared_memory_close(&shared);
+    return(result);
+}
+
+internal_api s32
+stats_monitor_tail(const char *name, u32 interval_ms, u64 line_count)
+{
+    sys_shared_memory_t      shared        = {};
+    stats_export_snapshot_t *snapshot      = (stats_export_snapshot_t*)malloc(sizeof(stats_export_snapshot_t));
+    u64                      last_sequence = 0;
+    float32                  stall_seconds = 0.0f;
+    bool8                    was_waiting   = false;
+
+    for(u64 lines_printed = 0; line_count == 0 || lines_printed < line_count;)
+    {
+        if(!shared.data)
+        {
+            if(c_stats_export_attach(&shared, name))
+            {
+                log_info("Attached to '%s'...\n", shared.name);
+                last_sequence = 0;
+                stall_seconds = 0.0f;
+                was_waiting   = false;
+            }
+            else if(!was_waiting)
+            {
+                log_info("Waiting for something to export stats as '%s'...\n", name);
+                was_waiting = true;
+            }
+        }
+
+        if(shared.data)
+        {
+            u64 sequence = 0;
+            if(c_stats_export_read((stats_export_region_t*)shared.data, snapshot, &sequence, STATS_MONITOR_READ_ATTEMPTS) &&
+               sequence != last_sequence)
+            {
+                stats_monitor_print_line(snapshot);
+                last_sequence = sequence;
+                stall_seconds = 0.0f;
+                ++lines_printed;
+            }
+            else
+            {
+                // NOTE(Sleepster): The engine exited (or hung), let go so a new one under the same name gets picked up.
+                stall_seconds += (float32)interval_ms / 1000.0f;
+                if(stall_seconds >= STATS_MONITOR_STALL_SECONDS)
+                {
+                    log_warning("No new frames from '%s' for '%.1f' seconds...\n", shared.name, stall_seconds);
+                    sys_shared_memory_close(&shared);
+                }
+            }
+        }
+
+        sys_sleep_ms(interval_ms);
+    }
+
+    sys_shared_memory_close(&shared);
+    free(snapshot);
+    return(0);
+}
+
+int
+main(int argc, char **argv)
+{
+    char  **name        = c_program_flag_add_string("name", (char*)STATS_EXPORT_DEFAULT_NAME, "The shared memory name the engine was given with '-stats_export'\n");
+    u64    *interval_ms = c_program_flag_add_size("interval_ms", 1000, "How often the tail looks for a new frame\n");
+    u64    *line_count  = c_program_flag_add_size("count", 0, "Stops tailing after this many lines, 0 is forever\n");
+    bool32 *prometheus  = c_program_flag_add_bool32("prometheus", false, "Prints the latest snapshot in Prometheus' text format and exits\n");
+    if(argc > 1) c_program_flag_parse_args(argc, argv);
+
+    s32 result = 0;
+    if(*prometheus) result = stats_monitor_prometheus(*name);
+    else            result = stats_monitor_tail(*name, (u32)Max(*interval_ms, 1), *line_count);
+
+    return(result);
+}
@@ -14,6 +14,8 @@
 
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/resource.h>
+#include <malloc.h>
 #include <sys/inotify.h>
 #include <dirent.h>
 #include <errno.h>
@@ -23,6 +25,12 @@
 #include <string.h> 
 #include <poll.h>
 #include <stdlib.h>
+#include <stdio.h>
+#include <sched.h>
+#include <limits.h>
+#include <time.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 
 void*
 sys_allocate_memory(usize allocation_size)
@@ -68,6 +76,28 @@ sys_free_memory(void *data, usize free_size)
     }
 }
 
+u64
+sys_get_peak_resident_bytes(void)
+{
+    u64 result = 0;
+
+    // NOTE(Sleepster): ru_maxrss is in kilobytes on Linux.
+    struct rusage usage = {};
+    if(getrusage(RUSAGE_SELF, &usage) == 0) result = (u64)usage.ru_maxrss * 1024;
+
+    return(result);
+}
+
+// NOTE(Sleepster): 'arena' is every arena's sbrk/mmap'd heap, 'hblkhd' the big allocations that got a mapping each.
+u64
+sys_get_heap_bytes(void)
+{
+    struct mallinfo2 info = mallinfo2();
+    u64 result = (u64)info.arena + (u64)info.hblkhd;
+
+    return(result);
+}
+
 //////////////////////
 // FILE IO STUFF
 /////////////////////
@@ -396,6 +426,26 @@ sys_file_exists(string_t filepath)
     return(result);
 }
 
+// NOTE(Sleepster): DONTNEED only drops clean pages, the sync makes sure there aren't any dirty ones left behind.
+bool8
+sys_file_drop_from_cache(string_t filepath)
+{
+    bool8 result = false;
+
+    char buffer[512];
+    sprintf(buffer, "%.*s", filepath.count, C_STR(filepath));
+
+    s32 file_descriptor = open(buffer, O_RDONLY);
+    if(file_descriptor >= 0)
+    {
+        fdatasync(file_descriptor);
+        result = posix_fadvise(file_descriptor, 0, 0, POSIX_FADV_DONTNEED) == 0;
+        close(file_descriptor);
+    }
+
+    return(result);
+}
+
 file_data_t
 sys_file_get_modtime_and_size(string_t filepath)
 {
@@ -515,6 +565,263 @@ sys_get_cpu_count()
     return(result);
 }
 
+/* NOTE(Sleepster): CPU topology comes straight out of sysfs, SDL only gives us a logical core count.
+ *
+ * /sys/devices/system/cpu/cpuN/topology/{core_id, physical_package_id, thread_siblings_list} for cores and SMT,
+ * /sys/devices/system/cpu/cpuN/cache/indexK/{level, shared_cpu_list} for the last level cache (the highest level),
+ * /sys/devices/system/cpu/cpuN/nodeM links for the NUMA node.
+ *
+ * If any of that is missing (containers, weird kernels) we fall back to a flat "every cpu is its own core" layout
+ * and return false.
+ */
+internal_api s32
+sys_linux_read_sysfs(const char *path, char *buffer, s32 buffer_size)
+{
+    s32 result = -1;
+    s32 file = open(path, O_RDONLY);
+    if(file >= 0)
+    {
+        ssize_t bytes_read = read(file, buffer, buffer_size - 1);
+        if(bytes_read >= 0)
+        {
+            buffer[bytes_read] = 0;
+            result = (s32)bytes_read;
+        }
+        close(file);
+    }
+
+    return(result);
+}
+
+internal_api bool8
+sys_linux_read_sysfs_u32(const char *path, u32 *value)
+{
+    bool8 result = false;
+    char buffer[64];
+    if(sys_linux_read_sysfs(path, buffer, sizeof(buffer)) > 0)
+    {
+        *value = (u32)strtoul(buffer, null, 10);
+        result = true;
+    }
+
+    return(result);
+}
+
+// NOTE(Sleepster): Kernel cpu lists look like "0-3,8,10-11\n".
+internal_api u32
+sys_linux_parse_cpu_list(const char *list, u32 *cpus, u32 max_cpus)
+{
+    u32 result = 0;
+    const char *cursor = list;
+    while(*cursor && *cursor != '\n')
+    {
+        char *after_first = null;
+        u32 first = (u32)strtoul(cursor, &after_first, 10);
+        if(after_first == cursor) break;
+
+        u32 last = first;
+        cursor   = after_first;
+        if(*cursor == '-')
+        {
+            last = (u32)strtoul(cursor + 1, &after_first, 10);
+            cursor = after_first;
+        }
+
+        for(u32 cpu = first;
+            cpu <= last && result < max_cpus;
+            ++cpu)
+        {
+            cpus[result++] = cpu;
+        }
+        if(*cursor == ',') ++cursor;
+    }
+
+    return(result);
+}
+
+// NOTE(Sleepster): Maps a sparse OS id onto a dense index, keys has to have room for SYS_MAX_LOGICAL_CPUS.
+internal_api u32
+sys_linux_dense_index(u64 *keys, u32 *key_count, u64 key)
+{
+    u32 result = *key_count;
+    for(u32 key_index = 0;
+        key_index < *key_count;
+        ++key_index)
+    {
+        if(keys[key_index] == key)
+        {
+            result = key_index;
+            break;
+        }
+    }
+
+    if(result == *key_count)
+    {
+        keys[result] = key;
+        *key_count  += 1;
+    }
+
+    return(result);
+}
+
+bool8
+sys_get_cpu_topology(sys_cpu_topology_t *topology)
+{
+    bool8 result = false;
+    ZeroStruct(*topology);
+
+    char buffer[1024];
+    char path[256];
+    u32  cpu_ids[SYS_MAX_LOGICAL_CPUS];
+    u32  cpu_count = 0;
+    if(sys_linux_read_sysfs("/sys/devices/system/cpu/online", buffer, sizeof(buffer)) > 0)
+    {
+        cpu_count = sys_linux_parse_cpu_list(buffer, cpu_ids, SYS_MAX_LOGICAL_CPUS);
+    }
+
+    if(cpu_count > 0)
+    {
+        u64 core_keys[SYS_MAX_LOGICAL_CPUS];
+        u64 package_keys[SYS_MAX_LOGICAL_CPUS];
+        u64 llc_keys[SYS_MAX_LOGICAL_CPUS];
+        u64 node_keys[SYS_MAX_LOGICAL_CPUS];
+        u32 core_count    = 0;
+        u32 package_count = 0;
+        u32 llc_count     = 0;
+        u32 node_count    = 0;
+
+        for(u32 cpu_index = 0;
+            cpu_index < cpu_count;
+            ++cpu_index)
+        {
+            u32 cpu_id = cpu_ids[cpu_index];
+            sys_logical_cpu_t *cpu = topology->cpus + cpu_index;
+            cpu->cpu_index = cpu_id;
+
+            u32 package_id = 0;
+            u32 core_id    = cpu_id;
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/physical_package_id", cpu_id);
+            sys_linux_read_sysfs_u32(path, &package_id);
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/core_id", cpu_id);
+            sys_linux_read_sysfs_u32(path, &core_id);
+
+            cpu->package_index = sys_linux_dense_index(package_keys, &package_count, package_id);
+            cpu->core_index    = sys_linux_dense_index(core_keys, &core_count, ((u64)package_id << 32) | core_id);
+
+            // NOTE(Sleepster): Our position in the sibling list is our SMT index, 0 is the "primary" thread.
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/thread_siblings_list", cpu_id);
+            if(sys_linux_read_sysfs(path, buffer, sizeof(buffer)) > 0)
+            {
+                u32 siblings[SYS_MAX_LOGICAL_CPUS];
+                u32 sibling_count = sys_linux_parse_cpu_list(buffer, siblings, SYS_MAX_LOGICAL_CPUS);
+                for(u32 sibling_index = 0;
+                    sibling_index < sibling_count;
+                    ++sibling_index)
+                {
+                    if(siblings[sibling_index] == cpu_id)
+                    {
+                        cpu->smt_index = sibling_index;
+                        break;
+                    }
+                }
+            }
+
+            // NOTE(Sleepster): The LLC group is keyed by the first cpu sharing it.
+            u32 llc_level = 0;
+            u64 llc_key   = ((u64)1 << 32) | package_id;
+            for(u32 cache_index = 0;
+                cache_index < 16;
+                ++cache_index)
+            {
+                u32 level = 0;
+                snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/level", cpu_id, cache_index);
+                if(!sys_linux_read_sysfs_u32(path, &level)) break;
+                if(level < llc_level) continue;
+
+                snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/shared_cpu_list", cpu_id, cache_index);
+                if(sys_linux_read_sysfs(path, buffer, sizeof(buffer)) > 0)
+                {
+                    u32 first_sharing_cpu = 0;
+                    if(sys_linux_parse_cpu_list(buffer, &first_sharing_cpu, 1) == 1)
+                    {
+                        llc_level = level;
+                        llc_key   = first_sharing_cpu;
+                    }
+                }
+            }
+            cpu->llc_index = sys_linux_dense_index(llc_keys, &llc_count, llc_key);
+
+            u32 node_id = 0;
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u", cpu_id);
+            DIR *cpu_directory = opendir(path);
+            if(cpu_directory)
+            {
+                struct dirent *entry;
+                while((entry = readdir(cpu_directory)))
+                {
+                    if(strncmp(entry->d_name, "node", 4) == 0 && entry->d_name[4] >= '0' && entry->d_name[4] <= '9')
+                    {
+                        node_id = (u32)strtoul(entry->d_name + 4, null, 10);
+                        break;
+                    }
+                }
+                closedir(cpu_directory);
+            }
+            cpu->numa_node = sys_linux_dense_index(node_keys, &node_count, node_id);
+        }
+
+        topology->logical_cpu_count   = cpu_count;
+        topology->physical_core_count = core_count;
+        topology->package_count       = package_count;
+        topology->llc_count           = llc_count;
+        topology->numa_node_count     = node_count;
+        result = true;
+    }
+    else
+    {
+        log_warning("Failed to read the CPU topology from sysfs, assuming a flat layout...\n");
+
+        s32 logical_cpu_count = sys_get_cpu_count();
+        if(logical_cpu_count < 1)                    logical_cpu_count = 1;
+        if(logical_cpu_count > SYS_MAX_LOGICAL_CPUS) logical_cpu_count = SYS_MAX_LOGICAL_CPUS;
+        for(s32 cpu_index = 0;
+            cpu_index < logical_cpu_count;
+            ++cpu_index)
+        {
+            topology->cpus[cpu_index].cpu_index  = cpu_index;
+            topology->cpus[cpu_index].core_index = cpu_index;
+        }
+
+        topology->logical_cpu_count   = logical_cpu_count;
+        topology->physical_core_count = logical_cpu_count;
+        topology->package_count       = 1;
+        topology->llc_count           = 1;
+        topology->numa_node_count     = 1;
+    }
+
+    return(result);
+}
+
+bool8
+sys_thread_pin_current(u32 cpu_index)
+{
+    bool8 result = false;
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu_index, &cpu_set);
+    if(sched_setaffinity(0, sizeof(cpu_set), &cpu_set) == 0)
+    {
+        result = true;
+    }
+    else
+    {
+        log_warning("Failed to pin thread to cpu '%u', errno: '%d'...\n", cpu_index, errno);
+    }
+
+    return(result);
+}
+
 sys_semaphore_t
 sys_semaphore_create(s32 initial_thread_count, s32 max_thread_count)
 {
@@ -620,6 +927,69 @@ sys_thread_close_handle(sys_thread_t *thread_data)
     return(true);
 }
 
+// NOTE(Sleepster): Only valid for threads created with close_handle == false.
+bool8
+sys_thread_join(sys_thread_t *thread_data)
+{
+    Assert(thread_data);
+
+    bool8 result = false;
+    if(thread_data->handle)
+    {
+        SDL_WaitThread(thread_data->handle, null);
+        thread_data->handle = null;
+        result = true;
+    }
+
+    return(result);
+}
+
+bool8
+sys_futex_wait(volatile u32 *address, u32 expected_value, u32 timeout_ms)
+{
+    bool8 result = true;
+
+    struct timespec  timeout;
+    struct timespec *timeout_pointer = null;
+    if(timeout_ms)
+    {
+        timeout.tv_sec  = timeout_ms / 1000;
+        timeout.tv_nsec = (timeout_ms % 1000) * 1000000;
+        timeout_pointer = &timeout;
+    }
+
+    // NOTE(Sleepster): EAGAIN (value already changed) and EINTR are just early wakeups.
+    long error = syscall(SYS_futex, (u32*)address, FUTEX_WAIT_PRIVATE, expected_value, timeout_pointer, null, 0);
+    if(error == -1 && errno == ETIMEDOUT)
+    {
+        result = false;
+    }
+
+    return(result);
+}
+
+void
+sys_futex_wake(volatile u32 *address, u32 wake_count)
+{
+    if(wake_count > INT_MAX) wake_count = INT_MAX;
+    syscall(SYS_futex, (u32*)address, FUTEX_WAKE_PRIVATE, wake_count, null, null, 0);
+}
+
+void
+sys_thread_yield()
+{
+    sched_yield();
+}
+
+void
+sys_sleep_ms(u32 milliseconds)
+{
+    struct timespec duration = {};
+    duration.tv_sec  = milliseconds / 1000;
+    duration.tv_nsec = (long)(milliseconds % 1000) * 1000000;
+    while(nanosleep(&duration, &duration) != 0 && errno == EINTR) {}
+}
+
 sys_mutex_t
 sys_mutex_create()
 {
@@ -661,6 +1031,630 @@ sys_mutex_unlock(sys_mutex_t *mutex)
     return(true);
 }
 
+/*===========================================
+  ================= SIGNALS =================
+  ===========================================*/
+#include <signal.h>
+
+global_variable volatile u32 *sys_dump_request_flag;
+
+internal_api void
+sys_dump_request_signal_handler(int signal_number)
+{
+    // NOTE(Sleepster): Signal handler, a store is all that's safe in here.
+    if(sys_dump_request_flag) *sys_dump_request_flag = 1;
+}
+
+// NOTE(Sleepster): 'kill -USR1 <pid>' sets *flag to 1, whoever owns the flag polls it and clears it.
+bool8
+sys_register_dump_request_flag(volatile u32 *flag)
+{
+    bool8 result = false;
+    sys_dump_request_flag = flag;
+
+    struct sigaction action = {};
+    action.sa_handler = sys_dump_request_signal_handler;
+    action.sa_flags   = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if(sigaction(SIGUSR1, &action, null) == 0)
+    {
+        result = true;
+    }
+    else
+    {
+        log_error("Failed to install the SIGUSR1 handler, error: '%s'...\n", strerror(errno));
+    }
+
+    return(result);
+}
+
+/*===========================================
+  ============== SHARED MEMORY ==============
+  ===========================================*/
+
+internal_api void
+sys_linux_shared_memory_name(sys_shared_memory_t *shared, const char *name)
+{
+    snprintf(shared->name, sizeof(shared->name), "/%s", name);
+}
+
+bool8
+sys_shared_memory_create(sys_shared_memory_t *shared, const char *name, usize size)
+{
+    bool8 result = false;
+    ZeroStruct(*shared);
+    sys_linux_shared_memory_name(shared, name);
+
+    s32 fd = shm_open(shared->name, O_CREAT|O_RDWR, 0644);
+    if(fd < 0)
+    {
+        log_error("Failed to create shared memory '%s', error: '%s'...\n", shared->name, strerror(errno));
+        return(result);
+    }
+
+    if(ftruncate(fd, (off_t)size) == 0)
+    {
+        void *data = mmap(null, size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+        if(data != MAP_FAILED)
+        {
+            // NOTE(Sleepster): A region left behind by a crash keeps its old contents at the same size.
+            memset(data, 0, size);
+            shared->data     = data;
+            shared->size     = size;
+            shared->is_owner = true;
+            result = true;
+        }
+        else
+        {
+            log_error("Failed to map shared memory '%s', error: '%s'...\n", shared->name, strerror(errno));
+        }
+    }
+    else
+    {
+        log_error("Failed to size shared memory '%s' to '%llu' bytes, error: '%s'...\n", shared->name, (unsigned long long)size, strerror(errno));
+    }
+    close(fd);
+
+    if(!result) shm_unlink(shared->name);
+    return(result);
+}
+
+bool8
+sys_shared_memory_open(sys_shared_memory_t *shared, const char *name)
+{
+    bool8 result = false;
+    ZeroStruct(*shared);
+    sys_linux_shared_memory_name(shared, name);
+
+    // NOTE(Sleepster): No log, "not there yet" is the normal answer for a reader that's waiting on the engine.
+    s32 fd = shm_open(shared->name, O_RDONLY, 0);
+    if(fd < 0) return(result);
+
+    struct stat region_stats;
+    if(fstat(fd, &region_stats) == 0 && region_stats.st_size > 0)
+    {
+        void *data = mmap(null, (usize)region_stats.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if(data != MAP_FAILED)
+        {
+            shared->data = data;
+            shared->size = (usize)region_stats.st_size;
+            result = true;
+        }
+    }
+    close(fd);
+
+    return(result);
+}
+
+void
+sys_shared_memory_close(sys_shared_memory_t *shared)
+{
+    if(shared->data)     munmap(shared->data, shared->size);
+    if(shared->is_owner) shm_unlink(shared->name);
+    ZeroStruct(*shared);
+}
+
+/*===========================================
+  ================ SAMPLING =================
+  ===========================================*/
+#include <ucontext.h>
+#include <link.h>
+
+#if !defined(sigev_notify_thread_id)
+    #define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+global_variable sys_sample_proc_t *sys_sample_proc;
+
+// NOTE(Sleepster): The stack the thread is running on right now, the thread's own or a fiber's. The frame walk
+//                  never reads outside of it, code built without frame pointers leaves anything in rbp.
+global_variable thread_local usize sys_linux_thread_stack_low;
+global_variable thread_local usize sys_linux_thread_stack_high;
+global_variable thread_local usize sys_linux_stack_low;
+global_variable thread_local usize sys_linux_stack_high;
+
+internal_api void
+sys_linux_sample_signal_handler(int signal_number, siginfo_t *signal_info, void *context)
+{
+    int saved_errno = errno;
+
+    ucontext_t *user_context  = (ucontext_t*)context;
+    usize       stack_pointer = (usize)user_context->uc_mcontext.gregs[REG_RSP];
+    usize       frame_pointer = (usize)user_context->uc_mcontext.gregs[REG_RBP];
+    usize       stack_low     = sys_linux_stack_low;
+    usize       stack_high    = sys_linux_stack_high;
+
+    u64 frames[SYS_SAMPLER_MAX_FRAMES];
+    u32 frame_count = 0;
+    frames[frame_count++] = (u64)user_context->uc_mcontext.gregs[REG_RIP];
+
+    if(stack_pointer >= stack_low && stack_pointer < stack_high)
+    {
+        while(frame_count < SYS_SAMPLER_MAX_FRAMES &&
+              frame_pointer >= stack_pointer       &&
+              frame_pointer + (2 * sizeof(u64)) <= stack_high &&
+              (frame_pointer & (sizeof(u64) - 1)) == 0)
+        {
+            u64 *frame          = (u64*)frame_pointer;
+            u64  return_address = frame[1];
+            if(!return_address) break;
+
+            frames[frame_count++] = return_address;
+            if(frame[0] <= frame_pointer) break;
+            frame_pointer = (usize)frame[0];
+        }
+    }
+
+    if(sys_sample_proc) sys_sample_proc(frames, frame_count);
+    errno = saved_errno;
+}
+
+bool8
+sys_sampler_install(sys_sample_proc_t *proc)
+{
+    bool8 result = false;
+    sys_sample_proc = proc;
+
+    struct sigaction action = {};
+    action.sa_sigaction = sys_linux_sample_signal_handler;
+    action.sa_flags     = SA_SIGINFO|SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if(sigaction(SIGPROF, &action, null) == 0)
+    {
+        result = true;
+    }
+    else
+    {
+        log_error("Failed to install the SIGPROF handler, error: '%s'...\n", strerror(errno));
+    }
+
+    return(result);
+}
+
+// NOTE(Sleepster): Has to be called on the thread itself.
+bool8
+sys_sampler_register_thread(sys_sampler_thread_t *thread)
+{
+    bool8 result = false;
+    ZeroStruct(*thread);
+    thread->thread_id = (pid_t)syscall(SYS_gettid);
+    thread->pthread   = pthread_self();
+
+    pthread_attr_t attributes;
+    if(pthread_getattr_np(thread->pthread, &attributes) == 0)
+    {
+        void   *stack_base = null;
+        size_t  stack_size = 0;
+        if(pthread_attr_getstack(&attributes, &stack_base, &stack_size) == 0)
+        {
+            sys_linux_thread_stack_low  = (usize)stack_base;
+            sys_linux_thread_stack_high = (usize)stack_base + stack_size;
+            sys_linux_stack_low         = sys_linux_thread_stack_low;
+            sys_linux_stack_high        = sys_linux_thread_stack_high;
+            result = true;
+        }
+        pthread_attr_destroy(&attributes);
+    }
+
+    if(!result) log_warning("Couldn't get the stack of thread '%d', its samples won't have call stacks...\n", thread->thread_id);
+    return(result);
+}
+
+// NOTE(Sleepster): Ticks on the thread's CPU time, a thread that's asleep doesn't get sampled.
+bool8
+sys_sampler_thread_start(sys_sampler_thread_t *thread, u32 frequency_hz)
+{
+    bool8 result = false;
+    Assert(frequency_hz > 0);
+
+    if(!thread->timer_created)
+    {
+        clockid_t clock_id;
+        s32 error = pthread_getcpuclockid(thread->pthread, &clock_id);
+        if(error != 0)
+        {
+            log_error("Failed to get the CPU clock of thread '%d', error: '%s'...\n", thread->thread_id, strerror(error));
+            return(result);
+        }
+
+        struct sigevent event = {};
+        event.sigev_notify           = SIGEV_THREAD_ID;
+        event.sigev_signo            = SIGPROF;
+        event.sigev_notify_thread_id = thread->thread_id;
+        if(timer_create(clock_id, &event, &thread->timer) != 0)
+        {
+            log_error("Failed to create the sampling timer of thread '%d', error: '%s'...\n", thread->thread_id, strerror(errno));
+            return(result);
+        }
+        thread->timer_created = true;
+    }
+
+    u64 interval_ns = 1000000000ULL / frequency_hz;
+    struct itimerspec timer_spec = {};
+    timer_spec.it_interval.tv_sec  = (time_t)(interval_ns / 1000000000ULL);
+    timer_spec.it_interval.tv_nsec = (long)(interval_ns % 1000000000ULL);
+    timer_spec.it_value            = timer_spec.it_interval;
+    if(timer_settime(thread->timer, 0, &timer_spec, null) == 0)
+    {
+        result = true;
+    }
+    else
+    {
+        log_error("Failed to arm the sampling timer of thread '%d', error: '%s'...\n", thread->thread_id, strerror(errno));
+    }
+
+    return(result);
+}
+
+void
+sys_sampler_thread_stop(sys_sampler_thread_t *thread)
+{
+    if(thread->timer_created)
+    {
+        timer_delete(thread->timer);
+        thread->timer_created = false;
+    }
+}
+
+struct sys_linux_module_list_t
+{
+    sys_module_t *modules;
+    u32           max_module_count;
+    u32           module_count;
+};
+
+internal_api int
+sys_linux_visit_module(struct dl_phdr_info *info, size_t info_size, void *user_data)
+{
+    sys_linux_module_list_t *list = (sys_linux_module_list_t*)user_data;
+    if(list->module_count >= list->max_module_count) return(1);
+
+    u64 start = ~0ULL;
+    u64 end   = 0;
+    for(u32 header_index = 0; header_index < info->dlpi_phnum; ++header_index)
+    {
+        const ElfW(Phdr) *header = info->dlpi_phdr + header_index;
+        if(header->p_type != PT_LOAD) continue;
+
+        if(header->p_vaddr < start)                  start = header->p_vaddr;
+        if(header->p_vaddr + header->p_memsz > end)  end   = header->p_vaddr + header->p_memsz;
+    }
+
+    if(end > start)
+    {
+        sys_module_t *module = list->modules + list->module_count++;
+        module->load_bias    = (u64)info->dlpi_addr;
+        module->start        = (u64)info->dlpi_addr + start;
+        module->end          = (u64)info->dlpi_addr + end;
+
+        // NOTE(Sleepster): The executable itself comes through without a name.
+        if(info->dlpi_name && info->dlpi_name[0])
+        {
+            snprintf(module->path, SYS_MODULE_MAX_PATH_LENGTH, "%s", info->dlpi_name);
+        }
+        else
+        {
+            ssize_t path_length = readlink("/proc/self/exe", module->path, SYS_MODULE_MAX_PATH_LENGTH - 1);
+            module->path[path_length > 0 ? path_length : 0] = 0;
+        }
+    }
+
+    return(0);
+}
+
+u32
+sys_get_loaded_modules(sys_module_t *modules, u32 max_module_count)
+{
+    sys_linux_module_list_t list = {};
+    list.modules          = modules;
+    list.max_module_count = max_module_count;
+    dl_iterate_phdr(sys_linux_visit_module, &list);
+
+    return(list.module_count);
+}
+
+/*===========================================
+  ============== PERF COUNTERS ==============
+  ===========================================*/
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+
+struct sys_linux_perf_event_t
+{
+    u32 type;
+    u64 config;
+};
+
+global_variable sys_linux_perf_event_t sys_linux_perf_events[SPCK_Count] =
+{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+};
+
+// NOTE(Sleepster): What read() gives back for a group with PERF_FORMAT_GROUP|ID|TOTAL_TIME_ENABLED|TOTAL_TIME_RUNNING.
+struct sys_linux_perf_group_read_t
+{
+    u64 counter_count;
+    u64 time_enabled;
+    u64 time_running;
+    struct
+    {
+        u64 value;
+        u64 id;
+    }counters[SPCK_Count];
+};
+
+/* NOTE(Sleepster): All of the counters go into one group so they're scheduled onto the PMU together and one read()
+ * gets all of them. The first counter that opens leads the group. A counter the machine doesn't have is left out,
+ * the rest still work, with no PMU at all (ENOENT in most VMs, EACCES with perf_event_paranoid > 2) nothing opens.
+ */
+bool8
+sys_perf_counters_open(sys_perf_counters_t *counters)
+{
+    ZeroStruct(*counters);
+    counters->group_fd = -1;
+
+    s32 first_error = 0;
+    for(u32 counter_index = 0; counter_index < SPCK_Count; ++counter_index)
+    {
+        counters->fds[counter_index] = -1;
+
+        struct perf_event_attr attributes = {};
+        attributes.size           = sizeof(attributes);
+        attributes.type           = sys_linux_perf_events[counter_index].type;
+        attributes.config         = sys_linux_perf_events[counter_index].config;
+        attributes.read_format    = PERF_FORMAT_GROUP|PERF_FORMAT_ID|PERF_FORMAT_TOTAL_TIME_ENABLED|PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv     = 1;
+
+        s32 fd = (s32)syscall(SYS_perf_event_open, &attributes, 0, -1, counters->group_fd, PERF_FLAG_FD_CLOEXEC);
+        if(fd < 0)
+        {
+            if(!first_error) first_error = errno;
+            continue;
+        }
+
+        if(ioctl(fd, PERF_EVENT_IOC_ID, &counters->ids[counter_index]) != 0)
+        {
+            if(!first_error) first_error = errno;
+            close(fd);
+            continue;
+        }
+
+        if(counters->group_fd < 0) counters->group_fd = fd;
+        counters->fds[counter_index] = fd;
+        counters->open_mask         |= 1 << counter_index;
+    }
+
+    // NOTE(Sleepster): Left in errno for whoever wants to say why, every thread opens its own so we don't log here.
+    bool8 result = counters->open_mask != 0;
+    errno = first_error;
+
+    return(result);
+}
+
+void
+sys_perf_counters_close(sys_perf_counters_t *counters)
+{
+    // NOTE(Sleepster): Members first, closing the leader doesn't take the rest of the group with it.
+    for(s32 counter_index = SPCK_Count - 1; counter_index >= 0; --counter_index)
+    {
+        if(counters->fds[counter_index] >= 0 && counters->fds[counter_index] != counters->group_fd)
+        {
+            close(counters->fds[counter_index]);
+        }
+    }
+    if(counters->group_fd >= 0) close(counters->group_fd);
+
+    ZeroStruct(*counters);
+    counters->group_fd = -1;
+}
+
+bool8
+sys_perf_counters_read(sys_perf_counters_t *counters, u64 *values_out)
+{
+    bool8 result = false;
+    if(counters->group_fd < 0) return(result);
+
+    sys_linux_perf_group_read_t group;
+    ssize_t bytes_read = read(counters->group_fd, &group, sizeof(group));
+    if(bytes_read < (ssize_t)(3 * sizeof(u64)) || group.counter_count > SPCK_Count) return(result);
+
+    // NOTE(Sleepster): Never got onto the PMU at all, there's nothing to scale.
+    if(group.time_running == 0) return(result);
+
+    for(u32 entry_index = 0; entry_index < group.counter_count; ++entry_index)
+    {
+        u64 value = group.counters[entry_index].value;
+        if(group.time_running < group.time_enabled)
+        {
+            value = (u64)((float64)value * ((float64)group.time_enabled / (float64)group.time_running));
+        }
+
+        for(u32 counter_index = 0; counter_index < SPCK_Count; ++counter_index)
+        {
+            if((counters->open_mask & (1 << counter_index)) && counters->ids[counter_index] == group.counters[entry_index].id)
+            {
+                values_out[counter_index] = value;
+                break;
+            }
+        }
+    }
+
+    result = true;
+    return(result);
+}
+
+/*===========================================
+  ================== FIBERS =================
+  ===========================================*/
+
+#if !ARCH_X64
+#error "Fibers are only implemented for x86-64 on Linux...\n"
+#endif
+
+// NOTE(Sleepster): Only the System V callee saved state gets saved: rbx, rbp, r12-r15, the x87 control word and MXCSR.
+//                  Everything else is caller saved, so whoever called sys_fiber_switch() has already spilled it.
+//
+//                  Frame layout, from the saved stack pointer up:
+//                  [0] x87 control word / MXCSR, [1] r15, [2] r14, [3] r13, [4] r12, [5] rbx, [6] rbp, [7] return address
+external void sys_linux_fiber_swap_context(void **save_stack_pointer, void *load_stack_pointer);
+external void sys_linux_fiber_trampoline();
+
+__asm__(
+    ".pushsection .text\n"
+    ".globl sys_linux_fiber_swap_context\n"
+    ".type  sys_linux_fiber_swap_context, @function\n"
+    "sys_linux_fiber_swap_context:\n"
+    "    pushq   %rbp\n"
+    "    pushq   %rbx\n"
+    "    pushq   %r12\n"
+    "    pushq   %r13\n"
+    "    pushq   %r14\n"
+    "    pushq   %r15\n"
+    "    subq    $8, %rsp\n"
+    "    fnstcw  (%rsp)\n"
+    "    stmxcsr 4(%rsp)\n"
+    "    movq    %rsp, (%rdi)\n"
+    "    movq    %rsi, %rsp\n"
+    "    fldcw   (%rsp)\n"
+    "    ldmxcsr 4(%rsp)\n"
+    "    addq    $8, %rsp\n"
+    "    popq    %r15\n"
+    "    popq    %r14\n"
+    "    popq    %r13\n"
+    "    popq    %r12\n"
+    "    popq    %rbx\n"
+    "    popq    %rbp\n"
+    "    ret\n"
+    ".size sys_linux_fiber_swap_context, .-sys_linux_fiber_swap_context\n"
+    "\n"
+    // NOTE(Sleepster): A fresh fiber "returns" here out of its first swap. r12 holds the sys_fiber_t.
+    ".globl sys_linux_fiber_trampoline\n"
+    ".type  sys_linux_fiber_trampoline, @function\n"
+    "sys_linux_fiber_trampoline:\n"
+    "    movq    %r12, %rdi\n"
+    "    call    sys_linux_fiber_start@PLT\n"
+    "    ud2\n"
+    ".size sys_linux_fiber_trampoline, .-sys_linux_fiber_trampoline\n"
+    ".popsection\n"
+);
+
+external void
+sys_linux_fiber_start(sys_fiber_t *fiber)
+{
+    fiber->proc(fiber->user_data);
+
+    log_fatal("A fiber proc returned, fibers have to switch away instead...\n");
+    InvalidCodePath;
+}
+
+bool8
+sys_fiber_create(sys_fiber_t *fiber, usize stack_size, sys_fiber_proc_t *proc, void *user_data)
+{
+    Assert(fiber);
+    Assert(proc);
+
+    bool8 result = false;
+
+    ZeroStruct(*fiber);
+    fiber->stack = sys_allocate_memory(stack_size);
+    if(fiber->stack)
+    {
+        fiber->stack_size = stack_size;
+        fiber->proc       = proc;
+        fiber->user_data  = user_data;
+
+        // NOTE(Sleepster): The trampoline's address sits 8 bytes under a 16 byte aligned top, so when it calls into
+        //                  sys_linux_fiber_start() the stack is aligned the way the ABI wants.
+        usize stack_top   = ((usize)fiber->stack + stack_size) & ~(usize)15;
+        u64  *frame       = (u64*)(stack_top - (8 * sizeof(u64)));
+        ((u16*)frame)[0]  = 0x037F;
+        ((u32*)frame)[1]  = 0x1F80;
+        frame[1]          = 0;
+        frame[2]          = 0;
+        frame[3]          = 0;
+        frame[4]          = (u64)fiber;
+        frame[5]          = 0;
+        frame[6]          = 0;
+        frame[7]          = (u64)&sys_linux_fiber_trampoline;
+
+        fiber->handle = frame;
+        result        = true;
+    }
+    else
+    {
+        log_error("Failed to allocate a '%llu' byte fiber stack...\n", (unsigned long long)stack_size);
+    }
+
+    return(result);
+}
+
+void
+sys_fiber_destroy(sys_fiber_t *fiber)
+{
+    Assert(fiber);
+    if(fiber->stack)
+    {
+        sys_free_memory(fiber->stack, fiber->stack_size);
+    }
+    ZeroStruct(*fiber);
+}
+
+// NOTE(Sleepster): Nothing to do on Linux, the thread's stack pointer gets saved into the handle on the first switch away.
+bool8
+sys_fiber_convert_thread(sys_fiber_t *fiber)
+{
+    Assert(fiber);
+    ZeroStruct(*fiber);
+
+    return(true);
+}
+
+void
+sys_fiber_convert_to_thread(sys_fiber_t *fiber)
+{
+    Assert(fiber);
+    ZeroStruct(*fiber);
+}
+
+void
+sys_fiber_switch(sys_fiber_t *from, sys_fiber_t *to)
+{
+    Assert(from);
+    Assert(to);
+    Assert(to->handle);
+
+    // NOTE(Sleepster): Before the swap, whatever runs on this thread next is on to's stack.
+    sys_linux_stack_low  = to->stack ? (usize)to->stack                  : sys_linux_thread_stack_low;
+    sys_linux_stack_high = to->stack ? (usize)to->stack + to->stack_size : sys_linux_thread_stack_high;
+
+    sys_linux_fiber_swap_context(&from->handle, to->handle);
+}
+
 /*===========================================
   =============== FILE WATCHER ==============
   ===========================================*/
@@ -26,6 +26,8 @@
 #include <dlfcn.h>
 #include <string.h> 
 #include <poll.h>
+#include <pthread.h>
+#include <time.h>
 
 #define INVALID_SOCKET      (-1)
 #define INVALID_FILE_HANDLE (-1)
@@ -56,6 +58,24 @@ typedef struct file_watcher_watch_data
     u32                         directory_data_count;
 }file_watcher_sys_watch_data_t;
 
+typedef struct sys_sampler_thread
+{
+    pid_t     thread_id;
+    pthread_t pthread;
+    timer_t   timer;
+    bool8     timer_created;
+}sys_sampler_thread_t;
+
+#define SYS_PERF_MAX_COUNTERS (8)
+
+typedef struct sys_perf_counters
+{
+    s32 group_fd;
+    s32 fds[SYS_PERF_MAX_COUNTERS];
+    u64 ids[SYS_PERF_MAX_COUNTERS];
+    u32 open_mask;
+}sys_perf_counters_t;
+
 #define PLATFORM_THREAD_PROC(name) int name(void *user_data)
 typedef PLATFORM_THREAD_PROC(thread_proc_t);
 
@@ -16,6 +16,9 @@
 #include <c_globals.h>
 #include <c_dynarray.h>
 
+#include <errno.h>
+#include <psapi.h>
+
 // TODO(Sleepster): UNICODE 
 
 typedef struct multithreading_work_queue_manager multithreading_work_queue_manager_t;
@@ -48,6 +51,30 @@ sys_allocate_memory(usize allocation_size)
     return(result);
 }
 
+u64
+sys_get_peak_resident_bytes(void)
+{
+    u64 result = 0;
+
+    PROCESS_MEMORY_COUNTERS counters = {};
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) result = (u64)counters.PeakWorkingSetSize;
+
+    return(result);
+}
+
+// NOTE(Sleepster): The CRT's malloc lives in the process heap.
+u64
+sys_get_heap_bytes(void)
+{
+    u64 result = 0;
+
+    HEAP_SUMMARY summary = {};
+    summary.cb = sizeof(summary);
+    if(HeapSummary(GetProcessHeap(), 0, &summary)) result = (u64)summary.cbCommitted;
+
+    return(result);
+}
+
 void
 sys_free_memory(void *data, usize free_size)
 {
@@ -286,6 +313,13 @@ sys_file_exists(string_t filepath)
     return(result);
 }
 
+// NOTE(Sleepster): There's no per file version of this that doesn't need admin, the standby list keeps it.
+bool8
+sys_file_drop_from_cache(string_t filepath)
+{
+    return(false);
+}
+
 file_data_t
 sys_file_get_modtime_and_size(string_t filepath)
 {
@@ -487,6 +521,143 @@ sys_get_cpu_count()
     return(system_info.dwNumberOfProcessors);
 }
 
+// NOTE(Sleepster): Processor group 0 only (64 logical processors), which is all that SetThreadAffinityMask can see anyway.
+bool8
+sys_get_cpu_topology(sys_cpu_topology_t *topology)
+{
+    bool8 result = false;
+    ZeroStruct(*topology);
+
+    DWORD buffer_size = 0;
+    GetLogicalProcessorInformationEx(RelationAll, null, &buffer_size);
+
+    byte *buffer = buffer_size ? (byte*)sys_allocate_memory(buffer_size) : null;
+    if(buffer && GetLogicalProcessorInformationEx(RelationAll, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buffer, &buffer_size))
+    {
+        u32 cpu_slots[64];
+        memset(cpu_slots, 0xFF, sizeof(cpu_slots));
+
+        // NOTE(Sleepster): Cores first, so every logical processor has a slot before the other relations show up.
+        for(DWORD offset = 0; offset < buffer_size;)
+        {
+            PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buffer + offset);
+            if(info->Relationship == RelationProcessorCore && info->Processor.GroupMask[0].Group == 0)
+            {
+                KAFFINITY mask = info->Processor.GroupMask[0].Mask;
+                u32 smt_index  = 0;
+                for(u32 bit = 0; bit < 64; ++bit)
+                {
+                    if(mask & ((KAFFINITY)1 << bit))
+                    {
+                        u32 slot = topology->logical_cpu_count++;
+                        cpu_slots[bit] = slot;
+                        topology->cpus[slot].cpu_index  = bit;
+                        topology->cpus[slot].core_index = topology->physical_core_count;
+                        topology->cpus[slot].smt_index  = smt_index++;
+                    }
+                }
+                topology->physical_core_count += 1;
+            }
+            offset += info->Size;
+        }
+
+        for(DWORD offset = 0; offset < buffer_size;)
+        {
+            PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buffer + offset);
+
+            KAFFINITY mask  = 0;
+            u32       value = 0;
+            switch(info->Relationship)
+            {
+                case RelationProcessorPackage:
+                {
+                    if(info->Processor.GroupMask[0].Group == 0) mask = info->Processor.GroupMask[0].Mask;
+                    value = topology->package_count++;
+                }break;
+                case RelationNumaNode:
+                {
+                    if(info->NumaNode.GroupMask.Group == 0) mask = info->NumaNode.GroupMask.Mask;
+                    value = topology->numa_node_count++;
+                }break;
+                case RelationCache:
+                {
+                    if(info->Cache.Level == 3 && info->Cache.GroupMask.Group == 0)
+                    {
+                        mask  = info->Cache.GroupMask.Mask;
+                        value = topology->llc_count++;
+                    }
+                }break;
+            }
+
+            for(u32 bit = 0; mask && bit < 64; ++bit)
+            {
+                if((mask & ((KAFFINITY)1 << bit)) && cpu_slots[bit] != 0xFFFFFFFF)
+                {
+                    sys_logical_cpu_t *cpu = topology->cpus + cpu_slots[bit];
+                    switch(info->Relationship)
+                    {
+                        case RelationProcessorPackage: cpu->package_index = value; break;
+                        case RelationNumaNode:         cpu->numa_node     = value; break;
+                        case RelationCache:            cpu->llc_index     = value; break;
+                    }
+                }
+            }
+            offset += info->Size;
+        }
+
+        if(topology->package_count   == 0) topology->package_count   = 1;
+        if(topology->numa_node_count == 0) topology->numa_node_count = 1;
+        if(topology->llc_count       == 0) topology->llc_count       = 1;
+        result = topology->logical_cpu_count > 0;
+    }
+
+    if(buffer)
+    {
+        sys_free_memory(buffer, buffer_size);
+    }
+
+    if(!result)
+    {
+        log_warning("Failed to query the CPU topology, assuming a flat layout...\n");
+        ZeroStruct(*topology);
+
+        s32 logical_cpu_count = sys_get_cpu_count();
+        if(logical_cpu_count < 1)                    logical_cpu_count = 1;
+        if(logical_cpu_count > SYS_MAX_LOGICAL_CPUS) logical_cpu_count = SYS_MAX_LOGICAL_CPUS;
+        for(s32 cpu_index = 0;
+            cpu_index < logical_cpu_count;
+            ++cpu_index)
+        {
+            topology->cpus[cpu_index].cpu_index  = cpu_index;
+            topology->cpus[cpu_index].core_index = cpu_index;
+        }
+
+        topology->logical_cpu_count   = logical_cpu_count;
+        topology->physical_core_count = logical_cpu_count;
+        topology->package_count       = 1;
+        topology->llc_count           = 1;
+        topology->numa_node_count     = 1;
+    }
+
+    return(result);
+}
+
+bool8
+sys_thread_pin_current(u32 cpu_index)
+{
+    bool8 result = false;
+    if(cpu_index < 64 && SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu_index))
+    {
+        result = true;
+    }
+    else
+    {
+        log_warning("Failed to pin thread to cpu '%u'...\n", cpu_index);
+    }
+
+    return(result);
+}
+
 sys_semaphore_t
 sys_semaphore_create(s32 initial_thread_count, s32 max_thread_count)
 {
@@ -585,6 +756,55 @@ sys_thread_close_handle(sys_thread_t *thread_data)
     return(result);
 }
 
+// NOTE(Sleepster): Only valid for threads created with close_handle == false.
+bool8
+sys_thread_join(sys_thread_t *thread_data)
+{
+    Assert(thread_data);
+
+    bool8 result = false;
+    if(thread_data->handle)
+    {
+        WaitForSingleObject(thread_data->handle, INFINITE);
+        result = CloseHandle(thread_data->handle);
+        thread_data->handle = null;
+    }
+
+    return(result);
+}
+
+bool8
+sys_futex_wait(volatile u32 *address, u32 expected_value, u32 timeout_ms)
+{
+    bool8 result = true;
+    if(!WaitOnAddress((volatile VOID*)address, &expected_value, sizeof(u32), timeout_ms ? timeout_ms : INFINITE))
+    {
+        result = GetLastError() != ERROR_TIMEOUT;
+    }
+
+    return(result);
+}
+
+// NOTE(Sleepster): WaitOnAddress only has "one" or "everybody", anything more than one wakes everybody.
+void
+sys_futex_wake(volatile u32 *address, u32 wake_count)
+{
+    if(wake_count == 1) WakeByAddressSingle((PVOID)address);
+    else                WakeByAddressAll((PVOID)address);
+}
+
+void
+sys_thread_yield()
+{
+    SwitchToThread();
+}
+
+void
+sys_sleep_ms(u32 milliseconds)
+{
+    Sleep(milliseconds);
+}
+
 sys_mutex_t
 sys_mutex_create()
 {
@@ -649,6 +869,257 @@ sys_mutex_unlock(sys_mutex_t *mutex)
     return(result);
 }
 
+/*===========================================
+  ================= SIGNALS =================
+  ===========================================*/
+
+global_variable volatile u32 *sys_dump_request_flag;
+
+internal_api BOOL WINAPI
+sys_dump_request_console_handler(DWORD control_type)
+{
+    BOOL result = FALSE;
+    if(control_type == CTRL_BREAK_EVENT && sys_dump_request_flag)
+    {
+        *sys_dump_request_flag = 1;
+        result = TRUE;
+    }
+
+    return(result);
+}
+
+// NOTE(Sleepster): No SIGUSR1 here, Ctrl+Break in the console sets *flag to 1 instead.
+bool8
+sys_register_dump_request_flag(volatile u32 *flag)
+{
+    sys_dump_request_flag = flag;
+
+    bool8 result = SetConsoleCtrlHandler(sys_dump_request_console_handler, TRUE) != 0;
+    if(!result) log_error("Failed to install the console control handler...\n");
+
+    return(result);
+}
+
+/*===========================================
+  ============== SHARED MEMORY ==============
+  ===========================================*/
+
+// NOTE(Sleepster): A pagefile backed mapping, it goes away with the last handle to it so there's nothing to unlink.
+bool8
+sys_shared_memory_create(sys_shared_memory_t *shared, const char *name, usize size)
+{
+    bool8 result = false;
+    ZeroStruct(*shared);
+    snprintf(shared->name, sizeof(shared->name), "Local\\%s", name);
+
+    shared->handle = CreateFileMappingA(INVALID_HANDLE_VALUE, null, PAGE_READWRITE, (DWORD)((u64)size >> 32), (DWORD)size, shared->name);
+    if(shared->handle)
+    {
+        shared->data = MapViewOfFile(shared->handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+        if(shared->data)
+        {
+            memset(shared->data, 0, size);
+            shared->size     = size;
+            shared->is_owner = true;
+            result = true;
+        }
+    }
+    if(!result)
+    {
+        log_error("Failed to create shared memory '%s', error: '%lu'...\n", shared->name, GetLastError());
+        sys_shared_memory_close(shared);
+    }
+
+    return(result);
+}
+
+bool8
+sys_shared_memory_open(sys_shared_memory_t *shared, const char *name)
+{
+    bool8 result = false;
+    ZeroStruct(*shared);
+    snprintf(shared->name, sizeof(shared->name), "Local\\%s", name);
+
+    shared->handle = OpenFileMappingA(FILE_MAP_READ, FALSE, shared->name);
+    if(shared->handle)
+    {
+        shared->data = MapViewOfFile(shared->handle, FILE_MAP_READ, 0, 0, 0);
+        MEMORY_BASIC_INFORMATION region_info = {};
+        if(shared->data && VirtualQuery(shared->data, &region_info, sizeof(region_info)))
+        {
+            shared->size = region_info.RegionSize;
+            result = true;
+        }
+    }
+    if(!result) sys_shared_memory_close(shared);
+
+    return(result);
+}
+
+void
+sys_shared_memory_close(sys_shared_memory_t *shared)
+{
+    if(shared->data)   UnmapViewOfFile(shared->data);
+    if(shared->handle) CloseHandle(shared->handle);
+    ZeroStruct(*shared);
+}
+
+/*===========================================
+  ================ SAMPLING =================
+  ===========================================*/
+
+// TODO(Sleepster): Win32 has no SIGPROF, this wants a thread that suspends the others and walks them with
+//                  GetThreadContext(). Until then the sampler just won't start.
+bool8
+sys_sampler_install(sys_sample_proc_t *proc)
+{
+    log_warning("The sampling profiler isn't implemented on Windows...\n");
+    return(false);
+}
+
+bool8
+sys_sampler_register_thread(sys_sampler_thread_t *thread)
+{
+    ZeroStruct(*thread);
+    thread->thread_id = GetCurrentThreadId();
+
+    return(true);
+}
+
+bool8
+sys_sampler_thread_start(sys_sampler_thread_t *thread, u32 frequency_hz)
+{
+    return(false);
+}
+
+void
+sys_sampler_thread_stop(sys_sampler_thread_t *thread)
+{
+}
+
+u32
+sys_get_loaded_modules(sys_module_t *modules, u32 max_module_count)
+{
+    return(0);
+}
+
+/*===========================================
+  ============== PERF COUNTERS ==============
+  ===========================================*/
+
+// TODO(Sleepster): Windows only hands these out through ETW or a driver. Everything that uses them already copes
+//                  with not having any.
+bool8
+sys_perf_counters_open(sys_perf_counters_t *counters)
+{
+    ZeroStruct(*counters);
+    errno = ENOSYS;
+
+    return(false);
+}
+
+void
+sys_perf_counters_close(sys_perf_counters_t *counters)
+{
+    ZeroStruct(*counters);
+}
+
+bool8
+sys_perf_counters_read(sys_perf_counters_t *counters, u64 *values_out)
+{
+    return(false);
+}
+
+/*===========================================
+  ================== FIBERS =================
+  ===========================================*/
+
+internal_api VOID WINAPI
+sys_win32_fiber_start(void *user_data)
+{
+    sys_fiber_t *fiber = (sys_fiber_t*)user_data;
+    fiber->proc(fiber->user_data);
+
+    log_fatal("A fiber proc returned, fibers have to switch away instead...\n");
+    InvalidCodePath;
+}
+
+bool8
+sys_fiber_create(sys_fiber_t *fiber, usize stack_size, sys_fiber_proc_t *proc, void *user_data)
+{
+    Assert(fiber);
+    Assert(proc);
+
+    bool8 result = false;
+
+    ZeroStruct(*fiber);
+    fiber->stack_size = stack_size;
+    fiber->proc       = proc;
+    fiber->user_data  = user_data;
+    fiber->handle     = CreateFiber(stack_size, sys_win32_fiber_start, fiber);
+    if(fiber->handle)
+    {
+        result = true;
+    }
+    else
+    {
+        log_error("Failed to create a fiber... Error: '%d'\n", GetLastError());
+    }
+
+    return(result);
+}
+
+void
+sys_fiber_destroy(sys_fiber_t *fiber)
+{
+    Assert(fiber);
+    if(fiber->handle)
+    {
+        DeleteFiber(fiber->handle);
+    }
+    ZeroStruct(*fiber);
+}
+
+bool8
+sys_fiber_convert_thread(sys_fiber_t *fiber)
+{
+    Assert(fiber);
+
+    bool8 result = false;
+
+    ZeroStruct(*fiber);
+    fiber->handle = ConvertThreadToFiber(null);
+    if(fiber->handle)
+    {
+        result = true;
+    }
+    else
+    {
+        log_error("Failed to convert the thread to a fiber... Error: '%d'\n", GetLastError());
+    }
+
+    return(result);
+}
+
+void
+sys_fiber_convert_to_thread(sys_fiber_t *fiber)
+{
+    Assert(fiber);
+
+    ConvertFiberToThread();
+    ZeroStruct(*fiber);
+}
+
+// NOTE(Sleepster): Windows tracks the current fiber for us, from is only here to match Linux.
+void
+sys_fiber_switch(sys_fiber_t *from, sys_fiber_t *to)
+{
+    Assert(to);
+    Assert(to->handle);
+
+    SwitchToFiber(to->handle);
+}
+
 /*===========================================
   =============== FILE WATCHER ==============
   ===========================================*/
@@ -42,6 +42,18 @@ typedef struct file_watcher_watch_data
     u32                         directory_data_count;
 }file_watcher_sys_watch_data_t;
 
+typedef struct sys_sampler_thread
+{
+    u32 thread_id;
+}sys_sampler_thread_t;
+
+#define SYS_PERF_MAX_COUNTERS (8)
+
+typedef struct sys_perf_counters
+{
+    u32 open_mask;
+}sys_perf_counters_t;
+
 #define PLATFORM_THREAD_PROC(name) DWORD WINAPI name(void *user_data)
 typedef PLATFORM_THREAD_PROC(thread_proc_t);
 
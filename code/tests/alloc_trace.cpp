@@ -0,0 +1,250 @@
+/* ========================================================================
+   $File: alloc_trace.cpp $
+   $Date: October 19 2026 10:50 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_alloc_tracker.h>
+#include <c_alloc_tracker.cpp>
+#include <c_alloc_trace.h>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_alloc_trace.cpp>
+
+#define TEST_TRACE_PATH      "test_alloc_trace.atrc"
+#define TEST_REPLAY_COUNT    (100)
+
+internal_api alloc_trace_record_t
+test_make_record(u32 op, u64 id, u64 size)
+{
+    alloc_trace_record_t result = {};
+    result.op              = (u8)op;
+    result.kind            = ASK_Zone;
+    result.alignment_shift = 4;
+    result.id              = id;
+    result.size            = size;
+
+    return(result);
+}
+
+// NOTE(Sleepster): Every alloc is freed exactly once by the end, frees only ever name ids that came before them.
+internal_api bool8
+test_capture()
+{
+    bool8 result = true;
+    result &= c_alloc_trace_start(STR(TEST_TRACE_PATH));
+
+    memory_arena_t    arena = c_arena_create(KB(64));
+    zone_allocator_t *zone  = c_za_create(MB(1));
+    for(u32 frame_index = 0; frame_index < 2; ++frame_index)
+    {
+        c_arena_push_size(&arena, 100);
+        scratch_arena_t scratch = c_arena_begin_temporary_memory(&arena);
+        c_arena_push_size(&arena, 200);
+        c_arena_push_size(&arena, 300);
+        c_arena_end_temporary_memory(&scratch);
+        c_alloc_trace_frame_end();
+    }
+
+    byte *texture = c_za_alloc(zone, 1000, ZA_TAG_TEXTURE);
+    byte *sound   = c_za_alloc(zone, 2000, ZA_TAG_SOUND);
+    c_za_free(zone, texture);
+
+    // NOTE(Sleepster): The grow out of the initial size is a free and an alloc.
+    u32 *values = c_dynarray_create(u32);
+    for(u32 value = 0; value < 100; ++value) c_dynarray_push(values, value);
+    c_dynarray_destroy(values);
+
+    c_za_destroy(zone);
+    c_arena_destroy(&arena);
+    c_alloc_trace_stop();
+    result &= !c_alloc_trace_is_running() && alloc_tracker_hook == null;
+
+    alloc_trace_t trace = {};
+    result &= c_alloc_trace_load(STR(TEST_TRACE_PATH), &trace);
+    result &= trace.frame_count == 2 && trace.alloc_count == trace.free_count && trace.alloc_count >= 10;
+    result &= trace.header.ticks_per_second > 0 && trace.max_id == trace.alloc_count;
+
+    u8   *freed        = (u8*)calloc(1, trace.max_id + 1);
+    u32   arena_allocs = 0;
+    u32   arena_owner  = 0;
+    u32   zone_owner   = 0;
+    bool8 ordered      = true;
+    bool8 found_tag    = false;
+    u64   last_ticks   = 0;
+    for(u64 record_index = 0; record_index < trace.record_count; ++record_index)
+    {
+        alloc_trace_record_t *record = trace.records + record_index;
+        ordered   &= record->ticks >= last_ticks;
+        last_ticks = record->ticks;
+        if(record->op == ATO_Alloc)
+        {
+            if(record->kind == ASK_Arena)
+            {
+                ++arena_allocs;
+                arena_owner = record->owner;
+                ordered    &= record->alignment_shift == 4;
+            }
+            if(record->kind == ASK_Zone)
+            {
+                zone_owner = record->owner;
+                found_tag |= record->tag == ZA_TAG_TEXTURE && record->size == 1000;
+            }
+            if(record->kind == ASK_Dynarray) ordered &= record->owner == 0 && record->alignment_shift >= 3;
+        }
+        else if(record->op == ATO_Free)
+        {
+            ordered &= record->id <= trace.max_id && !freed[record->id];
+            freed[record->id] = 1;
+        }
+    }
+    free(freed);
+
+    result &= ordered && found_tag && arena_allocs == 6;
+    result &= arena_owner != 0 && zone_owner != 0 && arena_owner != zone_owner;
+    result &= trace.peak_live_bytes >= 3000;
+
+    c_alloc_trace_free(&trace);
+    remove(TEST_TRACE_PATH);
+
+    printf("capture: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+// NOTE(Sleepster): Every other block freed leaves the zone's span where it was with half of it live.
+internal_api bool8
+test_replay()
+{
+    bool8 result = true;
+
+    alloc_trace_t trace = {};
+    trace.records = (alloc_trace_record_t*)calloc(TEST_REPLAY_COUNT * 2 + 1, sizeof(alloc_trace_record_t));
+    for(u64 id = 1; id <= TEST_REPLAY_COUNT; ++id)
+    {
+        trace.records[trace.record_count++] = test_make_record(ATO_Alloc, id, KB(1));
+    }
+    for(u64 id = 1; id <= TEST_REPLAY_COUNT; id += 2)
+    {
+        trace.records[trace.record_count++] = test_make_record(ATO_Free, id, 0);
+    }
+    trace.records[trace.record_count++] = test_make_record(ATO_Frame, 0, 0);
+    for(u64 id = 2; id <= TEST_REPLAY_COUNT; id += 2)
+    {
+        trace.records[trace.record_count++] = test_make_record(ATO_Free, id, 0);
+    }
+    trace.max_id          = TEST_REPLAY_COUNT;
+    trace.peak_live_bytes = KB(1) * TEST_REPLAY_COUNT;
+
+    alloc_replay_result_t zone = {};
+    result &= c_alloc_replay_run(&trace, c_alloc_replay_get_zone_backend(), null, &zone);
+    c_alloc_replay_log(&zone);
+    result &= zone.alloc_count == TEST_REPLAY_COUNT && zone.free_count == TEST_REPLAY_COUNT && zone.failed_count == 0;
+    result &= zone.peak_live_bytes == KB(1) * TEST_REPLAY_COUNT && zone.sample_count == 2;
+    result &= zone.samples[0].live_bytes == KB(1) * (TEST_REPLAY_COUNT / 2) && zone.samples[0].frame_index == 0;
+    result &= zone.samples[0].fragmentation > 0.45f && zone.samples[0].fragmentation < 0.55f;
+    result &= zone.peak_footprint_bytes >= KB(1) * TEST_REPLAY_COUNT;
+    result &= zone.samples[1].footprint_bytes == 0 && zone.final_fragmentation == 0.0f;
+    result &= zone.ops_per_second > 0.0;
+
+    // NOTE(Sleepster): Masked out, nothing gets played but the samples still happen.
+    alloc_replay_config_t config = {};
+    config.kind_mask = 1u << ASK_Arena;
+    alloc_replay_result_t masked = {};
+    result &= c_alloc_replay_run(&trace, c_alloc_replay_get_zone_backend(), &config, &masked);
+    result &= masked.alloc_count == 0 && masked.free_count == 0 && masked.sample_count == 2;
+
+    alloc_replay_result_t heap = {};
+    result &= c_alloc_replay_run(&trace, c_alloc_replay_get_malloc_backend(), null, &heap);
+    c_alloc_replay_log(&heap);
+    result &= heap.alloc_count == TEST_REPLAY_COUNT && heap.free_count == TEST_REPLAY_COUNT && heap.failed_count == 0;
+
+    const char *csv_path = "test_alloc_replay.csv";
+    alloc_replay_result_t results[2] = {zone, heap};
+    result &= c_alloc_replay_dump_csv(results, 2, STR(csv_path));
+
+    u32 line_count = 0;
+    FILE *file = fopen(csv_path, "rb");
+    if(file)
+    {
+        char line[256];
+        while(fgets(line, sizeof(line), file)) ++line_count;
+        fclose(file);
+    }
+    remove(csv_path);
+    result &= line_count == 5;
+
+    c_alloc_replay_free_result(&zone);
+    c_alloc_replay_free_result(&masked);
+    c_alloc_replay_free_result(&heap);
+    free(trace.records);
+
+    printf("replay: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+// NOTE(Sleepster): The tracker and a capture share the hook, each passes the events on to the other.
+internal_api bool8
+test_chain()
+{
+    bool8 result = true;
+
+    c_alloc_tracker_start();
+    result &= c_alloc_trace_start(STR(TEST_TRACE_PATH));
+
+    memory_arena_t arena = c_arena_create(KB(64));
+    u32 push_line = __LINE__; c_arena_push_size(&arena, 64);
+
+    alloc_site_t site = {};
+    result &= c_alloc_tracker_get_site(__FILE__, push_line, &site) && site.total_count == 1;
+
+    // NOTE(Sleepster): Stopped out of order, the capture keeps passing events to the tracker.
+    c_alloc_tracker_stop();
+    c_alloc_tracker_start();
+    push_line = __LINE__; c_arena_push_size(&arena, 64);
+    result &= c_alloc_tracker_get_site(__FILE__, push_line, &site) && site.total_count == 1;
+
+    c_alloc_trace_stop();
+    c_alloc_tracker_stop();
+    result &= alloc_tracker_hook == null;
+
+    alloc_trace_t trace = {};
+    result &= c_alloc_trace_load(STR(TEST_TRACE_PATH), &trace);
+    result &= trace.alloc_count == 2 && trace.free_count == 0;
+
+    c_alloc_trace_free(&trace);
+    c_arena_destroy(&arena);
+    remove(TEST_TRACE_PATH);
+
+    printf("chain: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+int
+main(void)
+{
+    bool8 passed = test_capture();
+    passed &= test_replay();
+    passed &= test_chain();
+
+    Assert(passed);
+    return(0);
+}
@@ -0,0 +1,244 @@
+/* ========================================================================
+   $File: alloc_tracker.cpp $
+   $Date: October 19 2026 03:40 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_alloc_tracker.h>
+#include <c_alloc_tracker.cpp>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+
+#define TEST_FRAME_COUNT (10)
+
+internal_api bool8
+test_get_site(u32 line, alloc_site_t *site)
+{
+    bool8 result = c_alloc_tracker_get_site(__FILE__, line, site);
+    return(result);
+}
+
+// NOTE(Sleepster): One site pushes every frame and never gives it back, the other only pushes into temporary memory.
+internal_api bool8
+test_arena()
+{
+    bool8 result = true;
+    c_alloc_tracker_start();
+
+    memory_arena_t arena = c_arena_create(MB(1));
+    u32 growing_line     = 0;
+    u32 scratch_line     = 0;
+    for(u32 frame_index = 0; frame_index < TEST_FRAME_COUNT; ++frame_index)
+    {
+        growing_line = __LINE__; c_arena_push_size(&arena, KB(1));
+
+        scratch_arena_t scratch = c_arena_begin_temporary_memory(&arena);
+        scratch_line = __LINE__; c_arena_push_size(&arena, 512);
+        c_arena_end_temporary_memory(&scratch);
+
+        c_alloc_tracker_frame_end();
+    }
+
+    alloc_site_t growing = {};
+    alloc_site_t scratch = {};
+    result &= test_get_site(growing_line, &growing);
+    result &= test_get_site(scratch_line, &scratch);
+    result &= growing.kind == ASK_Arena && growing.total_count == TEST_FRAME_COUNT;
+    result &= growing.live_bytes == KB(1) * TEST_FRAME_COUNT && growing.free_count == 0;
+    result &= growing.last_frame_bytes == KB(1) && growing.peak_frame_bytes == KB(1);
+    result &= c_alloc_tracker_get_bytes_per_frame(&growing) == (float64)KB(1);
+    result &= scratch.live_bytes == 0 && scratch.live_count == 0;
+    result &= scratch.free_count == TEST_FRAME_COUNT && scratch.peak_live_bytes == 512;
+
+    // NOTE(Sleepster): Spilling into a second block and freeing it gives those pushes back too.
+    u32 big_line = __LINE__; c_arena_push_size(&arena, MB(2));
+    c_arena_reset(&arena);
+
+    alloc_site_t big = {};
+    result &= test_get_site(big_line, &big);
+    result &= test_get_site(growing_line, &growing);
+    result &= big.live_bytes == 0 && big.free_count == 1 && big.peak_live_bytes == MB(2);
+    result &= growing.live_bytes == 0 && growing.free_count == TEST_FRAME_COUNT;
+
+    c_arena_destroy(&arena);
+    c_alloc_tracker_stop();
+
+    printf("arena: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+internal_api bool8
+test_zone()
+{
+    bool8 result = true;
+    c_alloc_tracker_start();
+
+    zone_allocator_t *zone = c_za_create(MB(1));
+    byte *allocations[3];
+    u32   alloc_line = 0;
+    for(u32 alloc_index = 0; alloc_index < ArrayCount(allocations); ++alloc_index)
+    {
+        alloc_line = __LINE__; allocations[alloc_index] = c_za_alloc(zone, 100, ZA_TAG_STATIC);
+    }
+    c_za_free(zone, allocations[0]);
+    c_za_free(zone, allocations[1]);
+
+    alloc_site_t site = {};
+    result &= test_get_site(alloc_line, &site);
+    result &= site.kind == ASK_Zone && site.total_count == 3 && site.total_bytes == 300;
+    result &= site.live_count == 1 && site.live_bytes == 100 && site.free_count == 2;
+    result &= site.peak_live_bytes == 300;
+
+    // NOTE(Sleepster): Whatever the zone still had goes with it.
+    c_za_destroy(zone);
+    result &= test_get_site(alloc_line, &site);
+    result &= site.live_count == 0 && site.live_bytes == 0 && site.free_count == 3;
+
+    c_alloc_tracker_stop();
+
+    printf("zone: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+internal_api bool8
+test_dynarray()
+{
+    bool8 result = true;
+    c_alloc_tracker_start();
+
+    u32  create_line = __LINE__; u32 *values = c_dynarray_create(u32);
+    for(u32 value = 0; value < 100; ++value)
+    {
+        c_dynarray_push(values, value);
+    }
+
+    dynarray_header_t *header = _dynarray_header(values);
+    u64 expected_bytes        = (header->capacity * sizeof(u32)) + sizeof(dynarray_header_t);
+
+    // NOTE(Sleepster): The grows are the same array, still one allocation from the line that created it.
+    alloc_site_t site = {};
+    result &= test_get_site(create_line, &site);
+    result &= site.kind == ASK_Dynarray && site.total_count == 1 && site.free_count == 0;
+    result &= site.live_count == 1 && site.live_bytes == expected_bytes && site.peak_live_bytes == expected_bytes;
+
+    c_dynarray_destroy(values);
+    result &= test_get_site(create_line, &site);
+    result &= site.live_count == 0 && site.live_bytes == 0 && site.free_count == 1;
+
+    c_alloc_tracker_stop();
+
+    printf("dynarray: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+// NOTE(Sleepster): Stopped keeps its numbers and adds nothing, frees of things it never saw are ignored.
+internal_api bool8
+test_stopped()
+{
+    bool8 result = true;
+
+    memory_arena_t arena = c_arena_create(KB(64));
+    u32 *untracked = c_dynarray_create(u32);
+    c_alloc_tracker_start();
+
+    u32 tracked_line   = __LINE__; c_arena_push_size(&arena, 64);
+    u32 untracked_line = 0;
+    c_dynarray_destroy(untracked);
+    c_alloc_tracker_stop();
+    result &= !c_alloc_tracker_is_running();
+
+    c_arena_reset(&arena);
+    for(u32 push_index = 0; push_index < 2; ++push_index)
+    {
+        untracked_line = __LINE__; c_arena_push_size(&arena, 64);
+    }
+
+    alloc_site_t site = {};
+    result &= test_get_site(tracked_line, &site);
+    result &= site.total_count == 1 && site.live_bytes == 64 && site.free_count == 0;
+    result &= !test_get_site(untracked_line, &site);
+
+    alloc_site_t sites[8];
+    result &= c_alloc_tracker_get_sites(sites, ArrayCount(sites)) == 1;
+
+    c_arena_destroy(&arena);
+
+    printf("stopped: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+// NOTE(Sleepster): The leak shows up in the never freed list, the CSV has a row per site.
+internal_api bool8
+test_report()
+{
+    bool8 result = true;
+    c_alloc_tracker_start();
+
+    memory_arena_t arena = c_arena_create(MB(1));
+    zone_allocator_t *zone = c_za_create(KB(64));
+    for(u32 frame_index = 0; frame_index < TEST_FRAME_COUNT; ++frame_index)
+    {
+        c_arena_push_size(&arena, KB(4));
+        c_za_free(zone, c_za_alloc(zone, 256, ZA_TAG_STATIC));
+        c_alloc_tracker_frame_end();
+    }
+    c_alloc_tracker_log(8);
+
+    const char *csv_path = "test_alloc_sites.csv";
+    result &= c_alloc_tracker_dump_csv(STR(csv_path));
+
+    u32 line_count = 0;
+    u32 arena_rows = 0;
+    FILE *file = fopen(csv_path, "rb");
+    if(file)
+    {
+        char line[1024];
+        while(fgets(line, sizeof(line), file))
+        {
+            ++line_count;
+            if(strstr(line, ",arena,40960,10,")) ++arena_rows;
+        }
+        fclose(file);
+    }
+    remove(csv_path);
+    result &= line_count == 3 && arena_rows == 1;
+
+    c_za_destroy(zone);
+    c_arena_destroy(&arena);
+    c_alloc_tracker_stop();
+
+    printf("report: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+int
+main(void)
+{
+    bool8 passed = test_arena();
+    passed &= test_zone();
+    passed &= test_dynarray();
+    passed &= test_stopped();
+    passed &= test_report();
+
+    Assert(passed);
+    return(0);
+}
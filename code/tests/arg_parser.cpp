@@ -18,6 +18,8 @@
 #include <p_platform_data.cpp>
 #include <c_memory_arena.cpp>
 #include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
 #include <c_string.cpp>
 #include <c_dynarray_impl.cpp>
 #include <c_globals.cpp>
@@ -16,6 +16,8 @@
 #include <c_file_api.cpp>
 #include <c_file_watcher.cpp>
 #include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
 
 internal_api void *
 get_chunk_data(byte *iterator, u32 chunk_size)
@@ -0,0 +1,176 @@
+/* ========================================================================
+   $File: flight_recorder.cpp $
+   $Date: October 19 2026 09:10 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdlib.h>
+#include <stdio.h>
+#include <signal.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_memory_telemetry.h>
+#include <c_memory_telemetry.cpp>
+#include <c_flight_recorder.h>
+#include <c_flight_recorder.cpp>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+
+internal_api u32
+test_count_lines(const char *path, const char *needle)
+{
+    u32 result = 0;
+
+    FILE *file = fopen(path, "rb");
+    if(file)
+    {
+        char line[16384];
+        while(fgets(line, sizeof(line), file))
+        {
+            if(!needle || strstr(line, needle)) ++result;
+        }
+        fclose(file);
+    }
+
+    return(result);
+}
+
+internal_api void
+test_wait_for_writer(flight_recorder_t *recorder)
+{
+    while(AtomicLoad32(&recorder->writer_busy)) sys_thread_yield();
+    sys_thread_join(&recorder->writer_thread);
+}
+
+internal_api void
+test_frame(flight_recorder_t *recorder, memory_arena_t *arena, float32 frame_ms)
+{
+    {
+        PROFILE_SCOPE("test_frame");
+        PROFILE_SCOPE("test_work");
+        c_arena_push_size(arena, KB(1));
+    }
+    PROFILE_FRAME_END();
+    c_memory_telemetry_frame_end();
+
+    flight_recorder_frame_stats_t stats = {};
+    stats.frame_ms          = frame_ms;
+    stats.threadpool_queued = 7;
+    c_flight_recorder_frame_end(recorder, &stats);
+}
+
+// NOTE(Sleepster): A hitch dumps once, the next one inside the cooldown doesn't, neither do the warmup frames.
+internal_api bool8
+test_hitch()
+{
+    bool8 result = true;
+
+    memory_arena_t arena = c_arena_create(MB(4));
+    c_memory_telemetry_register_arena("flight_arena", &arena);
+
+    flight_recorder_t recorder = {};
+    flight_recorder_config_t config = {};
+    config.seconds          = 1.0f;
+    config.hitch_ms         = 20.0f;
+    config.cooldown_seconds = 60.0f;
+    config.base_path        = "test_flight";
+    c_flight_recorder_init(&recorder, &config);
+    result &= recorder.frame_capacity == 256;
+
+    test_frame(&recorder, &arena, 100.0f);
+    for(u32 frame_index = 0; frame_index < 299; ++frame_index)
+    {
+        test_frame(&recorder, &arena, 5.0f);
+    }
+    result &= recorder.dump_index == 0;
+
+    test_frame(&recorder, &arena, 40.0f);
+    result &= recorder.dump_index == 1;
+    test_wait_for_writer(&recorder);
+
+    test_frame(&recorder, &arena, 40.0f);
+    result &= recorder.dump_index == 1;
+
+    result &= test_count_lines("test_flight_0.json", "\"reason\":\"hitch\",\"trigger_frame\":300,") == 1;
+    result &= test_count_lines("test_flight_0.json", "{\"frame\":") == 256;
+    result &= test_count_lines("test_flight_0.json", "\"threadpool_queued\":7,") == 256;
+    result &= test_count_lines("test_flight_0.json", "\"memory_delta\":1024,") >= 255;
+#if PROFILER_ENABLED
+    result &= test_count_lines("test_flight_0.json", "\"name\":\"test_work\"") == 256;
+#endif
+
+    c_flight_recorder_destroy(&recorder);
+    c_memory_telemetry_unregister(&arena);
+    c_arena_destroy(&arena);
+    remove("test_flight_0.json");
+
+    printf("hitch: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+// NOTE(Sleepster): A dump request skips the warmup and the cooldown, it's somebody asking.
+internal_api bool8
+test_request()
+{
+    bool8 result = true;
+
+    memory_arena_t arena = c_arena_create(MB(1));
+    flight_recorder_t recorder = {};
+    flight_recorder_config_t config = {};
+    config.base_path = "test_flight_request";
+    c_flight_recorder_init(&recorder, &config);
+
+    for(u32 frame_index = 0; frame_index < 10; ++frame_index)
+    {
+        test_frame(&recorder, &arena, 5.0f);
+    }
+#if OS_LINUX
+    raise(SIGUSR1);
+#else
+    recorder.dump_requested = 1;
+#endif
+    test_frame(&recorder, &arena, 5.0f);
+    result &= recorder.dump_index == 1;
+    test_wait_for_writer(&recorder);
+
+    result &= c_flight_recorder_dump(&recorder, "manual");
+    test_wait_for_writer(&recorder);
+    result &= recorder.dump_index == 2;
+
+    result &= test_count_lines("test_flight_request_0.json", "\"reason\":\"request\"") == 1;
+    result &= test_count_lines("test_flight_request_0.json", "{\"frame\":") == 11;
+    result &= test_count_lines("test_flight_request_1.json", "\"reason\":\"manual\"") == 1;
+
+    c_flight_recorder_destroy(&recorder);
+    c_arena_destroy(&arena);
+    remove("test_flight_request_0.json");
+    remove("test_flight_request_1.json");
+
+    printf("request: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+int
+main(void)
+{
+    bool8 passed = test_hitch();
+    passed &= test_request();
+
+    Assert(passed);
+    return(0);
+}
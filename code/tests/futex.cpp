@@ -0,0 +1,255 @@
+/* ========================================================================
+   $File: futex.cpp $
+   $Date: October 18 2026 08:40 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_futex.h>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+
+#define TEST_THREAD_COUNT      (8)
+#define TEST_MUTEX_ITERATIONS  (100000)
+#define TEST_SEMAPHORE_ITEMS   (20000)
+#define TEST_PING_PONG_ROUNDS  (20000)
+#define TEST_RWLOCK_ITERATIONS (20000)
+
+struct test_state_t
+{
+    futex_mutex_t      mutex;
+    u64                mutex_counter;
+
+    futex_semaphore_t  semaphore;
+    volatile u32       items_consumed;
+
+    futex_event_t      start_event;
+    volatile u32       threads_started;
+
+    futex_auto_event_t ping;
+    futex_auto_event_t pong;
+    u32                ping_pong_value;
+
+    futex_rwlock_t     rwlock;
+    u64                protected_values[2];
+    volatile u32       torn_reads;
+};
+
+global_variable test_state_t test_state;
+
+PLATFORM_THREAD_PROC(test_mutex_proc)
+{
+    for(u32 iteration = 0;
+        iteration < TEST_MUTEX_ITERATIONS;
+        ++iteration)
+    {
+        c_futex_mutex_lock(&test_state.mutex);
+        test_state.mutex_counter += 1;
+        c_futex_mutex_unlock(&test_state.mutex);
+    }
+
+    return(0);
+}
+
+PLATFORM_THREAD_PROC(test_consumer_proc)
+{
+    for(u32 item_index = 0;
+        item_index < TEST_SEMAPHORE_ITEMS;
+        ++item_index)
+    {
+        c_futex_semaphore_wait(&test_state.semaphore);
+        AtomicIncrement32(&test_state.items_consumed);
+    }
+
+    return(0);
+}
+
+PLATFORM_THREAD_PROC(test_event_proc)
+{
+    c_futex_event_wait(&test_state.start_event);
+    AtomicIncrement32(&test_state.threads_started);
+
+    return(0);
+}
+
+PLATFORM_THREAD_PROC(test_pong_proc)
+{
+    for(u32 round = 0;
+        round < TEST_PING_PONG_ROUNDS;
+        ++round)
+    {
+        c_futex_auto_event_wait(&test_state.ping);
+        test_state.ping_pong_value += 1;
+        c_futex_auto_event_signal(&test_state.pong);
+    }
+
+    return(0);
+}
+
+PLATFORM_THREAD_PROC(test_reader_proc)
+{
+    for(u32 iteration = 0;
+        iteration < TEST_RWLOCK_ITERATIONS;
+        ++iteration)
+    {
+        c_futex_rwlock_read_lock(&test_state.rwlock);
+        if(test_state.protected_values[0] != test_state.protected_values[1])
+        {
+            AtomicIncrement32(&test_state.torn_reads);
+        }
+        c_futex_rwlock_read_unlock(&test_state.rwlock);
+    }
+
+    return(0);
+}
+
+PLATFORM_THREAD_PROC(test_writer_proc)
+{
+    for(u32 iteration = 0;
+        iteration < TEST_RWLOCK_ITERATIONS / 4;
+        ++iteration)
+    {
+        c_futex_rwlock_write_lock(&test_state.rwlock);
+        test_state.protected_values[0] += 1;
+        test_state.protected_values[1] += 1;
+        c_futex_rwlock_write_unlock(&test_state.rwlock);
+    }
+
+    return(0);
+}
+
+internal_api void
+test_run_threads(thread_proc_t *proc, u32 thread_count)
+{
+    sys_thread_t threads[TEST_THREAD_COUNT];
+    for(u32 thread_index = 0;
+        thread_index < thread_count;
+        ++thread_index)
+    {
+        threads[thread_index] = sys_thread_create(proc, null, false);
+    }
+    for(u32 thread_index = 0;
+        thread_index < thread_count;
+        ++thread_index)
+    {
+        sys_thread_join(&threads[thread_index]);
+    }
+}
+
+int
+main(void)
+{
+    bool8 passed = true;
+
+    test_run_threads(test_mutex_proc, TEST_THREAD_COUNT);
+    printf("mutex: '%llu', expected '%llu'\n",
+           (unsigned long long)test_state.mutex_counter, (unsigned long long)TEST_THREAD_COUNT * TEST_MUTEX_ITERATIONS);
+    passed &= test_state.mutex_counter == (u64)TEST_THREAD_COUNT * TEST_MUTEX_ITERATIONS;
+    passed &= c_futex_mutex_try_lock(&test_state.mutex);
+    passed &= !c_futex_mutex_try_lock(&test_state.mutex);
+    c_futex_mutex_unlock(&test_state.mutex);
+
+    // NOTE(Sleepster): Consumers start before anything is released so they actually end up sleeping.
+    sys_thread_t consumers[TEST_THREAD_COUNT / 2];
+    for(u32 consumer_index = 0;
+        consumer_index < ArrayCount(consumers);
+        ++consumer_index)
+    {
+        consumers[consumer_index] = sys_thread_create(test_consumer_proc, null, false);
+    }
+    for(u32 item_index = 0;
+        item_index < ArrayCount(consumers) * TEST_SEMAPHORE_ITEMS;
+        item_index += 4)
+    {
+        c_futex_semaphore_release(&test_state.semaphore, 4);
+    }
+    for(u32 consumer_index = 0;
+        consumer_index < ArrayCount(consumers);
+        ++consumer_index)
+    {
+        sys_thread_join(&consumers[consumer_index]);
+    }
+    printf("semaphore: '%u' consumed, expected '%u'\n", test_state.items_consumed, (u32)ArrayCount(consumers) * TEST_SEMAPHORE_ITEMS);
+    passed &= test_state.items_consumed == ArrayCount(consumers) * TEST_SEMAPHORE_ITEMS;
+    passed &= !c_futex_semaphore_try_wait(&test_state.semaphore);
+    passed &= !c_futex_semaphore_wait(&test_state.semaphore, 10);
+
+    sys_thread_t waiters[TEST_THREAD_COUNT];
+    for(u32 waiter_index = 0;
+        waiter_index < TEST_THREAD_COUNT;
+        ++waiter_index)
+    {
+        waiters[waiter_index] = sys_thread_create(test_event_proc, null, false);
+    }
+    passed &= !c_futex_event_is_signaled(&test_state.start_event);
+    passed &= test_state.threads_started == 0;
+    c_futex_event_signal(&test_state.start_event);
+    for(u32 waiter_index = 0;
+        waiter_index < TEST_THREAD_COUNT;
+        ++waiter_index)
+    {
+        sys_thread_join(&waiters[waiter_index]);
+    }
+    c_futex_event_wait(&test_state.start_event);
+    printf("event: '%u' threads released\n", test_state.threads_started);
+    passed &= test_state.threads_started == TEST_THREAD_COUNT;
+
+    sys_thread_t pong_thread = sys_thread_create(test_pong_proc, null, false);
+    for(u32 round = 0;
+        round < TEST_PING_PONG_ROUNDS;
+        ++round)
+    {
+        c_futex_auto_event_signal(&test_state.ping);
+        c_futex_auto_event_wait(&test_state.pong);
+        if(test_state.ping_pong_value != round + 1)
+        {
+            passed = false;
+            break;
+        }
+    }
+    sys_thread_join(&pong_thread);
+    printf("auto event: '%u' round trips\n", test_state.ping_pong_value);
+    passed &= test_state.ping_pong_value == TEST_PING_PONG_ROUNDS;
+
+    sys_thread_t rwlock_threads[TEST_THREAD_COUNT];
+    for(u32 thread_index = 0;
+        thread_index < TEST_THREAD_COUNT;
+        ++thread_index)
+    {
+        rwlock_threads[thread_index] = sys_thread_create((thread_index & 3) == 0 ? test_writer_proc : test_reader_proc, null, false);
+    }
+    for(u32 thread_index = 0;
+        thread_index < TEST_THREAD_COUNT;
+        ++thread_index)
+    {
+        sys_thread_join(&rwlock_threads[thread_index]);
+    }
+    u64 expected_writes = (TEST_THREAD_COUNT / 4) * (TEST_RWLOCK_ITERATIONS / 4);
+    printf("rwlock: '%llu' writes, expected '%llu', '%u' torn reads\n",
+           (unsigned long long)test_state.protected_values[0], (unsigned long long)expected_writes, test_state.torn_reads);
+    passed &= test_state.protected_values[0] == expected_writes;
+    passed &= test_state.torn_reads == 0;
+    passed &= test_state.rwlock.state == 0;
+
+    printf("futex primitives: %s\n", passed ? "passed" : "FAILED");
+    Assert(passed);
+    return(0);
+}
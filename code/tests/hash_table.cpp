@@ -26,6 +26,8 @@
 #include <c_file_api.cpp>
 #include <c_file_watcher.cpp>
 #include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
 
 struct thing
 {
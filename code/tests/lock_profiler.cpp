@@ -0,0 +1,256 @@
+/* ========================================================================
+   $File: lock_profiler.cpp $
+   $Date: October 19 2026 05:50 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_lock_profiler.h>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+
+#define TEST_ACQUIRE_COUNT (1000)
+
+struct test_lock_state_t
+{
+    profiled_mutex_t     mutex;
+    profiled_semaphore_t semaphore;
+    volatile u32         is_waiting;
+    volatile u32         wait_line;
+};
+
+global_variable test_lock_state_t test_state;
+
+#if PROFILER_ENABLED
+
+// NOTE(Sleepster): No sleep in the platform layer, yield until the time's up so the other thread gets to block.
+internal_api void
+test_wait_ms(float64 milliseconds)
+{
+    u64 end = rdtsc() + (u64)(milliseconds * c_profiler_get_ticks_per_ms());
+    while(rdtsc() < end) sys_thread_yield();
+}
+
+internal_api bool8
+test_uncontended()
+{
+    bool8 result = true;
+
+    profiled_mutex_t mutex = {};
+    for(u32 acquire_index = 0; acquire_index < TEST_ACQUIRE_COUNT; ++acquire_index)
+    {
+        c_profiled_mutex_lock(&mutex);
+        c_profiled_mutex_unlock(&mutex);
+    }
+    result &= c_profiled_mutex_try_lock(&mutex);
+    result &= !c_profiled_mutex_try_lock(&mutex);
+    c_profiled_mutex_unlock(&mutex);
+
+    // NOTE(Sleepster): A failed try_lock isn't an acquire, and isn't a wait either.
+    result &= mutex.stats.acquire_count == TEST_ACQUIRE_COUNT + 1;
+    result &= mutex.stats.contended_count == 0 && mutex.stats.wait_ticks == 0;
+    result &= mutex.stats.hold_samples == (TEST_ACQUIRE_COUNT + 1) / LOCK_PROFILER_HOLD_SAMPLE_RATE;
+    result &= mutex.stats.max_hold_ticks <= mutex.stats.hold_ticks;
+
+    printf("uncontended: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+internal_api u32
+test_contended_proc(void *user_data)
+{
+    test_state.wait_line = __LINE__; AtomicExchange32(&test_state.is_waiting, 1); c_profiled_mutex_lock(&test_state.mutex);
+    c_profiled_mutex_unlock(&test_state.mutex);
+
+    return(0);
+}
+
+// NOTE(Sleepster): Main holds the lock while the thread asks for it, so its acquire can only be the contended kind.
+internal_api bool8
+test_contended()
+{
+    bool8 result = true;
+    ZeroStruct(test_state);
+    c_lock_profiler_register_mutex("test_mutex", &test_state.mutex);
+
+    c_profiled_mutex_lock(&test_state.mutex);
+    sys_thread_t thread = sys_thread_create(test_contended_proc, null, false);
+    while(!AtomicLoad32(&test_state.is_waiting)) sys_thread_yield();
+    test_wait_ms(20.0);
+    c_profiled_mutex_unlock(&test_state.mutex);
+    sys_thread_join(&thread);
+
+    lock_stats_t stats = {};
+    result &= c_lock_profiler_get_stats("test_mutex", &stats) == 1;
+    result &= stats.acquire_count == 2 && stats.contended_count == 1;
+    result &= stats.max_wait_ticks > 0 && stats.wait_ticks == stats.max_wait_ticks;
+    result &= stats.wait_sites[0].line == test_state.wait_line && stats.wait_sites[0].wait_count == 1;
+    result &= strcmp(stats.wait_sites[0].file, __FILE__) == 0;
+    result &= stats.wait_sites[1].file == null && stats.dropped_site_waits == 0;
+
+    // NOTE(Sleepster): It waited for at least most of the 20ms main spent holding the lock.
+    float64 wait_ms = (float64)stats.max_wait_ticks / c_profiler_get_ticks_per_ms();
+    result &= wait_ms > 10.0;
+
+    c_lock_profiler_log();
+    c_lock_profiler_unregister(&test_state.mutex);
+    result &= c_lock_profiler_get_stats("test_mutex", &stats) == 0 && stats.acquire_count == 0;
+
+    printf("contended: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+// NOTE(Sleepster): Locks with one name report as one, wait sites from each of them are merged.
+internal_api bool8
+test_aggregate()
+{
+    bool8 result = true;
+
+    profiled_mutex_t mutexes[3] = {};
+    for(u32 mutex_index = 0; mutex_index < ArrayCount(mutexes); ++mutex_index)
+    {
+        profiled_mutex_t *mutex = mutexes + mutex_index;
+        c_lock_profiler_register_mutex("test_zones", mutex);
+        for(u32 acquire_index = 0; acquire_index <= mutex_index; ++acquire_index)
+        {
+            c_profiled_mutex_lock(mutex);
+            c_profiled_mutex_unlock(mutex);
+        }
+        c_lock_stats_record_wait(&mutex->stats, __FILE__, 42, 100 * (mutex_index + 1));
+    }
+
+    lock_stats_t stats = {};
+    result &= c_lock_profiler_get_stats("test_zones", &stats) == 3;
+    result &= stats.acquire_count == 6 && stats.contended_count == 3;
+    result &= stats.wait_ticks == 600 && stats.max_wait_ticks == 300;
+    result &= stats.wait_sites[0].line == 42 && stats.wait_sites[0].wait_count == 3 && stats.wait_sites[0].wait_ticks == 600;
+    result &= stats.wait_sites[1].file == null;
+
+    c_lock_profiler_unregister(mutexes + 1);
+    result &= c_lock_profiler_get_stats("test_zones", &stats) == 2 && stats.acquire_count == 4;
+    c_lock_profiler_unregister(mutexes + 0);
+    c_lock_profiler_unregister(mutexes + 2);
+    result &= c_lock_profiler_get_stats("test_zones", &stats) == 0;
+
+    printf("aggregate: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+// NOTE(Sleepster): Past LOCK_PROFILER_MAX_WAIT_SITES the waits still count, only their site is lost.
+internal_api bool8
+test_site_overflow()
+{
+    bool8 result = true;
+
+    lock_stats_t stats = {};
+    for(u32 site_index = 0; site_index < LOCK_PROFILER_MAX_WAIT_SITES + 2; ++site_index)
+    {
+        c_lock_stats_record_wait(&stats, __FILE__, site_index + 1, 10);
+    }
+    result &= stats.contended_count == LOCK_PROFILER_MAX_WAIT_SITES + 2;
+    result &= stats.wait_ticks == 10 * (LOCK_PROFILER_MAX_WAIT_SITES + 2);
+    result &= stats.dropped_site_waits == 2;
+    result &= stats.wait_sites[LOCK_PROFILER_MAX_WAIT_SITES - 1].line == LOCK_PROFILER_MAX_WAIT_SITES;
+
+    printf("site overflow: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+internal_api u32
+test_semaphore_proc(void *user_data)
+{
+    AtomicExchange32(&test_state.is_waiting, 1);
+    c_profiled_semaphore_wait(&test_state.semaphore);
+
+    return(0);
+}
+
+// NOTE(Sleepster): A wait on a semaphore with a count left isn't contended, one that has to sleep for the release is.
+internal_api bool8
+test_semaphore()
+{
+    bool8 result = true;
+    ZeroStruct(test_state);
+    c_lock_profiler_register_semaphore("test_semaphore", &test_state.semaphore);
+
+    c_profiled_semaphore_release(&test_state.semaphore, 2);
+    c_profiled_semaphore_wait(&test_state.semaphore);
+    c_profiled_semaphore_wait(&test_state.semaphore);
+
+    sys_thread_t thread = sys_thread_create(test_semaphore_proc, null, false);
+    while(!AtomicLoad32(&test_state.is_waiting)) sys_thread_yield();
+    test_wait_ms(20.0);
+    c_profiled_semaphore_release(&test_state.semaphore);
+    sys_thread_join(&thread);
+
+    lock_stats_t stats = {};
+    result &= c_lock_profiler_get_stats("test_semaphore", &stats) == 1;
+    result &= stats.acquire_count == 3 && stats.contended_count == 1;
+    result &= stats.hold_samples == 0 && stats.wait_sites[0].wait_count == 1;
+
+    c_lock_profiler_log();
+    c_lock_profiler_unregister(&test_state.semaphore);
+
+    printf("semaphore: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+int
+main(void)
+{
+    bool8 passed = test_uncontended();
+    passed &= test_contended();
+    passed &= test_aggregate();
+    passed &= test_site_overflow();
+    passed &= test_semaphore();
+
+    Assert(passed);
+    return(0);
+}
+
+#else
+
+// NOTE(Sleepster): Compiled out the wrappers are still locks, they just don't keep anything.
+int
+main(void)
+{
+    bool8 passed = true;
+
+    c_lock_profiler_register_mutex("test_mutex", &test_state.mutex);
+    c_profiled_mutex_lock(&test_state.mutex);
+    passed &= !c_profiled_mutex_try_lock(&test_state.mutex);
+    c_profiled_mutex_unlock(&test_state.mutex);
+    passed &= c_profiled_mutex_try_lock(&test_state.mutex);
+    c_profiled_mutex_unlock(&test_state.mutex);
+
+    c_profiled_semaphore_release(&test_state.semaphore);
+    c_profiled_semaphore_wait(&test_state.semaphore);
+
+    lock_stats_t stats = {};
+    passed &= c_lock_profiler_get_stats("test_mutex", &stats) == 0;
+    c_lock_profiler_log();
+    printf("profiler is compiled out (PROFILER_ENABLED=0), only the locks are tested...\n");
+
+    Assert(passed);
+    return(0);
+}
+
+#endif // PROFILER_ENABLED
@@ -0,0 +1,216 @@
+/* ========================================================================
+   $File: memory_telemetry.cpp $
+   $Date: October 19 2026 03:40 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_memory_telemetry.h>
+#include <c_memory_telemetry.cpp>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+
+#define TEST_ZONE_HEADER_SIZE (sizeof(zone_allocator_block_t))
+
+internal_api u32
+test_count_lines(const char *path, const char *needle)
+{
+    u32 result = 0;
+
+    FILE *file = fopen(path, "rb");
+    if(file)
+    {
+        char line[4096];
+        while(fgets(line, sizeof(line), file))
+        {
+            if(!needle || strstr(line, needle)) ++result;
+        }
+        fclose(file);
+    }
+
+    return(result);
+}
+
+// NOTE(Sleepster): Current goes down with the blocks, peak and committed never do.
+internal_api bool8
+test_arena()
+{
+    bool8 result = true;
+
+    memory_arena_t arena = c_arena_create(MB(1));
+    c_memory_telemetry_register_arena("test_arena", &arena);
+
+    memory_telemetry_sample_t sample = {};
+    c_arena_push_size(&arena, KB(300));
+    c_memory_telemetry_frame_end();
+    result &= c_memory_telemetry_get_sample(&arena, 0, &sample);
+    result &= sample.current_bytes == KB(300) && sample.peak_bytes == KB(300) && sample.committed_bytes == KB(300);
+    result &= sample.reserved_bytes == MB(1) && sample.allocation_count == 1;
+
+    // NOTE(Sleepster): Doesn't fit, second block.
+    c_arena_push_size(&arena, KB(900));
+    c_memory_telemetry_frame_end();
+    result &= c_memory_telemetry_get_sample(&arena, 0, &sample);
+    result &= sample.current_bytes == KB(1200) && sample.peak_bytes == KB(1200) && sample.committed_bytes == KB(1200);
+    result &= sample.reserved_bytes == MB(2) && sample.allocation_count == 2;
+
+    c_arena_free_last_block(&arena);
+    c_memory_telemetry_frame_end();
+    result &= c_memory_telemetry_get_sample(&arena, 0, &sample);
+    result &= sample.current_bytes == KB(300) && sample.peak_bytes == KB(1200) && sample.committed_bytes == KB(300);
+    result &= sample.reserved_bytes == MB(1);
+
+    // NOTE(Sleepster): The pages stay committed after a reset, they've been written.
+    c_arena_reset(&arena);
+    c_arena_push_size(&arena, KB(100));
+    c_memory_telemetry_frame_end();
+    result &= c_memory_telemetry_get_sample(&arena, 0, &sample);
+    result &= sample.current_bytes == KB(100) && sample.peak_bytes == KB(1200) && sample.committed_bytes == KB(300);
+
+    // NOTE(Sleepster): History goes back in order.
+    result &= c_memory_telemetry_get_sample(&arena, 3, &sample) && sample.current_bytes == KB(300);
+    result &= !c_memory_telemetry_get_sample(&arena, 4, &sample);
+
+    c_memory_telemetry_unregister(&arena);
+    result &= !c_memory_telemetry_get_sample(&arena, 0, &sample);
+    c_arena_destroy(&arena);
+
+    printf("arena: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+internal_api bool8
+test_zone()
+{
+    bool8 result = true;
+
+    zone_allocator_t *zone = c_za_create(MB(1));
+    c_memory_telemetry_register_zone("test_zone", zone);
+
+    u64   block_size = KB(64) + TEST_ZONE_HEADER_SIZE;
+    byte *first      = c_za_alloc(zone, KB(64), ZA_TAG_TEXTURE);
+    byte *second     = c_za_alloc(zone, KB(64), ZA_TAG_SOUND);
+    byte *third      = c_za_alloc(zone, KB(64), ZA_TAG_TEXTURE);
+    (void)first;
+    (void)third;
+
+    memory_telemetry_sample_t sample = {};
+    c_memory_telemetry_frame_end();
+    result &= c_memory_telemetry_get_sample(zone, 0, &sample);
+    result &= sample.current_bytes == block_size * 3 && sample.allocation_count == 3;
+    result &= sample.tag_bytes[MTT_Texture] == block_size * 2 && sample.tag_bytes[MTT_Sound] == block_size;
+    result &= sample.free_block_count == 1 && sample.free_bytes == MB(1) - block_size * 3;
+    result &= c_memory_telemetry_get_fragmentation(&sample) == 0.0;
+
+    // NOTE(Sleepster): A hole in the middle, two free blocks and the largest one is the tail.
+    c_za_free(zone, second);
+    c_memory_telemetry_frame_end();
+    result &= c_memory_telemetry_get_sample(zone, 0, &sample);
+    result &= sample.current_bytes == block_size * 2 && sample.peak_bytes == block_size * 3;
+    result &= sample.committed_bytes == block_size * 3 && sample.reserved_bytes == MB(1);
+    result &= sample.tag_bytes[MTT_Sound] == 0;
+    result &= sample.free_block_count == 2 && sample.largest_free_block == MB(1) - block_size * 3;
+    result &= c_memory_telemetry_get_fragmentation(&sample) > 0.0;
+
+    c_memory_telemetry_unregister(zone);
+    c_za_destroy(zone);
+
+    printf("zone: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+internal_api bool8
+test_dynarrays()
+{
+    bool8 result = true;
+
+    memory_telemetry_sample_t before = {};
+    memory_telemetry_sample_t during = {};
+    memory_telemetry_sample_t after  = {};
+    c_memory_telemetry_frame_end();
+    result &= c_memory_telemetry_get_sample(&dynarray_memory_stats, 0, &before);
+
+    u32 *array = c_dynarray_create(u32);
+    for(u32 index = 0; index < 1000; ++index)
+    {
+        c_dynarray_push(array, index);
+    }
+    c_memory_telemetry_frame_end();
+    result &= c_memory_telemetry_get_sample(&dynarray_memory_stats, 0, &during);
+    result &= during.allocation_count == before.allocation_count + 1;
+    result &= during.current_bytes >= before.current_bytes + sizeof(u32) * 1000;
+
+    c_dynarray_destroy(array);
+    c_memory_telemetry_frame_end();
+    result &= c_memory_telemetry_get_sample(&dynarray_memory_stats, 0, &after);
+    result &= after.allocation_count == before.allocation_count && after.current_bytes == before.current_bytes;
+    result &= after.peak_bytes >= during.current_bytes;
+
+    printf("dynarrays: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+// NOTE(Sleepster): Past the end of the ring only the newest MEMORY_TELEMETRY_HISTORY_COUNT samples are dumped.
+internal_api bool8
+test_dumps()
+{
+    bool8 result = true;
+
+    memory_arena_t arena = c_arena_create(MB(1));
+    c_memory_telemetry_register_arena("dump_arena", &arena);
+    for(u32 frame_index = 0; frame_index < MEMORY_TELEMETRY_HISTORY_COUNT + 10; ++frame_index)
+    {
+        c_arena_push_size(&arena, KB(1));
+        c_memory_telemetry_frame_end();
+    }
+    c_memory_telemetry_log();
+
+    result &= c_memory_telemetry_dump_csv(STR("test_memory_telemetry.csv"));
+    result &= c_memory_telemetry_dump_json(STR("test_memory_telemetry.json"));
+    result &= test_count_lines("test_memory_telemetry.csv", "frame,name,kind,current_bytes") == 1;
+    result &= test_count_lines("test_memory_telemetry.csv", ",dump_arena,arena,") == MEMORY_TELEMETRY_HISTORY_COUNT;
+    result &= test_count_lines("test_memory_telemetry.csv", ",dynarrays,dynarrays,") == MEMORY_TELEMETRY_HISTORY_COUNT;
+    result &= test_count_lines("test_memory_telemetry.json", "{\"frame\":") == MEMORY_TELEMETRY_HISTORY_COUNT * 2;
+    result &= test_count_lines("test_memory_telemetry.json", "\"name\":\"dump_arena\"") == 1;
+
+    memory_telemetry_sample_t sample = {};
+    result &= c_memory_telemetry_get_sample(&arena, 0, &sample) && sample.current_bytes == KB(MEMORY_TELEMETRY_HISTORY_COUNT + 10);
+
+    remove("test_memory_telemetry.csv");
+    remove("test_memory_telemetry.json");
+    c_memory_telemetry_unregister(&arena);
+    c_arena_destroy(&arena);
+
+    printf("dumps: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+int
+main(void)
+{
+    bool8 passed = test_arena();
+    passed &= test_zone();
+    passed &= test_dynarrays();
+    passed &= test_dumps();
+
+    Assert(passed);
+    return(0);
+}
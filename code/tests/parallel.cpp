@@ -0,0 +1,123 @@
+/* ========================================================================
+   $File: parallel.cpp $
+   $Date: October 18 2026 06:41 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_threadpool.h>
+#include <c_threadpool.cpp>
+#include <c_profiler.cpp>
+#include <c_sampler.cpp>
+#include <c_parallel.h>
+#include <c_parallel.cpp>
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+
+#define TEST_RANGE_SIZE (100003)
+
+global_variable volatile u32 visit_counts[TEST_RANGE_SIZE];
+global_variable threadpool_t test_pool;
+
+void
+test_visit(void *user_data, u64 begin, u64 end)
+{
+    for(u64 index = begin;
+        index < end;
+        ++index)
+    {
+        AtomicIncrement32(&visit_counts[index]);
+    }
+}
+
+void
+test_sum(void *user_data, u64 begin, u64 end, void *partial_result)
+{
+    u64 *sum = (u64*)partial_result;
+    for(u64 index = begin;
+        index < end;
+        ++index)
+    {
+        *sum += index;
+    }
+}
+
+void
+test_combine(void *user_data, void *result, void *partial_result)
+{
+    *(u64*)result += *(u64*)partial_result;
+}
+
+// NOTE(Sleepster): Nested, every outer chunk runs its own parallel_for from inside of a task.
+void
+test_nested(void *user_data, u64 begin, u64 end)
+{
+    c_parallel_for(&test_pool, begin, end, 16, &test_visit, null);
+}
+
+internal_api bool8
+test_check_visits(const char *name, u32 expected)
+{
+    bool8 result = true;
+    for(u32 index = 0;
+        index < TEST_RANGE_SIZE;
+        ++index)
+    {
+        if(visit_counts[index] != expected)
+        {
+            printf("%s: index '%u' visited '%u' times, expected '%u'...\n", name, index, visit_counts[index], expected);
+            result = false;
+            break;
+        }
+    }
+    printf("%s: %s\n", name, result ? "passed" : "FAILED");
+
+    return(result);
+}
+
+int
+main(void)
+{
+    c_threadpool_init(&test_pool);
+
+    bool8 passed = true;
+    c_parallel_for(&test_pool, 0, TEST_RANGE_SIZE, 64, &test_visit, null);
+    passed &= test_check_visits("caller participates", 1);
+
+    c_parallel_for(&test_pool, 0, TEST_RANGE_SIZE, 7, &test_visit, null, PF_None);
+    passed &= test_check_visits("caller waits", 2);
+
+    c_parallel_for(&test_pool, 0, TEST_RANGE_SIZE, 1000, &test_nested, null);
+    passed &= test_check_visits("nested", 3);
+
+    c_parallel_for(null, 0, TEST_RANGE_SIZE, 100, &test_visit, null);
+    passed &= test_check_visits("no pool", 4);
+
+    u64 sum = 0;
+    c_parallel_reduce(&test_pool, 0, TEST_RANGE_SIZE, 128, &test_sum, &test_combine, null, &sum, sizeof(sum));
+    u64 expected_sum = ((u64)TEST_RANGE_SIZE * (TEST_RANGE_SIZE - 1)) / 2;
+    printf("reduce: '%llu', expected '%llu'\n", (unsigned long long)sum, (unsigned long long)expected_sum);
+    passed &= (sum == expected_sum);
+
+    c_threadpool_destroy(&test_pool);
+
+    Assert(passed);
+    return(0);
+}
@@ -0,0 +1,244 @@
+/* ========================================================================
+   $File: perf_counters.cpp $
+   $Date: October 19 2026 01:50 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_perf_counters.h>
+#include <c_perf_counters.cpp>
+#include <c_profiler.h>
+#include <c_profiler.cpp>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+
+#define TEST_WORK_ITERATIONS (1000000)
+
+global_variable volatile u64 test_sink;
+
+NO_INLINE internal_api void
+test_work(u32 iterations)
+{
+    u64 value = 0x9E3779B97F4A7C15ULL;
+    for(u32 iteration = 0; iteration < iterations; ++iteration)
+    {
+        value ^= value << 13;
+        value ^= value >> 7;
+        value ^= value << 17;
+    }
+    test_sink += value;
+}
+
+// NOTE(Sleepster): Either the counters are there and moved, or they aren't and everything says so. Both pass, this
+//                  runs in containers too.
+internal_api bool8
+test_read()
+{
+    bool8 result = true;
+
+    perf_counter_values_t start_values;
+    perf_counter_values_t end_values;
+    bool8 has_start = c_perf_counters_read(&start_values);
+    test_work(TEST_WORK_ITERATIONS);
+    bool8 has_end   = c_perf_counters_read(&end_values);
+
+    u64 deltas[PERF_COUNTER_COUNT];
+    u32 counter_mask = c_perf_counters_delta(&start_values, &end_values, deltas);
+    if(c_perf_counters_available())
+    {
+        result &= has_start && has_end;
+        result &= start_values.valid_mask != 0 && start_values.owner != null;
+        result &= counter_mask == start_values.valid_mask;
+        if(counter_mask & (1 << SPCK_Cycles))       result &= deltas[SPCK_Cycles] > 0;
+        if(counter_mask & (1 << SPCK_Instructions)) result &= deltas[SPCK_Instructions] >= TEST_WORK_ITERATIONS;
+    }
+    else
+    {
+        result &= !has_start && !has_end;
+        result &= start_values.valid_mask == 0 && start_values.owner == null;
+        result &= counter_mask == 0;
+    }
+
+    // NOTE(Sleepster): Two reads from different threads never make a delta.
+    perf_counter_values_t other_thread = {};
+    other_thread.valid_mask = (1 << PERF_COUNTER_COUNT) - 1;
+    other_thread.owner      = &other_thread;
+    result &= c_perf_counters_delta(&other_thread, &end_values, deltas) == 0;
+
+    char formatted[256];
+    u64  counters[PERF_COUNTER_COUNT] = {2000, 3000, 40, 10, 2};
+    c_perf_counters_format(formatted, sizeof(formatted), counters, (1 << PERF_COUNTER_COUNT) - 1, 2.0);
+    result &= strcmp(formatted, "ipc 1.50, cycles 1000.0, instructions 1500.0, cache_misses 20.0, branch_misses 5.0, tlb_misses 1.0") == 0;
+    c_perf_counters_format(formatted, sizeof(formatted), counters, 0, 1.0);
+    result &= formatted[0] == 0;
+
+    printf("read: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+#if PROFILER_ENABLED
+
+internal_api u32
+test_find_thread_root(profiler_frame_t *frame)
+{
+    u32 result = PROFILER_INVALID_NODE;
+    for(u32 thread_index = 0; thread_index < frame->thread_count; ++thread_index)
+    {
+        if(frame->thread_ids[thread_index] == (u32)GetThreadID()) result = frame->thread_roots[thread_index];
+    }
+
+    return(result);
+}
+
+// NOTE(Sleepster): Whatever the machine has, the zone is still a zone, and the deltas land on it and not its parent.
+internal_api bool8
+test_zone()
+{
+    bool8 result = true;
+    PROFILE_FRAME_END();
+
+    for(u32 call_index = 0; call_index < 3; ++call_index)
+    {
+        PROFILE_SCOPE("test_parent");
+        PROFILE_SCOPE_COUNTERS("test_counted");
+        test_work(TEST_WORK_ITERATIONS / 4);
+    }
+    profiler_frame_t *frame = PROFILE_FRAME_END();
+
+    u32 root    = test_find_thread_root(frame);
+    u32 parent  = c_profiler_find_child(frame, root, "test_parent");
+    u32 counted = c_profiler_find_child(frame, parent, "test_counted");
+    result &= counted != PROFILER_INVALID_NODE;
+    if(result)
+    {
+        profiler_node_t *parent_node  = frame->nodes + parent;
+        profiler_node_t *counted_node = frame->nodes + counted;
+        result &= counted_node->call_count == 3;
+        result &= parent_node->counter_calls == 0 && parent_node->counter_mask == 0;
+        if(c_perf_counters_available())
+        {
+            result &= counted_node->counter_calls == 3;
+            result &= counted_node->counter_mask != 0;
+            if(counted_node->counter_mask & (1 << SPCK_Instructions))
+            {
+                result &= counted_node->counters[SPCK_Instructions] >= 3 * (TEST_WORK_ITERATIONS / 4);
+            }
+        }
+        else
+        {
+            result &= counted_node->counter_calls == 0 && counted_node->counter_mask == 0;
+        }
+    }
+    c_profiler_log_frame(frame);
+
+    printf("zone: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+// NOTE(Sleepster): Made up deltas straight into the ring, so the collapse gets tested on machines without a PMU.
+internal_api bool8
+test_zone_deltas()
+{
+    bool8 result = true;
+    PROFILE_FRAME_END();
+
+    u32 owner = 0;
+    perf_counter_values_t start_values = {};
+    perf_counter_values_t end_values   = {};
+    start_values.valid_mask = end_values.valid_mask = (1 << SPCK_Cycles) | (1 << SPCK_CacheMisses);
+    start_values.owner      = end_values.owner      = &owner;
+    start_values.values[SPCK_Cycles]     = 1000;
+    end_values.values[SPCK_Cycles]       = 5000;
+    start_values.values[SPCK_CacheMisses] = 7;
+    end_values.values[SPCK_CacheMisses]   = 57;
+
+    {
+        PROFILE_SCOPE("test_outer");
+        for(u32 call_index = 0; call_index < 2; ++call_index)
+        {
+            PROFILE_SCOPE("test_inner");
+            c_profiler_zone_counters(&start_values, &end_values);
+        }
+
+        // NOTE(Sleepster): Went backwards, that's not a delta.
+        PROFILE_SCOPE("test_backwards");
+        c_profiler_zone_counters(&end_values, &start_values);
+    }
+
+    // NOTE(Sleepster): Left open over the frame boundary, the deltas still find it in the next frame.
+    PROFILE_BEGIN("test_carried");
+    profiler_frame_t *frame = PROFILE_FRAME_END();
+    c_profiler_zone_counters(&start_values, &end_values);
+    PROFILE_END();
+    profiler_frame_t *next_frame = PROFILE_FRAME_END();
+
+    u32 root      = test_find_thread_root(frame);
+    u32 outer     = c_profiler_find_child(frame, root, "test_outer");
+    u32 inner     = c_profiler_find_child(frame, outer, "test_inner");
+    u32 backwards = c_profiler_find_child(frame, outer, "test_backwards");
+    result &= inner != PROFILER_INVALID_NODE && backwards != PROFILER_INVALID_NODE;
+    if(result)
+    {
+        profiler_node_t *inner_node = frame->nodes + inner;
+        result &= inner_node->call_count == 2 && inner_node->counter_calls == 2;
+        result &= inner_node->counter_mask == ((1 << SPCK_Cycles) | (1 << SPCK_CacheMisses));
+        result &= inner_node->counters[SPCK_Cycles] == 8000;
+        result &= inner_node->counters[SPCK_CacheMisses] == 100;
+        result &= inner_node->counters[SPCK_Instructions] == 0;
+        result &= frame->nodes[outer].counter_calls == 0;
+        result &= frame->nodes[backwards].counter_calls == 0 && frame->nodes[backwards].counter_mask == 0;
+    }
+
+    u32 carried = c_profiler_find_child(next_frame, test_find_thread_root(next_frame), "test_carried");
+    result &= carried != PROFILER_INVALID_NODE;
+    if(result)
+    {
+        result &= next_frame->nodes[carried].call_count == 1 && next_frame->nodes[carried].counter_calls == 1;
+        result &= next_frame->nodes[carried].counters[SPCK_Cycles] == 4000;
+    }
+
+    printf("zone deltas: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+int
+main(void)
+{
+    bool8 passed = test_read();
+    passed &= test_zone();
+    passed &= test_zone_deltas();
+
+    Assert(passed);
+    return(0);
+}
+
+#else
+
+int
+main(void)
+{
+    bool8 passed = test_read();
+    printf("profiler is compiled out (PROFILER_ENABLED=0), only the counters are tested...\n");
+
+    Assert(passed);
+    return(0);
+}
+
+#endif // PROFILER_ENABLED
@@ -0,0 +1,315 @@
+/* ========================================================================
+   $File: profiler.cpp $
+   $Date: October 19 2026 12:30 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_threadpool.h>
+#include <c_threadpool.cpp>
+#include <c_profiler.h>
+#include <c_profiler.cpp>
+#include <c_sampler.cpp>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+
+#if PROFILER_ENABLED
+
+#define TEST_TASK_COUNT    (256)
+#define TEST_THREAD_ROUNDS (PROFILER_MAX_THREADS * 2)
+
+global_variable threadpool_t test_pool;
+
+internal_api void
+test_spin_ticks(u64 ticks)
+{
+    u64 start = rdtsc();
+    while(rdtsc() - start < ticks)
+    {
+        _mm_pause();
+    }
+}
+
+internal_api u32
+test_find_thread_root(profiler_frame_t *frame, u32 thread_id)
+{
+    u32 result = PROFILER_INVALID_NODE;
+    for(u32 thread_index = 0; thread_index < frame->thread_count; ++thread_index)
+    {
+        if(frame->thread_ids[thread_index] == thread_id) result = frame->thread_roots[thread_index];
+    }
+
+    return(result);
+}
+
+// NOTE(Sleepster): Every call of 'name' anywhere in the frame, on every thread.
+internal_api u32
+test_count_calls(profiler_frame_t *frame, const char *name)
+{
+    u32 result = 0;
+    for(u32 node_index = 0; node_index < frame->node_count; ++node_index)
+    {
+        if(strcmp(frame->nodes[node_index].name, name) == 0) result += frame->nodes[node_index].call_count;
+    }
+
+    return(result);
+}
+
+internal_api bool8
+test_open_zones_are_closed(void)
+{
+    bool8 result = true;
+    for(u32 slot_index = 0; slot_index < profiler.slot_count; ++slot_index)
+    {
+        profiler_thread_slot_t *slot = profiler.slots + slot_index;
+        if(slot->state == PSS_Active || slot->state == PSS_Exited)
+        {
+            result &= slot->open_depth == 0 && slot->overflow_depth == 0;
+        }
+    }
+
+    return(result);
+}
+
+internal_api bool8
+test_nesting()
+{
+    bool8 result = true;
+    c_profiler_frame_end();
+
+    {
+        PROFILE_SCOPE("outer");
+        test_spin_ticks(20000);
+        for(u32 call_index = 0; call_index < 3; ++call_index)
+        {
+            PROFILE_SCOPE("inner");
+            test_spin_ticks(10000);
+            {
+                PROFILE_SCOPE("leaf");
+            }
+        }
+    }
+
+    profiler_frame_t *frame = c_profiler_frame_end();
+    u32 root  = test_find_thread_root(frame, (u32)GetThreadID());
+    u32 outer = c_profiler_find_child(frame, root,  "outer");
+    u32 inner = c_profiler_find_child(frame, outer, "inner");
+    u32 leaf  = c_profiler_find_child(frame, inner, "leaf");
+    result &= root != PROFILER_INVALID_NODE && outer != PROFILER_INVALID_NODE && inner != PROFILER_INVALID_NODE && leaf != PROFILER_INVALID_NODE;
+    if(result)
+    {
+        profiler_node_t *outer_node = frame->nodes + outer;
+        profiler_node_t *inner_node = frame->nodes + inner;
+        profiler_node_t *leaf_node  = frame->nodes + leaf;
+        result &= outer_node->call_count == 1 && inner_node->call_count == 3 && leaf_node->call_count == 3;
+        result &= c_profiler_find_child(frame, root, "inner") == PROFILER_INVALID_NODE;
+
+        // NOTE(Sleepster): Totals nest, and the self times add back up to the outer zone's total.
+        result &= outer_node->total_ticks >= 50000 && inner_node->total_ticks >= 30000;
+        result &= outer_node->child_ticks == inner_node->total_ticks;
+        result &= inner_node->child_ticks == leaf_node->total_ticks;
+        result &= frame->nodes[root].total_ticks == outer_node->total_ticks;
+
+        float64 self_sum = c_profiler_node_self_ms(frame, outer) + c_profiler_node_self_ms(frame, inner) + c_profiler_node_self_ms(frame, leaf);
+        result &= self_sum > c_profiler_node_total_ms(frame, outer) * 0.999 && self_sum < c_profiler_node_total_ms(frame, outer) * 1.001;
+    }
+    result &= test_open_zones_are_closed();
+
+    printf("nesting: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+// NOTE(Sleepster): A zone that's still open at the end of the frame belongs to the frame it ends in.
+internal_api bool8
+test_carry_over()
+{
+    bool8 result = true;
+    c_profiler_frame_end();
+
+    PROFILE_BEGIN("long");
+    {
+        PROFILE_SCOPE("first_half");
+    }
+    profiler_frame_t *first = c_profiler_frame_end();
+    u32 first_long = c_profiler_find_child(first, test_find_thread_root(first, (u32)GetThreadID()), "long");
+    result &= first_long != PROFILER_INVALID_NODE && first->nodes[first_long].call_count == 0;
+    result &= c_profiler_find_child(first, first_long, "first_half") != PROFILER_INVALID_NODE;
+
+    {
+        PROFILE_SCOPE("second_half");
+    }
+    PROFILE_END();
+    profiler_frame_t *second = c_profiler_frame_end();
+    u32 second_long = c_profiler_find_child(second, test_find_thread_root(second, (u32)GetThreadID()), "long");
+    result &= second_long != PROFILER_INVALID_NODE && second->nodes[second_long].call_count == 1;
+    result &= c_profiler_find_child(second, second_long, "second_half") != PROFILER_INVALID_NODE;
+    result &= test_open_zones_are_closed();
+
+    printf("carry over: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+// NOTE(Sleepster): More zones than the ring holds in one frame, the extra ones are dropped whole.
+internal_api bool8
+test_overflow()
+{
+    bool8 result = true;
+    c_profiler_frame_end();
+
+    u32 zone_count = PROFILER_RING_EVENT_COUNT;
+    {
+        PROFILE_SCOPE("overflow_outer");
+        for(u32 zone_index = 0; zone_index < zone_count; ++zone_index)
+        {
+            PROFILE_SCOPE("overflow_inner");
+        }
+    }
+
+    profiler_frame_t *frame = c_profiler_frame_end();
+    u32 recorded = test_count_calls(frame, "overflow_inner");
+    result &= test_count_calls(frame, "overflow_outer") == 1;
+    result &= recorded > 0 && recorded < zone_count;
+    result &= frame->dropped_zones == zone_count - recorded;
+    result &= test_open_zones_are_closed();
+
+    // NOTE(Sleepster): Too deep is folded away the same way, the zones that fit are still there.
+    c_profiler_frame_end();
+    for(u32 depth = 0; depth < PROFILER_MAX_DEPTH + 8; ++depth) PROFILE_BEGIN("deep");
+    for(u32 depth = 0; depth < PROFILER_MAX_DEPTH + 8; ++depth) PROFILE_END();
+    frame = c_profiler_frame_end();
+    result &= test_count_calls(frame, "deep") == PROFILER_MAX_DEPTH;
+    result &= test_open_zones_are_closed();
+
+    printf("overflow ('%u' of '%u' zones recorded): %s\n", recorded, zone_count, result ? "passed" : "FAILED");
+    return(result);
+}
+
+void
+test_task_work(void *user_data)
+{
+    PROFILE_SCOPE("work");
+    test_spin_ticks(1000);
+}
+
+// NOTE(Sleepster): Waits on children from inside of a zone, the fiber can come back on any worker.
+void
+test_task_waiter(void *user_data)
+{
+    PROFILE_SCOPE("waiter");
+
+    threadpool_counter_t counter = {};
+    for(u32 task_index = 0; task_index < 8; ++task_index)
+    {
+        c_threadpool_add_task(&test_pool, null, test_task_work, TPTP_High, &counter);
+    }
+    c_threadpool_wait_for_counter(&test_pool, &counter);
+}
+
+internal_api bool8
+test_threads()
+{
+    bool8 result = true;
+    c_profiler_frame_end();
+
+    threadpool_counter_t counter = {};
+    for(u32 task_index = 0; task_index < TEST_TASK_COUNT; ++task_index)
+    {
+        c_threadpool_add_task(&test_pool, null, (task_index % 16) ? test_task_work : test_task_waiter, TPTP_High, &counter);
+    }
+    c_threadpool_wait_for_counter(&test_pool, &counter);
+
+    u32 waiter_count = TEST_TASK_COUNT / 16;
+    u32 work_count   = (TEST_TASK_COUNT - waiter_count) + waiter_count * 8;
+
+    // NOTE(Sleepster): Every work zone sits under a task, either directly or under a waiter.
+    profiler_frame_t *frame = c_profiler_frame_end();
+    result &= test_count_calls(frame, "work") == work_count;
+    result &= test_count_calls(frame, "waiter") >= waiter_count;
+    result &= test_count_calls(frame, "threadpool_task") >= TEST_TASK_COUNT;
+    for(u32 node_index = 0; node_index < frame->node_count; ++node_index)
+    {
+        profiler_node_t *node = frame->nodes + node_index;
+        if(strcmp(node->name, "work") == 0)
+        {
+            const char *parent_name = frame->nodes[node->parent].name;
+            result &= strcmp(parent_name, "threadpool_task") == 0 || strcmp(parent_name, "waiter") == 0;
+        }
+    }
+    result &= test_open_zones_are_closed();
+    result &= frame->dropped_zones == 0 && frame->dropped_nodes == 0;
+
+    printf("threads ('%u' threads in the frame): %s\n", frame->thread_count, result ? "passed" : "FAILED");
+    return(result);
+}
+
+PLATFORM_THREAD_PROC(test_short_lived_thread)
+{
+    PROFILE_SCOPE("short_lived");
+    return(0);
+}
+
+// NOTE(Sleepster): Rings come back when their thread exits, more threads than rings is fine as long as frames end.
+internal_api bool8
+test_thread_exit()
+{
+    bool8 result = true;
+    for(u32 round_index = 0; round_index < TEST_THREAD_ROUNDS; ++round_index)
+    {
+        sys_thread_t thread = sys_thread_create(test_short_lived_thread, null, false);
+        sys_thread_join(&thread);
+
+        profiler_frame_t *frame = c_profiler_frame_end();
+        result &= test_count_calls(frame, "short_lived") == 1;
+    }
+    result &= profiler.registration_failed == 0;
+
+    printf("thread exit ('%u' threads): %s\n", TEST_THREAD_ROUNDS, result ? "passed" : "FAILED");
+    return(result);
+}
+
+int
+main(void)
+{
+    c_threadpool_init(&test_pool, 4);
+    PROFILE_SET_THREAD_NAME("main");
+
+    bool8 passed = test_nesting();
+    passed &= test_carry_over();
+    passed &= test_overflow();
+    passed &= test_threads();
+    passed &= test_thread_exit();
+
+    c_profiler_frame_end();
+    c_threadpool_destroy(&test_pool);
+
+    Assert(passed);
+    return(0);
+}
+
+#else
+
+int
+main(void)
+{
+    printf("profiler is compiled out (PROFILER_ENABLED=0), nothing to test...\n");
+    return(0);
+}
+
+#endif // PROFILER_ENABLED
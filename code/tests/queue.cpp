@@ -0,0 +1,263 @@
+/* ========================================================================
+   $File: queue.cpp $
+   $Date: October 18 2026 09:45 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_queue.h>
+#include <c_queue.cpp>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+
+#define TEST_MAX_PRODUCERS     (4)
+#define TEST_MAX_CONSUMERS     (4)
+#define TEST_ITEMS_PER_PRODUCER (100000)
+#define TEST_QUEUE_CAPACITY    (64)
+#define TEST_MAX_BATCH         (8)
+
+// NOTE(Sleepster): Bigger than a pointer on purpose, a torn copy shows up as a bad check value.
+struct test_item_t
+{
+    u32 producer_index;
+    u32 sequence;
+    u64 check;
+    u64 padding;
+};
+
+struct test_run_t
+{
+    queue_t       queue;
+    u32           producer_count;
+    u32           consumer_count;
+    volatile u32  producers_done;
+    volatile u32  items_consumed;
+    volatile u32  order_errors;
+    volatile u32  check_errors;
+    volatile u32  next_thread_index;
+
+    volatile u8   seen[TEST_MAX_PRODUCERS][TEST_ITEMS_PER_PRODUCER];
+};
+
+global_variable test_run_t test_run;
+
+// NOTE(Sleepster): Full/empty is the normal case here, give the other side the core instead of burning the slice.
+internal_api inline void
+test_backoff(u32 *failed_attempts)
+{
+    if(++(*failed_attempts) < 64) _mm_pause();
+    else                          sys_thread_yield();
+}
+
+internal_api inline u64
+test_make_check(u32 producer_index, u32 sequence)
+{
+    u64 result = ((u64)producer_index << 32 | sequence) * 0x9E3779B97F4A7C15ull;
+    return(result);
+}
+
+PLATFORM_THREAD_PROC(test_producer_proc)
+{
+    u32 producer_index = AtomicIncrement32(&test_run.next_thread_index);
+
+    u32 sequence = 0;
+    while(sequence < TEST_ITEMS_PER_PRODUCER)
+    {
+        // NOTE(Sleepster): Mix of single pushes and batches of different sizes.
+        test_item_t batch[TEST_MAX_BATCH];
+        u32 batch_size = (sequence % 3 == 0) ? 1 : ((sequence % TEST_MAX_BATCH) + 1);
+        if(batch_size > TEST_ITEMS_PER_PRODUCER - sequence) batch_size = TEST_ITEMS_PER_PRODUCER - sequence;
+
+        for(u32 batch_index = 0;
+            batch_index < batch_size;
+            ++batch_index)
+        {
+            batch[batch_index].producer_index = producer_index;
+            batch[batch_index].sequence       = sequence + batch_index;
+            batch[batch_index].check          = test_make_check(producer_index, sequence + batch_index);
+        }
+
+        u32 pushed          = 0;
+        u32 failed_attempts = 0;
+        while(pushed < batch_size)
+        {
+            u32 pushed_now = 0;
+            if(batch_size == 1) pushed_now = c_queue_push(&test_run.queue, batch) ? 1 : 0;
+            else                pushed_now = c_queue_push_batch(&test_run.queue, batch + pushed, batch_size - pushed);
+
+            if(pushed_now == 0) test_backoff(&failed_attempts);
+            pushed += pushed_now;
+        }
+        sequence += batch_size;
+    }
+    AtomicIncrement32(&test_run.producers_done);
+
+    return(0);
+}
+
+PLATFORM_THREAD_PROC(test_consumer_proc)
+{
+    s64 last_sequence[TEST_MAX_PRODUCERS];
+    for(u32 producer_index = 0;
+        producer_index < TEST_MAX_PRODUCERS;
+        ++producer_index)
+    {
+        last_sequence[producer_index] = -1;
+    }
+
+    u32 total_items = test_run.producer_count * TEST_ITEMS_PER_PRODUCER;
+    u32 pop_count       = 0;
+    u32 failed_attempts = 0;
+    while(AtomicLoad32(&test_run.items_consumed) < total_items)
+    {
+        test_item_t batch[TEST_MAX_BATCH];
+        u32 popped = ((pop_count++ & 1) == 0) ? (c_queue_pop(&test_run.queue, batch) ? 1 : 0) :
+                                                c_queue_pop_batch(&test_run.queue, batch, TEST_MAX_BATCH);
+        if(popped == 0)
+        {
+            test_backoff(&failed_attempts);
+            continue;
+        }
+        failed_attempts = 0;
+
+        for(u32 batch_index = 0;
+            batch_index < popped;
+            ++batch_index)
+        {
+            test_item_t *item = batch + batch_index;
+            if(item->producer_index >= test_run.producer_count ||
+               item->sequence >= TEST_ITEMS_PER_PRODUCER ||
+               item->check != test_make_check(item->producer_index, item->sequence))
+            {
+                AtomicIncrement32(&test_run.check_errors);
+                continue;
+            }
+
+            // NOTE(Sleepster): Every consumer has to see each producer's items in the order they were pushed.
+            if((s64)item->sequence <= last_sequence[item->producer_index])
+            {
+                AtomicIncrement32(&test_run.order_errors);
+            }
+            last_sequence[item->producer_index] = item->sequence;
+            test_run.seen[item->producer_index][item->sequence] += 1;
+        }
+        AtomicExchangeAdd32(&test_run.items_consumed, popped);
+    }
+
+    return(0);
+}
+
+internal_api bool8
+test_queue(const char *name, u32 kind, u32 producer_count, u32 consumer_count)
+{
+    memset((void*)&test_run, 0, sizeof(test_run));
+    test_run.producer_count    = producer_count;
+    test_run.consumer_count    = consumer_count;
+
+    bool8 result = c_queue_create_typed(&test_run.queue, kind, test_item_t, TEST_QUEUE_CAPACITY);
+
+    sys_thread_t threads[TEST_MAX_PRODUCERS + TEST_MAX_CONSUMERS];
+    u32 thread_count = 0;
+    for(u32 consumer_index = 0;
+        consumer_index < consumer_count;
+        ++consumer_index)
+    {
+        threads[thread_count++] = sys_thread_create(test_consumer_proc, null, false);
+    }
+    for(u32 producer_index = 0;
+        producer_index < producer_count;
+        ++producer_index)
+    {
+        threads[thread_count++] = sys_thread_create(test_producer_proc, null, false);
+    }
+    for(u32 thread_index = 0;
+        thread_index < thread_count;
+        ++thread_index)
+    {
+        sys_thread_join(&threads[thread_index]);
+    }
+
+    u32 missing_items = 0;
+    for(u32 producer_index = 0;
+        producer_index < producer_count;
+        ++producer_index)
+    {
+        for(u32 sequence = 0;
+            sequence < TEST_ITEMS_PER_PRODUCER;
+            ++sequence)
+        {
+            if(test_run.seen[producer_index][sequence] != 1) ++missing_items;
+        }
+    }
+
+    test_item_t leftover;
+    result &= !c_queue_pop(&test_run.queue, &leftover);
+    result &= c_queue_get_count(&test_run.queue) == 0;
+    result &= missing_items == 0 && test_run.order_errors == 0 && test_run.check_errors == 0;
+    printf("%s (%u producers, %u consumers): '%u' consumed, '%u' missing/duplicated, '%u' out of order, '%u' torn... %s\n",
+           name, producer_count, consumer_count, test_run.items_consumed, missing_items,
+           test_run.order_errors, test_run.check_errors, result ? "passed" : "FAILED");
+
+    c_queue_destroy(&test_run.queue);
+    return(result);
+}
+
+internal_api bool8
+test_single_threaded()
+{
+    bool8 result = true;
+
+    queue_t queue;
+    c_queue_create(&queue, QK_SPSC, sizeof(u32), 5);
+    result &= queue.capacity == 8;
+
+    u32 values[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    result &= c_queue_push_batch(&queue, values, 10) == 8;
+    result &= !c_queue_push(&queue, values + 8);
+    result &= c_queue_get_count(&queue) == 8;
+
+    u32 popped[10] = {};
+    result &= c_queue_pop_batch(&queue, popped, 3) == 3;
+    result &= c_queue_push_batch(&queue, values + 8, 2) == 2;
+    result &= c_queue_pop_batch(&queue, popped + 3, 10) == 7;
+    for(u32 index = 0; index < 10; ++index)
+    {
+        result &= popped[index] == index;
+    }
+    result &= c_queue_pop_batch(&queue, popped, 10) == 0;
+    c_queue_destroy(&queue);
+
+    printf("single threaded: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+int
+main(void)
+{
+    bool8 passed = test_single_threaded();
+    passed &= test_queue("spsc", QK_SPSC, 1, 1);
+    passed &= test_queue("mpsc", QK_MPSC, 4, 1);
+    passed &= test_queue("mpmc", QK_MPMC, 4, 4);
+    passed &= test_queue("mpmc", QK_MPMC, 1, 4);
+
+    Assert(passed);
+    return(0);
+}
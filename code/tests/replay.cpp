@@ -0,0 +1,233 @@
+/* ========================================================================
+   $File: replay.cpp $
+   $Date: October 19 2026 07:20 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdlib.h>
+#include <stdio.h>
+
+#define MATH_IMPLEMENTATION
+#define HASH_TABLE_IMPLEMENTATION
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_hash_table.h>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+
+#include <g_entity.cpp>
+#include <g_game_state.cpp>
+#include <g_replay.cpp>
+
+#define TEST_REPLAY_TICKS (600)
+
+internal_api entity_t*
+test_spawn_player(game_state_t *state, u32 client_id)
+{
+    state->client_id = client_id;
+    state->clients[client_id].ID = client_id;
+    entity_t *result = entity_create(state);
+    result->e_type = ET_Player;
+    state->clients[client_id].player = result;
+
+    return(result);
+}
+
+internal_api void
+test_push_input(game_state_t *state, u32 client_id, vec2_t input_axis)
+{
+    client_data_t *client = state->clients + client_id;
+    client->input_data_buffer[client->input_data_head].input_axis = input_axis;
+    client->input_data_head = (client->input_data_head + 1) % MAX_BUFFERED_INPUTS;
+}
+
+internal_api float32
+test_random_bilateral(u64 *random_state)
+{
+    u64 x = *random_state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *random_state = x;
+
+    float32 result = (float32)((x * 0x2545F4914F6CDD1DULL) >> 40) * (2.0f / 16777216.0f) - 1.0f;
+    return(result);
+}
+
+/* NOTE(Sleepster): Two players, the first holds a direction for a few hundred ticks at a time, the second wanders
+ * randomly, the third joins halfway through. The wandering has its own RNG, the game's is the simulation's and the
+ * replay wouldn't draw from it the same way.
+ */
+internal_api string_t
+test_record(game_state_t *state, memory_arena_t *arena, u64 seed)
+{
+    ZeroStruct(*state);
+    g_game_state_seed_random(state, seed);
+    test_spawn_player(state, 0);
+    test_spawn_player(state, 1);
+
+    u64 input_random_state = seed;
+    replay_recorder_t *recorder = Alloc(replay_recorder_t);
+    g_replay_recorder_begin(recorder, state, STR("unused.replay"));
+    for(u32 tick_index = 0; tick_index < TEST_REPLAY_TICKS; ++tick_index)
+    {
+        if(tick_index == TEST_REPLAY_TICKS / 2) test_spawn_player(state, 2);
+
+        vec2_t held = (tick_index / 200) & 1 ? vec2(1.0f, 0.0f) : vec2(0.0f, -1.0f);
+        test_push_input(state, 0, held);
+        if(tick_index % 3 == 0)
+        {
+            test_push_input(state, 1, vec2(test_random_bilateral(&input_random_state), test_random_bilateral(&input_random_state)));
+        }
+        if(state->entity_manager.active_entities > 2) test_push_input(state, 2, vec2(-1.0f, 1.0f));
+        g_simulate_tick(state);
+    }
+
+    string_t result = g_replay_recorder_serialize(recorder, state, arena);
+    free(recorder);
+
+    return(result);
+}
+
+// NOTE(Sleepster): Replaying has to end on the exact state the recording did, twice in a row.
+internal_api bool8
+test_round_trip()
+{
+    bool8 result = true;
+
+    memory_arena_t arena = c_arena_create(MB(1));
+    game_state_t  *state = Alloc(game_state_t);
+
+    string_t file_data = test_record(state, &arena, 1234);
+    u64 recorded_checksum = g_game_state_checksum(state);
+    vec2_t recorded_position = state->entity_manager.entities[1].position;
+
+    replay_data_t replay = g_replay_load_from_memory(file_data);
+    result &= replay.is_valid;
+    result &= replay.header->tick_count   == TEST_REPLAY_TICKS;
+    result &= replay.header->entity_count == 2;
+    result &= replay.header->final_checksum == recorded_checksum;
+
+    for(u32 pass_index = 0; pass_index < 2 && result; ++pass_index)
+    {
+        g_replay_reset_state(&replay, state);
+        replay_stats_t stats = g_replay_run(&replay, state);
+        result &= stats.ticks == TEST_REPLAY_TICKS;
+        result &= stats.checksum_matches;
+        result &= state->entity_manager.active_entities == 3;
+        result &= state->entity_manager.entities[1].position.x == recorded_position.x;
+        result &= state->entity_manager.entities[1].position.y == recorded_position.y;
+        result &= state->simulation_timings.calls[GSS_Players] == TEST_REPLAY_TICKS;
+    }
+
+    // NOTE(Sleepster): Moving the starting state has to show up in the checksum.
+    g_replay_reset_state(&replay, state);
+    state->entity_manager.entities[0].position.x += 1.0f;
+    replay_stats_t stats = g_replay_run(&replay, state);
+    result &= !stats.checksum_matches;
+
+    free(state);
+    c_arena_destroy(&arena);
+
+    printf("round trip: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+// NOTE(Sleepster): Held input should cost one run, not one record per tick.
+internal_api bool8
+test_run_length()
+{
+    bool8 result = true;
+
+    memory_arena_t arena = c_arena_create(MB(1));
+    game_state_t  *state = Alloc(game_state_t);
+    test_spawn_player(state, 0);
+
+    replay_recorder_t *recorder = Alloc(replay_recorder_t);
+    g_replay_recorder_begin(recorder, state, STR("unused.replay"));
+    for(u32 tick_index = 0; tick_index < 3600; ++tick_index)
+    {
+        test_push_input(state, 0, tick_index < 1800 ? vec2(1.0f, 0.0f) : vec2(0.0f, 0.0f));
+        g_simulate_tick(state);
+    }
+    for(u32 tick_index = 0; tick_index < 60; ++tick_index)
+    {
+        g_simulate_tick(state);
+    }
+    string_t file_data = g_replay_recorder_serialize(recorder, state, &arena);
+
+    replay_data_t replay = g_replay_load_from_memory(file_data);
+    result &= replay.is_valid;
+    result &= replay.header->run_count  == 3;
+    result &= replay.header->tick_count == 3660;
+    result &= file_data.count == sizeof(replay_file_header_t) + sizeof(entity_t) + 3 * sizeof(replay_run_t) + 2 * sizeof(replay_event_t);
+
+    g_replay_reset_state(&replay, state);
+    replay_stats_t stats = g_replay_run(&replay, state);
+    result &= stats.checksum_matches;
+
+    free(recorder);
+    free(state);
+    c_arena_destroy(&arena);
+
+    printf("run length: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+internal_api bool8
+test_file()
+{
+    bool8 result = true;
+
+    memory_arena_t arena = c_arena_create(MB(1));
+    game_state_t  *state = Alloc(game_state_t);
+    test_spawn_player(state, 0);
+
+    replay_recorder_t *recorder = Alloc(replay_recorder_t);
+    g_replay_recorder_begin(recorder, state, STR("test_replay.replay"));
+    for(u32 tick_index = 0; tick_index < 120; ++tick_index)
+    {
+        test_push_input(state, 0, vec2(0.5f, 0.5f));
+        g_simulate_tick(state);
+    }
+    result &= g_replay_recorder_finish(recorder, state);
+    result &= g_replay_run_headless(STR("test_replay.replay"), 3) == 0;
+
+    replay_data_t missing = g_replay_load(STR("missing.replay"), &arena);
+    result &= !missing.is_valid;
+
+    string_t garbage = STR("not a replay file at all, just long enough to have a header's worth of bytes");
+    result &= !g_replay_load_from_memory(garbage).is_valid;
+
+    remove("test_replay.replay");
+    free(recorder);
+    free(state);
+    c_arena_destroy(&arena);
+
+    printf("file: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+int
+main(void)
+{
+    bool8 passed = test_round_trip();
+    passed &= test_run_length();
+    passed &= test_file();
+
+    Assert(passed);
+    return(0);
+}
@@ -0,0 +1,241 @@
+/* ========================================================================
+   $File: sampler.cpp $
+   $Date: October 19 2026 11:40 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_threadpool.h>
+#include <c_threadpool.cpp>
+#include <c_profiler.cpp>
+#include <c_sampler.h>
+#include <c_sampler.cpp>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+
+#define TEST_SAMPLE_HZ         (4000)
+#define TEST_BURN_MS           (500)
+#define TEST_BUFFER_SIZE       (KB(64))
+#define TEST_TASK_COUNT        (32)
+
+global_variable byte        test_buffer[TEST_BUFFER_SIZE];
+global_variable volatile u64 test_sink;
+
+internal_api u64
+test_now_ms()
+{
+    u64 result = (SDL_GetPerformanceCounter() * 1000) / SDL_GetPerformanceFrequency();
+    return(result);
+}
+
+// NOTE(Sleepster): The byte at a time FNV, the kind of loop this thing is supposed to find.
+NO_INLINE internal_api u64
+test_sampler_fnv_loop(byte *data, u32 size)
+{
+    u64 result = 0xcbf29ce484222325ULL;
+    for(u32 byte_index = 0; byte_index < size; ++byte_index)
+    {
+        result ^= data[byte_index];
+        result *= 0x100000001b3ULL;
+    }
+
+    return(result);
+}
+
+NO_INLINE internal_api void
+test_sampler_burn_main(u64 milliseconds)
+{
+    u64 end = test_now_ms() + milliseconds;
+    while(test_now_ms() < end)
+    {
+        test_sink += test_sampler_fnv_loop(test_buffer, TEST_BUFFER_SIZE);
+    }
+}
+
+NO_INLINE internal_api void
+test_sampler_fill_loop(byte *data, u32 size, byte value)
+{
+    for(u32 byte_index = 0; byte_index < size; ++byte_index)
+    {
+        ((volatile byte*)data)[byte_index] = value + (byte)byte_index;
+    }
+}
+
+// NOTE(Sleepster): Runs on a worker's fiber, the walk has to stay inside the fiber's stack.
+internal_api void
+test_sampler_task(void *user_data)
+{
+    byte *buffer = (byte*)malloc(TEST_BUFFER_SIZE);
+    u64   end    = test_now_ms() + 20;
+    while(test_now_ms() < end)
+    {
+        test_sampler_fill_loop(buffer, TEST_BUFFER_SIZE, (byte)(usize)user_data);
+    }
+    free(buffer);
+}
+
+internal_api sampler_function_t*
+test_find_function(sampler_report_t *report, const char *name, bool8 is_thread)
+{
+    sampler_function_t *result = null;
+    for(u32 function_index = 0; function_index < report->function_count; ++function_index)
+    {
+        sampler_function_t *function = report->functions + function_index;
+        if(function->is_thread == is_thread && strcmp(function->name, name) == 0)
+        {
+            result = function;
+            break;
+        }
+    }
+
+    return(result);
+}
+
+internal_api bool8
+test_file_contains(const char *path, const char *needle)
+{
+    bool8 result = false;
+
+    FILE *file = fopen(path, "rb");
+    if(file)
+    {
+        char line[16384];
+        while(!result && fgets(line, sizeof(line), file))
+        {
+            result = strstr(line, needle) != null;
+        }
+        fclose(file);
+    }
+
+    return(result);
+}
+
+internal_api bool8
+test_capture()
+{
+    bool8 result = true;
+
+    threadpool_t pool = {};
+    threadpool_config_t config = {};
+    config.thread_count = 2;
+
+    c_sampler_register_thread("test_main");
+    result &= c_sampler_start("test_sampler.smpl", TEST_SAMPLE_HZ);
+    result &= c_sampler_is_running();
+
+    // NOTE(Sleepster): Workers that come up after the start get their timers right away.
+    c_threadpool_init_with_config(&pool, &config);
+    threadpool_counter_t counter = {};
+    for(u32 task_index = 0; task_index < TEST_TASK_COUNT; ++task_index)
+    {
+        c_threadpool_add_task(&pool, (void*)(usize)task_index, test_sampler_task, TPTP_Low, &counter);
+    }
+
+    test_sampler_burn_main(TEST_BURN_MS);
+    c_threadpool_wait_for_counter(&pool, &counter);
+    c_threadpool_destroy(&pool);
+
+    c_sampler_stop();
+    result &= !c_sampler_is_running();
+
+    sampler_report_t *report = (sampler_report_t*)calloc(1, sizeof(sampler_report_t));
+    result &= c_sampler_report_load(report, STR("test_sampler.smpl"));
+    result &= c_sampler_report_write_folded(report, STR("test_sampler.folded"));
+    c_sampler_report_log_top(report, 8);
+
+    // NOTE(Sleepster): CPU clock timers only fire on the scheduler tick, a kernel built with HZ=100 gives ~100 Hz
+    //                  no matter what was asked for. The counts here only assume that much.
+    u64 expected_samples = (100 * TEST_BURN_MS) / 1000;
+    result &= report->sample_count >= expected_samples / 4;
+
+    sampler_function_t *top[4] = {};
+    u32 top_count = c_sampler_report_get_top(report, top, ArrayCount(top));
+    bool8 found_fnv = false;
+    for(u32 top_index = 0; top_index < top_count; ++top_index)
+    {
+        found_fnv |= strcmp(top[top_index]->name, "test_sampler_fnv_loop") == 0;
+    }
+    result &= found_fnv;
+
+    // NOTE(Sleepster): The walk made it out of the leaf and all the way up to main(). Not checking for
+    //                  test_sampler_burn_main(), GCC leaves the frame out of a leaf that doesn't touch the stack
+    //                  even with -mno-omit-leaf-frame-pointer and then the leaf's caller gets skipped. Same for
+    //                  test_sampler_task() on the workers.
+    sampler_function_t *fnv_loop = test_find_function(report, "test_sampler_fnv_loop", false);
+    sampler_function_t *capture  = test_find_function(report, "test_capture", false);
+    sampler_function_t *main_fn  = test_find_function(report, "main", false);
+    result &= fnv_loop && fnv_loop->self_samples >= expected_samples / 8;
+    result &= capture && capture->total_samples >= fnv_loop->self_samples;
+    result &= main_fn && main_fn->total_samples >= fnv_loop->self_samples;
+
+    sampler_function_t *fill_loop = test_find_function(report, "test_sampler_fill_loop", false);
+    sampler_function_t *execute   = test_find_function(report, "c_threadpool_execute_task", false);
+    result &= test_find_function(report, "test_main", true) != null;
+    result &= test_find_function(report, "threadpool_worker", true) != null;
+    result &= fill_loop && fill_loop->self_samples > 0;
+    result &= execute && execute->total_samples >= fill_loop->self_samples;
+
+    result &= test_file_contains("test_sampler.folded", "test_main;");
+    result &= test_file_contains("test_sampler.folded", ";main;test_capture;");
+    result &= test_file_contains("test_sampler.folded", "threadpool_worker;");
+
+    c_sampler_report_destroy(report);
+    free(report);
+    remove("test_sampler.smpl");
+    remove("test_sampler.folded");
+
+    printf("capture: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+// NOTE(Sleepster): A capture that isn't one gets turned away instead of read.
+internal_api bool8
+test_bad_capture()
+{
+    bool8 result = true;
+
+    FILE *file = fopen("test_sampler_bad.smpl", "wb");
+    fprintf(file, "definitely not a capture");
+    fclose(file);
+
+    sampler_report_t *report = (sampler_report_t*)calloc(1, sizeof(sampler_report_t));
+    result &= !c_sampler_report_load(report, STR("test_sampler_bad.smpl"));
+    c_sampler_report_destroy(report);
+    result &= !c_sampler_report_load(report, STR("test_sampler_missing.smpl"));
+    c_sampler_report_destroy(report);
+    free(report);
+    remove("test_sampler_bad.smpl");
+
+    printf("bad capture: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+int
+main(void)
+{
+    for(u32 byte_index = 0; byte_index < TEST_BUFFER_SIZE; ++byte_index) test_buffer[byte_index] = (byte)byte_index;
+
+    bool8 passed = test_capture();
+    passed &= test_bad_capture();
+
+    Assert(passed);
+    return(0);
+}
@@ -0,0 +1,251 @@
+/* ========================================================================
+   $File: stats_export.cpp $
+   $Date: October 19 2026 08:00 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_stats_export.h>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_profiler.cpp>
+#include <c_memory_telemetry.cpp>
+#include <c_stats_export.cpp>
+
+#define TEST_EXPORT_NAME    "test_stats_export"
+#define TEST_RACE_FRAMES    (500000)
+
+internal_api stats_export_frame_t
+test_make_frame(float32 frame_ms, u64 tick_index)
+{
+    stats_export_frame_t result = {};
+    result.frame_ms                  = frame_ms;
+    result.render_wait_ms            = 1.5f;
+    result.tick_index                = tick_index;
+    result.threadpool_queued         = 7;
+    result.asset_loads_in_flight     = 2;
+    result.network.packets_sent      = tick_index;
+    result.network.bytes_sent        = tick_index * 100;
+    result.network.connected_clients = 3;
+    result.network.is_host           = 1;
+
+    return(result);
+}
+
+// NOTE(Sleepster): The reader maps the region a second time, the same as another process would.
+internal_api bool8
+test_round_trip()
+{
+    bool8 result = true;
+
+    memory_arena_t arena = c_arena_create(MB(1));
+    c_memory_telemetry_register_arena("test_arena", &arena);
+    c_arena_push_size(&arena, KB(8));
+    c_memory_telemetry_frame_end();
+
+    stats_exporter_t *exporter = (stats_exporter_t*)calloc(1, sizeof(stats_exporter_t));
+    result &= c_stats_export_open(exporter, TEST_EXPORT_NAME);
+
+    sys_shared_memory_t shared = {};
+    result &= c_stats_export_attach(&shared, TEST_EXPORT_NAME);
+
+    // NOTE(Sleepster): Nothing published yet.
+    stats_export_snapshot_t *snapshot = (stats_export_snapshot_t*)calloc(1, sizeof(stats_export_snapshot_t));
+    stats_export_region_t   *region   = (stats_export_region_t*)shared.data;
+    u64 sequence = 0;
+    result &= region && !c_stats_export_read(region, snapshot, &sequence, 4);
+
+    // NOTE(Sleepster): Five quarter second frames at two ticks each, the one second window closes on the fourth.
+    for(u32 frame_index = 1; frame_index <= 5; ++frame_index)
+    {
+        stats_export_frame_t frame = test_make_frame(250.0f, frame_index * 2);
+        c_stats_export_frame_end(exporter, &frame);
+    }
+
+    result &= region && c_stats_export_read(region, snapshot, &sequence, 4);
+    result &= sequence == 10 && snapshot->frame_index == 5 && snapshot->tick_index == 10;
+    result &= snapshot->frame_ms == 250.0f && snapshot->uptime_seconds == 1.25;
+    result &= snapshot->frames_per_second == 4.0f && snapshot->ticks_per_second == 8.0f;
+    result &= snapshot->frame_ms_average == 250.0f && snapshot->frame_ms_max == 250.0f;
+    result &= snapshot->threadpool_queued == 7 && snapshot->asset_loads_in_flight == 2;
+    result &= snapshot->network.packets_sent == 10 && snapshot->network.bytes_sent == 1000;
+    result &= snapshot->network.connected_clients == 3 && snapshot->network.is_host == 1;
+
+    // NOTE(Sleepster): The telemetry's own dynarrays entry is in there too.
+    stats_export_memory_t *memory = null;
+    for(u32 entry_index = 0; entry_index < snapshot->memory_entry_count; ++entry_index)
+    {
+        if(strcmp(snapshot->memory[entry_index].name, "test_arena") == 0) memory = snapshot->memory + entry_index;
+    }
+    result &= memory && memory->kind == MTK_Arena;
+    result &= memory && memory->current_bytes == KB(8) && memory->reserved_bytes >= MB(1);
+    result &= snapshot->memory_total.current_bytes >= KB(8);
+
+    // NOTE(Sleepster): Mid write, a reader gives up instead of handing back half a frame.
+    AtomicStore64(&exporter->region->header.sequence, exporter->sequence + 1);
+    result &= !c_stats_export_read(region, snapshot, &sequence, 4);
+    AtomicStore64(&exporter->region->header.sequence, exporter->sequence);
+    result &= c_stats_export_read(region, snapshot, &sequence, 4);
+
+    sys_shared_memory_close(&shared);
+    c_stats_export_close(exporter);
+
+    // NOTE(Sleepster): Closing removes the name.
+    result &= !c_stats_export_attach(&shared, TEST_EXPORT_NAME);
+
+    c_memory_telemetry_unregister(&arena);
+    c_arena_destroy(&arena);
+    free(snapshot);
+    free(exporter);
+
+    printf("round trip: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+// NOTE(Sleepster): A reader built against another layout refuses it instead of reading garbage.
+internal_api bool8
+test_version()
+{
+    bool8 result = true;
+
+    stats_exporter_t *exporter = (stats_exporter_t*)calloc(1, sizeof(stats_exporter_t));
+    result &= c_stats_export_open(exporter, TEST_EXPORT_NAME);
+
+    sys_shared_memory_t shared = {};
+    exporter->region->header.version = STATS_EXPORT_VERSION + 1;
+    result &= !c_stats_export_attach(&shared, TEST_EXPORT_NAME);
+
+    exporter->region->header.version       = STATS_EXPORT_VERSION;
+    exporter->region->header.snapshot_size = sizeof(stats_export_snapshot_t) + 8;
+    result &= !c_stats_export_attach(&shared, TEST_EXPORT_NAME);
+
+    exporter->region->header.snapshot_size = sizeof(stats_export_snapshot_t);
+    result &= c_stats_export_attach(&shared, TEST_EXPORT_NAME);
+    sys_shared_memory_close(&shared);
+
+    c_stats_export_close(exporter);
+    free(exporter);
+
+    printf("version: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+internal_api u32
+test_writer_proc(void *user_data)
+{
+    stats_exporter_t *exporter = (stats_exporter_t*)user_data;
+    for(u64 frame_index = 1; frame_index <= TEST_RACE_FRAMES; ++frame_index)
+    {
+        stats_export_frame_t frame = test_make_frame((float32)frame_index, frame_index);
+        c_stats_export_frame_end(exporter, &frame);
+    }
+
+    return(0);
+}
+
+// NOTE(Sleepster): Every field of a frame comes from the same frame index, a torn read would mix two of them.
+internal_api bool8
+test_race()
+{
+    bool8 result = true;
+
+    stats_exporter_t *exporter = (stats_exporter_t*)calloc(1, sizeof(stats_exporter_t));
+    result &= c_stats_export_open(exporter, TEST_EXPORT_NAME);
+
+    sys_shared_memory_t shared = {};
+    result &= c_stats_export_attach(&shared, TEST_EXPORT_NAME);
+    stats_export_region_t   *region   = (stats_export_region_t*)shared.data;
+    stats_export_snapshot_t *snapshot = (stats_export_snapshot_t*)calloc(1, sizeof(stats_export_snapshot_t));
+
+    sys_thread_t writer = sys_thread_create(test_writer_proc, exporter, false);
+    u32 read_count   = 0;
+    u32 torn_count   = 0;
+    u64 last_frame   = 0;
+    while(region && last_frame < TEST_RACE_FRAMES)
+    {
+        u64 sequence = 0;
+        if(c_stats_export_read(region, snapshot, &sequence, 1))
+        {
+            ++read_count;
+            bool8 matches = snapshot->tick_index == snapshot->frame_index && snapshot->frame_ms == (float32)snapshot->frame_index;
+            matches      &= snapshot->network.bytes_sent == snapshot->frame_index * 100 && sequence == snapshot->frame_index * 2;
+            matches      &= snapshot->frame_index >= last_frame;
+            if(!matches) ++torn_count;
+            last_frame = snapshot->frame_index;
+        }
+    }
+    sys_thread_join(&writer);
+    result &= read_count > 0 && torn_count == 0;
+
+    sys_shared_memory_close(&shared);
+    c_stats_export_close(exporter);
+    free(snapshot);
+    free(exporter);
+
+    printf("race: '%u' reads, '%u' torn, %s\n", read_count, torn_count, result ? "passed" : "FAILED");
+    return(result);
+}
+
+internal_api bool8
+test_prometheus()
+{
+    bool8 result = true;
+
+    stats_export_snapshot_t *snapshot = (stats_export_snapshot_t*)calloc(1, sizeof(stats_export_snapshot_t));
+    snapshot->frame_index                  = 42;
+    snapshot->frames_per_second            = 60.0f;
+    snapshot->network.packets_received     = 9;
+    snapshot->memory_entry_count           = 1;
+    snapshot->memory_total.current_bytes   = 4096;
+    snapshot->memory[0].current_bytes      = 4096;
+    snapshot->memory[0].kind               = MTK_Zone;
+    snprintf(snapshot->memory_total.name, sizeof(snapshot->memory_total.name), "total");
+    snprintf(snapshot->memory[0].name,    sizeof(snapshot->memory[0].name),    "asset_zone");
+
+    char *text = (char*)calloc(1, STATS_EXPORT_PROMETHEUS_SIZE);
+    u32 text_length = c_stats_export_format_prometheus(snapshot, text, STATS_EXPORT_PROMETHEUS_SIZE);
+    result &= text_length > 0 && text_length == strlen(text);
+    result &= strstr(text, "# TYPE engine_frames_total counter\nengine_frames_total 42\n") != null;
+    result &= strstr(text, "engine_frames_per_second 60\n") != null;
+    result &= strstr(text, "engine_network_packets_received_total 9\n") != null;
+    result &= strstr(text, "engine_memory_current_bytes{name=\"total\",kind=\"total\"} 4096\n") != null;
+    result &= strstr(text, "engine_memory_current_bytes{name=\"asset_zone\",kind=\"zone\"} 4096\n") != null;
+
+    // NOTE(Sleepster): Too small a buffer is a 0, never half the metrics.
+    result &= c_stats_export_format_prometheus(snapshot, text, 256) == 0;
+
+    free(text);
+    free(snapshot);
+
+    printf("prometheus: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+int
+main(void)
+{
+    bool8 passed = test_round_trip();
+    passed &= test_version();
+    passed &= test_race();
+    passed &= test_prometheus();
+
+    Assert(passed);
+    return(0);
+}
@@ -0,0 +1,330 @@
+/* ========================================================================
+   $File: task_graph.cpp $
+   $Date: October 18 2026 11:05 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_threadpool.h>
+#include <c_threadpool.cpp>
+#include <c_profiler.cpp>
+#include <c_sampler.cpp>
+#include <c_queue.h>
+#include <c_queue.cpp>
+#include <c_task_graph.h>
+#include <c_task_graph.cpp>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+
+#define TEST_FRAME_COUNT      (500)
+#define TEST_OVERLAP_TIMEOUT  (2000000)
+
+struct test_node_data_t
+{
+    u32           node_id;
+    volatile u32  finish_order;
+    bool8         must_be_on_main_thread;
+    volatile u32  wrong_thread_count;
+};
+
+struct test_state_t
+{
+    volatile u32      next_finish_order;
+    test_node_data_t  nodes[TASK_GRAPH_MAX_NODES];
+
+    volatile u32      overlap_started[2];
+    volatile u32      overlap_failures;
+};
+
+global_variable test_state_t test_state;
+global_variable threadpool_t test_pool;
+global_variable u32          test_main_thread_id;
+global_variable char         test_node_names[TASK_GRAPH_MAX_NODES][16];
+
+void
+test_record_node(void *user_data)
+{
+    test_node_data_t *data = (test_node_data_t*)user_data;
+    if(data->must_be_on_main_thread && (u32)GetThreadID() != test_main_thread_id)
+    {
+        AtomicIncrement32(&data->wrong_thread_count);
+    }
+    AtomicStore32(&data->finish_order, AtomicIncrement32(&test_state.next_finish_order) + 1);
+}
+
+// NOTE(Sleepster): Each side waits until the other one has started, that only works if they really overlap.
+void
+test_overlap_node(void *user_data)
+{
+    u32 side = (u32)(usize)user_data;
+    AtomicStore32(&test_state.overlap_started[side], 1);
+
+    u32 attempts = 0;
+    while(AtomicLoad32(&test_state.overlap_started[side ^ 1]) == 0)
+    {
+        if(++attempts > TEST_OVERLAP_TIMEOUT)
+        {
+            AtomicIncrement32(&test_state.overlap_failures);
+            break;
+        }
+        sys_thread_yield();
+    }
+}
+
+internal_api bool8
+test_edges()
+{
+    bool8 result = true;
+
+    task_graph_t graph;
+    c_task_graph_init(&graph, &test_pool);
+    u32 input  = c_task_graph_add_resource(&graph, "input");
+    u32 world  = c_task_graph_add_resource(&graph, "world");
+    u32 render = c_task_graph_add_resource(&graph, "render");
+
+    u32 poll_input = c_task_graph_add_node(&graph, "poll_input", test_record_node, null);
+    u32 simulate   = c_task_graph_add_node(&graph, "simulate",   test_record_node, null);
+    u32 audio      = c_task_graph_add_node(&graph, "audio",      test_record_node, null);
+    u32 build      = c_task_graph_add_node(&graph, "build",      test_record_node, null);
+    u32 clear      = c_task_graph_add_node(&graph, "clear",      test_record_node, null);
+    c_task_graph_node_writes(&graph, poll_input, input);
+    c_task_graph_node_reads(&graph,  simulate,   input);
+    c_task_graph_node_writes(&graph, simulate,   world);
+    c_task_graph_node_reads(&graph,  audio,      input);
+    c_task_graph_node_reads(&graph,  build,      world);
+    c_task_graph_node_reads(&graph,  build,      input);
+    c_task_graph_node_writes(&graph, build,      render);
+    c_task_graph_node_writes(&graph, clear,      input);
+    result &= c_task_graph_build(&graph);
+
+    // NOTE(Sleepster): build's read of input is already covered through simulate. clear has to wait on every reader
+    //                  of input (write after read) but simulate is implied through build, so only audio and build are left.
+    result &= graph.nodes[poll_input].predecessor_mask == 0;
+    result &= graph.nodes[simulate].predecessor_mask   == c_task_graph_node_bit(poll_input);
+    result &= graph.nodes[audio].predecessor_mask      == c_task_graph_node_bit(poll_input);
+    result &= graph.nodes[build].predecessor_mask      == c_task_graph_node_bit(simulate);
+    result &= graph.nodes[clear].predecessor_mask      == (c_task_graph_node_bit(audio) | c_task_graph_node_bit(build));
+    result &= graph.root_mask == c_task_graph_node_bit(poll_input);
+    result &= graph.edge_count == 5;
+
+    // NOTE(Sleepster): Audio is the only node off of the critical path with every cost the same.
+    result &= graph.nodes[simulate].is_critical && graph.nodes[build].is_critical && !graph.nodes[audio].is_critical;
+    result &= graph.critical_path_ms == TASK_GRAPH_DEFAULT_COST_MS * 4;
+
+    c_task_graph_destroy(&graph);
+    printf("edges: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+// NOTE(Sleepster): Runs the graph for TEST_FRAME_COUNT frames, every node that didn't finish after all of its
+//                  predecessors is an error.
+internal_api u32
+test_execute_frames(task_graph_t *graph)
+{
+    u32 result = 0;
+    for(u32 frame_index = 0;
+        frame_index < TEST_FRAME_COUNT;
+        ++frame_index)
+    {
+        for(u32 node_id = 0; node_id < graph->node_count; ++node_id) test_state.nodes[node_id].finish_order = 0;
+        c_task_graph_execute(graph);
+
+        for(u32 node_id = 0;
+            node_id < graph->node_count;
+            ++node_id)
+        {
+            task_graph_node_t *node = graph->nodes + node_id;
+            for(u32 predecessor_id = 0;
+                predecessor_id < node_id;
+                ++predecessor_id)
+            {
+                if((node->predecessor_mask & c_task_graph_node_bit(predecessor_id)) &&
+                   test_state.nodes[predecessor_id].finish_order >= test_state.nodes[node_id].finish_order)
+                {
+                    ++result;
+                }
+            }
+            if(test_state.nodes[node_id].finish_order == 0) ++result;
+        }
+    }
+
+    return(result);
+}
+
+/* NOTE(Sleepster): A made up frame, a few chains that fan out and back in with main thread nodes mixed in. Every node
+ * has to finish after all of its predecessors, every frame.
+ */
+internal_api bool8
+test_ordering()
+{
+    bool8 result = true;
+    ZeroStruct(test_state);
+
+    task_graph_t graph;
+    c_task_graph_init(&graph, &test_pool);
+
+    u32 resources[8];
+    const char *resource_names[8] = {"r0", "r1", "r2", "r3", "r4", "r5", "r6", "r7"};
+    for(u32 resource_index = 0; resource_index < 8; ++resource_index)
+    {
+        resources[resource_index] = c_task_graph_add_resource(&graph, resource_names[resource_index]);
+    }
+
+    const char *node_names[24] = {"n0",  "n1",  "n2",  "n3",  "n4",  "n5",  "n6",  "n7",
+                                  "n8",  "n9",  "n10", "n11", "n12", "n13", "n14", "n15",
+                                  "n16", "n17", "n18", "n19", "n20", "n21", "n22", "n23"};
+    u32 random_state = 0x1234567;
+    for(u32 node_index = 0; node_index < 24; ++node_index)
+    {
+        test_node_data_t *data = test_state.nodes + node_index;
+        data->node_id                = node_index;
+        data->must_be_on_main_thread = (node_index % 7) == 3;
+
+        u32 node_id = c_task_graph_add_node(&graph, node_names[node_index], test_record_node, data,
+                                            data->must_be_on_main_thread ? TGNF_MainThread : TGNF_None);
+        for(u32 access_index = 0; access_index < 3; ++access_index)
+        {
+            random_state ^= random_state << 13;
+            random_state ^= random_state >> 17;
+            random_state ^= random_state << 5;
+
+            u32 resource = resources[random_state % 8];
+            if((random_state >> 8) % 3 == 0) c_task_graph_node_writes(&graph, node_id, resource);
+            else                             c_task_graph_node_reads(&graph,  node_id, resource);
+        }
+    }
+    result &= c_task_graph_build(&graph);
+
+    u32 order_errors = test_execute_frames(&graph);
+    u32 wrong_thread_count = 0;
+    for(u32 node_id = 0; node_id < graph.node_count; ++node_id) wrong_thread_count += test_state.nodes[node_id].wrong_thread_count;
+
+    result &= order_errors == 0 && wrong_thread_count == 0;
+    result &= test_state.next_finish_order == TEST_FRAME_COUNT * graph.node_count;
+    printf("ordering (%u nodes, %u edges, %u frames): '%u' out of order, '%u' main thread nodes off the main thread... %s\n",
+           graph.node_count, graph.edge_count, TEST_FRAME_COUNT, order_errors, wrong_thread_count, result ? "passed" : "FAILED");
+
+    c_task_graph_destroy(&graph);
+    return(result);
+}
+
+/* NOTE(Sleepster): Past 32 nodes, where the masks need all 64 bits. 32 readers of 'low', then a chain through 'high'
+ * that only has predecessors with ids of 32 and up, then one node that writes 'low' after every reader and reads the
+ * end of the chain, 33 predecessors. Counting only the low 32 bits makes the chain roots and lets the last node go
+ * one predecessor early.
+ */
+internal_api bool8
+test_wide()
+{
+    bool8 result = true;
+    ZeroStruct(test_state);
+
+    task_graph_t graph;
+    c_task_graph_init(&graph, &test_pool);
+    u32 low  = c_task_graph_add_resource(&graph, "low");
+    u32 high = c_task_graph_add_resource(&graph, "high");
+
+    const u32 reader_count = 32;
+    const u32 chain_count  = 16;
+    for(u32 node_index = 0;
+        node_index < reader_count + chain_count + 1;
+        ++node_index)
+    {
+        test_node_data_t *data = test_state.nodes + node_index;
+        data->node_id = node_index;
+        snprintf(test_node_names[node_index], sizeof(test_node_names[node_index]), "wide%u", node_index);
+
+        u32 node_id = c_task_graph_add_node(&graph, test_node_names[node_index], test_record_node, data);
+        if(node_index < reader_count)
+        {
+            c_task_graph_node_reads(&graph, node_id, low);
+        }
+        else if(node_index < reader_count + chain_count)
+        {
+            if(node_index > reader_count) c_task_graph_node_reads(&graph, node_id, high);
+            c_task_graph_node_writes(&graph, node_id, high);
+        }
+        else
+        {
+            c_task_graph_node_writes(&graph, node_id, low);
+            c_task_graph_node_reads(&graph,  node_id, high);
+        }
+    }
+    result &= c_task_graph_build(&graph);
+
+    u32 last_id = reader_count + chain_count;
+    result &= graph.root_mask == (c_task_graph_node_bit(reader_count + 1) - 1);
+    result &= graph.nodes[reader_count + 1].predecessor_count == 1;
+    result &= graph.nodes[last_id - 1].predecessor_count == 1;
+    result &= graph.nodes[last_id].predecessor_count == reader_count + 1;
+    result &= graph.edge_count == (chain_count - 1) + (reader_count + 1);
+
+    u32 order_errors = test_execute_frames(&graph);
+    result &= order_errors == 0 && test_state.next_finish_order == TEST_FRAME_COUNT * graph.node_count;
+    printf("wide (%u nodes, %u edges, %u frames): '%u' out of order... %s\n",
+           graph.node_count, graph.edge_count, TEST_FRAME_COUNT, order_errors, result ? "passed" : "FAILED");
+
+    c_task_graph_destroy(&graph);
+    return(result);
+}
+
+internal_api bool8
+test_overlap(bool8 second_on_main_thread)
+{
+    bool8 result = true;
+    ZeroStruct(test_state);
+
+    task_graph_t graph;
+    c_task_graph_init(&graph, &test_pool);
+    u32 left  = c_task_graph_add_resource(&graph, "left");
+    u32 right = c_task_graph_add_resource(&graph, "right");
+
+    u32 first  = c_task_graph_add_node(&graph, "first",  test_overlap_node, (void*)0);
+    u32 second = c_task_graph_add_node(&graph, "second", test_overlap_node, (void*)1, second_on_main_thread ? TGNF_MainThread : TGNF_None);
+    c_task_graph_node_writes(&graph, first,  left);
+    c_task_graph_node_writes(&graph, second, right);
+    result &= c_task_graph_build(&graph);
+    result &= graph.edge_count == 0;
+
+    c_task_graph_execute(&graph);
+    result &= test_state.overlap_failures == 0;
+
+    printf("overlap (%s): %s\n", second_on_main_thread ? "pool + main" : "pool + pool", result ? "passed" : "FAILED");
+    c_task_graph_destroy(&graph);
+    return(result);
+}
+
+int
+main(void)
+{
+    test_main_thread_id = (u32)GetThreadID();
+    c_threadpool_init(&test_pool, 4);
+
+    bool8 passed = test_edges();
+    passed &= test_ordering();
+    passed &= test_wide();
+    passed &= test_overlap(false);
+    passed &= test_overlap(true);
+
+    c_threadpool_destroy(&test_pool);
+
+    Assert(passed);
+    return(0);
+}
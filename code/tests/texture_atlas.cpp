@@ -0,0 +1,186 @@
+/* ========================================================================
+   $File: texture_atlas.cpp $
+   $Date: October 19 2026 11:10 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdlib.h>
+#include <stdio.h>
+
+#define MATH_IMPLEMENTATION
+#define HASH_TABLE_IMPLEMENTATION
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+#include <c_hash_table.h>
+
+#include <c_threadpool.h>
+#include <c_threadpool.cpp>
+#include <c_profiler.cpp>
+#include <c_sampler.cpp>
+#include <c_parallel.cpp>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_memory_telemetry.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+#include <c_perf_counters.cpp>
+
+// NOTE(Sleepster): The atlas never uploads here (no render context), these are only so the asset manager links
+//                  without the whole Vulkan backend.
+#include <r_vulkan_core.h>
+vulkan_shader_data_t
+r_vulkan_shader_create(vulkan_render_context_t *render_context, string_t filepath)
+{
+    vulkan_shader_data_t result = {};
+    return(result);
+}
+
+void
+r_vulkan_make_gpu_texture(vulkan_render_context_t *render_context, texture2D_t *texture)
+{
+}
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <s_asset_manager.cpp>
+
+#define TEST_ATLAS_SIZE     (2048)
+#define TEST_ICON_SIZE      (16)
+#define TEST_ICON_COUNT     (300)
+#define TEST_RESERVED_COUNT (256)
+
+struct test_icons_t
+{
+    asset_slot_t   slots[TEST_ICON_COUNT];
+    asset_handle_t handles[TEST_ICON_COUNT];
+};
+
+internal_api void
+test_make_icons(asset_manager_t *asset_manager, test_icons_t *icons)
+{
+    for(u32 icon_index = 0; icon_index < TEST_ICON_COUNT; ++icon_index)
+    {
+        asset_slot_t *slot = icons->slots + icon_index;
+        slot->type           = AT_Bitmap;
+        slot->texture.bitmap = s_asset_bitmap_create(asset_manager, TEST_ICON_SIZE, TEST_ICON_SIZE, 4, BMF_RGBA32);
+        memset(slot->texture.bitmap.pixels.data, icon_index & 0xFF, slot->texture.bitmap.pixels.count);
+
+        asset_handle_t *handle = icons->handles + icon_index;
+        handle->is_valid = true;
+        handle->type     = AT_Bitmap;
+        handle->slot     = slot;
+    }
+}
+
+// NOTE(Sleepster): 300 icons would fit in the pixels of one atlas many times over, the subtextures it reserved are
+//                  what runs out. Past those it has to turn them away, the packer would write past its array.
+internal_api bool8
+test_subtexture_capacity(asset_manager_t *asset_manager, test_icons_t *icons)
+{
+    bool8 result = true;
+
+    texture_atlas_t *atlas = s_texture_atlas_create(asset_manager, TEST_ATLAS_SIZE, 4, BMF_RGBA32, TEST_RESERVED_COUNT);
+    u32 added_count = 0;
+    for(u32 icon_index = 0; icon_index < TEST_ICON_COUNT; ++icon_index)
+    {
+        if(s_texture_atlas_add_texture(atlas, icons->handles + icon_index)) ++added_count;
+    }
+    result &= added_count == TEST_RESERVED_COUNT && atlas->merge_counter == TEST_RESERVED_COUNT;
+
+    s_texture_atlas_pack_added_textures(null, atlas);
+    result &= atlas->packed_subtexture_count == TEST_RESERVED_COUNT;
+    result &= !s_texture_atlas_add_texture(atlas, icons->handles + TEST_RESERVED_COUNT);
+
+    subtexture_data_t *last = icons->handles[TEST_RESERVED_COUNT - 1].subtexture_data;
+    result &= last == atlas->packed_subtextures + (TEST_RESERVED_COUNT - 1);
+    result &= last->atlas_subtexture_index == TEST_RESERVED_COUNT - 1 && last->size.x == TEST_ICON_SIZE;
+    s_texture_atlas_destroy(asset_manager, atlas);
+
+    // NOTE(Sleepster): Reserved for all of them, all of them go in one atlas and land where their UVs say.
+    atlas = s_texture_atlas_create(asset_manager, TEST_ATLAS_SIZE, 4, BMF_RGBA32, TEST_ICON_COUNT);
+    for(u32 icon_index = 0; icon_index < TEST_ICON_COUNT; ++icon_index)
+    {
+        result &= s_texture_atlas_add_texture(atlas, icons->handles + icon_index);
+    }
+    s_texture_atlas_pack_added_textures(null, atlas);
+    result &= atlas->packed_subtexture_count == TEST_ICON_COUNT;
+
+    byte *atlas_pixels = atlas->bitmap_data->pixels.data;
+    for(u32 icon_index = 0; icon_index < TEST_ICON_COUNT; ++icon_index)
+    {
+        subtexture_data_t *subtexture = icons->handles[icon_index].subtexture_data;
+        result &= subtexture == atlas->packed_subtextures + icon_index && subtexture->atlas == atlas;
+
+        u32 pixel_x = (u32)subtexture->uv_min.x + TEST_ICON_SIZE - 1;
+        u32 pixel_y = (u32)subtexture->uv_min.y + TEST_ICON_SIZE - 1;
+        result &= atlas_pixels[((pixel_y * TEST_ATLAS_SIZE) + pixel_x) * 4] == (icon_index & 0xFF);
+    }
+    s_texture_atlas_destroy(asset_manager, atlas);
+
+    printf("subtexture capacity: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+// NOTE(Sleepster): An atlas' ID is its slot, a destroyed atlas in the middle doesn't hand its ID out twice.
+internal_api bool8
+test_atlas_ids(asset_manager_t *asset_manager)
+{
+    bool8 result = true;
+    texture_atlas_registry_t *registry = &asset_manager->atlas_registry;
+
+    texture_atlas_t *first  = s_texture_atlas_create(asset_manager, 64, 4, BMF_RGBA32, 4);
+    texture_atlas_t *second = s_texture_atlas_create(asset_manager, 64, 4, BMF_RGBA32, 4);
+    texture_atlas_t *third  = s_texture_atlas_create(asset_manager, 64, 4, BMF_RGBA32, 4);
+    result &= first->ID == 0 && second->ID == 1 && third->ID == 2 && registry->current_atlas_count == 3;
+
+    s_texture_atlas_destroy(asset_manager, second);
+    result &= registry->current_atlas_count == 2;
+
+    texture_atlas_t *refill = s_texture_atlas_create(asset_manager, 64, 4, BMF_RGBA32, 4);
+    result &= refill == registry->atlases + 1 && refill->ID == 1 && refill->ID != third->ID;
+    result &= registry->current_atlas_count == 3;
+
+    s_texture_atlas_destroy(asset_manager, first);
+    texture_atlas_t *another = s_texture_atlas_create(asset_manager, 64, 4, BMF_RGBA32, 4);
+    result &= another->ID == 0 && another->ID != refill->ID;
+
+    s_texture_atlas_destroy(asset_manager, another);
+    s_texture_atlas_destroy(asset_manager, refill);
+    s_texture_atlas_destroy(asset_manager, third);
+    result &= registry->current_atlas_count == 0;
+
+    printf("atlas ids: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+int
+main(void)
+{
+    // NOTE(Sleepster): The pack splits its copies over the main threadpool, the caller does them all with no workers.
+    c_global_context_init();
+    c_threadpool_init(&global_context->main_threadpool, 0);
+
+    asset_manager_t *asset_manager = (asset_manager_t*)calloc(1, sizeof(asset_manager_t));
+    asset_manager->asset_allocator = c_za_create(MB(64));
+    test_icons_t *icons = (test_icons_t*)calloc(1, sizeof(test_icons_t));
+    test_make_icons(asset_manager, icons);
+
+    bool8 passed = test_subtexture_capacity(asset_manager, icons);
+    passed &= test_atlas_ids(asset_manager);
+
+    c_za_destroy(asset_manager->asset_allocator);
+    free(icons);
+    free(asset_manager);
+
+    Assert(passed);
+    return(0);
+}
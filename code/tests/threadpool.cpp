@@ -11,6 +11,8 @@
 
 #include <c_threadpool.h>
 #include <c_threadpool.cpp>
+#include <c_profiler.cpp>
+#include <c_sampler.cpp>
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -25,6 +27,7 @@
 #include <c_file_api.cpp>
 #include <c_file_watcher.cpp>
 #include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
 
 struct test_data
 {
@@ -34,11 +37,14 @@ struct test_data
     bool8         jobs_produced;
 };
 
+global_variable volatile u32 tasks_run = 0;
+
 void 
 test_callback(void *user_data)
 {
     test_data *data = (test_data*)user_data;
     printf("thread: '%d', parent_id: '%d'\n", data->thread_id, data->parent_id);
+    AtomicIncrement32(&tasks_run);
 
     if(!data->jobs_produced)
     {
@@ -56,6 +62,54 @@ test_callback(void *user_data)
     }
 }
 
+struct wait_test_data
+{
+    threadpool_t *threadpool;
+    u32           parent_id;
+    volatile u32  children_done;
+};
+
+void
+wait_test_child_callback(void *user_data)
+{
+    wait_test_data *data = (wait_test_data*)user_data;
+    AtomicIncrement32(&data->children_done);
+}
+
+// NOTE(Sleepster): Waits on its children without blocking the worker, and the children have to be done when it wakes up.
+void
+wait_test_parent_callback(void *user_data)
+{
+    wait_test_data *data = (wait_test_data*)user_data;
+
+    threadpool_counter_t counter = {};
+    for(u32 child_index = 0;
+        child_index < 12;
+        ++child_index)
+    {
+        c_threadpool_add_task(data->threadpool, data, &wait_test_child_callback, TPTP_Low, &counter);
+    }
+    c_threadpool_wait_for_counter(data->threadpool, &counter);
+
+    printf("parent: '%d' woke up, children done: '%u'\n", data->parent_id, data->children_done);
+    Assert(data->children_done == 12);
+    AtomicIncrement32(&tasks_run);
+}
+
+struct inline_test_payload
+{
+    u32  index;
+    u32 *results;
+};
+
+void
+inline_test_callback(void *user_data)
+{
+    inline_test_payload *payload = (inline_test_payload*)user_data;
+    payload->results[payload->index] = payload->index * 2;
+    AtomicIncrement32(&tasks_run);
+}
+
 int
 main(void)
 {
@@ -76,5 +130,55 @@ main(void)
     }
     c_threadpool_flush_task_queues(threadpool);
 
+    // NOTE(Sleepster): 12 roots, each of them spawning 12 more from inside of the workers.
+    printf("tasks run: '%u'...\n", tasks_run);
+    Assert(tasks_run == (12 + (12 * 12)));
+
+    tasks_run = 0;
+    wait_test_data wait_data[64] = {};
+    threadpool_counter_t parents_counter = {};
+    for(u32 parent_index = 0;
+        parent_index < ArrayCount(wait_data);
+        ++parent_index)
+    {
+        wait_data[parent_index].threadpool = threadpool;
+        wait_data[parent_index].parent_id  = parent_index;
+        c_threadpool_add_task(threadpool, wait_data + parent_index, &wait_test_parent_callback, TPTP_High, &parents_counter);
+    }
+    c_threadpool_wait_for_counter(threadpool, &parents_counter);
+
+    printf("parents finished: '%u'...\n", tasks_run);
+    Assert(tasks_run == ArrayCount(wait_data));
+
+    // NOTE(Sleepster): Inline payloads, submitted as one batch that's bigger than a deque so it spills.
+    tasks_run = 0;
+    u32 batch_count = THREADPOOL_DEQUE_CAPACITY + 500;
+    u32 *batch_results = (u32*)malloc(sizeof(u32) * batch_count);
+    threadpool_task_t *batch = (threadpool_task_t*)malloc(sizeof(threadpool_task_t) * batch_count);
+    for(u32 task_index = 0;
+        task_index < batch_count;
+        ++task_index)
+    {
+        inline_test_payload payload = {task_index, batch_results};
+        batch[task_index] = c_threadpool_make_inline_task(&inline_test_callback, &payload, sizeof(payload));
+    }
+
+    threadpool_counter_t batch_counter = {};
+    c_threadpool_add_tasks(threadpool, batch, batch_count, TPTP_Low, &batch_counter);
+    c_threadpool_wait_for_counter(threadpool, &batch_counter);
+
+    printf("batch tasks run: '%u'...\n", tasks_run);
+    Assert(tasks_run == batch_count);
+    for(u32 task_index = 0;
+        task_index < batch_count;
+        ++task_index)
+    {
+        Assert(batch_results[task_index] == task_index * 2);
+    }
+    free(batch);
+    free(batch_results);
+
+    c_threadpool_destroy(threadpool);
+
     return(0);
 }
@@ -0,0 +1,338 @@
+/* ========================================================================
+   $File: trace.cpp $
+   $Date: October 19 2026 02:30 am $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <c_intrinsics.h>
+#include <c_base.h>
+#include <c_types.h>
+#include <c_math.h>
+
+#include <c_threadpool.h>
+#include <c_threadpool.cpp>
+#include <c_profiler.h>
+#include <c_profiler.cpp>
+#include <c_sampler.cpp>
+#include <c_queue.h>
+#include <c_queue.cpp>
+#include <c_trace.h>
+#include <c_trace.cpp>
+
+#include <p_platform_data.h>
+#include <p_platform_data.cpp>
+
+#include <c_string.cpp>
+#include <c_dynarray_impl.cpp>
+#include <c_globals.cpp>
+#include <c_memory_arena.cpp>
+#include <c_file_api.cpp>
+#include <c_file_watcher.cpp>
+#include <c_zone_allocator.cpp>
+#include <c_lock_profiler.cpp>
+
+#if PROFILER_ENABLED
+
+#define TEST_FRAME_COUNT     (3)
+#define TEST_TASKS_PER_FRAME (64)
+
+global_variable threadpool_t test_pool;
+
+struct test_file_t
+{
+    char *data;
+    u64   size;
+};
+
+// NOTE(Sleepster): What we count in the .perfetto-trace, track events by type plus the descriptors.
+struct test_perfetto_counts_t
+{
+    u32   packet_count;
+    u32   descriptor_count;
+    u32   type_counts[5];
+    bool8 first_packet_clears_state;
+    bool8 is_well_formed;
+};
+
+internal_api test_file_t
+test_read_file(const char *path)
+{
+    test_file_t result = {};
+
+    FILE *file = fopen(path, "rb");
+    if(file)
+    {
+        fseek(file, 0, SEEK_END);
+        result.size = (u64)ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        result.data = (char*)malloc(result.size + 1);
+        result.size = fread(result.data, 1, result.size, file);
+        result.data[result.size] = 0;
+        fclose(file);
+    }
+
+    return(result);
+}
+
+internal_api u32
+test_count_occurrences(test_file_t *file, const char *needle)
+{
+    u32 result = 0;
+    for(char *at = strstr(file->data, needle); at; at = strstr(at + 1, needle))
+    {
+        ++result;
+    }
+
+    return(result);
+}
+
+internal_api bool8
+test_pb_varint(byte **at, byte *end, u64 *value)
+{
+    bool8 result = false;
+    *value = 0;
+    for(u32 shift = 0; *at < end && shift < 64; shift += 7)
+    {
+        byte next = *(*at)++;
+        *value |= (u64)(next & 0x7F) << shift;
+        if((next & 0x80) == 0)
+        {
+            result = true;
+            break;
+        }
+    }
+
+    return(result);
+}
+
+// NOTE(Sleepster): Walks one message, hands back where 'wanted_field' is if it's a length delimited field.
+internal_api bool8
+test_pb_walk(byte *at, byte *end, u32 wanted_field, byte **field_start, byte **field_end, u64 *varint_field_values)
+{
+    bool8 result = true;
+    while(at < end && result)
+    {
+        u64 tag = 0;
+        result = test_pb_varint(&at, end, &tag);
+
+        u32 field     = (u32)(tag >> 3);
+        u32 wire_type = (u32)(tag & 7);
+        if(wire_type == TPWT_Varint)
+        {
+            u64 value = 0;
+            result &= test_pb_varint(&at, end, &value);
+            if(varint_field_values && field < 64) varint_field_values[field] = value;
+        }
+        else if(wire_type == TPWT_Fixed64)
+        {
+            at += 8;
+        }
+        else if(wire_type == TPWT_Bytes)
+        {
+            u64 size = 0;
+            result &= test_pb_varint(&at, end, &size) && at + size <= end;
+            if(result && field == wanted_field)
+            {
+                *field_start = at;
+                *field_end   = at + size;
+            }
+            at += size;
+        }
+        else
+        {
+            result = false;
+        }
+    }
+    result &= at == end;
+
+    return(result);
+}
+
+internal_api test_perfetto_counts_t
+test_count_perfetto(test_file_t *file)
+{
+    test_perfetto_counts_t result = {};
+    result.is_well_formed = true;
+
+    byte *at  = (byte*)file->data;
+    byte *end = at + file->size;
+    while(at < end && result.is_well_formed)
+    {
+        u64 tag  = 0;
+        u64 size = 0;
+        result.is_well_formed &= test_pb_varint(&at, end, &tag) && tag == ((TPF_Trace_Packet << 3) | TPWT_Bytes);
+        result.is_well_formed &= test_pb_varint(&at, end, &size) && at + size <= end;
+        if(!result.is_well_formed) break;
+
+        byte *packet_end = at + size;
+        byte *event      = null;
+        byte *event_end  = null;
+        u64   packet_values[64] = {};
+        result.is_well_formed &= test_pb_walk(at, packet_end, TPF_Packet_TrackEvent, &event, &event_end, packet_values);
+        result.is_well_formed &= packet_values[TPF_Packet_TrustedPacketSequenceID] == TRACE_SEQUENCE_ID;
+        if(result.packet_count == 0)
+        {
+            result.first_packet_clears_state = packet_values[TPF_Packet_SequenceFlags] == TRACE_PERFETTO_SEQUENCE_CLEARED;
+        }
+
+        if(event)
+        {
+            byte *unused      = null;
+            u64   event_values[64] = {};
+            result.is_well_formed &= test_pb_walk(event, event_end, 0, &unused, &unused, event_values);
+            u64 type = event_values[TPF_TrackEvent_Type];
+            if(type < ArrayCount(result.type_counts)) ++result.type_counts[type];
+        }
+        else
+        {
+            ++result.descriptor_count;
+        }
+
+        ++result.packet_count;
+        at = packet_end;
+    }
+
+    return(result);
+}
+
+void
+test_task_work(void *user_data)
+{
+    PROFILE_SCOPE("work");
+    u64 start = rdtsc();
+    while(rdtsc() - start < 2000)
+    {
+        _mm_pause();
+    }
+}
+
+// NOTE(Sleepster): A few frames of tasks, then both files have to agree with what we put in.
+internal_api bool8
+test_capture_frames(trace_capture_t *trace)
+{
+    bool8 result = c_trace_start(trace, "test_trace", TEST_FRAME_COUNT);
+    for(u32 frame_index = 0;
+        frame_index < TEST_FRAME_COUNT;
+        ++frame_index)
+    {
+        result &= trace->is_capturing;
+
+        threadpool_counter_t counter = {};
+        for(u32 task_index = 0; task_index < TEST_TASKS_PER_FRAME; ++task_index)
+        {
+            c_threadpool_add_task(&test_pool, null, test_task_work, TPTP_High, &counter);
+        }
+        c_threadpool_wait_for_counter(&test_pool, &counter);
+        TRACE_COUNTER("test_counter", frame_index);
+
+        PROFILE_FRAME_END();
+        c_trace_frame_end(trace);
+    }
+    result &= !trace->is_capturing;
+
+    u32 task_count = TEST_FRAME_COUNT * TEST_TASKS_PER_FRAME;
+    test_file_t json = test_read_file("test_trace_0.json");
+    result &= json.data != null;
+    if(json.data)
+    {
+        result &= strncmp(json.data, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 38) == 0;
+        result &= json.size > 4 && strcmp(json.data + json.size - 4, "\n]}\n") == 0;
+        result &= test_count_occurrences(&json, "\"ph\":\"B\"") == test_count_occurrences(&json, "\"ph\":\"E\"");
+        result &= test_count_occurrences(&json, "{\"name\":\"work\",\"ph\":\"B\"") == task_count;
+        result &= test_count_occurrences(&json, "\"ph\":\"s\"") == task_count;
+        result &= test_count_occurrences(&json, "\"ph\":\"f\"") == task_count;
+        result &= test_count_occurrences(&json, "{\"name\":\"test_counter\",\"ph\":\"C\"") == TEST_FRAME_COUNT;
+        result &= test_count_occurrences(&json, "\"args\":{\"name\":\"main\"}") == 1;
+        free(json.data);
+    }
+
+    test_file_t perfetto = test_read_file("test_trace_0.perfetto-trace");
+    result &= perfetto.data != null;
+    if(perfetto.data)
+    {
+        test_perfetto_counts_t counts = test_count_perfetto(&perfetto);
+        result &= counts.is_well_formed && counts.first_packet_clears_state;
+        result &= counts.type_counts[TPET_SliceBegin] == counts.type_counts[TPET_SliceEnd];
+        result &= counts.type_counts[TPET_SliceBegin] >= task_count * 2;
+        result &= counts.type_counts[TPET_Instant]    == task_count * 2;
+        result &= counts.type_counts[TPET_Counter]    == TEST_FRAME_COUNT;
+        result &= counts.descriptor_count >= 3;
+        free(perfetto.data);
+    }
+
+    printf("capture frames ('%llu' events): %s\n", (unsigned long long)trace->events_written, result ? "passed" : "FAILED");
+    return(result);
+}
+
+// NOTE(Sleepster): A zone still open when the capture stops gets closed in the files, the next capture gets the next index.
+internal_api bool8
+test_open_at_stop(trace_capture_t *trace)
+{
+    bool8 result = c_trace_start(trace, "test_trace", 0);
+    PROFILE_BEGIN("open_at_stop");
+    PROFILE_FRAME_END();
+    c_trace_frame_end(trace);
+    result &= trace->is_capturing;
+    c_trace_stop(trace);
+    PROFILE_END();
+    PROFILE_FRAME_END();
+
+    test_file_t json = test_read_file("test_trace_1.json");
+    result &= json.data != null;
+    if(json.data)
+    {
+        result &= test_count_occurrences(&json, "{\"name\":\"open_at_stop\",\"ph\":\"B\"") == 1;
+        result &= test_count_occurrences(&json, "\"ph\":\"B\"") == test_count_occurrences(&json, "\"ph\":\"E\"");
+        free(json.data);
+    }
+
+    test_file_t perfetto = test_read_file("test_trace_1.perfetto-trace");
+    result &= perfetto.data != null;
+    if(perfetto.data)
+    {
+        test_perfetto_counts_t counts = test_count_perfetto(&perfetto);
+        result &= counts.is_well_formed;
+        result &= counts.type_counts[TPET_SliceBegin] == 1 && counts.type_counts[TPET_SliceEnd] == 1;
+        free(perfetto.data);
+    }
+
+    printf("open at stop: %s\n", result ? "passed" : "FAILED");
+    return(result);
+}
+
+int
+main(void)
+{
+    c_threadpool_init(&test_pool, 4);
+    PROFILE_SET_THREAD_NAME("main");
+    PROFILE_FRAME_END();
+
+    trace_capture_t *trace = (trace_capture_t*)calloc(1, sizeof(trace_capture_t));
+    bool8 passed = test_capture_frames(trace);
+    passed &= test_open_at_stop(trace);
+
+    remove("test_trace_0.json");
+    remove("test_trace_0.perfetto-trace");
+    remove("test_trace_1.json");
+    remove("test_trace_1.perfetto-trace");
+    free(trace);
+    c_threadpool_destroy(&test_pool);
+
+    Assert(passed);
+    return(0);
+}
+
+#else
+
+int
+main(void)
+{
+    printf("trace capture needs the profiler (PROFILER_ENABLED=0), nothing to test...\n");
+    return(0);
+}
+
+#endif // PROFILER_ENABLED